@@ -3,6 +3,7 @@
 #include <pthread.h>
 #include <boost/interprocess/managed_shared_memory.hpp>
 #include <boost/interprocess/sync/named_mutex.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
 #include <boost/interprocess/sync/scoped_lock.hpp>
 #include <boost/interprocess/allocators/allocator.hpp>
 #include <boost/interprocess/containers/string.hpp>
@@ -22,6 +23,7 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <iterator>
 #include <unistd.h>
+#include <sys/stat.h>
 #include <vector>
 /* Binary Tree */
 #include <string.h>
@@ -34,6 +36,20 @@
 #include <stdio.h>      /* printf */
 #include <math.h>       /* floor */
 #include <iostream>
+#include <atomic>
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <mutex>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include "util/async_log.hpp"
+#include "util/bounded_mpmc_queue.hpp"
+#include "util/permutation_sort.hpp"
+#include "util/route_slack.hpp"
+#include "util/stop_grid.hpp"
+#include "util/write_behind_queue.hpp"
 
 #include <occi.h>
 
@@ -162,7 +178,6 @@ const int MAXTIMESLOTS = 96;
 const int MAXCLUSTERS = 3000; // 1500 //3000-------------
 const int MAXTC_COLUMNSIZE = 1000; /// number of tripidx per cluster per timeslot
 const int MAXTS_COLUMNSIZE = 200;
-const int TREESIZE = 50000; //50000 //200000 -----------------
 const int TRIPCOLSIZE = 100;
 const int MAXLGSTRSIZE = 200; // 200 -- old value
 const int MAXVYLGSTRSIZE = 400000; ///allows ~25000 edges if each edge is about 10 characters.
@@ -186,7 +201,6 @@ const int BATCHRUNNING = 11;
 const int NUMBEROFTRIPSSCHEDULED = 12;
 const int GROUPBUILDER = 13;
 const int EXCLUSIONINCLUSIONCHARSIZE = 5000;
-const int MAXTREEINDEXSTRSIZE = 20000;
 const int MAXAVLTOPSCOLUMNSIZE = 7;
 
 
@@ -194,18 +208,6 @@ const int MAXAVLTOPSCOLUMNSIZE = 7;
 
 
 
-struct Tree
-{
-	//EdgeInfo data;
-	unsigned long long  id = -1;
-	char index_str[MAXTREEINDEXSTRSIZE] = "0";
-	bool available;
-	int left = -1;
-	int right = -1;  
-	int parent = -1; 
-	char dummy[1] = "";
-};
-Tree *root;
 char (*shm_edgeids)[MAXVYLGSTRSIZE];
 char (*schd_tab)[TRIPCOLSIZE][MAXLGSTRSIZE];
 char (*schd_tab_unprocess)[TRIPCOLSIZE][MAXLGSTRSIZE];
@@ -217,19 +219,243 @@ int (*ts_tab)[MAXCLUSTERS][2][MAXTC_COLUMNSIZE];
 int (*tc_tab)[MAXTC_COLUMNSIZE];
 char (*process_tab)[MAXPROCESSESCOL][MAXLGSTRSIZE];
 char (*shared_process_tab)[MAXPROCESSESCOL][MAXLGSTRSIZE];
-char (*request_number)[MAXLGSTRSIZE];
-char (*request_numberofedges)[MAXLGSTRSIZE];
-char (*request_id)[MAXLGSTRSIZE];
-char (*request_latlon)[MAXLGSTRSIZE];
-char (*request_distance)[MAXLGSTRSIZE];
-char (*request_time)[MAXLGSTRSIZE];
-char (*request_edges)[MAXVYLGSTRSIZE];
-char (*request_tripidx)[MAXVYLGSTRSIZE];
-char (*request_function)[MAXLGSTRSIZE];
-char (*request_timestamp)[MAXLGSTRSIZE];
 
 char (*avl_tops)[MAXAVLTOPSCOLUMNSIZE][MAXLGSTRSIZE]; //Hui, 01-FEB-21; 0: segment_id, 1: lat, 2: lng, 3: record_time
 
+//request slots shared between the schedulers and osrm-routed; see updateRequest()/fetchRequest()
+const int REQUESTEMPTY = 0;
+const int REQUESTSUBMITTED = 1;
+const int REQUESTDONE = 2;
+const int REQUESTCLAIMED = 3; //handed out by acquireRequest(), being filled in
+const int REQUESTPROCESSING = 4; //taken by an osrm-routed worker, see claimRequest()
+const long REQUESTCLIENTWAITUS = 100000; //re-check interval for callers blocked on a result
+const long REQUESTSERVERWAITUS = 10000; //osrm-routed idle re-scan interval (old idle usleep)
+const int MAXREQUESTCOORDS = 4; //lat1,lon1[,lat2,lon2]
+const int MAXREQUESTTAGSIZE = 64;
+const size_t REQUESTARENASIZE = (size_t)1 << 30; //EDGES node arrays and TRIPIDX lists; pages are only backed once written
+const size_t REQUESTQUEUESIZE = 8192; //power of two above MAXREQUESTS
+
+enum RequestFunction
+{
+	FUNC_NONE = 0,
+	FUNC_ACCESS,
+	FUNC_ACCESSBOTH,
+	FUNC_FINDBEST,
+	FUNC_FINDBESTSINGLE,
+	FUNC_SLACKDIST,
+	FUNC_CALCDIST,
+	FUNC_FINDBESTDIST,
+	FUNC_FINDBESTDISTSINGLE,
+	FUNC_NEEDDIST,
+	FUNC_GETOSRMFULLSTRINGACCESS,
+	FUNC_GETOSRMFULLSTRINGDISTANCES,
+	FUNC_BUILDSTOPMATRIX,
+	FUNC_COUNT
+};
+const char *REQUESTFUNCTIONNAMES[FUNC_COUNT] = {"", "Access", "AccessBOTH", "FindBest", "FindBestSINGLE", "SlackDist", "CalcDist",
+		"FindBestDist", "FindBestDistSINGLE", "NEEDDist", "GETOSRMFULLSTRINGACCESS", "GETOSRMFULLSTRINGDISTANCES", "BuildStopMatrix"};
+
+//bits of RequestSlot::fields, one per updateRequest() type; an unset bit reads back as ""
+const int REQUESTFIELD_FUNC = 1 << 0;
+const int REQUESTFIELD_TIMESTAMP = 1 << 1;
+const int REQUESTFIELD_NUM = 1 << 2;
+const int REQUESTFIELD_ID = 1 << 3;
+const int REQUESTFIELD_LATLONG = 1 << 4;
+const int REQUESTFIELD_DISTANCE = 1 << 5;
+const int REQUESTFIELD_TIME = 1 << 6;
+const int REQUESTFIELD_EDGES = 1 << 7;
+const int REQUESTFIELD_TRIPIDX = 1 << 8;
+const int REQUESTFIELD_NUMBEROFEDGES = 1 << 9;
+const int REQUESTFIELD_ESTIMATE = 1 << 10; //DISTANCE/TIME are osrm-routed's straight-line fallback, not a route
+const int REQUESTFIELD_DEPARTURE = 1 << 11;
+const int REQUESTFIELD_DEPARTUREMETRIC = 1 << 12; //TIME comes from the departure metric of DEPARTURE, no velocity factor applies
+
+//variable-length text kept in the request arena; length -1 marks a list that did not fit
+struct RequestText
+{
+	bip::managed_shared_memory::handle_t handle;
+	int length;
+};
+
+//OSM node ids of a route or nearest search, packed as uint64 in the request arena; count -1 marks a list that did not fit
+struct RequestNodes
+{
+	bip::managed_shared_memory::handle_t handle;
+	int count;
+};
+
+//everything osrm-routed needs to pick up a slot sits in the first 64 bytes
+struct alignas(64) RequestSlot
+{
+	std::atomic<int> state;
+	int fields;
+	int function;
+	int id;
+	double coords[MAXREQUESTCOORDS];
+	int ncoords;
+	float distance;
+	float time;
+	float radius; //NUMBEROFEDGES, radius in meters for near()
+	char tag[MAXREQUESTTAGSIZE]; //NUM: caller name or clientdate
+	char timestamp[32];
+	RequestNodes edges;
+	RequestText tripidx;
+	unsigned long long sequence; //submission order, see submitRequest(); orders the legs of a GETOSRMFULLSTRING* request
+	std::atomic<int> queued; //1 while the slot index is on free_slots, so a release pushes it once
+	int departure; //DEPARTURE, minute of the day the leg leaves at; osrm-routed passes it on as departure_time
+};
+
+typedef osrm::util::BoundedMPMCQueue<int, REQUESTQUEUESIZE> RequestQueue;
+
+//Stop-pair travel cache shared by every scheduler process and osrm-routed; see lookupTravelCache()
+const int TRAVELCACHESIZE = 1 << 18; //entries, a power of two
+const int TRAVELCACHEWAYS = 4; //entries probed per key
+const double TRAVELCACHEPRECISION = 100000.0; //coordinates are quantized to 1e-5 degrees (~1m)
+
+struct TravelCacheEntry
+{
+	std::atomic<unsigned> version; //seqlock: odd while a writer fills the entry, 0 if never written
+	unsigned generation;
+	unsigned long long dataset; //TravelCache::dataset the answer was routed on
+	int key[MAXREQUESTCOORDS];
+	int departure; //DEPARTURE minute the answer was asked for, -1 without one
+	bool departuremetric; //REQUESTFIELD_DEPARTUREMETRIC of the answer
+	float distance;
+	float time;
+};
+
+struct TravelCache
+{
+	std::atomic<unsigned> generation; //bumped by invalidateTravelCache() when osrm-routed loads a dataset
+	std::atomic<unsigned long long> dataset; //timestamps of the shared dataset osrm-routed serves, 0 without one
+	std::atomic<unsigned long long> hits;
+	std::atomic<unsigned long long> misses;
+	TravelCacheEntry entry[TRAVELCACHESIZE];
+};
+
+struct RequestTable
+{
+	RequestTable() : slot(), travel_cache(), submissions(0), completions(0), releases(0), registry_generation(0), sequence(0)
+	{
+		for(int i = 0; i < MAXREQUESTS; i++){
+			slot[i].queued.store(1);
+			free_slots.TryPush(i);
+		}
+	}
+
+	RequestSlot slot[MAXREQUESTS];
+	RequestQueue free_slots; //slots any scheduler can claim, see acquireRequest()
+	RequestQueue pending; //submitted slots in FIFO order for osrm-routed
+	TravelCache travel_cache;
+	std::atomic<int> submissions; //futex word osrm-routed sleeps on
+	std::atomic<int> completions; //futex word batch callers sleep on
+	std::atomic<int> releases; //futex word callers sleep on while every slot is taken
+	std::atomic<unsigned> registry_generation; //bumped by gse_update() once the whole registry is in shared memory, 0 before
+	std::atomic<unsigned long long> sequence; //next RequestSlot::sequence
+	bip::interprocess_mutex writingfb; //held by the writer of WRITINGFB, see lockWritingFB()
+};
+static_assert(sizeof(std::atomic<int>) == sizeof(int) && ATOMIC_INT_LOCK_FREE == 2, "futex words must be plain lock-free ints");
+static_assert(offsetof(RequestSlot, tag) == 64 && sizeof(RequestSlot) % 64 == 0, "request slot header must stay one cache line");
+RequestTable *request_table = NULL;
+bip::managed_shared_memory *request_segment = NULL;
+
+//Per-service-day stop matrix: every unique stop of schd_tab snapped once and the full stop-to-stop
+//distance/time table kept in shared memory; see buildStopMatrix() and lookupStopMatrix()
+struct StopMatrixCell
+{
+	float distance; //miles, as the DISTANCE of a CalcDist request
+	float time; //minutes, as the TIME of a CalcDist request
+};
+
+struct StopMatrix
+{
+	//leaves the cells alone so pages are only backed once osrm-routed fills them
+	StopMatrix() : version(0), handoff(0), generation(0), nstops(0) {}
+
+	std::atomic<unsigned> version; //seqlock: odd while a build is running, 0 if never built
+	std::atomic<int> handoff; //the second of the building scheduler and osrm-routed to let go of the build request clears it
+	unsigned generation; //travel cache generation osrm-routed built the cells against
+	unsigned long long dataset; //travel cache dataset the cells were routed on
+	int nstops;
+	int stop[MAXTRIPIDX]; //unique stop of each trip index, -1 if the row had no coordinates
+	int key[MAXTRIPIDX][2]; //quantized lat/lon of each trip index when the matrix was built
+	double coords[MAXTRIPIDX][2]; //lat/lon of each unique stop
+	StopMatrixCell cell[MAXTRIPIDX][MAXTRIPIDX]; //[from stop][to stop]
+};
+const float STOPMATRIXESTIMATE = -1; //time of a cell osrm-routed could not route; lookups skip it
+const int STOPMATRIXTILE = 256; //sources and destinations per Table query while osrm-routed fills the matrix
+const int STOPMATRIXWAIT = 600; //seconds buildStopMatrix() waits for osrm-routed before the scheduler goes on without the matrix
+StopMatrix *stop_matrix = NULL;
+bip::managed_shared_memory *stop_matrix_segment = NULL;
+time_t stop_matrix_checked = 0;
+std::mutex stop_matrix_attach_mutex;
+int STOPMATRIX = 0; //1 builds the stop matrix once buildTree() has loaded the day
+
+int FORWARDSLACK = 1; //0 stops FindBest rejecting insertions that make a later stop of the route late, see ForwardSlack
+int DEPARTUREMETRICS = 0; //1 sends CalcDist requests with their departure minute, see requestDepartureAt()
+int SCHEDULEWRITES = 0; //1 sends writeallsegtoDB()/writesomesegtoDB() stops through the schedule writer instead of DBWRITE
+string SCHEDULEWRITEFILE = ""; //set to write schedule updates to this file instead of the database
+string REGISTRYCSVDIR = ""; //set to load the registry from CSV files in this directory instead of the database
+
+//avl_tops stays attached once found; gse_monitor creates it, so attachAvlTops() retries at most once a second until then
+time_t avl_tops_checked = 0;
+std::mutex avl_tops_attach_mutex;
+
+//Vehicle tracks: for every segment a scheduler asked getRealTimeTravleTime() about, osrm-routed snaps
+//the avl_tops fixes with the Match HMM and keeps the ETA to each remaining stop current; see
+//trackVehicles() in routed.cpp. Tracks hash on the segment id into their own segment keyed by keyrnum.
+const int MAXTRACKEDSTOPS = 16; //remaining stops routed from the matched position
+const int AVLTRACKWINDOW = 5; //most recent fixes the match runs over
+const int AVLTRACKINTERVAL = 2; //seconds between two passes of osrm-routed over avl_tops
+
+struct VehicleTrackData
+{
+	char segment[MAXLGSTRSIZE]; //segment id as in avl_tops
+	unsigned requested; //bumped whenever a scheduler registers another list of stops
+	unsigned answered; //requested the ETAs were routed for, the ETAs are unusable while they differ
+	char record_time[MAXLGSTRSIZE]; //avl_tops record_time of the fix the ETAs start from
+	double matched[2]; //lat/lon of that fix on the road network
+	int nstops;
+	int key[MAXTRACKEDSTOPS][2]; //quantized lat/lon of the remaining stops, in route order
+	double coords[MAXTRACKEDSTOPS][2];
+	float eta[MAXTRACKEDSTOPS]; //seconds from the matched position, cumulative along the stops; -1 if unroutable
+};
+
+struct VehicleTrack
+{
+	std::atomic<unsigned> version; //seqlock: odd while a scheduler or osrm-routed writes, 0 if never claimed
+	VehicleTrackData data;
+};
+
+struct VehicleTracks
+{
+	VehicleTracks() : track() {}
+	VehicleTrack track[MAXSEGMENTS];
+};
+VehicleTracks *vehicle_tracks = NULL;
+bip::managed_shared_memory *vehicle_tracks_segment = NULL;
+std::mutex vehicle_tracks_attach_mutex;
+
+//Uniform grid over the trip coordinates of schd_tab, shared by every scheduler of the site. Each
+//trip index is linked into the cell of the lat/lon it had when it was last indexed; see
+//stopsInRadius() and nearestStops().
+const int STOPINDEXBUCKETS = 16384; //power of two, grid cells hash onto these lists
+const double STOPINDEXCELL = 0.01; //degrees per grid cell side, about 0.7 miles
+const int STOPINDEXMAXRING = 100; //cells nearestStops() walks out before giving up
+const double SAMELOCATIONMILES = 0.056818182; //300 feet, see isSameLocation()
+const int STOPSEARCHNEAREST = 64; //rows searchonetimeslotclustermatch() takes from nearestStops() before the rest
+
+struct StopIndex
+{
+	StopIndex() : grid(STOPINDEXCELL, STOPINDEXMAXRING) {}
+
+	bip::interprocess_mutex mutex; //taken by writers and by the grid queries
+	osrm::util::StopGrid<STOPINDEXBUCKETS, MAXTRIPIDX> grid; //trip index -> lat/lon as tripNumber() returned them
+};
+StopIndex *stop_index = NULL;
+bip::managed_shared_memory *stop_index_segment = NULL;
+
+
 
 
 
@@ -308,6 +534,49 @@ const int DISABILITY = 12;
 const int TRIP_ID = 3;
 const int PROM_TIME = 4;
 
+//Typed copy of the numeric columns of schd_tab in shared memory, one record per row. Each cell
+//keeps the string it was parsed from, so reading a field costs a short strcmp instead of a
+//stringstream while the row is unchanged; see tripNumber(). Cells are as wide as the values the
+//loader and the scheduler write to the column, coordinates and miles with all their decimals.
+const int TRIPTYPEDCOLUMNS[] = {STOP_NUM, PROM_TIME, DIST_TO_NEXT_STOP, LAT, 13, 20, ESTDIST, 22, 25, START_TIME,
+		DESIRED_END_TIME, ETA, ETD, AMB, WC, 33, 34, LON, 41, 42, DWWAIT, PICKUPIDX, TRVLTIMEDEVIATION,
+		LATEDEVIATION, CALCULATEDTIME, CS_OCC, BS_OCC};
+const int TRIPTYPEDWIDTHS[] = {8, 16, 32, 32, 8, 16, 32, 16, 16, 16,
+		16, 16, 16, 8, 8, 8, 8, 32, 16, 16, 16, 8, 24,
+		24, 24, 8, 8}; //longer strings are parsed on every read
+const int NTRIPTYPEDCOLUMNS = sizeof(TRIPTYPEDCOLUMNS) / sizeof(TRIPTYPEDCOLUMNS[0]);
+static_assert(sizeof(TRIPTYPEDWIDTHS) == sizeof(TRIPTYPEDCOLUMNS), "one width per typed column");
+constexpr int tripRowTextSize(int slot){
+	return slot == NTRIPTYPEDCOLUMNS ? 0 : TRIPTYPEDWIDTHS[slot] + tripRowTextSize(slot + 1);
+}
+const int TRIPROWTEXTSIZE = tripRowTextSize(0);
+
+struct TripRow
+{
+	std::atomic<unsigned> version; //seqlock for tripNumber(): odd while a cell of the row changes
+	bool cached[NTRIPTYPEDCOLUMNS];
+	double value[NTRIPTYPEDCOLUMNS]; //as to_number() returns it
+	char text[TRIPROWTEXTSIZE]; //the schd_tab strings the values were parsed from, see trip_cell_offset
+};
+
+struct TripColumns
+{
+	TripColumns()
+	{
+		for(int d = 0; d < MAXTRIPIDX; d++){
+			row[d].version.store(0);
+			for(int c = 0; c < NTRIPTYPEDCOLUMNS; c++)
+				row[d].cached[c] = false;
+		}
+	}
+
+	TripRow row[MAXTRIPIDX];
+};
+TripColumns *trip_columns = NULL;
+bip::managed_shared_memory *trip_columns_segment = NULL;
+int trip_cell_offset[NTRIPTYPEDCOLUMNS]; //where each typed column starts in TripRow::text
+int trip_column_slot[TRIPCOLSIZE]; //typed column of each schd_tab column, -1 for string columns
+
 
 string numberofedges;
 string osrm_shm;
@@ -476,42 +745,86 @@ string FIXEDBOOL;
 
 
 
-int DEBUG;
-int DEBUGSTATE;
-int DEBUGACCESS;
-int DEBUGLAUNCHER;
-int DEBUGBATCH;
-int DEBUGBUILDGRPS;
-int DEBUGCALC;
-int DEBUGCHECKINCL;
-int DEBUGCLEANALL;
-int DEBUGCLEARSCR;
-int DEBUGSYSSERV;
-int DEBUGDBWRITE;
-int DEBUGFB;
-int DEBUGFB2;
-int DEBUGFINAL;
-int DEBUGALLFIXED;
-int DEBUGKILLALLFIXED;
-int DEBUGKILLALLPROG;
-int DEBUGKILLCLIENTDATE;
-int DEBUGKILLPROC;
-int DEBUGMONITOR;
-int DEBUGORACLEBAT;
-int DEBUGPRINT;
-int DEBUGPRINTPROCSTAT;
-int DEBUGPRINTXML;
-int DEBUGRESTARTDB;
-int DEBUGREVERSE;
-int DEBUGSEARCHNOTRIP;
-int DEBUGSLACK;
-int DEBUGSWITCHBRD;
-int DEBUGSYNC;
-int DEBUGTIMEBATCH;
-int DEBUGVERSION;
-int DEBUGVIEWSCR;
-int DEBUGVIEWTAB;
-int DEBUGROUTED;
+//Switchable while running (see reloadDebugFlags()), so every thread reads them atomically
+atomic<int> DEBUG;
+atomic<int> DEBUGSTATE;
+atomic<int> DEBUGACCESS;
+atomic<int> DEBUGLAUNCHER;
+atomic<int> DEBUGBATCH;
+atomic<int> DEBUGBUILDGRPS;
+atomic<int> DEBUGCALC;
+atomic<int> DEBUGCHECKINCL;
+atomic<int> DEBUGCLEANALL;
+atomic<int> DEBUGCLEARSCR;
+atomic<int> DEBUGSYSSERV;
+atomic<int> DEBUGDBWRITE;
+atomic<int> DEBUGFB;
+atomic<int> DEBUGFB2;
+atomic<int> DEBUGFINAL;
+atomic<int> DEBUGALLFIXED;
+atomic<int> DEBUGKILLALLFIXED;
+atomic<int> DEBUGKILLALLPROG;
+atomic<int> DEBUGKILLCLIENTDATE;
+atomic<int> DEBUGKILLPROC;
+atomic<int> DEBUGMONITOR;
+atomic<int> DEBUGORACLEBAT;
+atomic<int> DEBUGPRINT;
+atomic<int> DEBUGPRINTPROCSTAT;
+atomic<int> DEBUGPRINTXML;
+atomic<int> DEBUGRESTARTDB;
+atomic<int> DEBUGREVERSE;
+atomic<int> DEBUGSEARCHNOTRIP;
+atomic<int> DEBUGSLACK;
+atomic<int> DEBUGSWITCHBRD;
+atomic<int> DEBUGSYNC;
+atomic<int> DEBUGTIMEBATCH;
+atomic<int> DEBUGVERSION;
+atomic<int> DEBUGVIEWSCR;
+atomic<int> DEBUGVIEWTAB;
+atomic<int> DEBUGROUTED;
+
+//The per-process flags of configLogs.txt by name
+struct DebugFlag{
+	const char* name;
+	atomic<int>* value;
+};
+DebugFlag DEBUGFLAGS[] = {
+	{"DEBUGACCESS", &DEBUGACCESS},
+	{"DEBUGLAUNCHER", &DEBUGLAUNCHER},
+	{"DEBUGBATCH", &DEBUGBATCH},
+	{"DEBUGBUILDGRPS", &DEBUGBUILDGRPS},
+	{"DEBUGCALC", &DEBUGCALC},
+	{"DEBUGCHECKINCL", &DEBUGCHECKINCL},
+	{"DEBUGCLEANALL", &DEBUGCLEANALL},
+	{"DEBUGCLEARSCR", &DEBUGCLEARSCR},
+	{"DEBUGSYSSERV", &DEBUGSYSSERV},
+	{"DEBUGDBWRITE", &DEBUGDBWRITE},
+	{"DEBUGFB", &DEBUGFB},
+	{"DEBUGFB2", &DEBUGFB2},
+	{"DEBUGFINAL", &DEBUGFINAL},
+	{"DEBUGALLFIXED", &DEBUGALLFIXED},
+	{"DEBUGKILLALLFIXED", &DEBUGKILLALLFIXED},
+	{"DEBUGKILLALLPROG", &DEBUGKILLALLPROG},
+	{"DEBUGKILLCLIENTDATE", &DEBUGKILLCLIENTDATE},
+	{"DEBUGKILLPROC", &DEBUGKILLPROC},
+	{"DEBUGMONITOR", &DEBUGMONITOR},
+	{"DEBUGORACLEBAT", &DEBUGORACLEBAT},
+	{"DEBUGPRINT", &DEBUGPRINT},
+	{"DEBUGPRINTPROCSTAT", &DEBUGPRINTPROCSTAT},
+	{"DEBUGPRINTXML", &DEBUGPRINTXML},
+	{"DEBUGRESTARTDB", &DEBUGRESTARTDB},
+	{"DEBUGREVERSE", &DEBUGREVERSE},
+	{"DEBUGSEARCHNOTRIP", &DEBUGSEARCHNOTRIP},
+	{"DEBUGSLACK", &DEBUGSLACK},
+	{"DEBUGSWITCHBRD", &DEBUGSWITCHBRD},
+	{"DEBUGSYNC", &DEBUGSYNC},
+	{"DEBUGTIMEBATCH", &DEBUGTIMEBATCH},
+	{"DEBUGVERSION", &DEBUGVERSION},
+	{"DEBUGVIEWSCR", &DEBUGVIEWSCR},
+	{"DEBUGVIEWTAB", &DEBUGVIEWTAB},
+	{"DEBUGROUTED", &DEBUGROUTED},
+};
+string DEBUGPROCESSNAME = ""; //this process as named in configLogs.txt, found when the flags are first read
 
 
 shm::shared_string to_shared_string(string str,shm::char_alloc char_alloc){
@@ -520,25 +833,26 @@ shm::shared_string to_shared_string(string str,shm::char_alloc char_alloc){
 }
 
 
-ofstream gse;
+//Both logs are written by a background thread, which also formats the values of the lines
+osrm::util::AsyncLog gse_log;
 string filename = "hbssgseout.txt";
-ofstream logstatechange;
+osrm::util::AsyncLog logstatechange_log;
 string aFileName = "";
 
 void f_cout(string filename2){
 
-	if(!gse.is_open())
-		//gse.open(filename2,fstream::out | fstream::app);
-	gse.open(filename2);
+	if(!gse_log.IsOpen())
+		//gse_log.Open(filename2,fstream::out | fstream::app);
+	gse_log.Open(filename2, fstream::out | fstream::trunc);
 
 
 }
 
 void s_cout(string theFilename){
-	if(!logstatechange.is_open())
+	if(!logstatechange_log.IsOpen())
 	{
 		aFileName = theFilename;
-		logstatechange.open(aFileName,fstream::out | fstream::app);
+		logstatechange_log.Open(aFileName,fstream::out | fstream::app);
 		// logstatechange.open(theFilename);
 	}
 
@@ -548,10 +862,11 @@ void s_cout(string theFilename){
 std::string getCurrentDateTime()
 {
 	time_t t = time(NULL);
-	struct tm tm = *localtime(&t);
+	struct tm tm;
+	localtime_r(&t, &tm);
 	// printf("%d-%02d-%02d %02d:%02d:%02d\n ", tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
-	char* datetime = (char*)malloc(13 * sizeof(char));
-	sprintf(datetime, "%d-%02d-%02d %02d:%02d:%02d ", tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+	char datetime[32];
+	snprintf(datetime, sizeof datetime, "%d-%02d-%02d %02d:%02d:%02d ", tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
 	std::string datetimestr = datetime;
 	// std::cout << datetimestr << "Some logs here" << std::endl;
 	return datetimestr;
@@ -563,14 +878,17 @@ std::string getCurrentDateTimeMilSecs()
 	// timespec_get(&ts, TIME_UTC);
 	clock_gettime(CLOCK_REALTIME, &ts);
 	char buff[100];
-	strftime(buff, sizeof buff, "%D %T", gmtime(&ts.tv_sec));
+	struct tm tm;
+	strftime(buff, sizeof buff, "%D %T", gmtime_r(&ts.tv_sec, &tm));
 	// printf("Producer-Consumer Test started: %s.%09ld UTC\n", buff, ts.tv_nsec);
-	sprintf(buff, "%s.%09ld ", buff, ts.tv_nsec);
-	std::string datetimestr = (string)buff;
+	char stamp[128];
+	snprintf(stamp, sizeof stamp, "%s.%09ld ", buff, ts.tv_nsec);
+	std::string datetimestr = (string)stamp;
 	return datetimestr;
 }
-#define gse gse << getCurrentDateTimeMilSecs()
-#define logstatechange logstatechange << getCurrentDateTimeMilSecs()
+//Each statement is one line: stamped where it starts, handed to the writer at its end
+#define gse osrm::util::AsyncLogLine(gse_log)
+#define logstatechange osrm::util::AsyncLogLine(logstatechange_log)
 
 
 string table_itms_trips;
@@ -594,6 +912,80 @@ double to_number(string str){
 	}
 }
 
+//The typed columns live in their own segment keyed by keyrnum, created by whichever process reads
+//a field first; loadTripColumns() fills it once buildTree() has loaded the day. schd_tab stays the
+//store everything writes to, and cells written after the load follow it lazily.
+void attachTripColumns(){
+	if(trip_columns != NULL)
+		return;
+	for(int c = 0; c < TRIPCOLSIZE; c++)
+		trip_column_slot[c] = -1;
+	int offset = 0;
+	for(int slot = 0; slot < NTRIPTYPEDCOLUMNS; slot++){
+		trip_column_slot[TRIPTYPEDCOLUMNS[slot]] = slot;
+		trip_cell_offset[slot] = offset;
+		offset += TRIPTYPEDWIDTHS[slot];
+	}
+	string segmentname = "GSE_TRIPROWS_" + to_string(keyrnum);
+	trip_columns_segment = new bip::managed_shared_memory(bip::open_or_create, segmentname.c_str(), sizeof(TripColumns) + 65536);
+	trip_columns = trip_columns_segment->find_or_construct<TripColumns>("TripColumns")();
+}
+
+bool readTripCell(int slot, int tripidx, const char * text, double & value){
+	TripRow & row = trip_columns->row[tripidx];
+	const unsigned before = row.version.load(std::memory_order_acquire);
+	if((before & 1) || !row.cached[slot] || strcmp(row.text + trip_cell_offset[slot], text) != 0)
+		return false;
+	value = row.value[slot];
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return row.version.load(std::memory_order_relaxed) == before;
+}
+
+//Stores value for the cell unless another thread or process is writing the same row; that one's
+//value is as good, and this read has its answer either way
+void writeTripCell(int slot, int tripidx, const string & text, double value){
+	TripRow & row = trip_columns->row[tripidx];
+	unsigned version = row.version.load(std::memory_order_relaxed);
+	if((version & 1) || !row.version.compare_exchange_strong(version, version + 1, std::memory_order_acquire))
+		return;
+	std::atomic_thread_fence(std::memory_order_release);
+	strcpy(row.text + trip_cell_offset[slot], text.c_str());
+	row.value[slot] = value;
+	row.cached[slot] = true;
+	row.version.store(version + 2, std::memory_order_release);
+}
+
+//schd_tab[tripidx][column] as to_number() parses it
+double tripNumber(int tripidx, int column){
+	const char * text = schd_tab[tripidx][column];
+	if(tripidx < 0 || tripidx >= MAXTRIPIDX || column < 0 || column >= TRIPCOLSIZE)
+		return to_number(text);
+	attachTripColumns();
+	const int slot = trip_column_slot[column];
+	double value;
+	if(slot < 0)
+		return to_number(text);
+	if(readTripCell(slot, tripidx, text, value))
+		return value;
+
+	const string snapshot(text);
+	value = to_number(snapshot);
+	if(snapshot.size() < (size_t)TRIPTYPEDWIDTHS[slot])
+		writeTripCell(slot, tripidx, snapshot, value);
+	return value;
+}
+
+//Parses the typed columns of every loaded row, so the searches start on filled cells
+void loadTripColumns(){
+	attachTripColumns();
+	for(int d = 1; d < MAXTRIPIDX; d++){
+		if(strcmp(schd_tab[d][10],"")==0)
+			break;
+		for(int slot = 0; slot < NTRIPTYPEDCOLUMNS; slot++)
+			tripNumber(d, TRIPTYPEDCOLUMNS[slot]);
+	}
+}
+
 
 
 
@@ -765,6 +1157,7 @@ bool checkfixedroutedata(){
 				throwaway=getNextToken(&(processName),"/");
 				processName = getNextToken(&(processName)," "); //JDC This assumes there is always a space at the end of the process name.
 				processName.erase(std::remove(processName.begin(), processName.end(), '\n'), processName.end()); //JDC If there is no space then there will be a \n
+				DEBUGPROCESSNAME = processName;
 
 				string candidateName;
 
@@ -1210,6 +1603,49 @@ bool checkfixedroutedata(){
 
 
 
+//Re-reads the DEBUG* flags of client from configLogs.txt whenever the file has changed since the
+//last call, so diagnostics can be switched on a running process. The first call only notes the
+//file's time, the flags having just been read at startup. Every flag listed for this process applies.
+void reloadDebugFlags(string client){
+	static time_t lastmodified = 0;
+	struct stat status;
+	if(stat(CONFIGLOGS.c_str(), &status) != 0 || status.st_mtime == lastmodified)
+		return;
+	bool first = lastmodified == 0;
+	lastmodified = status.st_mtime;
+	if(first)
+		return;
+
+	ifstream logfile (CONFIGLOGS);
+	string line;
+	while(getline (logfile,line)){
+		if(line != "CLIENT")
+			continue;
+		getline (logfile,line);
+		if(line != client)
+			continue;
+
+		getline (logfile,line);
+		getNextToken(&(line),"=");
+		DEBUG = (int) to_number(getNextToken(&(line),";"));
+		getline (logfile,line);
+		getNextToken(&(line),"=");
+		DEBUGSTATE = (int) to_number(getNextToken(&(line),";"));
+		while(getline (logfile,line)){
+			string candidateName = getNextToken(&(line),":");
+			string debugFlag = getNextToken(&(line),"=");
+			int flagValue = (int) to_number(getNextToken(&(line),";"));
+			if(candidateName != DEBUGPROCESSNAME)
+				continue;
+			for(size_t f = 0; f < sizeof(DEBUGFLAGS) / sizeof(DEBUGFLAGS[0]); f++)
+				if(debugFlag == DEBUGFLAGS[f].name)
+					*DEBUGFLAGS[f].value = flagValue;
+		}
+		break;
+	}
+	if(DEBUG == 1) gse << "Reloaded debug flags from " << CONFIGLOGS << endl;
+}
+
 bool initshm(string client, string date){
 
 	ifstream logfile (CONFIGLOGS);
@@ -1250,6 +1686,7 @@ bool initshm(string client, string date){
 					throwaway=getNextToken(&(processName),"/");
 					processName = getNextToken(&(processName)," "); //JDC This assumes there is always a space at the end of the process name.
 					processName.erase(std::remove(processName.begin(), processName.end(), '\n'), processName.end()); //JDC If there is no space then there will be a \n
+					DEBUGPROCESSNAME = processName;
 					string candidateName;
 
 					getline (logfile,line);
@@ -1259,12 +1696,38 @@ bool initshm(string client, string date){
 					candidateName=getNextToken(&(line),"=");
 					DEBUGSTATE = (int) to_number(getNextToken(&(line),";"));
 					string debugFlag;
+					string flagText;
 					int flagValue;
 					while(getline (logfile,line)){
 						candidateName = getNextToken(&(line),":");
 						debugFlag = getNextToken(&(line),"=");
-						flagValue = (int) to_number(getNextToken(&(line),";"));
+						flagText = getNextToken(&(line),";");
+						flagValue = (int) to_number(flagText);
 						if (candidateName == processName) {
+							if (debugFlag == "FORWARDSLACK"){ //not a debug flag either
+								FORWARDSLACK=flagValue;
+								continue;
+							}
+							if (debugFlag == "DEPARTUREMETRICS"){ //not a debug flag either
+								DEPARTUREMETRICS=flagValue;
+								continue;
+							}
+							if (debugFlag == "SCHEDULEWRITES"){ //not a debug flag either
+								SCHEDULEWRITES=flagValue;
+								continue;
+							}
+							if (debugFlag == "SCHEDULEWRITEFILE"){ //a file name, not a number
+								SCHEDULEWRITEFILE=flagText;
+								continue;
+							}
+							if (debugFlag == "REGISTRYCSVDIR"){ //a directory, not a number
+								REGISTRYCSVDIR=flagText;
+								continue;
+							}
+							if (debugFlag == "STOPMATRIX"){ //not a debug flag, keep reading the ones that follow
+								STOPMATRIX=flagValue;
+								continue;
+							}
 							if (debugFlag == "DEBUGACCESS"){
 								DEBUGACCESS=flagValue;
 								foundFlag = true;
@@ -1644,6 +2107,7 @@ bool checkdaily(string date){
 				throwaway=getNextToken(&(processName),"/");
 				processName = getNextToken(&(processName)," "); //JDC This assumes there is always a space at the end of the process name.
 				processName.erase(std::remove(processName.begin(), processName.end(), '\n'), processName.end()); //JDC If there is no space then there will be a \n
+				DEBUGPROCESSNAME = processName;
 				string candidateName;
 
 				getline (logfile,line);
@@ -2152,8 +2616,8 @@ bool foundMobilityExclusion(int * local_s_tab, int counter, string excludedmob1,
 						exmob2 = excludedmob1;
 					else
 						exmob2 = excludedmob2;
-					int ambocc = (int)to_number(schd_tab[local_s_tab[x-1]][31]);
-					int wcocc = (int)to_number(schd_tab[local_s_tab[x-1]][32]);
+					int ambocc = (int)tripNumber(local_s_tab[x-1], 31);
+					int wcocc = (int)tripNumber(local_s_tab[x-1], 32);
 					if(DEBUG == 1) gse << "First conditon in loop x is true. disposition2: " << disposition2 << ", stoptype2: " << stoptype2 << ", mobility2: " << mobility2 << ", excludedmob1: " << excludedmob1 << ", excludedmob2: " << excludedmob2 << ", exmob2: " << exmob2 << ", ambocc: " << ambocc << ", wcocc: " << wcocc << endl;
 					if((ambocc >= 1 || wcocc >= 1) && exmob2 != exmob){
 						if(DEBUG == 1) gse << "Second conditon in loop x is true. ambocc: " << ambocc << ", wcocc: " << wcocc << ", exmob2: " << exmob2 << ", exmob: " << exmob << endl;
@@ -2212,8 +2676,8 @@ bool foundMobilityExclusion_NIU(int * local_s_tab, int counter, string excludedm
                 string stoptype2 = schd_tab[local_s_tab[x]][7];
                 string mobility2 = schd_tab[local_s_tab[x]][12];
                 if(stoptype == "P" && (mobility2.find(excludedmob1,0)!=string::npos || mobility2.find(excludedmob2,0)!=string::npos)){
-                    int ambocc = (int)to_number(schd_tab[local_s_tab[x]][31]);
-                    int wcocc = (int)to_number(schd_tab[local_s_tab[x]][32]);
+                    int ambocc = (int)tripNumber(local_s_tab[x], 31);
+                    int wcocc = (int)tripNumber(local_s_tab[x], 32);
 
                         if(ambocc > 1 || wcocc > 1){
                             furthercheck =true;
@@ -2275,8 +2739,8 @@ bool foundMobilityExclusion_NIU(int * local_s_tab, int counter, string excludedm
 					else
 						exmob2 = excludedmob2;
 
-					int ambocc = (int)to_number(schd_tab[local_s_tab[x-1]][31]);
-					int wcocc = (int)to_number(schd_tab[local_s_tab[x-1]][32]);
+					int ambocc = (int)tripNumber(local_s_tab[x-1], 31);
+					int wcocc = (int)tripNumber(local_s_tab[x-1], 32);
 
 					if(DEBUG == 1) gse << "First conditon in loop x is true. disposition2: " << disposition2 << ", stoptype2: " << stoptype2 << ", mobility2: " << mobility2 << ", excludedmob1: " << excludedmob1 << ", excludedmob2: " << excludedmob2 << ", exmob2: " << exmob2 << ", ambocc: " << ambocc << ", wcocc: " << wcocc << endl;
 
@@ -2330,98 +2794,27 @@ bool foundMobilityExclusion_NIU(int * local_s_tab, int counter, string excludedm
 
 
 
-int F_GET_TRAVEL_TIME (int P_TRIP_TIME , string time_zone, string time_zone2)//, int VEL_PT, int VEL_WT, int  VEL_LT, int  VEL_ET,int  VEL_NT,int  VEL_HT)
-{
-	/* int  V_VEL_PT    = VEL_PT ;
-      int V_VEL_WT   = VEL_WT   ;
-      int V_VEL_LT   = VEL_LT ;
-     int  V_VEL_ET    = VEL_ET  ;
-      int V_VEL_NT  = VEL_NT   ;
-      int V_VEL_HT   = VEL_HT   ; 
-	 */
-	if(DEBUG == 1) gse << "inside calculator.h - F_GET_TRAVEL_TIME(), time_zone: " << time_zone << ", P_TRIP_TIME: " << P_TRIP_TIME << endl;
-	int v = 0;
-	//  if(DEBUG == 1) gse << "P_TRIP_TIME is " << P_TRIP_TIME << endl;
-
-
-
-	/* c[002] */
-
-	/*return the amount of minutes a trip takes at certain time of the day*/
-
-	/* if (P_TRIP_TIME == NULL)
-      THEN
-         RAISE_APPLICATION_ERROR (-20000, 'Invalid time');
-      END if;*/
-
-	/* c[002] */
-
-	//  if(DEBUG == 1) gse << " time zone_ " << time_zone << endl;
-
-	if (time_zone == "*")
-		return 0;
-
-
-
-
-	// if(DEBUG == 1) gse << "VEL  "  << V_VEL_PT[2] << endl;
-
-
-	/* if (time_zone2!= "*")
-      {
-         time_zone = time_zone2;
-      }*/
-
-	/*-- Peak time AM*/
-
-	//  if(DEBUG == 1) gse << ( 0/V_VEL_NT[v])*60 << endl;
-
-
-	//  if(DEBUG == 1) gse << "Time zone " << time_zone << " " << P_TRIP_DISTANCE << " " << V_VEL_PT[v] <<endl;
-
-	if (time_zone == "PTA"){
-		// if(DEBUG == 1) gse << " PTa " << V_VEL_PT[v] << " " << v << endl;
-		if(DEBUG == 1) gse << "end calculator.h - time_zone  == " << time_zone << ", returning ceil((P_TRIP_TIME * V_VEL_PT[0]) ) = " << ceil((P_TRIP_TIME * V_VEL_PT[0]) ) << endl;
-		return ceil((P_TRIP_TIME * V_VEL_PT[0]) );
-	}
-	/*-- Peak time PM*/
-	else if (time_zone == "PTP"){
-		// if(DEBUG == 1) gse << " PTP " << V_VEL_PT[v] << " " << v << endl;
-		if(DEBUG == 1) gse << "end calculator.h - time_zone  == " << time_zone << ", returning ceil((P_TRIP_TIME * V_VEL_PT[0])) = " << ceil((P_TRIP_TIME * V_VEL_PT[0])) << endl;
-		return ceil((P_TRIP_TIME * V_VEL_PT[0]));
-	}
-	/*-- Work time*/
-
-	else if (time_zone == "WT"){
-		//  if(DEBUG == 1) gse << " PTP " << V_VEL_WT[v] << " " << v << endl;
-		if(DEBUG == 1) gse << "end calculator.h - time_zone  == " << time_zone << ", returning ceil((P_TRIP_TIME * V_VEL_WT[0])) = " << ceil((P_TRIP_TIME * V_VEL_WT[0])) << endl;
-		return ceil((P_TRIP_TIME * V_VEL_WT[0]));
-	}
-	/*-- Leisure time*/
-	else if (time_zone == "LT"){
-		if(DEBUG == 1) gse << "end calculator.h - time_zone  == " << time_zone << ", returning ceil((P_TRIP_TIME * V_VEL_LT[0])) = " << ceil((P_TRIP_TIME * V_VEL_LT[0])) << endl;
-		return ceil((P_TRIP_TIME * V_VEL_LT[0]));
-	/*-- Night time AM*/
-	}
-	else if (time_zone == "NTA"){
-		if(DEBUG == 1) gse << "end calculator.h - time_zone  == " << time_zone << ", returning ceil((P_TRIP_TIME * V_VEL_NT[0])) = " << ceil((P_TRIP_TIME * V_VEL_NT[0])) << endl;
-		return ceil((P_TRIP_TIME * V_VEL_NT[0]));
-	}
-	/*-- Night time PM*/
-	else if (time_zone == "NTP"){
-		if(DEBUG == 1) gse << "end calculator.h - time_zone  == " << time_zone << ", returning ceil((P_TRIP_TIME * V_VEL_NT[0])) = " << ceil((P_TRIP_TIME * V_VEL_NT[0])) << endl;
-		return ceil((P_TRIP_TIME * V_VEL_NT[0]));
-	/*-- Early time*/
-	}
-	else if (time_zone == "ET"){
-		if(DEBUG == 1) gse << "end calculator.h - time_zone  == " << time_zone << ", returning ceil((P_TRIP_TIME * V_VEL_ET[0])) = " << ceil((P_TRIP_TIME * V_VEL_ET[0])) << endl;
-		return ceil((P_TRIP_TIME * V_VEL_ET[0]));
-	}
-	else{
-		if(DEBUG == 1) gse << "end calculator.h - time_zone  == " << time_zone << ", returning 0, RAISE_APPLICATION_ERROR(-20000,'Invalid time zone')" << endl;
-		return 0;  /*--RAISE_APPLICATION_ERROR(-20000,'Invalid time zone');*/
-	}
+//Velocity factor of a time zone; 0 for "*" and names that are not a zone, which have no travel time
+double zoneVelocityFactor(const char * time_zone){
+	if(strcmp(time_zone, "PTA") == 0 || strcmp(time_zone, "PTP") == 0) /*-- Peak time AM/PM*/
+		return V_VEL_PT[0];
+	if(strcmp(time_zone, "WT") == 0) /*-- Work time*/
+		return V_VEL_WT[0];
+	if(strcmp(time_zone, "LT") == 0) /*-- Leisure time*/
+		return V_VEL_LT[0];
+	if(strcmp(time_zone, "NTA") == 0 || strcmp(time_zone, "NTP") == 0) /*-- Night time AM/PM*/
+		return V_VEL_NT[0];
+	if(strcmp(time_zone, "ET") == 0) /*-- Early time*/
+		return V_VEL_ET[0];
+	return 0; /*--RAISE_APPLICATION_ERROR(-20000,'Invalid time zone');*/
+}
 
+/*return the amount of minutes a trip takes at certain time of the day*/
+int F_GET_TRAVEL_TIME (int P_TRIP_TIME , string time_zone, string time_zone2)
+{
+	int trav_time = ceil(P_TRIP_TIME * zoneVelocityFactor(time_zone.c_str()));
+	if(DEBUG == 1) gse << "calculator.h - F_GET_TRAVEL_TIME(), time_zone: " << time_zone << ", P_TRIP_TIME: " << P_TRIP_TIME << ", returning " << trav_time << endl;
+	return trav_time;
 }
 
 
@@ -2769,13 +3162,166 @@ string ampm2fullhrs(string in_time){
 
 }
 
+//Minutes since midnight, the form schedule times are compared and added in
+typedef int DayMinute;
+const DayMinute MINUTESPERDAY = 1440;
+
+//What stringstream >> int makes of the (at most) two characters of text at from: 0 if there is no number
+int twoCharNumber(const string & text, size_t from){
+	size_t end = min(text.size(), from + 2);
+	size_t i = from;
+	while(i < end && isspace((unsigned char)text[i]))
+		i++;
+	bool negative = false;
+	if(i < end && (text[i] == '-' || text[i] == '+'))
+		negative = text[i++] == '-';
+	int value = 0;
+	bool digits = false;
+	for(; i < end && isdigit((unsigned char)text[i]); i++){
+		value = value * 10 + (text[i] - '0');
+		digits = true;
+	}
+	return digits ? (negative ? -value : value) : 0;
+}
+
+//dayMinute(time) without building and parsing the 24 hour text in between
+DayMinute dayMinute(const string & time){
+	if(time == "0000" || time.find(':') != string::npos || time.find('.') != string::npos)
+		return 0;
+	if(MILITARYTIME != 'F')
+		return itms_to_minutes(time);
+
+	int hours = twoCharNumber(time, 0);
+	int minutes = twoCharNumber(time, 2);
+	if(hours == 0 && minutes == 0) /*** WILL CALL TIME 0000A OR 0000P ***/
+		return 0;
+	char ampm = time.size() < 4 ? 'A' : (time.size() == 4 ? ' ' : time[4]);
+	if(ampm == 'A'){
+		if(hours == 12)
+			hours = 0;
+	}
+	else if(hours != 12)
+		hours = hours + 12;
+	if(hours < 0 || hours > 99 || minutes < 0 || minutes > 99) //does not print as hhmm, so it does not read back as hours and minutes
+		return itms_to_minutes(ampm2fullhrs(time));
+	return hours * 60 + minutes;
+}
+
+//dayMinute(itms_minutes_to_ampm(minutes)): the minute itself in AM/PM time, the last one of the day if out of range
+DayMinute dayMinuteOf(int minutes){
+	if(MILITARYTIME != 'F')
+		return dayMinute(itms_minutes_to_ampm(minutes));
+	return minutes < 0 || minutes > 1439 ? 1439 : minutes;
+}
+
+
+
+
+
 
 
+//Where gse_update() loads the registry tables from. Each table is fetched whole by one query and
+//handed back as rows of text columns; the loaders below parse them into the shared tables in one pass.
+typedef vector<vector<string> > TableRows;
 
+struct TableSource{
+	virtual ~TableSource(){}
+	//Fills rows with every row command returns from table; throws if the table cannot be read
+	virtual void fetch(const string & table, const string & command, TableRows & rows) = 0;
+};
 
+const unsigned int REGISTRYPREFETCHROWS = 1000; //rows fetched per round trip when loading the registry
 
+//Reads straight from the database. Every fetch opens its own connection, so several tables can be
+//fetched at once, and the client prefetches REGISTRYPREFETCHROWS rows per round trip.
+struct OcciTableSource : TableSource{
+	Environment* env;
 
-void getVelocity(Environment* env ,Connection* conn){
+	OcciTableSource(){
+		env = Environment::createEnvironment(Environment::THREADED_MUTEXED);
+	}
+
+	~OcciTableSource(){
+		Environment::terminateEnvironment(env);
+	}
+
+	void fetch(const string &, const string & command, TableRows & rows){
+		Connection* conn = env->createConnection(username, password, connectString);
+		Statement* stmt = NULL;
+		ResultSet* rs = NULL;
+		try{
+			stmt = conn->createStatement(command);
+			stmt->setPrefetchRowCount(REGISTRYPREFETCHROWS);
+			rs = stmt->executeQuery();
+			size_t columns = rs->getColumnListMetaData().size();
+			while(rs->next()){
+				rows.push_back(vector<string>(columns));
+				for(size_t c = 0; c < columns; c++)
+					rows.back()[c] = rs->getString(c + 1);
+			}
+		}
+		catch(...){
+			if(rs != NULL)
+				stmt->closeResultSet(rs);
+			if(stmt != NULL)
+				conn->terminateStatement(stmt);
+			env->terminateConnection(conn);
+			throw;
+		}
+		stmt->closeResultSet(rs);
+		conn->terminateStatement(stmt);
+		env->terminateConnection(conn);
+	}
+};
+
+//Stand-in for the database: reads <directory>/<table>.csv, one row per line and the columns in table
+//order. The file holds exactly the rows the query would return; the query itself is ignored.
+struct CsvTableSource : TableSource{
+	string directory;
+
+	CsvTableSource(string directory) : directory(directory){}
+
+	void fetch(const string & table, const string &, TableRows & rows){
+		string path = directory + "/" + table + ".csv";
+		ifstream file(path.c_str());
+		if(!file.is_open())
+			throw runtime_error("cannot open " + path);
+		string line;
+		while(getline(file, line)){
+			if(!line.empty() && line[line.size() - 1] == '\r')
+				line.erase(line.size() - 1);
+			if(line.empty())
+				continue;
+			rows.push_back(vector<string>(1));
+			bool quoted = false;
+			for(size_t i = 0; i < line.size(); i++){
+				if(line[i] == '"'){
+					if(quoted && i + 1 < line.size() && line[i + 1] == '"')
+						rows.back().back() += line[++i];
+					else
+						quoted = !quoted;
+				}
+				else if(line[i] == ',' && !quoted)
+					rows.back().push_back("");
+				else
+					rows.back().back() += line[i];
+			}
+		}
+	}
+};
+
+//Column c (from 1, as in OCCI) of a fetched row; empty if the row is shorter
+const string & tableColumn(const vector<string> & row, size_t c){
+	static const string empty;
+	return c >= 1 && c <= row.size() ? row[c - 1] : empty;
+}
+
+int tableInt(const vector<string> & row, size_t c){
+	return (int)to_number(tableColumn(row, c));
+}
+
+//Takes the OSRMVELOCITYFACTOR row of the itms_oe_registry rows (featureid, featurevalue)
+void getVelocity(const TableRows & oe_registry){
 
 	// if(DEBUG == 1) gse << " here I am ";
 	/*
@@ -2805,19 +3351,15 @@ string command = "SELECT  MINDIST,MAXDIST,VEL_PT, VEL_WT,VEL_LT ,VEL_ET,VEL_NT,V
 
 	double defaultosrm = 0.85;
 
-	string command1 = "select featureid, featurevalue from itms_oe_registry where featureid = 'OSRMVELOCITYFACTOR'";
-
-	Statement *stmt = conn->createStatement (command1);
-	ResultSet *rs = stmt->executeQuery();
-
-	while(rs->next()){
-		if(rs->getString(1) == "OSRMVELOCITYFACTOR"){ //if this registry value is pulled from DB
-			V_VEL_PT[0] =  rs->getDouble(2);
-			V_VEL_WT[0] =  rs->getDouble(2);
-			V_VEL_LT[0] =  rs->getDouble(2);
-			V_VEL_ET[0] =  rs->getDouble(2);
-			V_VEL_NT[0] =  rs->getDouble(2);
-			V_VEL_HT[0] =  rs->getDouble(2); //save into appropriate shared memory
+	for(size_t r = 0; r < oe_registry.size(); r++){
+		if(tableColumn(oe_registry[r], 1) == "OSRMVELOCITYFACTOR"){ //if this registry value is pulled from DB
+			double factor = to_number(tableColumn(oe_registry[r], 2));
+			V_VEL_PT[0] =  factor;
+			V_VEL_WT[0] =  factor;
+			V_VEL_LT[0] =  factor;
+			V_VEL_ET[0] =  factor;
+			V_VEL_NT[0] =  factor;
+			V_VEL_HT[0] =  factor; //save into appropriate shared memory
 		}
 	}
 
@@ -2829,9 +3371,6 @@ string command = "SELECT  MINDIST,MAXDIST,VEL_PT, VEL_WT,VEL_LT ,VEL_ET,VEL_NT,V
 		V_VEL_NT[0] =  defaultosrm;
 		V_VEL_HT[0] =  defaultosrm; //save into appropriate shared memory
 	}
-
-	stmt->closeResultSet(rs);
-	conn->terminateStatement(stmt);
 }
 
 
@@ -2876,386 +3415,1236 @@ bool ignore_pu_time (string igputime){
 
 
 
+int futexWait(std::atomic<int> * word, int expected, long timeout_us){
+	struct timespec timeout;
+	timeout.tv_sec = timeout_us / 1000000;
+	timeout.tv_nsec = (timeout_us % 1000000) * 1000;
+	//shared (non-private) futex: the word lives in memory mapped by several processes
+	return syscall(SYS_futex, reinterpret_cast<int *>(word), FUTEX_WAIT, expected, &timeout, NULL, 0);
+}
+
+int futexWake(std::atomic<int> * word){
+	return syscall(SYS_futex, reinterpret_cast<int *>(word), FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+//Request slots live in one boost.interprocess segment keyed by keyrnum: a RequestTable of fixed-size
+//typed slots followed by the arena that holds EDGES/TRIPIDX lists. Every process that includes this
+//file attaches lazily on first use.
+void attachRequestTable(){
+	if(request_table != NULL)
+		return;
+
+	string segmentname = "GSE_REQUESTS_" + to_string(keyrnum);
+	request_segment = new bip::managed_shared_memory(bip::open_or_create, segmentname.c_str(), sizeof(RequestTable) + REQUESTARENASIZE);
+	request_table = request_segment->find_or_construct<RequestTable>("RequestTable")();
+}
+
+int requestFunctionCode(string name){
+	for(int f = 1; f < FUNC_COUNT; f++){
+		if(name == REQUESTFUNCTIONNAMES[f])
+			return f;
+	}
+	if(DEBUG == 1) gse << "calculator.h - requestFunctionCode() unknown FUNC: " << name << endl;
+	return FUNC_NONE;
+}
+
+string formatRequestNumber(double value){
+	ostringstream ss;
+	ss << setprecision(10) << value;
+	return ss.str();
+}
+
+void freeRequestText(RequestText & text){
+	if(text.length > 0)
+		request_segment->deallocate(request_segment->get_address_from_handle(text.handle));
+	text.length = 0;
+}
+
+void storeRequestText(RequestText & text, string value){
+	freeRequestText(text);
+	if(value == "")
+		return;
+	try{
+		char *buffer = static_cast<char *>(request_segment->allocate(value.length()));
+		memcpy(buffer, value.data(), value.length());
+		text.handle = request_segment->get_handle_from_address(buffer);
+		text.length = value.length();
+	}
+	catch(bip::bad_alloc &){
+		if(DEBUG == 1) gse << "calculator.h - storeRequestText() request arena full, " << value.length() << " bytes dropped" << endl;
+		text.length = -1;
+	}
+}
+
+string loadRequestText(const RequestText & text){
+	if(text.length < 0)
+		return "ERROR";
+	if(text.length == 0)
+		return "";
+	return string(static_cast<const char *>(request_segment->get_address_from_handle(text.handle)), text.length);
+}
+
+void freeRequestNodes(RequestNodes & nodes){
+	if(nodes.count > 0)
+		request_segment->deallocate(request_segment->get_address_from_handle(nodes.handle));
+	nodes.count = 0;
+}
+
+//EDGES of slot i straight from osrm-routed's node list: a count of 0 clears the field, a negative
+//count stores the "ERROR" marker. There is no length cap besides the arena itself.
+void storeRequestNodes(int i, const std::uint64_t *nodes, int count){
+	attachRequestTable();
+	RequestSlot & slot = request_table->slot[i];
+	freeRequestNodes(slot.edges);
+	if(count == 0){
+		slot.fields &= ~REQUESTFIELD_EDGES;
+		return;
+	}
+	slot.fields |= REQUESTFIELD_EDGES;
+	if(count < 0){
+		slot.edges.count = -1;
+		return;
+	}
+	try{
+		std::uint64_t *buffer = static_cast<std::uint64_t *>(request_segment->allocate(count * sizeof(std::uint64_t)));
+		memcpy(buffer, nodes, count * sizeof(std::uint64_t));
+		slot.edges.handle = request_segment->get_handle_from_address(buffer);
+		slot.edges.count = count;
+	}
+	catch(bip::bad_alloc &){
+		if(DEBUG == 1) gse << "calculator.h - storeRequestNodes() request arena full, " << count << " nodes dropped" << endl;
+		slot.edges.count = -1;
+	}
+}
+
+//EDGES of slot i without copying or parsing: points nodes at the array in the arena and returns
+//its length, 0 if EDGES is unset and -1 for "ERROR". Valid until the slot is cleared.
+int fetchRequestNodes(int i, const std::uint64_t *& nodes){
+	attachRequestTable();
+	const RequestSlot & slot = request_table->slot[i];
+	nodes = NULL;
+	if(!(slot.fields & REQUESTFIELD_EDGES))
+		return 0;
+	if(slot.edges.count > 0)
+		nodes = static_cast<const std::uint64_t *>(request_segment->get_address_from_handle(slot.edges.handle));
+	return slot.edges.count;
+}
+
+//comma-joined decimal form of a node list, for callers still on the string API
+string formatRequestNodes(const std::uint64_t *nodes, int count){
+	if(count < 0)
+		return "ERROR";
+	string text;
+	text.reserve(count * 11);
+	for(int n = 0; n < count; n++){
+		if(n > 0)
+			text += ',';
+		text += to_string(nodes[n]);
+	}
+	return text;
+}
+
 void updateRequest(int i, string value, string type){
 
+	attachRequestTable();
+	RequestSlot & slot = request_table->slot[i];
+	int field = 0;
+
 	if(type == "FUNC"){
-		strcpy(request_function[i], value.c_str());
+		field = REQUESTFIELD_FUNC;
+		slot.function = requestFunctionCode(value);
 	}
 	if(type == "TIMESTAMP"){
-		strcpy(request_timestamp[i], value.c_str());
+		field = REQUESTFIELD_TIMESTAMP;
+		strncpy(slot.timestamp, value.c_str(), sizeof(slot.timestamp) - 1);
 	}
 	if(type == "NUM"){
-		strcpy(request_number[i], value.c_str());
+		field = REQUESTFIELD_NUM;
+		strncpy(slot.tag, value.c_str(), sizeof(slot.tag) - 1);
 	}
 	if(type == "ID"){
-		strcpy(request_id[i], value.c_str());
+		field = REQUESTFIELD_ID;
+		slot.id = (int)to_number(value);
 	}
 	if(type == "LATLONG"){
-		strcpy(request_latlon[i], value.c_str());
+		field = REQUESTFIELD_LATLONG;
+		string latlong = value;
+		slot.ncoords = 0;
+		while(latlong != "" && slot.ncoords < MAXREQUESTCOORDS){
+			slot.coords[slot.ncoords] = to_number(getNextToken(&latlong, ","));
+			slot.ncoords++;
+		}
 	}
 	if(type == "DISTANCE"){
-		strcpy(request_distance[i], value.c_str());
+		field = REQUESTFIELD_DISTANCE;
+		slot.distance = to_number(value);
 	}
 	if(type == "TIME"){
-		strcpy(request_time[i], value.c_str());
+		field = REQUESTFIELD_TIME;
+		slot.time = to_number(value);
 	}
 	if(type == "EDGES"){
-		strcpy(request_edges[i], value.c_str());
+		//the string form is only parsed here; osrm-routed stores node arrays with storeRequestNodes()
+		if(value == "ERROR"){
+			storeRequestNodes(i, NULL, -1);
+			return;
+		}
+		vector<std::uint64_t> nodes;
+		const char *cursor = value.c_str();
+		while(*cursor != '\0'){
+			char *end;
+			const std::uint64_t node = strtoull(cursor, &end, 10);
+			if(end == cursor){
+				cursor++;
+				continue;
+			}
+			nodes.push_back(node);
+			cursor = end;
+		}
+		storeRequestNodes(i, nodes.data(), nodes.size());
+		return;
 	}
 	if(type == "TRIPIDX"){
-		strcpy(request_tripidx[i], value.c_str());
+		field = REQUESTFIELD_TRIPIDX;
+		storeRequestText(slot.tripidx, value);
 	}
 	if(type == "NUMBEROFEDGES"){ //changed to radius in meters
-		strcpy(request_numberofedges[i], value.c_str());
+		field = REQUESTFIELD_NUMBEROFEDGES;
+		slot.radius = to_number(value);
+	}
+	if(type == "DEPARTURE"){
+		field = REQUESTFIELD_DEPARTURE;
+		slot.departure = (int)to_number(value);
 	}
 
+	if(value == "")
+		slot.fields &= ~field;
+	else
+		slot.fields |= field;
+
 }
 
 string fetchRequest(int i, string type){ // fetches osrm data from SHM, if it returns null, then there's no data in SHM
 
+	attachRequestTable();
+	const RequestSlot & slot = request_table->slot[i];
+
 	if(type == "NUM"){
-		return request_number[i];
+		return (slot.fields & REQUESTFIELD_NUM) ? string(slot.tag) : "";
 	}
 	if(type == "ID"){
-		return request_id[i];
+		return (slot.fields & REQUESTFIELD_ID) ? to_string(slot.id) : "";
 	}
 	if(type == "LATLONG"){
-		return request_latlon[i];
+		if(!(slot.fields & REQUESTFIELD_LATLONG))
+			return "";
+		string latlong;
+		for(int c = 0; c < slot.ncoords; c++)
+			latlong += (c == 0 ? "" : ",") + formatRequestNumber(slot.coords[c]);
+		return latlong;
 	}
 	if(type == "FUNC"){
-		return request_function[i];
+		return (slot.fields & REQUESTFIELD_FUNC) ? REQUESTFUNCTIONNAMES[slot.function] : "";
 	}
 	if(type == "DISTANCE"){
-		return request_distance[i];
+		return (slot.fields & REQUESTFIELD_DISTANCE) ? formatRequestNumber(slot.distance) : "";
 	}
 	if(type == "TIME"){
-		return request_time[i];
+		return (slot.fields & REQUESTFIELD_TIME) ? formatRequestNumber(slot.time) : "";
 	}
 	if(type == "EDGES"){
-		return request_edges[i];
+		const std::uint64_t *nodes;
+		const int count = fetchRequestNodes(i, nodes);
+		return count == 0 ? "" : formatRequestNodes(nodes, count);
 	}
 	if(type == "TRIPIDX"){
-		return request_tripidx[i];
+		return (slot.fields & REQUESTFIELD_TRIPIDX) ? loadRequestText(slot.tripidx) : "";
 	}
 	if(type == "NUMBEROFEDGES"){
-		return request_numberofedges[i];
+		return (slot.fields & REQUESTFIELD_NUMBEROFEDGES) ? formatRequestNumber(slot.radius) : "";
+	}
+	if(type == "DEPARTURE"){
+		return (slot.fields & REQUESTFIELD_DEPARTURE) ? to_string(slot.departure) : "";
 	}
 
 	return "";
 
 }
 
+//cheap typed checks for the osrm-routed dispatch loop, no string building
+int requestFunction(int i){
+	attachRequestTable();
+	return (request_table->slot[i].fields & REQUESTFIELD_FUNC) ? request_table->slot[i].function : FUNC_NONE;
+}
+
+//LATLONG without the string round trip; returns how many of the up to MAXREQUESTCOORDS values were set
+int requestCoordinates(int i, double *coords){
+	attachRequestTable();
+	const RequestSlot & slot = request_table->slot[i];
+	if(!(slot.fields & REQUESTFIELD_LATLONG))
+		return 0;
+	for(int c = 0; c < slot.ncoords; c++)
+		coords[c] = slot.coords[c];
+	return slot.ncoords;
+}
+
+//DEPARTURE as a minute of the day, -1 when the slot has none
+int requestDeparture(int i){
+	attachRequestTable();
+	const RequestSlot & slot = request_table->slot[i];
+	return (slot.fields & REQUESTFIELD_DEPARTURE) ? slot.departure : -1;
+}
 
+bool requestHas(int i, int field){
+	attachRequestTable();
+	return (request_table->slot[i].fields & field) != 0;
+}
 
 bool requestIsEmpty(int i){
 
-	string empty = "";
-	if(strcmp(request_function[i],empty.c_str()) == 0 && strcmp(request_timestamp[i],empty.c_str()) == 0
-			&& strcmp(request_number[i],empty.c_str()) == 0 && strcmp(request_id[i],empty.c_str())==0 &&
-			strcmp(request_latlon[i],empty.c_str())==0 && strcmp(request_distance[i], empty.c_str())==0 && strcmp(request_time[i], empty.c_str())==0 &&
-			strcmp(request_edges[i], empty.c_str())==0 && strcmp(request_tripidx[i], empty.c_str())==0 &&
-			strcmp(request_numberofedges[i], empty.c_str())==0){
-		return true;
+	attachRequestTable();
+	return request_table->slot[i].fields == 0;
+
+}
+
+void clearRequest(int i){
+
+	attachRequestTable();
+	RequestSlot & slot = request_table->slot[i];
+	freeRequestNodes(slot.edges);
+	freeRequestText(slot.tripidx);
+	slot.fields = 0;
+	slot.function = FUNC_NONE;
+	slot.ncoords = 0;
+	slot.tag[0] = '\0';
+	slot.timestamp[0] = '\0';
+	//only the owner's first clear puts the slot back on the free list, and only if it is not on it already
+	if(slot.state.exchange(REQUESTEMPTY) != REQUESTEMPTY && slot.queued.exchange(1) == 0){
+		while(!request_table->free_slots.TryPush(i))
+			usleep(10);
+		request_table->releases.fetch_add(1);
+		futexWake(&request_table->releases);
 	}
-	else
+}
+
+//O(1) claim of a free slot; blocks while all MAXREQUESTS slots are in flight
+int acquireRequest(){
+	attachRequestTable();
+	int i;
+	while(true){
+		int releasesseen = request_table->releases.load();
+		if(request_table->free_slots.TryPop(i)){
+			request_table->slot[i].queued.store(0);
+			int expected = REQUESTEMPTY;
+			if(request_table->slot[i].state.compare_exchange_strong(expected, REQUESTCLAIMED))
+				return i;
+			//osrm-routed adopted it from a caller that never acquired it, whose clearRequest() frees it
+			continue;
+		}
+		futexWait(&request_table->releases, releasesseen, REQUESTCLIENTWAITUS);
+	}
+}
+
+
+//Request signalling: callers fill a slot with updateRequest() and hand it over with submitRequest(),
+//osrm-routed sleeps on the submissions word until there is work and marks slots with completeRequest(),
+//callers block in waitForRequest() / waitForRequestCompletion() instead of spinning on fetchRequest().
+int requestState(int i){
+	attachRequestTable();
+	return request_table->slot[i].state.load();
+}
+
+//Only Case 3 style requests (distance/time of one lat1,lon1,lat2,lon2 pair) are cacheable;
+//Access/FindBest also return edge lists that depend on more than the two points.
+bool isTravelPairRequest(int i){
+	const RequestSlot & slot = request_table->slot[i];
+	if(!(slot.fields & REQUESTFIELD_LATLONG) || slot.ncoords != MAXREQUESTCOORDS)
 		return false;
+	return slot.function == FUNC_SLACKDIST || slot.function == FUNC_CALCDIST || slot.function == FUNC_FINDBESTDIST ||
+			slot.function == FUNC_FINDBESTDISTSINGLE || slot.function == FUNC_NEEDDIST;
+}
+
+unsigned long long travelCacheSlot(const int *key){
+	unsigned long long hash = 14695981039346656037ULL;
+	for(int c = 0; c < MAXREQUESTCOORDS; c++){
+		hash ^= (unsigned)key[c];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
 
+void quantizeTravelKey(const double *coords, int *key){
+	for(int c = 0; c < MAXREQUESTCOORDS; c++)
+		key[c] = (int)lround(coords[c] * TRAVELCACHEPRECISION);
+}
 
+//Answers asked for with a DEPARTURE minute are keyed on that minute as well: osrm-routed may have
+//routed them on the departure metric of the minute, and only it knows which minutes have one.
+bool lookupTravelCache(const double *coords, int departure, float & distance, float & time, bool & departuremetric){
+	attachRequestTable();
+	TravelCache & cache = request_table->travel_cache;
+	int key[MAXREQUESTCOORDS];
+	quantizeTravelKey(coords, key);
+	const unsigned generation = cache.generation.load();
+	const unsigned long long dataset = cache.dataset.load();
+	const unsigned long long base = travelCacheSlot(key) & ~(unsigned long long)(TRAVELCACHEWAYS - 1);
+
+	for(int w = 0; w < TRAVELCACHEWAYS; w++){
+		TravelCacheEntry & entry = cache.entry[(base + w) & (TRAVELCACHESIZE - 1)];
+		const unsigned before = entry.version.load(std::memory_order_acquire);
+		if(before == 0 || (before & 1))
+			continue;
+		bool match = entry.generation == generation && entry.dataset == dataset && memcmp(entry.key, key, sizeof(key)) == 0 && entry.departure == departure;
+		float cacheddistance = entry.distance;
+		float cachedtime = entry.time;
+		bool cacheddeparturemetric = entry.departuremetric;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if(match && entry.version.load(std::memory_order_relaxed) == before){
+			distance = cacheddistance;
+			time = cachedtime;
+			departuremetric = cacheddeparturemetric;
+			cache.hits.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	cache.misses.fetch_add(1, std::memory_order_relaxed);
+	return false;
 }
 
-void clearRequest(int i){
-	string empty = "";
-
-	strcpy(request_function[i],empty.c_str());
-	strcpy(request_timestamp[i], empty.c_str());
-	strcpy(request_number[i], empty.c_str());
-	strcpy(request_id[i],empty.c_str());
-	strcpy(request_latlon[i], empty.c_str());
-	strcpy(request_distance[i], empty.c_str());
-	strcpy(request_time[i], empty.c_str());
-	strcpy(request_edges[i], empty.c_str());
-	strcpy(request_tripidx[i], empty.c_str());
-	strcpy(request_numberofedges[i], empty.c_str());
+//dataset is travelCacheDataset() from before the answer was routed; if osrm-routed has moved to
+//another dataset since, the answer may come from the old one and is dropped
+void storeTravelCache(const double *coords, int departure, float distance, float time, bool departuremetric, unsigned long long dataset){
+	attachRequestTable();
+	TravelCache & cache = request_table->travel_cache;
+	if(dataset != cache.dataset.load())
+		return;
+	int key[MAXREQUESTCOORDS];
+	quantizeTravelKey(coords, key);
+	const unsigned generation = cache.generation.load();
+	const unsigned long long hash = travelCacheSlot(key);
+	const unsigned long long base = hash & ~(unsigned long long)(TRAVELCACHEWAYS - 1);
+
+	//reuse the entry holding this key or a stale one, otherwise evict a pseudo-random way
+	int victim = (hash >> 32) % TRAVELCACHEWAYS;
+	for(int w = 0; w < TRAVELCACHEWAYS; w++){
+		TravelCacheEntry & entry = cache.entry[(base + w) & (TRAVELCACHESIZE - 1)];
+		if(entry.version.load() == 0 || entry.generation != generation || entry.dataset != dataset || (memcmp(entry.key, key, sizeof(key)) == 0 && entry.departure == departure)){
+			victim = w;
+			break;
+		}
+	}
+
+	TravelCacheEntry & entry = cache.entry[(base + victim) & (TRAVELCACHESIZE - 1)];
+	unsigned version = entry.version.load();
+	if((version & 1) || !entry.version.compare_exchange_strong(version, version + 1))
+		return; //another writer owns the entry, dropping one store is harmless
+	std::atomic_thread_fence(std::memory_order_release);
+	entry.generation = generation;
+	entry.dataset = dataset;
+	memcpy(entry.key, key, sizeof(key));
+	entry.departure = departure;
+	entry.departuremetric = departuremetric;
+	entry.distance = distance;
+	entry.time = time;
+	entry.version.store(version + 2, std::memory_order_release);
 }
 
+//osrm-routed calls this whenever it (re)loads a dataset, so no answer from older data is served
+void invalidateTravelCache(){
+	attachRequestTable();
+	request_table->travel_cache.generation.fetch_add(1);
+}
 
+//the shared dataset osrm-routed answers from; entries tagged with any other one are misses
+unsigned long long travelCacheDataset(){
+	attachRequestTable();
+	return request_table->travel_cache.dataset.load();
+}
 
+//osrm-routed: osrm-datastore loaded the dataset with these region timestamps
+void publishTravelCacheDataset(unsigned long long static_timestamp, unsigned long long updatable_timestamp){
+	attachRequestTable();
+	request_table->travel_cache.dataset.store((static_timestamp << 32) ^ updatable_timestamp);
+}
 
+//marks slot i answered and wakes whoever waits on it
+void finishRequest(int i){
+	request_table->slot[i].state.store(REQUESTDONE);
+	futexWake(&request_table->slot[i].state);
+	request_table->completions.fetch_add(1);
+	futexWake(&request_table->completions);
+}
 
-void getTimeZone(Environment* env ,Connection* conn){
+void submitRequest(int i){
+	attachRequestTable();
+	//repeated stop pairs are answered from the travel cache without a round trip to osrm-routed
+	RequestSlot & slot = request_table->slot[i];
+	bool departuremetric;
+	if(isTravelPairRequest(i) && lookupTravelCache(slot.coords, requestDeparture(i), slot.distance, slot.time, departuremetric)){
+		slot.fields |= REQUESTFIELD_DISTANCE | REQUESTFIELD_TIME;
+		if(departuremetric)
+			slot.fields |= REQUESTFIELD_DEPARTUREMETRIC;
+		finishRequest(i);
+		return;
+	}
+	slot.sequence = request_table->sequence.fetch_add(1);
+	request_table->slot[i].state.store(REQUESTSUBMITTED);
+	while(!request_table->pending.TryPush(i))
+		usleep(10);
+	request_table->submissions.fetch_add(1);
+	futexWake(&request_table->submissions);
+}
 
-	int i = 0;
-	string zonestr;
+//Callers written before submitRequest() fill a slot they found with requestIsEmpty() and poll
+//fetchRequest() for the answer without submitting it. osrm-routed runs this whenever it finds no
+//submitted work and queues such slots as if they had been submitted, in slot order.
+int adoptUnsubmittedRequests(){
+	attachRequestTable();
+	int adopted = 0;
+	for(int i = 0; i < MAXREQUESTS; i++){
+		RequestSlot & slot = request_table->slot[i];
+		if(!(slot.fields & REQUESTFIELD_FUNC) || slot.state.load() != REQUESTEMPTY)
+			continue;
+		int expected = REQUESTEMPTY;
+		if(!slot.state.compare_exchange_strong(expected, REQUESTSUBMITTED))
+			continue;
+		slot.sequence = request_table->sequence.fetch_add(1);
+		while(!request_table->pending.TryPush(i))
+			usleep(10);
+		adopted++;
+	}
+	if(adopted > 0 && DEBUG == 1) gse << "calculator.h - adoptUnsubmittedRequests() queued " << adopted << " unsubmitted slots" << endl;
+	return adopted;
+}
 
+//submission order of slot i, see RequestSlot::sequence
+unsigned long long requestSequence(int i){
+	attachRequestTable();
+	return request_table->slot[i].sequence;
+}
 
+//WRITINGFB in shared_process_tab tells osrm-routed a caller is still writing the legs of a
+//multi-leg request. Its writers in every thread and process take the request table's mutex
+//first, so two of them can no longer both see READY and claim the flag; the wait for READY covers
+//writers that do not take the mutex. Single-pair requests are served on their own and leave the
+//flag alone.
+void lockWritingFB(string owner){
+	attachRequestTable();
+	request_table->writingfb.lock();
+	while(strcmp(shared_process_tab[WRITINGFB][0], "READY") != 0)
+		usleep(100);
+	strcpy(shared_process_tab[WRITINGFB][0], owner.c_str());
+}
 
+void unlockWritingFB(){
+	strcpy(shared_process_tab[WRITINGFB][0], "READY");
+	request_table->writingfb.unlock();
+}
 
-	string command = "SELECT  ZONE, starttime, endtime FROM   ITMS_TIME_ZONES where zone not like '%-%'"      ;// WHERE " +  to_string(itms_to_minutes (ampm2fullhrs (p_eta))) + " BETWEEN starttime AND endtime union select '*' from    ITMS_TIME_ZONES WHERE  not exists (SELECT  ZONE FROM   ITMS_TIME_ZONES WHERE " +   to_string(itms_to_minutes (ampm2fullhrs (p_eta))) + " BETWEEN starttime AND endtime) and rownum <= 1";
+//dataset is travelCacheDataset() from before osrm-routed routed slot i
+void completeRequest(int i, unsigned long long dataset){
+	attachRequestTable();
+	const RequestSlot & slot = request_table->slot[i];
+	if(isTravelPairRequest(i) && (slot.fields & REQUESTFIELD_DISTANCE) && (slot.fields & REQUESTFIELD_TIME) && !(slot.fields & REQUESTFIELD_ESTIMATE))
+		storeTravelCache(slot.coords, requestDeparture(i), slot.distance, slot.time, (slot.fields & REQUESTFIELD_DEPARTUREMETRIC) != 0, dataset);
+	finishRequest(i);
+}
 
-	Statement* stmt = conn->createStatement (command);
-	ResultSet * rset = stmt->executeQuery();
+void completeRequest(int i){
+	completeRequest(i, travelCacheDataset());
+}
 
-	while(rset->next()){
-		zonestr = rset->getString(1);
-		strcpy(zone[i], zonestr.c_str());
-		starttime[i] = rset->getInt(2);
-		endtime[i] = rset->getInt(3);
-		//  if(DEBUG == 1) gse << rset->getInt(3) << endl;
-		i++;
+//osrm-routed: the answer of slot i is the straight-line fallback of a pair it could not route.
+//The caller still gets it, but it is not cached, so the pair is routed again next time.
+void markRequestEstimate(int i){
+	attachRequestTable();
+	request_table->slot[i].fields |= REQUESTFIELD_ESTIMATE;
+}
 
+//osrm-routed: the engine answered slot i from the departure metric of its DEPARTURE minute
+void markRequestDepartureMetric(int i){
+	attachRequestTable();
+	request_table->slot[i].fields |= REQUESTFIELD_DEPARTUREMETRIC;
+}
 
+void waitForRequest(int i){
+	attachRequestTable();
+	int state;
+	while((state = request_table->slot[i].state.load()) != REQUESTDONE){
+		futexWait(&request_table->slot[i].state, state, REQUESTCLIENTWAITUS);
 	}
+}
 
-	/*for(int p = 0; p < i;p++){
-                                 if(DEBUG == 1) gse << zone[p] << " " << p << " " << starttime[p] << " " <<  endtime[p] << endl;
-                            }*/
+//waitForRequest() that gives up after seconds; false if slot i was not answered by then
+bool waitForRequestFor(int i, int seconds){
+	attachRequestTable();
+	const time_t deadline = time(NULL) + seconds;
+	int state;
+	while((state = request_table->slot[i].state.load()) != REQUESTDONE){
+		if(time(NULL) >= deadline)
+			return false;
+		futexWait(&request_table->slot[i].state, state, REQUESTCLIENTWAITUS);
+	}
+	return true;
+}
 
+//osrm-routed side: submitted slots come off the pending FIFO oldest first
+bool nextRequest(int & i){
+	attachRequestTable();
+	return request_table->pending.TryPop(i);
+}
 
-	stmt->closeResultSet(rset);
-	conn->terminateStatement(stmt);
+int requestsPending(){
+	attachRequestTable();
+	return request_table->pending.ApproximateSize();
+}
 
+//only one osrm-routed worker wins a submitted slot
+bool claimRequest(int i){
+	int expected = REQUESTSUBMITTED;
+	return request_table->slot[i].state.compare_exchange_strong(expected, REQUESTPROCESSING);
+}
 
+//a slot that could not be served yet (e.g. WRITINGFB not READY) goes to the back of the queue
+void requeueRequest(int i){
+	request_table->slot[i].state.store(REQUESTSUBMITTED);
+	while(!request_table->pending.TryPush(i))
+		usleep(10);
+}
 
+int requestCompletions(){
+	attachRequestTable();
+	return request_table->completions.load();
 }
 
-string timeZones(string p_eta, string p_promised_time){
-	if(DEBUG == 1) gse << "begin calculator.h - timeZones(), p_promised_time: " << p_promised_time << endl;
+void waitForRequestCompletion(int seen){
+	attachRequestTable();
+	futexWait(&request_table->completions, seen, REQUESTCLIENTWAITUS);
+}
 
-	int timeint;
-	string time_zone;
+int requestSubmissions(){
+	attachRequestTable();
+	return request_table->submissions.load();
+}
 
+void waitForRequestSubmission(int seen){
+	attachRequestTable();
+	futexWait(&request_table->submissions, seen, REQUESTSERVERWAITUS);
+}
 
+//The stop index lives in its own segment keyed by keyrnum and is created by whichever process
+//needs it first; refreshStopIndex() moves rows whose coordinates changed since they were indexed.
+void attachStopIndex(){
+	if(stop_index != NULL)
+		return;
+	string segmentname = "GSE_STOPINDEX_" + to_string(keyrnum);
+	stop_index_segment = new bip::managed_shared_memory(bip::open_or_create, segmentname.c_str(), sizeof(StopIndex) + 65536);
+	stop_index = stop_index_segment->find_or_construct<StopIndex>("StopIndex")();
+}
 
-	/* if (p_promised_time.substr(0, 4) == "0000")
-                {
+//lat/lon of a trip index exactly as to_number() parses columns 10 and 37
+void stopCoords(int tripidx, double & lat, double & lon){
+	lat = tripNumber(tripidx, LAT);
+	lon = tripNumber(tripidx, LON);
+}
 
-                       stringstream p_etass(to_string(itms_to_minutes (ampm2fullhrs (p_eta))));
-                     p_etass >> timeint;
-                }*/
-	//else{
+//Moves the row to the grid cell of its current coordinates. Rows cleared by RemoveTrip() are
+//indexed at 0/0 like to_number() parses them.
+void indexStop(int tripidx){
+	attachStopIndex();
+	double lat, lon;
+	stopCoords(tripidx, lat, lon);
+	bip::scoped_lock<bip::interprocess_mutex> lock(stop_index->mutex);
+	stop_index->grid.insert(tripidx, lat, lon);
+}
 
-	stringstream p_etass(to_string(itms_to_minutes (ampm2fullhrs (p_promised_time))));
-	p_etass >> timeint;
-	//}
+bool stopIndexEntryCurrent(int tripidx){
+	double lat, lon;
+	stopCoords(tripidx, lat, lon);
+	return stop_index->grid.containsAt(tripidx, lat, lon);
+}
 
-	if(DEBUG == 1) gse << "begin calculator.h - timeZones(), timeint: " << timeint << endl;
+//Brings every row up to date with schd_tab; buildTree() runs it once the day is loaded and the
+//grid queries expect their callers to run it before searching.
+void refreshStopIndex(){
+	attachStopIndex();
+	int indexed = 0;
+	for(int d = 0; d < MAXTRIPIDX; d++){
+		if(!stopIndexEntryCurrent(d)){
+			indexStop(d);
+			indexed++;
+		}
+	}
+	if(DEBUG == 1) gse << "calculator.h - refreshStopIndex() " << indexed << " rows indexed" << endl;
+}
 
+//Trip indices within miles of lat/lon, ascending, as of the last refreshStopIndex()
+void stopsInRadius(double lat, double lon, double miles, vector<int> & tripidxes){
+	attachStopIndex();
+	bip::scoped_lock<bip::interprocess_mutex> lock(stop_index->mutex);
+	stop_index->grid.withinRadius(lat, lon, miles, tripidxes);
+}
 
+//Up to k trip indices closest to lat/lon, closest first (ties by trip index), as of the last
+//refreshStopIndex()
+void nearestStops(double lat, double lon, int k, vector<int> & tripidxes){
+	attachStopIndex();
+	bip::scoped_lock<bip::interprocess_mutex> lock(stop_index->mutex);
+	stop_index->grid.nearest(lat, lon, k, tripidxes);
+}
 
+//Trip indices 1 to rows-1 in the order a candidate search visits them: the k nearest to lat/lon
+//first, then the others in index order. A stale index only changes the order, never the set.
+void nearestFirstOrder(double lat, double lon, int rows, int k, vector<int> & order){
+	vector<int> nearest;
+	nearestStops(lat, lon, k, nearest);
+	vector<bool> taken(rows, false);
+	order.clear();
+	for(size_t n = 0; n < nearest.size(); n++){
+		if(nearest[n] >= 1 && nearest[n] < rows && !taken[nearest[n]]){
+			taken[nearest[n]] = true;
+			order.push_back(nearest[n]);
+		}
+	}
+	for(int d = 1; d < rows; d++)
+		if(!taken[d])
+			order.push_back(d);
+}
 
-	/*if (p_promised_time.substr(0, 4) == "0000")
-                         {
-                             if (timeint > 1439){ ///////////////////why?
-                            p_eta = "1439";
-                             }
+//The stop matrix lives in its own segment keyed by keyrnum. The building scheduler and osrm-routed
+//create it; lookups only attach once it exists and retry at most once a second until then.
+bool attachStopMatrix(bool create){
+	if(stop_matrix != NULL)
+		return true;
 
-                             int petainteger = itms_to_minutes (ampm2fullhrs (p_eta));
-                             int z = 0;
-                             for (int k = 0; k<15;k++){
-                                    if(petainteger < endtime[k] && petainteger >= starttime[k]){
-                                            z = k;
-                                            break;
-                                    }
-                            }
+	std::lock_guard<std::mutex> lock(stop_matrix_attach_mutex);
+	if(stop_matrix != NULL)
+		return true;
+	string segmentname = "GSE_STOPMATRIX_" + to_string(keyrnum);
+	if(create){
+		stop_matrix_segment = new bip::managed_shared_memory(bip::open_or_create, segmentname.c_str(), sizeof(StopMatrix) + 65536);
+		stop_matrix = stop_matrix_segment->find_or_construct<StopMatrix>("StopMatrix")();
+		return true;
+	}
 
-                            time_zone = zone[z];
-                           //  if(DEBUG == 1) gse << " Z  1 is " << z << " " << time_zone <<  endl;
+	time_t now = time(NULL);
+	if(now == stop_matrix_checked)
+		return false;
+	stop_matrix_checked = now;
+	try{
+		stop_matrix_segment = new bip::managed_shared_memory(bip::open_only, segmentname.c_str());
+	}
+	catch(bip::interprocess_exception &){
+		return false;
+	}
+	stop_matrix = stop_matrix_segment->find<StopMatrix>("StopMatrix").first;
+	if(stop_matrix == NULL){
+		delete stop_matrix_segment;
+		stop_matrix_segment = NULL;
+		return false;
+	}
+	return true;
+}
 
-                         }*/
-	//else{
-	if (timeint > 1439){
-		p_promised_time = "1439";
+//rows edited or inserted since the build no longer match their key and go back to osrm-routed
+bool stopMatrixRowCurrent(int tripidx){
+	if(stop_matrix->stop[tripidx] < 0)
+		return false;
+	double lat, lon;
+	stopCoords(tripidx, lat, lon);
+	return stop_matrix->key[tripidx][0] == (int)lround(lat * TRAVELCACHEPRECISION) &&
+			stop_matrix->key[tripidx][1] == (int)lround(lon * TRAVELCACHEPRECISION);
+}
+
+//Answers a CalcDist between two trip indices from the stop matrix; false if there is no current
+//matrix for them and the caller has to ask osrm-routed.
+bool lookupStopMatrix(int from, int to, float & distance, float & time){
+	if(from < 0 || from >= MAXTRIPIDX || to < 0 || to >= MAXTRIPIDX || !attachStopMatrix(false))
+		return false;
+	const unsigned before = stop_matrix->version.load(std::memory_order_acquire);
+	if(before == 0 || (before & 1))
+		return false;
+	attachRequestTable();
+	if(stop_matrix->generation != request_table->travel_cache.generation.load() || stop_matrix->dataset != request_table->travel_cache.dataset.load())
+		return false;
+	if(!stopMatrixRowCurrent(from) || !stopMatrixRowCurrent(to))
+		return false;
+	const StopMatrixCell cell = stop_matrix->cell[stop_matrix->stop[from]][stop_matrix->stop[to]];
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if(stop_matrix->version.load(std::memory_order_relaxed) != before || cell.time < 0)
+		return false;
+	distance = cell.distance;
+	time = cell.time;
+	return true;
+}
+
+//Called by the building scheduler once it stops waiting and by osrm-routed once it answered the
+//build request; whichever comes second clears the slot.
+void releaseStopMatrixRequest(int q){
+	if(stop_matrix->handoff.exchange(1) == 1)
+		clearRequest(q);
+}
+
+//Optional load phase: collects the unique stops of the day from schd_tab and has osrm-routed fill
+//the stop-to-stop matrix with parallel many-to-many searches. getTime(), getDist(),
+//getActualDistance() and getTravTime() then answer from the matrix instead of a request slot.
+void buildStopMatrix(){
+	attachStopMatrix(true);
+	unsigned version = stop_matrix->version.load();
+	if((version & 1) || !stop_matrix->version.compare_exchange_strong(version, version + 1)){
+		if(DEBUG == 1) gse << "calculator.h - buildStopMatrix() another build is running" << endl;
+		return;
 	}
 
+	map<pair<int, int>, int> stops;
+	stop_matrix->nstops = 0;
+	for(int d = 0; d < MAXTRIPIDX; d++){
+		stop_matrix->stop[d] = -1;
+		if(strcmp(schd_tab[d][10], "") == 0 || strcmp(schd_tab[d][37], "") == 0)
+			continue;
+		const double lat = tripNumber(d, 10);
+		const double lon = tripNumber(d, 37);
+		const pair<int, int> key((int)lround(lat * TRAVELCACHEPRECISION), (int)lround(lon * TRAVELCACHEPRECISION));
+		stop_matrix->key[d][0] = key.first;
+		stop_matrix->key[d][1] = key.second;
+		map<pair<int, int>, int>::iterator found = stops.find(key);
+		if(found == stops.end()){
+			found = stops.insert(make_pair(key, stop_matrix->nstops)).first;
+			stop_matrix->coords[stop_matrix->nstops][0] = lat;
+			stop_matrix->coords[stop_matrix->nstops][1] = lon;
+			stop_matrix->nstops++;
+		}
+		stop_matrix->stop[d] = found->second;
+	}
+	if(DEBUG == 1) gse << "calculator.h - buildStopMatrix() " << stop_matrix->nstops << " unique stops" << endl;
+
+	int q = acquireRequest();
+	updateRequest(q, "buildStopMatrix", "NUM");
+	updateRequest(q, REQUESTFUNCTIONNAMES[FUNC_BUILDSTOPMATRIX], "FUNC");
+	stop_matrix->handoff.store(0);
+	submitRequest(q);
+	//lookups keep going to osrm-routed pair by pair until the matrix is published, so a slow
+	//or stalled osrm-routed only costs the speed-up; it still publishes the matrix when it is done
+	const bool done = waitForRequestFor(q, STOPMATRIXWAIT);
+	releaseStopMatrixRequest(q);
+	if(!done){
+		gse << "calculator.h - buildStopMatrix() no matrix after " << STOPMATRIXWAIT << " seconds, going on without it" << endl;
+		return;
+	}
+	if(DEBUG == 1) gse << "calculator.h - buildStopMatrix() done, version " << stop_matrix->version.load() << endl;
+}
 
-	int promiseinteger = itms_to_minutes (ampm2fullhrs (p_promised_time));
+//Attaches avl_tops read-only for the lifetime of the process instead of once per lookup
+bool attachAvlTops(){
+	if(avl_tops != NULL)
+		return true;
 
-	int z = 0;
-	for (int k = 0; k<MAXZONES;k++){
-		if(promiseinteger <= endtime[k] && promiseinteger >= starttime[k]){
+	std::lock_guard<std::mutex> lock(avl_tops_attach_mutex);
+	if(avl_tops != NULL)
+		return true;
+	time_t now = time(NULL);
+	if(now == avl_tops_checked)
+		return false;
+	avl_tops_checked = now;
+	int shmid_a = shmget(key_avl_tops, sizeof(char[MAXSEGMENTS][MAXAVLTOPSCOLUMNSIZE][MAXLGSTRSIZE]), 0666);
+	if(shmid_a < 0)
+		return false;
+	void *address = shmat(shmid_a, 0, SHM_RDONLY);
+	if(address == (void *)-1)
+		return false;
+	if(DEBUG == 1) gse << "calculator.h - attachAvlTops() shmid_a: " << shmid_a << ", key_avl_tops: " << key_avl_tops << endl;
+	avl_tops = (char(*)[MAXAVLTOPSCOLUMNSIZE][MAXLGSTRSIZE])address;
+	return true;
+}
 
-			// if(DEBUG == 1) gse << starttime[k] << " " << endtime[k] << endl;
-			z = k;
-			if(DEBUG == 1) gse << "calculator.h - timeZones() z = k = " << z << ", promiseinteger:" << promiseinteger << 
-				", endtime[k]: " << endtime[k] << ", starttime[k]: " << starttime[k] << endl;
+//Row of the segment's latest fix in avl_tops, -1 if there is none; the table ends at the first blank row
+int findAvlTopsRow(string segment){
+	if(!attachAvlTops())
+		return -1;
+	for(int x = 0; x < MAXSEGMENTS; x++){
+		if(strcmp(avl_tops[x][0], "") == 0)
 			break;
+		if(segment == avl_tops[x][0])
+			return x;
+	}
+	return -1;
+}
+
+void attachVehicleTracks(){
+	if(vehicle_tracks != NULL)
+		return;
+
+	std::lock_guard<std::mutex> lock(vehicle_tracks_attach_mutex);
+	if(vehicle_tracks != NULL)
+		return;
+	string segmentname = "GSE_VEHICLETRACKS_" + to_string(keyrnum);
+	vehicle_tracks_segment = new bip::managed_shared_memory(bip::open_or_create, segmentname.c_str(), sizeof(VehicleTracks) + 65536);
+	vehicle_tracks = vehicle_tracks_segment->find_or_construct<VehicleTracks>("VehicleTracks")();
+}
+
+//FNV-1a, so every process probes the same tracks for a segment id
+int vehicleTrackSlot(string segment){
+	unsigned hash = 2166136261u;
+	for(size_t c = 0; c < segment.length(); c++)
+		hash = (hash ^ (unsigned char)segment[c]) * 16777619u;
+	return hash % MAXSEGMENTS;
+}
+
+//Takes the seqlock of a claimed track and returns the even version it had
+unsigned lockVehicleTrack(VehicleTrack & track){
+	while(true){
+		unsigned version = track.version.load();
+		if(!(version & 1) && track.version.compare_exchange_weak(version, version + 1))
+			return version;
+		std::this_thread::yield();
+	}
+}
+
+//Copies a track without locking it; false if the track was never claimed
+bool readVehicleTrack(int t, VehicleTrackData & data){
+	VehicleTrack & track = vehicle_tracks->track[t];
+	while(true){
+		const unsigned before = track.version.load(std::memory_order_acquire);
+		if(before == 0)
+			return false;
+		if(!(before & 1)){
+			memcpy(&data, &track.data, sizeof(data));
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if(track.version.load(std::memory_order_relaxed) == before)
+				return true;
+		}
+		std::this_thread::yield();
+	}
+}
+
+//Track of the segment id, claiming a free one along its probe sequence if asked to; -1 if there is none
+int findVehicleTrack(string segment, bool claim){
+	attachVehicleTracks();
+	if(segment == "" || segment.length() >= (size_t)MAXLGSTRSIZE)
+		return -1;
+	const int first = vehicleTrackSlot(segment);
+	for(int probe = 0; probe < MAXSEGMENTS; probe++){
+		VehicleTrack & track = vehicle_tracks->track[(first + probe) % MAXSEGMENTS];
+		unsigned version = track.version.load();
+		if(version == 0){
+			if(!claim)
+				return -1;
+			if(!track.version.compare_exchange_strong(version, 1)){
+				probe--; //another process claimed it first, look at it again
+				continue;
+			}
+			memset(&track.data, 0, sizeof(track.data));
+			strcpy(track.data.segment, segment.c_str());
+			track.version.store(2, std::memory_order_release);
+			return (first + probe) % MAXSEGMENTS;
 		}
+		//the segment id is only written while the track is claimed
+		while(track.version.load(std::memory_order_acquire) == 1)
+			std::this_thread::yield();
+		if(strcmp(track.data.segment, segment.c_str()) == 0)
+			return (first + probe) % MAXSEGMENTS;
+	}
+	return -1;
+}
+
+//Asks osrm-routed to keep ETAs for the remaining stops of the segment, in route order. The same list
+//again is a read; another list makes osrm-routed route it from the next matched position.
+void trackVehicle(string segment, const vector<pair<double, double> > & stops){
+	const int t = findVehicleTrack(segment, true);
+	if(t < 0){
+		if(DEBUG == 1) gse << "calculator.h - trackVehicle() no free track for segment " << segment << endl;
+		return;
+	}
+	const int nstops = min((int)stops.size(), MAXTRACKEDSTOPS);
+	int key[MAXTRACKEDSTOPS][2];
+	for(int s = 0; s < nstops; s++){
+		key[s][0] = (int)lround(stops[s].first * TRAVELCACHEPRECISION);
+		key[s][1] = (int)lround(stops[s].second * TRAVELCACHEPRECISION);
 	}
 
-	time_zone = zone[z];
-	// if(DEBUG == 1) gse << " Z 2 is " <<  z << " " << time_zone << endl;
-	// }
+	VehicleTrackData data;
+	if(readVehicleTrack(t, data) && data.requested > 0 && data.nstops == nstops && memcmp(data.key, key, nstops * sizeof(key[0])) == 0)
+		return;
 
-	return time_zone;
-	if(DEBUG == 1) gse << "end calculator.h - timeZones() returning: " << time_zone << endl;
+	VehicleTrack & track = vehicle_tracks->track[t];
+	const unsigned version = lockVehicleTrack(track);
+	track.data.nstops = nstops;
+	for(int s = 0; s < nstops; s++){
+		track.data.key[s][0] = key[s][0];
+		track.data.key[s][1] = key[s][1];
+		track.data.coords[s][0] = stops[s].first;
+		track.data.coords[s][1] = stops[s].second;
+		track.data.eta[s] = -1;
+	}
+	track.data.requested++;
+	track.version.store(version + 2, std::memory_order_release);
+	if(DEBUG == 1) gse << "calculator.h - trackVehicle() segment " << segment << ", " << nstops << " stops, request " << track.data.requested << endl;
 }
 
-#include <occi.h>
+//osrm-routed: stores the ETAs routed from the fix record_time for the stops the track had at
+//requested; false, and nothing stored, if a scheduler registered other stops in the meantime
+bool publishVehicleTrack(int t, unsigned requested, string record_time, double lat, double lon, const vector<float> & etas){
+	VehicleTrack & track = vehicle_tracks->track[t];
+	const unsigned version = lockVehicleTrack(track);
+	const bool current = track.data.requested == requested && (int)etas.size() == track.data.nstops && record_time.length() < (size_t)MAXLGSTRSIZE;
+	if(current){
+		track.data.answered = requested;
+		strcpy(track.data.record_time, record_time.c_str());
+		track.data.matched[0] = lat;
+		track.data.matched[1] = lon;
+		for(int s = 0; s < track.data.nstops; s++)
+			track.data.eta[s] = etas[s];
+	}
+	track.version.store(version + 2, std::memory_order_release);
+	return current;
+}
 
-void gse_update(string client, string date){
+//The segment's track as gse_monitor shows it: matched position and ETA to each remaining stop, no syscalls
+bool fetchVehicleTrack(string segment, VehicleTrackData & data){
+	const int t = findVehicleTrack(segment, false);
+	return t >= 0 && readVehicleTrack(t, data);
+}
 
+//ETA in minutes, rounded as the TIME of a request, from the segment's fix record_time to the first of
+//stops. False unless stops is the list registered with trackVehicle() and osrm-routed has already
+//routed it from exactly that fix; a later stop of the list would be timed via the stops before it.
+bool lookupVehicleEta(string segment, string record_time, const vector<pair<double, double> > & stops, int & minutes){
+	VehicleTrackData data;
+	if(stops.empty() || !fetchVehicleTrack(segment, data))
+		return false;
+	if(data.requested == 0 || data.answered != data.requested || record_time != data.record_time)
+		return false;
+	if(data.nstops != min((int)stops.size(), MAXTRACKEDSTOPS))
+		return false;
+	for(int s = 0; s < data.nstops; s++){
+		if(data.key[s][0] != (int)lround(stops[s].first * TRAVELCACHEPRECISION) || data.key[s][1] != (int)lround(stops[s].second * TRAVELCACHEPRECISION))
+			return false;
+	}
+	if(data.eta[0] < 0)
+		return false;
+	minutes = (int)ceil(data.eta[0] / 60);
+	return true;
+}
 
+//Stops tracking the segment once its run is over: the track keeps its slot but has no stops and no
+//request, so osrm-routed leaves it alone until a scheduler registers stops for it again
+void releaseVehicleTrack(string segment){
+	const int t = findVehicleTrack(segment, false);
+	if(t < 0)
+		return;
+	VehicleTrack & track = vehicle_tracks->track[t];
+	const unsigned version = lockVehicleTrack(track);
+	const bool tracked = track.data.requested > 0;
+	track.data.requested = 0;
+	track.data.answered = 0;
+	track.data.nstops = 0;
+	track.data.record_time[0] = '\0';
+	track.version.store(version + 2, std::memory_order_release);
+	if(DEBUG == 1 && tracked) gse << "calculator.h - releaseVehicleTrack() segment " << segment << endl;
+}
 
-	if(DEBUG == 1) gse << "Trying to connect to database " << endl;
-	//  if(DEBUG == 1) gse << p_AMBLOAD[0] <<endl;
-	// These will be passed as a parameter and not hard-coded
-	Environment* env = Environment::createEnvironment();
-	Connection* conn = env->createConnection( username, password, connectString );
 
-	if(DEBUG == 1) gse << "Environment and Connection created" << endl;
 
-	string aLabel = "";
-	string  command = "SELECT * FROM itms_registry WHERE VARIABLEDATE = '01-JAN-2001' order by scheduler"; ////////for all zones
-	int cc = 0;
-	Statement * stmt;
-	ResultSet * rs;
-	try {
-		if(DEBUG == 1) gse << command << endl;
-		stmt = conn->createStatement (command);
-		aLabel = "before executing above query";
-		rs = stmt->executeQuery();
-		aLabel = "after executing above query";
-		if(DEBUG == 1) gse << aLabel << endl;
-		if(DEBUG == 1) gse << rs->status() << " ;row count:" << rs->getNumArrayRows() << endl;
-		int y = 0;
-		int wl = 0;
-		size_t aSize = sizeof(V_VEL_PT)/sizeof(V_VEL_PT[0]);
-		if(DEBUG == 1) gse << "aSize: " << aSize << endl;
-		for(size_t i = 0; i < aSize; i++)
-		{
-			// if(DEBUG == 1) gse << "V_VEL_PT[i]: " << V_VEL_PT[i] << endl;
-		}
-		size_t bSize = sizeof(starttime)/sizeof(starttime[0]);
-		if(DEBUG == 1) gse << "bSize: " << bSize << endl;
-		for(size_t i = 0; i < bSize; i++)
-		{
-			// if(DEBUG == 1) gse << "starttime[i]: " <<  starttime[i] << endl;
-		}
-		size_t cSize = sizeof(p_WHEELLOAD)/sizeof(p_WHEELLOAD[0]);
-		if(DEBUG == 1) gse << "cSize: " << cSize << endl;
-		try{
-		while(rs->next()){
-			cc = 0;
-			try {
-				// if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				// if(DEBUG == 1) gse << rs->getString(1).c_str() << endl;
-				// if(DEBUG == 1) gse << rs->getString(2).c_str() << endl;
-				// if(DEBUG == 1) gse << rs->getString(3).c_str() << endl;
-				// if(DEBUG == 1) gse << rs->getString(4).c_str() << endl;
-				// if(DEBUG == 1) gse << rs->getString(5).c_str() << endl;
-				// if(DEBUG == 1) gse << rs->getInt(6) << endl;
-				// if(DEBUG == 1) gse << rs->getString(7).c_str() << endl;
-				// wl = rs->getInt(6);
-				// if(DEBUG == 1) gse << "wl: " << wl << endl;
-				// starttime[0] = 1;
-				// if(DEBUG == 1) gse << "starttime[0]: " << starttime[0] << endl;
-				// endtime[0] = 2;
-				// if(DEBUG == 1) gse << "endtime[0]: " << endtime[0] << endl;
-				// p_WHEELLOAD[y] = wl;
-				// if(DEBUG == 1) gse << "assigned p_WHEELLOAD" << endl;
-				// y++;
-				// cc++;
-				// continue;
-				p_WHEELLOAD[y] = rs->getInt(6);
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				p_AMBLOAD[y] = rs->getInt(7);
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				p_MAXEARLYDROPOFFFACTOR[y] = rs->getInt(11);
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				p_DIALRIDEEARLYPICKFACTOR[y] = rs->getInt(15);
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				p_DIALRIDELATEPICKFACTOR[y] = rs->getInt(16);
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				p_OTHEREARLYPICKFACTOR[y] = rs->getInt(17);
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				p_OTHERLATEPICKFACTOR[y] = rs->getInt(18);
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				strcpy(ignorepu[y], rs->getString(38).c_str());
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				p_SHORTBREAK[y] = rs->getInt(39);
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				p_LUNCHBREAK[y] = rs->getInt(40);
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				p_PROXIMITYFACTOR[y] = rs->getInt(42);
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				strcpy(ZONE_DESCR[y],rs->getString(43).c_str());
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				a_mediumshortdistance[y] = to_number(rs->getString(10));
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				a_shorttriptime[y] = rs->getInt(9);
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				a_longtriptime[y] = rs->getInt(8);
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				a_mediumlongdistance[y] = to_number(rs->getString(32));
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				a_mediumtriptime[y] = rs->getInt(33);
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				a_extra_loadtime[y] = rs->getInt(47);
-				cc++;
-				if(DEBUG == 1) gse << "y is " << y << "; cc is " << cc << endl;
-				y++;
-			}
-			catch(...)
-			{
-				if(DEBUG == 1) gse << "Exception parsing result from - " << command << " ; y is " << y << "; cc is " << cc << endl;
-			}
-		}
-		}catch(...){
-			if(DEBUG == 1) gse << "error fetching data from itms_registry in gse_update()" << endl;
-		}
-		aLabel = "parsed all dataset, before closing result set";
-		if(DEBUG == 1) gse << aLabel << endl;
 
-		stmt->closeResultSet(rs);
-		aLabel = "before terminating statement";
-		conn->terminateStatement(stmt);
-		aLabel = "after terminating statement";
+
+//Rows of ITMS_TIME_ZONES as (zone, starttime, endtime)
+void getTimeZone(const TableRows & time_zones){
+
+	for(size_t i = 0; i < time_zones.size(); i++){
+		strcpy(zone[i], tableColumn(time_zones[i], 1).c_str());
+		starttime[i] = tableInt(time_zones[i], 2);
+		endtime[i] = tableInt(time_zones[i], 3);
 	}
-	catch(...)
-	{
-		if(DEBUG == 1) gse << "Exception executing query - " << command << "; aLabel is " << aLabel << endl;
+}
+
+//Zone and velocity factor of every minute of the day, from the time zones and V_VEL_* factors the
+//registry load puts in shared memory. Every process builds it on first use after gse_update()
+//published the registry and rebuilds the same instance in place once gse_update() published a
+//newer one. Lookups copy the minute they need out of it under the seqlock, so none of them holds
+//on to the profile while it is rebuilt.
+struct VelocityProfile{
+	std::atomic<unsigned> version; //seqlock: odd while loadVelocityProfile() rebuilds it
+	std::atomic<unsigned> generation; //registry_generation it was built from, 0 before the first build
+	signed char zone[MINUTESPERDAY];
+	double factor[MINUTESPERDAY];
+};
+VelocityProfile velocity_profile;
+std::mutex velocity_profile_mutex;
+
+//First zone whose starttime..endtime holds minute; zone 0 when none does
+int searchTimeZone(DayMinute minute){
+	for (int k = 0; k<MAXZONES;k++)
+		if(minute <= endtime[k] && minute >= starttime[k])
+			return k;
+	return 0;
+}
+
+//Brings the profile up to the newest registry; false while gse_update() has not published one yet
+bool loadVelocityProfile(){
+	attachRequestTable();
+	const unsigned generation = request_table->registry_generation.load(std::memory_order_acquire);
+	if(generation == 0)
+		return false;
+	if(velocity_profile.generation.load(std::memory_order_acquire) == generation)
+		return true;
+
+	std::lock_guard<std::mutex> lock(velocity_profile_mutex);
+	if(velocity_profile.generation.load(std::memory_order_relaxed) != generation){
+		//built from the registry of generation or a newer one, which the next call picks up again
+		velocity_profile.version.fetch_add(1);
+		std::atomic_thread_fence(std::memory_order_release);
+		for(DayMinute minute = 0; minute < MINUTESPERDAY; minute++){
+			velocity_profile.zone[minute] = searchTimeZone(minute);
+			velocity_profile.factor[minute] = zoneVelocityFactor(zone[velocity_profile.zone[minute]]);
+		}
+		velocity_profile.version.fetch_add(1, std::memory_order_release);
+		velocity_profile.generation.store(generation, std::memory_order_release);
+		if(DEBUG == 1) gse << "calculator.h - loadVelocityProfile() built the velocity profile of registry " << generation << endl;
+	}
+	return true;
+}
+
+//Zone and velocity factor of minute from the profile; false while there is no profile
+bool velocityProfileAt(DayMinute minute, int & minutezone, double & factor){
+	if(minute < 0 || minute >= MINUTESPERDAY || !loadVelocityProfile())
+		return false;
+	while(true){
+		const unsigned before = velocity_profile.version.load(std::memory_order_acquire);
+		if(before & 1)
+			continue; //a rebuild takes microseconds
+		minutezone = velocity_profile.zone[minute];
+		factor = velocity_profile.factor[minute];
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if(velocity_profile.version.load(std::memory_order_relaxed) == before)
+			return true;
 	}
+}
 
+//Promised times past the last minute of the day are looked up as "1439", as they always were
+DayMinute zoneLookupMinute(DayMinute minute){
+	if (minute > 1439)
+		return dayMinute("1439");
+	return minute;
+}
 
+int timeZoneIndex(DayMinute minute){
+	minute = zoneLookupMinute(minute);
+	int minutezone;
+	double factor;
+	if(velocityProfileAt(minute, minutezone, factor))
+		return minutezone;
+	return searchTimeZone(minute);
+}
 
-	string usenewcommands = "N";
-	command = "select featureid, featurevalue from itms_oe_registry where featureid = 'UPDATEDBGSE'";
-	if(DEBUG == 1) gse << command <<endl;
+//F_GET_TRAVEL_TIME(P_TRIP_TIME, timeZones("", time of minute), "*") as one table lookup
+int travelTimeAt(int P_TRIP_TIME, DayMinute minute){
+	minute = zoneLookupMinute(minute);
+	int minutezone;
+	double factor;
+	if(velocityProfileAt(minute, minutezone, factor))
+		return ceil(P_TRIP_TIME * factor);
+	return ceil(P_TRIP_TIME * zoneVelocityFactor(zone[searchTimeZone(minute)]));
+}
+
+//With DEPARTUREMETRICS on, request q asks for the minute travelTimeAt() would look up as its
+//departure time. On an MLD dataset osrm-customize built departure ranges for, a minute inside a
+//range is routed on that range's metric and the answer comes back with
+//REQUESTFIELD_DEPARTUREMETRIC: its TIME is the time at that minute and takes no velocity factor.
+//Minutes outside every range, datasets without ranges and CH datasets, which have no departure
+//metrics and ignore the minute, answer from the base metric, and the factor applies as before.
+void requestDepartureAt(int q, DayMinute minute){
+	minute = zoneLookupMinute(minute);
+	if(DEPARTUREMETRICS == 1 && minute >= 0 && minute < MINUTESPERDAY)
+		updateRequest(q, to_string(minute), "DEPARTURE");
+}
 
-	stmt = conn->createStatement (command);
-	rs = stmt->executeQuery();
+string timeZones(string p_eta, string p_promised_time){
+	int z = timeZoneIndex(dayMinute(p_promised_time));
+	if(DEBUG == 1) gse << "calculator.h - timeZones(), p_promised_time: " << p_promised_time << ", zone " << z << ": " << zone[z] << endl;
+	return zone[z];
+}
 
-	try{
-	while(rs->next()){
-		if(rs->getString(1) == "UPDATEDBGSE") //if this registry value is pulled from DB
-			usenewcommands = rs->getString(2); //save into appropriate shared memory
+#include <occi.h>
+
+void gse_update(string client, string date){
+
+	if(DEBUG == 1) gse << "Loading registry from " << (REGISTRYCSVDIR != "" ? REGISTRYCSVDIR : "the database") << endl;
+	chrono::steady_clock::time_point loadstart = chrono::steady_clock::now();
+
+	TableSource* source;
+	if(REGISTRYCSVDIR != "")
+		source = new CsvTableSource(REGISTRYCSVDIR);
+	else
+		source = new OcciTableSource();
+
+	//The tables do not depend on each other, so they are all fetched at once and parsed afterwards
+	const int NREGISTRYTABLES = 3;
+	const int REGISTRY = 0, OE_REGISTRY = 1, TIME_ZONES = 2;
+	string tables[NREGISTRYTABLES] = {"itms_registry", "itms_oe_registry", "itms_time_zones"};
+	string commands[NREGISTRYTABLES] = {
+		"SELECT * FROM itms_registry WHERE VARIABLEDATE = '01-JAN-2001' order by scheduler", ////////for all zones
+		"SELECT featureid, featurevalue FROM itms_oe_registry WHERE featureid IN ('UPDATEDBGSE', 'DW_VARIANCE_CHECK_SML', 'DW_VARIANCE_CHECK_MED', 'DW_VARIANCE_CHECK_LNG', 'StraightLineForSlack', 'SAMEOUTBOUNDPREASSIGNMENT', 'MAXSTOPNUM', 'USE_REVERSE_CALC', 'XTRTRAVTIME', 'HEADHOMETHRESHOLD', 'MAXDEADHEADVARIANCE', 'CALCULATE_GCOUNT_WC', 'EXTRA_GRP_TT', 'PercentageToStopBatch', 'OpenSegThreshold', 'IGNORE_DEPOTS_CUTOFF', 'NumberOfEdgesForNearest', 'CS_CAP_AGENCY', 'CS_CAP_VOL', 'CY_CAP_AGENCY', 'CY_CAP_VOL', 'OSRMVELOCITYFACTOR')",
+		"SELECT  ZONE, starttime, endtime FROM   ITMS_TIME_ZONES where zone not like '%-%'"
+	};
+	TableRows rows[NREGISTRYTABLES];
+	string errors[NREGISTRYTABLES];
+
+	tbb::parallel_for(0, NREGISTRYTABLES, [&](int t){
+		try{
+			source->fetch(tables[t], commands[t], rows[t]);
+		}
+		catch(std::exception & e){
+			errors[t] = e.what();
+		}
+		catch(...){
+			errors[t] = "unknown error";
+		}
+	});
+	delete source;
+
+	//a table that could not be read leaves the registry as it was instead of loading part of it
+	bool failed = false;
+	for(int t = 0; t < NREGISTRYTABLES; t++){
+		if(errors[t] != ""){
+			gse << "error fetching data from " << tables[t] << " in gse_update(): " << errors[t] << endl;
+			failed = true;
+		}
+		else if(DEBUG == 1) gse << tables[t] << ": " << rows[t].size() << " rows" << endl;
 	}
-	}catch(...){
-		if(DEBUG == 1) gse << "error fetching data from itms_oe_registry in gse_update()" << endl;
+	if(failed){
+		gse << "gse_update() registry not loaded" << endl;
+		return;
 	}
 
-	stmt->closeResultSet(rs);
-	conn->terminateStatement(stmt);
+	const TableRows & registry = rows[REGISTRY];
+	for(size_t y = 0; y < registry.size(); y++){
+		const vector<string> & row = registry[y];
+		p_WHEELLOAD[y] = tableInt(row, 6);
+		p_AMBLOAD[y] = tableInt(row, 7);
+		p_MAXEARLYDROPOFFFACTOR[y] = tableInt(row, 11);
+		p_DIALRIDEEARLYPICKFACTOR[y] = tableInt(row, 15);
+		p_DIALRIDELATEPICKFACTOR[y] = tableInt(row, 16);
+		p_OTHEREARLYPICKFACTOR[y] = tableInt(row, 17);
+		p_OTHERLATEPICKFACTOR[y] = tableInt(row, 18);
+		strcpy(ignorepu[y], tableColumn(row, 38).c_str());
+		p_SHORTBREAK[y] = tableInt(row, 39);
+		p_LUNCHBREAK[y] = tableInt(row, 40);
+		p_PROXIMITYFACTOR[y] = tableInt(row, 42);
+		strcpy(ZONE_DESCR[y], tableColumn(row, 43).c_str());
+		a_mediumshortdistance[y] = to_number(tableColumn(row, 10));
+		a_shorttriptime[y] = tableInt(row, 9);
+		a_longtriptime[y] = tableInt(row, 8);
+		a_mediumlongdistance[y] = to_number(tableColumn(row, 32));
+		a_mediumtriptime[y] = tableInt(row, 33);
+		a_extra_loadtime[y] = tableInt(row, 47);
+	}
+
+	const TableRows & oe_registry = rows[OE_REGISTRY];
 
-	command = "SELECT featureid, featurevalue FROM itms_oe_registry WHERE FEATUREID = 'DW_VARIANCE_CHECK_SML'  OR FEATUREID = 'DW_VARIANCE_CHECK_MED' OR FEATUREID = 'DW_VARIANCE_CHECK_LNG' OR FEATUREID = 'StraightLineForSlack' or  FEATUREID='SAMEOUTBOUNDPREASSIGNMENT' OR FEATUREID='MAXSTOPNUM' OR FEATUREID='SAMEOUTBOUNDPREASSIGNMENT' or FEATUREID='USE_REVERSE_CALC' or FEATUREID = 'XTRTRAVTIME' or FEATUREID = 'HEADHOMETHRESHOLD' or   FEATUREID='MAXDEADHEADVARIANCE' or  FEATUREID='CALCULATE_GCOUNT_WC' or  featureid = 'EXTRA_GRP_TT' or featureid = 'PercentageToStopBatch' or featureid='OpenSegThreshold' or featureid='IGNORE_DEPOTS_CUTOFF' or featureid='NumberOfEdgesForNearest'";
-	if(DEBUG == 1) gse << command << endl;
+	string usenewcommands = "N";
+	for(size_t r = 0; r < oe_registry.size(); r++)
+		if(tableColumn(oe_registry[r], 1) == "UPDATEDBGSE") //if this registry value is pulled from DB
+			usenewcommands = tableColumn(oe_registry[r], 2); //save into appropriate shared memory
 
 	DW_VARIANCE_CHECK_SML[0] = 0.5;
 	DW_VARIANCE_CHECK_MED[0] = 0.4;
@@ -3267,118 +4656,176 @@ void gse_update(string client, string date){
 	PERCENTAGETOSTOPBATCH[0] = 0.01;
 	EXTRAGRPTT[0] = 0;
 	MAXDEADHEADVARIANCE[0] = 1;
-	//   if(DEBUG == 1) gse << "Before opening  " << endl;
 	strcpy(USEREVERSECALC[0], "N");
 	XTRTRAVTIME[0] = 1.2;
 	HEADHOMETHRESHOLD[0]= .25;
 	strcpy(SAMEOUTBOUNDPREASSIGNMENT[0],"N");
 	strcpy(MAXSTOPNUM[0],"999");
-	//  if(DEBUG == 1) gse << "After opening  " << endl;
-
-
-	//   if(DEBUG == 1) gse << command << endl;
+	if(usenewcommands == "N")
+		SLACK_THRESHOLD[0] = 20.0;
+
+	for(size_t r = 0; r < oe_registry.size(); r++){
+		const string & feature = tableColumn(oe_registry[r], 1);
+		const string & value = tableColumn(oe_registry[r], 2);
+		if(feature == "MAXSTOPNUM") //if this registry value is pulled from DB
+			strcpy(MAXSTOPNUM[0], value.c_str()); //save into appropriate shared memory
+		if(feature == "CALCULATE_GCOUNT_WC")
+			strcpy(ACALCULATE_GCOUNT_WC[0], value.c_str());
+		if(feature == "IGNORE_DEPOTS_CUTOFF")
+			strcpy(IGNORE_DEPOTS_CUTOFF[0], value.c_str());
+		if(feature == "USE_REVERSE_CALC")
+			strcpy(USEREVERSECALC[0], value.c_str());
+		if(feature == "SAMEOUTBOUNDPREASSIGNMENT")
+			strcpy(SAMEOUTBOUNDPREASSIGNMENT[0], value.c_str());
+		if(feature == "OpenSegThreshold")
+			OPEN_SEG_THRESHOLD[0] = to_number(value);
+		if(usenewcommands == "N" && feature == "StraightLineForSlack")
+			SLACK_THRESHOLD[0] = to_number(value);
+		if(feature == "PercentageToStopBatch")
+			PERCENTAGETOSTOPBATCH[0] = to_number(value);
+		if(feature == "MAXDEADHEADVARIANCE")
+			MAXDEADHEADVARIANCE[0] = to_number(value);
+		if(feature == "XTRTRAVTIME")
+			XTRTRAVTIME[0] = to_number(value);
+		if(feature == "HEADHOMETHRESHOLD")
+			HEADHOMETHRESHOLD[0] = to_number(value);
+
+		if(feature == "DW_VARIANCE_CHECK_SML")
+			DW_VARIANCE_CHECK_SML[0] = to_number(value);
+		if(feature == "DW_VARIANCE_CHECK_MED")
+			DW_VARIANCE_CHECK_MED[0] = to_number(value);
+		if(feature == "DW_VARIANCE_CHECK_LNG")
+			DW_VARIANCE_CHECK_LNG[0] = to_number(value);
+
+		if(feature == "NumberOfEdgesForNearest")
+			NUMBER_OF_EDGES[0] = tableInt(oe_registry[r], 2);
+		if(feature == "EXTRA_GRP_TT")
+			EXTRAGRPTT[0] = tableInt(oe_registry[r], 2);
+
+		if(feature == "CS_CAP_VOL")
+			cs_cap_vol[0] = tableInt(oe_registry[r], 2);
+		if(feature == "CY_CAP_VOL")
+			bs_cap_vol[0] = tableInt(oe_registry[r], 2);
+		if(feature == "CS_CAP_AGENCY")
+			cs_cap_agency[0] = tableInt(oe_registry[r], 2);
+		if(feature == "CY_CAP_AGENCY")
+			bs_cap_agency[0] = tableInt(oe_registry[r], 2);
+	}
+
+	getVelocity(oe_registry);
+	getTimeZone(rows[TIME_ZONES]);
+	//only now are the factors and the time zones all in place for the velocity profiles
+	attachRequestTable();
+	request_table->registry_generation.fetch_add(1, std::memory_order_release);
+
+	if(DEBUG == 1) gse << "Finished updating in " << chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - loadstart).count() << " ms" << endl;
 
-	stmt = conn->createStatement (command);
-	rs = stmt->executeQuery();
-	try{
-	while(rs->next()){
-		//  if(DEBUG == 1) gse << rs->getString(1) << endl;
-		if(rs->getString(1) == "MAXSTOPNUM") //if this registry value is pulled from DB
-			strcpy(MAXSTOPNUM[0],rs->getString(2).c_str()); //save into appropriate shared memory
-		if(rs->getString(1) == "CALCULATE_GCOUNT_WC") //if this registry value is pulled from DB
-			strcpy(ACALCULATE_GCOUNT_WC[0], rs->getString(2).c_str()); //save into appropriate shared memory
-		if(rs->getString(1) == "IGNORE_DEPOTS_CUTOFF")
-			strcpy(IGNORE_DEPOTS_CUTOFF[0], rs->getString(2).c_str());
-		if(rs->getString(1) == "USE_REVERSE_CALC")
-			strcpy(USEREVERSECALC[0], rs->getString(2).c_str());
-		if(rs->getString(1) == "SAMEOUTBOUNDPREASSIGNMENT")
-			strcpy(SAMEOUTBOUNDPREASSIGNMENT[0], rs->getString(2).c_str());
-		if(rs->getString(1) == "OpenSegThreshold")
-			OPEN_SEG_THRESHOLD[0] = rs->getDouble(2);
-		if(usenewcommands == "N"){
-			SLACK_THRESHOLD[0] = 20.0;
-			if(rs->getString(1) == "StraightLineForSlack")
-				SLACK_THRESHOLD[0] = rs->getDouble(2);
-		}
-		if(rs->getString(1) == "PercentageToStopBatch")
-			PERCENTAGETOSTOPBATCH[0] = rs->getDouble(2);
-		if(rs->getString(1) == "MAXDEADHEADVARIANCE")
-			MAXDEADHEADVARIANCE[0] = rs->getDouble(2);
-		if(rs->getString(1) == "XTRTRAVTIME")
-			XTRTRAVTIME[0] = rs->getDouble(2);
-		if(rs->getString(1) == "HEADHOMETHRESHOLD")
-			HEADHOMETHRESHOLD[0] = rs->getDouble(2);
-
-
-		if(rs->getString(1) == "DW_VARIANCE_CHECK_SML")
-			DW_VARIANCE_CHECK_SML[0] = rs->getDouble(2);
-		if(rs->getString(1) == "DW_VARIANCE_CHECK_MED")
-			DW_VARIANCE_CHECK_MED[0] = rs->getDouble(2);
-		if(rs->getString(1) == "DW_VARIANCE_CHECK_LNG")
-			DW_VARIANCE_CHECK_LNG[0] = rs->getDouble(2);
-
-
-		if(rs->getString(1) == "NumberOfEdgesForNearest")
-			NUMBER_OF_EDGES[0] = rs->getInt(2);
-		if(rs->getString(1) == "EXTRA_GRP_TT")
-			EXTRAGRPTT[0] = rs->getInt(2);
-	}
-	}catch(...){
-		if(DEBUG == 1) gse << "error fetching data from itms_oe_registry in gse_update() - 2" << endl;
-	}
-
-
-	stmt->closeResultSet(rs);
-	conn->terminateStatement(stmt);
-
-
-	string command1 = "select featureid, featurevalue from itms_oe_registry where featureid = 'CS_CAP_AGENCY' or featureid ='CS_CAP_VOL' or featureid = 'CY_CAP_AGENCY' or featureid ='CY_CAP_VOL'";
-	if(DEBUG == 1) gse << command1 <<endl;
-
-	stmt = conn->createStatement (command1);
-	rs = stmt->executeQuery();
-
-	try{
-	while(rs->next()){
-		if(rs->getString(1) == "CS_CAP_VOL")
-			cs_cap_vol[0] = rs->getInt(2);
 
-		if(rs->getString(1) == "CY_CAP_VOL")
-			bs_cap_vol[0] = rs->getInt(2);
+	return;
+}
 
-		if(rs->getString(1) == "CS_CAP_AGENCY")
-			cs_cap_agency[0] = rs->getInt(2);
 
-		if(rs->getString(1) == "CY_CAP_AGENCY")
-			bs_cap_agency[0] = rs->getInt(2);
-	}
-	}catch(...){
-		if(DEBUG == 1) gse << "error fetching data from itms_oe_registry in gse_update() - 3" << endl;
+//Route id -> s_tab row, stops per row and trip index -> (row, position). s_tab is filled by the
+//loader, so every remembered answer is checked against s_tab before it is used and looked up
+//again once it went stale; while the routes of the day stay put the lookups are O(1).
+//The hints are atomics and the route map has a mutex because the segment searches of
+//changedisposition() run on several threads at once.
+unordered_map<int, int> segment_index;
+std::mutex segment_index_mutex;
+std::atomic<int> loaded_segments(0);
+std::atomic<int> segment_stop_count[MAXSEGMENTS];
+std::atomic<int> trip_segment[MAXTRIPIDX];
+std::atomic<int> trip_position[MAXTRIPIDX];
+
+void rebuildSegmentIndex(){
+	segment_index.clear();
+	for(int m = 0; m < MAXSEGMENTS; m++){
+		if(s_tab[m][0] != 0)
+			segment_index.insert(make_pair(s_tab[m][0], m)); //keeps the first row of a route
 	}
+}
 
+//First s_tab row of a route like a scan over all MAXSEGMENTS rows, -1 if there is none
+int findSegment(int routeint){
+	if(routeint == 0){
+		for(int m = 0; m < MAXSEGMENTS; m++){
+			if(s_tab[m][0] == 0)
+				return m;
+		}
+		return -1;
+	}
+	std::lock_guard<std::mutex> lock(segment_index_mutex);
+	unordered_map<int, int>::const_iterator found = segment_index.find(routeint);
+	if(found != segment_index.end() && s_tab[found->second][0] == routeint)
+		return found->second;
+	rebuildSegmentIndex();
+	found = segment_index.find(routeint);
+	return found == segment_index.end() ? -1 : found->second;
+}
 
-	stmt->closeResultSet(rs);
-	conn->terminateStatement(stmt);
-
-
-
-	getVelocity(env, conn);
-
-	//   if(DEBUG == 1) gse << "Velocity" << endl;
-	//  if(DEBUG == 1) gse << "Found " << a_shorttriptime[0] << " " << a_mediumtriptime[0] << " " << a_longtriptime[0] << endl;
-	getTimeZone(env,conn);
-
-	//  if(DEBUG == 1) gse << "time" << endl;
-	//   if(DEBUG == 1) gse << "Found " << a_shorttriptime[0] << " " << a_mediumtriptime[0] << " " << a_longtriptime[0] << endl;
-	env->terminateConnection(conn);
-	env->terminateEnvironment(env);
+//Rows before the first empty row of s_tab
+int loadedSegmentCount(){
+	int count = loaded_segments.load(std::memory_order_relaxed);
+	if((count == MAXSEGMENTS || s_tab[count][0] == 0) && (count == 0 || s_tab[count - 1][0] != 0))
+		return count;
+	for(count = 0; count < MAXSEGMENTS && s_tab[count][0] != 0; count++);
+	loaded_segments.store(count, std::memory_order_relaxed);
+	return count;
+}
 
-	if(DEBUG == 1) gse << "Finished updating " << endl;
+//findSegment() for the loops that stop at the first empty row of s_tab
+int findLoadedSegment(int routeint){
+	int m = findSegment(routeint);
+	if(m < 0 || m >= loadedSegmentCount())
+		return -1;
+	return m;
+}
 
+//Stops on an s_tab row before its first empty position
+int segmentStopCount(int segment){
+	int count = segment_stop_count[segment].load(std::memory_order_relaxed);
+	if(count + 1 < MAXSTOPS && s_tab[segment][count + 1] == 0 && (count == 0 || s_tab[segment][count] != 0))
+		return count;
+	for(count = 0; count + 1 < MAXSTOPS && s_tab[segment][count + 1] != 0; count++);
+	segment_stop_count[segment].store(count, std::memory_order_relaxed);
+	return count;
+}
 
-	return;
+//First position of a trip index on an s_tab row, -1 if it is not on it
+int findStopPosition(int segment, int tripidx){
+	if(tripidx > 0 && tripidx < MAXTRIPIDX && trip_segment[tripidx].load(std::memory_order_relaxed) == segment){
+		const int position = trip_position[tripidx].load(std::memory_order_relaxed);
+		if(position > 0 && position < MAXSTOPS && s_tab[segment][position] == tripidx)
+			return position;
+	}
+	for(int g = 1; g < MAXSTOPS; g++){
+		if(s_tab[segment][g] == tripidx){
+			if(tripidx > 0 && tripidx < MAXTRIPIDX){
+				trip_position[tripidx].store(g, std::memory_order_relaxed);
+				trip_segment[tripidx].store(segment, std::memory_order_relaxed);
+			}
+			return g;
+		}
+	}
+	return -1;
 }
 
+//Pickups grouped with the stop of a trip on its route, counted back from the stop; the group
+//counters of the search functions add them up
+int groupedPickupsBefore(int routeint, int tripidx){
+	int segment = findSegment(routeint);
+	if(segment < 0)
+		return 0;
+	int g = findStopPosition(segment, tripidx);
+	if(g < 0)
+		return 0;
+	int grouped = 0;
+	while(g >=2 && strcmp(schd_tab[s_tab[segment][g]][7],"P")==0 && strcmp(schd_tab[s_tab[segment][g]][3],schd_tab[s_tab[segment][g]][0])!=0 ){
+		grouped++;
+		g--;
+	}
+	return grouped;
+}
 
 void overwriteexclusionwithinclusion(int tripidx, int (*tempexclu_inclu)[MAXTRIPIDX][MAXSEGMENTS], string route){
 
@@ -3402,17 +4849,7 @@ void overwriteexclusionwithinclusion(int tripidx, int (*tempexclu_inclu)[MAXTRIP
 			string token = getNextToken(&(temp),",");
 			token = token.substr(1,token.length());
 			int routeint = (int)to_number(token);
-			int s_tab_index = -1;
-			for(int m = 0; m < MAXSEGMENTS; m++){
-				if(s_tab[m][0] == 0){
-					break;
-				}
-
-				if(s_tab[m][0] == routeint){
-					s_tab_index = m;
-					break;
-				}
-			}
+			int s_tab_index = findLoadedSegment(routeint);
 			if(s_tab_index != -1){
 				(*tempexclu_inclu)[tripidx][s_tab_index] = 1;
 			}
@@ -3475,17 +4912,7 @@ void populate_exclu_inclu_array(int tripidx){
 				string token = getNextToken(&(temp),",");
 				token = token.substr(1,token.length());
 				int routeint = (int)to_number(token);
-				int s_tab_index = -1;
-				for(int m = 0; m < MAXSEGMENTS; m++){
-					if(s_tab[m][0] == 0){
-						break;
-					}
-
-					if(s_tab[m][0] == routeint){
-						s_tab_index = m;
-						break;
-					}
-				}
+				int s_tab_index = findLoadedSegment(routeint);
 				if(s_tab_index != -1){
 					exclu_inclu[tripidx][s_tab_index] = 1;
 				}
@@ -3508,17 +4935,7 @@ void populate_exclu_inclu_array(int tripidx){
 				token = token.substr(1,token.length());
 				int routeint = (int)to_number(token);
 				/// if(DEBUG == 1) gse << "Token " << routeint << endl;
-				int s_tab_index = -1;
-				for(int m = 0; m < MAXSEGMENTS; m++){
-					if(s_tab[m][0] == 0){
-						break;
-					}
-					if(s_tab[m][0] == routeint){
-						// if(DEBUG == 1) gse << "Found index " << m << endl;
-						s_tab_index = m;
-						break;
-					}
-				}
+				int s_tab_index = findLoadedSegment(routeint);
 				if(s_tab_index != -1){
 					exclu_inclu[tripidx][s_tab_index] = 2;
 				}
@@ -3547,15 +4964,7 @@ bool skipsegment(int tripidx, string route){
 	//  if(DEBUG == 1) gse << "skipsegment " << tripidx << " " << route << endl;
 
 	int routeint = (int)to_number(route.substr(1,route.length()));
-	int s_tab_index = -1;
-
-	for(int i = 0; i < MAXSEGMENTS; i++){
-		if(s_tab[i][0] == routeint){
-			s_tab_index = i;
-			//  if(DEBUG == 1) gse << " index " << i << endl;
-			break;
-		}
-	}
+	int s_tab_index = findSegment(routeint);
 
 	if(s_tab_index == -1){
 		if(DEBUG == 1) gse << "There was an error in skipsegment " << routeint << endl;
@@ -3579,15 +4988,8 @@ bool skipsegmenttemp(int tripidx, string route, int (*tempinclusion)[MAXTRIPIDX]
 	//   if(DEBUG == 1) gse << "skipsegment " << tripidx << " " << route << endl;
 
 	int routeint = (int)to_number(route.substr(1,route.length()));
-	int s_tab_index = -1;
-
-	for(int i = 0; i < MAXSEGMENTS; i++){
-		if(s_tab[i][0] == routeint){
-			s_tab_index = i;
-			if(DEBUG == 1) gse << " index " << i << endl;
-			break;
-		}
-	}
+	int s_tab_index = findSegment(routeint);
+	if(DEBUG == 1) gse << " index " << s_tab_index << endl;
 
 
 
@@ -3695,10 +5097,9 @@ string padStr(string str){
 
 
 bool isSameLocation(int tripidx1, int tripidx2){
-	double blat = to_number(schd_tab[tripidx1][10]);
-	double gridlat = to_number(schd_tab[tripidx2][10]);
-	double blon = to_number(schd_tab[tripidx1][37]);
-	double gridlon = to_number(schd_tab[tripidx2][37]);
+	double blat, blon, gridlat, gridlon;
+	stopCoords(tripidx1, blat, blon);
+	stopCoords(tripidx2, gridlat, gridlon);
 	double dist = ((blat - gridlat)*(blat - gridlat) + (blon - gridlon)*(blon - gridlon)) ;
 	dist = sqrt(dist)*3959.0 * 3.1415/180;
 	if(dist <= 0.056818182){
@@ -3721,9 +5122,9 @@ bool isSameLocation(int tripidx1, int tripidx2){
 
 bool isSameLocation_passedLatLong(double lat, double lon, int tripidx2){
 	double blat = lat;
-	double gridlat = to_number(schd_tab[tripidx2][10]);
 	double blon = lon;
-	double gridlon = to_number(schd_tab[tripidx2][37]);
+	double gridlat, gridlon;
+	stopCoords(tripidx2, gridlat, gridlon);
 	double dist = ((blat - gridlat)*(blat - gridlat) + (blon - gridlon)*(blon - gridlon)) ;
 	dist = sqrt(dist)*3959.0 * 3.1415/180;
 
@@ -3757,12 +5158,35 @@ void groupSameLocationTrips(){
 	if(DEBUG == 1) gse << "Finding same groups to ignore for findbest" <<endl;
 	int groupindex = 0;
 
+	//Only trips at the pickup location of i or with the same column 17 can join its group, so
+	//those come from the stop index and a column 17 lookup instead of a pass over every row
+	refreshStopIndex();
+	map<string, vector<int> > samekey;
+	for(int j = 1; j < MAXTRIPIDX; j++){
+		if(strcmp(schd_tab[j][17],"")!=0 && strcmp(schd_tab[j][7],"P")==0)
+			samekey[schd_tab[j][17]].push_back(j);
+	}
+	vector<int> candidates;
+
 	for(int i = 1; i < MAXTRIPIDX; i++){
 		if(strcmp(schd_tab[i][GROUPNUMBER],"")==0 && strcmp(schd_tab[i][0],"")==0 && strcmp(schd_tab[i][7],"P")==0){
-			for(int j = i+1; j < MAXTRIPIDX; j++){
-
-				int timeslot1 = (int)to_number(schd_tab[i][41]);
-				int timeslot2 = (int)to_number(schd_tab[j][41]);
+			double lat, lon;
+			stopCoords(i, lat, lon);
+			stopsInRadius(lat, lon, SAMELOCATIONMILES, candidates);
+			if(strcmp(schd_tab[i][17],"")!=0){
+				const vector<int> & same = samekey[schd_tab[i][17]];
+				candidates.insert(candidates.end(), same.begin(), same.end());
+				sort(candidates.begin(), candidates.end());
+				candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+			}
+
+			int timeslot1 = (int)tripNumber(i, 41);
+			for(size_t c = 0; c < candidates.size(); c++){
+				int j = candidates[c];
+				if(j <= i)
+					continue;
+
+				int timeslot2 = (int)tripNumber(j, 41);
 				if(strcmp(schd_tab[j][GROUPNUMBER],"")==0 && strcmp(schd_tab[j][0],"")==0 && strcmp(schd_tab[j][7],"P")==0 && isSameLocation(i,j) && isSameLocation(i+1,j+1) && (timeslot2 == timeslot1+1 || timeslot2 == timeslot1-1 || timeslot2 == timeslot1) /*&& strcmp(schd_tab[j][41],schd_tab[i][41])==0*/){
 					strcpy(schd_tab[i][GROUPNUMBER],to_string(groupindex).c_str());
 					strcpy(schd_tab[j][GROUPNUMBER],to_string(groupindex).c_str());
@@ -3792,7 +5216,7 @@ int groupid = 1;
             if(strcmp(schd_tab[s_tab[s][k]][2],"999")!=0){
             if(strcmp(schd_tab[s_tab[s][k]][7],"D")==0 && strcmp(schd_tab[s_tab[s][k]][7],"D")==0  ){
                 strcpy(schd_tab[s_tab[s][k]][GRPIDX],to_string(groupid).c_str());
-                strcpy(schd_tab[(int)to_number(schd_tab[s_tab[s][k]][PICKUPIDX])][GRPIDX],to_string(groupid).c_str());
+                strcpy(schd_tab[(int)tripNumber(s_tab[s][k], PICKUPIDX)][GRPIDX],to_string(groupid).c_str());
                 //int grpnumber = (int)to_number(getNextToken(&groupmark, "^"));
                 //grouptraveltimeallowance[grpnumber] = grouptraveltimeallowance[grpnumber] + EXTRAGRPTT[0];
             }
@@ -3812,15 +5236,13 @@ int getTravTimeNoID(double lat, double lon, int do_aftershmid, string eta){
 
 
 
-	string time_zone = timeZones("",itms_minutes_to_ampm((int)to_number(eta)));
+	DayMinute zoneminute = dayMinuteOf((int)to_number(eta));
 
 
 
 
 
 
-	string running = "RUNNINGCALC";
-	strcpy(shared_process_tab[WRITINGFB][0], running.c_str());
 
 
 	int waitingforosrm = 0;
@@ -3835,29 +5257,16 @@ int getTravTimeNoID(double lat, double lon, int do_aftershmid, string eta){
 
 	string osrm = lat1 + "," + lon1 + "," + lat2 + "," + lon2;
 
-	for (int d = 0; d < MAXREQUESTS; d++)
-	{
-
-		if (requestIsEmpty(d))
-		{
-			//usleep(10);
-			if (requestIsEmpty(d))
-			{
-				q = d;
-				break;
-			}
-		}
-		if (d + 1 == MAXREQUESTS)
-			d = -1;
-	}
+	q = acquireRequest();
 	//  if(DEBUG == 1) gse << "q is " << q << endl;
 
 	string function = "CalcDist";
 
 	time_t t = time(NULL);
-	struct tm tm = *localtime(&t);
+	struct tm tm;
+	localtime_r(&t, &tm);
 	char timebuffer[100];
-	sprintf(timebuffer, "%s", asctime(&tm));
+	asctime_r(&tm, timebuffer);
 	string localtimestr = timebuffer;
 	localtimestr.erase(std::remove(localtimestr.begin(), localtimestr.end(), '\n'), localtimestr.end());
 
@@ -3867,6 +5276,7 @@ int getTravTimeNoID(double lat, double lon, int do_aftershmid, string eta){
 	updateRequest(q, to_string(0), "ID");
 	updateRequest(q, osrm, "LATLONG");
 	updateRequest(q, to_string(do_aftershmid), "TRIPIDX");
+	requestDepartureAt(q, zoneminute);
 
 	waitingforosrm++;
 
@@ -3875,19 +5285,20 @@ int getTravTimeNoID(double lat, double lon, int do_aftershmid, string eta){
 
 
 
-	strcpy(shared_process_tab[WRITINGFB][0], "READY");
+	submitRequest(q);
 	int datafromosrm = 0;
 	int timebetween = 0;
+	bool departuremetric = false;
+	waitForRequest(q);
 	while (true)
 	{
 
 		if (fetchRequest(q, "DISTANCE") != "" &&  fetchRequest(q, "TIME") != "" &&/*fetchRequest(q, "ID") == to_string(g) &&*/ fetchRequest(q, "NUM") == "getTravTimeNoID"&& fetchRequest(q, "FUNC") == "CalcDist")
 		{
 			timebetween = (int)to_number(fetchRequest(q, "TIME"));
+			departuremetric = requestHas(q, REQUESTFIELD_DEPARTUREMETRIC);
 			clearRequest(q);
 
-			while(!requestIsEmpty(q)){
-			}
 			//f++;
 			//g++;
 			datafromosrm++;
@@ -3899,7 +5310,7 @@ int getTravTimeNoID(double lat, double lon, int do_aftershmid, string eta){
 	}
 
 
-	int trav_time = F_GET_TRAVEL_TIME (timebetween , time_zone, "*");
+	int trav_time = departuremetric ? timebetween : travelTimeAt(timebetween, zoneminute);
 
 
 
@@ -3912,10 +5323,9 @@ int getTravTimeNoID(double lat, double lon, int do_aftershmid, string eta){
 
 double getCost(int tripidx, int pu_aftershmid){
 	double totalcost;
-	double blat = to_number(schd_tab[tripidx][10]);
-	double gridlat= to_number(schd_tab[pu_aftershmid][10]);
-	double blon = to_number(schd_tab[tripidx][37]);
-	double gridlon =to_number(schd_tab[pu_aftershmid][37]);
+	double blat, blon, gridlat, gridlon;
+	stopCoords(tripidx, blat, blon);
+	stopCoords(pu_aftershmid, gridlat, gridlon);
 	double dist = ((blat - gridlat)*(blat - gridlat) + (blon - gridlon)*(blon - gridlon)) ;
 	dist = sqrt(dist)*3959.0 * 3.1415/180;
 	//double dist = (acos(1.0*sin(blat)*sin(gridlat)+cos(blat)*cos(gridlat)*cos(blon-gridlon)))*3959.87;
@@ -3924,8 +5334,10 @@ double getCost(int tripidx, int pu_aftershmid){
 }
 
 int getTime(int tripidx, int pu_aftershmid){
-	string running = "RUNNINGCALC";
-	strcpy(shared_process_tab[WRITINGFB][0], running.c_str());
+	float matrixdistance, matrixtime;
+	if(lookupStopMatrix(tripidx, pu_aftershmid, matrixdistance, matrixtime))
+		return (int)matrixtime;
+
 
 
 
@@ -3946,29 +5358,16 @@ int getTime(int tripidx, int pu_aftershmid){
 
 	if(DEBUG == 1) gse << osrm << endl;
 
-	for (int d = 0; d < MAXREQUESTS; d++)
-	{
-
-		if (requestIsEmpty(d))
-		{
-			//usleep(10);
-			if (requestIsEmpty(d))
-			{
-				q = d;
-				break;
-			}
-		}
-		if (d + 1 == MAXREQUESTS)
-			d = -1;
-	}
+	q = acquireRequest();
 	//  if(DEBUG == 1) gse << "q is " << q << endl;
 
 	string function = "CalcDist";
 
 	time_t t = time(NULL);
-	struct tm tm = *localtime(&t);
+	struct tm tm;
+	localtime_r(&t, &tm);
 	char timebuffer[100];
-	sprintf(timebuffer, "%s", asctime(&tm));
+	asctime_r(&tm, timebuffer);
 	string localtimestr = timebuffer;
 	localtimestr.erase(std::remove(localtimestr.begin(), localtimestr.end(), '\n'), localtimestr.end());
 
@@ -3986,9 +5385,10 @@ int getTime(int tripidx, int pu_aftershmid){
 
 
 
-	strcpy(shared_process_tab[WRITINGFB][0], "READY");
+	submitRequest(q);
 	int datafromosrm = 0;
 	int timebetween = 0;
+	waitForRequest(q);
 	while (true)
 	{
 
@@ -3996,8 +5396,6 @@ int getTime(int tripidx, int pu_aftershmid){
 		{
 			timebetween = (int)to_number(fetchRequest(q, "TIME"));
 			clearRequest(q);
-			while(!requestIsEmpty(q)){
-			}
 			//f++;
 			//g++;
 			datafromosrm++;
@@ -4014,8 +5412,10 @@ int getTime(int tripidx, int pu_aftershmid){
 	return timebetween;
 }
 double getDist(int tripidx, int pu_aftershmid){
-	string running = "RUNNINGCALC";
-	strcpy(shared_process_tab[WRITINGFB][0], running.c_str());
+	float matrixdistance, matrixtime;
+	if(lookupStopMatrix(tripidx, pu_aftershmid, matrixdistance, matrixtime))
+		return matrixdistance;
+
 
 
 
@@ -4031,29 +5431,16 @@ double getDist(int tripidx, int pu_aftershmid){
 
 	string osrm = lat1 + "," + lon1 + "," + lat2 + "," + lon2;
 
-	for (int d = 0; d < MAXREQUESTS; d++)
-	{
-
-		if (requestIsEmpty(d))
-		{
-			//usleep(10);
-			if (requestIsEmpty(d))
-			{
-				q = d;
-				break;
-			}
-		}
-		if (d + 1 == MAXREQUESTS)
-			d = -1;
-	}
+	q = acquireRequest();
 	//  if(DEBUG == 1) gse << "q is " << q << endl;
 
 	string function = "NEEDDist";
 
 	time_t t = time(NULL);
-	struct tm tm = *localtime(&t);
+	struct tm tm;
+	localtime_r(&t, &tm);
 	char timebuffer[100];
-	sprintf(timebuffer, "%s", asctime(&tm));
+	asctime_r(&tm, timebuffer);
 	string localtimestr = timebuffer;
 	localtimestr.erase(std::remove(localtimestr.begin(), localtimestr.end(), '\n'), localtimestr.end());
 
@@ -4071,9 +5458,10 @@ double getDist(int tripidx, int pu_aftershmid){
 
 
 
-	strcpy(shared_process_tab[WRITINGFB][0], "READY");
+	submitRequest(q);
 	int datafromosrm = 0;
 	double dist1 = 0;
+	waitForRequest(q);
 	while (true)
 	{
 
@@ -4081,8 +5469,6 @@ double getDist(int tripidx, int pu_aftershmid){
 		{
 			dist1= to_number(fetchRequest(q, "DISTANCE"));
 			clearRequest(q);
-			while(!requestIsEmpty(q)){
-			}
 			//f++;
 			//g++;
 			datafromosrm++;
@@ -4102,8 +5488,6 @@ double getDistNoID(double lat, double lon, int do_aftershmid){
 
 
 
-	string running = "RUNNINGCALC";
-	strcpy(shared_process_tab[WRITINGFB][0], running.c_str());
 
 
 	int waitingforosrm = 0;
@@ -4118,29 +5502,16 @@ double getDistNoID(double lat, double lon, int do_aftershmid){
 
 	string osrm = lat1 + "," + lon1 + "," + lat2 + "," + lon2;
 
-	for (int d = 0; d < MAXREQUESTS; d++)
-	{
-
-		if (requestIsEmpty(d))
-		{
-			//usleep(10);
-			if (requestIsEmpty(d))
-			{
-				q = d;
-				break;
-			}
-		}
-		if (d + 1 == MAXREQUESTS)
-			d = -1;
-	}
+	q = acquireRequest();
 	//  if(DEBUG == 1) gse << "q is " << q << endl;
 
 	string function = "NEEDDist";
 
 	time_t t = time(NULL);
-	struct tm tm = *localtime(&t);
+	struct tm tm;
+	localtime_r(&t, &tm);
 	char timebuffer[100];
-	sprintf(timebuffer, "%s", asctime(&tm));
+	asctime_r(&tm, timebuffer);
 	string localtimestr = timebuffer;
 	localtimestr.erase(std::remove(localtimestr.begin(), localtimestr.end(), '\n'), localtimestr.end());
 
@@ -4158,9 +5529,10 @@ double getDistNoID(double lat, double lon, int do_aftershmid){
 
 
 
-	strcpy(shared_process_tab[WRITINGFB][0], "READY");
+	submitRequest(q);
 	int datafromosrm = 0;
 	int dist1 = 0;
+	waitForRequest(q);
 	while (true)
 	{
 
@@ -4168,8 +5540,6 @@ double getDistNoID(double lat, double lon, int do_aftershmid){
 		{
 			dist1 = (int)to_number(fetchRequest(q, "DISTANCE"));
 			clearRequest(q);
-			while(!requestIsEmpty(q)){
-			}
 			//f++;
 			//g++;
 			datafromosrm++;
@@ -4195,9 +5565,9 @@ double getDistNoID(double lat, double lon, int do_aftershmid){
 double getCost_notripid(double lat, double lon, int pu_aftershmid){
 	double totalcost;
 	double blat = lat;
-	double gridlat= to_number(schd_tab[pu_aftershmid][10]);
 	double blon = lon;
-	double gridlon =to_number(schd_tab[pu_aftershmid][37]);
+	double gridlat, gridlon;
+	stopCoords(pu_aftershmid, gridlat, gridlon);
 	double dist = ((blat - gridlat)*(blat - gridlat) + (blon - gridlon)*(blon - gridlon)) ;
 	dist = sqrt(dist)*3959.0 * 3.1415/180;
 	//double dist = (acos(1.0*sin(blat)*sin(gridlat)+cos(blat)*cos(gridlat)*cos(blon-gridlon)))*3959.87;
@@ -4375,13 +5745,14 @@ void set_p_perf_time(string pDisposition,string pDisability,int & p_perf_time, i
 
 
 int getActualDistance(int tripidx, int do_aftershmid){
+	float matrixdistance, matrixtime;
+	if(lookupStopMatrix(tripidx, do_aftershmid, matrixdistance, matrixtime))
+		return (int)matrixdistance;
 
 
 
 
 
-	string running = "RUNNINGCALC";
-	strcpy(shared_process_tab[WRITINGFB][0], running.c_str());
 
 	int waitingforosrm = 0;
 	int q;
@@ -4395,29 +5766,16 @@ int getActualDistance(int tripidx, int do_aftershmid){
 
 	string osrm = lat1 + "," + lon1 + "," + lat2 + "," + lon2;
 
-	for (int d = 0; d < MAXREQUESTS; d++)
-	{
-
-		if (requestIsEmpty(d))
-		{
-			//usleep(10);
-			if (requestIsEmpty(d))
-			{
-				q = d;
-				break;
-			}
-		}
-		if (d + 1 == MAXREQUESTS)
-			d = -1;
-	}
+	q = acquireRequest();
 	//  if(DEBUG == 1) gse << "q is " << q << endl;
 
 	string function = "CalcDist";
 
 	time_t t = time(NULL);
-	struct tm tm = *localtime(&t);
+	struct tm tm;
+	localtime_r(&t, &tm);
 	char timebuffer[100];
-	sprintf(timebuffer, "%s", asctime(&tm));
+	asctime_r(&tm, timebuffer);
 	string localtimestr = timebuffer;
 	localtimestr.erase(std::remove(localtimestr.begin(), localtimestr.end(), '\n'), localtimestr.end());
 
@@ -4435,9 +5793,10 @@ int getActualDistance(int tripidx, int do_aftershmid){
 
 
 
-	strcpy(shared_process_tab[WRITINGFB][0], "READY");
+	submitRequest(q);
 	int datafromosrm = 0;
 	int timebetween = 0;
+	waitForRequest(q);
 	while (true)
 	{
 
@@ -4445,8 +5804,6 @@ int getActualDistance(int tripidx, int do_aftershmid){
 		{
 			timebetween = (int)to_number(fetchRequest(q, "DISTANCE"));
 			clearRequest(q);
-			while(!requestIsEmpty(q)){
-			}
 			//f++;
 			//g++;
 			datafromosrm++;
@@ -4472,26 +5829,24 @@ int getTravTime_passedEta(int tripidx, int do_aftershmid, string eta, string eta
 
 
 	/*if(strcmp(schd_tab[tripidx][0],"")==0 && strcmp(schd_tab[do_aftershmid][0],"")==0){
-                                        dist = to_number(schd_tab[tripidx][21]);
+                                        dist = tripNumber(tripidx, 21);
                                     }
                                     else{
 
-                                        double blat = to_number(schd_tab[tripidx][10]);
-                                        double gridlat = to_number(schd_tab[do_aftershmid][10]);
-                                        double blon = to_number(schd_tab[tripidx][37]);
-                                        double gridlon = to_number(schd_tab[do_aftershmid][37]);
+                                        double blat = tripNumber(tripidx, 10);
+                                        double gridlat = tripNumber(do_aftershmid, 10);
+                                        double blon = tripNumber(tripidx, 37);
+                                        double gridlon = tripNumber(do_aftershmid, 37);
                                         dist = ((blat - gridlat)*(blat - gridlat) + (blon - gridlon)*(blon - gridlon)) ;
                                         dist = sqrt(dist)*3959.0 * 3.1415/180;
                                     //double dist = (acos(1.0*sin(blat)*sin(gridlat)+cos(blat)*cos(gridlat)*cos(blon-gridlon)))*3959.87;
                                     //getTimeZone(env ,conn);
                                     }*/
-	string time_zone = timeZones("",itms_minutes_to_ampm((int)to_number(eta)));
-	string time_zone2 = timeZones("",itms_minutes_to_ampm((int)to_number(eta2)));
+	DayMinute zoneminute = dayMinuteOf((int)to_number(eta));
+	DayMinute zoneminute2 = dayMinuteOf((int)to_number(eta2));
 
 
 
-	string running = "RUNNINGCALC";
-	strcpy(shared_process_tab[WRITINGFB][0], running.c_str());
 
 	//  if(DEBUG == 1) gse <<"Gettng writing osrm : " << endl;
 	//endtimer(osrmtime, FILE1);
@@ -4508,29 +5863,16 @@ int getTravTime_passedEta(int tripidx, int do_aftershmid, string eta, string eta
 
 	string osrm = lat1 + "," + lon1 + "," + lat2 + "," + lon2;
 
-	for (int d = 0; d < MAXREQUESTS; d++)
-	{
-
-		if (requestIsEmpty(d))
-		{
-			//usleep(10);
-			if (requestIsEmpty(d))
-			{
-				q = d;
-				break;
-			}
-		}
-		if (d + 1 == MAXREQUESTS)
-			d = -1;
-	}
+	q = acquireRequest();
 	//  if(DEBUG == 1) gse << "q is " << q << endl;
 
 	string function = "CalcDist";
 
 	time_t t = time(NULL);
-	struct tm tm = *localtime(&t);
+	struct tm tm;
+	localtime_r(&t, &tm);
 	char timebuffer[100];
-	sprintf(timebuffer, "%s", asctime(&tm));
+	asctime_r(&tm, timebuffer);
 	string localtimestr = timebuffer;
 	localtimestr.erase(std::remove(localtimestr.begin(), localtimestr.end(), '\n'), localtimestr.end());
 
@@ -4540,6 +5882,7 @@ int getTravTime_passedEta(int tripidx, int do_aftershmid, string eta, string eta
 	updateRequest(q, to_string(0), "ID");
 	updateRequest(q, osrm, "LATLONG");
 	updateRequest(q, to_string(tripidx), "TRIPIDX");
+	requestDepartureAt(q, zoneminute);
 
 	waitingforosrm++;
 
@@ -4548,22 +5891,23 @@ int getTravTime_passedEta(int tripidx, int do_aftershmid, string eta, string eta
 
 
 
-	strcpy(shared_process_tab[WRITINGFB][0], "READY");
+	submitRequest(q);
 
 
 	//  if(DEBUG == 1) gse <<"Gettng reading osrm : " << endl;
 	//endtimer(osrmtime, FILE1);
 	int datafromosrm = 0;
 	int timebetween = 0;
+	bool departuremetric = false;
+	waitForRequest(q);
 	while (true)
 	{
 
 		if (fetchRequest(q, "DISTANCE") != "" &&  fetchRequest(q, "TIME") != "" &&/*fetchRequest(q, "ID") == to_string(g) &&*/ fetchRequest(q, "NUM") == "getTravTime_passedEta" && fetchRequest(q, "FUNC") == "CalcDist")
 		{
 			timebetween = (int)to_number(fetchRequest(q, "TIME"));
+			departuremetric = requestHas(q, REQUESTFIELD_DEPARTUREMETRIC);
 			clearRequest(q);
-			while(!requestIsEmpty(q)){
-			}
 			//f++;
 			//g++;
 			datafromosrm++;
@@ -4578,8 +5922,9 @@ int getTravTime_passedEta(int tripidx, int do_aftershmid, string eta, string eta
 	//endtimer(osrmtime, FILE1);
 
 
-	int trav_time = F_GET_TRAVEL_TIME (timebetween , time_zone, "*");
-	int trav_time2 = F_GET_TRAVEL_TIME (timebetween , time_zone2, "*");
+	//an answer from a departure metric is the time at eta already, see requestDepartureAt()
+	int trav_time = departuremetric ? timebetween : travelTimeAt(timebetween, zoneminute);
+	int trav_time2 = departuremetric ? timebetween : travelTimeAt(timebetween, zoneminute2);
 
 
 
@@ -4595,6 +5940,26 @@ int getTravTime_passedEta(int tripidx, int do_aftershmid, string eta, string eta
 		return trav_time2;
 }
 
+//Asks osrm-routed for every pair at once, one thread per core, so the getTime(),
+//getActualDistance() and getTravTime_passedEta() calls the FindBest searches then make in order
+//are answered from the travel cache instead of one round trip after another. Pairs at the same
+//place or in the stop matrix need no request. With DEBUG on nothing is fetched ahead, so the
+//gse log stays in order.
+void prefetchTravelTimes(const vector<std::pair<int, int>> & pairs){
+	if(DEBUG == 1 || pairs.size() < 2)
+		return;
+	//the lazily attached segments are set up before the threads share them
+	attachRequestTable();
+	attachTripColumns();
+	attachStopMatrix(false);
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, pairs.size(), 1), [&](const tbb::blocked_range<size_t> & range){
+		for(size_t b = range.begin(); b != range.end(); b++){
+			if(!isSameLocation(pairs[b].first, pairs[b].second))
+				getTime(pairs[b].first, pairs[b].second);
+		}
+	});
+}
+
 
 void clearSlack(int timeslot, int cluster, int tripidx){
 
@@ -4625,6 +5990,80 @@ void clearSlack(int timeslot, int cluster, int tripidx){
 	//  if(DEBUG == 1) gse << "Cleared Slack for Trip "<< tripidx << " for clusterid " << clusterid << endl;
 }
 
+//Minutes a pickup may be late by, the same factor the insertion checks below use for the stop
+//after an insertion
+int latePickupFactor(int tripidx){
+	int p_WHEELLOAD1, p_AMBLOAD1, p_MAXEARLYDROPOFFFACTOR1, p_DIALRIDEEARLYPICKFACTOR1, p_DIALRIDELATEPICKFACTOR1, p_OTHEREARLYPICKFACTOR1, p_OTHERLATEPICKFACTOR1;
+	int p_SHORTBREAK1, p_LUNCHBREAK1, p_PROXIMITYFACTOR1, a_mediumshortdistance1, a_mediumlongdistance1, a_shorttriptime1, a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1;
+	string IGNOREPUTIMES1, ZONE_DESCR1, IGNORE_DEPOTS_CUTOFF1;
+	string pDisability = schd_tab[tripidx][12];
+	string pReturn_trip = schd_tab[tripidx][18];
+
+	if (pDisability.find("LP",0) != string::npos && pDisability.find("OT",0) == string::npos)
+		return 0;
+	set_registry_values(  p_WHEELLOAD1,  p_AMBLOAD1,
+			p_MAXEARLYDROPOFFFACTOR1, p_DIALRIDEEARLYPICKFACTOR1, p_DIALRIDELATEPICKFACTOR1, p_OTHEREARLYPICKFACTOR1,  p_OTHERLATEPICKFACTOR1,IGNOREPUTIMES1, p_SHORTBREAK1, p_LUNCHBREAK1,  p_PROXIMITYFACTOR1,  a_mediumshortdistance1, a_mediumlongdistance1, a_shorttriptime1,
+			a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip,  pDisability,schd_tab[tripidx][8]);
+	return pReturn_trip == "Y" ? p_OTHERLATEPICKFACTOR1 : p_DIALRIDELATEPICKFACTOR1;
+}
+
+//Latest arrival the insertion checks accept at a stop (endofsegtime), plus the late deviation the
+//route recalculation tolerates on trips that carry one
+int latestArrival(int tripidx){
+	int latest;
+	if(strcmp(schd_tab[tripidx][2], MAXSTOPNUM[0])==0)
+		return (int)tripNumber(tripidx, 4);
+	if(strcmp(schd_tab[tripidx][7], "P")==0)
+		latest = (int)tripNumber(tripidx, (int)tripNumber(tripidx, 26) > 0 ? 26 : 4) + latePickupFactor(tripidx);
+	else
+		latest = (int)tripNumber(tripidx, (int)tripNumber(tripidx, 27) > 0 ? 27 : 4);
+	if(strcmp(schd_tab[tripidx][LATEDEVIATION],"")!=0)
+		latest += (int)tripNumber(tripidx, LATEDEVIATION);
+	return latest;
+}
+
+//Per-stop state of an s_tab row for the FindBest searches, read from schd_tab once per route: the
+//eta, etd and time to the next stop, the latest arrival (latestArrival() plus the relaxation) and
+//the amb, wc, cs and cy occupancy after each stop, with the forward slack built on top. An
+//insertion is then checked against every stop after it with one comparison, and the searches read
+//the stop columns they need from here rather than parsing them again for every candidate trip.
+//Index p is s_tab column p.
+const int SLACKAMB = 0;
+const int SLACKWC = 1;
+const int SLACKCS = 2;
+const int SLACKCY = 3;
+
+struct ForwardSlack{
+	bool valid; //false while a stop has no eta yet or FORWARDSLACK is off; every delay fits then
+	osrm::util::RouteSlack<MAXSTOPS + 1, 4> route;
+};
+
+void buildForwardSlack(int m, ForwardSlack & forward){
+	const int relax = (int)floor((RELAXCONSTRAINTS[0] - 1)*50);
+	const int stops = segmentStopCount(m);
+	forward.valid = FORWARDSLACK == 1;
+	forward.route.clear();
+	const int none[4] = {0, 0, 0, 0};
+	forward.route.push(0, 0, 0, INT_MAX, none); //column 0 holds the route number, not a stop
+	for(int p = 1; p <= stops; p++){
+		int eta = (int)tripNumber(s_tab[m][p], 29);
+		if(p >= 2 && eta <= 0)
+			forward.valid = false;
+		//the latest arrivals cost a registry lookup per stop and only the slack needs them
+		int latest = forward.valid ? latestArrival(s_tab[m][p]) + relax : INT_MAX;
+		const int load[4] = {(int)tripNumber(s_tab[m][p], 31), (int)tripNumber(s_tab[m][p], 32), (int)tripNumber(s_tab[m][p], CS_OCC), (int)tripNumber(s_tab[m][p], BS_OCC)};
+		forward.route.push(eta, (int)tripNumber(s_tab[m][p], 30), (int)tripNumber(s_tab[m][p], 28), latest, load);
+	}
+	if(forward.valid)
+		forward.route.build();
+}
+
+//Whether the stops after stop k stay on time when an insertion before stop k makes the vehicle
+//arrive there at arrival; the arrival at stop k itself is checked against endofsegtime
+bool insertionDelayFits(const ForwardSlack & forward, int k, int arrival){
+	return !forward.valid || forward.route.delayFits(k, arrival);
+}
+
 //////////////////////////searchtimeslotclustermatch/////////////////
 bool searchtimeslotclustermatch(string route, string wc,string inslack,double outsideofellipsevar, double maxdeviationfromstop_slack, string tripids, double maxfirststopdeadhead ){ //s_tab[m][1] : search to see if this route has any unassigned trips that can fit on it
 
@@ -4671,6 +6110,8 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 	for(int m = 0; m < MAXSEGMENTS; m++){
 		if(s_tab[m][0] == routeint){ // find the route
 			//  if(DEBUG == 1) gse << "Found the route " << endl;
+		ForwardSlack forwardslack;
+		buildForwardSlack(m, forwardslack);
 		for(int k = 1; k < MAXSTOPS; k++){ // for every stop on route
 			if(s_tab[m][k]==0)
 				break;
@@ -4769,36 +6210,36 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 				if(strcmp(schd_tab[s_tab[m][k-1]][7],"P")==0){
-					t1 = (int)ceil((to_number(schd_tab[s_tab[m][k-1]][4]) - aEarlypickup) ); // eta
+					t1 = (int)ceil((tripNumber(s_tab[m][k-1], 4) - aEarlypickup) ); // eta
 				}
 				else{
-					t1 = (int)ceil((to_number(schd_tab[s_tab[m][k-1]][4]) - aEarlydropoff) ); // eta
+					t1 = (int)ceil((tripNumber(s_tab[m][k-1], 4) - aEarlydropoff) ); // eta
 				}
 
-				if((int)ceil(to_number(schd_tab[s_tab[m][k-1]][30])) > t1){
-					t1 = (int)ceil(to_number(schd_tab[s_tab[m][k-1]][30]));
+				if((int)ceil(tripNumber(s_tab[m][k-1], 30)) > t1){
+					t1 = (int)ceil(tripNumber(s_tab[m][k-1], 30));
 
 				}
 
 				if(strcmp(schd_tab[s_tab[m][k]][7],"P")==0){
-					if((int)to_number(schd_tab[s_tab[m][k]][26]) > 0){
-						t2 =  (int)ceil(to_number(schd_tab[s_tab[m][k]][26]));
+					if((int)tripNumber(s_tab[m][k], 26) > 0){
+						t2 =  (int)ceil(tripNumber(s_tab[m][k], 26));
 					}
 					else{
-						t2 =  (int)ceil(to_number(schd_tab[s_tab[m][k]][30]));
+						t2 =  (int)ceil(tripNumber(s_tab[m][k], 30));
 					}
 				}
 				else{
-					if((int)to_number(schd_tab[s_tab[m][k]][27]) > 0){
-						t2 =  (int)ceil(to_number(schd_tab[s_tab[m][k]][27]));
+					if((int)tripNumber(s_tab[m][k], 27) > 0){
+						t2 =  (int)ceil(tripNumber(s_tab[m][k], 27));
 					}
 					else{
-						t2 =  (int)ceil(to_number(schd_tab[s_tab[m][k]][30]));
+						t2 =  (int)ceil(tripNumber(s_tab[m][k], 30));
 					}
 				}
 
-				if((int)ceil(to_number(schd_tab[s_tab[m][k]][4])) > t2){
-					t2 =  (int)ceil(to_number(schd_tab[s_tab[m][k]][4]));
+				if((int)ceil(tripNumber(s_tab[m][k], 4)) > t2){
+					t2 =  (int)ceil(tripNumber(s_tab[m][k], 4));
 				}
 
 				//int t2 =  (int)ceil(to_number(schd_tab[s_tab[m][k]][4])/15); // promise time
@@ -4806,22 +6247,17 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 				int segmentstart = s_tab[m][1];
 				int segmentend;
 
-				for(int z = 1; z < MAXSTOPS; z++){
-					if(s_tab[m][z] == 0){
-						segmentend = s_tab[m][z-1];
-						break;
-					}
-				}
+				segmentend = s_tab[m][segmentStopCount(m)];
 
 				//  if(DEBUG == 1) gse << "new verison" << endl;
 
 
-				if(t1 > (int)to_number(schd_tab[segmentend][4]))
-					t1 = (int)to_number(schd_tab[segmentend][4]);
+				if(t1 > (int)tripNumber(segmentend, 4))
+					t1 = (int)tripNumber(segmentend, 4);
 
 
-				if(t2 > (int)to_number(schd_tab[segmentend][4]))
-					t2 = (int)to_number(schd_tab[segmentend][4]);
+				if(t2 > (int)tripNumber(segmentend, 4))
+					t2 = (int)tripNumber(segmentend, 4);
 
 				if(DEBUG == 1) gse << "New stop " << k << endl;
 				//int etd = (int)to_number(schd_tab[s_tab[m][k-1]][30]);
@@ -4829,25 +6265,25 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 				int slack = t2 - t1;
 				int endofsegtime = 0;
 				if(strcmp(schd_tab[s_tab[m][k]][2], MAXSTOPNUM[0])==0){
-					endofsegtime = (int)to_number(schd_tab[s_tab[m][k]][4]);
+					endofsegtime = (int)tripNumber(s_tab[m][k], 4);
 					if(DEBUG == 1) gse << "The trip before is " << schd_tab[s_tab[m][k-1]][3]  << " " << schd_tab[s_tab[m][k-1]][7] << " With time " << schd_tab[s_tab[m][k-1]][4] << endl;
 					if(DEBUG == 1) gse << "The trip after is " << schd_tab[s_tab[m][k]][3] << " " << schd_tab[s_tab[m][k]][7] <<  " With time " << endofsegtime<<  endl;
 				}
 				else{
 					if(strcmp(schd_tab[s_tab[m][k]][7], "P")==0){
-						if((int)to_number(schd_tab[s_tab[m][k]][26])>0)
-							endofsegtime = (int)to_number(schd_tab[s_tab[m][k]][26]) + aLatepickup ;
+						if((int)tripNumber(s_tab[m][k], 26)>0)
+							endofsegtime = (int)tripNumber(s_tab[m][k], 26) + aLatepickup ;
 						else
-							endofsegtime = (int)to_number(schd_tab[s_tab[m][k]][4])  + aLatepickup ;
+							endofsegtime = (int)tripNumber(s_tab[m][k], 4)  + aLatepickup ;
 
 						if(DEBUG == 1) gse << "The trip before is " << schd_tab[s_tab[m][k-1]][3]  << " " << schd_tab[s_tab[m][k-1]][7] << " With time " << schd_tab[s_tab[m][k-1]][4] << endl;
 						if(DEBUG == 1) gse << "The trip after is " << schd_tab[s_tab[m][k]][3] << " " << schd_tab[s_tab[m][k]][7] <<  " With time " << endofsegtime - aLatepickup << " " << aLatepickup << endl;
 					}
 					else{
-						if((int)to_number(schd_tab[s_tab[m][k]][27])>0)
-							endofsegtime = (int)to_number(schd_tab[s_tab[m][k]][27]);
+						if((int)tripNumber(s_tab[m][k], 27)>0)
+							endofsegtime = (int)tripNumber(s_tab[m][k], 27);
 						else
-							endofsegtime = (int)to_number(schd_tab[s_tab[m][k]][4]);
+							endofsegtime = (int)tripNumber(s_tab[m][k], 4);
 
 						if(DEBUG == 1) gse << "The trip before is " << schd_tab[s_tab[m][k-1]][3]  << " " << schd_tab[s_tab[m][k-1]][7] << " With time " << schd_tab[s_tab[m][k-1]][4] << endl;
 						if(DEBUG == 1) gse << "The trip after is " << schd_tab[s_tab[m][k]][3]  << " " << schd_tab[s_tab[m][k]][7] << " With time " << endofsegtime << endl;
@@ -4862,8 +6298,8 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 				t2 = ceil(t2/15);
 				t1 = ceil(t1/15);
 
-				int wc_cap = (int)to_number(schd_tab[s_tab[m][1]][34]);
-				int amb_cap = (int)to_number(schd_tab[s_tab[m][1]][33]);
+				int wc_cap = (int)tripNumber(s_tab[m][1], 34);
+				int amb_cap = (int)tripNumber(s_tab[m][1], 33);
 				int cs_cap;
 				int cy_cap;
 
@@ -4893,10 +6329,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 								tripidx = i;
 								int timethreshold = (segmentend - segmentstart)*HEADHOMETHRESHOLD[0];
 								timethreshold = segmentend - timethreshold;
-								int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+								int triptimethreshold = ((int)tripNumber(tripidx, 4));
 
-								triptimeslot = (int)to_number(schd_tab[tripidx][41]);
-								tripcluster = (int)to_number(schd_tab[tripidx][42]);
+								triptimeslot = (int)tripNumber(tripidx, 41);
+								tripcluster = (int)tripNumber(tripidx, 42);
 								tripneighbors = schd_tab[tripidx][NEIGHBORS];
 								int aLatepickup2;
 								int prechecktime;
@@ -4946,28 +6382,28 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 											//  if(DEBUG == 1) gse << "here1 " << endl;
 										}
 									}
-									if((int)to_number(schd_tab[s_tab[m][k]][26]) ==0){
-										prechecktime =  (int)to_number(schd_tab[s_tab[m][k]][4]) +  90 - getCost(tripidx+1,s_tab[m][k]);
+									if((int)tripNumber(s_tab[m][k], 26) ==0){
+										prechecktime =  (int)tripNumber(s_tab[m][k], 4) +  90 - getCost(tripidx+1,s_tab[m][k]);
 									}
 									else{
-										prechecktime = (int)to_number(schd_tab[s_tab[m][k]][4]) + aLatepickup2 + floor((RELAXCONSTRAINTS[0] - 1)*50) - getCost(tripidx+1,s_tab[m][k]);
+										prechecktime = (int)tripNumber(s_tab[m][k], 4) + aLatepickup2 + floor((RELAXCONSTRAINTS[0] - 1)*50) - getCost(tripidx+1,s_tab[m][k]);
 									}
 
 
 								}
 								else{
-									if((int)to_number(schd_tab[s_tab[m][k]][27]) ==0 && (int)to_number(schd_tab[s_tab[m][k]][2]) != (int)to_number(MAXSTOPNUM[0])){
-										prechecktime =  (int)to_number(schd_tab[s_tab[m][k]][4]) +  90 - getCost(tripidx+1,s_tab[m][k]);
+									if((int)tripNumber(s_tab[m][k], 27) ==0 && (int)tripNumber(s_tab[m][k], 2) != (int)to_number(MAXSTOPNUM[0])){
+										prechecktime =  (int)tripNumber(s_tab[m][k], 4) +  90 - getCost(tripidx+1,s_tab[m][k]);
 									}
 									else{
-										prechecktime = (int)to_number(schd_tab[s_tab[m][k]][4]) + floor((RELAXCONSTRAINTS[0] - 1)*50) - getCost(tripidx+1,s_tab[m][k]);
+										prechecktime = (int)tripNumber(s_tab[m][k], 4) + floor((RELAXCONSTRAINTS[0] - 1)*50) - getCost(tripidx+1,s_tab[m][k]);
 									}
 								}
 
 
-								int segmenttimebefore = (int)to_number(schd_tab[s_tab[m][k - 1]][41]);
+								int segmenttimebefore = (int)tripNumber(s_tab[m][k - 1], 41);
 								//  if(DEBUG == 1) gse << "Segment time before = " << segmenttimebefore << endl;
-								if(triptimeslot >= segmenttimebefore -1 && (int)to_number(schd_tab[tripidx+1][4]) <= prechecktime
+								if(triptimeslot >= segmenttimebefore -1 && (int)tripNumber(tripidx+1, 4) <= prechecktime
 										//&& (int)to_number(schd_tab[s_tab[m][k]][31]) == 0 && (int)to_number(schd_tab[s_tab[m][k]][32]) == 0
 								){ //if not the first stop
 
@@ -5048,13 +6484,13 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 
-									/* int triptimeslot2 = (int)to_number(schd_tab[tripidx+1][41]);
+									/* int triptimeslot2 = (int)tripNumber(tripidx+1, 41);
                         int segtimeslot;
                         if(strcmp(schd_tab[s_tab[m][k]][7],"D")==0){
-                            segtimeslot = (int)to_number(schd_tab[s_tab[m][k]][41]);
+                            segtimeslot = (int)tripNumber(s_tab[m][k], 41);
                         }
                        else{
-                           segtimeslot = (int)to_number(schd_tab[s_tab[m][k]][41])  + (aLatepickup2/15)+1;
+                           segtimeslot = (int)tripNumber(s_tab[m][k], 41)  + (aLatepickup2/15)+1;
                        }*/
 
 
@@ -5073,17 +6509,17 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 											int extraperftime = 0;
-											int wc_occ = (int)to_number(schd_tab[s_tab[m][k-1]][32]);
-											int amb_occ = (int)to_number(schd_tab[s_tab[m][k-1]][31]);
-											int cs_occ = (int)to_number(schd_tab[s_tab[m][k-1]][CS_OCC]);
-											int cy_occ = (int)to_number(schd_tab[s_tab[m][k-1]][BS_OCC]);
+											int wc_occ = forwardslack.route.load(k-1, SLACKWC);
+											int amb_occ = forwardslack.route.load(k-1, SLACKAMB);
+											int cs_occ = forwardslack.route.load(k-1, SLACKCS);
+											int cy_occ = forwardslack.route.load(k-1, SLACKCY);
 
 
 											string pReturn_trip = schd_tab[tripidx][18];
 											string pDisability = schd_tab[tripidx][12];
 											string p_trip_type1 = schd_tab[tripidx][8];
 
-											int escort = (int)to_number(schd_tab[tripidx][13]);
+											int escort = (int)tripNumber(tripidx, 13);
 
 											if (pDisability.find("WC",0)!= string::npos || pDisability.find("SC",0)!= string::npos){
 												wc_occ = wc_occ + 1;
@@ -5124,7 +6560,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 													string pDisability = schd_tab[u][12];
 													string p_trip_type1 = schd_tab[u][8];
 
-													int escort = (int)to_number(schd_tab[u][13]);
+													int escort = (int)tripNumber(u, 13);
 
 													if (pDisability.find("WC",0)!= string::npos || pDisability.find("SC",0)!= string::npos){
 														wc_occ = wc_occ + 1;
@@ -5177,10 +6613,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 											if(strcmp(schd_tab[tripidx][42],schd_tab[s_tab[m][k-1]][42])==0){
 												string tempneighbors =  schd_tab[s_tab[m][k]][NEIGHBORS];
-												int tripcluster2 = (int)to_number(schd_tab[tripidx+1][42]);
+												int tripcluster2 = (int)tripNumber(tripidx+1, 42);
 												while(tempneighbors != ""){
 													int cidroute = (int)to_number(getNextToken(&(tempneighbors),","));
-													if(tripcluster2 == cidroute || tripcluster2 == (int)to_number(schd_tab[s_tab[m][k]][42])){
+													if(tripcluster2 == cidroute || tripcluster2 == (int)tripNumber(s_tab[m][k], 42)){
 
 
 														//  if(DEBUG == 1) gse << "The clusters directly match!" << endl;
@@ -5206,30 +6642,30 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 															else{
 																est_time =  (int)to_number(endtime1) - (int)to_number(est_traveltime1);
 															}
-															int trav_time =   (int)to_number(schd_tab[s_tab[m][k-1]][30]) + getTravTime_passedEta(s_tab[m][k-1],tripidx, to_string(est_time),"0");
-															int tripstarttime = (int)to_number(schd_tab[tripidx][26]);
+															int trav_time =   forwardslack.route.departure(k-1) + getTravTime_passedEta(s_tab[m][k-1],tripidx, to_string(est_time),"0");
+															int tripstarttime = (int)tripNumber(tripidx, 26);
 
-															if(DEBUG == 1) gse << "starting with time "<< (int)to_number(schd_tab[s_tab[m][k-1]][30]) << " " <<  trav_time - (int)to_number(schd_tab[s_tab[m][k-1]][30]) << endl;
+															if(DEBUG == 1) gse << "starting with time "<< forwardslack.route.departure(k-1) << " " <<  trav_time - forwardslack.route.departure(k-1) << endl;
 
 
 															if (trav_time < tripstarttime + aLatepickup + floor((RELAXCONSTRAINTS[0] - 1)*50) && tripstarttime > 0){
 
 
-																if(trav_time < to_number(schd_tab[tripidx][26])  - aEarlypickup && to_number(schd_tab[tripidx][26])!= 0 ){
-																	trav_time = to_number(schd_tab[tripidx][26]) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
+																if(trav_time < tripNumber(tripidx, 26)  - aEarlypickup && tripNumber(tripidx, 26)!= 0 ){
+																	trav_time = tripNumber(tripidx, 26) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
 																}
-																else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlypickup && to_number(schd_tab[tripidx][26])== 0 ){
-																	trav_time =  to_number(schd_tab[tripidx][4])  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
+																else if(trav_time < tripNumber(tripidx, 4) - aEarlypickup && tripNumber(tripidx, 26)== 0 ){
+																	trav_time =  tripNumber(tripidx, 4)  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																}
 																else{
 																	trav_time =  trav_time + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																}
 
 
-																if (to_number(schd_tab[tripidx][27]) > 0)
+																if (tripNumber(tripidx, 27) > 0)
 																{
-																	if(DEBUG == 1) gse << "End time of trip " << to_number(schd_tab[tripidx][27])  << " trav time " << trav_time << endl;
-																	if (trav_time > to_number(schd_tab[tripidx][27]) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
+																	if(DEBUG == 1) gse << "End time of trip " << tripNumber(tripidx, 27)  << " trav time " << trav_time << endl;
+																	if (trav_time > tripNumber(tripidx, 27) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
 																	{
 																		break;
 																	}
@@ -5237,11 +6673,11 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																}
 
 
-																if(trav_time < to_number(schd_tab[tripidx][27])  - aEarlydropoff && to_number(schd_tab[tripidx][27])!= 0 ){
-																	trav_time = to_number(schd_tab[tripidx][27]) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
+																if(trav_time < tripNumber(tripidx, 27)  - aEarlydropoff && tripNumber(tripidx, 27)!= 0 ){
+																	trav_time = tripNumber(tripidx, 27) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
 																}
-																else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlydropoff  && to_number(schd_tab[tripidx][27])== 0 ){
-																	trav_time =  to_number(schd_tab[tripidx][4])  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
+																else if(trav_time < tripNumber(tripidx, 4) - aEarlydropoff  && tripNumber(tripidx, 27)== 0 ){
+																	trav_time =  tripNumber(tripidx, 4)  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
 																}
 
 																if((int)to_number(endtime1)!= 0)
@@ -5253,23 +6689,23 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																if(endofsegtime > 0  ){
 
-																	if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																	if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50) && insertionDelayFits(forwardslack, k, trav_time)){
 
 																		if(strcmp(schd_tab[s_tab[m][k]][7],"D")==0  /*&& strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*//*&& strcmp(schd_tab[pickupafterstop][7],"P")==0 && strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*/ && strcmp(schd_tab[s_tab[m][k]][3],schd_tab[s_tab[m][k]][0])!=0){
 
 
 
-																			int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																			int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																			int doeta1 = trav_time;
 																			int actualTT = doeta1 - puetd1;
-																			if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																			if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																			string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																			string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																			double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																			string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																			string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																			string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																			string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																			double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																			string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																			string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -5281,26 +6717,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			int groupcnter = 1;
 																			routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																			//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																			for (int i = 0; i < MAXSEGMENTS; i++)
-																			{
-																				if (s_tab[i][0] == routeint)
-																				{
-																					for (int g = 1; g < MAXSTOPS; g++)
-																					{
-																						if (s_tab[i][g] == s_tab[m][k-1])
-																						{
-
-																							while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																								groupcnter++;
-																								g--;
-																							}
-																							//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																							break;
-																						}
-																					}
-																					break;
-																				}
-																			}
+																			groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																			groupcnter = groupcnter + groupnumber;
 
 
@@ -5329,24 +6746,24 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																		}
 																		//  if(DEBUG == 1) gse << "end time " << endofsegtime << " " << trav_time << endl;
-																		int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																		int segstart = (int)tripNumber(s_tab[m][1], 4);
 																		int segend;
 																		for (int g = 1; g < MAXSTOPS; g++)
 																		{
 																			if (s_tab[m][g] == 0)
 																			{
-																				segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																				segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																				break;
 
 																			}
 																		}
 																		int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																		int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																		int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																		timethreshold = segend - timethreshold;
 																		bool docalc = true;
 
-																		if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																		if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																				|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																		){
 
@@ -5365,12 +6782,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																			if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																				if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																				if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																					pudev = getCost(pickupafterstop,puid);
 																					dodev = getCost(doid,  dropoffafterstop);
 																				}
 																				else{
-																					pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																					pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																					dodev = pudev;
 
 																				}
@@ -5383,7 +6800,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																			docalc = false;
 
-																			if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																			if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																				double distpu =  getCost(tripidx, s_tab[m][k]);
 																				double distdo = getCost(tripidx+1, s_tab[m][k]);
 																				if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -5391,10 +6808,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				}
 																				double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																				if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																				if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																					if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																					distpu = 0;
-																					if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																					if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																						if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																						//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																							distdo = 0;
@@ -5405,7 +6822,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																						if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																						docalc = true;
 																					}
-																					else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																					else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																						if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																						docalc = true;
 																					}
@@ -5416,12 +6833,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																				if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																					if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																					if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																						pudev = getCost(pickupafterstop,puid);
 																						dodev = getCost(doid,  dropoffafterstop);
 																					}
 																					else{
-																						pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																						pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																						dodev = pudev;
 
 																					}
@@ -5431,7 +6848,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					dodev = 0;
 																				}
 
-																				if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																				if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																					if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																					docalc = true;
 
@@ -5466,7 +6883,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 
-																			if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																			if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																			if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																				AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -5555,16 +6972,16 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																			if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																				if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																					nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																				if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																					nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																				}
 																				else{
 																					nextstoptime = nextstoptime+p_perf_time2;
 																				}
 																			}
 																			else{
-																				if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																					nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																				if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																					nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																				}
 																				else{
 																					nextstoptime = nextstoptime+p_perf_time2;
@@ -5573,14 +6990,14 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																			int p_eta;
-																			if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																			if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																				p_eta = previouseta;
 																			}
 																			else{
-																				p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																				p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																			}
 
-																			nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																			nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																			if (pDisability3.find("LP",0) != string::npos){
@@ -5629,10 +7046,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																			bool preassigntripchange = true;
 
-																			int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																			int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																			int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																			int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																			if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																				endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																				endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																			}
 																			string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -5643,7 +7060,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																					{
 																						int dev =  p_eta - (starttime1 + aLatepickup);
-																						if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																						if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																							preassigntripchange = true;
 																						}
 
@@ -5656,7 +7073,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																					{
 																						int dev =  p_eta - (endtime1);
-																						if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																						if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																							preassigntripchange = true;
 																						}
 																					}
@@ -5670,7 +7087,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																						isLate = true;
 																						break;
 																					}
@@ -5681,12 +7098,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				}
 																				else{
 
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																						isLate = true;
 																						break;
 																					}
 																					else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																						if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																						if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																							isLate = true;
 																							break;}
 																					}
@@ -5726,10 +7143,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -5755,17 +7172,17 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 
-																		int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																		int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																		int doeta1 = trav_time;
 																		int actualTT = doeta1 - puetd1;
-																		if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																		if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																		string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																		string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																		double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																		string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																		string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																		string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																		string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																		double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																		string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																		string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -5777,26 +7194,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		int groupcnter = 1;
 																		routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																		//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																		for (int i = 0; i < MAXSEGMENTS; i++)
-																		{
-																			if (s_tab[i][0] == routeint)
-																			{
-																				for (int g = 1; g < MAXSTOPS; g++)
-																				{
-																					if (s_tab[i][g] == s_tab[m][k-1])
-																					{
-
-																						while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																							groupcnter++;
-																							g--;
-																						}
-																						//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																						break;
-																					}
-																				}
-																				break;
-																			}
-																		}
+																		groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																		groupcnter = groupcnter + groupnumber;
 																		int aAllowedTT;
 																		if(estdisttrip < a_mediumshortdistance1)
@@ -5822,24 +7220,24 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																	}
 																	//  if(DEBUG == 1) gse << "No end time " << endl;
-																	int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																	int segstart = (int)tripNumber(s_tab[m][1], 4);
 																	int segend;
 																	for (int g = 1; g < MAXSTOPS; g++)
 																	{
 																		if (s_tab[m][g] == 0)
 																		{
-																			segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																			segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																			break;
 
 																		}
 																	}
 																	int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																	int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																	int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																	timethreshold = segend - timethreshold;
 																	bool docalc = true;
 
-																	if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																	if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																			|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																	){
 																		double threshold;
@@ -5856,12 +7254,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																		if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																			if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																			if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																				pudev = getCost(pickupafterstop,puid);
 																				dodev = getCost(doid,  dropoffafterstop);
 																			}
 																			else{
-																				pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																				pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																				dodev = pudev;
 
 																			}
@@ -5874,7 +7272,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																		docalc = false;
 
-																		if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																		if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																			double distpu =  getCost(tripidx, s_tab[m][k]);
 																			double distdo = getCost(tripidx+1, s_tab[m][k]);
 																			if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -5882,10 +7280,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			}
 																			double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																			if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																			if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																				if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																				distpu = 0;
-																				if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																				if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																					if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																					//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																						distdo = 0;
@@ -5896,7 +7294,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																					docalc = true;
 																				}
-																				else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																				else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																					if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																					docalc = true;
 																				}
@@ -5906,12 +7304,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																			if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																				if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																				if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																					pudev = getCost(pickupafterstop,puid);
 																					dodev = getCost(doid,  dropoffafterstop);
 																				}
 																				else{
-																					pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																					pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																					dodev = pudev;
 
 																				}
@@ -5921,7 +7319,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				dodev = 0;
 																			}
 
-																			if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																			if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																				if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																				docalc = true;
 
@@ -5947,7 +7345,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																		set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																		if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																		if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																		if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																			AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -6029,16 +7427,16 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																		if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																			if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																				nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																			if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																				nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																			}
 																			else{
 																				nextstoptime = nextstoptime+p_perf_time2;
 																			}
 																		}
 																		else{
-																			if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																				nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																			if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																				nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																			}
 																			else{
 																				nextstoptime = nextstoptime+p_perf_time2;
@@ -6047,14 +7445,14 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																		int p_eta;
-																		if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																		if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																			p_eta = previouseta;
 																		}
 																		else{
-																			p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																			p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																		}
 
-																		nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																		nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 																		if (pDisability3.find("LP",0) != string::npos){
 																			aEarlypickup = 0;
@@ -6100,10 +7498,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																		bool preassigntripchange = true;
 
-																		int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																		int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																		int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																		int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																		if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																			endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																			endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																		}
 																		string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -6114,7 +7512,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																				{
 																					int dev =  p_eta - (starttime1 + aLatepickup);
-																					if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																					if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																						preassigntripchange = true;
 																					}
 
@@ -6127,7 +7525,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																				{
 																					int dev =  p_eta - (endtime1);
-																					if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																					if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																						preassigntripchange = true;
 																					}
 																				}
@@ -6138,7 +7536,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																				if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																				if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																					isLate = true;
 																					break;
 																				}
@@ -6149,12 +7547,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			}
 																			else{
 
-																				if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																				if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																					isLate = true;
 																					break;
 																				}
 																				else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																						isLate = true;
 																						break;}
 																				}
@@ -6194,10 +7592,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -6212,30 +7610,30 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 
-																if(trav_time < to_number(schd_tab[tripidx][26])  - aEarlypickup && to_number(schd_tab[tripidx][26])!= 0 ){
-																	trav_time = to_number(schd_tab[tripidx][26]) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
+																if(trav_time < tripNumber(tripidx, 26)  - aEarlypickup && tripNumber(tripidx, 26)!= 0 ){
+																	trav_time = tripNumber(tripidx, 26) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
 																}
-																else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlypickup && to_number(schd_tab[tripidx][26])== 0 ){
-																	trav_time =  to_number(schd_tab[tripidx][4])  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
+																else if(trav_time < tripNumber(tripidx, 4) - aEarlypickup && tripNumber(tripidx, 26)== 0 ){
+																	trav_time =  tripNumber(tripidx, 4)  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																}
 																else{
 																	trav_time =  trav_time + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																}
 
-																if (to_number(schd_tab[tripidx][27]) > 0)
-																{if(DEBUG == 1) gse << "End time of trip " << to_number(schd_tab[tripidx][27])  << " trav time " << trav_time << endl;
-																if (trav_time > to_number(schd_tab[tripidx][27]) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
+																if (tripNumber(tripidx, 27) > 0)
+																{if(DEBUG == 1) gse << "End time of trip " << tripNumber(tripidx, 27)  << " trav time " << trav_time << endl;
+																if (trav_time > tripNumber(tripidx, 27) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
 																{
 																	break;
 																}
 
 																}
 
-																if(trav_time < to_number(schd_tab[tripidx][27])  - aEarlydropoff && to_number(schd_tab[tripidx][27])!= 0 ){
-																	trav_time = to_number(schd_tab[tripidx][27]) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
+																if(trav_time < tripNumber(tripidx, 27)  - aEarlydropoff && tripNumber(tripidx, 27)!= 0 ){
+																	trav_time = tripNumber(tripidx, 27) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
 																}
-																else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlydropoff  && to_number(schd_tab[tripidx][27])== 0 ){
-																	trav_time =  to_number(schd_tab[tripidx][4])  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
+																else if(trav_time < tripNumber(tripidx, 4) - aEarlydropoff  && tripNumber(tripidx, 27)== 0 ){
+																	trav_time =  tripNumber(tripidx, 4)  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
 																}
 
 
@@ -6248,24 +7646,24 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																if(endofsegtime > 0  ){
 
-																	if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																	if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50) && insertionDelayFits(forwardslack, k, trav_time)){
 
 
 																		if(strcmp(schd_tab[s_tab[m][k]][7],"D")==0  /*&& strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*//*&& strcmp(schd_tab[pickupafterstop][7],"P")==0 && strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*/ && strcmp(schd_tab[s_tab[m][k]][3],schd_tab[s_tab[m][k]][0])!=0){
 
 
 
-																			int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																			int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																			int doeta1 = trav_time;
 																			int actualTT = doeta1 - puetd1;
-																			if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																			if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																			string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																			string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																			double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																			string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																			string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																			string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																			string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																			double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																			string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																			string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -6277,26 +7675,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			int groupcnter = 1;
 																			routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																			//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																			for (int i = 0; i < MAXSEGMENTS; i++)
-																			{
-																				if (s_tab[i][0] == routeint)
-																				{
-																					for (int g = 1; g < MAXSTOPS; g++)
-																					{
-																						if (s_tab[i][g] == s_tab[m][k-1])
-																						{
-
-																							while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																								groupcnter++;
-																								g--;
-																							}
-																							//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																							break;
-																						}
-																					}
-																					break;
-																				}
-																			}
+																			groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																			groupcnter = groupcnter + groupnumber;
 																			int aAllowedTT;
 																			if(estdisttrip < a_mediumshortdistance1)
@@ -6323,24 +7702,24 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		}
 
 
-																		int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																		int segstart = (int)tripNumber(s_tab[m][1], 4);
 																		int segend;
 																		for (int g = 1; g < MAXSTOPS; g++)
 																		{
 																			if (s_tab[m][g] == 0)
 																			{
-																				segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																				segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																				break;
 
 																			}
 																		}
 																		int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																		int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																		int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																		timethreshold = segend - timethreshold;
 																		bool docalc = true;
 
-																		if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																		if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																				|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																		){
 
@@ -6357,12 +7736,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																			if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																				if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																				if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																					pudev = getCost(pickupafterstop,puid);
 																					dodev = getCost(doid,  dropoffafterstop);
 																				}
 																				else{
-																					pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																					pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																					dodev = pudev;
 
 																				}
@@ -6375,7 +7754,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																			docalc = false;
 
-																			if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																			if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																				double distpu =  getCost(tripidx, s_tab[m][k]);
 																				double distdo = getCost(tripidx+1, s_tab[m][k]);
 																				if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -6383,10 +7762,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				}
 																				double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																				if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																				if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																					if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																					distpu = 0;
-																					if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																					if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																						if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																						//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																							distdo = 0;
@@ -6397,7 +7776,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																						if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																						docalc = true;
 																					}
-																					else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																					else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																						if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																						docalc = true;
 																					}
@@ -6407,12 +7786,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																				if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																					if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																					if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																						pudev = getCost(pickupafterstop,puid);
 																						dodev = getCost(doid,  dropoffafterstop);
 																					}
 																					else{
-																						pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																						pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																						dodev = pudev;
 
 																					}
@@ -6422,7 +7801,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					dodev = 0;
 																				}
 
-																				if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																				if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																					if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																					docalc = true;
 
@@ -6450,7 +7829,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																			set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																			if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																			if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																			if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																				AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -6532,16 +7911,16 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																			if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																				if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																					nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																				if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																					nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																				}
 																				else{
 																					nextstoptime = nextstoptime+p_perf_time2;
 																				}
 																			}
 																			else{
-																				if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																					nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																				if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																					nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																				}
 																				else{
 																					nextstoptime = nextstoptime+p_perf_time2;
@@ -6550,14 +7929,14 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																			int p_eta;
-																			if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																			if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																				p_eta = previouseta;
 																			}
 																			else{
-																				p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																				p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																			}
 
-																			nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																			nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																			if (pDisability3.find("LP",0) != string::npos){
@@ -6602,10 +7981,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																			bool preassigntripchange = true;
 
-																			int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																			int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																			int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																			int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																			if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																				endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																				endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																			}
 																			string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -6616,7 +7995,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																					{
 																						int dev =  p_eta - (starttime1 + aLatepickup);
-																						if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																						if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																							preassigntripchange = true;
 																						}
 
@@ -6629,7 +8008,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																					{
 																						int dev =  p_eta - (endtime1);
-																						if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																						if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																							preassigntripchange = true;
 																						}
 																					}
@@ -6641,7 +8020,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																						isLate = true;
 																						break;
 																					}
@@ -6652,12 +8031,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				}
 																				else{
 
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																						isLate = true;
 																						break;
 																					}
 																					else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																						if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																						if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																							isLate = true;
 																							break;}
 																					}
@@ -6696,10 +8075,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -6718,17 +8097,17 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 
-																		int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																		int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																		int doeta1 = trav_time;
 																		int actualTT = doeta1 - puetd1;
-																		if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																		if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																		string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																		string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																		double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																		string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																		string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																		string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																		string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																		double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																		string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																		string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -6740,26 +8119,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		int groupcnter = 1;
 																		routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																		//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																		for (int i = 0; i < MAXSEGMENTS; i++)
-																		{
-																			if (s_tab[i][0] == routeint)
-																			{
-																				for (int g = 1; g < MAXSTOPS; g++)
-																				{
-																					if (s_tab[i][g] == s_tab[m][k-1])
-																					{
-
-																						while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																							groupcnter++;
-																							g--;
-																						}
-																						//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																						break;
-																					}
-																				}
-																				break;
-																			}
-																		}
+																		groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																		groupcnter = groupcnter + groupnumber;
 																		int aAllowedTT;
 																		if(estdisttrip < a_mediumshortdistance1)
@@ -6784,24 +8144,24 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																	}
-																	int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																	int segstart = (int)tripNumber(s_tab[m][1], 4);
 																	int segend;
 																	for (int g = 1; g < MAXSTOPS; g++)
 																	{
 																		if (s_tab[m][g] == 0)
 																		{
-																			segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																			segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																			break;
 
 																		}
 																	}
 																	int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																	int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																	int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																	timethreshold = segend - timethreshold;
 																	bool docalc = true;
 
-																	if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																	if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																			|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																	){
 
@@ -6818,12 +8178,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																		if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																			if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																			if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																				pudev = getCost(pickupafterstop,puid);
 																				dodev = getCost(doid,  dropoffafterstop);
 																			}
 																			else{
-																				pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																				pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																				dodev = pudev;
 
 																			}
@@ -6836,7 +8196,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																		docalc = false;
 
-																		if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																		if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																			double distpu =  getCost(tripidx, s_tab[m][k]);
 																			double distdo = getCost(tripidx+1, s_tab[m][k]);
 																			if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -6844,10 +8204,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			}
 																			double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																			if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																			if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																				if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																				distpu = 0;
-																				if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																				if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																					if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																					//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																						distdo = 0;
@@ -6858,7 +8218,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																					docalc = true;
 																				}
-																				else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																				else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																					if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																					docalc = true;
 																				}
@@ -6868,12 +8228,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																			if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																				if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																				if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																					pudev = getCost(pickupafterstop,puid);
 																					dodev = getCost(doid,  dropoffafterstop);
 																				}
 																				else{
-																					pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																					pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																					dodev = pudev;
 
 																				}
@@ -6883,7 +8243,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				dodev = 0;
 																			}
 
-																			if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																			if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																				if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																				docalc = true;
 
@@ -6910,7 +8270,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		int p_perf_time2;
 																		set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																		if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																		if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																		if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																			AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -6992,16 +8352,16 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																		if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																			if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																				nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																			if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																				nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																			}
 																			else{
 																				nextstoptime = nextstoptime+p_perf_time2;
 																			}
 																		}
 																		else{
-																			if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																				nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																			if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																				nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																			}
 																			else{
 																				nextstoptime = nextstoptime+p_perf_time2;
@@ -7010,14 +8370,14 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																		int p_eta;
-																		if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																		if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																			p_eta = previouseta;
 																		}
 																		else{
-																			p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																			p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																		}
 
-																		nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																		nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																		if (pDisability3.find("LP",0) != string::npos){
@@ -7062,10 +8422,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		}
 																		bool preassigntripchange = true;
 
-																		int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																		int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																		int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																		int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																		if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																			endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																			endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																		}
 																		string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -7076,7 +8436,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																				{
 																					int dev =  p_eta - (starttime1 + aLatepickup);
-																					if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																					if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																						preassigntripchange = true;
 																					}
 
@@ -7089,7 +8449,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																				{
 																					int dev =  p_eta - (endtime1);
-																					if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																					if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																						preassigntripchange = true;
 																					}
 																				}
@@ -7101,7 +8461,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		if(preassigntripchange){
 																			if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
-																				if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																				if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																					isLate = true;
 																					break;
 																				}
@@ -7112,12 +8472,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			}
 																			else{
 
-																				if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																				if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																					isLate = true;
 																					break;
 																				}
 																				else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																						isLate = true;
 																						break;}
 																				}
@@ -7156,10 +8516,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -7189,13 +8549,13 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 											//int temproutecluster  = (int)to_number( schd_tab[s_tab[m][k-1]][42]);
 											string temp2 = schd_tab[s_tab[m][k]][NEIGHBORS];
-											int tripcluster2 = (int)to_number(schd_tab[tripidx+1][42]);
+											int tripcluster2 = (int)tripNumber(tripidx+1, 42);
 											while(temp != ""){
 												cidroute = (int)to_number(getNextToken(&(temp),","));
 												if(tripcluster == cidroute){
 													while(temp2 != ""){
 														int cidroute2 = (int)to_number(getNextToken(&(temp2),","));
-														if(tripcluster2 == cidroute2 || tripcluster2 == (int)to_number(schd_tab[s_tab[m][k]][42])){
+														if(tripcluster2 == cidroute2 || tripcluster2 == (int)tripNumber(s_tab[m][k], 42)){
 															//if(cid == cidroute || cid == temproutecluster || cidroute  == tripcluster || tripcluster == temproutecluster)
 															bool skiproute = skipsegment(tripidx, schd_tab[s_tab[m][k]][0]);
 															if(!skiproute){
@@ -7218,28 +8578,28 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																else{
 																	est_time =  (int)to_number(endtime1) - (int)to_number(est_traveltime1);
 																}
-																int trav_time =   (int)to_number(schd_tab[s_tab[m][k-1]][30]) + getTravTime_passedEta(s_tab[m][k-1],tripidx, to_string(est_time),"0");
-																int tripstarttime = (int)to_number(schd_tab[tripidx][26]);
+																int trav_time =   forwardslack.route.departure(k-1) + getTravTime_passedEta(s_tab[m][k-1],tripidx, to_string(est_time),"0");
+																int tripstarttime = (int)tripNumber(tripidx, 26);
 
 																//if(DEBUG == 1) gse << "1:" << trav_time << endl;
 
 																if (trav_time < tripstarttime + aLatepickup + floor((RELAXCONSTRAINTS[0] - 1)*50) && tripstarttime > 0){
 
 
-																	if(trav_time < to_number(schd_tab[tripidx][26])  - aEarlypickup && to_number(schd_tab[tripidx][26])!= 0 ){
-																		trav_time = to_number(schd_tab[tripidx][26]) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
+																	if(trav_time < tripNumber(tripidx, 26)  - aEarlypickup && tripNumber(tripidx, 26)!= 0 ){
+																		trav_time = tripNumber(tripidx, 26) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
 																	}
-																	else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlypickup && to_number(schd_tab[tripidx][26])== 0 ){
-																		trav_time =  to_number(schd_tab[tripidx][4])  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
+																	else if(trav_time < tripNumber(tripidx, 4) - aEarlypickup && tripNumber(tripidx, 26)== 0 ){
+																		trav_time =  tripNumber(tripidx, 4)  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																	}
 																	else{
 																		trav_time =  trav_time + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																	}
 
-																	if (to_number(schd_tab[tripidx][27]) > 0)
+																	if (tripNumber(tripidx, 27) > 0)
 																	{
-																		if(DEBUG == 1) gse << "End time of trip " << to_number(schd_tab[tripidx][27])  << " trav time " << trav_time << endl;
-																		if (trav_time > to_number(schd_tab[tripidx][27]) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
+																		if(DEBUG == 1) gse << "End time of trip " << tripNumber(tripidx, 27)  << " trav time " << trav_time << endl;
+																		if (trav_time > tripNumber(tripidx, 27) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
 																		{
 																			break;
 																		}
@@ -7248,11 +8608,11 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																	//if(DEBUG == 1) gse << "2:" << trav_time << endl;
 
-																	if(trav_time < to_number(schd_tab[tripidx][27])  - aEarlydropoff && to_number(schd_tab[tripidx][27])!= 0 ){
-																		trav_time = to_number(schd_tab[tripidx][27]) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
+																	if(trav_time < tripNumber(tripidx, 27)  - aEarlydropoff && tripNumber(tripidx, 27)!= 0 ){
+																		trav_time = tripNumber(tripidx, 27) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
 																	}
-																	else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlydropoff  && to_number(schd_tab[tripidx][27])== 0 ){
-																		trav_time =  to_number(schd_tab[tripidx][4])  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
+																	else if(trav_time < tripNumber(tripidx, 4) - aEarlydropoff  && tripNumber(tripidx, 27)== 0 ){
+																		trav_time =  tripNumber(tripidx, 4)  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
 																	}
 
 
@@ -7267,22 +8627,22 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																	if(endofsegtime > 0  ){
 
-																		if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																		if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50) && insertionDelayFits(forwardslack, k, trav_time)){
 																			if(strcmp(schd_tab[s_tab[m][k]][7],"D")==0  /*&& strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*//*&& strcmp(schd_tab[pickupafterstop][7],"P")==0 && strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*/ && strcmp(schd_tab[s_tab[m][k]][3],schd_tab[s_tab[m][k]][0])!=0){
 
 
 
-																				int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																				int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																				int doeta1 = trav_time;
 																				int actualTT = doeta1 - puetd1;
-																				if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																				if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																				string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																				string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																				double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																				string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																				string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																				string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																				string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																				double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																				string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																				string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -7294,26 +8654,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				int groupcnter = 1;
 																				routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																				//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																				for (int i = 0; i < MAXSEGMENTS; i++)
-																				{
-																					if (s_tab[i][0] == routeint)
-																					{
-																						for (int g = 1; g < MAXSTOPS; g++)
-																						{
-																							if (s_tab[i][g] == s_tab[m][k-1])
-																							{
-
-																								while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																									groupcnter++;
-																									g--;
-																								}
-																								//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																								break;
-																							}
-																						}
-																						break;
-																					}
-																				}
+																				groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																				groupcnter = groupcnter + groupnumber;
 																				int aAllowedTT;
 																				if(estdisttrip < a_mediumshortdistance1)
@@ -7339,24 +8680,24 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																			}
 
-																			int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																			int segstart = (int)tripNumber(s_tab[m][1], 4);
 																			int segend;
 																			for (int g = 1; g < MAXSTOPS; g++)
 																			{
 																				if (s_tab[m][g] == 0)
 																				{
-																					segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																					segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																					break;
 
 																				}
 																			}
 																			int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																			int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																			int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																			timethreshold = segend - timethreshold;
 																			bool docalc = true;
 
-																			if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																			if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																					|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																			){
 
@@ -7373,12 +8714,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																				if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																					if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																					if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																						pudev = getCost(pickupafterstop,puid);
 																						dodev = getCost(doid,  dropoffafterstop);
 																					}
 																					else{
-																						pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																						pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																						dodev = pudev;
 
 																					}
@@ -7391,7 +8732,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																				docalc = false;
 
-																				if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																				if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																					double distpu =  getCost(tripidx, s_tab[m][k]);
 																					double distdo = getCost(tripidx+1, s_tab[m][k]);
 																					if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -7399,10 +8740,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					}
 																					double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																					if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																					if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																						if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																						distpu = 0;
-																						if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																						if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																							if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																							//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																								distdo = 0;
@@ -7413,7 +8754,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																							if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																							docalc = true;
 																						}
-																						else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																						else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																							if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																							docalc = true;
 																						}
@@ -7423,12 +8764,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																					if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																						if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																						if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																							pudev = getCost(pickupafterstop,puid);
 																							dodev = getCost(doid,  dropoffafterstop);
 																						}
 																						else{
-																							pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																							pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																							dodev = pudev;
 
 																						}
@@ -7438,7 +8779,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																						dodev = 0;
 																					}
 
-																					if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																					if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																						if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																						docalc = true;
 
@@ -7466,7 +8807,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																				set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																				if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																				if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																				if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																					AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -7548,16 +8889,16 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																				if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																					if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																						nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																					if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																						nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																					}
 																					else{
 																						nextstoptime = nextstoptime+p_perf_time2;
 																					}
 																				}
 																				else{
-																					if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																						nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																					if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																						nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																					}
 																					else{
 																						nextstoptime = nextstoptime+p_perf_time2;
@@ -7566,14 +8907,14 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																				int p_eta;
-																				if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																				if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																					p_eta = previouseta;
 																				}
 																				else{
-																					p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																					p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																				}
 
-																				nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																				nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																				if (pDisability3.find("LP",0) != string::npos){
@@ -7618,10 +8959,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																				bool preassigntripchange = true;
 
-																				int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																				int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																				int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																				int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																				if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																					endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																					endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																				}
 																				string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -7632,7 +8973,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																						if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																						{
 																							int dev =  p_eta - (starttime1 + aLatepickup);
-																							if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																							if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																								preassigntripchange = true;
 																							}
 
@@ -7645,7 +8986,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																						if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																						{
 																							int dev =  p_eta - (endtime1);
-																							if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																							if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																								preassigntripchange = true;
 																							}
 																						}
@@ -7656,7 +8997,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				if(preassigntripchange){
 																					if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
-																						if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																						if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																							isLate = true;
 																							break;
 																						}
@@ -7667,12 +9008,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					}
 																					else{
 
-																						if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																						if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																							isLate = true;
 																							break;
 																						}
 																						else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																							if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																							if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																								isLate = true;
 																								break;}
 																						}
@@ -7711,10 +9052,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -7733,17 +9074,17 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 
-																			int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																			int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																			int doeta1 = trav_time;
 																			int actualTT = doeta1 - puetd1;
-																			if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																			if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																			string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																			string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																			double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																			string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																			string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																			string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																			string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																			double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																			string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																			string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -7755,26 +9096,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			int groupcnter = 1;
 																			routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																			//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																			for (int i = 0; i < MAXSEGMENTS; i++)
-																			{
-																				if (s_tab[i][0] == routeint)
-																				{
-																					for (int g = 1; g < MAXSTOPS; g++)
-																					{
-																						if (s_tab[i][g] == s_tab[m][k-1])
-																						{
-
-																							while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																								groupcnter++;
-																								g--;
-																							}
-																							//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																							break;
-																						}
-																					}
-																					break;
-																				}
-																			}
+																			groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																			groupcnter = groupcnter + groupnumber;
 																			int aAllowedTT;
 																			if(estdisttrip < a_mediumshortdistance1)
@@ -7799,24 +9121,24 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																		}
-																		int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																		int segstart = (int)tripNumber(s_tab[m][1], 4);
 																		int segend;
 																		for (int g = 1; g < MAXSTOPS; g++)
 																		{
 																			if (s_tab[m][g] == 0)
 																			{
-																				segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																				segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																				break;
 
 																			}
 																		}
 																		int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																		int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																		int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																		timethreshold = segend - timethreshold;
 																		bool docalc = true;
 
-																		if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																		if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																				|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																		){
 																			double threshold;
@@ -7833,12 +9155,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																			if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																				if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																				if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																					pudev = getCost(pickupafterstop,puid);
 																					dodev = getCost(doid,  dropoffafterstop);
 																				}
 																				else{
-																					pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																					pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																					dodev = pudev;
 
 																				}
@@ -7851,7 +9173,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																			docalc = false;
 
-																			if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																			if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																				double distpu =  getCost(tripidx, s_tab[m][k]);
 																				double distdo = getCost(tripidx+1, s_tab[m][k]);
 																				if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -7859,10 +9181,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				}
 																				double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																				if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																				if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																					if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																					distpu = 0;
-																					if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																					if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																						if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																						//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																							distdo = 0;
@@ -7873,7 +9195,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																						if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																						docalc = true;
 																					}
-																					else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																					else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																						if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																						docalc = true;
 																					}
@@ -7883,12 +9205,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																				if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																					if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																					if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																						pudev = getCost(pickupafterstop,puid);
 																						dodev = getCost(doid,  dropoffafterstop);
 																					}
 																					else{
-																						pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																						pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																						dodev = pudev;
 
 																					}
@@ -7898,7 +9220,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					dodev = 0;
 																				}
 
-																				if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																				if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																					if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																					docalc = true;
 
@@ -7926,7 +9248,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																			set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																			if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																			if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																			if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																				AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -8008,16 +9330,16 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																			if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																				if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																					nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																				if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																					nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																				}
 																				else{
 																					nextstoptime = nextstoptime+p_perf_time2;
 																				}
 																			}
 																			else{
-																				if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																					nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																				if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																					nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																				}
 																				else{
 																					nextstoptime = nextstoptime+p_perf_time2;
@@ -8026,14 +9348,14 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																			int p_eta;
-																			if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																			if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																				p_eta = previouseta;
 																			}
 																			else{
-																				p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																				p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																			}
 
-																			nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																			nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																			if (pDisability3.find("LP",0) != string::npos){
@@ -8078,10 +9400,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																			bool preassigntripchange = true;
 
-																			int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																			int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																			int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																			int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																			if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																				endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																				endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																			}
 																			string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -8092,7 +9414,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																					{
 																						int dev =  p_eta - (starttime1 + aLatepickup);
-																						if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																						if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																							preassigntripchange = true;
 																						}
 
@@ -8105,7 +9427,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																					{
 																						int dev =  p_eta - (endtime1);
-																						if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																						if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																							preassigntripchange = true;
 																						}
 																					}
@@ -8117,7 +9439,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																						isLate = true;
 																						break;
 																					}
@@ -8128,12 +9450,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				}
 																				else{
 
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																						isLate = true;
 																						break;
 																					}
 																					else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																						if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																						if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																							isLate = true;
 																							break;}
 																					}
@@ -8172,10 +9494,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -8190,30 +9512,30 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																else if(tripstarttime == 0) {
 																	if(DEBUG == 1) gse << "no start time " << endl;
 
-																	if(trav_time < to_number(schd_tab[tripidx][26])  - aEarlypickup && to_number(schd_tab[tripidx][26])!= 0 ){
-																		trav_time = to_number(schd_tab[tripidx][26]) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
+																	if(trav_time < tripNumber(tripidx, 26)  - aEarlypickup && tripNumber(tripidx, 26)!= 0 ){
+																		trav_time = tripNumber(tripidx, 26) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
 																	}
-																	else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlypickup && to_number(schd_tab[tripidx][26])== 0 ){
-																		trav_time =  to_number(schd_tab[tripidx][4])  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
+																	else if(trav_time < tripNumber(tripidx, 4) - aEarlypickup && tripNumber(tripidx, 26)== 0 ){
+																		trav_time =  tripNumber(tripidx, 4)  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																	}
 																	else{
 																		trav_time =  trav_time + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																	}
 
-																	if (to_number(schd_tab[tripidx][27]) > 0)
-																	{if(DEBUG == 1) gse << "End time of trip " << to_number(schd_tab[tripidx][27])  << " trav time " << trav_time << endl;
-																	if (trav_time > to_number(schd_tab[tripidx][27]) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
+																	if (tripNumber(tripidx, 27) > 0)
+																	{if(DEBUG == 1) gse << "End time of trip " << tripNumber(tripidx, 27)  << " trav time " << trav_time << endl;
+																	if (trav_time > tripNumber(tripidx, 27) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
 																	{
 																		break;
 																	}
 
 																	}
 
-																	if(trav_time < to_number(schd_tab[tripidx][27])  - aEarlydropoff && to_number(schd_tab[tripidx][27])!= 0 ){
-																		trav_time = to_number(schd_tab[tripidx][27]) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
+																	if(trav_time < tripNumber(tripidx, 27)  - aEarlydropoff && tripNumber(tripidx, 27)!= 0 ){
+																		trav_time = tripNumber(tripidx, 27) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
 																	}
-																	else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlydropoff  && to_number(schd_tab[tripidx][27])== 0 ){
-																		trav_time =  to_number(schd_tab[tripidx][4])  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
+																	else if(trav_time < tripNumber(tripidx, 4) - aEarlydropoff  && tripNumber(tripidx, 27)== 0 ){
+																		trav_time =  tripNumber(tripidx, 4)  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
 																	}
 
 
@@ -8226,22 +9548,22 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																	if(endofsegtime > 0  ){
 
-																		if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																		if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50) && insertionDelayFits(forwardslack, k, trav_time)){
 																			if(strcmp(schd_tab[s_tab[m][k]][7],"D")==0  /*&& strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*//*&& strcmp(schd_tab[pickupafterstop][7],"P")==0 && strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*/ && strcmp(schd_tab[s_tab[m][k]][3],schd_tab[s_tab[m][k]][0])!=0){
 
 
 
-																				int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																				int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																				int doeta1 = trav_time;
 																				int actualTT = doeta1 - puetd1;
-																				if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																				if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																				string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																				string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																				double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																				string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																				string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																				string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																				string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																				double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																				string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																				string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -8253,26 +9575,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				int groupcnter = 1;
 																				routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																				//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																				for (int i = 0; i < MAXSEGMENTS; i++)
-																				{
-																					if (s_tab[i][0] == routeint)
-																					{
-																						for (int g = 1; g < MAXSTOPS; g++)
-																						{
-																							if (s_tab[i][g] == s_tab[m][k-1])
-																							{
-
-																								while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																									groupcnter++;
-																									g--;
-																								}
-																								//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																								break;
-																							}
-																						}
-																						break;
-																					}
-																				}
+																				groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																				groupcnter = groupcnter + groupnumber;
 																				int aAllowedTT;
 																				if(estdisttrip < a_mediumshortdistance1)
@@ -8297,24 +9600,24 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																			}
-																			int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																			int segstart = (int)tripNumber(s_tab[m][1], 4);
 																			int segend;
 																			for (int g = 1; g < MAXSTOPS; g++)
 																			{
 																				if (s_tab[m][g] == 0)
 																				{
-																					segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																					segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																					break;
 
 																				}
 																			}
 																			int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																			int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																			int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																			timethreshold = segend - timethreshold;
 																			bool docalc = true;
 
-																			if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																			if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																					|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																			){
 
@@ -8332,12 +9635,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																				if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																					if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																					if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																						pudev = getCost(pickupafterstop,puid);
 																						dodev = getCost(doid,  dropoffafterstop);
 																					}
 																					else{
-																						pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																						pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																						dodev = pudev;
 
 																					}
@@ -8350,7 +9653,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																				docalc = false;
 
-																				if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																				if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																					double distpu =  getCost(tripidx, s_tab[m][k]);
 																					double distdo = getCost(tripidx+1, s_tab[m][k]);
 																					if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -8358,10 +9661,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					}
 																					double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																					if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																					if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																						if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																						distpu = 0;
-																						if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																						if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																							if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																							//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																								distdo = 0;
@@ -8372,7 +9675,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																							if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																							docalc = true;
 																						}
-																						else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																						else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																							if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																							docalc = true;
 																						}
@@ -8382,12 +9685,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																					if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																						if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																						if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																							pudev = getCost(pickupafterstop,puid);
 																							dodev = getCost(doid,  dropoffafterstop);
 																						}
 																						else{
-																							pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																							pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																							dodev = pudev;
 
 																						}
@@ -8397,7 +9700,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																						dodev = 0;
 																					}
 
-																					if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																					if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																						if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																						docalc = true;
 
@@ -8425,7 +9728,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																				set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																				if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																				if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																				if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																					AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -8507,16 +9810,16 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																				if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																					if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																						nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																					if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																						nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																					}
 																					else{
 																						nextstoptime = nextstoptime+p_perf_time2;
 																					}
 																				}
 																				else{
-																					if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																						nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																					if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																						nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																					}
 																					else{
 																						nextstoptime = nextstoptime+p_perf_time2;
@@ -8525,14 +9828,14 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																				int p_eta;
-																				if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																				if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																					p_eta = previouseta;
 																				}
 																				else{
-																					p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																					p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																				}
 
-																				nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																				nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																				if (pDisability3.find("LP",0) != string::npos){
@@ -8576,10 +9879,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				}
 																				bool preassigntripchange = true;
 
-																				int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																				int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																				int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																				int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																				if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																					endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																					endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																				}
 																				string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -8590,7 +9893,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																						if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																						{
 																							int dev =  p_eta - (starttime1 + aLatepickup);
-																							if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																							if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																								preassigntripchange = true;
 																							}
 
@@ -8603,7 +9906,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																						if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																						{
 																							int dev =  p_eta - (endtime1);
-																							if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																							if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																								preassigntripchange = true;
 																							}
 																						}
@@ -8615,7 +9918,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																						if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																						if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																							isLate = true;
 																							break;
 																						}
@@ -8626,12 +9929,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					}
 																					else{
 
-																						if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																						if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																							isLate = true;
 																							break;
 																						}
 																						else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																							if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																							if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																								isLate = true;
 																								break;}
 																						}
@@ -8670,10 +9973,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -8691,17 +9994,17 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 
-																			int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																			int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																			int doeta1 = trav_time;
 																			int actualTT = doeta1 - puetd1;
-																			if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																			if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																			string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																			string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																			double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																			string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																			string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																			string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																			string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																			double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																			string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																			string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -8713,26 +10016,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			int groupcnter = 1;
 																			routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																			//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																			for (int i = 0; i < MAXSEGMENTS; i++)
-																			{
-																				if (s_tab[i][0] == routeint)
-																				{
-																					for (int g = 1; g < MAXSTOPS; g++)
-																					{
-																						if (s_tab[i][g] == s_tab[m][k-1])
-																						{
-
-																							while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																								groupcnter++;
-																								g--;
-																							}
-																							//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																							break;
-																						}
-																					}
-																					break;
-																				}
-																			}
+																			groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																			groupcnter = groupcnter + groupnumber;
 																			int aAllowedTT;
 																			if(estdisttrip < a_mediumshortdistance1)
@@ -8757,24 +10041,24 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																		}
-																		int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																		int segstart = (int)tripNumber(s_tab[m][1], 4);
 																		int segend;
 																		for (int g = 1; g < MAXSTOPS; g++)
 																		{
 																			if (s_tab[m][g] == 0)
 																			{
-																				segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																				segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																				break;
 
 																			}
 																		}
 																		int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																		int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																		int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																		timethreshold = segend - timethreshold;
 																		bool docalc = true;
 
-																		if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																		if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																				|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																		){
 
@@ -8792,12 +10076,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																			if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																				if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																				if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																					pudev = getCost(pickupafterstop,puid);
 																					dodev = getCost(doid,  dropoffafterstop);
 																				}
 																				else{
-																					pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																					pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																					dodev = pudev;
 
 																				}
@@ -8810,7 +10094,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																			docalc = false;
 
-																			if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																			if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																				double distpu =  getCost(tripidx, s_tab[m][k]);
 																				double distdo = getCost(tripidx+1, s_tab[m][k]);
 																				if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -8818,10 +10102,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				}
 																				double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																				if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																				if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																					if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																					distpu = 0;
-																					if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																					if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																						if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																						//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																							distdo = 0;
@@ -8832,7 +10116,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																						if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																						docalc = true;
 																					}
-																					else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																					else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																						if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																						docalc = true;
 																					}
@@ -8842,12 +10126,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																				if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																					if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																					if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																						pudev = getCost(pickupafterstop,puid);
 																						dodev = getCost(doid,  dropoffafterstop);
 																					}
 																					else{
-																						pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																						pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																						dodev = pudev;
 
 																					}
@@ -8857,7 +10141,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					dodev = 0;
 																				}
 
-																				if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																				if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																					if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																					docalc = true;
 
@@ -8885,7 +10169,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																			set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																			if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																			if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																			if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																				AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -8967,16 +10251,16 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																			if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																				if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																					nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																				if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																					nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																				}
 																				else{
 																					nextstoptime = nextstoptime+p_perf_time2;
 																				}
 																			}
 																			else{
-																				if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																					nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																				if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																					nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																				}
 																				else{
 																					nextstoptime = nextstoptime+p_perf_time2;
@@ -8985,14 +10269,14 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																			int p_eta;
-																			if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																			if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																				p_eta = previouseta;
 																			}
 																			else{
-																				p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																				p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																			}
 
-																			nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																			nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																			if (pDisability3.find("LP",0) != string::npos){
@@ -9036,10 +10320,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			}
 																			bool preassigntripchange = true;
 
-																			int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																			int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																			int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																			int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																			if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																				endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																				endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																			}
 																			string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -9050,7 +10334,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																					{
 																						int dev =  p_eta - (starttime1 + aLatepickup);
-																						if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																						if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																							preassigntripchange = true;
 																						}
 
@@ -9063,7 +10347,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																					if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																					{
 																						int dev =  p_eta - (endtime1);
-																						if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																						if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																							preassigntripchange = true;
 																						}
 																					}
@@ -9074,7 +10358,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																						isLate = true;
 																						break;
 																					}
@@ -9085,12 +10369,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				}
 																				else{
 
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																						isLate = true;
 																						break;
 																					}
 																					else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																						if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																						if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																							isLate = true;
 																							break;}
 																					}
@@ -9129,10 +10413,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -9173,7 +10457,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 												if(!skiproute)
 													return true;
 											}
-											else if((/*timethreshold <= slack &&*/ triptimethreshold > timethreshold) && inslack == "N" && (strcmp(schd_tab[s_tab[m][k-1]][2], "1")!=0  || strcmp(schd_tab[s_tab[m][k]][2], MAXSTOPNUM[0])!=0) && (distpu/to_number(schd_tab[pickupafterstop][6])) < MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[pickupafterstop][6])) < MAXDEADHEADVARIANCE[0]){
+											else if((/*timethreshold <= slack &&*/ triptimethreshold > timethreshold) && inslack == "N" && (strcmp(schd_tab[s_tab[m][k-1]][2], "1")!=0  || strcmp(schd_tab[s_tab[m][k]][2], MAXSTOPNUM[0])!=0) && (distpu/tripNumber(pickupafterstop, 6)) < MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(pickupafterstop, 6)) < MAXDEADHEADVARIANCE[0]){
 												skiproute = skipsegment(tripidx, schd_tab[s_tab[m][k]][0]);
 												if(!skiproute)
 													return true;
@@ -9202,38 +10486,38 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 													else{
 														est_time =  (int)to_number(endtime1) - (int)to_number(est_traveltime1);
 													}
-													int trav_time =   (int)to_number(schd_tab[s_tab[m][k-1]][30]) +getTravTime_passedEta(s_tab[m][k-1],tripidx, to_string(est_time),"0");
-													int tripstarttime = (int)to_number(schd_tab[tripidx][26]);
+													int trav_time =   forwardslack.route.departure(k-1) +getTravTime_passedEta(s_tab[m][k-1],tripidx, to_string(est_time),"0");
+													int tripstarttime = (int)tripNumber(tripidx, 26);
 
 													if (trav_time < tripstarttime + aLatepickup + floor((RELAXCONSTRAINTS[0] - 1)*50) && tripstarttime > 0){
 
 														if(DEBUG == 1) gse << trav_time << " " << tripstarttime << " " << aLatepickup << endl;
 
 
-														if(trav_time < to_number(schd_tab[tripidx][26])  - aEarlypickup && to_number(schd_tab[tripidx][26])!= 0 ){
-															trav_time = to_number(schd_tab[tripidx][26]) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
+														if(trav_time < tripNumber(tripidx, 26)  - aEarlypickup && tripNumber(tripidx, 26)!= 0 ){
+															trav_time = tripNumber(tripidx, 26) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
 														}
-														else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlypickup && to_number(schd_tab[tripidx][26])== 0 ){
-															trav_time =  to_number(schd_tab[tripidx][4])  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
+														else if(trav_time < tripNumber(tripidx, 4) - aEarlypickup && tripNumber(tripidx, 26)== 0 ){
+															trav_time =  tripNumber(tripidx, 4)  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 														}
 														else{
 															trav_time =  trav_time + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 														}
 
-														if (to_number(schd_tab[tripidx][27]) > 0)
-														{if(DEBUG == 1) gse << "End time of trip " << to_number(schd_tab[tripidx][27])  << " trav time " << trav_time << endl;
-														if (trav_time > to_number(schd_tab[tripidx][27]) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
+														if (tripNumber(tripidx, 27) > 0)
+														{if(DEBUG == 1) gse << "End time of trip " << tripNumber(tripidx, 27)  << " trav time " << trav_time << endl;
+														if (trav_time > tripNumber(tripidx, 27) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
 														{
 															continue;
 														}
 
 														}
 
-														if(trav_time < to_number(schd_tab[tripidx][27])  - aEarlydropoff && to_number(schd_tab[tripidx][27])!= 0 ){
-															trav_time = to_number(schd_tab[tripidx][27]) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
+														if(trav_time < tripNumber(tripidx, 27)  - aEarlydropoff && tripNumber(tripidx, 27)!= 0 ){
+															trav_time = tripNumber(tripidx, 27) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
 														}
-														else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlydropoff  && to_number(schd_tab[tripidx][27])== 0 ){
-															trav_time =  to_number(schd_tab[tripidx][4])  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
+														else if(trav_time < tripNumber(tripidx, 4) - aEarlydropoff  && tripNumber(tripidx, 27)== 0 ){
+															trav_time =  tripNumber(tripidx, 4)  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
 														}
 
 
@@ -9246,23 +10530,23 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 														if(endofsegtime > 0  ){
 
-															if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50)){
+															if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50) && insertionDelayFits(forwardslack, k, trav_time)){
 
 																if(strcmp(schd_tab[s_tab[m][k]][7],"D")==0  /*&& strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*//*&& strcmp(schd_tab[pickupafterstop][7],"P")==0 && strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*/ && strcmp(schd_tab[s_tab[m][k]][3],schd_tab[s_tab[m][k]][0])!=0){
 
 
 
-																	int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																	int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																	int doeta1 = trav_time;
 																	int actualTT = doeta1 - puetd1;
-																	if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																	if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																	string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																	string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																	double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																	string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																	string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																	string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																	string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																	double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																	string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																	string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -9274,26 +10558,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	int groupcnter = 1;
 																	routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																	//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																	for (int i = 0; i < MAXSEGMENTS; i++)
-																	{
-																		if (s_tab[i][0] == routeint)
-																		{
-																			for (int g = 1; g < MAXSTOPS; g++)
-																			{
-																				if (s_tab[i][g] == s_tab[m][k-1])
-																				{
-
-																					while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																						groupcnter++;
-																						g--;
-																					}
-																					//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																					break;
-																				}
-																			}
-																			break;
-																		}
-																	}
+																	groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																	groupcnter = groupcnter + groupnumber;
 																	int aAllowedTT;
 																	if(estdisttrip < a_mediumshortdistance1)
@@ -9318,26 +10583,26 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																}
-																int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																int segstart = (int)tripNumber(s_tab[m][1], 4);
 																int segend;
 																for (int g = 1; g < MAXSTOPS; g++)
 																{
 																	if (s_tab[m][g] == 0)
 																	{
-																		segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																		segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																		break;
 
 																	}
 																}
 																int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																timethreshold = segend - timethreshold;
 																bool docalc = true;
 
 																if(DEBUG == 1) gse << "Going to see if we are in the ellipse: " << schd_tab[s_tab[m][k-1]][31] << " " << schd_tab[s_tab[m][k-1]][32] << " " << triptimethreshold << " " << timethreshold <<" " <<schd_tab[s_tab[m][k]][7] << " " << schd_tab[s_tab[m][k]][2] << endl;
 
-																if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																		|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																){
 
@@ -9355,12 +10620,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																	if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																		if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																		if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																			pudev = getCost(pickupafterstop,puid);
 																			dodev = getCost(doid,  dropoffafterstop);
 																		}
 																		else{
-																			pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																			pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																			dodev = pudev;
 
 																		}
@@ -9373,7 +10638,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																	docalc = false;
 
-																	if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																	if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																		double distpu =  getCost(tripidx, s_tab[m][k]);
 																		double distdo = getCost(tripidx+1, s_tab[m][k]);
 																		if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -9381,10 +10646,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		}
 																		double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																		if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																		if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																			if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																			distpu = 0;
-																			if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																			if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																				if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																				//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																					distdo = 0;
@@ -9395,7 +10660,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																				docalc = true;
 																			}
-																			else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																			else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																				if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																				docalc = true;
 																			}
@@ -9405,12 +10670,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																		if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																			if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																			if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																				pudev = getCost(pickupafterstop,puid);
 																				dodev = getCost(doid,  dropoffafterstop);
 																			}
 																			else{
-																				pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																				pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																				dodev = pudev;
 
 																			}
@@ -9420,7 +10685,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			dodev = 0;
 																		}
 
-																		if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																		if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																			if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																			docalc = true;
 
@@ -9448,7 +10713,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																	set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																	if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																	if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																	if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																		AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -9533,17 +10798,17 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																	if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																		if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
+																		if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
 																			//if(DEBUG == 1) gse << "Adding pickup " << aEarlypickup << endl;
-																			nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																			nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																		}
 																		else{
 																			nextstoptime = nextstoptime+p_perf_time2;
 																		}
 																	}
 																	else{
-																		if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																			nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																		if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																			nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																			//if(DEBUG == 1) gse << "Adding dropoff " << aEarlydropoff << endl;
 																		}
 																		else{
@@ -9553,14 +10818,14 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																	int p_eta;
-																	if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																	if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																		p_eta = previouseta;
 																	}
 																	else{
-																		p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																		p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																	}
 
-																	nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																	nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 																	//if(DEBUG == 1) gse << "NEXT STOP TIME  " <<  nextstoptime - (int)to_number(schd_tab[s_tab[m][w]][CALCULATEDTIME]) << " " << (int)to_number(schd_tab[s_tab[m][w]][CALCULATEDTIME]) <<  " " << nextstoptime << " " <<schd_tab[s_tab[m][w+1]][3] << " " <<   schd_tab[s_tab[m][w+1]][7] <<endl;
 
@@ -9606,10 +10871,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	}
 																	bool preassigntripchange = true;
 
-																	int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																	int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																	int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																	int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																	if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																		endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																		endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																	}
 																	string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -9620,7 +10885,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																			{
 																				int dev =  p_eta - (starttime1 + aLatepickup);
-																				if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																				if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																					preassigntripchange = true;
 																				}
 
@@ -9633,7 +10898,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																			{
 																				int dev =  p_eta - (endtime1);
-																				if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																				if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																					preassigntripchange = true;
 																				}
 																			}
@@ -9653,7 +10918,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																			if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																			if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																				isLate = true;
 																				break;
 																			}
@@ -9664,12 +10929,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		}
 																		else{
 
-																			if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																			if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																				isLate = true;
 																				break;
 																			}
 																			else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																				if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																				if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																					isLate = true;
 																					break;
 																				}
@@ -9707,10 +10972,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -9729,17 +10994,17 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 
-																int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																int doeta1 = trav_time;
 																int actualTT = doeta1 - puetd1;
-																if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -9751,26 +11016,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																int groupcnter = 1;
 																routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																for (int i = 0; i < MAXSEGMENTS; i++)
-																{
-																	if (s_tab[i][0] == routeint)
-																	{
-																		for (int g = 1; g < MAXSTOPS; g++)
-																		{
-																			if (s_tab[i][g] == s_tab[m][k-1])
-																			{
-
-																				while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																					groupcnter++;
-																					g--;
-																				}
-																				//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																				break;
-																			}
-																		}
-																		break;
-																	}
-																}
+																groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																groupcnter = groupcnter + groupnumber;
 																int aAllowedTT;
 																if(estdisttrip < a_mediumshortdistance1)
@@ -9795,24 +11041,24 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 															}
-															int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+															int segstart = (int)tripNumber(s_tab[m][1], 4);
 															int segend;
 															for (int g = 1; g < MAXSTOPS; g++)
 															{
 																if (s_tab[m][g] == 0)
 																{
-																	segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																	segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																	break;
 
 																}
 															}
 															int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-															int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+															int triptimethreshold = ((int)tripNumber(tripidx, 4));
 															timethreshold = segend - timethreshold;
 															bool docalc = true;
 
-															if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+															if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																	|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 															){
 
@@ -9830,12 +11076,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																	if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																	if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																		pudev = getCost(pickupafterstop,puid);
 																		dodev = getCost(doid,  dropoffafterstop);
 																	}
 																	else{
-																		pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																		pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																		dodev = pudev;
 
 																	}
@@ -9848,7 +11094,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																docalc = false;
 
-																if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																	double distpu =  getCost(tripidx, s_tab[m][k]);
 																	double distdo = getCost(tripidx+1, s_tab[m][k]);
 																	if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -9856,10 +11102,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	}
 																	double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																	if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																	if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																		if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																		distpu = 0;
-																		if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																		if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																			if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																			//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																				distdo = 0;
@@ -9870,7 +11116,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																			docalc = true;
 																		}
-																		else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																		else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																			if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																			docalc = true;
 																		}
@@ -9880,12 +11126,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																	if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																		if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																		if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																			pudev = getCost(pickupafterstop,puid);
 																			dodev = getCost(doid,  dropoffafterstop);
 																		}
 																		else{
-																			pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																			pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																			dodev = pudev;
 
 																		}
@@ -9895,7 +11141,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		dodev = 0;
 																	}
 
-																	if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																	if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																		if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																		docalc = true;
 
@@ -9923,7 +11169,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																	AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -10005,16 +11251,16 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																	if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																		nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																	if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																		nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																	}
 																	else{
 																		nextstoptime = nextstoptime+p_perf_time2;
 																	}
 																}
 																else{
-																	if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																		nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																	if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																		nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																	}
 																	else{
 																		nextstoptime = nextstoptime+p_perf_time2;
@@ -10022,14 +11268,14 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																}
 
 																int p_eta;
-																if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																	p_eta = previouseta;
 																}
 																else{
-																	p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																	p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																}
 
-																nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																if (pDisability3.find("LP",0) != string::npos){
@@ -10073,10 +11319,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																}
 																bool preassigntripchange = true;
 
-																int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																	endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																	endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																}
 																string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -10087,7 +11333,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																		{
 																			int dev =  p_eta - (starttime1 + aLatepickup);
-																			if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																			if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																				preassigntripchange = true;
 																			}
 
@@ -10100,7 +11346,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																		{
 																			int dev =  p_eta - (endtime1);
-																			if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																			if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																				preassigntripchange = true;
 																			}
 																		}
@@ -10113,7 +11359,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																		if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																		if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																			isLate = true;
 																			break;
 																		}
@@ -10124,12 +11370,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	}
 																	else{
 
-																		if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																		if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																			isLate = true;
 																			break;
 																		}
 																		else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																			if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																			if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																				isLate = true;
 																				break;}
 																		}
@@ -10168,10 +11414,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -10185,30 +11431,30 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 													}
 													else if(tripstarttime == 0) {
 														if(DEBUG == 1) gse << "no start time " << endl;
-														if(trav_time < to_number(schd_tab[tripidx][26])  - aEarlypickup && to_number(schd_tab[tripidx][26])!= 0 ){
-															trav_time = to_number(schd_tab[tripidx][26]) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
+														if(trav_time < tripNumber(tripidx, 26)  - aEarlypickup && tripNumber(tripidx, 26)!= 0 ){
+															trav_time = tripNumber(tripidx, 26) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
 														}
-														else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlypickup && to_number(schd_tab[tripidx][26])== 0 ){
-															trav_time =  to_number(schd_tab[tripidx][4])  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
+														else if(trav_time < tripNumber(tripidx, 4) - aEarlypickup && tripNumber(tripidx, 26)== 0 ){
+															trav_time =  tripNumber(tripidx, 4)  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 														}
 														else{
 															trav_time =  trav_time + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 														}
 
-														if (to_number(schd_tab[tripidx][27]) > 0)
-														{if(DEBUG == 1) gse << "End time of trip " << to_number(schd_tab[tripidx][27])  << " trav time " << trav_time << endl;
-														if (trav_time > to_number(schd_tab[tripidx][27]) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
+														if (tripNumber(tripidx, 27) > 0)
+														{if(DEBUG == 1) gse << "End time of trip " << tripNumber(tripidx, 27)  << " trav time " << trav_time << endl;
+														if (trav_time > tripNumber(tripidx, 27) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
 														{
 															continue;
 														}
 
 														}
 
-														if(trav_time < to_number(schd_tab[tripidx][27])  - aEarlydropoff && to_number(schd_tab[tripidx][27])!= 0 ){
-															trav_time = to_number(schd_tab[tripidx][27]) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
+														if(trav_time < tripNumber(tripidx, 27)  - aEarlydropoff && tripNumber(tripidx, 27)!= 0 ){
+															trav_time = tripNumber(tripidx, 27) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
 														}
-														else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlydropoff  && to_number(schd_tab[tripidx][27])== 0 ){
-															trav_time =  to_number(schd_tab[tripidx][4])  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
+														else if(trav_time < tripNumber(tripidx, 4) - aEarlydropoff  && tripNumber(tripidx, 27)== 0 ){
+															trav_time =  tripNumber(tripidx, 4)  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
 														}
 
 
@@ -10221,23 +11467,23 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 														if(endofsegtime > 0  ){
 
-															if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50)){
+															if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50) && insertionDelayFits(forwardslack, k, trav_time)){
 
 																if(strcmp(schd_tab[s_tab[m][k]][7],"D")==0  /*&& strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*//*&& strcmp(schd_tab[pickupafterstop][7],"P")==0 && strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*/ && strcmp(schd_tab[s_tab[m][k]][3],schd_tab[s_tab[m][k]][0])!=0){
 
 
 
-																	int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																	int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																	int doeta1 = trav_time;
 																	int actualTT = doeta1 - puetd1;
-																	if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																	if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																	string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																	string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																	double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																	string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																	string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																	string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																	string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																	double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																	string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																	string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -10249,26 +11495,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	int groupcnter = 1;
 																	routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																	//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																	for (int i = 0; i < MAXSEGMENTS; i++)
-																	{
-																		if (s_tab[i][0] == routeint)
-																		{
-																			for (int g = 1; g < MAXSTOPS; g++)
-																			{
-																				if (s_tab[i][g] == s_tab[m][k-1])
-																				{
-
-																					while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																						groupcnter++;
-																						g--;
-																					}
-																					//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																					break;
-																				}
-																			}
-																			break;
-																		}
-																	}
+																	groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																	groupcnter = groupcnter + groupnumber;
 																	int aAllowedTT;
 																	if(estdisttrip < a_mediumshortdistance1)
@@ -10293,26 +11520,26 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																}
-																int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																int segstart = (int)tripNumber(s_tab[m][1], 4);
 																int segend;
 																for (int g = 1; g < MAXSTOPS; g++)
 																{
 																	if (s_tab[m][g] == 0)
 																	{
-																		segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																		segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																		break;
 
 																	}
 																}
 																int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																timethreshold = segend - timethreshold;
 																bool docalc = true;
 
 
 
-																if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																		|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																){
 
@@ -10330,12 +11557,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																	if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																		if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																		if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																			pudev = getCost(pickupafterstop,puid);
 																			dodev = getCost(doid,  dropoffafterstop);
 																		}
 																		else{
-																			pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																			pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																			dodev = pudev;
 
 																		}
@@ -10348,7 +11575,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																	docalc = false;
 
-																	if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																	if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																		double distpu =  getCost(tripidx, s_tab[m][k]);
 																		double distdo = getCost(tripidx+1, s_tab[m][k]);
 																		if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -10356,10 +11583,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		}
 																		double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																		if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																		if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																			if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																			distpu = 0;
-																			if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																			if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																				if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																				//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																					distdo = 0;
@@ -10370,7 +11597,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																				if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																				docalc = true;
 																			}
-																			else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																			else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																				if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																				docalc = true;
 																			}
@@ -10380,12 +11607,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																		if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																			if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																			if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																				pudev = getCost(pickupafterstop,puid);
 																				dodev = getCost(doid,  dropoffafterstop);
 																			}
 																			else{
-																				pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																				pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																				dodev = pudev;
 
 																			}
@@ -10395,7 +11622,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			dodev = 0;
 																		}
 
-																		if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																		if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																			if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																			docalc = true;
 
@@ -10423,7 +11650,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																	set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																	if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																	if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																	if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																		AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -10505,16 +11732,16 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																	if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																		if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																			nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																		if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																			nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																		}
 																		else{
 																			nextstoptime = nextstoptime+p_perf_time2;
 																		}
 																	}
 																	else{
-																		if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																			nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																		if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																			nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																		}
 																		else{
 																			nextstoptime = nextstoptime+p_perf_time2;
@@ -10523,14 +11750,14 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																	int p_eta;
-																	if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																	if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																		p_eta = previouseta;
 																	}
 																	else{
-																		p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																		p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																	}
 
-																	nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																	nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 
@@ -10575,10 +11802,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	}
 																	bool preassigntripchange = true;
 
-																	int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																	int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																	int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																	int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																	if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																		endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																		endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																	}
 																	string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -10589,7 +11816,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																			{
 																				int dev =  p_eta - (starttime1 + aLatepickup);
-																				if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																				if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																					preassigntripchange = true;
 																				}
 
@@ -10602,7 +11829,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																			{
 																				int dev =  p_eta - (endtime1);
-																				if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																				if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																					preassigntripchange = true;
 																				}
 																			}
@@ -10614,7 +11841,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																			if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																			if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																				isLate = true;
 																				break;
 																			}
@@ -10625,12 +11852,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		}
 																		else{
 
-																			if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																			if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																				isLate = true;
 																				break;
 																			}
 																			else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																				if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																				if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																					isLate = true;
 																					break;}
 																			}
@@ -10671,10 +11898,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -10693,17 +11920,17 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 
-																int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																int doeta1 = trav_time;
 																int actualTT = doeta1 - puetd1;
-																if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -10715,26 +11942,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																int groupcnter = 1;
 																routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																for (int i = 0; i < MAXSEGMENTS; i++)
-																{
-																	if (s_tab[i][0] == routeint)
-																	{
-																		for (int g = 1; g < MAXSTOPS; g++)
-																		{
-																			if (s_tab[i][g] == s_tab[m][k-1])
-																			{
-
-																				while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																					groupcnter++;
-																					g--;
-																				}
-																				//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																				break;
-																			}
-																		}
-																		break;
-																	}
-																}
+																groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																groupcnter = groupcnter + groupnumber;
 																int aAllowedTT;
 																if(estdisttrip < a_mediumshortdistance1)
@@ -10759,24 +11967,24 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 															}
-															int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+															int segstart = (int)tripNumber(s_tab[m][1], 4);
 															int segend;
 															for (int g = 1; g < MAXSTOPS; g++)
 															{
 																if (s_tab[m][g] == 0)
 																{
-																	segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																	segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																	break;
 
 																}
 															}
 															int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-															int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+															int triptimethreshold = ((int)tripNumber(tripidx, 4));
 															timethreshold = segend - timethreshold;
 															bool docalc = true;
 
-															if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+															if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																	|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 															){
 
@@ -10794,12 +12002,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																	if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																	if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																		pudev = getCost(pickupafterstop,puid);
 																		dodev = getCost(doid,  dropoffafterstop);
 																	}
 																	else{
-																		pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																		pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																		dodev = pudev;
 
 																	}
@@ -10812,7 +12020,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 																docalc = false;
 
-																if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																	double distpu =  getCost(tripidx, s_tab[m][k]);
 																	double distdo = getCost(tripidx+1, s_tab[m][k]);
 																	if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -10820,10 +12028,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	}
 																	double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																	if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																	if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																		if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																		distpu = 0;
-																		if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																		if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																			if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																			//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																				distdo = 0;
@@ -10834,7 +12042,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																			if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																			docalc = true;
 																		}
-																		else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																		else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																			if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																			docalc = true;
 																		}
@@ -10844,12 +12052,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																	if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																		if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																		if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																			pudev = getCost(pickupafterstop,puid);
 																			dodev = getCost(doid,  dropoffafterstop);
 																		}
 																		else{
-																			pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																			pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																			dodev = pudev;
 
 																		}
@@ -10859,7 +12067,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		dodev = 0;
 																	}
 
-																	if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																	if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																		if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																		docalc = true;
 
@@ -10888,7 +12096,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																	AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -10970,16 +12178,16 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																	if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																		nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																	if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																		nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																	}
 																	else{
 																		nextstoptime = nextstoptime+p_perf_time2;
 																	}
 																}
 																else{
-																	if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																		nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																	if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																		nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																	}
 																	else{
 																		nextstoptime = nextstoptime+p_perf_time2;
@@ -10988,14 +12196,14 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 
 
 																int p_eta;
-																if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																	p_eta = previouseta;
 																}
 																else{
-																	p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																	p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																}
 
-																nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																if (pDisability3.find("LP",0) != string::npos){
@@ -11039,10 +12247,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																}
 																bool preassigntripchange = true;
 
-																int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																	endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																	endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																}
 																string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -11053,7 +12261,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																		{
 																			int dev =  p_eta - (starttime1 + aLatepickup);
-																			if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																			if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																				preassigntripchange = true;
 																			}
 
@@ -11066,7 +12274,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																		if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																		{
 																			int dev =  p_eta - (endtime1);
-																			if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																			if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																				preassigntripchange = true;
 																			}
 																		}
@@ -11078,7 +12286,7 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																		if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																		if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																			isLate = true;
 																			break;
 																		}
@@ -11089,12 +12297,12 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
 																	}
 																	else{
 
-																		if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																		if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																			isLate = true;
 																			break;
 																		}
 																		else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																			if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																			if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																				isLate = true;
 																				break;}
 																		}
@@ -11133,10 +12341,10 @@ bool searchtimeslotclustermatch(string route, string wc,string inslack,double ou
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -11197,201 +12405,103 @@ void swapstring(string *xp, string *yp)
 	*yp = temp;
 }
 
-// A function to implement bubble sort
+//The bubbleSort_* routines reorder parallel candidate arrays by one of them. They keep their
+//exchange sort semantics (stable, same ranges) but order through util::sortParallel().
 void bubbleSort(int arr[], int n)
 {
-	int i, j;
-	for (i = 0; i < n-1; i++)
-
-		// Last i elements are already in place
-		for (j = 0; j < n-i-1; j++)
-			if (arr[j] > arr[j+1])
-				swapint(&arr[j], &arr[j+1]);
+	if(n > 1)
+		osrm::util::sortParallel(0, n, osrm::util::ascending(arr), arr);
 }
 
 void bubbleSort_twoarray(double dist[],int tripidxes[], int groupcnt)
 {
-	int i, j;
-	for (i = 0; i < groupcnt-1; i++)
-		// Last i elements are already in place
-		for (j = 0; j < groupcnt-i-1; j++)
-			if (dist[j] > dist[j+1]){
-				swapdouble(&dist[j], &dist[j+1]);
-				swapint(&tripidxes[j], &tripidxes[j+1]);
-
-			}
+	if(groupcnt > 1)
+		osrm::util::sortParallel(0, groupcnt, osrm::util::ascending(dist), dist, tripidxes);
 }
 void bubbleSort_twoarray_str(double dev[],string json[], int groupcnt)
 {
-	int i, j;
-	for (i = 0; i < groupcnt-1; i++)
-		// Last i elements are already in place
-		for (j = 0; j < groupcnt-i-1; j++)
-			if (dev[j] > dev[j+1]){
-				swapdouble(&dev[j], &dev[j+1]);
-				swapstring(&json[j], &json[j+1]);
-
-			}
+	if(groupcnt > 1)
+		osrm::util::sortParallel(0, groupcnt, osrm::util::ascending(dev), dev, json);
 }
 
 
 void bubbleSort_threearray(double time1[], double dev[],string json[], int groupcnt)
 {
-	int i, j;
-	for (i = 0; i < groupcnt-1; i++)
-		// Last i elements are already in place
-		for (j = 0; j < groupcnt-i-1; j++)
-			if (dev[j] > dev[j+1]){
-				swapdouble(&dev[j], &dev[j+1]);
-				swapstring(&json[j], &json[j+1]);
-				swapdouble(&time1[j], &time1[j+1]);
-
-			}
+	if(groupcnt > 1)
+		osrm::util::sortParallel(0, groupcnt, osrm::util::ascending(dev), dev, json, time1);
 }
 void bubbleSort_threearray_int(double time1[], double dev[],int json[], int groupcnt)
 {
-	int i, j;
-	for (i = 0; i < groupcnt-1; i++)
-		// Last i elements are already in place
-		for (j = 0; j < groupcnt-i-1; j++)
-			if (dev[j] > dev[j+1]){
-				swapdouble(&dev[j], &dev[j+1]);
-				swapint(&json[j], &json[j+1]);
-				swapdouble(&time1[j], &time1[j+1]);
-
-			}
+	if(groupcnt > 1)
+		osrm::util::sortParallel(0, groupcnt, osrm::util::ascending(dev), dev, json, time1);
 }
 
 void bubbleSort_threearray_twoint(int time1[], double dev[],int json[], int groupcnt)
 {
-	int i, j;
-	for (i = 0; i < groupcnt-1; i++)
-		// Last i elements are already in place
-		for (j = 0; j < groupcnt-i-1; j++)
-			if (dev[j] > dev[j+1]){
-				swapdouble(&dev[j], &dev[j+1]);
-				swapint(&json[j], &json[j+1]);
-				swapint(&time1[j], &time1[j+1]);
-
-			}
+	if(groupcnt > 1)
+		osrm::util::sortParallel(0, groupcnt, osrm::util::ascending(dev), dev, json, time1);
 }
 
 
 
 
+//descending, the last entry is left where it is
 void bubbleSort_threearray_desc(double time1[], double dev[],string json[], int groupcnt)
 {
-	int i, j;
-	for (i = groupcnt-1; i > 0; i--)
-		// Last i elements are already in place
-		for (j = groupcnt-i-1; j > 0; j--)
-			if (dev[j] > dev[j-1]){
-				swapdouble(&dev[j], &dev[j-1]);
-				swapstring(&json[j], &json[j-1]);
-				swapdouble(&time1[j], &time1[j-1]);
-
-			}
+	if(groupcnt > 2)
+		osrm::util::sortParallel(0, groupcnt - 1, osrm::util::descending(dev), dev, json, time1);
 }
 
 
+//1-based: sorts entries 1 to groupcnt
 void bubbleSort_threearrayint_slackonly(double dev[], double time1[],int json[], int groupcnt)
 {
-	int i, j;
-	for (i = 1; i <= groupcnt; i++)
-		// Last i elements are already in place
-		for (j = 1; j <= groupcnt-i; j++)
-			if (dev[j] > dev[j+1]){
-				swapdouble(&dev[j], &dev[j+1]);
-				swapint(&json[j], &json[j+1]);
-				swapdouble(&time1[j], &time1[j+1]);
-
-			}
+	if(groupcnt > 1)
+		osrm::util::sortParallel(1, groupcnt + 1, osrm::util::ascending(dev), dev, json, time1);
 }
 
 void bubbleSort_threearray_start_end(double leastdevstraightline[],double promtime[],int tripidxes[], int start,int end){
 
 	if(DEBUG == 1) gse << "In sort by least dev " << endl;
-	int i, j;
-	for (i = start; i <= end; i++)
-		// Last i elements are already in place
-		for (j = start; j <= end-1; j++)
-			if (leastdevstraightline[j] > leastdevstraightline[j+1]){
-				swapint(&tripidxes[j], &tripidxes[j+1]);
-				swapdouble(&promtime[j], &promtime[j+1]);
-				swapdouble(&leastdevstraightline[j], &leastdevstraightline[j+1]);
-			}
+	if(end > start)
+		osrm::util::sortParallel(start, end + 1, osrm::util::ascending(leastdevstraightline), tripidxes, promtime, leastdevstraightline);
 }
 
 
 void bubbleSort_threearray_start_end_string(double leastdevstraightline[],double promtime[],string tripidxes[], int start,int end){
-	int i, j;
-	for (i = start; i <= end; i++)
-		// Last i elements are already in place
-		for (j = start; j <= end-1; j++)
-			if (leastdevstraightline[j] < leastdevstraightline[j+1]){
-				swapstring(&tripidxes[j], &tripidxes[j+1]);
-				swapdouble(&promtime[j], &promtime[j+1]);
-				swapdouble(&leastdevstraightline[j], &leastdevstraightline[j+1]);
-			}
+	if(end > start)
+		osrm::util::sortParallel(start, end + 1, osrm::util::descending(leastdevstraightline), tripidxes, promtime, leastdevstraightline);
 }
 
+//orders by time within each run of equal deviations, the runs stay where they are
 void bubbleSort_threearray_sortbytime(double time1[], double dev[],string json[], int groupcnt)
 {
-	int i, j;
-	for (i = 0; i < groupcnt-1; i++)
-		// Last i elements are already in place
-		for (j = 0; j < groupcnt-i-1; j++)
-			if (time1[j] > time1[j+1] && dev[j] == dev[j+1]){
-				swapdouble(&dev[j], &dev[j+1]);
-				swapstring(&json[j], &json[j+1]);
-				swapdouble(&time1[j], &time1[j+1]);
-
-			}
+	for(int runstart = 0; runstart < groupcnt; ){
+		int runend = runstart + 1;
+		while(runend < groupcnt && dev[runend] == dev[runstart])
+			runend++;
+		osrm::util::sortParallel(runstart, runend, osrm::util::ascending(time1), dev, json, time1);
+		runstart = runend;
+	}
 }
 
 
 
 void bubbleSort_findbest(double leastdevstraightline[],int returnedroutespu[], int returnedroutesdo[], int cnt){
 
-	int i, j;
-	for (i = 0; i < cnt-1; i++)
-
-		// Last i elements are already in place
-		for (j = 0; j < cnt-i-1; j++)
-			if (leastdevstraightline[j] > leastdevstraightline[j+1]){
-				swapdouble(&leastdevstraightline[j], &leastdevstraightline[j+1]);
-				swapint(&returnedroutespu[j], &returnedroutespu[j+1]);
-				swapint(&returnedroutesdo[j], &returnedroutesdo[j+1]);
-			}
+	if(cnt > 1)
+		osrm::util::sortParallel(0, cnt, osrm::util::ascending(leastdevstraightline), leastdevstraightline, returnedroutespu, returnedroutesdo);
 }
 void bubbleSort_findbestdoublearry(int binarynotransferarray[],double promtime[],double leastdevstraightline[],int returnedroutespu[], int returnedroutesdo[], int cnt){
 
-	int i, j;
-	for (i = 0; i < cnt-1; i++)
-
-		// Last i elements are already in place
-		for (j = 0; j < cnt-i-1; j++)
-			if (binarynotransferarray[j] > binarynotransferarray[j+1]){
-				swapint(&binarynotransferarray[j], &binarynotransferarray[j+1]);
-				swapdouble(&promtime[j], &promtime[j+1]);
-				swapint(&returnedroutespu[j], &returnedroutespu[j+1]);
-				swapint(&returnedroutesdo[j], &returnedroutesdo[j+1]);
-				swapdouble(&leastdevstraightline[j], &leastdevstraightline[j+1]);
-			}
+	if(cnt > 1)
+		osrm::util::sortParallel(0, cnt, osrm::util::ascending(binarynotransferarray), binarynotransferarray, promtime, returnedroutespu, returnedroutesdo, leastdevstraightline);
 }
+//the _start_end and up/down variants sort [start, end)
 void bubbleSort_findbestdoublearry_start_end(double leastdevstraightline[],double promtime[],int binarynotransferarray[],int returnedroutespu[], int returnedroutesdo[], int start,int end){
 
-	int i, j;
-	for (i = start; i < end-1; i++)
-		// Last i elements are already in place
-		for (j = start; j < end-1; j++)
-			if (leastdevstraightline[j] > leastdevstraightline[j+1]){
-				swapint(&binarynotransferarray[j], &binarynotransferarray[j+1]);
-				swapdouble(&promtime[j], &promtime[j+1]);
-				swapint(&returnedroutespu[j], &returnedroutespu[j+1]);
-				swapint(&returnedroutesdo[j], &returnedroutesdo[j+1]);
-				swapdouble(&leastdevstraightline[j], &leastdevstraightline[j+1]);
-			}
+	if(end > start)
+		osrm::util::sortParallel(start, end, osrm::util::ascending(leastdevstraightline), binarynotransferarray, promtime, returnedroutespu, returnedroutesdo, leastdevstraightline);
 }
 
 
@@ -11400,48 +12510,18 @@ void bubbleSort_findbestdoublearry_start_end(double leastdevstraightline[],doubl
 
 void bubbleSort_findbestdoublearry2(double promtime[],double leastdevstraightline[],int returnedroutespu[], int returnedroutesdo[], int start, int end){
 
-	int i, j;
-	for (i = start; i < end-1; i++)
-
-		// Last i elements are already in place
-		for (j = start; j < end-1; j++)
-			if (promtime[j] > promtime[j+1]){
-				swapdouble(&promtime[j], &promtime[j+1]);
-				swapdouble(&leastdevstraightline[j], &leastdevstraightline[j+1]);
-				swapint(&returnedroutespu[j], &returnedroutespu[j+1]);
-				swapint(&returnedroutesdo[j], &returnedroutesdo[j+1]);
-			}
+	if(end > start)
+		osrm::util::sortParallel(start, end, osrm::util::ascending(promtime), promtime, leastdevstraightline, returnedroutespu, returnedroutesdo);
 }
 void bubbleSort_findbestdoublearryup(double promtime[],double leastdevstraightline[],int binarynotransferarray[],int returnedroutespu[], int returnedroutesdo[], int start, int end){
 
-	int i, j;
-	for (i = start; i < end-1; i++)
-
-		// Last i elements are already in place
-		for (j = start; j < end-1; j++)
-			if (promtime[j] > promtime[j+1]){
-				swapdouble(&promtime[j], &promtime[j+1]);
-				swapdouble(&leastdevstraightline[j], &leastdevstraightline[j+1]);
-				swapint(&returnedroutespu[j], &returnedroutespu[j+1]);
-				swapint(&returnedroutesdo[j], &returnedroutesdo[j+1]);
-				swapint(&binarynotransferarray[j], &binarynotransferarray[j+1]);
-			}
+	if(end > start)
+		osrm::util::sortParallel(start, end, osrm::util::ascending(promtime), promtime, leastdevstraightline, returnedroutespu, returnedroutesdo, binarynotransferarray);
 }
 void bubbleSort_findbestdoublearrydown(double promtime[],double leastdevstraightline[],int binarynotransferarray[],int returnedroutespu[], int returnedroutesdo[], int start, int end){
 
-
-	int i, j;
-	for (i = start; i < end-1; i++)
-
-		// Last i elements are already in place
-		for (j = start; j < end-1; j++)
-			if (promtime[j] < promtime[j+1]){
-				swapdouble(&promtime[j], &promtime[j+1]);
-				swapdouble(&leastdevstraightline[j], &leastdevstraightline[j+1]);
-				swapint(&returnedroutespu[j], &returnedroutespu[j+1]);
-				swapint(&returnedroutesdo[j], &returnedroutesdo[j+1]);
-				swapint(&binarynotransferarray[j], &binarynotransferarray[j+1]);
-			}
+	if(end > start)
+		osrm::util::sortParallel(start, end, osrm::util::descending(promtime), promtime, leastdevstraightline, returnedroutespu, returnedroutesdo, binarynotransferarray);
 }
 
 
@@ -11492,6 +12572,8 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 	for(int m = 0; m < MAXSEGMENTS; m++){
 		if(s_tab[m][0] == routeint){ // find the route
+			ForwardSlack forwardslack;
+			buildForwardSlack(m, forwardslack);
 			for(int k = 1; k < MAXSTOPS; k++){ // for every stop on route
 				if(s_tab[m][k]==0)
 					break;
@@ -11587,38 +12669,38 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 					if(strcmp(schd_tab[s_tab[m][k-1]][7],"P")==0){
-						t1 = (int)ceil((to_number(schd_tab[s_tab[m][k-1]][4]) - aEarlypickup) ); // eta
+						t1 = (int)ceil((tripNumber(s_tab[m][k-1], 4) - aEarlypickup) ); // eta
 					}
 					else{
-						t1 = (int)ceil((to_number(schd_tab[s_tab[m][k-1]][4]) - aEarlydropoff) ); // eta
+						t1 = (int)ceil((tripNumber(s_tab[m][k-1], 4) - aEarlydropoff) ); // eta
 					}
 
-					if((int)ceil(to_number(schd_tab[s_tab[m][k-1]][30])) > t1){
-						t1 = (int)ceil(to_number(schd_tab[s_tab[m][k-1]][30]));
+					if((int)ceil(tripNumber(s_tab[m][k-1], 30)) > t1){
+						t1 = (int)ceil(tripNumber(s_tab[m][k-1], 30));
 
 					}
 
 
 					int t2;
 					if(strcmp(schd_tab[s_tab[m][k]][7],"P")==0){
-						if((int)to_number(schd_tab[s_tab[m][k]][26]) > 0){
-							t2 =  (int)ceil(to_number(schd_tab[s_tab[m][k]][26]));
+						if((int)tripNumber(s_tab[m][k], 26) > 0){
+							t2 =  (int)ceil(tripNumber(s_tab[m][k], 26));
 						}
 						else{
-							t2 =  (int)ceil(to_number(schd_tab[s_tab[m][k]][30]));
+							t2 =  (int)ceil(tripNumber(s_tab[m][k], 30));
 						}
 					}
 					else{
-						if((int)to_number(schd_tab[s_tab[m][k]][27]) > 0){
-							t2 =  (int)ceil(to_number(schd_tab[s_tab[m][k]][27]));
+						if((int)tripNumber(s_tab[m][k], 27) > 0){
+							t2 =  (int)ceil(tripNumber(s_tab[m][k], 27));
 						}
 						else{
-							t2 =  (int)ceil(to_number(schd_tab[s_tab[m][k]][30]));
+							t2 =  (int)ceil(tripNumber(s_tab[m][k], 30));
 						}
 					}
 
-					if((int)ceil(to_number(schd_tab[s_tab[m][k]][4])) > t2){
-						t2 =  (int)ceil(to_number(schd_tab[s_tab[m][k]][4]));
+					if((int)ceil(tripNumber(s_tab[m][k], 4)) > t2){
+						t2 =  (int)ceil(tripNumber(s_tab[m][k], 4));
 					}
 
 					//int t2 =  (int)ceil(to_number(schd_tab[s_tab[m][k]][4])/15); // promise time
@@ -11626,22 +12708,17 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 					int segmentstart = s_tab[m][1];
 					int segmentend;
 
-					for(int z = 1; z < MAXSTOPS; z++){
-						if(s_tab[m][z] == 0){
-							segmentend = s_tab[m][z-1];
-							break;
-						}
-					}
+					segmentend = s_tab[m][segmentStopCount(m)];
 
 					//  if(DEBUG == 1) gse << "new verison" << endl;
 
 
-					if(t1 > (int)to_number(schd_tab[segmentend][4]))
-						t1 = (int)to_number(schd_tab[segmentend][4]);
+					if(t1 > (int)tripNumber(segmentend, 4))
+						t1 = (int)tripNumber(segmentend, 4);
 
 
-					if(t2 > (int)to_number(schd_tab[segmentend][4]))
-						t2 = (int)to_number(schd_tab[segmentend][4]);
+					if(t2 > (int)tripNumber(segmentend, 4))
+						t2 = (int)tripNumber(segmentend, 4);
 
 					//int etd = (int)to_number(schd_tab[s_tab[m][k-1]][30]);
 					// int prom = (int)to_number(schd_tab[s_tab[m][k]][4]);
@@ -11649,26 +12726,26 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 					int endofsegtime = 0;
 					if(DEBUG == 1) gse << "New stop " << k << endl;
 					if(strcmp(schd_tab[s_tab[m][k]][2], MAXSTOPNUM[0])==0){
-						endofsegtime = (int)to_number(schd_tab[s_tab[m][k]][4]);
+						endofsegtime = (int)tripNumber(s_tab[m][k], 4);
 					}
 					if(strcmp(schd_tab[s_tab[m][k]][2], MAXSTOPNUM[0])==0){
-						endofsegtime = (int)to_number(schd_tab[s_tab[m][k]][4]);
+						endofsegtime = (int)tripNumber(s_tab[m][k], 4);
 					}
 					else{
 						if(strcmp(schd_tab[s_tab[m][k]][7], "P")==0){
-							if((int)to_number(schd_tab[s_tab[m][k]][26])>0)
-								endofsegtime = (int)to_number(schd_tab[s_tab[m][k]][26]) + aLatepickup ;
+							if((int)tripNumber(s_tab[m][k], 26)>0)
+								endofsegtime = (int)tripNumber(s_tab[m][k], 26) + aLatepickup ;
 							else
-								endofsegtime = (int)to_number(schd_tab[s_tab[m][k]][4])  + aLatepickup ;
+								endofsegtime = (int)tripNumber(s_tab[m][k], 4)  + aLatepickup ;
 
 							if(DEBUG == 1) gse << "The trip before is " << schd_tab[s_tab[m][k-1]][3]  << " " << schd_tab[s_tab[m][k-1]][7] << " With time " << schd_tab[s_tab[m][k-1]][4] << endl;
 							if(DEBUG == 1) gse << "The trip after is " << schd_tab[s_tab[m][k]][3] << " " << schd_tab[s_tab[m][k]][7] <<  " With time " << endofsegtime - aLatepickup << " " << aLatepickup << endl;
 						}
 						else{
-							if((int)to_number(schd_tab[s_tab[m][k]][27])>0)
-								endofsegtime = (int)to_number(schd_tab[s_tab[m][k]][27]);
+							if((int)tripNumber(s_tab[m][k], 27)>0)
+								endofsegtime = (int)tripNumber(s_tab[m][k], 27);
 							else
-								endofsegtime = (int)to_number(schd_tab[s_tab[m][k]][4]);
+								endofsegtime = (int)tripNumber(s_tab[m][k], 4);
 
 							if(DEBUG == 1) gse << "The trip before is " << schd_tab[s_tab[m][k-1]][3]  << " " << schd_tab[s_tab[m][k-1]][7] << " With time " << schd_tab[s_tab[m][k-1]][4] << endl;
 							if(DEBUG == 1) gse << "The trip after is " << schd_tab[s_tab[m][k]][3]  << " " << schd_tab[s_tab[m][k]][7] << " With time " << endofsegtime << endl;
@@ -11682,8 +12759,8 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 
-					int wc_cap = (int)to_number(schd_tab[s_tab[m][1]][34]);
-					int amb_cap = (int)to_number(schd_tab[s_tab[m][1]][33]);
+					int wc_cap = (int)tripNumber(s_tab[m][1], 34);
+					int amb_cap = (int)tripNumber(s_tab[m][1], 33);
 					int cs_cap;
 					int cy_cap;
 
@@ -11706,10 +12783,43 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 
-						for (int i = 1; i < MAXTRIPIDX;i++){
+						//Rows up to the first without coordinates, nearest to the stop before first. A candidate's
+						//deviation is its getCost() from that stop plus the one on, so once that first leg alone
+						//exceeds the least deviation found, the row cannot be the answer and is not searched.
+						int rows = 1;
+						while(rows < MAXTRIPIDX && strcmp(schd_tab[rows][10],"")!=0)
+							rows++;
+						double prevlat, prevlon;
+						stopCoords(s_tab[m][k-1], prevlat, prevlon);
+						vector<int> candidates;
+						nearestFirstOrder(prevlat, prevlon, rows, STOPSEARCHNEAREST, candidates);
 
-							if(strcmp(schd_tab[i][10],"")==0)
-								break;
+						//the legs of the nearest unassigned pickups the loop below will try, one per core, are
+						//routed together before it asks for them one at a time
+						vector<std::pair<int, int>> legs;
+						const int prefetchrows = tbb::this_task_arena::max_concurrency();
+						for (size_t c = 0; c < candidates.size() && (int)legs.size() < 3 * prefetchrows; c++){
+							const int i = candidates[c];
+							string trip = schd_tab[i][3];
+							string p_disability = schd_tab[i][12];
+							if(strcmp(schd_tab[i][0],"")!=0 || strcmp(schd_tab[i][7],"P")!=0 || (tripids!= "" && tripids.find(trip,0)==string::npos))
+								continue;
+							if(wc == "WC" && p_disability.find("WC", 0) == string::npos && p_disability.find("SC", 0) == string::npos && p_disability.find("DOSLOW", 0) == string::npos)
+								continue;
+							legs.push_back(std::make_pair(s_tab[m][k-1], i));
+							legs.push_back(std::make_pair(i, i+1));
+							legs.push_back(std::make_pair(i+1, s_tab[m][k]));
+						}
+						prefetchTravelTimes(legs);
+						double leastdeviation = HUGE_VAL;
+						int deviationsseen = 0;
+
+						for (size_t c = 0; c < candidates.size(); c++){
+							const int i = candidates[c];
+							for(; deviationsseen < tripidxcnt; deviationsseen++)
+								leastdeviation = min(leastdeviation, deviation[deviationsseen]);
+							if(getCost(s_tab[m][k-1], i) > leastdeviation)
+								continue;
 
 							string trip = schd_tab[i][3];
 							if(tripids!= "" && tripids.find(trip,0)==string::npos)
@@ -11724,7 +12834,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 									int timethreshold = (segmentend - segmentstart)*HEADHOMETHRESHOLD[0];
 									timethreshold = segmentend - timethreshold;
-									int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+									int triptimethreshold = ((int)tripNumber(tripidx, 4));
 
 									pDisability = schd_tab[tripidx][12];
 									pReturn_trip = schd_tab[tripidx][18];
@@ -11792,17 +12902,17 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 											//  if(DEBUG == 1) gse << "here1 " << endl;
 										}
 									}
-									triptimeslot = (int)to_number(schd_tab[tripidx][41]);
-									tripcluster = (int)to_number(schd_tab[tripidx][42]);
+									triptimeslot = (int)tripNumber(tripidx, 41);
+									tripcluster = (int)tripNumber(tripidx, 42);
 									tripneighbors = schd_tab[tripidx][NEIGHBORS];
 
-									if(triplength == "L" && to_number(schd_tab[tripidx][21]) <=  a_mediumlongdistance[0]){
+									if(triplength == "L" && tripNumber(tripidx, 21) <=  a_mediumlongdistance[0]){
 										continue;
 									}
-									else if(triplength == "M" && to_number(schd_tab[tripidx][21]) <=  a_mediumshortdistance[0] || triplength == "M" && to_number(schd_tab[tripidx][21]) >  a_mediumlongdistance[0]){
+									else if(triplength == "M" && tripNumber(tripidx, 21) <=  a_mediumshortdistance[0] || triplength == "M" && tripNumber(tripidx, 21) >  a_mediumlongdistance[0]){
 										continue;
 									}
-									else if(triplength == "S" && to_number(schd_tab[tripidx][21]) >  a_mediumshortdistance[0]){
+									else if(triplength == "S" && tripNumber(tripidx, 21) >  a_mediumshortdistance[0]){
 										continue;
 									}
 
@@ -11865,39 +12975,39 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 												}
 											}
 
-											if((int)to_number(schd_tab[s_tab[m][k]][26]) ==0){
+											if((int)tripNumber(s_tab[m][k], 26) ==0){
 												prechecktime =  1440;
 											}
 											else{
-												prechecktime = (int)to_number(schd_tab[s_tab[m][k]][4]) + aLatepickup2 + floor((RELAXCONSTRAINTS[0] - 1)*50);
+												prechecktime = (int)tripNumber(s_tab[m][k], 4) + aLatepickup2 + floor((RELAXCONSTRAINTS[0] - 1)*50);
 											}
 
 
 										}
 										else{
-											if((int)to_number(schd_tab[s_tab[m][k]][27]) ==0 && (int)to_number(schd_tab[s_tab[m][k]][2]) != (int)to_number(MAXSTOPNUM[0])){
+											if((int)tripNumber(s_tab[m][k], 27) ==0 && (int)tripNumber(s_tab[m][k], 2) != (int)to_number(MAXSTOPNUM[0])){
 												prechecktime =  1440;
 											}
 
 											else{
-												prechecktime = (int)to_number(schd_tab[s_tab[m][k]][4]) + floor((RELAXCONSTRAINTS[0] - 1)*50);
+												prechecktime = (int)tripNumber(s_tab[m][k], 4) + floor((RELAXCONSTRAINTS[0] - 1)*50);
 											}
 										}
 
 
-										if(prechecktime >= (int)to_number(schd_tab[tripidx+1][4]) ){
+										if(prechecktime >= (int)tripNumber(tripidx+1, 4) ){
 
 
 
 
 
-											/* int triptimeslot2 = (int)to_number(schd_tab[tripidx+1][41]);
+											/* int triptimeslot2 = (int)tripNumber(tripidx+1, 41);
                               int segtimeslot;
                         if(strcmp(schd_tab[s_tab[m][k]][7],"D")==0){
-                            segtimeslot = (int)to_number(schd_tab[s_tab[m][k]][41]);
+                            segtimeslot = (int)tripNumber(s_tab[m][k], 41);
                         }
                        else{
-                           segtimeslot = (int)to_number(schd_tab[s_tab[m][k]][41])  + (aLatepickup2/15)+1;
+                           segtimeslot = (int)tripNumber(s_tab[m][k], 41)  + (aLatepickup2/15)+1;
                        }*/
 
 											if( triptimeslot >=t1 && triptimeslot <= t2 /*&& triptimeslot2 <= segtimeslot*/)
@@ -11916,17 +13026,17 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 													int extraperftime = 0;
-													int wc_occ = (int)to_number(schd_tab[s_tab[m][k-1]][32]);
-													int amb_occ = (int)to_number(schd_tab[s_tab[m][k-1]][31]);
-													int cs_occ = (int)to_number(schd_tab[s_tab[m][k-1]][CS_OCC]);
-													int cy_occ = (int)to_number(schd_tab[s_tab[m][k-1]][BS_OCC]);
+													int wc_occ = forwardslack.route.load(k-1, SLACKWC);
+													int amb_occ = forwardslack.route.load(k-1, SLACKAMB);
+													int cs_occ = forwardslack.route.load(k-1, SLACKCS);
+													int cy_occ = forwardslack.route.load(k-1, SLACKCY);
 
 
 													string pReturn_trip = schd_tab[tripidx][18];
 													string pDisability = schd_tab[tripidx][12];
 													string p_trip_type1 = schd_tab[tripidx][8];
 
-													int escort = (int)to_number(schd_tab[tripidx][13]);
+													int escort = (int)tripNumber(tripidx, 13);
 
 													if (pDisability.find("WC",0)!= string::npos || pDisability.find("SC",0)!= string::npos){
 														wc_occ = wc_occ + 1;
@@ -11969,7 +13079,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 															string pDisability = schd_tab[u][12];
 															string p_trip_type1 = schd_tab[u][8];
 
-															int escort = (int)to_number(schd_tab[u][13]);
+															int escort = (int)tripNumber(u, 13);
 
 															if (pDisability.find("WC",0)!= string::npos || pDisability.find("SC",0)!= string::npos){
 																wc_occ = wc_occ + 1;
@@ -12018,10 +13128,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 													if(strcmp(schd_tab[tripidx][42],schd_tab[s_tab[m][k-1]][42])==0){
 														string tempneighbors =  schd_tab[s_tab[m][k]][NEIGHBORS];
-														int tripcluster2 = (int)to_number(schd_tab[tripidx+1][42]);
+														int tripcluster2 = (int)tripNumber(tripidx+1, 42);
 														while(tempneighbors != ""){
 															int cidroute = (int)to_number(getNextToken(&(tempneighbors),","));
-															if(tripcluster2 == cidroute || tripcluster2 == (int)to_number(schd_tab[s_tab[m][k]][42])){
+															if(tripcluster2 == cidroute || tripcluster2 == (int)tripNumber(s_tab[m][k], 42)){
 
 
 
@@ -12048,36 +13158,36 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																	else{
 																		est_time =  (int)to_number(endtime1) - (int)to_number(est_traveltime1);
 																	}
-																	int trav_time =   (int)to_number(schd_tab[s_tab[m][k-1]][30]) + getTravTime_passedEta(s_tab[m][k-1],tripidx, to_string(est_time),"0");
-																	int tripstarttime = (int)to_number(schd_tab[tripidx][26]);
+																	int trav_time =   forwardslack.route.departure(k-1) + getTravTime_passedEta(s_tab[m][k-1],tripidx, to_string(est_time),"0");
+																	int tripstarttime = (int)tripNumber(tripidx, 26);
 
 																	if (trav_time < tripstarttime + aLatepickup + floor((RELAXCONSTRAINTS[0] - 1)*50) && tripstarttime > 0){
 
 
-																		if(trav_time < to_number(schd_tab[tripidx][26])  - aEarlypickup && to_number(schd_tab[tripidx][26])!= 0 ){
-																			trav_time = to_number(schd_tab[tripidx][26]) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
+																		if(trav_time < tripNumber(tripidx, 26)  - aEarlypickup && tripNumber(tripidx, 26)!= 0 ){
+																			trav_time = tripNumber(tripidx, 26) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
 																		}
-																		else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlypickup && to_number(schd_tab[tripidx][26])== 0 ){
-																			trav_time =  to_number(schd_tab[tripidx][4])  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
+																		else if(trav_time < tripNumber(tripidx, 4) - aEarlypickup && tripNumber(tripidx, 26)== 0 ){
+																			trav_time =  tripNumber(tripidx, 4)  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																		}
 																		else{
 																			trav_time =  trav_time + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																		}
 
-																		if (to_number(schd_tab[tripidx][27]) > 0)
-																		{if(DEBUG == 1) gse << "End time of trip " << to_number(schd_tab[tripidx][27])  << " trav time " << trav_time << endl;
-																		if (trav_time > to_number(schd_tab[tripidx][27]) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
+																		if (tripNumber(tripidx, 27) > 0)
+																		{if(DEBUG == 1) gse << "End time of trip " << tripNumber(tripidx, 27)  << " trav time " << trav_time << endl;
+																		if (trav_time > tripNumber(tripidx, 27) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
 																		{
 																			break;
 																		}
 
 																		}
 
-																		if(trav_time < to_number(schd_tab[tripidx][27])  - aEarlydropoff && to_number(schd_tab[tripidx][27])!= 0 ){
-																			trav_time = to_number(schd_tab[tripidx][27]) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
+																		if(trav_time < tripNumber(tripidx, 27)  - aEarlydropoff && tripNumber(tripidx, 27)!= 0 ){
+																			trav_time = tripNumber(tripidx, 27) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
 																		}
-																		else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlydropoff  && to_number(schd_tab[tripidx][27])== 0 ){
-																			trav_time =  to_number(schd_tab[tripidx][4])  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
+																		else if(trav_time < tripNumber(tripidx, 4) - aEarlydropoff  && tripNumber(tripidx, 27)== 0 ){
+																			trav_time =  tripNumber(tripidx, 4)  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
 																		}
 																		if((int)to_number(endtime1)!= 0)
 																			est_time = (int)to_number(endtime1);
@@ -12088,7 +13198,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																		if(endofsegtime > 0 ){
 
-																			if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																			if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50) && insertionDelayFits(forwardslack, k, trav_time)){
 
 
 
@@ -12097,17 +13207,17 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 
-																					int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																					int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																					int doeta1 = trav_time;
 																					int actualTT = doeta1 - puetd1;
-																					if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																					if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																					string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																					string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																					double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																					string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																					string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																					string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																					string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																					double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																					string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																					string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -12119,26 +13229,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					int groupcnter = 1;
 																					routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																					//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																					for (int i = 0; i < MAXSEGMENTS; i++)
-																					{
-																						if (s_tab[i][0] == routeint)
-																						{
-																							for (int g = 1; g < MAXSTOPS; g++)
-																							{
-																								if (s_tab[i][g] == s_tab[m][k-1])
-																								{
-
-																									while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																										groupcnter++;
-																										g--;
-																									}
-																									//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																									break;
-																								}
-																							}
-																							break;
-																						}
-																					}
+																					groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																					groupcnter = groupcnter + groupnumber;
 																					int aAllowedTT;
 																					if(estdisttrip < a_mediumshortdistance1)
@@ -12167,24 +13258,24 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 
-																				int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																				int segstart = (int)tripNumber(s_tab[m][1], 4);
 																				int segend;
 																				for (int g = 1; g < MAXSTOPS; g++)
 																				{
 																					if (s_tab[m][g] == 0)
 																					{
-																						segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																						segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																						break;
 
 																					}
 																				}
 																				int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																				int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																				int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																				timethreshold = segend - timethreshold;
 																				bool docalc = true;
 
-																				if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																				if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																						|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																				){
 
@@ -12202,12 +13293,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																					if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																						if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																						if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																							pudev = getCost(pickupafterstop,puid);
 																							dodev = getCost(doid,  dropoffafterstop);
 																						}
 																						else{
-																							pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																							pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																							dodev = pudev;
 
 																						}
@@ -12220,7 +13311,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																					docalc = false;
 
-																					if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																					if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																						double distpu =  getCost(tripidx, s_tab[m][k]);
 																						double distdo = getCost(tripidx+1, s_tab[m][k]);
 																						if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -12228,10 +13319,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						}
 																						double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																						if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																						if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																							if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																							distpu = 0;
-																							if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																							if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																								if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																								//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																									distdo = 0;
@@ -12242,7 +13333,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																								if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																								docalc = true;
 																							}
-																							else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																							else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																								if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																								docalc = true;
 																							}
@@ -12252,12 +13343,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																						if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																							if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																							if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																								pudev = getCost(pickupafterstop,puid);
 																								dodev = getCost(doid,  dropoffafterstop);
 																							}
 																							else{
-																								pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																								pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																								dodev = pudev;
 
 																							}
@@ -12267,7 +13358,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							dodev = 0;
 																						}
 
-																						if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																						if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																							if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																							docalc = true;
 
@@ -12299,7 +13390,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																					set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																					if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																					if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																					if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																						AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -12381,16 +13472,16 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																					if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																						if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																							nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																						if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																							nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																						}
 																						else{
 																							nextstoptime = nextstoptime+p_perf_time2;
 																						}
 																					}
 																					else{
-																						if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																							nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																						if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																							nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																						}
 																						else{
 																							nextstoptime = nextstoptime+p_perf_time2;
@@ -12399,14 +13490,14 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																					int p_eta;
-																					if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																					if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																						p_eta = previouseta;
 																					}
 																					else{
-																						p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																						p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																					}
 
-																					nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																					nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 
@@ -12452,10 +13543,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																					bool preassigntripchange = true;
 
-																					int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																					int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																					int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																					int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																					if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																						endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																						endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																					}
 																					string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -12466,7 +13557,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																							{
 																								int dev =  p_eta - (starttime1 + aLatepickup);
-																								if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																								if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																									preassigntripchange = true;
 																								}
 
@@ -12479,7 +13570,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																							{
 																								int dev =  p_eta - (endtime1);
-																								if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																								if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																									preassigntripchange = true;
 																								}
 																							}
@@ -12491,7 +13582,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																							if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																							if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																								isLate = true;
 																								break;
 																							}
@@ -12502,12 +13593,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						}
 																						else{
 
-																							if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																							if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																								isLate = true;
 																								break;
 																							}
 																							else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																								if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																								if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																									isLate = true;
 																									break;}
 																							}
@@ -12546,10 +13637,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -12572,17 +13663,17 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 
-																				int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																				int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																				int doeta1 = trav_time;
 																				int actualTT = doeta1 - puetd1;
-																				if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																				if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																				string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																				string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																				double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																				string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																				string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																				string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																				string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																				double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																				string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																				string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -12594,26 +13685,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																				int groupcnter = 1;
 																				routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																				//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																				for (int i = 0; i < MAXSEGMENTS; i++)
-																				{
-																					if (s_tab[i][0] == routeint)
-																					{
-																						for (int g = 1; g < MAXSTOPS; g++)
-																						{
-																							if (s_tab[i][g] == s_tab[m][k-1])
-																							{
-
-																								while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																									groupcnter++;
-																									g--;
-																								}
-																								//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																								break;
-																							}
-																						}
-																						break;
-																					}
-																				}
+																				groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																				groupcnter = groupcnter + groupnumber;
 																				int aAllowedTT;
 																				if(estdisttrip < a_mediumshortdistance1)
@@ -12638,24 +13710,24 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																				}
 
 
-																			}int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																			}int segstart = (int)tripNumber(s_tab[m][1], 4);
 																			int segend;
 																			for (int g = 1; g < MAXSTOPS; g++)
 																			{
 																				if (s_tab[m][g] == 0)
 																				{
-																					segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																					segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																					break;
 
 																				}
 																			}
 																			int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																			int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																			int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																			timethreshold = segend - timethreshold;
 																			bool docalc = true;
 
-																			if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																			if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																					|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																			){
 
@@ -12673,12 +13745,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																				double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																				if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																					if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																					if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																						pudev = getCost(pickupafterstop,puid);
 																						dodev = getCost(doid,  dropoffafterstop);
 																					}
 																					else{
-																						pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																						pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																						dodev = pudev;
 
 																					}
@@ -12691,7 +13763,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																				docalc = false;
 
-																				if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																				if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																					double distpu =  getCost(tripidx, s_tab[m][k]);
 																					double distdo = getCost(tripidx+1, s_tab[m][k]);
 																					if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -12699,10 +13771,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					}
 																					double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																					if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																					if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																						if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																						distpu = 0;
-																						if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																						if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																							if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																							//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																								distdo = 0;
@@ -12713,7 +13785,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																							docalc = true;
 																						}
-																						else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																						else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																							if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																							docalc = true;
 																						}
@@ -12723,12 +13795,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																					if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																						if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																						if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																							pudev = getCost(pickupafterstop,puid);
 																							dodev = getCost(doid,  dropoffafterstop);
 																						}
 																						else{
-																							pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																							pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																							dodev = pudev;
 
 																						}
@@ -12738,7 +13810,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						dodev = 0;
 																					}
 
-																					if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																					if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																						if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																						docalc = true;
 
@@ -12766,7 +13838,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																				string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																				set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																				if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																				if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																				if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																					AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -12848,16 +13920,16 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																				if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																					if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																						nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																					if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																						nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																					}
 																					else{
 																						nextstoptime = nextstoptime+p_perf_time2;
 																					}
 																				}
 																				else{
-																					if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																						nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																					if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																						nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																					}
 																					else{
 																						nextstoptime = nextstoptime+p_perf_time2;
@@ -12866,14 +13938,14 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																				int p_eta;
-																				if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																				if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																					p_eta = previouseta;
 																				}
 																				else{
-																					p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																					p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																				}
 
-																				nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																				nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																				if (pDisability3.find("LP",0) != string::npos){
@@ -12917,10 +13989,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																				}
 																				bool preassigntripchange = true;
 
-																				int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																				int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																				int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																				int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																				if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																					endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																					endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																				}
 																				string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -12931,7 +14003,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																						{
 																							int dev =  p_eta - (starttime1 + aLatepickup);
-																							if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																							if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																								preassigntripchange = true;
 																							}
 
@@ -12944,7 +14016,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																						{
 																							int dev =  p_eta - (endtime1);
-																							if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																							if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																								preassigntripchange = true;
 																							}
 																						}
@@ -12955,7 +14027,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																						if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																						if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																							isLate = true;
 																							break;
 																						}
@@ -12966,12 +14038,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					}
 																					else{
 
-																						if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																						if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																							isLate = true;
 																							break;
 																						}
 																						else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																							if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																							if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																								isLate = true;
 																								break;}
 																						}
@@ -13010,10 +14082,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -13030,29 +14102,29 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																	else if(tripstarttime == 0) {
 																		if(DEBUG == 1) gse << "no start time " << endl;
 
-																		if(trav_time < to_number(schd_tab[tripidx][26])  - aEarlypickup && to_number(schd_tab[tripidx][26])!= 0 ){
-																			trav_time = to_number(schd_tab[tripidx][26]) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
+																		if(trav_time < tripNumber(tripidx, 26)  - aEarlypickup && tripNumber(tripidx, 26)!= 0 ){
+																			trav_time = tripNumber(tripidx, 26) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
 																		}
-																		else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlypickup && to_number(schd_tab[tripidx][26])== 0 ){
-																			trav_time =  to_number(schd_tab[tripidx][4])  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
+																		else if(trav_time < tripNumber(tripidx, 4) - aEarlypickup && tripNumber(tripidx, 26)== 0 ){
+																			trav_time =  tripNumber(tripidx, 4)  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																		}
 																		else{
 																			trav_time =  trav_time + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																		}
 
-																		if (to_number(schd_tab[tripidx][27]) > 0)
-																		{if(DEBUG == 1) gse << "End time of trip " << to_number(schd_tab[tripidx][27])  << " trav time " << trav_time << endl;
-																		if (trav_time > to_number(schd_tab[tripidx][27]) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
+																		if (tripNumber(tripidx, 27) > 0)
+																		{if(DEBUG == 1) gse << "End time of trip " << tripNumber(tripidx, 27)  << " trav time " << trav_time << endl;
+																		if (trav_time > tripNumber(tripidx, 27) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
 																		{
 																			break;
 																		}
 
 																		}
-																		if(trav_time < to_number(schd_tab[tripidx][27])  - aEarlydropoff && to_number(schd_tab[tripidx][27])!= 0 ){
-																			trav_time = to_number(schd_tab[tripidx][27]) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
+																		if(trav_time < tripNumber(tripidx, 27)  - aEarlydropoff && tripNumber(tripidx, 27)!= 0 ){
+																			trav_time = tripNumber(tripidx, 27) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
 																		}
-																		else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlydropoff  && to_number(schd_tab[tripidx][27])== 0 ){
-																			trav_time =  to_number(schd_tab[tripidx][4])  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
+																		else if(trav_time < tripNumber(tripidx, 4) - aEarlydropoff  && tripNumber(tripidx, 27)== 0 ){
+																			trav_time =  tripNumber(tripidx, 4)  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
 																		}
 
 																		if((int)to_number(endtime1)!= 0)
@@ -13064,23 +14136,23 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																		if(endofsegtime > 0  ){
 
-																			if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																			if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50) && insertionDelayFits(forwardslack, k, trav_time)){
 
 																				if(strcmp(schd_tab[s_tab[m][k]][7],"D")==0  /*&& strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*//*&& strcmp(schd_tab[pickupafterstop][7],"P")==0 && strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*/ && strcmp(schd_tab[s_tab[m][k]][3],schd_tab[s_tab[m][k]][0])!=0){
 
 
 
-																					int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																					int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																					int doeta1 = trav_time;
 																					int actualTT = doeta1 - puetd1;
-																					if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																					if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																					string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																					string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																					double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																					string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																					string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																					string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																					string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																					double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																					string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																					string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -13092,26 +14164,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					int groupcnter = 1;
 																					routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																					//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																					for (int i = 0; i < MAXSEGMENTS; i++)
-																					{
-																						if (s_tab[i][0] == routeint)
-																						{
-																							for (int g = 1; g < MAXSTOPS; g++)
-																							{
-																								if (s_tab[i][g] == s_tab[m][k-1])
-																								{
-
-																									while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																										groupcnter++;
-																										g--;
-																									}
-																									//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																									break;
-																								}
-																							}
-																							break;
-																						}
-																					}
+																					groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																					groupcnter = groupcnter + groupnumber;
 																					int aAllowedTT;
 
@@ -13137,24 +14190,24 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																				}
-																				int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																				int segstart = (int)tripNumber(s_tab[m][1], 4);
 																				int segend;
 																				for (int g = 1; g < MAXSTOPS; g++)
 																				{
 																					if (s_tab[m][g] == 0)
 																					{
-																						segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																						segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																						break;
 
 																					}
 																				}
 																				int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																				int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																				int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																				timethreshold = segend - timethreshold;
 																				bool docalc = true;
 
-																				if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																				if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																						|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																				){
 
@@ -13172,12 +14225,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																					if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																						if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																						if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																							pudev = getCost(pickupafterstop,puid);
 																							dodev = getCost(doid,  dropoffafterstop);
 																						}
 																						else{
-																							pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																							pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																							dodev = pudev;
 
 																						}
@@ -13190,7 +14243,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																					docalc = false;
 
-																					if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																					if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																						double distpu =  getCost(tripidx, s_tab[m][k]);
 																						double distdo = getCost(tripidx+1, s_tab[m][k]);
 																						if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -13198,10 +14251,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						}
 																						double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																						if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																						if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																							if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																							distpu = 0;
-																							if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																							if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																								if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																								//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																									distdo = 0;
@@ -13212,7 +14265,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																								if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																								docalc = true;
 																							}
-																							else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																							else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																								if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																								docalc = true;
 																							}
@@ -13222,12 +14275,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																						if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																							if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																							if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																								pudev = getCost(pickupafterstop,puid);
 																								dodev = getCost(doid,  dropoffafterstop);
 																							}
 																							else{
-																								pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																								pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																								dodev = pudev;
 
 																							}
@@ -13237,7 +14290,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							dodev = 0;
 																						}
 
-																						if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																						if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																							if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																							docalc = true;
 
@@ -13264,7 +14317,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																					set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																					if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																					if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																					if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																						AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -13346,16 +14399,16 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																					if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																						if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																							nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																						if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																							nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																						}
 																						else{
 																							nextstoptime = nextstoptime+p_perf_time2;
 																						}
 																					}
 																					else{
-																						if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																							nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																						if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																							nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																						}
 																						else{
 																							nextstoptime = nextstoptime+p_perf_time2;
@@ -13364,14 +14417,14 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																					int p_eta;
-																					if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																					if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																						p_eta = previouseta;
 																					}
 																					else{
-																						p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																						p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																					}
 
-																					nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																					nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																					if (pDisability3.find("LP",0) != string::npos){
@@ -13415,10 +14468,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					}
 																					bool preassigntripchange = true;
 
-																					int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																					int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																					int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																					int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																					if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																						endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																						endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																					}
 																					string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -13429,7 +14482,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																							{
 																								int dev =  p_eta - (starttime1 + aLatepickup);
-																								if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																								if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																									preassigntripchange = true;
 																								}
 
@@ -13442,7 +14495,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																							{
 																								int dev =  p_eta - (endtime1);
-																								if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																								if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																									preassigntripchange = true;
 																								}
 																							}
@@ -13454,7 +14507,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																							if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																							if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																								isLate = true;
 																								break;
 																							}
@@ -13465,12 +14518,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						}
 																						else{
 
-																							if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																							if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																								isLate = true;
 																								break;
 																							}
 																							else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																								if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																								if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																									isLate = true;
 																									break;}
 																							}
@@ -13509,10 +14562,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -13534,17 +14587,17 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 
-																				int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																				int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																				int doeta1 = trav_time;
 																				int actualTT = doeta1 - puetd1;
-																				if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																				if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																				string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																				string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																				double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																				string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																				string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																				string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																				string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																				double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																				string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																				string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -13556,26 +14609,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																				int groupcnter = 1;
 																				routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																				//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																				for (int i = 0; i < MAXSEGMENTS; i++)
-																				{
-																					if (s_tab[i][0] == routeint)
-																					{
-																						for (int g = 1; g < MAXSTOPS; g++)
-																						{
-																							if (s_tab[i][g] == s_tab[m][k-1])
-																							{
-
-																								while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																									groupcnter++;
-																									g--;
-																								}
-																								//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																								break;
-																							}
-																						}
-																						break;
-																					}
-																				}
+																				groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																				groupcnter = groupcnter + groupnumber;
 																				int aAllowedTT;
 
@@ -13601,24 +14635,24 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																			}
-																			int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																			int segstart = (int)tripNumber(s_tab[m][1], 4);
 																			int segend;
 																			for (int g = 1; g < MAXSTOPS; g++)
 																			{
 																				if (s_tab[m][g] == 0)
 																				{
-																					segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																					segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																					break;
 
 																				}
 																			}
 																			int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																			int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																			int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																			timethreshold = segend - timethreshold;
 																			bool docalc = true;
 
-																			if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																			if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																					|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																			){
 
@@ -13636,12 +14670,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																				double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																				if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																					if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																					if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																						pudev = getCost(pickupafterstop,puid);
 																						dodev = getCost(doid,  dropoffafterstop);
 																					}
 																					else{
-																						pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																						pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																						dodev = pudev;
 
 																					}
@@ -13654,7 +14688,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																				docalc = false;
 
-																				if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																				if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																					double distpu =  getCost(tripidx, s_tab[m][k]);
 																					double distdo = getCost(tripidx+1, s_tab[m][k]);
 																					if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -13662,10 +14696,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					}
 																					double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																					if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																					if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																						if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																						distpu = 0;
-																						if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																						if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																							if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																							//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																								distdo = 0;
@@ -13676,7 +14710,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																							docalc = true;
 																						}
-																						else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																						else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																							if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																							docalc = true;
 																						}
@@ -13686,12 +14720,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																					if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																						if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																						if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																							pudev = getCost(pickupafterstop,puid);
 																							dodev = getCost(doid,  dropoffafterstop);
 																						}
 																						else{
-																							pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																							pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																							dodev = pudev;
 
 																						}
@@ -13701,7 +14735,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						dodev = 0;
 																					}
 
-																					if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																					if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																						if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																						docalc = true;
 
@@ -13729,7 +14763,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																				string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																				set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																				if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																				if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																				if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																					AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -13811,16 +14845,16 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																				if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																					if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																						nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																					if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																						nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																					}
 																					else{
 																						nextstoptime = nextstoptime+p_perf_time2;
 																					}
 																				}
 																				else{
-																					if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																						nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																					if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																						nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																					}
 																					else{
 																						nextstoptime = nextstoptime+p_perf_time2;
@@ -13829,14 +14863,14 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																				int p_eta;
-																				if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																				if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																					p_eta = previouseta;
 																				}
 																				else{
-																					p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																					p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																				}
 
-																				nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																				nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																				if (pDisability3.find("LP",0) != string::npos){
@@ -13881,10 +14915,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																				}
 																				bool preassigntripchange = true;
 
-																				int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																				int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																				int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																				int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																				if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																					endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																					endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																				}
 																				string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -13895,7 +14929,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																						{
 																							int dev =  p_eta - (starttime1 + aLatepickup);
-																							if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																							if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																								preassigntripchange = true;
 																							}
 
@@ -13908,7 +14942,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																						{
 																							int dev =  p_eta - (endtime1);
-																							if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																							if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																								preassigntripchange = true;
 																							}
 																						}
@@ -13921,7 +14955,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																						if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																						if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																							isLate = true;
 																							break;
 																						}
@@ -13932,12 +14966,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					}
 																					else{
 
-																						if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																						if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																							isLate = true;
 																							break;
 																						}
 																						else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																							if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																							if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																								isLate = true;
 																								break;}
 																						}
@@ -13976,10 +15010,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -14009,13 +15043,13 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 													bool foundmatch = false;
 													//int temproutecluster  = (int)to_number( schd_tab[s_tab[m][k-1]][42]);
 													string temp2 = schd_tab[s_tab[m][k]][NEIGHBORS];
-													int tripcluster2 = (int)to_number(schd_tab[tripidx+1][42]);
+													int tripcluster2 = (int)tripNumber(tripidx+1, 42);
 													while(temp != ""){
 														cidroute = (int)to_number(getNextToken(&(temp),","));
 														if(tripcluster == cidroute){
 															while(temp2 != ""){
 																int cidroute2 = (int)to_number(getNextToken(&(temp2),","));
-																if(tripcluster2 == cidroute2 || tripcluster2 == (int)to_number(schd_tab[s_tab[m][k]][42])){
+																if(tripcluster2 == cidroute2 || tripcluster2 == (int)tripNumber(s_tab[m][k], 42)){
 																	//if(cid == cidroute || cid == temproutecluster || cidroute  == tripcluster || tripcluster == temproutecluster)
 
 
@@ -14040,39 +15074,39 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																		else{
 																			est_time =  (int)to_number(endtime1) - (int)to_number(est_traveltime1);
 																		}
-																		int trav_time =   (int)to_number(schd_tab[s_tab[m][k-1]][30]) +getTravTime_passedEta(s_tab[m][k-1],tripidx, to_string(est_time),"0");
-																		int tripstarttime = (int)to_number(schd_tab[tripidx][26]);
+																		int trav_time =   forwardslack.route.departure(k-1) +getTravTime_passedEta(s_tab[m][k-1],tripidx, to_string(est_time),"0");
+																		int tripstarttime = (int)tripNumber(tripidx, 26);
 
 																		if (trav_time < tripstarttime + aLatepickup + floor((RELAXCONSTRAINTS[0] - 1)*50) && tripstarttime > 0){
 
 
-																			if(trav_time < to_number(schd_tab[tripidx][26])  - aEarlypickup && to_number(schd_tab[tripidx][26])!= 0 ){
+																			if(trav_time < tripNumber(tripidx, 26)  - aEarlypickup && tripNumber(tripidx, 26)!= 0 ){
 																				//  if(DEBUG == 1) gse <<" using 1 " << schd_tab[tripidx][26] << endl;
-																				trav_time = to_number(schd_tab[tripidx][26]) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
+																				trav_time = tripNumber(tripidx, 26) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
 																			}
-																			else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlypickup && to_number(schd_tab[tripidx][26])== 0 ){
+																			else if(trav_time < tripNumber(tripidx, 4) - aEarlypickup && tripNumber(tripidx, 26)== 0 ){
 																				//  if(DEBUG == 1) gse <<" using 2 " << schd_tab[tripidx][4] << endl;
-																				trav_time =  to_number(schd_tab[tripidx][4])  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
+																				trav_time =  tripNumber(tripidx, 4)  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																			}
 																			else{
 																				//  if(DEBUG == 1) gse <<" none " << trav_time  << endl;
 																				trav_time =  trav_time + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																			}
 
-																			if (to_number(schd_tab[tripidx][27]) > 0)
-																			{if(DEBUG == 1) gse << "End time of trip " << to_number(schd_tab[tripidx][27])  << " trav time " << trav_time << endl;
-																			if (trav_time > to_number(schd_tab[tripidx][27]) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
+																			if (tripNumber(tripidx, 27) > 0)
+																			{if(DEBUG == 1) gse << "End time of trip " << tripNumber(tripidx, 27)  << " trav time " << trav_time << endl;
+																			if (trav_time > tripNumber(tripidx, 27) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
 																			{
 																				break;
 																			}
 
 																			}
 
-																			if(trav_time < to_number(schd_tab[tripidx][27])  - aEarlydropoff && to_number(schd_tab[tripidx][27])!= 0 ){
-																				trav_time = to_number(schd_tab[tripidx][27]) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
+																			if(trav_time < tripNumber(tripidx, 27)  - aEarlydropoff && tripNumber(tripidx, 27)!= 0 ){
+																				trav_time = tripNumber(tripidx, 27) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
 																			}
-																			else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlydropoff  && to_number(schd_tab[tripidx][27])== 0 ){
-																				trav_time =  to_number(schd_tab[tripidx][4])  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
+																			else if(trav_time < tripNumber(tripidx, 4) - aEarlydropoff  && tripNumber(tripidx, 27)== 0 ){
+																				trav_time =  tripNumber(tripidx, 4)  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
 																			}
 
 																			if((int)to_number(endtime1)!= 0)
@@ -14084,23 +15118,23 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																			if(endofsegtime > 0  ){
 
-																				if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																				if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50) && insertionDelayFits(forwardslack, k, trav_time)){
 
 																					if(strcmp(schd_tab[s_tab[m][k]][7],"D")==0  /*&& strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*//*&& strcmp(schd_tab[pickupafterstop][7],"P")==0 && strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*/ && strcmp(schd_tab[s_tab[m][k]][3],schd_tab[s_tab[m][k]][0])!=0){
 
 
 
-																						int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																						int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																						int doeta1 = trav_time;
 																						int actualTT = doeta1 - puetd1;
-																						if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																						if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																						string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																						string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																						double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																						string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																						string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																						string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																						string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																						double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																						string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																						string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -14112,26 +15146,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						int groupcnter = 1;
 																						routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																						//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																						for (int i = 0; i < MAXSEGMENTS; i++)
-																						{
-																							if (s_tab[i][0] == routeint)
-																							{
-																								for (int g = 1; g < MAXSTOPS; g++)
-																								{
-																									if (s_tab[i][g] == s_tab[m][k-1])
-																									{
-
-																										while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																											groupcnter++;
-																											g--;
-																										}
-																										//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																										break;
-																									}
-																								}
-																								break;
-																							}
-																						}
+																						groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																						groupcnter = groupcnter + groupnumber;
 																						int aAllowedTT;
 
@@ -14158,24 +15173,24 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																					}
-																					int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																					int segstart = (int)tripNumber(s_tab[m][1], 4);
 																					int segend;
 																					for (int g = 1; g < MAXSTOPS; g++)
 																					{
 																						if (s_tab[m][g] == 0)
 																						{
-																							segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																							segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																							break;
 
 																						}
 																					}
 																					int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																					int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																					int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																					timethreshold = segend - timethreshold;
 																					bool docalc = true;
 
-																					if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																					if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																							|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																					){
 
@@ -14193,12 +15208,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																						if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																							if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																							if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																								pudev = getCost(pickupafterstop,puid);
 																								dodev = getCost(doid,  dropoffafterstop);
 																							}
 																							else{
-																								pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																								pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																								dodev = pudev;
 
 																							}
@@ -14211,7 +15226,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																						docalc = false;
 
-																						if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																						if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																							double distpu =  getCost(tripidx, s_tab[m][k]);
 																							double distdo = getCost(tripidx+1, s_tab[m][k]);
 																							if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -14219,10 +15234,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							}
 																							double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																							if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																							if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																								if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																								distpu = 0;
-																								if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																								if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																									if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																									//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																										distdo = 0;
@@ -14233,7 +15248,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																									if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																									docalc = true;
 																								}
-																								else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																								else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																									if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																									docalc = true;
 																								}
@@ -14243,12 +15258,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																							if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																								if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																								if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																									pudev = getCost(pickupafterstop,puid);
 																									dodev = getCost(doid,  dropoffafterstop);
 																								}
 																								else{
-																									pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																									pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																									dodev = pudev;
 
 																								}
@@ -14258,7 +15273,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																								dodev = 0;
 																							}
 
-																							if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																							if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																								if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																								docalc = true;
 
@@ -14286,7 +15301,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																						set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																						if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																						if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																						if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																							AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -14368,16 +15383,16 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																						if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																							if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																								nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																							if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																								nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																							}
 																							else{
 																								nextstoptime = nextstoptime+p_perf_time2;
 																							}
 																						}
 																						else{
-																							if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																								nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																							if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																								nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																							}
 																							else{
 																								nextstoptime = nextstoptime+p_perf_time2;
@@ -14385,14 +15400,14 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						}
 
 																						int p_eta;
-																						if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																						if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																							p_eta = previouseta;
 																						}
 																						else{
-																							p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																							p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																						}
 
-																						nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																						nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																						if (pDisability3.find("LP",0) != string::npos){
@@ -14436,10 +15451,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						}
 																						bool preassigntripchange = true;
 
-																						int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																						int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																						int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																						int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																						if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																							endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																							endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																						}
 																						string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -14450,7 +15465,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																								if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																								{
 																									int dev =  p_eta - (starttime1 + aLatepickup);
-																									if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																									if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																										preassigntripchange = true;
 																									}
 
@@ -14463,7 +15478,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																								if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																								{
 																									int dev =  p_eta - (endtime1);
-																									if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																									if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																										preassigntripchange = true;
 																									}
 																								}
@@ -14475,7 +15490,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																								if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																								if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																									isLate = true;
 																									break;
 																								}
@@ -14486,12 +15501,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							}
 																							else{
 
-																								if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																								if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																									isLate = true;
 																									break;
 																								}
 																								else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																									if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																									if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																										isLate = true;
 																										break;}
 																								}
@@ -14530,10 +15545,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -14555,17 +15570,17 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 
-																					int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																					int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																					int doeta1 = trav_time;
 																					int actualTT = doeta1 - puetd1;
-																					if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																					if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																					string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																					string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																					double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																					string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																					string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																					string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																					string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																					double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																					string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																					string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -14577,26 +15592,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					int groupcnter = 1;
 																					routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																					//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																					for (int i = 0; i < MAXSEGMENTS; i++)
-																					{
-																						if (s_tab[i][0] == routeint)
-																						{
-																							for (int g = 1; g < MAXSTOPS; g++)
-																							{
-																								if (s_tab[i][g] == s_tab[m][k-1])
-																								{
-
-																									while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																										groupcnter++;
-																										g--;
-																									}
-																									//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																									break;
-																								}
-																							}
-																							break;
-																						}
-																					}
+																					groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																					groupcnter = groupcnter + groupnumber;
 																					int aAllowedTT;
 
@@ -14623,24 +15619,24 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																				}
-																				int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																				int segstart = (int)tripNumber(s_tab[m][1], 4);
 																				int segend;
 																				for (int g = 1; g < MAXSTOPS; g++)
 																				{
 																					if (s_tab[m][g] == 0)
 																					{
-																						segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																						segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																						break;
 
 																					}
 																				}
 																				int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																				int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																				int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																				timethreshold = segend - timethreshold;
 																				bool docalc = true;
 
-																				if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																				if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																						|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																				){
 
@@ -14658,12 +15654,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																					if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																						if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																						if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																							pudev = getCost(pickupafterstop,puid);
 																							dodev = getCost(doid,  dropoffafterstop);
 																						}
 																						else{
-																							pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																							pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																							dodev = pudev;
 
 																						}
@@ -14676,7 +15672,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																					docalc = false;
 
-																					if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																					if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																						double distpu =  getCost(tripidx, s_tab[m][k]);
 																						double distdo = getCost(tripidx+1, s_tab[m][k]);
 																						if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -14684,10 +15680,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						}
 																						double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																						if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																						if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																							if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																							distpu = 0;
-																							if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																							if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																								if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																								//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																									distdo = 0;
@@ -14698,7 +15694,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																								if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																								docalc = true;
 																							}
-																							else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																							else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																								if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																								docalc = true;
 																							}
@@ -14708,12 +15704,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																						if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																							if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																							if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																								pudev = getCost(pickupafterstop,puid);
 																								dodev = getCost(doid,  dropoffafterstop);
 																							}
 																							else{
-																								pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																								pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																								dodev = pudev;
 
 																							}
@@ -14723,7 +15719,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							dodev = 0;
 																						}
 
-																						if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																						if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																							if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																							docalc = true;
 
@@ -14750,7 +15746,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																					set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																					if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																					if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																					if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																						AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -14832,16 +15828,16 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																					if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																						if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																							nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																						if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																							nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																						}
 																						else{
 																							nextstoptime = nextstoptime+p_perf_time2;
 																						}
 																					}
 																					else{
-																						if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																							nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																						if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																							nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																						}
 																						else{
 																							nextstoptime = nextstoptime+p_perf_time2;
@@ -14849,14 +15845,14 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					}
 
 																					int p_eta;
-																					if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																					if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																						p_eta = previouseta;
 																					}
 																					else{
-																						p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																						p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																					}
 
-																					nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																					nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																					if (pDisability3.find("LP",0) != string::npos){
@@ -14900,10 +15896,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					}
 																					bool preassigntripchange = true;
 
-																					int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																					int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																					int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																					int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																					if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																						endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																						endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																					}
 																					string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -14914,7 +15910,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																							{
 																								int dev =  p_eta - (starttime1 + aLatepickup);
-																								if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																								if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																									preassigntripchange = true;
 																								}
 
@@ -14927,7 +15923,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																							{
 																								int dev =  p_eta - (endtime1);
-																								if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																								if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																									preassigntripchange = true;
 																								}
 																							}
@@ -14939,7 +15935,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																							if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																							if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																								isLate = true;
 																								break;
 																							}
@@ -14950,12 +15946,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						}
 																						else{
 
-																							if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																							if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																								isLate = true;
 																								break;
 																							}
 																							else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																								if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																								if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																									isLate = true;
 																									break;}
 																							}
@@ -14994,10 +15990,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -15016,30 +16012,30 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																		else if(tripstarttime == 0) {
 																			if(DEBUG == 1) gse << "no start time " << endl;
 
-																			if(trav_time < to_number(schd_tab[tripidx][26])  - aEarlypickup && to_number(schd_tab[tripidx][26])!= 0 ){
-																				trav_time = to_number(schd_tab[tripidx][26]) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
+																			if(trav_time < tripNumber(tripidx, 26)  - aEarlypickup && tripNumber(tripidx, 26)!= 0 ){
+																				trav_time = tripNumber(tripidx, 26) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
 																			}
-																			else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlypickup && to_number(schd_tab[tripidx][26])== 0 ){
-																				trav_time =  to_number(schd_tab[tripidx][4])  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
+																			else if(trav_time < tripNumber(tripidx, 4) - aEarlypickup && tripNumber(tripidx, 26)== 0 ){
+																				trav_time =  tripNumber(tripidx, 4)  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																			}
 																			else{
 																				trav_time =  trav_time + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																			}
 
-																			if (to_number(schd_tab[tripidx][27]) > 0)
-																			{if(DEBUG == 1) gse << "End time of trip " << to_number(schd_tab[tripidx][27])  << " trav time " << trav_time << endl;
-																			if (trav_time > to_number(schd_tab[tripidx][27]) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
+																			if (tripNumber(tripidx, 27) > 0)
+																			{if(DEBUG == 1) gse << "End time of trip " << tripNumber(tripidx, 27)  << " trav time " << trav_time << endl;
+																			if (trav_time > tripNumber(tripidx, 27) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
 																			{
 																				break;
 																			}
 
 																			}
 
-																			if(trav_time < to_number(schd_tab[tripidx][27])  - aEarlydropoff && to_number(schd_tab[tripidx][27])!= 0 ){
-																				trav_time = to_number(schd_tab[tripidx][27]) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
+																			if(trav_time < tripNumber(tripidx, 27)  - aEarlydropoff && tripNumber(tripidx, 27)!= 0 ){
+																				trav_time = tripNumber(tripidx, 27) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
 																			}
-																			else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlydropoff  && to_number(schd_tab[tripidx][27])== 0 ){
-																				trav_time =  to_number(schd_tab[tripidx][4])  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
+																			else if(trav_time < tripNumber(tripidx, 4) - aEarlydropoff  && tripNumber(tripidx, 27)== 0 ){
+																				trav_time =  tripNumber(tripidx, 4)  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
 																			}
 
 																			if((int)to_number(endtime1)!= 0)
@@ -15051,23 +16047,23 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																			if(endofsegtime > 0  ){
 
-																				if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																				if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50) && insertionDelayFits(forwardslack, k, trav_time)){
 
 																					if(strcmp(schd_tab[s_tab[m][k]][7],"D")==0  /*&& strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*//*&& strcmp(schd_tab[pickupafterstop][7],"P")==0 && strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*/ && strcmp(schd_tab[s_tab[m][k]][3],schd_tab[s_tab[m][k]][0])!=0){
 
 
 
-																						int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																						int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																						int doeta1 = trav_time;
 																						int actualTT = doeta1 - puetd1;
-																						if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																						if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																						string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																						string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																						double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																						string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																						string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																						string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																						string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																						double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																						string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																						string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -15079,26 +16075,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						int groupcnter = 1;
 																						routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																						//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																						for (int i = 0; i < MAXSEGMENTS; i++)
-																						{
-																							if (s_tab[i][0] == routeint)
-																							{
-																								for (int g = 1; g < MAXSTOPS; g++)
-																								{
-																									if (s_tab[i][g] == s_tab[m][k-1])
-																									{
-
-																										while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																											groupcnter++;
-																											g--;
-																										}
-																										//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																										break;
-																									}
-																								}
-																								break;
-																							}
-																						}
+																						groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																						groupcnter = groupcnter + groupnumber;
 																						int aAllowedTT;
 
@@ -15125,24 +16102,24 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																					}
-																					int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																					int segstart = (int)tripNumber(s_tab[m][1], 4);
 																					int segend;
 																					for (int g = 1; g < MAXSTOPS; g++)
 																					{
 																						if (s_tab[m][g] == 0)
 																						{
-																							segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																							segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																							break;
 
 																						}
 																					}
 																					int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																					int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																					int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																					timethreshold = segend - timethreshold;
 																					bool docalc = true;
 
-																					if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																					if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																							|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																					){
 
@@ -15160,12 +16137,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																						if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																							if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																							if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																								pudev = getCost(pickupafterstop,puid);
 																								dodev = getCost(doid,  dropoffafterstop);
 																							}
 																							else{
-																								pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																								pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																								dodev = pudev;
 
 																							}
@@ -15178,7 +16155,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																						docalc = false;
 
-																						if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																						if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																							double distpu =  getCost(tripidx, s_tab[m][k]);
 																							double distdo = getCost(tripidx+1, s_tab[m][k]);
 																							if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -15186,10 +16163,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							}
 																							double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																							if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																							if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																								if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																								distpu = 0;
-																								if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																								if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																									if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																									//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																										distdo = 0;
@@ -15200,7 +16177,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																									if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																									docalc = true;
 																								}
-																								else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																								else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																									if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																									docalc = true;
 																								}
@@ -15210,12 +16187,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																							if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																								if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																								if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																									pudev = getCost(pickupafterstop,puid);
 																									dodev = getCost(doid,  dropoffafterstop);
 																								}
 																								else{
-																									pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																									pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																									dodev = pudev;
 
 																								}
@@ -15225,7 +16202,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																								dodev = 0;
 																							}
 
-																							if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																							if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																								if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																								docalc = true;
 
@@ -15253,7 +16230,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																						set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																						if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																						if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																						if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																							AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -15335,16 +16312,16 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																						if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																							if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																								nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																							if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																								nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																							}
 																							else{
 																								nextstoptime = nextstoptime+p_perf_time2;
 																							}
 																						}
 																						else{
-																							if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																								nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																							if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																								nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																							}
 																							else{
 																								nextstoptime = nextstoptime+p_perf_time2;
@@ -15353,14 +16330,14 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																						int p_eta;
-																						if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																						if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																							p_eta = previouseta;
 																						}
 																						else{
-																							p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																							p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																						}
 
-																						nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																						nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																						if (pDisability3.find("LP",0) != string::npos){
@@ -15404,10 +16381,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						}
 																						bool preassigntripchange = true;
 
-																						int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																						int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																						int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																						int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																						if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																							endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																							endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																						}
 																						string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -15418,7 +16395,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																								if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																								{
 																									int dev =  p_eta - (starttime1 + aLatepickup);
-																									if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																									if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																										preassigntripchange = true;
 																									}
 
@@ -15431,7 +16408,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																								if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																								{
 																									int dev =  p_eta - (endtime1);
-																									if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																									if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																										preassigntripchange = true;
 																									}
 																								}
@@ -15444,7 +16421,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																								if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																								if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																									isLate = true;
 																									break;
 																								}
@@ -15455,12 +16432,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							}
 																							else{
 
-																								if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																								if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																									isLate = true;
 																									break;
 																								}
 																								else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																									if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																									if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																										isLate = true;
 																										break;}
 																								}
@@ -15499,10 +16476,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -15526,17 +16503,17 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 
-																					int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																					int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																					int doeta1 = trav_time;
 																					int actualTT = doeta1 - puetd1;
-																					if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																					if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																					string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																					string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																					double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																					string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																					string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																					string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																					string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																					double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																					string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																					string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -15548,26 +16525,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					int groupcnter = 1;
 																					routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																					//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																					for (int i = 0; i < MAXSEGMENTS; i++)
-																					{
-																						if (s_tab[i][0] == routeint)
-																						{
-																							for (int g = 1; g < MAXSTOPS; g++)
-																							{
-																								if (s_tab[i][g] == s_tab[m][k-1])
-																								{
-
-																									while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																										groupcnter++;
-																										g--;
-																									}
-																									//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																									break;
-																								}
-																							}
-																							break;
-																						}
-																					}
+																					groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																					groupcnter = groupcnter + groupnumber;
 																					int aAllowedTT;
 
@@ -15594,24 +16552,24 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																				}
-																				int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																				int segstart = (int)tripNumber(s_tab[m][1], 4);
 																				int segend;
 																				for (int g = 1; g < MAXSTOPS; g++)
 																				{
 																					if (s_tab[m][g] == 0)
 																					{
-																						segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																						segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																						break;
 
 																					}
 																				}
 																				int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																				int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																				int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																				timethreshold = segend - timethreshold;
 																				bool docalc = true;
 
-																				if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																				if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																						|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																				){
 
@@ -15629,12 +16587,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																					if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																						if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																						if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																							pudev = getCost(pickupafterstop,puid);
 																							dodev = getCost(doid,  dropoffafterstop);
 																						}
 																						else{
-																							pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																							pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																							dodev = pudev;
 
 																						}
@@ -15647,7 +16605,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																					docalc = false;
 
-																					if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																					if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																						double distpu =  getCost(tripidx, s_tab[m][k]);
 																						double distdo = getCost(tripidx+1, s_tab[m][k]);
 																						if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -15655,10 +16613,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						}
 																						double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																						if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																						if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																							if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																							distpu = 0;
-																							if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																							if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																								if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																								//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																									distdo = 0;
@@ -15669,7 +16627,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																								if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																								docalc = true;
 																							}
-																							else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																							else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																								if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																								docalc = true;
 																							}
@@ -15679,12 +16637,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																						if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																							if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																							if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																								pudev = getCost(pickupafterstop,puid);
 																								dodev = getCost(doid,  dropoffafterstop);
 																							}
 																							else{
-																								pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																								pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																								dodev = pudev;
 
 																							}
@@ -15694,7 +16652,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							dodev = 0;
 																						}
 
-																						if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																						if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																							if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																							docalc = true;
 
@@ -15722,7 +16680,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																					set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																					if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																					if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																					if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																						AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -15804,16 +16762,16 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																					if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																						if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																							nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																						if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																							nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																						}
 																						else{
 																							nextstoptime = nextstoptime+p_perf_time2;
 																						}
 																					}
 																					else{
-																						if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																							nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																						if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																							nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																						}
 																						else{
 																							nextstoptime = nextstoptime+p_perf_time2;
@@ -15821,14 +16779,14 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					}
 
 																					int p_eta;
-																					if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																					if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																						p_eta = previouseta;
 																					}
 																					else{
-																						p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																						p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																					}
 
-																					nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																					nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																					if (pDisability3.find("LP",0) != string::npos){
@@ -15872,10 +16830,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					}
 																					bool preassigntripchange = true;
 
-																					int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																					int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																					int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																					int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																					if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																						endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																						endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																					}
 																					string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -15886,7 +16844,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																							{
 																								int dev =  p_eta - (starttime1 + aLatepickup);
-																								if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																								if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																									preassigntripchange = true;
 																								}
 
@@ -15899,7 +16857,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																							if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																							{
 																								int dev =  p_eta - (endtime1);
-																								if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																								if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																									preassigntripchange = true;
 																								}
 																							}
@@ -15912,7 +16870,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																							if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																							if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																								isLate = true;
 																								break;
 																							}
@@ -15923,12 +16881,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						}
 																						else{
 
-																							if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																							if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																								isLate = true;
 																								break;
 																							}
 																							else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																								if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																								if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																									isLate = true;
 																									break;}
 																							}
@@ -15967,10 +16925,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -16035,41 +16993,41 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 															else{
 																est_time =  (int)to_number(endtime1) - (int)to_number(est_traveltime1);
 															}
-															int trav_time =   (int)to_number(schd_tab[s_tab[m][k-1]][30]) + getTravTime_passedEta(s_tab[m][k-1],tripidx, to_string(est_time),"0");
-															int tripstarttime = (int)to_number(schd_tab[tripidx][26]);
+															int trav_time =   forwardslack.route.departure(k-1) + getTravTime_passedEta(s_tab[m][k-1],tripidx, to_string(est_time),"0");
+															int tripstarttime = (int)tripNumber(tripidx, 26);
 
 															if (trav_time < tripstarttime + aLatepickup + floor((RELAXCONSTRAINTS[0] - 1)*50) && tripstarttime > 0){
 
 																//  if(DEBUG == 1) gse << "trav time  = " << trav_time << " etd " << (int)to_number(schd_tab[s_tab[m][k-1]][30]) << endl;
 
 
-																if(trav_time < to_number(schd_tab[tripidx][26])  - aEarlypickup && to_number(schd_tab[tripidx][26])!= 0 ){
+																if(trav_time < tripNumber(tripidx, 26)  - aEarlypickup && tripNumber(tripidx, 26)!= 0 ){
 																	//  if(DEBUG == 1) gse <<" using 1 " << schd_tab[tripidx][26] << endl;
-																	trav_time = to_number(schd_tab[tripidx][26]) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
+																	trav_time = tripNumber(tripidx, 26) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
 																}
-																else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlypickup && to_number(schd_tab[tripidx][26])== 0 ){
+																else if(trav_time < tripNumber(tripidx, 4) - aEarlypickup && tripNumber(tripidx, 26)== 0 ){
 																	//  if(DEBUG == 1) gse <<" using 2 " << schd_tab[tripidx][4] << endl;
-																	trav_time =  to_number(schd_tab[tripidx][4])  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
+																	trav_time =  tripNumber(tripidx, 4)  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																}
 																else{
 																	//  if(DEBUG == 1) gse <<" none " << trav_time  << endl;
 																	trav_time =  trav_time + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																}
 
-																if (to_number(schd_tab[tripidx][27]) > 0)
-																{if(DEBUG == 1) gse << "End time of trip " << to_number(schd_tab[tripidx][27])  << " trav time " << trav_time << endl;
-																if (trav_time > to_number(schd_tab[tripidx][27]) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
+																if (tripNumber(tripidx, 27) > 0)
+																{if(DEBUG == 1) gse << "End time of trip " << tripNumber(tripidx, 27)  << " trav time " << trav_time << endl;
+																if (trav_time > tripNumber(tripidx, 27) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
 																{
 																	continue;
 																}
 
 																}
 
-																if(trav_time < to_number(schd_tab[tripidx][27])  - aEarlydropoff && to_number(schd_tab[tripidx][27])!= 0 ){
-																	trav_time = to_number(schd_tab[tripidx][27]) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
+																if(trav_time < tripNumber(tripidx, 27)  - aEarlydropoff && tripNumber(tripidx, 27)!= 0 ){
+																	trav_time = tripNumber(tripidx, 27) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
 																}
-																else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlydropoff  && to_number(schd_tab[tripidx][27])== 0 ){
-																	trav_time =  to_number(schd_tab[tripidx][4])  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
+																else if(trav_time < tripNumber(tripidx, 4) - aEarlydropoff  && tripNumber(tripidx, 27)== 0 ){
+																	trav_time =  tripNumber(tripidx, 4)  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
 																}
 
 
@@ -16082,23 +17040,23 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																if(endofsegtime > 0  ){
 
-																	if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																	if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50) && insertionDelayFits(forwardslack, k, trav_time)){
 
 																		if(strcmp(schd_tab[s_tab[m][k]][7],"D")==0  /*&& strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*//*&& strcmp(schd_tab[pickupafterstop][7],"P")==0 && strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*/ && strcmp(schd_tab[s_tab[m][k]][3],schd_tab[s_tab[m][k]][0])!=0){
 
 
 
-																			int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																			int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																			int doeta1 = trav_time;
 																			int actualTT = doeta1 - puetd1;
-																			if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																			if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																			string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																			string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																			double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																			string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																			string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																			string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																			string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																			double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																			string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																			string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -16110,26 +17068,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																			int groupcnter = 1;
 																			routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																			//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																			for (int i = 0; i < MAXSEGMENTS; i++)
-																			{
-																				if (s_tab[i][0] == routeint)
-																				{
-																					for (int g = 1; g < MAXSTOPS; g++)
-																					{
-																						if (s_tab[i][g] == s_tab[m][k-1])
-																						{
-
-																							while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																								groupcnter++;
-																								g--;
-																							}
-																							//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																							break;
-																						}
-																					}
-																					break;
-																				}
-																			}
+																			groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																			groupcnter = groupcnter + groupnumber;
 																			int aAllowedTT;
 
@@ -16155,24 +17094,24 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																		}
-																		int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																		int segstart = (int)tripNumber(s_tab[m][1], 4);
 																		int segend;
 																		for (int g = 1; g < MAXSTOPS; g++)
 																		{
 																			if (s_tab[m][g] == 0)
 																			{
-																				segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																				segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																				break;
 
 																			}
 																		}
 																		int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																		int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																		int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																		timethreshold = segend - timethreshold;
 																		bool docalc = true;
 
-																		if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																		if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																				|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																		){
 
@@ -16190,12 +17129,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																			double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																			if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																				if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																				if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																					pudev = getCost(pickupafterstop,puid);
 																					dodev = getCost(doid,  dropoffafterstop);
 																				}
 																				else{
-																					pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																					pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																					dodev = pudev;
 
 																				}
@@ -16208,7 +17147,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 																			docalc = false;
 
-																			if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																			if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																				double distpu =  getCost(tripidx, s_tab[m][k]);
 																				double distdo = getCost(tripidx+1, s_tab[m][k]);
 																				if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -16216,10 +17155,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																				}
 																				double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																				if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																				if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																					if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																					distpu = 0;
-																					if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																					if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																						if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																						//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																							distdo = 0;
@@ -16230,7 +17169,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																						if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																						docalc = true;
 																					}
-																					else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																					else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																						if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																						docalc = true;
 																					}
@@ -16240,12 +17179,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																				double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																				if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																					if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																					if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																						pudev = getCost(pickupafterstop,puid);
 																						dodev = getCost(doid,  dropoffafterstop);
 																					}
 																					else{
-																						pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																						pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																						dodev = pudev;
 
 																					}
@@ -16255,7 +17194,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					dodev = 0;
 																				}
 
-																				if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																				if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																					if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																					docalc = true;
 
@@ -16283,7 +17222,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																			string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																			set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																			if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																			if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																			if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																				AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -16365,30 +17304,30 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 
 
 																			if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																				if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																					nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																				if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																					nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																				}
 																				else{
 																					nextstoptime = nextstoptime+p_perf_time2;
 																				}
 																			}
 																			else{
-																				if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																					nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																				if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																					nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																				}
 																				else{
 																					nextstoptime = nextstoptime+p_perf_time2;
 																				}
 																			}
 																			int p_eta;
-																			if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																			if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																				p_eta = previouseta;
 																			}
 																			else{
-																				p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																				p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																			}
 
-																			nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																			nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																			if (pDisability3.find("LP",0) != string::npos){
@@ -16432,10 +17371,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																			}
 																			bool preassigntripchange = true;
 
-																			int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																			int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																			int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																			int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																			if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																				endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																				endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																			}
 																			string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -16446,7 +17385,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																					{
 																						int dev =  p_eta - (starttime1 + aLatepickup);
-																						if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																						if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																							preassigntripchange = true;
 																						}
 
@@ -16459,7 +17398,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																					if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																					{
 																						int dev =  p_eta - (endtime1);
-																						if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																						if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																							preassigntripchange = true;
 																						}
 																					}
@@ -16471,7 +17410,7 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																				if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																						isLate = true;
 																						break;
 																					}
@@ -16482,12 +17421,12 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
 																				}
 																				else{
 
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																						isLate = true;
 																						break;
 																					}
 																					else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																						if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																						if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																							isLate = true;
 																							break;}
 																					}
@@ -16526,10 +17465,10 @@ int searchonetimeslotclustermatch(string route, string wc,string inslack, int ti
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -16549,17 +17488,17 @@ tripidxcnt++;continue;
 
 
 
-																		int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																		int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																		int doeta1 = trav_time;
 																		int actualTT = doeta1 - puetd1;
-																		if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																		if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																		string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																		string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																		double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																		string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																		string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																		string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																		string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																		double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																		string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																		string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -16571,26 +17510,7 @@ tripidxcnt++;continue;
 																		int groupcnter = 1;
 																		routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																		//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																		for (int i = 0; i < MAXSEGMENTS; i++)
-																		{
-																			if (s_tab[i][0] == routeint)
-																			{
-																				for (int g = 1; g < MAXSTOPS; g++)
-																				{
-																					if (s_tab[i][g] == s_tab[m][k-1])
-																					{
-
-																						while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																							groupcnter++;
-																							g--;
-																						}
-																						//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																						break;
-																					}
-																				}
-																				break;
-																			}
-																		}
+																		groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																		groupcnter = groupcnter + groupnumber;
 																		int aAllowedTT;
 
@@ -16617,24 +17537,24 @@ tripidxcnt++;continue;
 
 
 																	}
-																	int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																	int segstart = (int)tripNumber(s_tab[m][1], 4);
 																	int segend;
 																	for (int g = 1; g < MAXSTOPS; g++)
 																	{
 																		if (s_tab[m][g] == 0)
 																		{
-																			segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																			segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																			break;
 
 																		}
 																	}
 																	int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																	int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																	int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																	timethreshold = segend - timethreshold;
 																	bool docalc = true;
 
-																	if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																	if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																			|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																	){
 
@@ -16652,12 +17572,12 @@ tripidxcnt++;continue;
 																		double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																		if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																			if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																			if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																				pudev = getCost(pickupafterstop,puid);
 																				dodev = getCost(doid,  dropoffafterstop);
 																			}
 																			else{
-																				pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																				pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																				dodev = pudev;
 
 																			}
@@ -16670,7 +17590,7 @@ tripidxcnt++;continue;
 
 																		docalc = false;
 
-																		if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																		if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																			double distpu =  getCost(tripidx, s_tab[m][k]);
 																			double distdo = getCost(tripidx+1, s_tab[m][k]);
 																			if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -16678,10 +17598,10 @@ tripidxcnt++;continue;
 																			}
 																			double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																			if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																			if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																				if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																				distpu = 0;
-																				if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																				if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																					if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																					//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																						distdo = 0;
@@ -16692,7 +17612,7 @@ tripidxcnt++;continue;
 																					if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																					docalc = true;
 																				}
-																				else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																				else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																					if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																					docalc = true;
 																				}
@@ -16702,12 +17622,12 @@ tripidxcnt++;continue;
 																			double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																			if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																				if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																				if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																					pudev = getCost(pickupafterstop,puid);
 																					dodev = getCost(doid,  dropoffafterstop);
 																				}
 																				else{
-																					pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																					pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																					dodev = pudev;
 
 																				}
@@ -16717,7 +17637,7 @@ tripidxcnt++;continue;
 																				dodev = 0;
 																			}
 
-																			if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																			if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																				if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																				docalc = true;
 
@@ -16745,7 +17665,7 @@ tripidxcnt++;continue;
 																		string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																		set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																		if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																		if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																		if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																			AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -16827,16 +17747,16 @@ tripidxcnt++;continue;
 
 
 																		if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																			if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																				nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																			if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																				nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																			}
 																			else{
 																				nextstoptime = nextstoptime+p_perf_time2;
 																			}
 																		}
 																		else{
-																			if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																				nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																			if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																				nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																			}
 																			else{
 																				nextstoptime = nextstoptime+p_perf_time2;
@@ -16844,14 +17764,14 @@ tripidxcnt++;continue;
 																		}
 
 																		int p_eta;
-																		if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																		if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																			p_eta = previouseta;
 																		}
 																		else{
-																			p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																			p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																		}
 
-																		nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																		nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																		if (pDisability3.find("LP",0) != string::npos){
@@ -16895,10 +17815,10 @@ tripidxcnt++;continue;
 																		}
 																		bool preassigntripchange = true;
 
-																		int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																		int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																		int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																		int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																		if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																			endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																			endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																		}
 																		string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -16909,7 +17829,7 @@ tripidxcnt++;continue;
 																				if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																				{
 																					int dev =  p_eta - (starttime1 + aLatepickup);
-																					if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																					if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																						preassigntripchange = true;
 																					}
 
@@ -16922,7 +17842,7 @@ tripidxcnt++;continue;
 																				if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																				{
 																					int dev =  p_eta - (endtime1);
-																					if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																					if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																						preassigntripchange = true;
 																					}
 																				}
@@ -16932,7 +17852,7 @@ tripidxcnt++;continue;
 																		if(preassigntripchange){
 																			if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
-																				if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																				if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																					isLate = true;
 																					break;
 																				}
@@ -16943,12 +17863,12 @@ tripidxcnt++;continue;
 																			}
 																			else{
 
-																				if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																				if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																					isLate = true;
 																					break;
 																				}
 																				else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																						isLate = true;
 																						break;}
 																				}
@@ -16987,10 +17907,10 @@ tripidxcnt++;continue;
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -17006,20 +17926,20 @@ tripidxcnt++;continue;
 															}
 															else if(tripstarttime == 0) {
 																if(DEBUG == 1) gse << "no start time " << endl;
-																if(trav_time < to_number(schd_tab[tripidx][26])  - aEarlypickup && to_number(schd_tab[tripidx][26])!= 0 ){
-																	trav_time = to_number(schd_tab[tripidx][26]) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
+																if(trav_time < tripNumber(tripidx, 26)  - aEarlypickup && tripNumber(tripidx, 26)!= 0 ){
+																	trav_time = tripNumber(tripidx, 26) - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0"); // + (int)to_number(schd_tab[tripidx][22]);
 																}
-																else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlypickup && to_number(schd_tab[tripidx][26])== 0 ){
-																	trav_time =  to_number(schd_tab[tripidx][4])  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
+																else if(trav_time < tripNumber(tripidx, 4) - aEarlypickup && tripNumber(tripidx, 26)== 0 ){
+																	trav_time =  tripNumber(tripidx, 4)  - aEarlypickup + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																}
 																else{
 																	trav_time =  trav_time + extraperftime + p_perf_time + getTravTime_passedEta(tripidx, tripidx+1, to_string(est_time),"0");// (int)to_number(schd_tab[tripidx][22]);
 																}
 
-																if (to_number(schd_tab[tripidx][27]) > 0)
+																if (tripNumber(tripidx, 27) > 0)
 																{
-																	if(DEBUG == 1) gse << "End time of trip " << to_number(schd_tab[tripidx][27])  << " trav time " << trav_time << endl;
-																	if (trav_time > to_number(schd_tab[tripidx][27]) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
+																	if(DEBUG == 1) gse << "End time of trip " << tripNumber(tripidx, 27)  << " trav time " << trav_time << endl;
+																	if (trav_time > tripNumber(tripidx, 27) + floor((RELAXCONSTRAINTS[0] - 1)*50) )
 																	{
 																		continue;
 																	}
@@ -17027,11 +17947,11 @@ tripidxcnt++;continue;
 																}
 
 
-																if(trav_time < to_number(schd_tab[tripidx][27])  - aEarlydropoff && to_number(schd_tab[tripidx][27])!= 0 ){
-																	trav_time = to_number(schd_tab[tripidx][27]) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
+																if(trav_time < tripNumber(tripidx, 27)  - aEarlydropoff && tripNumber(tripidx, 27)!= 0 ){
+																	trav_time = tripNumber(tripidx, 27) - aEarlydropoff + p_perf_time; // + (int)to_number(schd_tab[tripidx][22]);
 																}
-																else if(trav_time < to_number(schd_tab[tripidx][4]) - aEarlydropoff  && to_number(schd_tab[tripidx][27])== 0 ){
-																	trav_time =  to_number(schd_tab[tripidx][4])  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
+																else if(trav_time < tripNumber(tripidx, 4) - aEarlydropoff  && tripNumber(tripidx, 27)== 0 ){
+																	trav_time =  tripNumber(tripidx, 4)  - aEarlydropoff + p_perf_time;// (int)to_number(schd_tab[tripidx][22]);
 																}
 
 																if((int)to_number(endtime1)!= 0)
@@ -17043,23 +17963,23 @@ tripidxcnt++;continue;
 
 																if(endofsegtime > 0  ){
 
-																	if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																	if(trav_time <= endofsegtime + floor((RELAXCONSTRAINTS[0] - 1)*50) && insertionDelayFits(forwardslack, k, trav_time)){
 
 																		if(strcmp(schd_tab[s_tab[m][k]][7],"D")==0  /*&& strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*//*&& strcmp(schd_tab[pickupafterstop][7],"P")==0 && strcmp(schd_tab[pickupafterstop][3],schd_tab[do_aftershmid][3])==0*/ && strcmp(schd_tab[s_tab[m][k]][3],schd_tab[s_tab[m][k]][0])!=0){
 
 
 
-																			int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																			int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																			int doeta1 = trav_time;
 																			int actualTT = doeta1 - puetd1;
-																			if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																			if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																			string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																			string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																			double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																			string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																			string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																			string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																			string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																			double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																			string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																			string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -17071,26 +17991,7 @@ tripidxcnt++;continue;
 																			int groupcnter = 1;
 																			routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																			//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																			for (int i = 0; i < MAXSEGMENTS; i++)
-																			{
-																				if (s_tab[i][0] == routeint)
-																				{
-																					for (int g = 1; g < MAXSTOPS; g++)
-																					{
-																						if (s_tab[i][g] == s_tab[m][k-1])
-																						{
-
-																							while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																								groupcnter++;
-																								g--;
-																							}
-																							//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																							break;
-																						}
-																					}
-																					break;
-																				}
-																			}
+																			groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																			groupcnter = groupcnter + groupnumber;
 																			int aAllowedTT;
 
@@ -17118,24 +18019,24 @@ tripidxcnt++;continue;
 
 
 																		}
-																		int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																		int segstart = (int)tripNumber(s_tab[m][1], 4);
 																		int segend;
 																		for (int g = 1; g < MAXSTOPS; g++)
 																		{
 																			if (s_tab[m][g] == 0)
 																			{
-																				segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																				segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																				break;
 
 																			}
 																		}
 																		int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																		int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																		int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																		timethreshold = segend - timethreshold;
 																		bool docalc = true;
 
-																		if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																		if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																				|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																		){
 
@@ -17153,12 +18054,12 @@ tripidxcnt++;continue;
 																			double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																			if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																				if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																				if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																					pudev = getCost(pickupafterstop,puid);
 																					dodev = getCost(doid,  dropoffafterstop);
 																				}
 																				else{
-																					pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																					pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																					dodev = pudev;
 
 																				}
@@ -17171,7 +18072,7 @@ tripidxcnt++;continue;
 
 																			docalc = false;
 
-																			if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																			if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																				double distpu =  getCost(tripidx, s_tab[m][k]);
 																				double distdo = getCost(tripidx+1, s_tab[m][k]);
 																				if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -17179,10 +18080,10 @@ tripidxcnt++;continue;
 																				}
 																				double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																				if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																				if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																					if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																					distpu = 0;
-																					if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																					if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																						if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																						//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																							distdo = 0;
@@ -17193,7 +18094,7 @@ tripidxcnt++;continue;
 																						if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																						docalc = true;
 																					}
-																					else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																					else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																						if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																						docalc = true;
 																					}
@@ -17203,12 +18104,12 @@ tripidxcnt++;continue;
 																				double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																				if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																					if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																					if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																						pudev = getCost(pickupafterstop,puid);
 																						dodev = getCost(doid,  dropoffafterstop);
 																					}
 																					else{
-																						pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																						pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																						dodev = pudev;
 
 																					}
@@ -17218,7 +18119,7 @@ tripidxcnt++;continue;
 																					dodev = 0;
 																				}
 
-																				if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																				if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																					if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																					docalc = true;
 
@@ -17247,7 +18148,7 @@ tripidxcnt++;continue;
 																			string pDisposition = schd_tab[s_tab[m][w]][DISPOSITION];
 																			set_p_perf_time(pDisposition,pDisability2,p_perf_time2,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
 
-																			if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																			if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 																			if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
 
 																				AGRPCOUNTER = AGRPCOUNTER + 1;
@@ -17329,16 +18230,16 @@ tripidxcnt++;continue;
 
 
 																			if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																				if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																					nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																				if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																					nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																				}
 																				else{
 																					nextstoptime = nextstoptime+p_perf_time2;
 																				}
 																			}
 																			else{
-																				if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																					nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																				if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																					nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																				}
 																				else{
 																					nextstoptime = nextstoptime+p_perf_time2;
@@ -17346,14 +18247,14 @@ tripidxcnt++;continue;
 																			}
 
 																			int p_eta;
-																			if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																			if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																				p_eta = previouseta;
 																			}
 																			else{
-																				p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																				p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																			}
 
-																			nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																			nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																			if (pDisability3.find("LP",0) != string::npos){
@@ -17397,10 +18298,10 @@ tripidxcnt++;continue;
 																			}
 																			bool preassigntripchange = true;
 
-																			int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																			int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																			int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																			int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																			if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																				endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																				endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																			}
 																			string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -17411,7 +18312,7 @@ tripidxcnt++;continue;
 																					if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																					{
 																						int dev =  p_eta - (starttime1 + aLatepickup);
-																						if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																						if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																							preassigntripchange = true;
 																						}
 
@@ -17424,7 +18325,7 @@ tripidxcnt++;continue;
 																					if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																					{
 																						int dev =  p_eta - (endtime1);
-																						if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																						if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																							preassigntripchange = true;
 																						}
 																					}
@@ -17436,7 +18337,7 @@ tripidxcnt++;continue;
 																				if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																						isLate = true;
 																						break;
 																					}
@@ -17447,12 +18348,12 @@ tripidxcnt++;continue;
 																				}
 																				else{
 
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																						isLate = true;
 																						break;
 																					}
 																					else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																						if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																						if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																							isLate = true;
 																							break;}
 																					}
@@ -17491,10 +18392,10 @@ tripidxcnt++;continue;
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -17515,17 +18416,17 @@ tripidxcnt++;continue;
 
 
 
-																		int puetd1 = (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][30]);
+																		int puetd1 = (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 30);
 																		int doeta1 = trav_time;
 																		int actualTT = doeta1 - puetd1;
-																		if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][3] << " " << actualTT << endl;
+																		if(DEBUG == 1) gse << "estimated travel time " << schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][3] << " " << actualTT << endl;
 
 
-																		string p_disability = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][12];
-																		string p_trip_type = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][8];
-																		double estdisttrip = to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][21]);
-																		string est_traveltime1 = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][22];
-																		string p_returntrip = schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][18];
+																		string p_disability = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][12];
+																		string p_trip_type = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][8];
+																		double estdisttrip = tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 21);
+																		string est_traveltime1 = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][22];
+																		string p_returntrip = schd_tab[(int)tripNumber(s_tab[m][k], PICKUPIDX)][18];
 
 
 
@@ -17537,26 +18438,7 @@ tripidxcnt++;continue;
 																		int groupcnter = 1;
 																		routeint = (int)to_number(a_route.substr(1, a_route.length()));
 																		//    if(DEBUG == 1) gse << a_route << " " << routeint << endl;
-																		for (int i = 0; i < MAXSEGMENTS; i++)
-																		{
-																			if (s_tab[i][0] == routeint)
-																			{
-																				for (int g = 1; g < MAXSTOPS; g++)
-																				{
-																					if (s_tab[i][g] == s_tab[m][k-1])
-																					{
-
-																						while(g >=2 && strcmp(schd_tab[s_tab[i][g]][7],"P")==0 && strcmp(schd_tab[s_tab[i][g]][3],schd_tab[s_tab[i][g]][0])!=0 ){
-																							groupcnter++;
-																							g--;
-																						}
-																						//   if(DEBUG == 1) gse << " Pick up after stop " << schd_tab[pickupafterstop][31] << " " << schd_tab[pickupafterstop][3] << " " << schd_tab[pickupafterstop][2] << endl;
-																						break;
-																					}
-																				}
-																				break;
-																			}
-																		}
+																		groupcnter = groupcnter + groupedPickupsBefore(routeint, s_tab[m][k-1]);
 																		groupcnter = groupcnter + groupnumber;
 																		int aAllowedTT;
 
@@ -17583,24 +18465,24 @@ tripidxcnt++;continue;
 
 
 																	}
-																	int segstart = (int)to_number(schd_tab[s_tab[m][1]][4]);
+																	int segstart = (int)tripNumber(s_tab[m][1], 4);
 																	int segend;
 																	for (int g = 1; g < MAXSTOPS; g++)
 																	{
 																		if (s_tab[m][g] == 0)
 																		{
-																			segend = (int)to_number(schd_tab[s_tab[m][g-1]][4]);
+																			segend = (int)tripNumber(s_tab[m][g-1], 4);
 
 																			break;
 
 																		}
 																	}
 																	int timethreshold = (segend - segstart)*HEADHOMETHRESHOLD[0];
-																	int triptimethreshold = ((int)to_number(schd_tab[tripidx][4]));
+																	int triptimethreshold = ((int)tripNumber(tripidx, 4));
 																	timethreshold = segend - timethreshold;
 																	bool docalc = true;
 
-																	if(((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 )
+																	if((forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 )
 																			|| ((/*timethreshold > actualslack ||*/ triptimethreshold > timethreshold)  && strcmp(schd_tab[s_tab[m][k]][7],"D")==0 && strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0)
 																	){
 
@@ -17618,12 +18500,12 @@ tripidxcnt++;continue;
 																		double dodev; int pickupafterstop = s_tab[m][k-1]; int dropoffafterstop = s_tab[m][k]; int puid = tripidx; int doid = tripidx+1;
 
 																		if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																			if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																			if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																				pudev = getCost(pickupafterstop,puid);
 																				dodev = getCost(doid,  dropoffafterstop);
 																			}
 																			else{
-																				pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																				pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																				dodev = pudev;
 
 																			}
@@ -17636,7 +18518,7 @@ tripidxcnt++;continue;
 
 																		docalc = false;
 
-																		if((int)to_number(schd_tab[s_tab[m][k-1]][31]) != 0 ||  (int)to_number(schd_tab[s_tab[m][k-1]][32])!= 0 ){
+																		if(forwardslack.route.load(k-1, SLACKAMB) != 0 ||  forwardslack.route.load(k-1, SLACKWC)!= 0 ){
 																			double distpu =  getCost(tripidx, s_tab[m][k]);
 																			double distdo = getCost(tripidx+1, s_tab[m][k]);
 																			if(isSameLocation(tripidx+1,s_tab[m][k])){
@@ -17644,10 +18526,10 @@ tripidxcnt++;continue;
 																			}
 																			double cost = getCost(tripidx, s_tab[m][k-1]);
 
-																			if(cost <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
+																			if(cost <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || cost<= maxdeviationfromstop_slack){
 																				if(DEBUG == 1) gse << "There's an allowed deadhead here 2 " << endl;
 																				distpu = 0;
-																				if(distdo <= to_number(schd_tab[s_tab[m][k-1]][6])*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
+																				if(distdo <= tripNumber(s_tab[m][k-1], 6)*outsideofellipsevar || distdo<= maxdeviationfromstop_slack){
 																					if(DEBUG == 1) gse << "There's an allowed deadhead for the dropoff too" << endl;
 																					//if(strcmp(schd_tab[pickupafterstop][2],"1")==0 && strcmp(schd_tab[dropoffafterstop][7],"D")==0 && strcmp(schd_tab[dropoffafterstop][2],MAXSTOPNUM[0])==0){
 																						distdo = 0;
@@ -17658,7 +18540,7 @@ tripidxcnt++;continue;
 																					if(DEBUG == 1) gse << "We are within the ellipse because it is an empty segment " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																					docalc = true;
 																				}
-																				else if (to_number(schd_tab[s_tab[m][k-1]][6]) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0]  && (distdo/to_number(schd_tab[s_tab[m][k-1]][6])) <= MAXDEADHEADVARIANCE[0] ){
+																				else if (tripNumber(s_tab[m][k-1], 6) > 0.0 &&   pudev <= threshold && dodev <= threshold  && (distpu/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0]  && (distdo/tripNumber(s_tab[m][k-1], 6)) <= MAXDEADHEADVARIANCE[0] ){
 																					if(DEBUG == 1) gse << "We are within the ellipse  " << distpu << " " << distdo << " " <<  schd_tab[s_tab[m][k-1]][6] << endl;
 																					docalc = true;
 																				}
@@ -17668,12 +18550,12 @@ tripidxcnt++;continue;
 																			double distdo = getCost(tripidx+1, s_tab[m][k]);
 
 																			if(!isSameLocation(pickupafterstop,dropoffafterstop)){
-																				if((int)to_number(schd_tab[dropoffafterstop][2])==(int)to_number(MAXSTOPNUM[0])){
+																				if((int)tripNumber(dropoffafterstop, 2)==(int)to_number(MAXSTOPNUM[0])){
 																					pudev = getCost(pickupafterstop,puid);
 																					dodev = getCost(doid,  dropoffafterstop);
 																				}
 																				else{
-																					pudev = getCost(pickupafterstop,puid) + (int)to_number(schd_tab[puid][21]) + getCost(doid,dropoffafterstop) - to_number(schd_tab[pickupafterstop][6]);
+																					pudev = getCost(pickupafterstop,puid) + (int)tripNumber(puid, 21) + getCost(doid,dropoffafterstop) - tripNumber(pickupafterstop, 6);
 																					dodev = pudev;
 
 																				}
@@ -17683,7 +18565,7 @@ tripidxcnt++;continue;
 																				dodev = 0;
 																			}
 
-																			if ((distdo/to_number(schd_tab[pickupafterstop][6])) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
+																			if ((distdo/tripNumber(pickupafterstop, 6)) <= MAXDEADHEADVARIANCE[0] &&  pudev <= threshold && dodev <= threshold ){
 																				if(DEBUG == 1) gse << "We are heading in the right direction "<<  endl;
 																				docalc = true;
 
@@ -17714,7 +18596,7 @@ tripidxcnt++;continue;
 
 
 
-																		if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)to_number(schd_tab[s_tab[m][w-1]][CALCULATEDTIME]);
+																		if (w != 1 && w+1 != 0) { int timetonextstop2 = (int)tripNumber(s_tab[m][w-1], CALCULATEDTIME);
 
 
 																		if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[m][w]][7],schd_tab[s_tab[m][w-1]][7])==0)
@@ -17798,16 +18680,16 @@ tripidxcnt++;continue;
 
 
 																		if(strcmp(schd_tab[s_tab[m][w]][7],"P")==0){
-																			if(nextstoptime < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup){
-																				nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlypickup + p_perf_time2;
+																			if(nextstoptime < (int)tripNumber(s_tab[m][w], 4) - aEarlypickup){
+																				nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlypickup + p_perf_time2;
 																			}
 																			else{
 																				nextstoptime = nextstoptime+p_perf_time2;
 																			}
 																		}
 																		else{
-																			if(nextstoptime +  p_perf_time2 < (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff){
-																				nextstoptime = (int)to_number(schd_tab[s_tab[m][w]][4]) - aEarlydropoff + p_perf_time2;
+																			if(nextstoptime +  p_perf_time2 < (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff){
+																				nextstoptime = (int)tripNumber(s_tab[m][w], 4) - aEarlydropoff + p_perf_time2;
 																			}
 																			else{
 																				nextstoptime = nextstoptime+p_perf_time2;
@@ -17815,14 +18697,14 @@ tripidxcnt++;continue;
 																		}
 
 																		int p_eta;
-																		if((int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]) == 0){
+																		if((int)tripNumber(s_tab[t][w], CALCULATEDTIME) == 0){
 																			p_eta = previouseta;
 																		}
 																		else{
-																			p_eta = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																			p_eta = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 																		}
 
-																		nextstoptime = nextstoptime + (int)to_number(schd_tab[s_tab[t][w]][CALCULATEDTIME]);
+																		nextstoptime = nextstoptime + (int)tripNumber(s_tab[t][w], CALCULATEDTIME);
 
 
 																		if (pDisability3.find("LP",0) != string::npos){
@@ -17866,10 +18748,10 @@ tripidxcnt++;continue;
 
 																		bool preassigntripchange = true;
 
-																		int starttime1  = (int)to_number(schd_tab[s_tab[m][w+1]][26]);
-																		int endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][27]);
+																		int starttime1  = (int)tripNumber(s_tab[m][w+1], 26);
+																		int endtime1  = (int)tripNumber(s_tab[m][w+1], 27);
 																		if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																			endtime1  = (int)to_number(schd_tab[s_tab[m][w+1]][4]);
+																			endtime1  = (int)tripNumber(s_tab[m][w+1], 4);
 																		}
 																		string p_stop_type = schd_tab[s_tab[m][w+1]][7];
 
@@ -17880,7 +18762,7 @@ tripidxcnt++;continue;
 																				if( p_eta  > starttime1 + aLatepickup +floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 																				{
 																					int dev =  p_eta - (starttime1 + aLatepickup);
-																					if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																					if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																						preassigntripchange = true;
 																					}
 
@@ -17893,7 +18775,7 @@ tripidxcnt++;continue;
 																				if((p_eta > endtime1 +floor((RELAXCONSTRAINTS[0] - 1)*50)))
 																				{
 																					int dev =  p_eta - (endtime1);
-																					if(dev > (int)to_number(schd_tab[s_tab[m][w+1]][LATEDEVIATION])){
+																					if(dev > (int)tripNumber(s_tab[m][w+1], LATEDEVIATION)){
 																						preassigntripchange = true;
 																					}
 																				}
@@ -17905,7 +18787,7 @@ tripidxcnt++;continue;
 																			if(strcmp(schd_tab[s_tab[m][w+1]][7],"P")==0){
 
 
-																				if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)to_number(schd_tab[s_tab[m][w+1]][26])!=0){
+																				if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+aLatepickup+floor((RELAXCONSTRAINTS[0] - 1)*50) && (int)tripNumber(s_tab[m][w+1], 26)!=0){
 																					isLate = true;
 																					break;
 																				}
@@ -17916,12 +18798,12 @@ tripidxcnt++;continue;
 																			}
 																			else{
 
-																				if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)to_number(schd_tab[s_tab[m][w+1]][27])!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
+																				if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50) &&  (int)tripNumber(s_tab[m][w+1], 27)!=0 && strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])!=0){
 																					isLate = true;
 																					break;
 																				}
 																				else if(strcmp(schd_tab[s_tab[m][w+1]][2],MAXSTOPNUM[0])==0){
-																					if(p_eta > (int)to_number(schd_tab[s_tab[m][w+1]][4])+floor((RELAXCONSTRAINTS[0] - 1)*50)){
+																					if(p_eta > (int)tripNumber(s_tab[m][w+1], 4)+floor((RELAXCONSTRAINTS[0] - 1)*50)){
 																						isLate = true;
 																						break;}
 																				}
@@ -17960,10 +18842,10 @@ tripidxcnt++;continue;
                                 a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip3,  pDisability3,p_trip_type13);
                                 int p_perf_time3;
                                 set_p_perf_time(pDisposition,pDisability3,p_perf_time3,p_WHEELLOAD1,p_AMBLOAD1,a_extra_loadtime1);
-                                int nextstoptime = trav_time+p_perf_time2+(int)to_number(schd_tab[s_tab[m][k]][CALCULATEDTIME]);
+                                int nextstoptime = trav_time+p_perf_time2+(int)tripNumber(s_tab[m][k], CALCULATEDTIME);
 
 
-                                if(p_eta > (int)to_number(schd_tab[s_tab[m][k+1]][4])-p_perf_time3){
+                                if(p_eta > (int)tripNumber(s_tab[m][k+1], 4)-p_perf_time3){
                                     continue;
                                 }
 
@@ -17996,8 +18878,12 @@ tripidxcnt++;continue;
 	}
 
 	if( tripidxcnt >  0){
-		bubbleSort_twoarray(deviation,tripidxes,tripidxcnt);
-		return tripidxes[0];
+		//only the least deviation is needed; ties go to the lowest trip index, as when rows were searched in order
+		int best = 0;
+		for(int c = 1; c < tripidxcnt; c++)
+			if(deviation[c] < deviation[best] || (deviation[c] == deviation[best] && tripidxes[c] < tripidxes[best]))
+				best = c;
+		return tripidxes[best];
 	}
 
 
@@ -18093,6 +18979,11 @@ void buildTree(){
 	}
 	strcpy(process_tab[LOADDB][0],("DONE"));
 
+	loadTripColumns();
+	refreshStopIndex();
+	if(STOPMATRIX == 1)
+		buildStopMatrix();
+
 	if(d == 1){
 		strcpy(process_tab[ACCESS][0],("READY"));
 	}
@@ -18103,6 +18994,60 @@ void buildTree(){
 	}
 }
 
+//searchtimeslotclustermatch() answers for the s_tab rows one changedisposition() pass may open.
+//The search only reads the tables, so on a miss the next rows the pass would search are searched
+//together, one per core, and the pass takes the answers in s_tab order: it opens the same segments
+//as searching them one at a time. With DEBUG on the rows are searched one by one to keep gse in order.
+struct SegmentFitSearch{
+	string wc;
+	double outsideofellipsevar;
+	double maxdeviationfromstop_slack;
+	string tripids;
+	double maxfirststopdeadhead;
+	signed char fits[MAXSEGMENTS]; //-1 until the row was searched
+
+	SegmentFitSearch(string wc, double outsideofellipsevar, double maxdeviationfromstop_slack, string tripids, double maxfirststopdeadhead)
+	: wc(wc), outsideofellipsevar(outsideofellipsevar), maxdeviationfromstop_slack(maxdeviationfromstop_slack), tripids(tripids), maxfirststopdeadhead(maxfirststopdeadhead){
+		for(int z = 0; z < MAXSEGMENTS; z++)
+			fits[z] = -1;
+	}
+};
+
+void searchSegmentFit(SegmentFitSearch & search, int z){
+	string a_route = "S"+to_string(s_tab[z][0]);
+	search.fits[z] = searchtimeslotclustermatch(a_route,search.wc,"Y",search.outsideofellipsevar,search.maxdeviationfromstop_slack,search.tripids,search.maxfirststopdeadhead) ? 1 : 0;
+}
+
+//Whether any trip might fit on s_tab row z; candidate(h) says if the pass would search row h too
+template <typename Candidate>
+bool segmentMightFit(SegmentFitSearch & search, int z, Candidate candidate){
+	if(search.fits[z] >= 0)
+		return search.fits[z] == 1;
+
+	const int batchsize = DEBUG == 1 ? 1 : tbb::this_task_arena::max_concurrency();
+	vector<int> batch(1, z);
+	for(int h = z + 1; h < MAXSEGMENTS && (int)batch.size() < batchsize; h++){
+		if(s_tab[h][0] == 0)
+			break;
+		if(search.fits[h] < 0 && candidate(h))
+			batch.push_back(h);
+	}
+	if(batch.size() == 1){
+		searchSegmentFit(search, z);
+		return search.fits[z] == 1;
+	}
+
+	//the lazily attached segments are set up before the threads share them
+	attachRequestTable();
+	attachTripColumns();
+	attachStopMatrix(false);
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, batch.size(), 1), [&](const tbb::blocked_range<size_t> & range){
+		for(size_t b = range.begin(); b != range.end(); b++)
+			searchSegmentFit(search, batch[b]);
+	});
+	return search.fits[z] == 1;
+}
+
 int changedisposition(int * arraytoignore, int numtoignore, string wc, double outsideofellipsevar, double maxdeviationfromstop_slack, string tripids, double maxfirststopdeadhead){
 	if(DEBUG == 1) gse << "v2 :Opening more segments with threshold " << OPEN_SEG_THRESHOLD[0] << endl;
 	OPEN_SEG_THRESHOLD[0] = 1; //for now since we are using "no threshold" pass in slack we dont want to completely close segments that could be used in this pass
@@ -18161,6 +19106,24 @@ int changedisposition(int * arraytoignore, int numtoignore, string wc, double ou
 	int cantopen = 0;
 	int tripcounter = 0;
 
+	//the rows the loops below would search, so their searches can run ahead of them
+	auto ignored = [&](int route){
+		for(int g = 0; g < numtoignore; g++){
+			if(route == arraytoignore[g])
+				return true;
+		}
+		return false;
+	};
+	auto openable = [&](int h){
+		return strcmp(schd_tab[s_tab[h][1]][DISPOSITION],"C")==0  || strcmp(schd_tab[s_tab[h][1]][DISPOSITION],"")==0;
+	};
+	auto segmentwithtrips = [&](int h){
+		return strcmp(schd_tab[s_tab[h][1]][2],"1")==0 && strcmp(schd_tab[s_tab[h][2]][2],MAXSTOPNUM[0])!=0 && openable(h) && !ignored(routeint);
+	};
+	auto emptysegment = [&](int h){
+		return strcmp(schd_tab[s_tab[h][1]][2],"1")==0 && strcmp(schd_tab[s_tab[h][2]][2],MAXSTOPNUM[0])==0 && openable(h) && !ignored(s_tab[h][0]);
+	};
+
 	if(tripids!= ""){
 
 		string temptrip = tripids;
@@ -18169,6 +19132,7 @@ int changedisposition(int * arraytoignore, int numtoignore, string wc, double ou
 
 			string trip = getNextToken(&temptrip,",");
 			tripcounter = 0;
+			SegmentFitSearch fitsearch(wc,outsideofellipsevar,maxdeviationfromstop_slack,trip,maxfirststopdeadhead);
 
 
 			for(int z = 0; z < MAXSEGMENTS; z++){
@@ -18207,7 +19171,7 @@ int changedisposition(int * arraytoignore, int numtoignore, string wc, double ou
 							}
 							else if(routeint != arraytoignore[g] && g+1 ==  numtoignore && cnt < numbertoopen && (strcmp(schd_tab[s_tab[z][1]][DISPOSITION],"C")==0  || strcmp(schd_tab[s_tab[z][1]][DISPOSITION],"")==0)){
 								a_route = "S"+to_string(s_tab[z][0]);
-								mightfittrip =  searchtimeslotclustermatch(a_route,wc,"Y",outsideofellipsevar,maxdeviationfromstop_slack,trip,maxfirststopdeadhead); // check if we can possibly fit any trips on the route before opening
+								mightfittrip = segmentMightFit(fitsearch, z, segmentwithtrips); // check if we can possibly fit any trips on the route before opening
 								if(/*numberalreadyopen > 0 &&*/ !mightfittrip){
 									if(DEBUG == 1) gse << "No trips can fit on this segment so we're not opening it: " << a_route << endl;
 									cantopen++;
@@ -18235,7 +19199,7 @@ int changedisposition(int * arraytoignore, int numtoignore, string wc, double ou
 					}
 					else if (numtoignore == 0 && cnt < numbertoopen && (strcmp(schd_tab[s_tab[z][1]][DISPOSITION],"C")==0  || strcmp(schd_tab[s_tab[z][1]][DISPOSITION],"")==0)){
 						a_route = "S"+to_string(s_tab[z][0]);
-						mightfittrip =  searchtimeslotclustermatch(a_route,wc,"Y",outsideofellipsevar,maxdeviationfromstop_slack,trip,maxfirststopdeadhead); // check if we can possibly fit any trips on the route before opening
+						mightfittrip = segmentMightFit(fitsearch, z, segmentwithtrips); // check if we can possibly fit any trips on the route before opening
 						if(/*numberalreadyopen > 0 &&*/ !mightfittrip){
 							if(DEBUG == 1) gse << "No trips can fit on this segment so we're not opening it: " << a_route << endl;
 							cantopen++;
@@ -18282,7 +19246,7 @@ int changedisposition(int * arraytoignore, int numtoignore, string wc, double ou
 
 							else if(s_tab[h][0] != arraytoignore[g]  && g+1 == numtoignore && cnt < numbertoopen && (strcmp(schd_tab[s_tab[h][1]][DISPOSITION],"C")==0  || strcmp(schd_tab[s_tab[h][1]][DISPOSITION],"")==0)){
 								a_route = "S"+to_string(s_tab[h][0]);
-								mightfittrip =  searchtimeslotclustermatch(a_route,wc,"Y",outsideofellipsevar,maxdeviationfromstop_slack,trip,maxfirststopdeadhead); // check if we can possibly fit any trips on the route before opening
+								mightfittrip = segmentMightFit(fitsearch, h, emptysegment); // check if we can possibly fit any trips on the route before opening
 								if(/*numberalreadyopen > 0 &&*/ !mightfittrip){
 									if(DEBUG == 1) gse << "No trips can fit on this segment so we're not opening it: " << a_route << endl;
 									cantopen++;
@@ -18318,7 +19282,7 @@ int changedisposition(int * arraytoignore, int numtoignore, string wc, double ou
 						break;
 					if(strcmp(schd_tab[s_tab[h][1]][2],"1")==0 && strcmp(schd_tab[s_tab[h][2]][2],MAXSTOPNUM[0])==0 && (strcmp(schd_tab[s_tab[h][1]][DISPOSITION],"C")==0  || strcmp(schd_tab[s_tab[h][1]][DISPOSITION],"")==0)){
 						a_route = "S"+to_string(s_tab[h][0]);
-						mightfittrip =  searchtimeslotclustermatch(a_route,wc,"Y",outsideofellipsevar,maxdeviationfromstop_slack,trip,maxfirststopdeadhead); // check if we can possibly fit any trips on the route before opening
+						mightfittrip = segmentMightFit(fitsearch, h, emptysegment); // check if we can possibly fit any trips on the route before opening
 						if(/*numberalreadyopen > 0 &&*/ !mightfittrip){
 							if(DEBUG == 1) gse << "No trips can fit on this segment so we're not opening it: " << a_route << endl;
 							cantopen++;
@@ -18342,6 +19306,7 @@ int changedisposition(int * arraytoignore, int numtoignore, string wc, double ou
 		}
 	}
 	else{
+		SegmentFitSearch fitsearch(wc,outsideofellipsevar,maxdeviationfromstop_slack,tripids,maxfirststopdeadhead);
 
 		for(int z = 0; z < MAXSEGMENTS; z++){
 
@@ -18374,7 +19339,7 @@ int changedisposition(int * arraytoignore, int numtoignore, string wc, double ou
 						}
 						else if(routeint != arraytoignore[g] && g+1 ==  numtoignore &&   cnt < numbertoopen && (strcmp(schd_tab[s_tab[z][1]][DISPOSITION],"C")==0  || strcmp(schd_tab[s_tab[z][1]][DISPOSITION],"")==0)){
 							a_route = "S"+to_string(s_tab[z][0]);
-							mightfittrip =  searchtimeslotclustermatch(a_route,wc,"Y",outsideofellipsevar,maxdeviationfromstop_slack,tripids,maxfirststopdeadhead); // check if we can possibly fit any trips on the route before opening
+							mightfittrip = segmentMightFit(fitsearch, z, segmentwithtrips); // check if we can possibly fit any trips on the route before opening
 							if(/*numberalreadyopen > 0 &&*/ !mightfittrip){
 								if(DEBUG == 1) gse << "No trips can fit on this segment so we're not opening it: " << a_route << endl;
 								cantopen++;
@@ -18393,7 +19358,7 @@ int changedisposition(int * arraytoignore, int numtoignore, string wc, double ou
 				}
 				else if (numtoignore == 0 && cnt < numbertoopen && (strcmp(schd_tab[s_tab[z][1]][DISPOSITION],"C")==0  || strcmp(schd_tab[s_tab[z][1]][DISPOSITION],"")==0)){
 					a_route = "S"+to_string(s_tab[z][0]);
-					mightfittrip =  searchtimeslotclustermatch(a_route,wc,"Y",outsideofellipsevar,maxdeviationfromstop_slack,tripids,maxfirststopdeadhead); // check if we can possibly fit any trips on the route before opening
+					mightfittrip = segmentMightFit(fitsearch, z, segmentwithtrips); // check if we can possibly fit any trips on the route before opening
 					if(/*numberalreadyopen > 0 &&*/ !mightfittrip){
 						if(DEBUG == 1) gse << "No trips can fit on this segment so we're not opening it: " << a_route << endl;
 						cantopen++;
@@ -18433,7 +19398,7 @@ int changedisposition(int * arraytoignore, int numtoignore, string wc, double ou
 
 						else if(s_tab[h][0] != arraytoignore[g]  && g+1 == numtoignore && cnt < numbertoopen){
 							a_route = "S"+to_string(s_tab[h][0]);
-							mightfittrip =  searchtimeslotclustermatch(a_route,wc,"Y",outsideofellipsevar,maxdeviationfromstop_slack,tripids,maxfirststopdeadhead); // check if we can possibly fit any trips on the route before opening
+							mightfittrip = segmentMightFit(fitsearch, h, emptysegment); // check if we can possibly fit any trips on the route before opening
 							if(/*numberalreadyopen > 0 &&*/ !mightfittrip){
 								if(DEBUG == 1) gse << "No trips can fit on this segment so we're not opening it: " << a_route << endl;
 								cantopen++;
@@ -18462,7 +19427,7 @@ int changedisposition(int * arraytoignore, int numtoignore, string wc, double ou
 					break;
 				if(strcmp(schd_tab[s_tab[h][1]][2],"1")==0 && strcmp(schd_tab[s_tab[h][2]][2],MAXSTOPNUM[0])==0 && (strcmp(schd_tab[s_tab[h][1]][DISPOSITION],"C")==0  || strcmp(schd_tab[s_tab[h][1]][DISPOSITION],"")==0)){
 					a_route = "S"+to_string(s_tab[h][0]);
-					mightfittrip =  searchtimeslotclustermatch(a_route,wc,"Y",outsideofellipsevar,maxdeviationfromstop_slack,tripids,maxfirststopdeadhead); // check if we can possibly fit any trips on the route before opening
+					mightfittrip = segmentMightFit(fitsearch, h, emptysegment); // check if we can possibly fit any trips on the route before opening
 					if(/*numberalreadyopen > 0 &&*/ !mightfittrip){
 						if(DEBUG == 1) gse << "No trips can fit on this segment so we're not opening it: " << a_route << endl;
 						cantopen++;
@@ -18791,8 +19756,267 @@ void passSomeThroughAccess(string segments){
 }
 
 
+//updateDatabase() no longer runs one UPDATE and commit per stop on the scheduler thread. Each stop
+//becomes a StopUpdate for a write-behind queue keyed by the statement and the row it updates, so a
+//stop recalculated again before it was written is written once with its newest values. The
+//queue's thread hands the rows to a ScheduleSink: OCCI array binds, one execute per kind of stop
+//and one commit per batch, or the SQL as text in a file where there is no Oracle server. A failed
+//batch is tried again; stops that fail SCHEDULEWRITEATTEMPTS times get their DIRTYBIT set so
+//DBWRITE writes them.
+const int STOPUPDATE_SEGMENTSTART = 0;
+const int STOPUPDATE_SEGMENTEND = 1;
+const int STOPUPDATE_PICKUP = 2;
+const int STOPUPDATE_DROPOFF = 3;
+const int STOPUPDATEKINDS = 4;
+const int SCHEDULEWRITEBATCH = 500; //rows per round trip to the database
+const int SCHEDULEWRITEATTEMPTS = 3; //writes of a batch before its stops go to DBWRITE
+const int SCHEDULEWRITERETRYMS = 1000; //pause after a failed batch
+const char * STOPUPDATESQL[STOPUPDATEKINDS] = {
+		"UPDATE %s set pu_etd = :1, pu_eta = :2, pu_disttonextstop = :3 where SEGMENTID = :4 AND TRAVEL_DATE = :5",
+		"UPDATE %s set do_timetonextstop = :1, do_disttonextstop = :2, do_eta = :3, do_etd = :4 where SEGMENTID = :5 AND TRAVEL_DATE = :6",
+		"UPDATE %s set pu_stop = :1, pu_perf_time = :2, pu_eta = :3, pu_etd = :4, pu_amb_occ = :5, pu_wc_occ = :6, pu_disttonextstop = :7, pu_timetonextstop = :8, SYSTEM_USER = 'SHM' where tripid = :9",
+		"UPDATE %s set do_stop = :1, do_perf_time = :2, do_eta = :3, do_etd = :4, do_amb_occ = :5, do_wc_occ = :6, do_disttonextstop = :7, do_timetonextstop = :8, SYSTEM_USER = 'SHM' where tripid = :9"};
+const int STOPUPDATEWHERE[STOPUPDATEKINDS] = {2, 2, 1, 1}; //trailing placeholders in the where clause
+
+struct StopUpdate{
+	int kind;
+	int tripidx; //the schd_tab row the values were read from
+	vector<string> values; //in the order of the placeholders of STOPUPDATESQL[kind]
+
+	//the statement and the row it updates; two updates with the same key overwrite each other
+	string key() const{
+		string k = to_string(kind);
+		for(size_t v = values.size() - STOPUPDATEWHERE[kind]; v < values.size(); v++)
+			k += "^" + values[v];
+		return k;
+	}
+};
+
+struct ScheduleSink{
+	string table_itms_segments;
+	string table_itms_trips;
+
+	ScheduleSink(string table_itms_segments, string table_itms_trips) : table_itms_segments(table_itms_segments), table_itms_trips(table_itms_trips){}
+	virtual ~ScheduleSink(){}
+	virtual void write(const vector<StopUpdate> & rows) = 0;
+
+	string statement(int kind){
+		char buffer[512];
+		sprintf(buffer, STOPUPDATESQL[kind], (kind == STOPUPDATE_SEGMENTSTART || kind == STOPUPDATE_SEGMENTEND ? table_itms_segments : table_itms_trips).c_str());
+		return buffer;
+	}
+};
+
+//Opens its own connection from a THREADED_MUTEXED Environment on the first write, which runs on
+//the writer thread, so it never shares a connection with the scheduler's queries. A write that
+//fails rolls back what the batch executed and drops the connection, so the next write starts on
+//a fresh one.
+struct OcciScheduleSink : ScheduleSink{
+	Environment* env;
+	Connection* conn;
+
+	OcciScheduleSink(string table_itms_segments, string table_itms_trips) : ScheduleSink(table_itms_segments, table_itms_trips), env(NULL), conn(NULL){}
+
+	~OcciScheduleSink(){
+		if(conn != NULL)
+			env->terminateConnection(conn);
+		if(env != NULL)
+			Environment::terminateEnvironment(env);
+	}
+
+	void write(const vector<StopUpdate> & rows){
+		if(env == NULL)
+			env = Environment::createEnvironment(Environment::THREADED_MUTEXED);
+		if(conn == NULL)
+			conn = env->createConnection(username, password, connectString);
+		Statement* stmt = NULL;
+		try{
+			execute(rows, stmt);
+			conn->commit();
+		}
+		catch(const std::exception &){
+			try{
+				if(stmt != NULL)
+					conn->terminateStatement(stmt);
+				conn->rollback();
+			}
+			catch(const std::exception & e){
+				gse << "calculator.h - OcciScheduleSink rollback failed: " << e.what() << endl;
+			}
+			try{
+				env->terminateConnection(conn);
+			}
+			catch(const std::exception & e){
+				gse << "calculator.h - OcciScheduleSink could not close its connection: " << e.what() << endl;
+			}
+			conn = NULL;
+			throw;
+		}
+	}
+
+	//stmt is the statement in flight, so write() can terminate it when one fails
+	void execute(const vector<StopUpdate> & rows, Statement* & stmt){
+		for(int kind = 0; kind < STOPUPDATEKINDS; kind++){
+			int count = 0;
+			for(size_t r = 0; r < rows.size(); r++){
+				if(rows[r].kind == kind)
+					count++;
+			}
+			if(count == 0)
+				continue;
+
+			stmt = conn->createStatement(statement(kind));
+			stmt->setMaxIterations(count);
+			for(size_t r = 0; r < rows.size(); r++){
+				if(rows[r].kind == kind){
+					for(size_t v = 0; v < rows[r].values.size(); v++)
+						stmt->setMaxParamSize(v + 1, MAXLGSTRSIZE);
+					break;
+				}
+			}
+			int added = 0;
+			for(size_t r = 0; r < rows.size(); r++){
+				if(rows[r].kind != kind)
+					continue;
+				for(size_t v = 0; v < rows[r].values.size(); v++)
+					stmt->setString(v + 1, rows[r].values[v]);
+				added++;
+				if(added < count)
+					stmt->addIteration();
+			}
+			stmt->executeUpdate();
+			conn->terminateStatement(stmt);
+			stmt = NULL;
+		}
+	}
+};
+
+//Stand-in without an Oracle server: every row as the statement it binds, one per line
+struct FileScheduleSink : ScheduleSink{
+	ofstream out;
+
+	FileScheduleSink(string filename, string table_itms_segments, string table_itms_trips) : ScheduleSink(table_itms_segments, table_itms_trips), out(filename.c_str(), fstream::out | fstream::app){}
+
+	void write(const vector<StopUpdate> & rows){
+		for(size_t r = 0; r < rows.size(); r++){
+			out << statement(rows[r].kind);
+			for(size_t v = 0; v < rows[r].values.size(); v++)
+				out << (v == 0 ? " -- " : ", ") << rows[r].values[v];
+			out << ";" << endl;
+		}
+		out.flush();
+	}
+};
+
+ScheduleSink* schedule_sink = NULL;
+osrm::util::WriteBehindQueue<string, StopUpdate>* schedule_writes = NULL;
+
+//Waits until every queued schedule update reached the database
+void flushScheduleWrites(){
+	if(schedule_writes == NULL)
+		return;
+	schedule_writes->Flush();
+	if(schedule_writes->Failed() > 0)
+		gse << "calculator.h - flushScheduleWrites() " << schedule_writes->Failed() << " batches failed, " << schedule_writes->Abandoned() << " stops left to DBWRITE, last: " << schedule_writes->LastError() << endl;
+}
+
+//Flushes and closes the writer; startScheduleWriter() registers it to run at exit
+void stopScheduleWriter(){
+	if(schedule_writes == NULL)
+		return;
+	flushScheduleWrites();
+	delete schedule_writes;
+	schedule_writes = NULL;
+	delete schedule_sink;
+	schedule_sink = NULL;
+}
+
+void startScheduleWriter(string table_itms_segments, string table_itms_trips){
+	if(schedule_writes != NULL)
+		return;
+	if(SCHEDULEWRITEFILE != "")
+		schedule_sink = new FileScheduleSink(SCHEDULEWRITEFILE, table_itms_segments, table_itms_trips);
+	else
+		schedule_sink = new OcciScheduleSink(table_itms_segments, table_itms_trips);
+	ScheduleSink* sink = schedule_sink;
+	schedule_writes = new osrm::util::WriteBehindQueue<string, StopUpdate>([sink](const vector<StopUpdate> & rows){
+		try{
+			sink->write(rows);
+		}
+		catch(const std::exception & e){
+			gse << "calculator.h - schedule writer failed " << rows.size() << " updates: " << e.what() << endl;
+			throw;
+		}
+	}, SCHEDULEWRITEBATCH, SCHEDULEWRITEATTEMPTS, std::chrono::milliseconds(SCHEDULEWRITERETRYMS), [](const vector<StopUpdate> & rows){
+		//the same handoff writeallsegtoDB() makes without the writer
+		for(size_t r = 0; r < rows.size(); r++)
+			strcpy((schd_tab[rows[r].tripidx][DIRTYBIT]) , ("Y"));
+		strcpy((process_tab[DBWRITE][0]) , ("RUNNING"));
+		gse << "calculator.h - schedule writer left " << rows.size() << " updates to DBWRITE" << endl;
+	});
+	atexit(stopScheduleWriter);
+}
+
+//The connection arguments are kept for the old callers; the writer opens its own
+void updateDatabase(int cnt, int index, Environment*, Connection*, char (*schd_tab)[TRIPCOLSIZE][MAXLGSTRSIZE],int (*s_tab)[MAXSTOPS], string table_itms_segments,string table_itms_trips){
+	startScheduleWriter(table_itms_segments, table_itms_trips);
+
+	for(int i = 1; i < cnt+1; i++){
+		int tripidx = s_tab[index][i];
+		string prom_time = schd_tab[tripidx][4];
+		string stopnum = schd_tab[tripidx][2];
+		string perf_time = schd_tab[tripidx][25];
+		string timetonextstop = schd_tab[tripidx][28];
+		string eta = schd_tab[tripidx][29];
+		string etd = schd_tab[tripidx][30];
+		string amb_occ = schd_tab[tripidx][31];
+		string wc_occ = schd_tab[tripidx][32];
+		string dist = schd_tab[tripidx][6];
+		string tripid = schd_tab[tripidx][3];
+		string traveldate = schd_tab[tripidx][1];
+		StopUpdate update;
+		update.tripidx = tripidx;
+
+		if (strcmp(schd_tab[tripidx][2],"1") == 0 ){
+			update.kind = STOPUPDATE_SEGMENTSTART;
+			update.values = {prom_time, to_string((int)to_number(prom_time)-15), dist, tripid, traveldate};
+		}
+		else if (strcmp(schd_tab[tripidx][2],MAXSTOPNUM[0]) == 0 ){
+			update.kind = STOPUPDATE_SEGMENTEND;
+			update.values = {timetonextstop, dist, eta, eta, tripid, traveldate};
+		}
+		else if(strcmp(schd_tab[tripidx][7],"P")==0 && strcmp(schd_tab[tripidx][2],"999")!=0){
+			update.kind = STOPUPDATE_PICKUP;
+			update.values = {stopnum, perf_time, eta, etd, amb_occ, wc_occ, dist, timetonextstop, tripid};
+		}
+		else if (strcmp(schd_tab[tripidx][7],"D")==0 && strcmp(schd_tab[tripidx][2],"999")!=0) {
+			update.kind = STOPUPDATE_DROPOFF;
+			update.values = {stopnum, perf_time, eta, etd, amb_occ, wc_occ, dist, timetonextstop, tripid};
+		}
+		else
+			continue;
+
+		if(DEBUG == 1) gse << "calculator.h - updateDatabase() queued " << schedule_sink->statement(update.kind) << " for " << tripid << endl;
+		schedule_writes->Push(update.key(), update);
+	}
+}
+//Queues the stops of segment row m of s_tab for the schedule writer
+void queueSegmentWrites(int m){
+	int cnt = 0;
+	while(cnt + 1 < MAXSTOPS && s_tab[m][cnt + 1] != 0)
+		cnt++;
+	updateDatabase(cnt, m, NULL, NULL, schd_tab, s_tab, table_itms_segments, table_itms_trips);
+}
+
+
 void writeallsegtoDB(){
 
+	if(SCHEDULEWRITES == 1){ //the schedule writer takes the stops instead of DBWRITE
+		for(int m = 0; m < MAXSEGMENTS && s_tab[m][0] != 0; m++)
+			queueSegmentWrites(m);
+		return;
+	}
+
 	strcpy((process_tab[DBWRITE][0]) , ("RUNNING"));
 
 	for(int m = 0; m < MAXSEGMENTS; m++){
@@ -18821,6 +20045,16 @@ void writesomesegtoDB(string segments){
 		string a_route = getNextToken(&temp, ",");
 		int routeint = (int)to_number(a_route.substr(1,a_route.length()));
 
+		if(SCHEDULEWRITES == 1){ //the schedule writer takes the stops instead of DBWRITE
+			for(int m = 0; m < MAXSEGMENTS && s_tab[m][0] != 0; m++){
+				if(s_tab[m][0] == routeint){
+					queueSegmentWrites(m);
+					break;
+				}
+			}
+			continue;
+		}
+
 		strcpy((process_tab[DBWRITE][0]) , ("RUNNING"));
 
 		for(int m = 0; m < MAXSEGMENTS; m++){
@@ -18840,7 +20074,8 @@ void writesomesegtoDB(string segments){
 		}
 	}
 
-	sleep(1); // give time for dbwrite to trigger
+	if(SCHEDULEWRITES != 1)
+		sleep(1); // give time for dbwrite to trigger
 
 	return;
 
@@ -19234,21 +20469,8 @@ string getCurrentDate_New()  //Hui, 01-FEB-21
 }
 
 void getDistTimeFromOsrm_New(string theOrigLat, string theOrigLng, string theDistLat, string theDistLng, int & theTime)
-{    int x;    for (int d = 0;
-         d < MAXREQUESTS;
-         d++)
-    {        if (requestIsEmpty(d))
-        {
-            usleep(10);
-            if (requestIsEmpty(d))
-            {
-                x = d;
-                break;
-            }
-        }
-        if (d + 1 == MAXREQUESTS)
-            d = -1;
-    }
+{
+    int x = acquireRequest();
     if (DEBUGFB == 1 || DEBUG == 1)
         gse << "x is " << x << endl;    string aFunction = "FindBestDistSINGLE", bOsrm = theOrigLat + "," + theOrigLng + "," + theDistLat + "," + theDistLng;    // time_t t = time(NULL);
     // struct tm tm = *localtime(&t);
@@ -19265,61 +20487,47 @@ void getDistTimeFromOsrm_New(string theOrigLat, string theOrigLng, string theDis
     updateRequest(x, "", "DISTANCE");
     if (DEBUGFB == 1 || DEBUG == 1)
         gse << "calculator.h - getDistTimeFromOsrm_New() x: " << x << ", FUNC: " << aFunction << "LATLONG: " << bOsrm <<  endl;
-    bool aFoundTime = false;
-    while (true)
-    {
-    	for (int q = 0;
-             q < MAXREQUESTS;
-             q++)
-        {
-    		if(q<10)
-    			gse << "waiting for osrm: q:" << q << ", fetchRequest(q, DISTANCE): " << fetchRequest(q, "DISTANCE") << ", fetchRequest(q, TIME): " << fetchRequest(q, "TIME") << ", fetchRequest(q, FUNC): " << fetchRequest(q, "FUNC") << ", fetchRequest(q, LATLONG)" << fetchRequest(q, "LATLONG") << endl;
-    	if (fetchRequest(q, "DISTANCE") != "" && fetchRequest(q, "TIME") != "" && fetchRequest(q, "FUNC") == "FindBestDistSINGLE" && fetchRequest(q, "LATLONG") == bOsrm)
-            {
-                double aDist = to_number(fetchRequest(q, "DISTANCE"));
-                theTime = ( int )to_number( fetchRequest( q, "TIME" ) );
-                aFoundTime = true;
-                clearRequest(q);
-                while (!requestIsEmpty(q))
-                {
-                }
-                break;
-            }
-        }
-    	if(aFoundTime)
-    		break;
-    }    if (DEBUGFB == 1 || DEBUG == 1) gse << "calculator.h - getDistTimeFromOsrm_New() at the end, theTime: " << theTime << endl;
+    submitRequest(x);
+    waitForRequest(x);
+    if (DEBUGFB == 1 || DEBUG == 1)
+        gse << "osrm answered x:" << x << ", DISTANCE: " << fetchRequest(x, "DISTANCE") << ", TIME: " << fetchRequest(x, "TIME") << ", FUNC: " << fetchRequest(x, "FUNC") << ", LATLONG: " << fetchRequest(x, "LATLONG") << endl;
+    theTime = ( int )to_number( fetchRequest( x, "TIME" ) );
+    clearRequest(x);
+    if (DEBUGFB == 1 || DEBUG == 1) gse << "calculator.h - getDistTimeFromOsrm_New() at the end, theTime: " << theTime << endl;
 }
 
 
+//Hui, 10FEB21 - the coordinates getRealTimeTravleTime() routes to: pickup location for a pickup, dropoff location otherwise
+void realTimeStopCoords(int tripidx, string & lat, string & lon)
+{
+	if(strcmp(schd_tab[tripidx][7], "P") == 0)
+	{
+		lat = schd_tab[tripidx][10];
+		lon = schd_tab[tripidx][37];
+	}else{
+		lat = schd_tab[tripidx][38];
+		lon = schd_tab[tripidx][39];
+	}
+}
+
 void getRealTimeTravleTime(int & osrm_travel_time_from_tops_location_to_next_stop, string & vRecordTime, string p_td_segmentid, int p_stop_num, int puid, int doid)
 {	
 	//Hui, 10FEB21, this function uses real time location of the vehicle to get travel time to the next stop. 
 	//Hui, 10FEB21, tops table is only been populated if travel date is current date. this constraint is in gse_monitor.
-	int shmid_a = shmget ( key_avl_tops, sizeof( char[ MAXSEGMENTS ][ MAXAVLTOPSCOLUMNSIZE ][ MAXLGSTRSIZE ] ), 0666 );
-	avl_tops = ( char ( * )[ MAXAVLTOPSCOLUMNSIZE ][ MAXLGSTRSIZE ] )shmat( shmid_a, 0, 0 );
+	//avl_tops stays attached, and osrm-routed keeps the ETAs of a tracked vehicle current from its matched position,
+	//so a request is only sent for a fix osrm-routed has not routed yet.
 	string vLat = "", vLon = ""; // will be used as if current stop.
 	if (DEBUGFB == 1 || DEBUG == 1)
-	            gse << "avl_tops[0][0]: " << avl_tops[0][0] << ", osrm_travel_time_from_tops_location_to_next_stop: " << osrm_travel_time_from_tops_location_to_next_stop << ", vRecordTime: " << vRecordTime << ", p_td_segmentid: " << p_td_segmentid << ", p_stop_num: " << p_stop_num << ", puid: " << puid << ", doid: " << doid << endl;
-	for (int x = 0; x < MAXSTOPS; x++)
+	            gse << "osrm_travel_time_from_tops_location_to_next_stop: " << osrm_travel_time_from_tops_location_to_next_stop << ", vRecordTime: " << vRecordTime << ", p_td_segmentid: " << p_td_segmentid << ", p_stop_num: " << p_stop_num << ", puid: " << puid << ", doid: " << doid << endl;
+	int x = findAvlTopsRow(p_td_segmentid);
+	if (x >= 0)
 	{
-		if (strcmp(avl_tops[x][0], "") == 0)
-		{
-			break;
-		}
-		if (DEBUGFB == 1 || DEBUG == 1)
-			gse << "searching avl_tops: idx: " << x << ", segment_id: " << avl_tops[x][0] << ", target segment_id: " << p_td_segmentid << endl;
-		// if (strcmp(avl_tops[x][0], p_td_segmentid) == 0)
-		if(avl_tops[x][0] == p_td_segmentid)
-		{
-			vLat = avl_tops[x][1];
-			vLon = avl_tops[x][2];
-			vRecordTime = avl_tops[x][3];
-			break;
-		}
+		vLat = avl_tops[x][1];
+		vLon = avl_tops[x][2];
+		vRecordTime = avl_tops[x][3];
 	}
 	if (DEBUGFB == 1 || DEBUG == 1)
-		gse << "vLat: " << vLat << ", vLon: " << vLon << ", vRecordTime: " << vRecordTime << endl;
+		gse << "avl_tops idx: " << x << ", vLat: " << vLat << ", vLon: " << vLon << ", vRecordTime: " << vRecordTime << endl;
 	// if (strcmp(vLat, "") == 0 || strcmp(vLon, "") == 0 || strcmp(vRecordTime, "") == 0)
 	if(vLat == "" || vLon == "" || vRecordTime == "")
 	{
@@ -19327,8 +20535,9 @@ void getRealTimeTravleTime(int & osrm_travel_time_from_tops_location_to_next_sto
 	}
 	else
 	{
-		// get next stop latlng
+		// get next stop latlng, and the stops after it on the segment for the vehicle track
 		string nLat = "", nLon = "";
+		vector<pair<double, double> > remaining;
 		if (p_stop_num != 1 && p_stop_num % 5 == 0)
 		{
 			for (int x = 0; x < MAXSEGMENTS; x++)
@@ -19338,16 +20547,16 @@ void getRealTimeTravleTime(int & osrm_travel_time_from_tops_location_to_next_sto
 				// if (strcmp("S" + to_string(s_tab[x][0]), p_td_segmentid) == 0)
 				if ( ("S" + to_string(s_tab[x][0])) == p_td_segmentid )
 				{
-					if (DEBUGFB == 1 || DEBUG == 1) gse << "Segment found - s_tab[x][0]: " << s_tab[x][0] << ", = p_td_segmentid: " << p_td_segmentid << endl;
-					if(schd_tab[s_tab[x][p_stop_num / 5]][7] == "P")
+					if (DEBUGFB == 1 || DEBUG == 1) gse << "Segment found - s_tab[x][0]: " << s_tab[x][0] << ", = p_td_segmentid: " << p_td_segmentid << ", stop type: " << schd_tab[s_tab[x][p_stop_num / 5]][7] << endl;
+					realTimeStopCoords(s_tab[x][p_stop_num / 5], nLat, nLon);
+					remaining.clear();
+					for (int k = p_stop_num / 5; k < MAXSTOPS && s_tab[x][k] != 0 && (int)remaining.size() < MAXTRACKEDSTOPS; k++)
 					{
-						if (DEBUGFB == 1 || DEBUG == 1) gse << "It's a pickup." << endl;
-						nLat = schd_tab[s_tab[x][p_stop_num / 5]][10];
-						nLon = schd_tab[s_tab[x][p_stop_num / 5]][37];
-					}else{
-						if (DEBUGFB == 1 || DEBUG == 1) gse << "It's a dropoff." << endl;
-						nLat = schd_tab[s_tab[x][p_stop_num / 5]][38];
-						nLon = schd_tab[s_tab[x][p_stop_num / 5]][39];
+						string sLat, sLon;
+						realTimeStopCoords(s_tab[x][k], sLat, sLon);
+						if (sLat == "" || sLon == "")
+							break;
+						remaining.push_back(make_pair(to_number(sLat), to_number(sLon)));
 					}
 				}
 			}
@@ -19356,18 +20565,32 @@ void getRealTimeTravleTime(int & osrm_travel_time_from_tops_location_to_next_sto
 		{
 			nLat = schd_tab[puid][10];
 			nLon = schd_tab[puid][37];
+			if (nLat != "" && nLon != "")
+				remaining.push_back(make_pair(to_number(nLat), to_number(nLon)));
 		}
 		if (DEBUGFB == 1 || DEBUG == 1)
-			gse << "nLat: " << nLat << ", nLon: " << nLon << endl;
+			gse << "nLat: " << nLat << ", nLon: " << nLon << ", remaining stops: " << remaining.size() << endl;
 		// if (strcmp(nLat, "") == 0 || strcmp(nLon, "") == 0)
 		if (nLat == "" || nLon == "")
 		{
 			osrm_travel_time_from_tops_location_to_next_stop = -1;
+			// no stop left to drive to: the run is over
+			if (remaining.empty())
+				releaseVehicleTrack(p_td_segmentid);
 		}
 		else
 		{
-			// call osrm to get travel_time and assign it to osrm_travel_time_from_tops_location_to_next_stop
-			getDistTimeFromOsrm_New(vLat, vLon, nLat, nLon, osrm_travel_time_from_tops_location_to_next_stop);
+			// the same stops again leave the track as it is, other stops make osrm-routed route them anew
+			trackVehicle(p_td_segmentid, remaining);
+			if (lookupVehicleEta(p_td_segmentid, vRecordTime, remaining, osrm_travel_time_from_tops_location_to_next_stop))
+			{
+				if (DEBUGFB == 1 || DEBUG == 1) gse << "ETA from the vehicle track: " << osrm_travel_time_from_tops_location_to_next_stop << endl;
+			}
+			else
+			{
+				// not routed from this fix yet: ask for this stop directly
+				getDistTimeFromOsrm_New(vLat, vLon, nLat, nLon, osrm_travel_time_from_tops_location_to_next_stop);
+			}
 		}
 	}
 }
@@ -19590,7 +20813,7 @@ itms_calcroute_RealTime( string pActual_Arr_Time, string pActual_Dep_Time, doubl
 
      */
 
-    aProm_time = itms_to_minutes (ampm2fullhrs (pPromised_time));
+    aProm_time = dayMinute(pPromised_time);
     aDep_time = aProm_time;
 
 
@@ -19826,7 +21049,7 @@ itms_calcroute_RealTime( string pActual_Arr_Time, string pActual_Dep_Time, doubl
                         {
 
                             // aArr_time = current_time_from_avl_tops + osrm_travel_time_from_tops_location_to_next_stop;
-                            aArr_time = (int)itms_to_minutes(ampm2fullhrs(vRecordTime)) + osrm_travel_time_from_tops_location_to_next_stop;
+                            aArr_time = (int)dayMinute(vRecordTime) + osrm_travel_time_from_tops_location_to_next_stop;
                             if (DEBUGFB == 1 || DEBUG == 1) gse << "first non performed stop (tops value) arrive time " << aArr_time << " for stop num " << pStop_num << endl;
                         }
                         else
@@ -20333,7 +21556,7 @@ dep_time = arr_time + perf_time + (c)*(60/t)         - c = count at a stop, t =
 	// if(DEBUG == 1) gse << "5 in calculator " << p_promised_time << " perf time " << p_perf_time<< " disability " <<p_disability<<  endl;
 
 
-	prom_time = itms_to_minutes (ampm2fullhrs (p_promised_time));
+	prom_time = dayMinute(p_promised_time);
 	perf_time = p_perf_time;
 	dep_time = prom_time;
 
@@ -20504,8 +21727,8 @@ dep_time = arr_time + perf_time + (c)*(60/t)         - c = count at a stop, t =
 
 		if (p_trip_type == "FIXED")
 		{     /* if the stop is part of a fixed route eta = promised_time */
-			p_eta = itms_to_minutes (ampm2fullhrs (p_promised_time));
-			p_etd = itms_to_minutes (ampm2fullhrs (p_promised_time));
+			p_eta = dayMinute(p_promised_time);
+			p_etd = dayMinute(p_promised_time);
 
 
 			p_timetonextstop = trav_time;
@@ -20515,8 +21738,8 @@ dep_time = arr_time + perf_time + (c)*(60/t)         - c = count at a stop, t =
 			tot_miles = tot_miles + p_disttonextstop;
 			tot_driv_time = tot_driv_time + p_timetonextstop;
 
-			dep_time = itms_to_minutes (ampm2fullhrs (p_etd));
-			arr_time = itms_to_minutes (ampm2fullhrs (p_eta));
+			dep_time = dayMinute(p_etd);
+			arr_time = dayMinute(p_eta);
 
 		}
 		else{
@@ -20932,7 +22155,7 @@ const int MAXLGSTRSIZE = 2000;*/
 
 void slack_calc(int i, char (*schd_tab)[TRIPCOLSIZE][MAXLGSTRSIZE]){
 
-	int slack = ((int)to_number(schd_tab[i][4]) - (int)to_number(schd_tab[i][29]));
+	int slack = ((int)tripNumber(i, 4) - (int)tripNumber(i, 29));
 
 	if (slack > 0){
 		strcpy(schd_tab[i-1][40], to_string(slack).c_str());
@@ -21017,7 +22240,7 @@ void insertGroupTrips(int timeslot, int cluster, int tripidx, int routeidx, bool
 		if(strcmp(schd_tab[q][7],"D")==0 && strcmp(schd_tab[q][0],"")==0 ){
 
 			int doid = q;
-			int puid = (int)to_number(schd_tab[q][PICKUPIDX]);
+			int puid = (int)tripNumber(q, PICKUPIDX);
 
 			if(strcmp(schd_tab[puid][41],schd_tab[attemptstraightline[0]][41])==0  && puid != attemptstraightline[0]  && strcmp(schd_tab[puid][0],"")==0){
 
@@ -21043,7 +22266,7 @@ void insertGroupTrips(int timeslot, int cluster, int tripidx, int routeidx, bool
 						while (neighborclusterspu != "")
 						{
 
-							if(strcmp(schd_tab[attemptstraightline[h]][3], schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][3]) ==0){
+							if(strcmp(schd_tab[attemptstraightline[h]][3], schd_tab[(int)tripNumber(doid, PICKUPIDX)][3]) ==0){
 								break;
 							}
 
@@ -21051,9 +22274,9 @@ void insertGroupTrips(int timeslot, int cluster, int tripidx, int routeidx, bool
 
 							//int t1 = ((int)to_number(schd_tab[h][4]))/15;
 							//int t2 = ((int)to_number(schd_tab[h+1][4]))/15;
-							int timeslot1 = ((int)to_number(schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][41]));
+							int timeslot1 = ((int)tripNumber((int)tripNumber(doid, PICKUPIDX), 41));
 
-							if (/*(timeslot >= (t1 - 2) && timeslot <= (t2 +2 ))*/ /*timeslot >= m-2 && timeslot <= m+2*/ strcmp(schd_tab[attemptstraightline[h]][3], schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][3]) != 0  && (strcmp(cidpu.c_str(), schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][42]) == 0 || strcmp(schd_tab[attemptstraightline[h]][42], schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][42]) == 0 || (strcmp(schd_tab[attemptstraightline[h]][17], schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][17]) == 0&& strcmp(schd_tab[attemptstraightline[h]][17], "") != 0)))
+							if (/*(timeslot >= (t1 - 2) && timeslot <= (t2 +2 ))*/ /*timeslot >= m-2 && timeslot <= m+2*/ strcmp(schd_tab[attemptstraightline[h]][3], schd_tab[(int)tripNumber(doid, PICKUPIDX)][3]) != 0  && (strcmp(cidpu.c_str(), schd_tab[(int)tripNumber(doid, PICKUPIDX)][42]) == 0 || strcmp(schd_tab[attemptstraightline[h]][42], schd_tab[(int)tripNumber(doid, PICKUPIDX)][42]) == 0 || (strcmp(schd_tab[attemptstraightline[h]][17], schd_tab[(int)tripNumber(doid, PICKUPIDX)][17]) == 0&& strcmp(schd_tab[attemptstraightline[h]][17], "") != 0)))
 							{
 								//   if(DEBUG == 1) gse << "hit a match in the group P " << t1 << " " << t2 << " " <<schd_tab[straightlinetrip][3] << " " << timeslot << " " << schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][3]<< endl;
 								if(DEBUG == 1) gse << "Same pickup cluster " << endl;
@@ -21081,18 +22304,18 @@ void insertGroupTrips(int timeslot, int cluster, int tripidx, int routeidx, bool
 							while (neighborclustersdo != "")
 							{
 
-								if(strcmp(schd_tab[attemptstraightline[h]][3], schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][3]) ==0){
+								if(strcmp(schd_tab[attemptstraightline[h]][3], schd_tab[(int)tripNumber(doid, PICKUPIDX)][3]) ==0){
 									break;
 								}
 								string ciddo = getNextToken(&(neighborclustersdo), ",");
 
 								//   if(DEBUG == 1) gse << "Looping through group " << schd_tab[grouptriparr[h]][3] << " " << ciddo << " " << schd_tab[(ts_tab[m][k][UNASSIGNED][u] + 1)][42] << endl;
-								if (strcmp(schd_tab[attemptstraightline[h]][3], schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][3]) != 0 && (strcmp(ciddo.c_str(), schd_tab[doid][42]) == 0 || strcmp(schd_tab[attemptstraightline[h]+1][42], schd_tab[doid][42]) == 0||(strcmp(schd_tab[attemptstraightline[h]][17], schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][17]) == 0&& strcmp(schd_tab[attemptstraightline[h]][17], "") != 0)))
+								if (strcmp(schd_tab[attemptstraightline[h]][3], schd_tab[(int)tripNumber(doid, PICKUPIDX)][3]) != 0 && (strcmp(ciddo.c_str(), schd_tab[doid][42]) == 0 || strcmp(schd_tab[attemptstraightline[h]+1][42], schd_tab[doid][42]) == 0||(strcmp(schd_tab[attemptstraightline[h]][17], schd_tab[(int)tripNumber(doid, PICKUPIDX)][17]) == 0&& strcmp(schd_tab[attemptstraightline[h]][17], "") != 0)))
 								{
 									if(DEBUG == 1) gse << "Same dropoff cluster " << endl;
 									//  if(DEBUG == 1) gse << "hit a match in the group D " << endl;
 									foundamatchneighborgroupdo = true;
-									if((strcmp(schd_tab[attemptstraightline[h]][17], schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][17]) == 0 && strcmp(schd_tab[attemptstraightline[h]][17], "") != 0)|| (isSameLocation(attemptstraightline[h]+1,doid) && isSameLocation(attemptstraightline[h],(int)to_number(schd_tab[doid][PICKUPIDX]))) || (firstPassOfSlack  && isSameLocation(attemptstraightline[h],(int)to_number(schd_tab[doid][PICKUPIDX])))){
+									if((strcmp(schd_tab[attemptstraightline[h]][17], schd_tab[(int)tripNumber(doid, PICKUPIDX)][17]) == 0 && strcmp(schd_tab[attemptstraightline[h]][17], "") != 0)|| (isSameLocation(attemptstraightline[h]+1,doid) && isSameLocation(attemptstraightline[h],(int)tripNumber(doid, PICKUPIDX))) || (firstPassOfSlack  && isSameLocation(attemptstraightline[h],(int)tripNumber(doid, PICKUPIDX)))){
 										isSameStopLocation = true;
 									}
 									break;
@@ -21114,7 +22337,7 @@ void insertGroupTrips(int timeslot, int cluster, int tripidx, int routeidx, bool
 
 							for (int j = 0; j <  attemptstraightlinecnt; j++)
 							{
-								if (attemptstraightline[j] == (int)to_number(schd_tab[doid][PICKUPIDX]))
+								if (attemptstraightline[j] == (int)tripNumber(doid, PICKUPIDX))
 								{
 									break;
 								}
@@ -21123,8 +22346,8 @@ void insertGroupTrips(int timeslot, int cluster, int tripidx, int routeidx, bool
 
 									bool skiproute = true;
 
-									if( addextracnt < (int)to_number(schd_tab[routeidx][33]))
-										skiproute = skipsegment((int)to_number(schd_tab[doid][PICKUPIDX]), schd_tab[routeidx][0]);
+									if( addextracnt < (int)tripNumber(routeidx, 33))
+										skiproute = skipsegment((int)tripNumber(doid, PICKUPIDX), schd_tab[routeidx][0]);
 
 
 
@@ -21134,19 +22357,19 @@ void insertGroupTrips(int timeslot, int cluster, int tripidx, int routeidx, bool
 										break;
 									}
 
-									if(DEBUG == 1) gse << "v2 Also found and inserting grouped trip because of same pickup/neighboring cluster route : " << schd_tab[doid][0] << " tripid :  "  << schd_tab[doid][3] << " " << timeslot  << " " << timeslot  <<  " " << schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][41] << endl;
-									attemptstraightline[attemptstraightlinecnt] = (int)to_number(schd_tab[doid][PICKUPIDX]);
+									if(DEBUG == 1) gse << "v2 Also found and inserting grouped trip because of same pickup/neighboring cluster route : " << schd_tab[doid][0] << " tripid :  "  << schd_tab[doid][3] << " " << timeslot  << " " << timeslot  <<  " " << schd_tab[(int)tripNumber(doid, PICKUPIDX)][41] << endl;
+									attemptstraightline[attemptstraightlinecnt] = (int)tripNumber(doid, PICKUPIDX);
 									attemptstraightlinecnt++;
-									insertTrip(timeslot, cluster, (int)to_number(schd_tab[doid][PICKUPIDX]), UNASSIGNED);
+									insertTrip(timeslot, cluster, (int)tripNumber(doid, PICKUPIDX), UNASSIGNED);
 									h = -1;
 									addextracnt++;
 									break;
 								}
 								else if(isSameStopLocation){
-									if(DEBUG == 1) gse << "v2 Also found and inserting grouped trip because of same pickup/neighboring cluster route and same lat long : " << schd_tab[doid][0] << " tripid :  "  << schd_tab[doid][3] << " "  <<timeslot  <<  " " << schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][41] << endl;
-									attemptstraightline[attemptstraightlinecnt] = (int)to_number(schd_tab[doid][PICKUPIDX]);
+									if(DEBUG == 1) gse << "v2 Also found and inserting grouped trip because of same pickup/neighboring cluster route and same lat long : " << schd_tab[doid][0] << " tripid :  "  << schd_tab[doid][3] << " "  <<timeslot  <<  " " << schd_tab[(int)tripNumber(doid, PICKUPIDX)][41] << endl;
+									attemptstraightline[attemptstraightlinecnt] = (int)tripNumber(doid, PICKUPIDX);
 									attemptstraightlinecnt++;
-									insertTrip(timeslot, cluster, (int)to_number(schd_tab[doid][PICKUPIDX]), UNASSIGNED);
+									insertTrip(timeslot, cluster, (int)tripNumber(doid, PICKUPIDX), UNASSIGNED);
 									h = -1;
 									addextracnt++;
 									break;
@@ -21218,7 +22441,7 @@ void bubbleSort(int n, int m, int k, int isslack)
 
 
            // if(DEBUG == 1) gse << ts_tab[m][k][j] << " " << j << " Dist " << to_number(schd_tab[ts_tab[m][k][j]][21]) << endl;
-           if (to_number(schd_tab[ts_tab[m][k][isslack][j]][21]) < to_number(schd_tab[ts_tab[m][k][isslack][j+1]][21])){
+           if (tripNumber(ts_tab[m][k][isslack][j], 21) < tripNumber(ts_tab[m][k][isslack][j+1], 21)){
                     temp = ts_tab[m][k][isslack][j];
                     ts_tab[m][k][isslack][j] = ts_tab[m][k][isslack][j+1];
                     ts_tab[m][k][isslack][j+1] = temp;
@@ -21327,7 +22550,7 @@ void create_group(int local_s_tab[], int counter){
 							if(checkcnt == 2){
 								temptravelarray[temptravarraycnt] = local_s_tab[c-1];
 								temptravarraycnt++;
-								temptravelarray[temptravarraycnt] = (int)to_number(schd_tab[local_s_tab[c-1]][PICKUPIDX]);
+								temptravelarray[temptravarraycnt] = (int)tripNumber(local_s_tab[c-1], PICKUPIDX);
 								temptravarraycnt++;
 
 								//  if(DEBUG == 1) gse << " c 1 " << c-1 << endl;
@@ -21355,7 +22578,7 @@ void create_group(int local_s_tab[], int counter){
 							if(checkcnt == 2){
 								temptravelarray[temptravarraycnt] = local_s_tab[c+1];
 								temptravarraycnt++;
-								temptravelarray[temptravarraycnt] = (int)to_number(schd_tab[local_s_tab[c+1]][PICKUPIDX]);
+								temptravelarray[temptravarraycnt] = (int)tripNumber(local_s_tab[c+1], PICKUPIDX);
 								temptravarraycnt++;
 
 								//  if(DEBUG == 1) gse << " c 2 " << c+1 << endl;
@@ -21375,7 +22598,7 @@ void create_group(int local_s_tab[], int counter){
 
 							temptravelarray[temptravarraycnt] = local_s_tab[c];
 							temptravarraycnt++;
-							temptravelarray[temptravarraycnt] = (int)to_number(schd_tab[local_s_tab[c]][PICKUPIDX]);
+							temptravelarray[temptravarraycnt] = (int)tripNumber(local_s_tab[c], PICKUPIDX);
 							temptravarraycnt++;
 
 
@@ -21504,17 +22727,17 @@ void groupsametosame(int doid){
 
 		if(strcmp(schd_tab[g][7],"D")==0 && strcmp(schd_tab[doid][17],"")==0){
 			//  if(DEBUG == 1) gse << "doid is " << g << endl;
-			if(isSameLocation((int)to_number(schd_tab[doid][PICKUPIDX]),(int)to_number(schd_tab[g][PICKUPIDX])) && isSameLocation(doid,g) && (int)to_number(schd_tab[(int)to_number(schd_tab[g][PICKUPIDX])][41]) <= (int)to_number(schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][41])+1 && (int)to_number(schd_tab[(int)to_number(schd_tab[g][PICKUPIDX])][41]) >= (int)to_number(schd_tab[doid][41])-1 &&   (int)to_number(schd_tab[g][41]) <= (int)to_number(schd_tab[doid][41])+1 && (int)to_number(schd_tab[g][41]) >= (int)to_number(schd_tab[doid][41])-1 && strcmp(schd_tab[doid][7],"D")==0 && strcmp(schd_tab[(int)to_number(schd_tab[g][PICKUPIDX])][7],"P")==0  && /*strcmp(schd_tab[doid][0],"")==0 && strcmp(schd_tab[j][0],"")==0 &&*/ (int)to_number(schd_tab[doid][PICKUPIDX]) != (int)to_number(schd_tab[g][PICKUPIDX])  && strcmp(schd_tab[(int)to_number(schd_tab[g][PICKUPIDX])][GROUPNUMBER],"")==0){
+			if(isSameLocation((int)tripNumber(doid, PICKUPIDX),(int)tripNumber(g, PICKUPIDX)) && isSameLocation(doid,g) && (int)tripNumber((int)tripNumber(g, PICKUPIDX), 41) <= (int)tripNumber((int)tripNumber(doid, PICKUPIDX), 41)+1 && (int)tripNumber((int)tripNumber(g, PICKUPIDX), 41) >= (int)tripNumber(doid, 41)-1 &&   (int)tripNumber(g, 41) <= (int)tripNumber(doid, 41)+1 && (int)tripNumber(g, 41) >= (int)tripNumber(doid, 41)-1 && strcmp(schd_tab[doid][7],"D")==0 && strcmp(schd_tab[(int)tripNumber(g, PICKUPIDX)][7],"P")==0  && /*strcmp(schd_tab[doid][0],"")==0 && strcmp(schd_tab[j][0],"")==0 &&*/ (int)tripNumber(doid, PICKUPIDX) != (int)tripNumber(g, PICKUPIDX)  && strcmp(schd_tab[(int)tripNumber(g, PICKUPIDX)][GROUPNUMBER],"")==0){
 				if(DEBUG == 1) gse << "Found a match in grouping " << grpmarker << endl;
-				if(strcmp(schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][GROUPNUMBER],"")==0){
-					strcpy(schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][GROUPNUMBER],to_string(grpmarker).c_str());
-					strcpy(schd_tab[(int)to_number(schd_tab[g][PICKUPIDX])][GROUPNUMBER],to_string(grpmarker).c_str());
+				if(strcmp(schd_tab[(int)tripNumber(doid, PICKUPIDX)][GROUPNUMBER],"")==0){
+					strcpy(schd_tab[(int)tripNumber(doid, PICKUPIDX)][GROUPNUMBER],to_string(grpmarker).c_str());
+					strcpy(schd_tab[(int)tripNumber(g, PICKUPIDX)][GROUPNUMBER],to_string(grpmarker).c_str());
 					strcpy(schd_tab[doid][GROUPNUMBER],to_string(grpmarker).c_str());
 					strcpy(schd_tab[g][GROUPNUMBER],to_string(grpmarker).c_str());
 					grpmarker++;
 				}
 				else{
-					strcpy(schd_tab[(int)to_number(schd_tab[g][PICKUPIDX])][GROUPNUMBER],schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][GROUPNUMBER]);
+					strcpy(schd_tab[(int)tripNumber(g, PICKUPIDX)][GROUPNUMBER],schd_tab[(int)tripNumber(doid, PICKUPIDX)][GROUPNUMBER]);
 					strcpy(schd_tab[g][GROUPNUMBER],schd_tab[doid][GROUPNUMBER]);
 				}
 
@@ -21523,20 +22746,20 @@ void groupsametosame(int doid){
 
 		}
 
-		else if(strcmp(schd_tab[g][7],"D")==0 && strcmp(schd_tab[doid][17],"")!=0 && (int)to_number(schd_tab[g][PICKUPIDX]) != (int)to_number(schd_tab[doid][PICKUPIDX])){
+		else if(strcmp(schd_tab[g][7],"D")==0 && strcmp(schd_tab[doid][17],"")!=0 && (int)tripNumber(g, PICKUPIDX) != (int)tripNumber(doid, PICKUPIDX)){
 
-			if(strcmp(schd_tab[g][17],schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][17])==0 && strcmp(schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][17],"")!=0){
+			if(strcmp(schd_tab[g][17],schd_tab[(int)tripNumber(doid, PICKUPIDX)][17])==0 && strcmp(schd_tab[(int)tripNumber(doid, PICKUPIDX)][17],"")!=0){
 
 				if(DEBUG == 1) gse << "Found a match in grouping actual group " << grpmarker << endl;
-				if(strcmp(schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][GROUPNUMBER],"")==0){
-					strcpy(schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][GROUPNUMBER],to_string(grpmarker).c_str());
-					strcpy(schd_tab[(int)to_number(schd_tab[g][PICKUPIDX])][GROUPNUMBER],to_string(grpmarker).c_str());
+				if(strcmp(schd_tab[(int)tripNumber(doid, PICKUPIDX)][GROUPNUMBER],"")==0){
+					strcpy(schd_tab[(int)tripNumber(doid, PICKUPIDX)][GROUPNUMBER],to_string(grpmarker).c_str());
+					strcpy(schd_tab[(int)tripNumber(g, PICKUPIDX)][GROUPNUMBER],to_string(grpmarker).c_str());
 					strcpy(schd_tab[doid][GROUPNUMBER],to_string(grpmarker).c_str());
 					strcpy(schd_tab[g][GROUPNUMBER],to_string(grpmarker).c_str());
 					grpmarker++;
 				}
 				else{
-					strcpy(schd_tab[(int)to_number(schd_tab[g][PICKUPIDX])][GROUPNUMBER],schd_tab[(int)to_number(schd_tab[doid][PICKUPIDX])][GROUPNUMBER]);
+					strcpy(schd_tab[(int)tripNumber(g, PICKUPIDX)][GROUPNUMBER],schd_tab[(int)tripNumber(doid, PICKUPIDX)][GROUPNUMBER]);
 					strcpy(schd_tab[g][GROUPNUMBER],schd_tab[doid][GROUPNUMBER]);
 				}
 
@@ -21571,10 +22794,10 @@ bool hasoutboundtrip(string tripid){
 			break;
 		}
 		if(strcmp(schd_tab[j][3],tripid.c_str())==0 && strcmp(schd_tab[j][7],"P")==0){
-			puid = (int)to_number(schd_tab[j][20]);
+			puid = (int)tripNumber(j, 20);
 		}
 		else if(strcmp(schd_tab[j][3],tripid.c_str())==0 && strcmp(schd_tab[j][7],"D")==0){
-			doid = (int)to_number(schd_tab[j][20]);
+			doid = (int)tripNumber(j, 20);
 		}
 	}
 
@@ -21614,10 +22837,10 @@ bool hasgrouptrip(string tripid){
 			break;
 		}
 		if(strcmp(schd_tab[j][3],tripid.c_str())==0 && strcmp(schd_tab[j][7],"P")==0){
-			puid = (int)to_number(schd_tab[j][20]);
+			puid = (int)tripNumber(j, 20);
 		}
 		else if(strcmp(schd_tab[j][3],tripid.c_str())==0 && strcmp(schd_tab[j][7],"D")==0){
-			doid = (int)to_number(schd_tab[j][20]);
+			doid = (int)tripNumber(j, 20);
 		}
 	}
 
@@ -21665,11 +22888,11 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 			break;
 		}
 		if(strcmp(schd_tab[j][3],tripid.c_str())==0 && strcmp(schd_tab[j][7],"P")==0){
-			temppuid = (int)to_number(schd_tab[j][20]);
+			temppuid = (int)tripNumber(j, 20);
 
 		}
 		if(strcmp(schd_tab[j][3],tripid.c_str())==0 && strcmp(schd_tab[j][7],"D")==0){
-			tempdoid = (int)to_number(schd_tab[j][20]);
+			tempdoid = (int)tripNumber(j, 20);
 		}
 
 	}
@@ -21747,10 +22970,10 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 
 		for(int j = 1; j < MAXTRIPIDX; j++){
 			if(strcmp(schd_tab[j][3],tripidxarray[z].c_str())==0 && strcmp(schd_tab[j][7],"P")==0){
-				puid = (int)to_number(schd_tab[j][20]);
+				puid = (int)tripNumber(j, 20);
 			}
 			else if(strcmp(schd_tab[j][3],tripidxarray[z].c_str())==0 && strcmp(schd_tab[j][7],"D")==0){
-				doid = (int)to_number(schd_tab[j][20]);
+				doid = (int)tripNumber(j, 20);
 			}
 		}
 
@@ -21836,10 +23059,10 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 				break;
 			}
 			if(strcmp(schd_tab[j][3],tripidxarray[z].c_str())==0 && strcmp(schd_tab[j][7],"P")==0){
-				puid = (int)to_number(schd_tab[j][20]);
+				puid = (int)tripNumber(j, 20);
 			}
 			else if(strcmp(schd_tab[j][3],tripidxarray[z].c_str())==0 && strcmp(schd_tab[j][7],"D")==0){
-				doid = (int)to_number(schd_tab[j][20]);
+				doid = (int)tripNumber(j, 20);
 			}
 		}
 
@@ -21961,37 +23184,37 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 
 					while(u < tripidxarrayindiciescnt) {
 
-						if(DEBUG == 1) gse << u << " out of " << tripidxarrayindiciescnt << " " << (int)to_number(schd_tab[s_tab[m][k]][29]) << "/" << (int)to_number(schd_tab[s_tab[m][k]][4]) << " compared to " << estputime[u] << endl;
+						if(DEBUG == 1) gse << u << " out of " << tripidxarrayindiciescnt << " " << (int)tripNumber(s_tab[m][k], 29) << "/" << (int)tripNumber(s_tab[m][k], 4) << " compared to " << estputime[u] << endl;
 
 
 
-						if((int)to_number(schd_tab[s_tab[m][k]][4]) < estputime[u] && (int)to_number(schd_tab[s_tab[m][k]][2])== (int)to_number(MAXSTOPNUM[0]) ){
+						if((int)tripNumber(s_tab[m][k], 4) < estputime[u] && (int)tripNumber(s_tab[m][k], 2)== (int)to_number(MAXSTOPNUM[0]) ){
 							if(DEBUG == 1) gse << "Passed segment end" << endl;
 							return false;
 						}
 
 						int comparisontime = 0;
-						if((int)to_number(schd_tab[s_tab[m][k]][29]) > (int)to_number(schd_tab[s_tab[m][k]][4])){
-							comparisontime = (int)to_number(schd_tab[s_tab[m][k]][29]);
+						if((int)tripNumber(s_tab[m][k], 29) > (int)tripNumber(s_tab[m][k], 4)){
+							comparisontime = (int)tripNumber(s_tab[m][k], 29);
 						}
 						else{
-							comparisontime = (int)to_number(schd_tab[s_tab[m][k]][4]);
+							comparisontime = (int)tripNumber(s_tab[m][k], 4);
 						}
 
-						if(comparisontime >= estputime[u] && (int)to_number(schd_tab[s_tab[m][k]][2])!= 1 ){
+						if(comparisontime >= estputime[u] && (int)tripNumber(s_tab[m][k], 2)!= 1 ){
 							if(DEBUG == 1) gse << "inserting " << u << endl;
 
-							if(k!= 1 && (int)to_number(schd_tab[s_tab[m][k-1]][2])!= 1 && !isSameLocation(s_tab[m][k], (int)to_number(tripidxarrayindicies[u]))    &&  !isSameLocation(s_tab[m][k],s_tab[m][k-1])){
+							if(k!= 1 && (int)tripNumber(s_tab[m][k-1], 2)!= 1 && !isSameLocation(s_tab[m][k], (int)to_number(tripidxarrayindicies[u]))    &&  !isSameLocation(s_tab[m][k],s_tab[m][k-1])){
 								int l = k;
 								while( l != 1 && isSameLocation(s_tab[m][l], s_tab[m][l-1])){
 									l--;
-									if((int)to_number(schd_tab[s_tab[m][l-1]][2])== 1)
+									if((int)tripNumber(s_tab[m][l-1], 2)== 1)
 										break;
 								}
 								if(DEBUG == 1) gse << " l is " << l << " : k is " << k << endl;
 								k = l;
-								if(((int)to_number(schd_tab[s_tab[m][k]][29])!= 0 && (int)to_number(schd_tab[s_tab[m][k]][29]) < estputime[u])||
-										((int)to_number(schd_tab[s_tab[m][k]][29])== 0 && (int)to_number(schd_tab[s_tab[m][k]][4]) < estputime[u])
+								if(((int)tripNumber(s_tab[m][k], 29)!= 0 && (int)tripNumber(s_tab[m][k], 29) < estputime[u])||
+										((int)tripNumber(s_tab[m][k], 29)== 0 && (int)tripNumber(s_tab[m][k], 4) < estputime[u])
 								){
 									if(DEBUG == 1) gse << "We had to move up because of a group and the first stop in the group that we are inserting before will be late" << endl;
 									return false;
@@ -21999,7 +23222,7 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 							}
 							temproute[h][0] = schd_tab[s_tab[m][1]][0];
 							temproute[h][1] =schd_tab[(int)to_number(tripidxarrayindicies[u])][1];
-							temproute[h][2] = to_string((int)to_number(schd_tab[(int)to_number(temproute[h-1][20])][2])+1) ;
+							temproute[h][2] = to_string((int)tripNumber((int)to_number(temproute[h-1][20]), 2)+1) ;
 							temproute[h][3] = schd_tab[(int)to_number(tripidxarrayindicies[u])][3];
 							temproute[h][4] = schd_tab[(int)to_number(tripidxarrayindicies[u])][4];
 							temproute[h][5] = "Y";
@@ -22021,8 +23244,8 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 							temproute[h][16] =schd_tab[(int)to_number(tripidxarrayindicies[u])][16];
 							temproute[h][17] =schd_tab[(int)to_number(tripidxarrayindicies[u])][17];
 							temproute[h][18] =schd_tab[(int)to_number(tripidxarrayindicies[u])][18];
-							temproute[h][19] = to_string((int)to_number(schd_tab[(int)to_number(temproute[h-1][20])][2])+2) ;
-							temproute[h-1][19] = to_string((int)to_number(schd_tab[(int)to_number(temproute[h-1][20])][2])+1) ;
+							temproute[h][19] = to_string((int)tripNumber((int)to_number(temproute[h-1][20]), 2)+2) ;
+							temproute[h-1][19] = to_string((int)tripNumber((int)to_number(temproute[h-1][20]), 2)+1) ;
 							temproute[h][20] = tripidxarrayindicies[u];
 							temproute[h][21] = schd_tab[(int)to_number(tripidxarrayindicies[u])][21];
 							temproute[h][22] =schd_tab[(int)to_number(tripidxarrayindicies[u])][22];
@@ -22058,7 +23281,7 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 							counter++;
 						}
 
-						else if(u == tripidxarrayindiciescnt || (int)to_number(schd_tab[s_tab[m][k]][4]) < estputime[u] || (int)to_number(schd_tab[s_tab[m][k]][2])== 1){
+						else if(u == tripidxarrayindiciescnt || (int)tripNumber(s_tab[m][k], 4) < estputime[u] || (int)tripNumber(s_tab[m][k], 2)== 1){
 
 							if(strcmp(schd_tab[s_tab[m][k]][2],MAXSTOPNUM[0])==0){
 								// string templatlong = schd_tab[s_tab[m][k]][10];
@@ -22254,29 +23477,7 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 
 				int waitingforosrm = 0;
 
-				while(true){
-					//  if(DEBUG == 1) gse << process_tab[ACCESS][0] << " " << process_tab[LOADDB][0] << endl;
-					if( strcmp(shared_process_tab[WRITINGFB][0],("READY"))==0 ){
-						usleep(100);
-						if( strcmp(shared_process_tab[WRITINGFB][0],("READY"))==0 ){
-							strcpy(shared_process_tab[WRITINGFB][0],running.c_str());
-							break;
-						}
-
-					}
-				}
-
-
-				while(true){ // double check if someone else is currently writing
-					//  if(DEBUG == 1) gse << process_tab[ACCESS][0] << " " << process_tab[LOADDB][0] << endl;
-					if( strcmp(shared_process_tab[WRITINGFB][0],(running.c_str()))==0){
-						break;
-					}
-					else if(strcmp(shared_process_tab[WRITINGFB][0],("READY"))==0){
-						strcpy(shared_process_tab[WRITINGFB][0],running.c_str());
-						usleep(100);
-					}
-				}
+				lockWritingFB(running);
 
 				int q;
 
@@ -22285,27 +23486,16 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 
 					string osrm = temproute[g][10] + "," +temproute[g][37]+ "," +temproute[g][38]+ "," +temproute[g][39];
 
-					for(int d = 0; d < MAXREQUESTS; d++){
-
-						if(requestIsEmpty(d)){
-							usleep(10);
-							if(requestIsEmpty(d)){
-								q = d;
-								break;
-							}
-
-						}
-						if(d+1 == MAXREQUESTS)
-							d = -1;
-					}
+					q = acquireRequest();
 					if(DEBUG == 1) gse << "q is " << q << endl;
 
 					string function = "FindBestDistSINGLE";
 
 					time_t t = time(NULL);
-					struct tm tm = *localtime(&t);
+					struct tm tm;
+					localtime_r(&t, &tm);
 					char timebuffer[100];
-					sprintf(timebuffer, "%s", asctime(&tm));
+					asctime_r(&tm, timebuffer);
 					string localtimestr = timebuffer;
 					localtimestr.erase(std::remove(localtimestr.begin(), localtimestr.end(), '\n'), localtimestr.end());
 
@@ -22317,6 +23507,7 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 					updateRequest(q, osrm, "LATLONG");
 					updateRequest(q, temproute[g][20], "TRIPIDX");
 					updateRequest(q, to_string(NUMBER_OF_EDGES[0]), "NUMBEROFEDGES");
+					submitRequest(q);
 
 
 					waitingforosrm++;
@@ -22324,7 +23515,7 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 				}
 
 
-				strcpy(shared_process_tab[WRITINGFB][0],"READY");
+				unlockWritingFB();
 
 
 
@@ -22333,6 +23524,7 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 				int g = 0;
 				while(true){
 
+					int completionsseen = requestCompletions();
 					for(int q = 0; q < MAXREQUESTS; q++){
 
 						if(fetchRequest(q, "DISTANCE") != "" &&  fetchRequest(q, "TIME") != "" && fetchRequest(q, "ID") == to_string(g) && fetchRequest(q, "NUM") == clientdate && fetchRequest(q, "FUNC") == "FindBestDistSINGLE"){
@@ -22343,8 +23535,6 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 
 							if(DEBUG == 1) gse << fetchRequest(q, "ID") << " " << schd_tab[(int)to_number(fetchRequest(q, "TRIPIDX"))][3] << " " << dist << endl;
 							clearRequest(q);
-							while(!requestIsEmpty(q)){
-							}
 							//f++;
 							g++;
 							datafromosrm++;
@@ -22353,6 +23543,7 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 					}
 					if(datafromosrm == waitingforosrm )
 						break;
+					waitForRequestCompletion(completionsseen);
 				}
 
 
@@ -22718,7 +23909,7 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 					tripid = tripid.substr(0,1);
 					string endtime2;
 					if(tripid == "S"){
-						endtime2 =to_string( (int)itms_to_minutes(ampm2fullhrs(p_promised_time)));
+						endtime2 =to_string( (int)dayMinute(p_promised_time));
 					}
 
 					if(p_stop_type == "P"){
@@ -22798,7 +23989,7 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 					p_bs_occ = std::get<14>(varHolder);
 
 					if(!secondpassinsertedtrip){
-						p_etd =  itms_minutes_to_ampm(itms_to_minutes (ampm2fullhrs (p_etd)) - p_perf_time);
+						p_etd =  itms_minutes_to_ampm(dayMinute(p_etd) - p_perf_time);
 						if (p_stop_num != 1 && p_stop_num != (int)to_number(MAXSTOPNUM[0])) {
 							if (timetostop == 0 && temproute[i][7] == temproute[i-1][7])
 
@@ -22846,27 +24037,27 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 							}
 
 						}
-						p_etd =  itms_minutes_to_ampm(itms_to_minutes (ampm2fullhrs (p_etd)) + p_perf_time);
+						p_etd =  itms_minutes_to_ampm(dayMinute(p_etd) + p_perf_time);
 					}
 					//   if(DEBUG == 1) gse << "ETa2 " << p_eta << " " << p_etd << endl;
 
 					bool changedeta = false;
 
-					if(to_string(itms_to_minutes (ampm2fullhrs (p_eta))) != temproute[i][29])
+					if(to_string(dayMinute(p_eta)) != temproute[i][29])
 						changedeta = true;
 
 
 
 					if(p_stop_type  == "P"){
 						string tripidforwait = temproute[i][3];
-						int DW = getDWByStop (tripidforwait, p_stop_type ,itms_to_minutes (ampm2fullhrs (p_eta)) , itms_to_minutes (ampm2fullhrs (p_etd))  ,(int)to_number(starttime1), p_perf_time);
-						int PW = getPWByStop (tripidforwait,  p_stop_type  ,itms_to_minutes (ampm2fullhrs (p_eta))    , (int)to_number(starttime1));
+						int DW = getDWByStop (tripidforwait, p_stop_type ,dayMinute(p_eta) , dayMinute(p_etd)  ,(int)to_number(starttime1), p_perf_time);
+						int PW = getPWByStop (tripidforwait,  p_stop_type  ,dayMinute(p_eta)    , (int)to_number(starttime1));
 						temproute[i][DWWAIT] = to_string(DW);
 						temproute[i][PWWAIT] = to_string(PW);
 					}
 					else{
 
-						int eta = itms_to_minutes (ampm2fullhrs (p_eta));
+						int eta = dayMinute(p_eta);
 						int etd = (int)to_number(temproute[i-1][30]);
 						int TT = (int)to_number(temproute[i-1][CALCULATEDTIME]);
 						string tripidforwait = temproute[i][3];
@@ -22877,7 +24068,7 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 					}
 
 
-					temproute[i][4] = to_string(itms_to_minutes (ampm2fullhrs ( p_promised_time)));
+					temproute[i][4] = to_string(dayMinute(p_promised_time));
 					temproute[i][22] =est_traveltime1;
 					temproute[i][23] =arrivetime1;
 					temproute[i][24] =departtime1;
@@ -22889,8 +24080,8 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 						temproute[i-1][CALCULATEDTIME] =to_string(p_timetonextstop) ;
 					}
 
-					temproute[i][29] =to_string(itms_to_minutes (ampm2fullhrs (p_eta)));
-					temproute[i][30] =to_string(itms_to_minutes (ampm2fullhrs (p_etd)));
+					temproute[i][29] =to_string(dayMinute(p_eta));
+					temproute[i][30] =to_string(dayMinute(p_etd));
 					//temproute[i][6] = to_string(disttrav);
 					temproute[i][31] =  to_string(p_amb_occ);
 					temproute[i][32] =to_string(p_wc_occ);
@@ -23026,8 +24217,8 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 					}
 
 					if(p_stop_num == (int)to_number(MAXSTOPNUM[0])){
-						endtime1 = to_string((int)itms_to_minutes(ampm2fullhrs(p_promised_time))); // to make sure segments do not go beyond the end'
-						//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)itms_to_minutes(ampm2fullhrs(p_promised_time)) << endl;
+						endtime1 = to_string((int)dayMinute(p_promised_time)); // to make sure segments do not go beyond the end'
+						//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)dayMinute(p_promised_time) << endl;
 					}
 
 					bool preassigntripchange = true;
@@ -23035,10 +24226,10 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 						if(DEBUG == 1) gse << "Preassign is false " << endl;
 						preassigntripchange = false;
 						if ((p_stop_type == "P") && starttime1 != "0" && starttime1 != "" &&   starttime1 != "0000" ) {
-							if( itms_to_minutes(ampm2fullhrs(p_eta))  > (int)to_number(starttime1) + aLatepickup)//p_DIALRIDELATEPICKFACTOR )
+							if( dayMinute(p_eta)  > (int)to_number(starttime1) + aLatepickup)//p_DIALRIDELATEPICKFACTOR )
 							{
-								int dev =  itms_to_minutes(ampm2fullhrs(p_eta)) - ((int)to_number(starttime1) + aLatepickup);
-								if(dev > (int)to_number(schd_tab[(int)to_number(temproute[i][20])][LATEDEVIATION])){
+								int dev =  dayMinute(p_eta) - ((int)to_number(starttime1) + aLatepickup);
+								if(dev > (int)tripNumber((int)to_number(temproute[i][20]), LATEDEVIATION)){
 									if(DEBUG == 1) gse << "Preassign is true " << endl;
 									preassigntripchange = true;
 								}
@@ -23049,11 +24240,11 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 
 						if ((p_stop_type == "D") && (endtime1) != "0" && (endtime1) != "" && (endtime1) != "0000")
 						{
-							if((((itms_to_minutes(ampm2fullhrs(p_eta))) >  (int)to_number(endtime1)) && prom_time != 0))
+							if((((dayMinute(p_eta)) >  (int)to_number(endtime1)) && prom_time != 0))
 							{
 
-								int dev =  itms_to_minutes(ampm2fullhrs(p_eta)) - ((int)to_number(endtime1));
-								if(dev > (int)to_number(schd_tab[(int)to_number(temproute[i][20])][LATEDEVIATION])){
+								int dev =  dayMinute(p_eta) - ((int)to_number(endtime1));
+								if(dev > (int)tripNumber((int)to_number(temproute[i][20]), LATEDEVIATION)){
 									if(DEBUG == 1) gse << "Preassign is true " << endl;
 									preassigntripchange = true;
 								}
@@ -23063,7 +24254,7 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 						}
 
 						if((actualTT > aAllowedTT  && actualTT > 0)){
-							if((actualTT - aAllowedTT) > (int)to_number(schd_tab[(int)to_number(temproute[i][20])][TRVLTIMEDEVIATION])){
+							if((actualTT - aAllowedTT) > (int)tripNumber((int)to_number(temproute[i][20]), TRVLTIMEDEVIATION)){
 								if(DEBUG == 1) gse << "Preassign is true " << endl;
 								preassigntripchange = true;
 							}
@@ -23153,7 +24344,7 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 						/***3. Pickup Window violation *****/
 						if (true && (p_stop_type == "P") && starttime1 != "0" && starttime1 != "" &&   starttime1 != "0000" && (p_stop_num >= aStp )) {
 
-							if( itms_to_minutes(ampm2fullhrs(p_eta))  > (int)to_number(starttime1) + aLatepickup + floor((RELAXCONSTRAINTS[0] - 1)*50) )// p_DIALRIDELATEPICKFACTOR )
+							if( dayMinute(p_eta)  > (int)to_number(starttime1) + aLatepickup + floor((RELAXCONSTRAINTS[0] - 1)*50) )// p_DIALRIDELATEPICKFACTOR )
 							{
 								//   if(DEBUG == 1) gse << "Starttime " << itms_minutes_to_ampm(to_number(starttime1)) << endl;
 								// oDropETA = " Dropoff ETA:  ;" ;
@@ -23209,7 +24400,7 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 						if (true && p_stop_num >=aStp && ((p_stop_type == "D") && (endtime1) != "0" && (endtime1) != "" && (endtime1) != "0000"&& (p_stop_num >= aStp)))
 						{
 
-							if((((itms_to_minutes(ampm2fullhrs(p_eta))) > /*12 +*/ (int)to_number(endtime1) + floor((RELAXCONSTRAINTS[0] - 1)*50)) && prom_time != 0))
+							if((((dayMinute(p_eta)) > /*12 +*/ (int)to_number(endtime1) + floor((RELAXCONSTRAINTS[0] - 1)*50)) && prom_time != 0))
 							{
 
 
@@ -23234,7 +24425,7 @@ bool insertandtrygroup_onsegment(string client, string date,string segment,strin
 									//    if(DEBUG == 1) gse << temproute[p][2] << " \t " << temproute[p][4]  << " \t " << temproute[p][29]  << " \t " << temproute[p][30]  << " \t "  << setprecision(2) << temproute[p][6]  <<  "  \t" << temproute[p][28]  << " \t " << temproute[p][7]  << "\t " << temproute[p][32]  << " \t" << temproute[p][31] << "\t" << temproute[p][13]  << " " << temproute[p][23]  << " " << temproute[p][24]  << " " << temproute[p][8]  << " " << temproute[p][20] <<  " end time: " <<  temproute[p][27]  << endl;
 									//}
 									string tripid4 = temproute[i][3];
-									oResult = "Impact: " +  tripid4 + " will be late: " + to_string((int)itms_to_minutes(ampm2fullhrs(p_eta)) - (int)to_number(endtime1) ) +
+									oResult = "Impact: " +  tripid4 + " will be late: " + to_string((int)dayMinute(p_eta) - (int)to_number(endtime1) ) +
 											" minutes for the " + itms_minutes_to_ampm((int)to_number(endtime1)) + " Appointment";
 									// strcpy( schd_tab[local_s_tab[i]][0] ,"");
 									if(DEBUG == 1) gse <<   oResult <<"\n\n";
@@ -24084,15 +25275,15 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 
 
 			aTravel_Date = schd_tab[local_s_tab[m]][1];
-			aStop_num = (int)to_number(schd_tab[local_s_tab[m]][2]);
+			aStop_num = (int)tripNumber(local_s_tab[m], 2);
 			aStop_type = schd_tab[local_s_tab[m]][7];
-			aPerf_time = (int)to_number(schd_tab[local_s_tab[m]][25]);
-			aPromised_time = (int)to_number(schd_tab[local_s_tab[m]][4]);
-			aETA = (int)to_number(schd_tab[local_s_tab[m]][29]);
-			aETD = (int)to_number(schd_tab[local_s_tab[m]][30]);
-			aEndTime = (int)to_number(schd_tab[local_s_tab[m]][27]);
+			aPerf_time = (int)tripNumber(local_s_tab[m], 25);
+			aPromised_time = (int)tripNumber(local_s_tab[m], 4);
+			aETA = (int)tripNumber(local_s_tab[m], 29);
+			aETD = (int)tripNumber(local_s_tab[m], 30);
+			aEndTime = (int)tripNumber(local_s_tab[m], 27);
 			if(m>0){
-				aTIMETONEXTSTOP = (int)to_number(schd_tab[local_s_tab[m-1]][CALCULATEDTIME]); //because it's technically timeFROMlaststop
+				aTIMETONEXTSTOP = (int)tripNumber(local_s_tab[m-1], CALCULATEDTIME); //because it's technically timeFROMlaststop
 				if(DEBUG == 1) gse << "aTIMETONEXTSTOP " << aTIMETONEXTSTOP << " " <<local_s_tab[m] << " " << CALCULATEDTIME<< " " << schd_tab[local_s_tab[m]][CALCULATEDTIME] <<  endl;
 			}
 			else
@@ -24101,10 +25292,10 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 			aReturn_trip = schd_tab[local_s_tab[m]][18];
 			aDisability = schd_tab[local_s_tab[m]][12];
 			aTripType = schd_tab[local_s_tab[m]][8];
-			index = (int)to_number(schd_tab[local_s_tab[m]][20]);
+			index = (int)tripNumber(local_s_tab[m], 20);
 
 			if( m+1 != counter && local_s_tab[m+1] != 0){
-				nextindex = (int)to_number(schd_tab[local_s_tab[m+1]][20]);
+				nextindex = (int)tripNumber(local_s_tab[m+1], 20);
 				if(DEBUG == 1) gse << "Next index is " << nextindex << endl;
 			}
 			else {
@@ -24112,7 +25303,7 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 			}
 
 			if(m != 0 && local_s_tab[m-1] != 0){
-				previndex = (int)to_number(schd_tab[local_s_tab[m-1]][20]);
+				previndex = (int)tripNumber(local_s_tab[m-1], 20);
 			}
 			else{
 				previndex = 0;
@@ -24149,7 +25340,7 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 					a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip,  pDisability,p_trip_type1);
 
 			int aLatepickup;
-			int aStartTime =  (int)to_number(schd_tab[local_s_tab[m]][26]);
+			int aStartTime =  (int)tripNumber(local_s_tab[m], 26);
 
 			if (pReturn_trip == "Y"){
 				aLatepickup = p_OTHERLATEPICKFACTOR1;
@@ -24252,7 +25443,7 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 									a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip,  pDisability,p_trip_type1);
 
 							int aLatepickup;
-							int aStartTime =  (int)to_number(schd_tab[local_s_tab[m]][26]);
+							int aStartTime =  (int)tripNumber(local_s_tab[m], 26);
 
 							if (pReturn_trip == "Y"){
 								aLatepickup = p_OTHERLATEPICKFACTOR1;
@@ -24334,17 +25525,17 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 							string aStop_type1 = schd_tab[local_s_tab[m+1]][7];
 
 							if(aStop_type1 == "P"){
-								aPwtime = (int)to_number(schd_tab[local_s_tab[m]][26]);
+								aPwtime = (int)tripNumber(local_s_tab[m], 26);
 							}
 							else{
-								aPwtime = (int)to_number(schd_tab[local_s_tab[m]][27]);
+								aPwtime = (int)tripNumber(local_s_tab[m], 27);
 							}
 
-							int eta = (int)to_number(schd_tab[local_s_tab[m+1]][29]);
+							int eta = (int)tripNumber(local_s_tab[m+1], 29);
 							int etd = aETD;
 							int TT = aTIMETONEXTSTOP;
-							int prom_time = (int)to_number(schd_tab[local_s_tab[m+1]][4]);
-							int perf_time = (int)to_number(schd_tab[local_s_tab[m+1]][25]);
+							int prom_time = (int)tripNumber(local_s_tab[m+1], 4);
+							int perf_time = (int)tripNumber(local_s_tab[m+1], 25);
 
 							string tripidforwait = schd_tab[local_s_tab[m+1]][3];
 							int DW = eta - etd + TT;
@@ -24382,17 +25573,17 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 							string aStop_type1 = schd_tab[local_s_tab[m+1]][7];
 
 							if(aStop_type1 == "P"){
-								aPwtime = (int)to_number(schd_tab[local_s_tab[m]][26]);
+								aPwtime = (int)tripNumber(local_s_tab[m], 26);
 							}
 							else{
-								aPwtime = (int)to_number(schd_tab[local_s_tab[m]][27]);
+								aPwtime = (int)tripNumber(local_s_tab[m], 27);
 							}
 
-							int eta = (int)to_number(schd_tab[local_s_tab[m+1]][29]);
+							int eta = (int)tripNumber(local_s_tab[m+1], 29);
 							int etd = aETD;
 							int TT = aTIMETONEXTSTOP;
-							int prom_time = (int)to_number(schd_tab[local_s_tab[m+1]][4]);
-							int perf_time = (int)to_number(schd_tab[local_s_tab[m+1]][25]);
+							int prom_time = (int)tripNumber(local_s_tab[m+1], 4);
+							int perf_time = (int)tripNumber(local_s_tab[m+1], 25);
 
 							string tripidforwait = schd_tab[local_s_tab[m+1]][3];
 							int DW = eta - etd + TT;
@@ -24407,9 +25598,9 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 					}
 				}
 				else {
-					aPrev_etd = (int)to_number(schd_tab[local_s_tab[m]][30]);
-					aPrev_pt = (int)to_number(schd_tab[local_s_tab[m]][25]);
-					aPrev_tt = (int)to_number(schd_tab[local_s_tab[m-1]][CALCULATEDTIME]);
+					aPrev_etd = (int)tripNumber(local_s_tab[m], 30);
+					aPrev_pt = (int)tripNumber(local_s_tab[m], 25);
+					aPrev_tt = (int)tripNumber(local_s_tab[m-1], CALCULATEDTIME);
 					aPrev_eta = aPrev_etd - aPrev_pt;
 					string tripid = schd_tab[local_s_tab[m]][3];
 					strcpy(schd_tab[local_s_tab[m]][29], to_string(aPrev_eta).c_str());
@@ -24419,11 +25610,11 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 				}
 			}
 			else{
-				aPrev_etd = (int)to_number(schd_tab[local_s_tab[m]][30]);
-				aPrev_eta = (int)to_number(schd_tab[local_s_tab[m]][29]);
-				aPrev_pt = (int)to_number(schd_tab[local_s_tab[m]][25]);
+				aPrev_etd = (int)tripNumber(local_s_tab[m], 30);
+				aPrev_eta = (int)tripNumber(local_s_tab[m], 29);
+				aPrev_pt = (int)tripNumber(local_s_tab[m], 25);
 				if(m>0)
-					aPrev_tt = (int)to_number(schd_tab[local_s_tab[m-1]][CALCULATEDTIME]);
+					aPrev_tt = (int)tripNumber(local_s_tab[m-1], CALCULATEDTIME);
 				if(DEBUG == 1) gse << aStop_num << " Not a outbound pickup " << aStop_type << " eta " << itms_minutes_to_ampm(aPrev_eta) << " etd " << itms_minutes_to_ampm(aPrev_etd) << " perf time " << aPrev_pt << " " <<  aPrev_tt << endl;
 
 			}
@@ -24455,32 +25646,32 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 
 
 							aTravel_Date = schd_tab[s_tab[i][m]][1];
-							aStop_num = (int)to_number(schd_tab[s_tab[i][m]][2]);
+							aStop_num = (int)tripNumber(s_tab[i][m], 2);
 							aStop_type = schd_tab[s_tab[i][m]][7];
-							aPerf_time = (int)to_number(schd_tab[s_tab[i][m]][25]);
-							aPromised_time = (int)to_number(schd_tab[s_tab[i][m]][4]);
-							aEndTime = (int)to_number(schd_tab[s_tab[i][m]][27]);
-							aETA = (int)to_number(schd_tab[s_tab[i][m]][29]);
-							aETD = (int)to_number(schd_tab[s_tab[i][m]][30]);
+							aPerf_time = (int)tripNumber(s_tab[i][m], 25);
+							aPromised_time = (int)tripNumber(s_tab[i][m], 4);
+							aEndTime = (int)tripNumber(s_tab[i][m], 27);
+							aETA = (int)tripNumber(s_tab[i][m], 29);
+							aETD = (int)tripNumber(s_tab[i][m], 30);
 							if(m>1)
-								aTIMETONEXTSTOP = (int)to_number(schd_tab[s_tab[i][m-1]][CALCULATEDTIME]); //because it's technically timeFROMlaststop
+								aTIMETONEXTSTOP = (int)tripNumber(s_tab[i][m-1], CALCULATEDTIME); //because it's technically timeFROMlaststop
 								else
 									aTIMETONEXTSTOP = 0;
 							aTripid = schd_tab[s_tab[i][m]][3];
 							aReturn_trip = schd_tab[s_tab[i][m]][18];
 							aDisability = schd_tab[s_tab[i][m]][12];
 							aTripType = schd_tab[s_tab[i][m]][8];
-							index = (int)to_number(schd_tab[s_tab[i][m]][20]);
+							index = (int)tripNumber(s_tab[i][m], 20);
 
 							if(s_tab[i][m+1] != 0 && strcmp(schd_tab[s_tab[i][m]][2],MAXSTOPNUM[0])!=0 && strcmp(schd_tab[s_tab[i][m+1]][2],MAXSTOPNUM[0])!=0){
-								nextindex = (int)to_number(schd_tab[s_tab[i][m+1]][20]);
+								nextindex = (int)tripNumber(s_tab[i][m+1], 20);
 							}
 							else {
 								nextindex = 0;
 							}
 
 							if(m > 1 && strcmp(schd_tab[s_tab[i][m]][2],"1")!=0 && strcmp(schd_tab[s_tab[i][m-1]][2],"1")!=0){
-								previndex = (int)to_number(schd_tab[s_tab[i][m-1]][20]);
+								previndex = (int)tripNumber(s_tab[i][m-1], 20);
 							}
 							else{
 								previndex = 0;
@@ -24517,7 +25708,7 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 									a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip,  pDisability,p_trip_type1);
 
 							int aLatepickup;
-							int aStartTime =  (int)to_number(schd_tab[s_tab[i][m]][26]);
+							int aStartTime =  (int)tripNumber(s_tab[i][m], 26);
 
 							if (pReturn_trip == "Y"){
 								aLatepickup = p_OTHERLATEPICKFACTOR1;
@@ -24649,8 +25840,8 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 											r--;
 										}
 
-										aETA = (int)to_number(schd_tab[s_tab[i][m]][29]);
-										aETD = (int)to_number(schd_tab[s_tab[i][m]][30]);
+										aETA = (int)tripNumber(s_tab[i][m], 29);
+										aETD = (int)tripNumber(s_tab[i][m], 30);
 										aPrev_etd = aETD;
 										aPrev_eta = aETA;
 
@@ -24670,11 +25861,11 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 
 
 										if(s_tab[i][m+1] != 0){
-											int eta = (int)to_number(schd_tab[s_tab[i][m+1]][29]);
+											int eta = (int)tripNumber(s_tab[i][m+1], 29);
 											int etd = aETD;
 											int TT = aTIMETONEXTSTOP;
-											int prom_time = (int)to_number(schd_tab[s_tab[i][m+1]][4]);
-											int perf_time = (int)to_number(schd_tab[s_tab[i][m+1]][25]);
+											int prom_time = (int)tripNumber(s_tab[i][m+1], 4);
+											int perf_time = (int)tripNumber(s_tab[i][m+1], 25);
 
 											string tripidforwait = schd_tab[s_tab[i][m+1]][3];
 											int DW = eta - etd + TT;
@@ -24713,17 +25904,17 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 											string aStop_type1 = schd_tab[s_tab[i][m+1]][7];
 
 											if(aStop_type1 == "P"){
-												aPwtime = (int)to_number(schd_tab[s_tab[i][m]][26]);
+												aPwtime = (int)tripNumber(s_tab[i][m], 26);
 											}
 											else{
-												aPwtime = (int)to_number(schd_tab[s_tab[i][m]][27]);
+												aPwtime = (int)tripNumber(s_tab[i][m], 27);
 											}
 
-											int eta = (int)to_number(schd_tab[s_tab[i][m+1]][29]);
+											int eta = (int)tripNumber(s_tab[i][m+1], 29);
 											int etd = aETD;
 											int TT = aTIMETONEXTSTOP;
-											int prom_time = (int)to_number(schd_tab[s_tab[i][m+1]][4]);
-											int perf_time = (int)to_number(schd_tab[s_tab[i][m+1]][25]);
+											int prom_time = (int)tripNumber(s_tab[i][m+1], 4);
+											int perf_time = (int)tripNumber(s_tab[i][m+1], 25);
 
 											string tripidforwait = schd_tab[s_tab[i][m+1]][3];
 											int DW = eta - etd + TT;
@@ -24739,9 +25930,9 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 									}
 								}
 								else {
-									aPrev_etd = (int)to_number(schd_tab[s_tab[i][m]][30]);
-									aPrev_pt = (int)to_number(schd_tab[s_tab[i][m]][25]);
-									aPrev_tt = (int)to_number(schd_tab[s_tab[i][m-1]][CALCULATEDTIME]);
+									aPrev_etd = (int)tripNumber(s_tab[i][m], 30);
+									aPrev_pt = (int)tripNumber(s_tab[i][m], 25);
+									aPrev_tt = (int)tripNumber(s_tab[i][m-1], CALCULATEDTIME);
 									aPrev_eta = aPrev_etd - aPrev_pt;
 									strcpy(schd_tab[s_tab[i][m]][29], to_string(aPrev_eta).c_str());
 									strcpy(schd_tab[s_tab[i][m]][30], to_string(aPrev_etd).c_str());
@@ -24750,11 +25941,11 @@ void UPDATE_REVERSE_CALCULATE_BATCH(int counter,int * local_s_tab, string a_rout
 								}
 							}
 							else{
-								aPrev_etd = (int)to_number(schd_tab[s_tab[i][m]][30]);
-								aPrev_eta = (int)to_number(schd_tab[s_tab[i][m]][29]);
-								aPrev_pt = (int)to_number(schd_tab[s_tab[i][m]][25]);
+								aPrev_etd = (int)tripNumber(s_tab[i][m], 30);
+								aPrev_eta = (int)tripNumber(s_tab[i][m], 29);
+								aPrev_pt = (int)tripNumber(s_tab[i][m], 25);
 								if(m>1)
-									aPrev_tt = (int)to_number(schd_tab[s_tab[i][m-1]][CALCULATEDTIME]);
+									aPrev_tt = (int)tripNumber(s_tab[i][m-1], CALCULATEDTIME);
 								if(DEBUG == 1) gse << aStop_num << " Not a outbound pickup " << aStop_type << " eta " << itms_minutes_to_ampm(aPrev_eta) << " etd " << itms_minutes_to_ampm(aPrev_etd) << " perf time " << aPrev_pt << " " <<  aPrev_tt << endl;
 
 							}
@@ -24851,20 +26042,20 @@ int reversecalclocal_returnindex(int counter, int * local_s_tab, bool ontime){
 		string starttime1 = schd_tab[local_s_tab[i]][26];
 		string wc_cap1 = schd_tab[local_s_tab[0]][34];
 		string amb_cap1 = schd_tab[local_s_tab[0]][33];
-		if((int)to_number(schd_tab[local_s_tab[0]][20]) == 0 || strcmp(schd_tab[local_s_tab[i]][3],schd_tab[local_s_tab[i]][0])!=0){
+		if((int)tripNumber(local_s_tab[0], 20) == 0 || strcmp(schd_tab[local_s_tab[i]][3],schd_tab[local_s_tab[i]][0])!=0){
 			wc_cap1 = "999";
 			amb_cap1 = "999";
 		}
-		int p_wc_occ = to_number(schd_tab[local_s_tab[i]][32]);
-		int p_amb_occ = to_number(schd_tab[local_s_tab[i]][31]);
-		int p_cs_occ = to_number(schd_tab[local_s_tab[i]][CS_OCC]);
-		int p_bs_occ = to_number(schd_tab[local_s_tab[i]][BS_OCC]);
+		int p_wc_occ = tripNumber(local_s_tab[i], 32);
+		int p_amb_occ = tripNumber(local_s_tab[i], 31);
+		int p_cs_occ = tripNumber(local_s_tab[i], CS_OCC);
+		int p_bs_occ = tripNumber(local_s_tab[i], BS_OCC);
 		int prom_time = (int)to_number(p_promised_time);
 		string est_traveltime1 = schd_tab[local_s_tab[i]][22];
 		string p_return_trip = schd_tab[local_s_tab[i]][18];
-		int p_stop_num = to_number(schd_tab[local_s_tab[i]][2]);
-		int p_eta = to_number(schd_tab[local_s_tab[i]][29]);
-		int p_etd = to_number(schd_tab[local_s_tab[i]][30]);
+		int p_stop_num = tripNumber(local_s_tab[i], 2);
+		int p_eta = tripNumber(local_s_tab[i], 29);
+		int p_etd = tripNumber(local_s_tab[i], 30);
 		string oResult = "";
 		int actualTT;
 		int p_WHEELLOAD1;
@@ -24897,7 +26088,7 @@ int reversecalclocal_returnindex(int counter, int * local_s_tab, bool ontime){
 
 
 
-		double estdisttrip = to_number(schd_tab[local_s_tab[i]][21]);
+		double estdisttrip = tripNumber(local_s_tab[i], 21);
 
 		int aAllowedTT;
 		/*if(to_number(estdist[0]) < 3.0)
@@ -24924,7 +26115,7 @@ int reversecalclocal_returnindex(int counter, int * local_s_tab, bool ontime){
 
 
 		int allowedDW;
-		double esttime = to_number(schd_tab[local_s_tab[i]][22]);
+		double esttime = tripNumber(local_s_tab[i], 22);
 
 		if(estdisttrip < a_mediumshortdistance1){
 			aAllowedTT = a_shorttriptime1 + extratraveltime;
@@ -24950,9 +26141,9 @@ int reversecalclocal_returnindex(int counter, int * local_s_tab, bool ontime){
 
 		if(strcmp(schd_tab[local_s_tab[i]][7],"D")==0 && (tripid2.substr(0,1) == "T" ||  tripid2.substr(0,1) == "R") && p_trip_type2 != "BRK" && p_trip_type2 != "LUNCH" && p_trip_type2 != "ADMIN"){
 
-			int pickupid = (int)to_number(schd_tab[local_s_tab[i]][PICKUPIDX]);
-			int doeta1 = (int)to_number(schd_tab[local_s_tab[i]][30]) - (int)to_number(schd_tab[local_s_tab[i]][25]);
-			int puetd1 = (int)to_number(schd_tab[pickupid][30]);
+			int pickupid = (int)tripNumber(local_s_tab[i], PICKUPIDX);
+			int doeta1 = (int)tripNumber(local_s_tab[i], 30) - (int)tripNumber(local_s_tab[i], 25);
+			int puetd1 = (int)tripNumber(pickupid, 30);
 			int stopafter;
 
 			for(int t = 0; t < counter; t++){
@@ -24979,11 +26170,11 @@ int reversecalclocal_returnindex(int counter, int * local_s_tab, bool ontime){
 			}
 
 
-			if((int)to_number(schd_tab[stopafter][30]) - (int)to_number(schd_tab[stopafter][25])  >= (int)to_number(schd_tab[pickupid][4]) + aLatepickup+ (int)to_number(schd_tab[pickupid][25]) + (int)to_number(schd_tab[pickupid][CALCULATEDTIME])){
+			if((int)tripNumber(stopafter, 30) - (int)tripNumber(stopafter, 25)  >= (int)tripNumber(pickupid, 4) + aLatepickup+ (int)tripNumber(pickupid, 25) + (int)tripNumber(pickupid, CALCULATEDTIME)){
 
-				puetd1 = (int)to_number(schd_tab[pickupid][4]) + aLatepickup+ (int)to_number(schd_tab[pickupid][25]);
+				puetd1 = (int)tripNumber(pickupid, 4) + aLatepickup+ (int)tripNumber(pickupid, 25);
 
-				if(DEBUG == 1) gse << "Changing puetd to " << puetd1 << " " << (int)to_number(schd_tab[stopafter][30]) << "  " <<  (int)to_number(schd_tab[stopafter][25]) <<  endl;
+				if(DEBUG == 1) gse << "Changing puetd to " << puetd1 << " " << (int)tripNumber(stopafter, 30) << "  " <<  (int)tripNumber(stopafter, 25) <<  endl;
 			}
 
 
@@ -25009,7 +26200,7 @@ int reversecalclocal_returnindex(int counter, int * local_s_tab, bool ontime){
 
 		if(p_stop_num == (int)to_number(MAXSTOPNUM[0]) && i+1 == counter){
 			endtime1 = p_promised_time; // to make sure segments do not go beyond the end'
-			//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)itms_to_minutes(ampm2fullhrs(p_promised_time)) << endl;
+			//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)dayMinute(p_promised_time) << endl;
 		}
 
 		bool preassigntripchange = true;
@@ -25019,7 +26210,7 @@ int reversecalclocal_returnindex(int counter, int * local_s_tab, bool ontime){
 				if( p_eta  > (int)to_number(starttime1) + aLatepickup)//p_DIALRIDELATEPICKFACTOR )
 				{
 					int dev =  p_eta - ((int)to_number(starttime1) + aLatepickup);
-					if(dev > (int)to_number(schd_tab[local_s_tab[i]][LATEDEVIATION])){
+					if(dev > (int)tripNumber(local_s_tab[i], LATEDEVIATION)){
 						preassigntripchange = true;
 					}
 
@@ -25033,7 +26224,7 @@ int reversecalclocal_returnindex(int counter, int * local_s_tab, bool ontime){
 				{
 
 					int dev =  p_eta - ((int)to_number(endtime1));
-					if(dev > (int)to_number(schd_tab[local_s_tab[i]][LATEDEVIATION])){
+					if(dev > (int)tripNumber(local_s_tab[i], LATEDEVIATION)){
 						preassigntripchange = true;
 					}
 
@@ -25042,8 +26233,8 @@ int reversecalclocal_returnindex(int counter, int * local_s_tab, bool ontime){
 			}
 
 			if((actualTT > aAllowedTT  && actualTT > 0)){
-				if((actualTT - aAllowedTT) > (int)to_number(schd_tab[local_s_tab[i]][TRVLTIMEDEVIATION])){
-					if(DEBUG == 1) gse << "The dev is " << (int)to_number(schd_tab[local_s_tab[i]][TRVLTIMEDEVIATION]) << endl;
+				if((actualTT - aAllowedTT) > (int)tripNumber(local_s_tab[i], TRVLTIMEDEVIATION)){
+					if(DEBUG == 1) gse << "The dev is " << (int)tripNumber(local_s_tab[i], TRVLTIMEDEVIATION) << endl;
 					preassigntripchange = true;
 				}
 			}
@@ -25208,7 +26399,7 @@ int reversecalclocal_returnindex(int counter, int * local_s_tab, bool ontime){
 
 
 
-			if((i>0 &&  ((int)to_number(schd_tab[local_s_tab[i-1]][31]) > 0 || (int)to_number(schd_tab[local_s_tab[i-1]][32]) > 0) && strcmp(schd_tab[local_s_tab[i]][0],"")==0 && strcmp(schd_tab[local_s_tab[i-1]][3],schd_tab[local_s_tab[i-1]][0])!=0 && strcmp(schd_tab[local_s_tab[i]][3],schd_tab[local_s_tab[i-1]][3])!=0  && p_stop_type == "P" &&  (int)to_number(schd_tab[local_s_tab[i]][DWWAIT]) > allowedDW + floor((RELAXCONSTRAINTS[0] - 1)*50) /*60*/ && (int)to_number(schd_tab[local_s_tab[i]][DWWAIT]) > 0)){
+			if((i>0 &&  ((int)tripNumber(local_s_tab[i-1], 31) > 0 || (int)tripNumber(local_s_tab[i-1], 32) > 0) && strcmp(schd_tab[local_s_tab[i]][0],"")==0 && strcmp(schd_tab[local_s_tab[i-1]][3],schd_tab[local_s_tab[i-1]][0])!=0 && strcmp(schd_tab[local_s_tab[i]][3],schd_tab[local_s_tab[i-1]][3])!=0  && p_stop_type == "P" &&  (int)tripNumber(local_s_tab[i], DWWAIT) > allowedDW + floor((RELAXCONSTRAINTS[0] - 1)*50) /*60*/ && (int)tripNumber(local_s_tab[i], DWWAIT) > 0)){
 				string tripid = schd_tab[local_s_tab[i]][3];
 				oResult = "Impact: Passenger wait violation: " + tripid  + " PW: " + schd_tab[local_s_tab[i]][DWWAIT] + " Allowed: " + to_string(allowedDW) + " dist " + to_string(estdisttrip) + " Seg: " + schd_tab[local_s_tab[i]][0] + "\n";
 				if(DEBUG == 1) gse <<  oResult <<"\n\n";
@@ -25473,19 +26664,19 @@ bool reversecalclocal_TEMPARRAY(int counter, string (* temproute)[MAXSTOPS][TRIP
 
 		if(p_stop_num == (int)to_number(MAXSTOPNUM[0]) && i+1 == counter){
 			endtime1 = p_promised_time; // to make sure segments do not go beyond the end'
-			//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)itms_to_minutes(ampm2fullhrs(p_promised_time)) << endl;
+			//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)dayMinute(p_promised_time) << endl;
 		}
 
 		bool preassigntripchange = true;
 
 
-		if((int)to_number(schd_tab[(int)to_number((*temproute)[i][20])][LATEDEVIATION])!=0 || (int)to_number(schd_tab[(int)to_number((*temproute)[i][20])][TRVLTIMEDEVIATION])!=0){
+		if((int)tripNumber((int)to_number((*temproute)[i][20]), LATEDEVIATION)!=0 || (int)tripNumber((int)to_number((*temproute)[i][20]), TRVLTIMEDEVIATION)!=0){
 			preassigntripchange = false;
 			if ((p_stop_type == "P") && starttime1 != "0" && starttime1 != "" &&   starttime1 != "0000" ) {
 				if( p_eta  > (int)to_number(starttime1) + aLatepickup)//p_DIALRIDELATEPICKFACTOR )
 				{
 					int dev =  p_eta - ((int)to_number(starttime1) + aLatepickup);
-					if(dev > (int)to_number(schd_tab[(int)to_number((*temproute)[i][20])][LATEDEVIATION])){
+					if(dev > (int)tripNumber((int)to_number((*temproute)[i][20]), LATEDEVIATION)){
 						preassigntripchange = true;
 					}
 
@@ -25499,7 +26690,7 @@ bool reversecalclocal_TEMPARRAY(int counter, string (* temproute)[MAXSTOPS][TRIP
 				{
 
 					int dev =  p_eta - ((int)to_number(endtime1));
-					if(dev > (int)to_number(schd_tab[(int)to_number((*temproute)[i][20])][LATEDEVIATION])){
+					if(dev > (int)tripNumber((int)to_number((*temproute)[i][20]), LATEDEVIATION)){
 						preassigntripchange = true;
 					}
 
@@ -25508,8 +26699,8 @@ bool reversecalclocal_TEMPARRAY(int counter, string (* temproute)[MAXSTOPS][TRIP
 			}
 
 			if((actualTT > aAllowedTT  && actualTT > 0)){
-				if((actualTT - aAllowedTT) > (int)to_number(schd_tab[(int)to_number((*temproute)[i][20])][TRVLTIMEDEVIATION])){
-					if(DEBUG == 1) gse << "The dev is " << (int)to_number(schd_tab[(int)to_number((*temproute)[i][20])][TRVLTIMEDEVIATION]) << endl;
+				if((actualTT - aAllowedTT) > (int)tripNumber((int)to_number((*temproute)[i][20]), TRVLTIMEDEVIATION)){
+					if(DEBUG == 1) gse << "The dev is " << (int)tripNumber((int)to_number((*temproute)[i][20]), TRVLTIMEDEVIATION) << endl;
 					preassigntripchange = true;
 				}
 			}
@@ -25761,20 +26952,20 @@ bool reversecalclocal(int counter, int * local_s_tab, bool ontime){
 		string starttime1 = schd_tab[local_s_tab[i]][26];
 		string wc_cap1 = schd_tab[local_s_tab[0]][34];
 		string amb_cap1 = schd_tab[local_s_tab[0]][33];
-		if((int)to_number(schd_tab[local_s_tab[0]][20]) == 0 || strcmp(schd_tab[local_s_tab[i]][3],schd_tab[local_s_tab[i]][0])!=0){
+		if((int)tripNumber(local_s_tab[0], 20) == 0 || strcmp(schd_tab[local_s_tab[i]][3],schd_tab[local_s_tab[i]][0])!=0){
 			wc_cap1 = "999";
 			amb_cap1 = "999";
 		}
-		int p_wc_occ = to_number(schd_tab[local_s_tab[i]][32]);
-		int p_amb_occ = to_number(schd_tab[local_s_tab[i]][31]);
-		int p_cs_occ = to_number(schd_tab[local_s_tab[i]][CS_OCC]);
-		int p_bs_occ = to_number(schd_tab[local_s_tab[i]][BS_OCC]);
+		int p_wc_occ = tripNumber(local_s_tab[i], 32);
+		int p_amb_occ = tripNumber(local_s_tab[i], 31);
+		int p_cs_occ = tripNumber(local_s_tab[i], CS_OCC);
+		int p_bs_occ = tripNumber(local_s_tab[i], BS_OCC);
 		int prom_time = (int)to_number(p_promised_time);
 		string est_traveltime1 = schd_tab[local_s_tab[i]][22];
 		string p_return_trip = schd_tab[local_s_tab[i]][18];
-		int p_stop_num = to_number(schd_tab[local_s_tab[i]][2]);
-		int p_eta = to_number(schd_tab[local_s_tab[i]][29]);
-		int p_etd = to_number(schd_tab[local_s_tab[i]][30]);
+		int p_stop_num = tripNumber(local_s_tab[i], 2);
+		int p_eta = tripNumber(local_s_tab[i], 29);
+		int p_etd = tripNumber(local_s_tab[i], 30);
 		string oResult = "";
 		int actualTT;
 		int p_WHEELLOAD1;
@@ -25807,7 +26998,7 @@ bool reversecalclocal(int counter, int * local_s_tab, bool ontime){
 
 
 
-		double estdisttrip = to_number(schd_tab[local_s_tab[i]][21]);
+		double estdisttrip = tripNumber(local_s_tab[i], 21);
 
 		int aAllowedTT;
 		/*if(to_number(estdist[0]) < 3.0)
@@ -25834,7 +27025,7 @@ bool reversecalclocal(int counter, int * local_s_tab, bool ontime){
 
 
 		int allowedDW;
-		double esttime = to_number(schd_tab[local_s_tab[i]][22]);
+		double esttime = tripNumber(local_s_tab[i], 22);
 
 		if(estdisttrip < a_mediumshortdistance1){
 			aAllowedTT = a_shorttriptime1 + extratraveltime;
@@ -25860,9 +27051,9 @@ bool reversecalclocal(int counter, int * local_s_tab, bool ontime){
 
 		if(strcmp(schd_tab[local_s_tab[i]][7],"D")==0 && (tripid2.substr(0,1) == "T" ||  tripid2.substr(0,1) == "R") && p_trip_type2 != "BRK" && p_trip_type2 != "LUNCH" && p_trip_type2 != "ADMIN" && i != 0 && i+1!=counter){
 
-			int pickupid = (int)to_number(schd_tab[local_s_tab[i]][PICKUPIDX]);
-			int doeta1 = (int)to_number(schd_tab[local_s_tab[i]][30]) - (int)to_number(schd_tab[local_s_tab[i]][25]);
-			int puetd1 = (int)to_number(schd_tab[pickupid][30]);
+			int pickupid = (int)tripNumber(local_s_tab[i], PICKUPIDX);
+			int doeta1 = (int)tripNumber(local_s_tab[i], 30) - (int)tripNumber(local_s_tab[i], 25);
+			int puetd1 = (int)tripNumber(pickupid, 30);
 			int stopafter;
 
 			for(int t = 0; t < counter; t++){
@@ -25889,11 +27080,11 @@ bool reversecalclocal(int counter, int * local_s_tab, bool ontime){
 			}
 
 
-			if((int)to_number(schd_tab[stopafter][30]) - (int)to_number(schd_tab[stopafter][25])  >= (int)to_number(schd_tab[pickupid][4]) + aLatepickup+ (int)to_number(schd_tab[pickupid][25]) + (int)to_number(schd_tab[pickupid][CALCULATEDTIME])){
+			if((int)tripNumber(stopafter, 30) - (int)tripNumber(stopafter, 25)  >= (int)tripNumber(pickupid, 4) + aLatepickup+ (int)tripNumber(pickupid, 25) + (int)tripNumber(pickupid, CALCULATEDTIME)){
 
-				puetd1 = (int)to_number(schd_tab[pickupid][4]) + aLatepickup+ (int)to_number(schd_tab[pickupid][25]);
+				puetd1 = (int)tripNumber(pickupid, 4) + aLatepickup+ (int)tripNumber(pickupid, 25);
 
-				if(DEBUG == 1) gse << "Changing puetd to " << puetd1 << " " << (int)to_number(schd_tab[stopafter][30]) << "  " <<  (int)to_number(schd_tab[stopafter][25]) <<  endl;
+				if(DEBUG == 1) gse << "Changing puetd to " << puetd1 << " " << (int)tripNumber(stopafter, 30) << "  " <<  (int)tripNumber(stopafter, 25) <<  endl;
 			}
 
 
@@ -25919,7 +27110,7 @@ bool reversecalclocal(int counter, int * local_s_tab, bool ontime){
 
 		if(p_stop_num == (int)to_number(MAXSTOPNUM[0]) && i+1 == counter){
 			endtime1 = p_promised_time; // to make sure segments do not go beyond the end'
-			//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)itms_to_minutes(ampm2fullhrs(p_promised_time)) << endl;
+			//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)dayMinute(p_promised_time) << endl;
 		}
 
 		bool preassigntripchange = true;
@@ -25929,7 +27120,7 @@ bool reversecalclocal(int counter, int * local_s_tab, bool ontime){
 				if( p_eta  > (int)to_number(starttime1) + aLatepickup)//p_DIALRIDELATEPICKFACTOR )
 				{
 					int dev =  p_eta - ((int)to_number(starttime1) + aLatepickup);
-					if(dev > (int)to_number(schd_tab[local_s_tab[i]][LATEDEVIATION])){
+					if(dev > (int)tripNumber(local_s_tab[i], LATEDEVIATION)){
 						preassigntripchange = true;
 					}
 
@@ -25943,7 +27134,7 @@ bool reversecalclocal(int counter, int * local_s_tab, bool ontime){
 				{
 
 					int dev =  p_eta - ((int)to_number(endtime1));
-					if(dev > (int)to_number(schd_tab[local_s_tab[i]][LATEDEVIATION])){
+					if(dev > (int)tripNumber(local_s_tab[i], LATEDEVIATION)){
 						preassigntripchange = true;
 					}
 
@@ -25952,8 +27143,8 @@ bool reversecalclocal(int counter, int * local_s_tab, bool ontime){
 			}
 
 			if((actualTT > aAllowedTT  && actualTT > 0)){
-				if((actualTT - aAllowedTT) > (int)to_number(schd_tab[local_s_tab[i]][TRVLTIMEDEVIATION])){
-					if(DEBUG == 1) gse << "The dev is " << (int)to_number(schd_tab[local_s_tab[i]][TRVLTIMEDEVIATION]) << endl;
+				if((actualTT - aAllowedTT) > (int)tripNumber(local_s_tab[i], TRVLTIMEDEVIATION)){
+					if(DEBUG == 1) gse << "The dev is " << (int)tripNumber(local_s_tab[i], TRVLTIMEDEVIATION) << endl;
 					preassigntripchange = true;
 				}
 			}
@@ -26092,7 +27283,7 @@ bool reversecalclocal(int counter, int * local_s_tab, bool ontime){
 
 
 
-			if((i>0 &&  ((int)to_number(schd_tab[local_s_tab[i-1]][31]) > 0 || (int)to_number(schd_tab[local_s_tab[i-1]][32]) > 0) && strcmp(schd_tab[local_s_tab[i]][0],"")==0 && strcmp(schd_tab[local_s_tab[i-1]][3],schd_tab[local_s_tab[i-1]][0])!=0 && strcmp(schd_tab[local_s_tab[i]][3],schd_tab[local_s_tab[i-1]][3])!=0  && p_stop_type == "P" &&  (int)to_number(schd_tab[local_s_tab[i]][DWWAIT]) > allowedDW + floor((RELAXCONSTRAINTS[0] - 1)*50) /*60*/ && (int)to_number(schd_tab[local_s_tab[i]][DWWAIT]) > 0)){
+			if((i>0 &&  ((int)tripNumber(local_s_tab[i-1], 31) > 0 || (int)tripNumber(local_s_tab[i-1], 32) > 0) && strcmp(schd_tab[local_s_tab[i]][0],"")==0 && strcmp(schd_tab[local_s_tab[i-1]][3],schd_tab[local_s_tab[i-1]][0])!=0 && strcmp(schd_tab[local_s_tab[i]][3],schd_tab[local_s_tab[i-1]][3])!=0  && p_stop_type == "P" &&  (int)tripNumber(local_s_tab[i], DWWAIT) > allowedDW + floor((RELAXCONSTRAINTS[0] - 1)*50) /*60*/ && (int)tripNumber(local_s_tab[i], DWWAIT) > 0)){
 				string tripid = schd_tab[local_s_tab[i]][3];
 				oResult = "Impact: Passenger wait violation: " + tripid  + " PW: " + schd_tab[local_s_tab[i]][DWWAIT] + " Allowed: " + to_string(allowedDW) + " dist " + to_string(estdisttrip) + " Seg: " + schd_tab[local_s_tab[i]][0] + "\n";
 				if(DEBUG == 1) gse <<  oResult <<"\n\n";
@@ -26393,14 +27584,11 @@ estdist[0] = schd_tab[puid][21];*/
 		if(DEBUG == 1) gse << "Segment is " << segment << endl;
 		routeint = (int)to_number(segment.substr(1, segment.length()));
 
-		for(int i = 0; i < MAXSEGMENTS; i++){
-			if(s_tab[i][0] == routeint){
-				index = s_tab[i][1];
-				break;
-			}
-		}
-		cap = (int)to_number(schd_tab[index][33]);
-		wccap = (int)to_number(schd_tab[index][34]);
+		int segment = findSegment(routeint);
+		if(segment >= 0)
+			index = s_tab[segment][1];
+		cap = (int)tripNumber(index, 33);
+		wccap = (int)tripNumber(index, 34);
 		getCS_CY_cap(cscap, bscap, schd_tab[index][SEGMENTTYPE]);
 	}
 
@@ -26468,8 +27656,8 @@ estdist[0] = schd_tab[puid][21];*/
 				// temp = schd_tab[local_s_tab[i]][12];
 				amb_occ1 =  schd_tab[local_s_tab[i]][31];
 				wc_occ1 =  schd_tab[local_s_tab[i]][32];
-				p_cs_occ = (int)to_number(schd_tab[local_s_tab[i]][CS_OCC]);
-				p_bs_occ = (int)to_number(schd_tab[local_s_tab[i]][BS_OCC]);
+				p_cs_occ = (int)tripNumber(local_s_tab[i], CS_OCC);
+				p_bs_occ = (int)tripNumber(local_s_tab[i], BS_OCC);
 				amb_cap1 =  to_string(cap);
 				cs_cap = cscap;
 				bs_cap = bscap;
@@ -26490,12 +27678,12 @@ estdist[0] = schd_tab[puid][21];*/
 				p_name = schd_tab[local_s_tab[i]][14];
 				p_return_trip = schd_tab[local_s_tab[i]][18];
 				p_stop_type = schd_tab[local_s_tab[i]][7];
-				p_esc = (int)to_number(schd_tab[local_s_tab[i]][13]);
+				p_esc = (int)tripNumber(local_s_tab[i], 13);
 				p_stop_num = 1;
 				//    if(DEBUG == 1) gse << "The segment is  " << p_td_segmentid << " " <<  schd_tab[local_s_tab[SEGSTART]][0] << endl;
 				//  if(DEBUG == 1) gse << "STop num " << p_stop_num<< endl;
 				p_citytown =  schd_tab[local_s_tab[i]][11];
-				estdisttrip = to_number(schd_tab[local_s_tab[i]][21]);
+				estdisttrip = tripNumber(local_s_tab[i], 21);
 				p_td_segmentid = "STEST";
 
 				if (p_stop_num == 1 ){
@@ -26680,8 +27868,8 @@ estdist[0] = schd_tab[puid][21];*/
 				// temp = schd_tab[local_s_tab[i]][12];
 				amb_occ1 =  schd_tab[local_s_tab[i]][31];
 				wc_occ1 =  schd_tab[local_s_tab[i]][32];
-				p_cs_occ =  to_number(schd_tab[local_s_tab[i]][CS_OCC]);
-				p_bs_occ =  to_number(schd_tab[local_s_tab[i]][BS_OCC]);
+				p_cs_occ =  tripNumber(local_s_tab[i], CS_OCC);
+				p_bs_occ =  tripNumber(local_s_tab[i], BS_OCC);
 				amb_cap1 =  to_string(cap);
 				cs_cap = cscap;
 				bs_cap = bscap;
@@ -26702,11 +27890,11 @@ estdist[0] = schd_tab[puid][21];*/
 				p_name = schd_tab[local_s_tab[i]][14];
 				p_return_trip = schd_tab[local_s_tab[i]][18];
 				p_stop_type = schd_tab[local_s_tab[i]][7];
-				p_esc = (int)to_number(schd_tab[local_s_tab[i]][13]);
+				p_esc = (int)tripNumber(local_s_tab[i], 13);
 				//    if(DEBUG == 1) gse << "The segment is  " << p_td_segmentid << " " <<  schd_tab[local_s_tab[SEGSTART]][0] << endl;
 				//  if(DEBUG == 1) gse << "STop num " << p_stop_num<< endl;
 				p_citytown =  schd_tab[local_s_tab[i]][11];
-				estdisttrip = to_number(schd_tab[local_s_tab[i]][21]);
+				estdisttrip = tripNumber(local_s_tab[i], 21);
 				p_stop_num =  (int)to_number(MAXSTOPNUM[0]);
 				p_td_segmentid = "STEST";
 
@@ -26830,8 +28018,8 @@ estdist[0] = schd_tab[puid][21];*/
 			// temp = schd_tab[local_s_tab[i]][12];
 			amb_occ1 =  schd_tab[local_s_tab[i]][31];
 			wc_occ1 =  schd_tab[local_s_tab[i]][32];
-			p_cs_occ =  to_number(schd_tab[local_s_tab[i]][CS_OCC]);
-			p_bs_occ =  to_number(schd_tab[local_s_tab[i]][BS_OCC]);
+			p_cs_occ =  tripNumber(local_s_tab[i], CS_OCC);
+			p_bs_occ =  tripNumber(local_s_tab[i], BS_OCC);
 			amb_cap1 =  to_string(cap);
 			cs_cap = cscap;
 			bs_cap = bscap;
@@ -26852,7 +28040,7 @@ estdist[0] = schd_tab[puid][21];*/
 			p_name = schd_tab[local_s_tab[i]][14];
 			p_return_trip = schd_tab[local_s_tab[i]][18];
 			p_stop_type = schd_tab[local_s_tab[i]][7];
-			p_esc = (int)to_number(schd_tab[local_s_tab[i]][13]);
+			p_esc = (int)tripNumber(local_s_tab[i], 13);
 
 			if(!secondpassinsertedtrip){
 				p_stop_num = p_stop_num + 1;
@@ -26863,7 +28051,7 @@ estdist[0] = schd_tab[puid][21];*/
 			//    if(DEBUG == 1) gse << "The segment is  " << p_td_segmentid << " " <<  schd_tab[local_s_tab[SEGSTART]][0] << endl;
 			//  if(DEBUG == 1) gse << "STop num " << p_stop_num<< endl;
 			p_citytown =  schd_tab[local_s_tab[i]][11];
-			estdisttrip = to_number(schd_tab[local_s_tab[i]][21]);
+			estdisttrip = tripNumber(local_s_tab[i], 21);
 
 		}
 		prev_distance = 0;
@@ -26917,13 +28105,13 @@ estdist[0] = schd_tab[puid][21];*/
 				p_MAXEARLYDROPOFFFACTOR1, p_DIALRIDEEARLYPICKFACTOR1, p_DIALRIDELATEPICKFACTOR1, p_OTHEREARLYPICKFACTOR1,  p_OTHERLATEPICKFACTOR1,IGNOREPUTIMES1, p_SHORTBREAK1, p_LUNCHBREAK1,  p_PROXIMITYFACTOR1,  a_mediumshortdistance1, a_mediumlongdistance1, a_shorttriptime1,
 				a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip,  pDisability,p_trip_type1);
 
-		double estdisttrip = to_number(schd_tab[local_s_tab[i]][21]);
+		double estdisttrip = tripNumber(local_s_tab[i], 21);
 
 		int aAllowedTT;
 
 
 		int allowedDW;
-		double esttime = to_number(schd_tab[local_s_tab[i]][22]);
+		double esttime = tripNumber(local_s_tab[i], 22);
 
 		if(estdisttrip < a_mediumshortdistance1){
 			aAllowedTT = a_shorttriptime1 + extratraveltime;
@@ -26953,7 +28141,7 @@ estdist[0] = schd_tab[puid][21];*/
 		tripid = tripid.substr(0,1);
 		string endtime2;
 		if(tripid == "S"){
-			endtime2 =to_string( (int)itms_to_minutes(ampm2fullhrs(p_promised_time)));
+			endtime2 =to_string( (int)dayMinute(p_promised_time));
 		}
 
 		if(p_stop_type == "P"){
@@ -27054,7 +28242,7 @@ estdist[0] = schd_tab[puid][21];*/
 		p_perf_time = std::get<12>(varHolder);
 
 		if(!secondpassinsertedtrip){
-			p_etd =  itms_minutes_to_ampm(itms_to_minutes (ampm2fullhrs (p_etd)) - p_perf_time);
+			p_etd =  itms_minutes_to_ampm(dayMinute(p_etd) - p_perf_time);
 
 			if (p_stop_num != 1 && p_stop_num != (int)to_number(MAXSTOPNUM[0])) {
 				if (prev_distance == 0 && strcmp(schd_tab[local_s_tab[i]][7],schd_tab[local_s_tab[i-1]][7])==0)
@@ -27103,7 +28291,7 @@ estdist[0] = schd_tab[puid][21];*/
 				}
 
 			}
-			p_etd =  itms_minutes_to_ampm(itms_to_minutes (ampm2fullhrs (p_etd)) + p_perf_time);
+			p_etd =  itms_minutes_to_ampm(dayMinute(p_etd) + p_perf_time);
 		}
 
 
@@ -27134,15 +28322,15 @@ estdist[0] = schd_tab[puid][21];*/
 
 		//if(i != 0 && i+1 != counter){
 		if(local_s_tab[i] != 0){
-			strcpy(  schd_tab[local_s_tab[i]][29] ,to_string(itms_to_minutes (ampm2fullhrs (p_eta))).c_str());
-			strcpy(  schd_tab[local_s_tab[i]][30] ,to_string(itms_to_minutes (ampm2fullhrs (p_etd))).c_str());
+			strcpy(  schd_tab[local_s_tab[i]][29] ,to_string(dayMinute(p_eta)).c_str());
+			strcpy(  schd_tab[local_s_tab[i]][30] ,to_string(dayMinute(p_etd)).c_str());
 			strcpy(  schd_tab[local_s_tab[i]][CALCULATEDTIME] ,to_string(p_timetonextstop).c_str());
 			strcpy(  schd_tab[local_s_tab[i]][25] ,to_string(p_perf_time).c_str());
 		}
 
 
 
-		prev_eta1 = to_string(itms_to_minutes (ampm2fullhrs (p_eta)));
+		prev_eta1 = to_string(dayMinute(p_eta));
 		prev_eta = (int)to_number(prev_eta1);
 		prev_eta1 = itms_minutes_to_ampm(prev_eta);
 
@@ -27179,7 +28367,7 @@ estdist[0] = schd_tab[puid][21];*/
 		prev_p_perf_time = (int)to_number(prev_perftime1);
 
 
-		prev_etd1 =to_string(itms_to_minutes (ampm2fullhrs (p_etd))); /// fix this hack in get next token
+		prev_etd1 =to_string(dayMinute(p_etd)); /// fix this hack in get next token
 		prev_etd = (int)to_number(prev_etd1);
 		prev_etd1 = itms_minutes_to_ampm(prev_etd);
 		//temp = temproute[i][12];
@@ -27253,7 +28441,7 @@ estdist[0] = schd_tab[puid][21];*/
          latlon4= latlon4+ ","+ schd_tab[local_s_tab[i+1]][37];
 
 
-         actualTT = (itms_to_minutes (ampm2fullhrs (doeta)) - itms_to_minutes (ampm2fullhrs (puetd))); //flipped eta/etd
+         actualTT = (dayMinute(doeta) - dayMinute(puetd)); //flipped eta/etd
             if(DEBUG == 1) gse << "Actual travel time " << actualTT << endl;
     }
 		 */
@@ -27267,9 +28455,9 @@ estdist[0] = schd_tab[puid][21];*/
 
 		if(strcmp(schd_tab[local_s_tab[i]][7],"D")==0 && i != 0 && i!= counter-1 && (tripid2.substr(0,1) == "T" || tripid2.substr(0,1) == "R") && p_trip_type2 != "BRK" && p_trip_type2 != "LUNCH" && p_trip_type2 != "ADMIN"){
 
-			int pickupid = (int)to_number(schd_tab[local_s_tab[i]][PICKUPIDX]);
-			int doeta1 = (int)to_number(schd_tab[local_s_tab[i]][30])-(int)to_number(schd_tab[local_s_tab[i]][25]);
-			int puetd1 = (int)to_number(schd_tab[pickupid][30]);
+			int pickupid = (int)tripNumber(local_s_tab[i], PICKUPIDX);
+			int doeta1 = (int)tripNumber(local_s_tab[i], 30)-(int)tripNumber(local_s_tab[i], 25);
+			int puetd1 = (int)tripNumber(pickupid, 30);
 			int stopafter;
 
 			for(int t = 0; t < counter; t++){
@@ -27295,11 +28483,11 @@ estdist[0] = schd_tab[puid][21];*/
 				aLatepickup = p_DIALRIDELATEPICKFACTOR1;
 			}
 
-			if((int)to_number(schd_tab[stopafter][30]) - (int)to_number(schd_tab[stopafter][25])  >= (int)to_number(schd_tab[pickupid][4]) + aLatepickup+ (int)to_number(schd_tab[pickupid][25]) + (int)to_number(schd_tab[pickupid][CALCULATEDTIME])){
+			if((int)tripNumber(stopafter, 30) - (int)tripNumber(stopafter, 25)  >= (int)tripNumber(pickupid, 4) + aLatepickup+ (int)tripNumber(pickupid, 25) + (int)tripNumber(pickupid, CALCULATEDTIME)){
 
-				puetd1 = (int)to_number(schd_tab[pickupid][4]) + aLatepickup+ (int)to_number(schd_tab[pickupid][25]);
+				puetd1 = (int)tripNumber(pickupid, 4) + aLatepickup+ (int)tripNumber(pickupid, 25);
 
-				if(DEBUG == 1) gse << "Changing puetd to " << puetd1 << " " << (int)to_number(schd_tab[stopafter][30]) << "  " <<  (int)to_number(schd_tab[stopafter][25]) <<  endl;
+				if(DEBUG == 1) gse << "Changing puetd to " << puetd1 << " " << (int)tripNumber(stopafter, 30) << "  " <<  (int)tripNumber(stopafter, 25) <<  endl;
 			}
 
 
@@ -27311,8 +28499,8 @@ estdist[0] = schd_tab[puid][21];*/
 			actualTT = 0;
 
 
-		p_eta = itms_minutes_to_ampm((int)to_number(schd_tab[local_s_tab[i]][29]));
-		p_etd = itms_minutes_to_ampm((int)to_number(schd_tab[local_s_tab[i]][30]));
+		p_eta = itms_minutes_to_ampm((int)tripNumber(local_s_tab[i], 29));
+		p_etd = itms_minutes_to_ampm((int)tripNumber(local_s_tab[i], 30));
 
 		int aLatepickup;
 
@@ -27324,8 +28512,8 @@ estdist[0] = schd_tab[puid][21];*/
 		}
 
 		if(p_stop_num == (int)to_number(MAXSTOPNUM[0])){
-			endtime1 = to_string((int)itms_to_minutes(ampm2fullhrs(p_promised_time))); // to make sure segments do not go beyond the end'
-			////  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)itms_to_minutes(ampm2fullhrs(p_promised_time)) << endl;
+			endtime1 = to_string((int)dayMinute(p_promised_time)); // to make sure segments do not go beyond the end'
+			////  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)dayMinute(p_promised_time) << endl;
 		}
 
 		bool preassigntripchange = true;
@@ -27334,10 +28522,10 @@ estdist[0] = schd_tab[puid][21];*/
 		if(strcmp(schd_tab[local_s_tab[i]][LATEDEVIATION],"")!=0 || strcmp(schd_tab[local_s_tab[i]][TRVLTIMEDEVIATION],"")!=0){
 			preassigntripchange = false;
 			if ((p_stop_type == "P") && starttime1 != "0" && starttime1 != "" &&   starttime1 != "0000" ) {
-				if( itms_to_minutes(ampm2fullhrs(p_eta))  > (int)to_number(starttime1) + aLatepickup)//p_DIALRIDELATEPICKFACTOR )
+				if( dayMinute(p_eta)  > (int)to_number(starttime1) + aLatepickup)//p_DIALRIDELATEPICKFACTOR )
 				{
-					int dev =  itms_to_minutes(ampm2fullhrs(p_eta)) - ((int)to_number(starttime1) + aLatepickup);
-					if(dev > (int)to_number(schd_tab[local_s_tab[i]][LATEDEVIATION])){
+					int dev =  dayMinute(p_eta) - ((int)to_number(starttime1) + aLatepickup);
+					if(dev > (int)tripNumber(local_s_tab[i], LATEDEVIATION)){
 						preassigntripchange = true;
 					}
 
@@ -27347,11 +28535,11 @@ estdist[0] = schd_tab[puid][21];*/
 
 			if ((p_stop_type == "D") && (endtime1) != "0" && (endtime1) != "" && (endtime1) != "0000")
 			{
-				if((((itms_to_minutes(ampm2fullhrs(p_eta))) >  (int)to_number(endtime1)) && prom_time != 0))
+				if((((dayMinute(p_eta)) >  (int)to_number(endtime1)) && prom_time != 0))
 				{
 
-					int dev =  itms_to_minutes(ampm2fullhrs(p_eta)) - ((int)to_number(endtime1));
-					if(dev > (int)to_number(schd_tab[local_s_tab[i]][LATEDEVIATION])){
+					int dev =  dayMinute(p_eta) - ((int)to_number(endtime1));
+					if(dev > (int)tripNumber(local_s_tab[i], LATEDEVIATION)){
 						preassigntripchange = true;
 					}
 
@@ -27360,7 +28548,7 @@ estdist[0] = schd_tab[puid][21];*/
 			}
 
 			if((actualTT > aAllowedTT  && actualTT > 0)){
-				if((actualTT - aAllowedTT) > (int)to_number(schd_tab[local_s_tab[i]][TRVLTIMEDEVIATION])){
+				if((actualTT - aAllowedTT) > (int)tripNumber(local_s_tab[i], TRVLTIMEDEVIATION)){
 					preassigntripchange = true;
 				}
 			}
@@ -27369,7 +28557,7 @@ estdist[0] = schd_tab[puid][21];*/
 
 
 
-		if(DEBUG == 1) gse << p_stop_num << " \t " << p_promised_time << " \t " <<  itms_minutes_to_ampm((int)to_number(schd_tab[local_s_tab[i]][29])) << " \t " << itms_minutes_to_ampm((int)to_number(schd_tab[local_s_tab[i]][30])) << " \t NOT STORING DISTANCE  \t" << p_timetonextstop << " \t " << p_stop_type << "\t wc occ" << p_wc_occ << " \t amb occ" << p_amb_occ << "\t" << p_cs_occ << "\t" << p_bs_occ << "\t" << p_esc << " " << arrivetime1 << " " << departtime1 << " " << p_trip_type << " " << schd_tab[local_s_tab[i]][20] << " " << " " <<schd_tab[local_s_tab[i]][42]<< " " << schd_tab[local_s_tab[i]][41] << " " << local_s_tab[i] << " starttime " << starttime1 << " end time: " << endtime1 << " trip id " <<schd_tab[local_s_tab[i]][3]  << " " << schd_tab[local_s_tab[i]][10] << " " << schd_tab[local_s_tab[i]][37]  <<  endl;
+		if(DEBUG == 1) gse << p_stop_num << " \t " << p_promised_time << " \t " <<  itms_minutes_to_ampm((int)tripNumber(local_s_tab[i], 29)) << " \t " << itms_minutes_to_ampm((int)tripNumber(local_s_tab[i], 30)) << " \t NOT STORING DISTANCE  \t" << p_timetonextstop << " \t " << p_stop_type << "\t wc occ" << p_wc_occ << " \t amb occ" << p_amb_occ << "\t" << p_cs_occ << "\t" << p_bs_occ << "\t" << p_esc << " " << arrivetime1 << " " << departtime1 << " " << p_trip_type << " " << schd_tab[local_s_tab[i]][20] << " " << " " <<schd_tab[local_s_tab[i]][42]<< " " << schd_tab[local_s_tab[i]][41] << " " << local_s_tab[i] << " starttime " << starttime1 << " end time: " << endtime1 << " trip id " <<schd_tab[local_s_tab[i]][3]  << " " << schd_tab[local_s_tab[i]][10] << " " << schd_tab[local_s_tab[i]][37]  <<  endl;
 
 
 
@@ -27465,8 +28653,8 @@ estdist[0] = schd_tab[puid][21];*/
 			if (preassigntripchange && (p_stop_type == "P") && starttime1 != "0" && starttime1 != "" &&   starttime1 != "0000" && (p_stop_num >= aStp )) {
 
 
-				if(DEBUG == 1) gse << "checking " << itms_to_minutes(ampm2fullhrs(p_eta)) << " " << (int)to_number(starttime1) << " " << aLatepickup << endl;
-				if( itms_to_minutes(ampm2fullhrs(p_eta))  > (int)to_number(starttime1) + aLatepickup + floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
+				if(DEBUG == 1) gse << "checking " << dayMinute(p_eta) << " " << (int)to_number(starttime1) << " " << aLatepickup << endl;
+				if( dayMinute(p_eta)  > (int)to_number(starttime1) + aLatepickup + floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 				{
 					//   if(DEBUG == 1) gse << "Starttime " << itms_minutes_to_ampm(to_number(starttime1)) << endl;
 					// oDropETA = " Dropoff ETA:  ;" ;
@@ -27513,8 +28701,8 @@ estdist[0] = schd_tab[puid][21];*/
 			}
 
 			if(p_stop_num == (int)to_number(MAXSTOPNUM[0]) && tripid == "S"){
-				endtime1 = to_string((int)itms_to_minutes(ampm2fullhrs(p_promised_time))); // to make sure segments do not go beyond the end'
-				//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)itms_to_minutes(ampm2fullhrs(p_promised_time)) << endl;
+				endtime1 = to_string((int)dayMinute(p_promised_time)); // to make sure segments do not go beyond the end'
+				//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)dayMinute(p_promised_time) << endl;
 			}
 			/*** 4. Check if someone is late for Appointment ***/
 			/** Added condition if the appt. time is not null and return_trip = Y **/
@@ -27523,13 +28711,13 @@ estdist[0] = schd_tab[puid][21];*/
 
 
 
-				if((((itms_to_minutes(ampm2fullhrs(p_eta))) > /*12 +*/ (int)to_number(endtime1) + floor((RELAXCONSTRAINTS[0] - 1)*50)) && prom_time != 0))
+				if((((dayMinute(p_eta)) > /*12 +*/ (int)to_number(endtime1) + floor((RELAXCONSTRAINTS[0] - 1)*50)) && prom_time != 0))
 				{
 					if(DEBUG == 1) gse << "Endtime " << endtime1 << endl;
 					if(!finished){
 						if(DEBUG == 1) gse << "I will be late " << endl;
 						string tripid = schd_tab[local_s_tab[i]][3];
-						oResult = "Impact: " +  tripid + " will be late: " + to_string((int)itms_to_minutes(ampm2fullhrs(p_eta)) - (int)to_number(endtime1) ) +
+						oResult = "Impact: " +  tripid + " will be late: " + to_string((int)dayMinute(p_eta) - (int)to_number(endtime1) ) +
 								" minutes for the " + itms_minutes_to_ampm((int)to_number(endtime1)) + " Appointment";
 						// strcpy( schd_tab[local_s_tab[i]][0] ,"");
 						if(DEBUG == 1) gse <<   oResult <<"\n\n";
@@ -27858,13 +29046,13 @@ void recalcons_tabREOPTIMIZE(string a_route){
 				// // //  if(DEBUG == 1) gse << "Test " << s_tab[i][k] << endl;
 				if(s_tab[i][k]==0){break;}
 
-				p_stop_num = (int)to_number(schd_tab[s_tab[i][k]][2]);
+				p_stop_num = (int)tripNumber(s_tab[i][k], 2);
 
 				if(p_stop_num == 1){
 					index = s_tab[i][k];
 					cnt = 0;
 					//// //  if(DEBUG == 1) gse << "Stop " << schd_tab[s_tab[i][k]][2] <<endl;
-					disttrav = to_number(schd_tab[s_tab[i][k]][6]);
+					disttrav = tripNumber(s_tab[i][k], 6);
 					dist = schd_tab[s_tab[i][k]][6];//////////////////////////////////move distance to after loop when finished converting binary tree function as
 					////////////// because it stores the NEXT distance as distance FROM.
 
@@ -27904,8 +29092,8 @@ void recalcons_tabREOPTIMIZE(string a_route){
 					// temp = schd_tab[s_tab[i][k]][12];
 					amb_occ1 =  schd_tab[s_tab[i][k]][31];
 					wc_occ1 =  schd_tab[s_tab[i][k]][32];
-					p_cs_occ = to_number(schd_tab[s_tab[i][k]][CS_OCC]);
-					p_bs_occ =to_number(schd_tab[s_tab[i][k]][BS_OCC]);
+					p_cs_occ = tripNumber(s_tab[i][k], CS_OCC);
+					p_bs_occ =tripNumber(s_tab[i][k], BS_OCC);
 					amb_cap1 =  schd_tab[s_tab[i][k]][33];
 					//temp = temp+",";
 					wc_cap1 =  schd_tab[s_tab[i][k]][34]; /// fix this hack in get next token
@@ -27921,16 +29109,16 @@ void recalcons_tabREOPTIMIZE(string a_route){
 					p_return_trip = schd_tab[s_tab[i][k]][18];
 					p_stop_type = schd_tab[s_tab[i][k]][7];
 
-					disttrav = (int)to_number(schd_tab[s_tab[i][k]][6]);
+					disttrav = (int)tripNumber(s_tab[i][k], 6);
 					dist = schd_tab[s_tab[i][k]][6];
 					//////////////////////////////////move distance to after loop when finished converting binary tree function as
 					////////////// because it stores
-					p_esc = (int)to_number(schd_tab[s_tab[i][k]][13]);
+					p_esc = (int)tripNumber(s_tab[i][k], 13);
 					p_td_segmentid = schd_tab[s_tab[i][k]][0];
 
 					////  if(DEBUG == 1) gse << "The segment is for recalc " << p_td_segmentid << " " <<  schd_tab[s_tab[i][k]][0] << endl;
 
-					p_stop_num = (int)to_number(schd_tab[s_tab[i][k]][2]);
+					p_stop_num = (int)tripNumber(s_tab[i][k], 2);
 					p_citytown = schd_tab[s_tab[i][k]][11];
 
 					p_eta = eta1;
@@ -27975,8 +29163,8 @@ void recalcons_tabREOPTIMIZE(string a_route){
 				// temp = schd_tab[s_tab[i][k]][12];
 				amb_occ1 =  schd_tab[s_tab[i][k]][31];
 				wc_occ1 =  schd_tab[s_tab[i][k]][32];
-				p_cs_occ = to_number(schd_tab[s_tab[i][k]][CS_OCC]);
-				p_bs_occ =to_number(schd_tab[s_tab[i][k]][BS_OCC]);
+				p_cs_occ = tripNumber(s_tab[i][k], CS_OCC);
+				p_bs_occ =tripNumber(s_tab[i][k], BS_OCC);
 				amb_cap1 =  schd_tab[s_tab[i][k]][33];
 				//temp = temp+",";
 				wc_cap1 =  schd_tab[s_tab[i][k]][34]; /// fix this hack in get next token
@@ -27995,7 +29183,7 @@ void recalcons_tabREOPTIMIZE(string a_route){
 				p_name = schd_tab[s_tab[i][k]][14];
 				p_return_trip = schd_tab[s_tab[i][k]][18];
 				p_stop_type = schd_tab[s_tab[i][k]][7];
-				p_esc = (int)to_number(schd_tab[s_tab[i][k]][13]);
+				p_esc = (int)tripNumber(s_tab[i][k], 13);
 				p_td_segmentid = schd_tab[s_tab[i][k]][0];
 
 
@@ -28055,7 +29243,7 @@ void recalcons_tabREOPTIMIZE(string a_route){
 				set_registry_values(  p_WHEELLOAD1,  p_AMBLOAD1,
 						p_MAXEARLYDROPOFFFACTOR1, p_DIALRIDEEARLYPICKFACTOR1, p_DIALRIDELATEPICKFACTOR1, p_OTHEREARLYPICKFACTOR1,  p_OTHERLATEPICKFACTOR1,IGNOREPUTIMES1, p_SHORTBREAK1, p_LUNCHBREAK1,  p_PROXIMITYFACTOR1,  a_mediumshortdistance1, a_mediumlongdistance1, a_shorttriptime1,
 						a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip,  pDisability,p_trip_type1);
-				double estdisttrip = to_number(schd_tab[s_tab[i][k]][21]);
+				double estdisttrip = tripNumber(s_tab[i][k], 21);
 
 				int aAllowedTT;
 
@@ -28083,7 +29271,7 @@ void recalcons_tabREOPTIMIZE(string a_route){
 				tripid = tripid.substr(0,1);
 				string endtime2;
 				if(tripid == "S"){
-					endtime2 =to_string( (int)itms_to_minutes(ampm2fullhrs(p_promised_time)));
+					endtime2 =to_string( (int)dayMinute(p_promised_time));
 				}
 
 				if(p_stop_type == "P"){
@@ -28167,7 +29355,7 @@ void recalcons_tabREOPTIMIZE(string a_route){
 				p_cs_occ = std::get<13>(varHolder);
 				p_bs_occ = std::get<14>(varHolder);
 				if(!secondpassinsertedtrip){
-					p_etd =  itms_minutes_to_ampm(itms_to_minutes (ampm2fullhrs(p_etd)) - p_perf_time);
+					p_etd =  itms_minutes_to_ampm(dayMinute(p_etd) - p_perf_time);
 
 					if (p_stop_num != 1 && p_stop_num != (int)to_number(MAXSTOPNUM[0])) {
 						if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[i][k]][7],schd_tab[s_tab[i][k-1]][7])==0)
@@ -28218,21 +29406,21 @@ void recalcons_tabREOPTIMIZE(string a_route){
 						}
 
 					}
-					p_etd =  itms_minutes_to_ampm(itms_to_minutes (ampm2fullhrs (p_etd)) + p_perf_time);
+					p_etd =  itms_minutes_to_ampm(dayMinute(p_etd) + p_perf_time);
 					//  if(DEBUG == 1) gse << "petd changing after " << p_etd << endl;
 				}
 
 				if(p_stop_type  == "P"){
 					string tripidforwait = schd_tab[s_tab[i][k]][3];
-					int DW = getDWByStop (tripidforwait, p_stop_type ,itms_to_minutes(ampm2fullhrs (p_eta)) , itms_to_minutes (ampm2fullhrs(p_etd)),(int)to_number(starttime1),p_perf_time);
-					int PW = getPWByStop (tripidforwait,  p_stop_type  ,itms_to_minutes(ampm2fullhrs (p_eta))    , (int)to_number(starttime1));
+					int DW = getDWByStop (tripidforwait, p_stop_type ,dayMinute(p_eta) , dayMinute(p_etd),(int)to_number(starttime1),p_perf_time);
+					int PW = getPWByStop (tripidforwait,  p_stop_type  ,dayMinute(p_eta)    , (int)to_number(starttime1));
 					strcpy(schd_tab[s_tab[i][k]][DWWAIT], to_string(DW).c_str());
 					strcpy(schd_tab[s_tab[i][k]][PWWAIT], to_string(PW).c_str());
 				}
 				else{
-					int eta = itms_to_minutes (ampm2fullhrs (p_eta));
-					int etd = (int)to_number(schd_tab[s_tab[i][k-1]][30]);
-					int TT = (int)to_number(schd_tab[s_tab[i][k-1]][CALCULATEDTIME]);
+					int eta = dayMinute(p_eta);
+					int etd = (int)tripNumber(s_tab[i][k-1], 30);
+					int TT = (int)tripNumber(s_tab[i][k-1], CALCULATEDTIME);
 					string tripidforwait = schd_tab[s_tab[i][k]][3];
 					int DW = eta - etd + TT;
 					int PW = getPWByStop (tripidforwait,  schd_tab[s_tab[i][k]][7],eta, (int)to_number(endtime1));
@@ -28243,10 +29431,10 @@ void recalcons_tabREOPTIMIZE(string a_route){
 
 
 				//capacity  = to_string(p_amb_occ)+ ","+ to_string(p_wc_occ)+","+ amb_cap1+","+ wc_cap1+ "," +to_string(p_grp_cnt_amb) +","+ to_string(p_grp_cnt_wc)+","+ p_disability;
-				//times  =  to_string(itms_to_minutes (ampm2fullhrs ( p_promised_time))) +","+est_traveltime1 +","+arrivetime1 +","+ departtime1 +","+to_string(p_perf_time) +","+starttime1 +","+endtime1 +","+to_string(p_timetonextstop) +","+to_string(itms_to_minutes (ampm2fullhrs (p_eta))) +","+to_string(itms_to_minutes (ampm2fullhrs (p_etd)));
+				//times  =  to_string(dayMinute(p_promised_time)) +","+est_traveltime1 +","+arrivetime1 +","+ departtime1 +","+to_string(p_perf_time) +","+starttime1 +","+endtime1 +","+to_string(p_timetonextstop) +","+to_string(dayMinute(p_eta)) +","+to_string(dayMinute(p_etd));
 
 
-				strcpy((schd_tab[s_tab[i][k]][4]) , to_string(itms_to_minutes (ampm2fullhrs (p_promised_time))).c_str());
+				strcpy((schd_tab[s_tab[i][k]][4]) , to_string(dayMinute(p_promised_time)).c_str());
 
 				strcpy((schd_tab[s_tab[i][k]][22]) , est_traveltime1.c_str());
 
@@ -28265,9 +29453,9 @@ void recalcons_tabREOPTIMIZE(string a_route){
 
 				}
 
-				strcpy((schd_tab[s_tab[i][k]][29]) , to_string(itms_to_minutes (ampm2fullhrs (p_eta))).c_str());
+				strcpy((schd_tab[s_tab[i][k]][29]) , to_string(dayMinute(p_eta)).c_str());
 
-				strcpy((schd_tab[s_tab[i][k]][30]) ,to_string(itms_to_minutes (ampm2fullhrs (p_etd))).c_str());
+				strcpy((schd_tab[s_tab[i][k]][30]) ,to_string(dayMinute(p_etd)).c_str());
 
 				strcpy((schd_tab[s_tab[i][k]][31]) , to_string(p_amb_occ).c_str());
 
@@ -28320,7 +29508,7 @@ void recalcons_tabREOPTIMIZE(string a_route){
 				last_amb_occ=(int)to_number(prev_amb_occ1);
 				last_wc_occ=(int)to_number(prev_wc_occ1);
 				p_prev_perf_time = prev_p_perf_time;
-				p_prev_stop_num = (int)to_number(schd_tab[s_tab[i][k]][2]);
+				p_prev_stop_num = (int)tripNumber(s_tab[i][k], 2);
 				p_prev_promised_time = p_promised_time;
 
 				//   if(DEBUG == 1) gse << p_stop_num << " \t " << p_promised_time << " \t " << p_eta << " \t " << p_etd << " \t "  << setprecision(2) << prev_distance <<  "  \t" << p_timetonextstop << " \t " << p_stop_type << "\t " << p_wc_occ << " \t" << p_amb_occ << "\t" << p_cs_occ << "\t" << p_bs_occ << "\t" << p_esc << " " << arrivetime1 << " " << departtime1 << endl;
@@ -28680,8 +29868,8 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 		// temp = schd_tab[local_s_tab[i]][12];
 		amb_occ1 =  schd_tab[local_s_tab[i]][31];
 		wc_occ1 =  schd_tab[local_s_tab[i]][32];
-		p_cs_occ = to_number(schd_tab[local_s_tab[i]][CS_OCC]);
-		p_bs_occ =to_number(schd_tab[local_s_tab[i]][BS_OCC]);
+		p_cs_occ = tripNumber(local_s_tab[i], CS_OCC);
+		p_bs_occ =tripNumber(local_s_tab[i], BS_OCC);
 		amb_cap1 =  schd_tab[local_s_tab[SEGSTART]][33];
 		//temp = temp+",";
 		wc_cap1 =  schd_tab[local_s_tab[SEGSTART]][34]; /// fix this hack in get next token
@@ -28700,8 +29888,8 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 		p_name = schd_tab[local_s_tab[i]][14];
 		p_return_trip = schd_tab[local_s_tab[i]][18];
 		p_stop_type = schd_tab[local_s_tab[i]][7];
-		p_esc = (int)to_number(schd_tab[local_s_tab[i]][13]);
-		p_stop_num = (int)to_number(schd_tab[local_s_tab[i]][2]);
+		p_esc = (int)tripNumber(local_s_tab[i], 13);
+		p_stop_num = (int)tripNumber(local_s_tab[i], 2);
 		p_td_segmentid = schd_tab[local_s_tab[SEGSTART]][0];
 		//  //  if(DEBUG == 1) gse << "The segment is  " << p_td_segmentid << " " <<  schd_tab[local_s_tab[SEGSTART]][0] << endl;
 		////  if(DEBUG == 1) gse << "STop num " << p_stop_num<< endl;
@@ -28923,9 +30111,9 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 
 
 
-		double estdisttrip = to_number(schd_tab[local_s_tab[i]][21]);
+		double estdisttrip = tripNumber(local_s_tab[i], 21);
 		int allowedDW;
-		double esttime = to_number(schd_tab[local_s_tab[i]][22]);
+		double esttime = tripNumber(local_s_tab[i], 22);
 
 		if(estdisttrip < a_mediumshortdistance1){
 			aAllowedTT = a_shorttriptime1 + extratraveltime;
@@ -28954,7 +30142,7 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 		tripid = tripid.substr(0,1);
 		string endtime2;
 		if(tripid == "S"){
-			endtime2 =to_string( (int)itms_to_minutes(ampm2fullhrs(p_promised_time)));
+			endtime2 =to_string( (int)dayMinute(p_promised_time));
 		}
 
 		if(p_stop_type == "P"){
@@ -29049,7 +30237,7 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 		p_bs_occ = std::get<14>(varHolder);
 
 		if(!secondpassinsertedtrip){
-			p_etd =  itms_minutes_to_ampm(itms_to_minutes (ampm2fullhrs (p_etd)) - p_perf_time);
+			p_etd =  itms_minutes_to_ampm(dayMinute(p_etd) - p_perf_time);
 
 
 
@@ -29102,12 +30290,12 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 			}
 
 
-			p_etd =  itms_minutes_to_ampm(itms_to_minutes (ampm2fullhrs (p_etd)) + p_perf_time);
+			p_etd =  itms_minutes_to_ampm(dayMinute(p_etd) + p_perf_time);
 		}
 
 		bool changedeta = true;
 
-		if(itms_to_minutes (ampm2fullhrs (p_eta)) != eta)
+		if(dayMinute(p_eta) != eta)
 			changedeta = true;
 
 
@@ -29115,16 +30303,16 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 
 		if(p_stop_type  == "P"){
 			string tripidforwait = schd_tab[local_s_tab[i]][3];
-			int DW = getDWByStop (tripidforwait, p_stop_type ,itms_to_minutes (ampm2fullhrs (p_eta)) , itms_to_minutes (ampm2fullhrs (p_etd))  ,(int)to_number(starttime1), p_perf_time);
-			int PW = getPWByStop (tripidforwait,  p_stop_type  ,itms_to_minutes (ampm2fullhrs (p_eta))    , (int)to_number(starttime1));
+			int DW = getDWByStop (tripidforwait, p_stop_type ,dayMinute(p_eta) , dayMinute(p_etd)  ,(int)to_number(starttime1), p_perf_time);
+			int PW = getPWByStop (tripidforwait,  p_stop_type  ,dayMinute(p_eta)    , (int)to_number(starttime1));
 			strcpy(schd_tab[local_s_tab[i]][DWWAIT], to_string(DW).c_str());
 			strcpy(schd_tab[local_s_tab[i]][PWWAIT], to_string(PW).c_str());
 		}
 		else{
 
-			int eta = itms_to_minutes (ampm2fullhrs (p_eta));
-			int etd = (int)to_number(schd_tab[local_s_tab[i-1]][30]);
-			int TT = (int)to_number(schd_tab[local_s_tab[i-1]][CALCULATEDTIME]);
+			int eta = dayMinute(p_eta);
+			int etd = (int)tripNumber(local_s_tab[i-1], 30);
+			int TT = (int)tripNumber(local_s_tab[i-1], CALCULATEDTIME);
 			string tripidforwait = schd_tab[local_s_tab[i]][3];
 			int DW = eta - etd + TT;
 			int PW = getPWByStop (tripidforwait,  schd_tab[local_s_tab[i]][7],eta, (int)to_number(endtime1));
@@ -29137,7 +30325,7 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 
 		////  if(DEBUG == 1) gse << "2. I am here " << schd_tab[local_s_tab[0]][0] << endl;
 
-		strcpy(schd_tab[local_s_tab[i]][4], to_string(itms_to_minutes (ampm2fullhrs ( p_promised_time))).c_str());
+		strcpy(schd_tab[local_s_tab[i]][4], to_string(dayMinute(p_promised_time)).c_str());
 		strcpy( schd_tab[local_s_tab[i]][22] ,est_traveltime1.c_str());
 		strcpy( schd_tab[local_s_tab[i]][23],arrivetime1.c_str());
 		strcpy( schd_tab[local_s_tab[i]][24] ,departtime1.c_str());
@@ -29150,8 +30338,8 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 		}
 
 
-		strcpy(  schd_tab[local_s_tab[i]][29] ,to_string(itms_to_minutes (ampm2fullhrs (p_eta))).c_str());
-		strcpy(  schd_tab[local_s_tab[i]][30] ,to_string(itms_to_minutes (ampm2fullhrs (p_etd))).c_str());
+		strcpy(  schd_tab[local_s_tab[i]][29] ,to_string(dayMinute(p_eta)).c_str());
+		strcpy(  schd_tab[local_s_tab[i]][30] ,to_string(dayMinute(p_etd)).c_str());
 		//strcpy(  schd_tab[local_s_tab[i]][DIRTYBIT] ,("Y")) ;
 		//temproute[i][6] = to_string(disttrav);
 		strcpy( schd_tab[local_s_tab[i]][31] ,  to_string(p_amb_occ).c_str());
@@ -29219,7 +30407,7 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 		last_amb_occ=(int)to_number(prev_amb_occ1);
 		last_wc_occ=(int)to_number(prev_wc_occ1);
 		p_prev_perf_time = prev_p_perf_time;
-		p_prev_stop_num = (int)to_number(schd_tab[local_s_tab[i]][2]);
+		p_prev_stop_num = (int)tripNumber(local_s_tab[i], 2);
 		p_prev_promised_time = p_promised_time;
 
 
@@ -29289,7 +30477,7 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
          latlon4= latlon4+ ","+ schd_tab[local_s_tab[i+1]][37];
 
 
-         actualTT = (itms_to_minutes (ampm2fullhrs (doeta)) - itms_to_minutes (ampm2fullhrs (puetd))); //flipped eta/etd
+         actualTT = (dayMinute(doeta) - dayMinute(puetd)); //flipped eta/etd
          // //  if(DEBUG == 1) gse << "Actual travel time " << actualTT << endl;
     }
 		 */
@@ -29304,9 +30492,9 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 
 		if(strcmp(schd_tab[local_s_tab[i]][7],"D")==0 && (tripid2.substr(0,1) == "T" || tripid2.substr(0,1) == "R") && p_trip_type2 != "BRK" && p_trip_type2 != "LUNCH" && p_trip_type2 != "ADMIN"){
 
-			int pickupid = (int)to_number(schd_tab[local_s_tab[i]][PICKUPIDX]);
-			int doeta1 = (int)to_number(schd_tab[local_s_tab[i]][30])-(int)to_number(schd_tab[local_s_tab[i]][25]);
-			int puetd1 = (int)to_number(schd_tab[pickupid][30]);
+			int pickupid = (int)tripNumber(local_s_tab[i], PICKUPIDX);
+			int doeta1 = (int)tripNumber(local_s_tab[i], 30)-(int)tripNumber(local_s_tab[i], 25);
+			int puetd1 = (int)tripNumber(pickupid, 30);
 			int stopafter;
 
 			for(int t = 0; t < counter; t++){
@@ -29333,11 +30521,11 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 			}
 
 
-			if((int)to_number(schd_tab[stopafter][30]) - (int)to_number(schd_tab[stopafter][25])  >= (int)to_number(schd_tab[pickupid][4]) + aLatepickup+ (int)to_number(schd_tab[pickupid][25]) + (int)to_number(schd_tab[pickupid][CALCULATEDTIME])){
+			if((int)tripNumber(stopafter, 30) - (int)tripNumber(stopafter, 25)  >= (int)tripNumber(pickupid, 4) + aLatepickup+ (int)tripNumber(pickupid, 25) + (int)tripNumber(pickupid, CALCULATEDTIME)){
 
-				puetd1 = (int)to_number(schd_tab[pickupid][4]) + aLatepickup+ (int)to_number(schd_tab[pickupid][25]);
+				puetd1 = (int)tripNumber(pickupid, 4) + aLatepickup+ (int)tripNumber(pickupid, 25);
 
-				if(DEBUG == 1) gse << "Changing puetd to " << puetd1 << " " << (int)to_number(schd_tab[stopafter][30]) << "  " <<  (int)to_number(schd_tab[stopafter][25]) <<  endl;
+				if(DEBUG == 1) gse << "Changing puetd to " << puetd1 << " " << (int)tripNumber(stopafter, 30) << "  " <<  (int)tripNumber(stopafter, 25) <<  endl;
 			}
 
 
@@ -29354,8 +30542,8 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 
 
 		if(DEBUG == 1) gse << p_stop_num << " \t " << p_promised_time << " \t " << p_eta << " \t " << p_etd << " \t "  << setprecision(2) << prev_distance <<  "  \t" << p_timetonextstop << " \t " << p_stop_type << "\t wc occ" << p_wc_occ << " \t amb occ" << p_amb_occ << "\t" << p_cs_occ << "\t" << p_bs_occ << "\t" << p_esc << " " << arrivetime1 << " " << departtime1 << " " << p_trip_type << " " << schd_tab[local_s_tab[i]][20] << " " << " " <<schd_tab[local_s_tab[i]][42]<< " " << schd_tab[local_s_tab[i]][41] << " " << local_s_tab[i] << " end time: " << endtime1 << " trip id " <<schd_tab[local_s_tab[i]][3] << " " << schd_tab[local_s_tab[i]][10] << " " << schd_tab[local_s_tab[i]][37]  <<  endl;
-		p_eta = itms_minutes_to_ampm((int)to_number(schd_tab[local_s_tab[i]][29]));
-		p_etd = itms_minutes_to_ampm((int)to_number(schd_tab[local_s_tab[i]][30]));
+		p_eta = itms_minutes_to_ampm((int)tripNumber(local_s_tab[i], 29));
+		p_etd = itms_minutes_to_ampm((int)tripNumber(local_s_tab[i], 30));
 
 
 
@@ -29370,18 +30558,18 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 		}
 
 		if(p_stop_num == (int)to_number(MAXSTOPNUM[0])){
-			endtime1 = to_string((int)itms_to_minutes(ampm2fullhrs(p_promised_time))); // to make sure segments do not go beyond the end'
-			////  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)itms_to_minutes(ampm2fullhrs(p_promised_time)) << endl;
+			endtime1 = to_string((int)dayMinute(p_promised_time)); // to make sure segments do not go beyond the end'
+			////  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)dayMinute(p_promised_time) << endl;
 		}
 
 		bool preassigntripchange = true;
 		if(strcmp(schd_tab[local_s_tab[i]][LATEDEVIATION],"")!=0 || strcmp(schd_tab[local_s_tab[i]][TRVLTIMEDEVIATION],"")!=0){
 			preassigntripchange = false;
 			if ((p_stop_type == "P") && starttime1 != "0" && starttime1 != "" &&   starttime1 != "0000" ) {
-				if( itms_to_minutes(ampm2fullhrs(p_eta))  > (int)to_number(starttime1) + aLatepickup)//p_DIALRIDELATEPICKFACTOR )
+				if( dayMinute(p_eta)  > (int)to_number(starttime1) + aLatepickup)//p_DIALRIDELATEPICKFACTOR )
 				{
-					int dev =  itms_to_minutes(ampm2fullhrs(p_eta)) - ((int)to_number(starttime1) + aLatepickup);
-					if(dev > (int)to_number(schd_tab[local_s_tab[i]][LATEDEVIATION])){
+					int dev =  dayMinute(p_eta) - ((int)to_number(starttime1) + aLatepickup);
+					if(dev > (int)tripNumber(local_s_tab[i], LATEDEVIATION)){
 						preassigntripchange = true;
 					}
 
@@ -29391,11 +30579,11 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 
 			if ((p_stop_type == "D") && (endtime1) != "0" && (endtime1) != "" && (endtime1) != "0000")
 			{
-				if((((itms_to_minutes(ampm2fullhrs(p_eta))) >  (int)to_number(endtime1)) && prom_time != 0))
+				if((((dayMinute(p_eta)) >  (int)to_number(endtime1)) && prom_time != 0))
 				{
 
-					int dev =  itms_to_minutes(ampm2fullhrs(p_eta)) - ((int)to_number(endtime1));
-					if(dev > (int)to_number(schd_tab[local_s_tab[i]][LATEDEVIATION])){
+					int dev =  dayMinute(p_eta) - ((int)to_number(endtime1));
+					if(dev > (int)tripNumber(local_s_tab[i], LATEDEVIATION)){
 						preassigntripchange = true;
 					}
 
@@ -29404,7 +30592,7 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 			}
 
 			if((actualTT > aAllowedTT  && actualTT > 0)){
-				if((actualTT - aAllowedTT) > (int)to_number(schd_tab[local_s_tab[i]][TRVLTIMEDEVIATION])){
+				if((actualTT - aAllowedTT) > (int)tripNumber(local_s_tab[i], TRVLTIMEDEVIATION)){
 					preassigntripchange = true;
 				}
 			}
@@ -29525,7 +30713,7 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 				/***3. Pickup Window violation *****/
 				if ( preassigntripchange && (p_stop_type == "P") && starttime1 != "0" && starttime1 != "" &&   starttime1 != "0000" && (p_stop_num >= aStp )) {
 
-					if( itms_to_minutes(ampm2fullhrs(p_eta))  > (int)to_number(starttime1) + aLatepickup+ floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
+					if( dayMinute(p_eta)  > (int)to_number(starttime1) + aLatepickup+ floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 					{
 						//// //  if(DEBUG == 1) gse << "Starttime " << itms_minutes_to_ampm(to_number(starttime1)) << endl;
 						// oDropETA = " Dropoff ETA:  ;" ;
@@ -29586,12 +30774,12 @@ bool insertandcalcrouteREOPTIMIZE(int counter, double * distances, double * time
 
 
 
-					if((((itms_to_minutes(ampm2fullhrs(p_eta))) > /*12 +*/ (int)to_number(endtime1)+ floor((RELAXCONSTRAINTS[0] - 1)*50)) && prom_time != 0))
+					if((((dayMinute(p_eta)) > /*12 +*/ (int)to_number(endtime1)+ floor((RELAXCONSTRAINTS[0] - 1)*50)) && prom_time != 0))
 					{
 						// //  if(DEBUG == 1) gse << "Endtime " << endtime1 << endl;
 						if(!finished){
 							string tripid = schd_tab[local_s_tab[i]][3];
-							oResult = "Impact: " +  tripid + " will be late: " + to_string((int)itms_to_minutes(ampm2fullhrs(p_eta)) - (int)to_number(endtime1) ) +
+							oResult = "Impact: " +  tripid + " will be late: " + to_string((int)dayMinute(p_eta) - (int)to_number(endtime1) ) +
 									" minutes for the " + itms_minutes_to_ampm((int)to_number(endtime1)) + " Appointment";
 							// strcpy( schd_tab[local_s_tab[i]][0] ,"");
 							//  if(DEBUG == 1) gse <<   oResult <<"\n\n";
@@ -29879,19 +31067,19 @@ void optimizeRoutes(){
 					//   if(DEBUG == 1) gse << "k is " << k << " " <<  endl;
 					/*
                                             if(strcmp(schd_tab[s_tab[m][k+1]][7],"D") == 0  && //if there's another trip in the group
-                                                strcmp(schd_tab[(int)to_number(schd_tab[s_tab[m][k+1]][PICKUPIDX])][7],"P")==0
-                                                != (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k+1]][PICKUPIDX])][2]) - 5){
+                                                strcmp(schd_tab[(int)tripNumber(s_tab[m][k+1], PICKUPIDX)][7],"P")==0
+                                                != (int)tripNumber((int)tripNumber(s_tab[m][k+1], PICKUPIDX), 2) - 5){
                                                 groupcnt = 0;
                                                 interruptedgroup = true;
                                                   if(DEBUG == 1) gse << schd_tab[s_tab[m][k]][2] << " " << schd_tab[s_tab[m][k+1]][2] << endl;
-                                                  if(DEBUG == 1) gse << " interuppted " << (int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX])][2]) << " = " <<(int)to_number(schd_tab[(int)to_number(schd_tab[s_tab[m][k+1]][PICKUPIDX])][2]) << " | " << endl;
+                                                  if(DEBUG == 1) gse << " interuppted " << (int)tripNumber((int)tripNumber(s_tab[m][k], PICKUPIDX), 2) << " = " <<(int)tripNumber((int)tripNumber(s_tab[m][k+1], PICKUPIDX), 2) << " | " << endl;
                                                 break;
                                             }*/
 					//else{
 
 					//   if(DEBUG == 1) gse << "Examining " << schd_tab[s_tab[m][k]][3] << endl;
 
-					pickupindicies[groupcnt] = (int)to_number(schd_tab[s_tab[m][k]][PICKUPIDX]);
+					pickupindicies[groupcnt] = (int)tripNumber(s_tab[m][k], PICKUPIDX);
 					dropoffindicies[groupcnt] = s_tab[m][k];
 					fullRoute[fullRoutecnt] = dropoffindicies[groupcnt];
 					groupcnt++;
@@ -29952,7 +31140,7 @@ void optimizeRoutes(){
 
 
 				for(int o = 0; o < groupcnt;o++){
-					stopnum[o] = to_number(schd_tab[pickupindicies[o]][2]);
+					stopnum[o] = tripNumber(pickupindicies[o], 2);
 
 				}
 
@@ -29965,7 +31153,7 @@ void optimizeRoutes(){
 				}
 
 				for(int o = 0; o < groupcnt;o++){
-					stopnum[o] = to_number(schd_tab[dropoffindicies[o]][2]);
+					stopnum[o] = tripNumber(dropoffindicies[o], 2);
 				}
 				bubbleSort_twoarray(stopnum,dropoffindicies,groupcnt);
 
@@ -29999,8 +31187,8 @@ void optimizeRoutes(){
 
 				for(int o = 0; o < groupcnt;o++){
 
-					if (largestpromtime < (int)to_number(schd_tab[pickupindicies[o]][4])){
-						largestpromtime = (int)to_number(schd_tab[pickupindicies[o]][4]);
+					if (largestpromtime < (int)tripNumber(pickupindicies[o], 4)){
+						largestpromtime = (int)tripNumber(pickupindicies[o], 4);
 						if(strcmp(schd_tab[pickupindicies[o]][18],"Y")==0){
 							isreturntriplargest = true;
 							largestidx = pickupindicies[o];
@@ -30011,8 +31199,8 @@ void optimizeRoutes(){
 						}
 					}
 
-					if (smalleststarttime > (int)to_number(schd_tab[pickupindicies[o]][26]) && (int)to_number(schd_tab[pickupindicies[o]][26]) != 0 ){
-						smalleststarttime = (int)to_number(schd_tab[pickupindicies[o]][26]);
+					if (smalleststarttime > (int)tripNumber(pickupindicies[o], 26) && (int)tripNumber(pickupindicies[o], 26) != 0 ){
+						smalleststarttime = (int)tripNumber(pickupindicies[o], 26);
 						if(strcmp(schd_tab[pickupindicies[o]][18],"Y")==0){
 							isreturntripsmallest = true;
 							smallestidx = pickupindicies[o];
@@ -30308,8 +31496,8 @@ void optimizeRoutes(){
 
 				for(int o = 0; o < groupcnt;o++){
 
-					if (largestpromtime < (int)to_number(schd_tab[dropoffindicies[o]][4])){
-						largestpromtime = (int)to_number(schd_tab[dropoffindicies[o]][4]);
+					if (largestpromtime < (int)tripNumber(dropoffindicies[o], 4)){
+						largestpromtime = (int)tripNumber(dropoffindicies[o], 4);
 						if(strcmp(schd_tab[dropoffindicies[o]][18],"Y")==0){
 							isreturntriplargest = true;
 							largestidx = dropoffindicies[o];
@@ -30320,8 +31508,8 @@ void optimizeRoutes(){
 						}
 					}
 
-					if (smallestendtime > (int)to_number(schd_tab[dropoffindicies[o]][27]) && (int)to_number(schd_tab[dropoffindicies[o]][27]) != 0 ){
-						smallestendtime = (int)to_number(schd_tab[dropoffindicies[o]][27]);
+					if (smallestendtime > (int)tripNumber(dropoffindicies[o], 27) && (int)tripNumber(dropoffindicies[o], 27) != 0 ){
+						smallestendtime = (int)tripNumber(dropoffindicies[o], 27);
 						if(strcmp(schd_tab[dropoffindicies[o]][18],"Y")==0){
 							isreturntripsmallest = true;
 							smallestidx = dropoffindicies[o];
@@ -30595,7 +31783,7 @@ void optimizeRoutes(){
 
 					//  if(DEBUG == 1) gse << schd_tab[pickupindicies[q]][2] << endl;
 
-					if((int)to_number(schd_tab[pickupindicies[q]][2]) + 5 != (int)to_number(schd_tab[pickupindicies[q+1]][2])){
+					if((int)tripNumber(pickupindicies[q], 2) + 5 != (int)tripNumber(pickupindicies[q+1], 2)){
 						interruptedgroup = true;
 						groupcnt = 0;
 						if(DEBUG == 1) gse << "The pickups are not consecutive " << endl;
@@ -30612,7 +31800,7 @@ void optimizeRoutes(){
 
 						//   if(DEBUG == 1) gse << schd_tab[dropoffindicies[q]][2] << endl;
 
-						if((int)to_number(schd_tab[dropoffindicies[q]][2]) + 5 != (int)to_number(schd_tab[dropoffindicies[q+1]][2])){
+						if((int)tripNumber(dropoffindicies[q], 2) + 5 != (int)tripNumber(dropoffindicies[q+1], 2)){
 							interruptedgroup = true;
 							groupcnt = 0;
 							if(DEBUG == 1) gse << "The dropoffs are not consecutive " << endl;
@@ -30623,7 +31811,7 @@ void optimizeRoutes(){
 				}
 
 				if(!interruptedgroup){
-					if((int)to_number(schd_tab[pickupindicies[groupcnt-1]][2]) + 5 != (int)to_number(schd_tab[dropoffindicies[0]][2])){
+					if((int)tripNumber(pickupindicies[groupcnt-1], 2) + 5 != (int)tripNumber(dropoffindicies[0], 2)){
 						interruptedgroup = true;
 						groupcnt = 0;
 						if(DEBUG == 1) gse << "There is a trip in between pick ups and drop offs " << endl;
@@ -30714,7 +31902,7 @@ void optimizeRoutes(){
 					int stoptoinsertafter1;
 
 					/*for(int j = 1; j < MAXSTOPS; j++){
-                        if(to_number(schd_tab[s_tab[m][j+1]][2])==stopnum[0]){
+                        if(tripNumber(s_tab[m][j+1], 2)==stopnum[0]){
                             stoptoinsertafter1 = s_tab[m][j];
                             break;
                         }
@@ -30986,8 +32174,8 @@ void optimizeRoutes(){
 
 
 							for(int o = 0; o < groupcnt+1;o++){ ///get centroid of p and d area of group trips
-								double lat = to_number(schd_tab[grouptriparrdo[o]][10]);
-								double lon = to_number(schd_tab[grouptriparrdo[o]][37]);
+								double lat = tripNumber(grouptriparrdo[o], 10);
+								double lon = tripNumber(grouptriparrdo[o], 37);
 								bg::assign_values(p, lon, lat);
 								ring.push_back(p);
 							}
@@ -30999,8 +32187,8 @@ void optimizeRoutes(){
 
 							for(int i = 0; i < groupcnt+1;i++){ //get inital pickup farthest from centroid of dropoff
 
-								double lat = to_number(schd_tab[temp[i]][10]);
-								double lon = to_number(schd_tab[temp[i]][37]);
+								double lat = tripNumber(temp[i], 10);
+								double lon = tripNumber(temp[i], 37);
 								bg::assign_values(p, lon, lat);
 								point_type p2;
 								boost::geometry::convert(p, p2);
@@ -31073,11 +32261,11 @@ void optimizeRoutes(){
 										}
 										else if(h+1 == r){
 											//newinsert = true;
-											double lat = to_number(schd_tab[temp[i]][10]);
-											double lon = to_number(schd_tab[temp[i]][37]);
+											double lat = tripNumber(temp[i], 10);
+											double lon = tripNumber(temp[i], 37);
 											bg::assign_values(p, lon, lat);
-											double lat1 = to_number(schd_tab[grouptriparrtot[r-1]][10]);
-											double lon1 = to_number(schd_tab[grouptriparrtot[r-1]][37]);
+											double lat1 = tripNumber(grouptriparrtot[r-1], 10);
+											double lon1 = tripNumber(grouptriparrtot[r-1], 37);
 											bg::assign_values(p1, lon1, lat1);
 											point_type p2;
 											point_type p3;
@@ -31127,8 +32315,8 @@ void optimizeRoutes(){
 						distpu = 0;
 
 
-						double lat = to_number(schd_tab[grouptriparrtot[f-1]][10]); //last pickup in array
-						double lon = to_number(schd_tab[grouptriparrtot[f-1]][37]);
+						double lat = tripNumber(grouptriparrtot[f-1], 10); //last pickup in array
+						double lon = tripNumber(grouptriparrtot[f-1], 37);
 						bg::assign_values(centroid, lon, lat); //make that the centroid
 
 
@@ -31146,8 +32334,8 @@ void optimizeRoutes(){
 						}
 						else{
 							for(int i = 0; i < groupcnt+1;i++){ //get inital dropoff closest to last pickup in group
-								double lat = to_number(schd_tab[grouptriparrdo[i]][10]);
-								double lon = to_number(schd_tab[grouptriparrdo[i]][37]);
+								double lat = tripNumber(grouptriparrdo[i], 10);
+								double lon = tripNumber(grouptriparrdo[i], 37);
 								bg::assign_values(p, lon, lat);
 								point_type p2;
 								boost::geometry::convert(p, p2);
@@ -31170,8 +32358,8 @@ void optimizeRoutes(){
 							dropoffcentroid = 0;
 
 							for(int i = 0; i < groupcnt+1;i++){ //get dropoff farthest to last pickup in group
-								double lat = to_number(schd_tab[grouptriparrdo[i]][10]);
-								double lon = to_number(schd_tab[grouptriparrdo[i]][37]);
+								double lat = tripNumber(grouptriparrdo[i], 10);
+								double lon = tripNumber(grouptriparrdo[i], 37);
 								bg::assign_values(p, lon, lat);
 								point_type p2;
 								boost::geometry::convert(p, p2);
@@ -31195,8 +32383,8 @@ void optimizeRoutes(){
 								}
 							}
 
-							lat = to_number(schd_tab[dropoffcentroid][10]); //last pickup in array
-							lon = to_number(schd_tab[dropoffcentroid][37]);
+							lat = tripNumber(dropoffcentroid, 10); //last pickup in array
+							lon = tripNumber(dropoffcentroid, 37);
 							bg::assign_values(centroid, lon, lat); //make that the centroid
 
 							//  if(DEBUG == 1) gse << " Drop off centroid " << schd_tab[dropoffcentroid][3] << endl;
@@ -31218,11 +32406,11 @@ void optimizeRoutes(){
 										}
 										else if(h+1 == f){
 											//newinsert = true;
-											double lat = to_number(schd_tab[grouptriparrdo[i]][10]);
-											double lon = to_number(schd_tab[grouptriparrdo[i]][37]);
+											double lat = tripNumber(grouptriparrdo[i], 10);
+											double lon = tripNumber(grouptriparrdo[i], 37);
 											bg::assign_values(p, lon, lat);
-											double lat1 = to_number(schd_tab[grouptriparrtot[f-1]][10]);
-											double lon1 = to_number(schd_tab[grouptriparrtot[f-1]][37]);
+											double lat1 = tripNumber(grouptriparrtot[f-1], 10);
+											double lon1 = tripNumber(grouptriparrtot[f-1], 37);
 											bg::assign_values(p1, lon1, lat1);
 											point_type p2;
 											point_type p3;
@@ -31308,7 +32496,7 @@ void optimizeRoutes(){
 								i = 0;
 
 							if(i+1 != (groupcnt * 2) + 2 && strcmp(schd_tab[grouptriparrtot[i]][42],schd_tab[grouptriparrtot[i+1]][42])==0 &&
-									(int)to_number(schd_tab[grouptriparrtot[i]][4]) >  (int)to_number(schd_tab[grouptriparrtot[i+1]][4])){
+									(int)tripNumber(grouptriparrtot[i], 4) >  (int)tripNumber(grouptriparrtot[i+1], 4)){
 								if(DEBUG == 1) gse << "We should swap these trips based off timeslot and cluster " << schd_tab[grouptriparrtot[i]][3]  << " " << schd_tab[grouptriparrtot[i+1]][3] << endl;
 								int temp = grouptriparrtot[i];
 								grouptriparrtot[i] = grouptriparrtot[i+1];
@@ -31320,6 +32508,17 @@ void optimizeRoutes(){
 						}
 
 
+						//every getTime() below for this group, the regrouped order included, routed at once
+						vector<std::pair<int, int>> legs;
+						for (int i = 0; i + 1 < (groupcnt * 2) + 2; i++){
+							legs.push_back(std::make_pair(local_s_tab[i], local_s_tab[i + 1]));
+							legs.push_back(std::make_pair(grouptriparrtot[i], grouptriparrtot[i + 1]));
+						}
+						legs.push_back(std::make_pair(local_s_tab[0], pickupafter));
+						legs.push_back(std::make_pair(local_s_tab[(groupcnt * 2) + 1], dropoffbefore));
+						legs.push_back(std::make_pair(grouptriparrtot[0], pickupafter));
+						legs.push_back(std::make_pair(grouptriparrtot[(groupcnt * 2) + 1], dropoffbefore));
+						prefetchTravelTimes(legs);
 						for (int i = 0; i < (groupcnt * 2) + 2; i++){
 							distances[i] = 0;
 						}
@@ -31534,7 +32733,6 @@ void optimizeRoutes(){
 
 			string clientdate = "INREOPTIMIZEFORCLIENT";
 
-			strcpy(shared_process_tab[WRITINGFB][0], "REOPTIMIZEROUTES");
 			int q = 0;
 			int waitingforosrm = 0;
 
@@ -31559,29 +32757,16 @@ void optimizeRoutes(){
 					lon2 = schd_tab[fullRoute[g]][37];
 				}
 				string osrm = lat1 + "," + lon1 + "," + lat2 + "," + lon2;
-				for (int d = 0; d < MAXREQUESTS; d++)
-				{
-
-					if (requestIsEmpty(d))
-					{
-						usleep(10);
-						if (requestIsEmpty(d))
-						{
-							q = d;
-							break;
-						}
-					}
-					if (d + 1 == MAXREQUESTS)
-						d = -1;
-				}
+				q = acquireRequest();
 				//  if(DEBUG == 1) gse << "q is " << q << endl;
 
 				string function = "SlackDist";
 
 				time_t t = time(NULL);
-				struct tm tm = *localtime(&t);
+				struct tm tm;
+				localtime_r(&t, &tm);
 				char timebuffer[100];
-				sprintf(timebuffer, "%s", asctime(&tm));
+				asctime_r(&tm, timebuffer);
 				string localtimestr = timebuffer;
 				localtimestr.erase(std::remove(localtimestr.begin(), localtimestr.end(), '\n'), localtimestr.end());
 				//  if(DEBUG == 1) gse << "Writing to arrays " << endl;
@@ -31591,11 +32776,11 @@ void optimizeRoutes(){
 				updateRequest(q, to_string(g), "ID");
 				updateRequest(q, osrm, "LATLONG");
 				updateRequest(q, to_string(fullRoute[g]), "TRIPIDX");
+				submitRequest(q);
 				//  if(DEBUG == 1) gse << "Done " << endl;
 				waitingforosrm++;
 				//}
 			}
-			strcpy(shared_process_tab[WRITINGFB][0], "READY");
 
 			//  if(DEBUG == 1) gse << "waiting for osrm " << endl;
 			int g = 0;
@@ -31604,6 +32789,7 @@ void optimizeRoutes(){
 			while (true)
 			{
 
+				int completionsseen = requestCompletions();
 				for (int q = 0; q < MAXREQUESTS; q++)
 				{
 					if (fetchRequest(q, "DISTANCE") != "" &&  fetchRequest(q, "TIME") != "" &&fetchRequest(q, "ID") == to_string(g) && fetchRequest(q, "NUM") == clientdate && fetchRequest(q, "FUNC") == "SlackDist")
@@ -31614,8 +32800,6 @@ void optimizeRoutes(){
 						times1[(int)to_number(fetchRequest(q, "TRIPIDX"))] = to_number(time1);
 						//  if(DEBUG == 1) gse << fetchRequest(q, "ID") << " " << schd_tab[(int)to_number(fetchRequest(q, "TRIPIDX"))][3] << " " << dist << " " << (int)to_number(fetchRequest(q, "ID")) << endl;
 						clearRequest(q);
-						while(!requestIsEmpty(q)){
-						}
 						f++;
 						g++;
 						datafromosrm++;
@@ -31625,6 +32809,7 @@ void optimizeRoutes(){
 
 				if (datafromosrm == waitingforosrm)
 					break;
+				waitForRequestCompletion(completionsseen);
 			}
 
 
@@ -31689,7 +32874,7 @@ void optimizeRoutes(){
 				}
 
 				string route = schd_tab[fullRoute[i]][0];
-				int g = (int)to_number(schd_tab[fullRoute[i]][20]);
+				int g = (int)tripNumber(fullRoute[i], 20);
 
 				strcpy(schd_tab[g][2], to_string(stopnum).c_str());
 				strcpy(schd_tab[g][19], to_string(stopnum2).c_str());
@@ -31970,12 +33155,12 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 				//   if(DEBUG == 1) gse << "k is " << k << " " <<  endl;
 				/*
                                             if(strcmp(schd_tab[index2][7],"D") == 0  && //if there's another trip in the group
-                                                strcmp(schd_tab[(int)to_number(schd_tab[index2][PICKUPIDX])][7],"P")==0
-                                                != (int)to_number(schd_tab[(int)to_number(schd_tab[index2][PICKUPIDX])][2]) - 5){
+                                                strcmp(schd_tab[(int)tripNumber(index2, PICKUPIDX)][7],"P")==0
+                                                != (int)tripNumber((int)tripNumber(index2, PICKUPIDX), 2) - 5){
                                                 groupcnt = 0;
                                                 interruptedgroup = true;
                                                   if(DEBUG == 1) gse << schd_tab[index][2] << " " << schd_tab[index2][2] << endl;
-                                                  if(DEBUG == 1) gse << " interuppted " << (int)to_number(schd_tab[(int)to_number(schd_tab[index][PICKUPIDX])][2]) << " = " <<(int)to_number(schd_tab[(int)to_number(schd_tab[index2][PICKUPIDX])][2]) << " | " << endl;
+                                                  if(DEBUG == 1) gse << " interuppted " << (int)tripNumber((int)tripNumber(index, PICKUPIDX), 2) << " = " <<(int)tripNumber((int)tripNumber(index2, PICKUPIDX), 2) << " | " << endl;
                                                 break;
                                             }*/
 				//else{
@@ -31984,7 +33169,7 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 					grpfound = true;
 				}
 
-				pickupindicies[groupcnt] = (int)to_number(schd_tab[index][PICKUPIDX]);
+				pickupindicies[groupcnt] = (int)tripNumber(index, PICKUPIDX);
 				dropoffindicies[groupcnt] = index;
 
 				fullRoute[fullRoutecnt] = dropoffindicies[groupcnt];
@@ -32089,7 +33274,7 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 			}
 
 			for(int o = 0; o < groupcnt;o++){
-				stopnum[o] = to_number(schd_tab[pickupindicies[o]][2]);
+				stopnum[o] = tripNumber(pickupindicies[o], 2);
 
 			}
 
@@ -32101,7 +33286,7 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 			}
 
 			for(int o = 0; o < groupcnt;o++){
-				stopnum[o] = to_number(schd_tab[dropoffindicies[o]][2]);
+				stopnum[o] = tripNumber(dropoffindicies[o], 2);
 
 			}
 			bubbleSort_twoarray(stopnum,dropoffindicies,groupcnt);
@@ -32144,8 +33329,8 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 
 			for(int o = 0; o < groupcnt;o++){
 
-				if (largestpromtime < (int)to_number(schd_tab[pickupindicies[o]][4])){
-					largestpromtime = (int)to_number(schd_tab[pickupindicies[o]][4]);
+				if (largestpromtime < (int)tripNumber(pickupindicies[o], 4)){
+					largestpromtime = (int)tripNumber(pickupindicies[o], 4);
 					if(strcmp(schd_tab[pickupindicies[o]][18],"Y")==0){
 						isreturntriplargest = true;
 						largestidx = pickupindicies[o];
@@ -32156,8 +33341,8 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 					}
 				}
 
-				if (smalleststarttime > (int)to_number(schd_tab[pickupindicies[o]][26]) && (int)to_number(schd_tab[pickupindicies[o]][26]) != 0 ){
-					smalleststarttime = (int)to_number(schd_tab[pickupindicies[o]][26]);
+				if (smalleststarttime > (int)tripNumber(pickupindicies[o], 26) && (int)tripNumber(pickupindicies[o], 26) != 0 ){
+					smalleststarttime = (int)tripNumber(pickupindicies[o], 26);
 					if(strcmp(schd_tab[pickupindicies[o]][18],"Y")==0){
 						isreturntripsmallest = true;
 						smallestidx = pickupindicies[o];
@@ -32453,8 +33638,8 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 
 			for(int o = 0; o < groupcnt;o++){
 
-				if (largestpromtime < (int)to_number(schd_tab[dropoffindicies[o]][4])){
-					largestpromtime = (int)to_number(schd_tab[dropoffindicies[o]][4]);
+				if (largestpromtime < (int)tripNumber(dropoffindicies[o], 4)){
+					largestpromtime = (int)tripNumber(dropoffindicies[o], 4);
 					if(strcmp(schd_tab[dropoffindicies[o]][18],"Y")==0){
 						isreturntriplargest = true;
 						largestidx = dropoffindicies[o];
@@ -32465,8 +33650,8 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 					}
 				}
 
-				if (smallestendtime > (int)to_number(schd_tab[dropoffindicies[o]][27]) && (int)to_number(schd_tab[dropoffindicies[o]][27]) != 0 ){
-					smallestendtime = (int)to_number(schd_tab[dropoffindicies[o]][27]);
+				if (smallestendtime > (int)tripNumber(dropoffindicies[o], 27) && (int)tripNumber(dropoffindicies[o], 27) != 0 ){
+					smallestendtime = (int)tripNumber(dropoffindicies[o], 27);
 					if(strcmp(schd_tab[dropoffindicies[o]][18],"Y")==0){
 						isreturntripsmallest = true;
 						smallestidx = dropoffindicies[o];
@@ -32742,7 +33927,7 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 			for(int q = 0; q < groupcnt-1;q++){
 
 
-				if((int)to_number(schd_tab[pickupindicies[q]][2]) + 1 != (int)to_number(schd_tab[pickupindicies[q+1]][2])){
+				if((int)tripNumber(pickupindicies[q], 2) + 1 != (int)tripNumber(pickupindicies[q+1], 2)){
 					if(DEBUG == 1) gse << "Stop number " << schd_tab[pickupindicies[q]][2] << " " << schd_tab[pickupindicies[q+1]][2] << endl;
 					groupcnt = 0;
 					interruptedgroup = true;
@@ -32760,7 +33945,7 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 
 
 
-					if((int)to_number(schd_tab[dropoffindicies[q]][2]) + 1 != (int)to_number(schd_tab[dropoffindicies[q+1]][2])){
+					if((int)tripNumber(dropoffindicies[q], 2) + 1 != (int)tripNumber(dropoffindicies[q+1], 2)){
 						if(DEBUG == 1) gse << "Stop number1 " << schd_tab[dropoffindicies[q]][2] << " " << schd_tab[dropoffindicies[q+1]][2] << endl;
 						interruptedgroup = true;
 						grpfound = false;
@@ -32771,7 +33956,7 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 			}
 
 			if(!interruptedgroup){
-				if((int)to_number(schd_tab[pickupindicies[groupcnt-1]][2]) + 1 != (int)to_number(schd_tab[dropoffindicies[0]][2])){
+				if((int)tripNumber(pickupindicies[groupcnt-1], 2) + 1 != (int)tripNumber(dropoffindicies[0], 2)){
 					if(DEBUG == 1) gse << "Stop number2 " << schd_tab[pickupindicies[groupcnt-1]][2] << " " << schd_tab[dropoffindicies[0]][2] << endl;
 					interruptedgroup = true;
 					grpfound = false;
@@ -32921,7 +34106,7 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 
 					tempidx = (*local_s_tab)[j+1];
 					//  if(DEBUG == 1) gse << "stop num 2 " << (int)to_number(schd_tab[tempidx][2]) << endl;
-					if((int)to_number(schd_tab[tempidx][2]) == stopnum[0]){
+					if((int)tripNumber(tempidx, 2) == stopnum[0]){
 						stoptoinsertafter = (*local_s_tab)[j];
 						break;
 					}
@@ -33223,8 +34408,8 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 
 
 						for(int o = 0; o < groupcnt+1;o++){ ///get centroid of p and d area of group trips
-							double lat = to_number(schd_tab[grouptriparrdo[o]][10]);
-						double lon = to_number(schd_tab[grouptriparrdo[o]][37]);
+							double lat = tripNumber(grouptriparrdo[o], 10);
+						double lon = tripNumber(grouptriparrdo[o], 37);
 						bg::assign_values(p, lon, lat);
 						ring.push_back(p);
 						}
@@ -33235,8 +34420,8 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 
 						for(int i = 0; i < groupcnt+1;i++){ //get inital pickup farthest from centroid of dropoff
 
-							double lat = to_number(schd_tab[temp[i]][10]);
-							double lon = to_number(schd_tab[temp[i]][37]);
+							double lat = tripNumber(temp[i], 10);
+							double lon = tripNumber(temp[i], 37);
 							bg::assign_values(p, lon, lat);
 							point_type p2;
 							boost::geometry::convert(p, p2);
@@ -33308,11 +34493,11 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 									}
 									else if(h+1 == r){
 										//newinsert = true;
-										double lat = to_number(schd_tab[temp[i]][10]);
-										double lon = to_number(schd_tab[temp[i]][37]);
+										double lat = tripNumber(temp[i], 10);
+										double lon = tripNumber(temp[i], 37);
 										bg::assign_values(p, lon, lat);
-										double lat1 = to_number(schd_tab[grouptriparrtot[r-1]][10]);
-										double lon1 = to_number(schd_tab[grouptriparrtot[r-1]][37]);
+										double lat1 = tripNumber(grouptriparrtot[r-1], 10);
+										double lon1 = tripNumber(grouptriparrtot[r-1], 37);
 										bg::assign_values(p1, lon1, lat1);
 										point_type p2;
 										point_type p3;
@@ -33362,8 +34547,8 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 					distpu = 0;
 
 
-					double lat = to_number(schd_tab[grouptriparrtot[f-1]][10]); //last pickup in array
-					double lon = to_number(schd_tab[grouptriparrtot[f-1]][37]);
+					double lat = tripNumber(grouptriparrtot[f-1], 10); //last pickup in array
+					double lon = tripNumber(grouptriparrtot[f-1], 37);
 					bg::assign_values(centroid, lon, lat); //make that the centroid
 
 
@@ -33381,8 +34566,8 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 					}
 					else{
 						for(int i = 0; i < groupcnt+1;i++){ //get inital dropoff closest to last pickup in group
-							double lat = to_number(schd_tab[grouptriparrdo[i]][10]);
-							double lon = to_number(schd_tab[grouptriparrdo[i]][37]);
+							double lat = tripNumber(grouptriparrdo[i], 10);
+							double lon = tripNumber(grouptriparrdo[i], 37);
 							bg::assign_values(p, lon, lat);
 							point_type p2;
 							boost::geometry::convert(p, p2);
@@ -33405,8 +34590,8 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 						dropoffcentroid = 0;
 
 						for(int i = 0; i < groupcnt+1;i++){ //get dropoff farthest to last pickup in group
-							double lat = to_number(schd_tab[grouptriparrdo[i]][10]);
-							double lon = to_number(schd_tab[grouptriparrdo[i]][37]);
+							double lat = tripNumber(grouptriparrdo[i], 10);
+							double lon = tripNumber(grouptriparrdo[i], 37);
 							bg::assign_values(p, lon, lat);
 							point_type p2;
 							boost::geometry::convert(p, p2);
@@ -33430,8 +34615,8 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 							}
 						}
 
-						lat = to_number(schd_tab[dropoffcentroid][10]); //last pickup in array
-						lon = to_number(schd_tab[dropoffcentroid][37]);
+						lat = tripNumber(dropoffcentroid, 10); //last pickup in array
+						lon = tripNumber(dropoffcentroid, 37);
 						bg::assign_values(centroid, lon, lat); //make that the centroid
 
 						if(DEBUG == 1) gse << " Drop off centroid " << schd_tab[dropoffcentroid][3] << endl;
@@ -33453,11 +34638,11 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 									}
 									else if(h+1 == f){
 										//newinsert = true;
-										double lat = to_number(schd_tab[grouptriparrdo[i]][10]);
-										double lon = to_number(schd_tab[grouptriparrdo[i]][37]);
+										double lat = tripNumber(grouptriparrdo[i], 10);
+										double lon = tripNumber(grouptriparrdo[i], 37);
 										bg::assign_values(p, lon, lat);
-										double lat1 = to_number(schd_tab[grouptriparrtot[f-1]][10]);
-										double lon1 = to_number(schd_tab[grouptriparrtot[f-1]][37]);
+										double lat1 = tripNumber(grouptriparrtot[f-1], 10);
+										double lon1 = tripNumber(grouptriparrtot[f-1], 37);
 										bg::assign_values(p1, lon1, lat1);
 										point_type p2;
 										point_type p3;
@@ -33578,7 +34763,7 @@ bool optimizeRoutesSingleSLACK(int (*local_s_tab)[MAXSTOPS]){
 			if(i < 0)
 				i = 0;
 			if(i+1 != ((groupcnt * 2) + 2) && strcmp(schd_tab[grouptriparrtot[i]][42],schd_tab[grouptriparrtot[i+1]][42]) ==0 &&
-					(int)to_number(schd_tab[grouptriparrtot[i]][4]) >  (int)to_number(schd_tab[grouptriparrtot[i+1]][4])){
+					(int)tripNumber(grouptriparrtot[i], 4) >  (int)tripNumber(grouptriparrtot[i+1], 4)){
 				if(DEBUG == 1) gse << "We should swap these trips based off timeslot and cluster " << schd_tab[grouptriparrtot[i]][3]  << " " << schd_tab[grouptriparrtot[i+1]][3] << endl;
 				int temp = grouptriparrtot[i];
 				grouptriparrtot[i] = grouptriparrtot[i+1];
@@ -34064,91 +35249,6 @@ int updateSlack(int t1, int t2, int cid, int segstart, int isslack){
 	return 1;
 }
 
-void updateDatabase(int cnt, int index, Environment* env, Connection* conn, char (*schd_tab)[TRIPCOLSIZE][MAXLGSTRSIZE],int (*s_tab)[MAXSTOPS], string table_itms_segments,string table_itms_trips){
-	string temp;
-	string perf_time;
-	string timetonextstop;
-	string eta;
-	string etd;
-	string amb_occ;
-	string wc_occ;
-	char updatebuffer[916];
-	string dist;
-	string tripid;
-	string prom_time;
-	string stopnum;
-
-	// if(DEBUG == 1) gse << schd_tab[s_tab[index][1]][0] << " " << cnt << " " << index  << endl;
-
-
-
-	for(int i = 1; i < cnt+1; i++){
-
-		//    if(DEBUG == 1) gse << "PU AMB " <<schd_tab[i][31] << endl;
-
-		prom_time = schd_tab[s_tab[index][i]][4];
-		stopnum = schd_tab[s_tab[index][i]][2];
-		perf_time = schd_tab[s_tab[index][i]][25];
-
-		timetonextstop = schd_tab[s_tab[index][i]][28];
-		eta = schd_tab[s_tab[index][i]][29];
-		//temp = temp+",";
-		etd = schd_tab[s_tab[index][i]][30];
-		// if(DEBUG == 1) gse << "TEMP " << b_time1[i] <<endl;
-		amb_occ =  schd_tab[s_tab[index][i]][31];
-		wc_occ =  schd_tab[s_tab[index][i]][32];
-		dist = schd_tab[s_tab[index][i]][6];
-		tripid = schd_tab[s_tab[index][i]][3];
-		//   times  =  p_promised_time +","+est_traveltime1 +","+arrivetime1 +","+ departtime1 +","+to_string(p_perf_time) +","+starttime1 +","+endtime1 +","+to_string(p_timetonextstop) +","+to_string(itms_to_minutes (ampm2fullhrs (p_eta))); +","+to_string(itms_to_minutes (ampm2fullhrs (p_etd)));
-		string command;
-
-		//   if(DEBUG == 1) gse << "stop " << schd_tab[s_tab[index][i]][2] <<  " " << s_tab[index][i] << endl;
-
-		if (strcmp(schd_tab[s_tab[index][i]][2],"1") == 0 ){
-
-			sprintf(updatebuffer, "UPDATE %s set pu_etd = %s,pu_eta = %s, pu_disttonextstop=%s where SEGMENTID = '%s' AND TRAVEL_DATE = '%s'"
-					,table_itms_segments.c_str(), prom_time.c_str(),to_string((int)to_number(prom_time)-15).c_str(), dist.c_str(), tripid.c_str(),schd_tab[s_tab[index][i]][1] );
-
-
-		}
-		else if /*(strcmp(schd_tab[i][2],"1") == 0 ||*/ (strcmp(schd_tab[s_tab[index][i]][2],MAXSTOPNUM[0]) == 0 ){
-
-			sprintf(updatebuffer, "UPDATE %s set do_timetonextstop = %s,  do_disttonextstop = %s,  do_eta = %s, do_etd = %s where SEGMENTID = '%s' AND TRAVEL_DATE = '%s'"
-					,table_itms_segments.c_str(), timetonextstop.c_str(),dist.c_str(),eta.c_str(),eta.c_str(),tripid.c_str(),schd_tab[s_tab[index][i]][1] );
-
-			// if(DEBUG == 1) gse << updatebuffer << endl;
-
-		}
-
-		else if(strcmp(schd_tab[s_tab[index][i]][7],"P")==0 && strcmp(schd_tab[s_tab[index][i]][2],"1")!=0 && strcmp(schd_tab[s_tab[index][i]][2],"999")!=0  ){
-
-
-			sprintf(updatebuffer, "UPDATE %s set pu_stop = %s, pu_perf_time = %s, pu_eta = %s, pu_etd = %s, pu_amb_occ = %s, pu_wc_occ = %s, pu_disttonextstop = %s, pu_timetonextstop = %s, SYSTEM_USER = '%s' where tripid = '%s'"
-					,table_itms_trips.c_str(), stopnum.c_str(),  perf_time.c_str(),eta.c_str(),etd.c_str(),amb_occ.c_str(),wc_occ.c_str(),dist.c_str(), timetonextstop.c_str(),"SHM", /*std::chrono::system_clock::now()"05-JAN-2018"*/tripid.c_str() );
-
-		}
-
-		else if (strcmp(schd_tab[s_tab[index][i]][7],"D")==0 && strcmp(schd_tab[s_tab[index][i]][2],"1")!=0 && strcmp(schd_tab[s_tab[index][i]][2],"999")!=0  ) {
-			sprintf(updatebuffer, "UPDATE %s set do_stop = %s, do_perf_time = %s, do_eta = %s, do_etd = %s, do_amb_occ = %s, do_wc_occ = %s , do_disttonextstop = %s, do_timetonextstop = %s,SYSTEM_USER = '%s' where tripid = '%s'"
-					,table_itms_trips.c_str(), stopnum.c_str(), perf_time.c_str(),eta.c_str(),etd.c_str(), amb_occ.c_str(),wc_occ.c_str(),dist.c_str(), timetonextstop.c_str(), "SHM", /*std::chrono::system_clock::now() "05-JAN-2018"*/tripid.c_str() );
-		}
-
-
-		command = updatebuffer;
-		if(DEBUG == 1) gse << command << ";"<< endl;
-		//  if(DEBUG == 1) gse << "OCCI command \n" <<command <<endl;
-
-		Statement* stmt = conn->createStatement (command);
-		stmt->executeUpdate();
-		conn->commit();
-		///////////stmt->closeResultSet(rset);
-		conn->terminateStatement(stmt);
-
-		//  if(DEBUG == 1) gse << i << " finishing update statement " << cnt << endl;
-
-	}
-
-}
 
 int lst[1][MAXSTOPS];
 
@@ -34210,7 +35310,7 @@ if((int)to_number(eta2) >= n_eta && n_eta >= (int)to_number(earliest2) && "N" ==
 }
 
 else if ((int)to_number(eta2) < n_eta && "N" == returntrip || n_eta < (int)to_number(earliest2) && "N" == returntrip) {
-      if(DEBUG == 1) gse << "Is not a return trip and " +to_string(n_eta)+ " < " + earliest2 + "or "  +eta2+ " < " + to_string(n_eta) + " with stop num "  << (*temproute)[start_loc][2] <<
+      if(DEBUG == 1) gse << "Is not a return trip and " << n_eta << " < " << earliest2 << "or " << eta2 << " < " << n_eta << " with stop num "  << (*temproute)[start_loc][2] <<
     " " << etd << " - " << perf << " - " << ttns << " new eta " << n_etd << " - " << perf2 <<   endl;
     return false;
     }
@@ -34234,7 +35334,7 @@ else if("Y" == returntrip  && (int)to_number(eta) >  (int)to_number(promtime)){
     }
 
     else{
-            if(DEBUG == 1) gse << "Is a return trip and " +to_string(n_eta)+ " > " +latest << endl;
+            if(DEBUG == 1) gse << "Is a return trip and " << n_eta << " > " << latest << endl;
         return false;
     }
 
@@ -34443,13 +35543,13 @@ void recalcons_tab(string a_route , Environment* env, Connection* conn, string t
 			//    if(DEBUG == 1) gse << "Test " << s_tab[i][k] << endl;
 			if(s_tab[i][k]==0){break;}
 
-			p_stop_num = (int)to_number(schd_tab[s_tab[i][k]][2]);
+			p_stop_num = (int)tripNumber(s_tab[i][k], 2);
 
 			if(p_stop_num == 1){
 				index = s_tab[i][k];
 				cnt = 0;
 				//   if(DEBUG == 1) gse << "Stop " << schd_tab[s_tab[i][k]][2] <<endl;
-				disttrav = to_number(schd_tab[s_tab[i][k]][6]);
+				disttrav = tripNumber(s_tab[i][k], 6);
 				dist = schd_tab[s_tab[i][k]][6];//////////////////////////////////move distance to after loop when finished converting binary tree function as
 				////////////// because it stores the NEXT distance as distance FROM.
 
@@ -34489,8 +35589,8 @@ void recalcons_tab(string a_route , Environment* env, Connection* conn, string t
 				// temp = schd_tab[s_tab[i][k]][12];
 				amb_occ1 =  schd_tab[s_tab[i][k]][31];
 				wc_occ1 =  schd_tab[s_tab[i][k]][32];
-				p_cs_occ = to_number(schd_tab[s_tab[i][k]][CS_OCC]);
-				p_bs_occ =to_number(schd_tab[s_tab[i][k]][BS_OCC]);
+				p_cs_occ = tripNumber(s_tab[i][k], CS_OCC);
+				p_bs_occ =tripNumber(s_tab[i][k], BS_OCC);
 				amb_cap1 =  schd_tab[s_tab[i][1]][33];
 
 				//temp = temp+",";
@@ -34507,16 +35607,16 @@ void recalcons_tab(string a_route , Environment* env, Connection* conn, string t
 				p_return_trip = schd_tab[s_tab[i][k]][18];
 				p_stop_type = schd_tab[s_tab[i][k]][7];
 
-				disttrav = (int)to_number(schd_tab[s_tab[i][k]][6]);
+				disttrav = (int)tripNumber(s_tab[i][k], 6);
 				dist = schd_tab[s_tab[i][k]][6];
 				//////////////////////////////////move distance to after loop when finished converting binary tree function as
 				////////////// because it stores
-				p_esc = (int)to_number(schd_tab[s_tab[i][k]][13]);
+				p_esc = (int)tripNumber(s_tab[i][k], 13);
 				p_td_segmentid = schd_tab[s_tab[i][k]][0];
 
 				//  if(DEBUG == 1) gse << "The segment is for recalc " << p_td_segmentid << " " <<  schd_tab[s_tab[i][k]][0] << endl;
 
-				p_stop_num = (int)to_number(schd_tab[s_tab[i][k]][2]);
+				p_stop_num = (int)tripNumber(s_tab[i][k], 2);
 				p_citytown = schd_tab[s_tab[i][k]][11];
 
 				p_eta = eta1;
@@ -34561,8 +35661,8 @@ void recalcons_tab(string a_route , Environment* env, Connection* conn, string t
 			// temp = schd_tab[s_tab[i][k]][12];
 			amb_occ1 =  schd_tab[s_tab[i][k]][31];
 			wc_occ1 =  schd_tab[s_tab[i][k]][32];
-			p_cs_occ = to_number(schd_tab[s_tab[i][k]][CS_OCC]);
-			p_bs_occ =to_number(schd_tab[s_tab[i][k]][BS_OCC]);
+			p_cs_occ = tripNumber(s_tab[i][k], CS_OCC);
+			p_bs_occ =tripNumber(s_tab[i][k], BS_OCC);
 			amb_cap1 =  schd_tab[s_tab[i][1]][33];
 			//temp = temp+",";
 			wc_cap1 =  schd_tab[s_tab[i][1]][34]; /// fix this hack in get next token
@@ -34581,7 +35681,7 @@ void recalcons_tab(string a_route , Environment* env, Connection* conn, string t
 			p_name = schd_tab[s_tab[i][k]][14];
 			p_return_trip = schd_tab[s_tab[i][k]][18];
 			p_stop_type = schd_tab[s_tab[i][k]][7];
-			p_esc = (int)to_number(schd_tab[s_tab[i][k]][13]);
+			p_esc = (int)tripNumber(s_tab[i][k], 13);
 			p_td_segmentid = schd_tab[s_tab[i][k]][0];
 
 
@@ -34650,7 +35750,7 @@ void recalcons_tab(string a_route , Environment* env, Connection* conn, string t
 					p_MAXEARLYDROPOFFFACTOR1, p_DIALRIDEEARLYPICKFACTOR1, p_DIALRIDELATEPICKFACTOR1, p_OTHEREARLYPICKFACTOR1,  p_OTHERLATEPICKFACTOR1,IGNOREPUTIMES1, p_SHORTBREAK1, p_LUNCHBREAK1,  p_PROXIMITYFACTOR1,  a_mediumshortdistance1, a_mediumlongdistance1, a_shorttriptime1,
 					a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip,  pDisability, p_trip_type1);
 
-			double estdisttrip = to_number(schd_tab[s_tab[i][k]][21]);
+			double estdisttrip = tripNumber(s_tab[i][k], 21);
 
 			int aAllowedTT;
 
@@ -34680,7 +35780,7 @@ void recalcons_tab(string a_route , Environment* env, Connection* conn, string t
 			tripid = tripid.substr(0,1);
 			string endtime2;
 			if(tripid == "S"){
-				endtime2 =to_string( (int)itms_to_minutes(ampm2fullhrs(p_promised_time)));
+				endtime2 =to_string( (int)dayMinute(p_promised_time));
 			}
 
 			if(p_stop_type == "P"){
@@ -34765,7 +35865,7 @@ void recalcons_tab(string a_route , Environment* env, Connection* conn, string t
 			p_bs_occ = std::get<14>(varHolder);
 
 			if(!secondpassinsertedtrip){
-				p_etd =  itms_minutes_to_ampm(itms_to_minutes (ampm2fullhrs(p_etd)) - p_perf_time);
+				p_etd =  itms_minutes_to_ampm(dayMinute(p_etd) - p_perf_time);
 
 				if (p_stop_num != 1 && p_stop_num !=(int)to_number(MAXSTOPNUM[0])) {
 					if (timetonextstop2 == 0 && strcmp(schd_tab[s_tab[i][k]][7],schd_tab[s_tab[i][k-1]][7])==0)
@@ -34816,21 +35916,21 @@ void recalcons_tab(string a_route , Environment* env, Connection* conn, string t
 					}
 
 				}
-				p_etd =  itms_minutes_to_ampm(itms_to_minutes (ampm2fullhrs (p_etd)) + p_perf_time);
+				p_etd =  itms_minutes_to_ampm(dayMinute(p_etd) + p_perf_time);
 				//   if(DEBUG == 1) gse << "petd changing after " << p_etd << endl;
 			}
 
 			if(p_stop_type  == "P"){
 				string tripidforwait = schd_tab[s_tab[i][k]][3];
-				int DW = getDWByStop (tripidforwait, p_stop_type ,itms_to_minutes(ampm2fullhrs (p_eta)) , itms_to_minutes (ampm2fullhrs(p_etd)),(int)to_number(starttime1),p_perf_time);
-				int PW = getPWByStop (tripidforwait,  p_stop_type  ,itms_to_minutes(ampm2fullhrs (p_eta))    , (int)to_number(starttime1));
+				int DW = getDWByStop (tripidforwait, p_stop_type ,dayMinute(p_eta) , dayMinute(p_etd),(int)to_number(starttime1),p_perf_time);
+				int PW = getPWByStop (tripidforwait,  p_stop_type  ,dayMinute(p_eta)    , (int)to_number(starttime1));
 				strcpy(schd_tab[s_tab[i][k]][DWWAIT], to_string(DW).c_str());
 				strcpy(schd_tab[s_tab[i][k]][PWWAIT], to_string(PW).c_str());
 			}
 			else{
-				int eta = itms_to_minutes (ampm2fullhrs (p_eta));
-				int etd = (int)to_number(schd_tab[s_tab[i][k-1]][30]);
-				int TT = (int)to_number(schd_tab[s_tab[i][k-1]][CALCULATEDTIME]);
+				int eta = dayMinute(p_eta);
+				int etd = (int)tripNumber(s_tab[i][k-1], 30);
+				int TT = (int)tripNumber(s_tab[i][k-1], CALCULATEDTIME);
 				string tripidforwait = schd_tab[s_tab[i][k]][3];
 				int DW = eta - etd + TT;
 				int PW = getPWByStop (tripidforwait,  schd_tab[s_tab[i][k]][7],eta, (int)to_number(endtime1));
@@ -34841,10 +35941,10 @@ void recalcons_tab(string a_route , Environment* env, Connection* conn, string t
 
 
 			//capacity  = to_string(p_amb_occ)+ ","+ to_string(p_wc_occ)+","+ amb_cap1+","+ wc_cap1+ "," +to_string(p_grp_cnt_amb) +","+ to_string(p_grp_cnt_wc)+","+ p_disability;
-			//times  =  to_string(itms_to_minutes (ampm2fullhrs ( p_promised_time))) +","+est_traveltime1 +","+arrivetime1 +","+ departtime1 +","+to_string(p_perf_time) +","+starttime1 +","+endtime1 +","+to_string(p_timetonextstop) +","+to_string(itms_to_minutes (ampm2fullhrs (p_eta))) +","+to_string(itms_to_minutes (ampm2fullhrs (p_etd)));
+			//times  =  to_string(dayMinute(p_promised_time)) +","+est_traveltime1 +","+arrivetime1 +","+ departtime1 +","+to_string(p_perf_time) +","+starttime1 +","+endtime1 +","+to_string(p_timetonextstop) +","+to_string(dayMinute(p_eta)) +","+to_string(dayMinute(p_etd));
 
 
-			strcpy((schd_tab[s_tab[i][k]][4]) , to_string(itms_to_minutes (ampm2fullhrs (p_promised_time))).c_str());
+			strcpy((schd_tab[s_tab[i][k]][4]) , to_string(dayMinute(p_promised_time)).c_str());
 
 			strcpy((schd_tab[s_tab[i][k]][22]) , est_traveltime1.c_str());
 
@@ -34864,9 +35964,9 @@ void recalcons_tab(string a_route , Environment* env, Connection* conn, string t
 			}
 
 
-			strcpy((schd_tab[s_tab[i][k]][29]) , to_string(itms_to_minutes (ampm2fullhrs (p_eta))).c_str());
+			strcpy((schd_tab[s_tab[i][k]][29]) , to_string(dayMinute(p_eta)).c_str());
 
-			strcpy((schd_tab[s_tab[i][k]][30]) ,to_string(itms_to_minutes (ampm2fullhrs (p_etd))).c_str());
+			strcpy((schd_tab[s_tab[i][k]][30]) ,to_string(dayMinute(p_etd)).c_str());
 
 			strcpy((schd_tab[s_tab[i][k]][31]) , to_string(p_amb_occ).c_str());
 
@@ -34930,7 +36030,7 @@ void recalcons_tab(string a_route , Environment* env, Connection* conn, string t
 			last_amb_occ=(int)to_number(prev_amb_occ1);
 			last_wc_occ=(int)to_number(prev_wc_occ1);
 			p_prev_perf_time = prev_p_perf_time;
-			p_prev_stop_num = (int)to_number(schd_tab[s_tab[i][k]][2]);
+			p_prev_stop_num = (int)tripNumber(s_tab[i][k], 2);
 			p_prev_promised_time = p_promised_time;
 
 
@@ -35261,7 +36361,7 @@ bool insertandcalcroute(int counter, double * distances, int * times, int * loca
 			strcpy(schd_tab[local_s_tab[i]][2],MAXSTOPNUM[0]);
 		}
 		else{
-			int stopnum4 = (int)to_number(schd_tab[local_s_tab[i-1]][2]);
+			int stopnum4 = (int)tripNumber(local_s_tab[i-1], 2);
 			stopnum4++;
 			strcpy(schd_tab[local_s_tab[i]][2],to_string(stopnum4).c_str());
 
@@ -35370,8 +36470,8 @@ for(int i = 0; i < counter; i++){
 		// temp = schd_tab[local_s_tab[i]][12];
 		amb_occ1 =  schd_tab[local_s_tab[i]][31];
 		wc_occ1 =  schd_tab[local_s_tab[i]][32];
-		p_cs_occ = to_number(schd_tab[local_s_tab[i]][CS_OCC]);
-		p_bs_occ =to_number(schd_tab[local_s_tab[i]][BS_OCC]);
+		p_cs_occ = tripNumber(local_s_tab[i], CS_OCC);
+		p_bs_occ =tripNumber(local_s_tab[i], BS_OCC);
 		amb_cap1 =  schd_tab[local_s_tab[SEGSTART]][33];
 		//temp = temp+",";
 		wc_cap1 =  schd_tab[local_s_tab[SEGSTART]][34]; /// fix this hack in get next token
@@ -35390,8 +36490,8 @@ for(int i = 0; i < counter; i++){
 		p_name = schd_tab[local_s_tab[i]][14];
 		p_return_trip = schd_tab[local_s_tab[i]][18];
 		p_stop_type = schd_tab[local_s_tab[i]][7];
-		p_esc = (int)to_number(schd_tab[local_s_tab[i]][13]);
-		p_stop_num = (int)to_number(schd_tab[local_s_tab[i]][2]);
+		p_esc = (int)tripNumber(local_s_tab[i], 13);
+		p_stop_num = (int)tripNumber(local_s_tab[i], 2);
 		p_td_segmentid = schd_tab[local_s_tab[SEGSTART]][0];
 		//    if(DEBUG == 1) gse << "The segment is  " << p_td_segmentid << " " <<  schd_tab[local_s_tab[SEGSTART]][0] << endl;
 		//  if(DEBUG == 1) gse << "STop num " << p_stop_num<< endl;
@@ -35472,7 +36572,7 @@ for(int i = 0; i < counter; i++){
 				p_MAXEARLYDROPOFFFACTOR1, p_DIALRIDEEARLYPICKFACTOR1, p_DIALRIDELATEPICKFACTOR1, p_OTHEREARLYPICKFACTOR1,  p_OTHERLATEPICKFACTOR1,IGNOREPUTIMES1, p_SHORTBREAK1, p_LUNCHBREAK1,  p_PROXIMITYFACTOR1,  a_mediumshortdistance1, a_mediumlongdistance1, a_shorttriptime1,
 				a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip,  pDisability,p_trip_type1);
 
-		double estdisttrip = to_number(schd_tab[local_s_tab[i]][21]);
+		double estdisttrip = tripNumber(local_s_tab[i], 21);
 
 		int aAllowedTT;
 		/*if(to_number(estdist[0]) < 3.0)
@@ -35497,7 +36597,7 @@ for(int i = 0; i < counter; i++){
 			if(DEBUG == 1) gse << "Extra travel time " << extratraveltime << endl;
 		}
 		int allowedDW;
-		double esttime = to_number(schd_tab[local_s_tab[i]][22]);
+		double esttime = tripNumber(local_s_tab[i], 22);
 
 		if(estdisttrip < a_mediumshortdistance1){
 			aAllowedTT = a_shorttriptime1 + extratraveltime;
@@ -35526,7 +36626,7 @@ for(int i = 0; i < counter; i++){
 		tripid = tripid.substr(0,1);
 		string endtime2;
 		if(tripid == "S"){
-			endtime2 =to_string( (int)itms_to_minutes(ampm2fullhrs(p_promised_time)));
+			endtime2 =to_string( (int)dayMinute(p_promised_time));
 		}
 
 		if(p_stop_type == "P"){
@@ -35624,7 +36724,7 @@ for(int i = 0; i < counter; i++){
 		p_bs_occ = std::get<14>(varHolder);
 
 		if(!secondpassinsertedtrip){
-			p_etd =  itms_minutes_to_ampm(itms_to_minutes (ampm2fullhrs (p_etd)) - p_perf_time);
+			p_etd =  itms_minutes_to_ampm(dayMinute(p_etd) - p_perf_time);
 
 
 
@@ -35677,12 +36777,12 @@ for(int i = 0; i < counter; i++){
 			}
 
 
-			p_etd =  itms_minutes_to_ampm(itms_to_minutes (ampm2fullhrs (p_etd)) + p_perf_time);
+			p_etd =  itms_minutes_to_ampm(dayMinute(p_etd) + p_perf_time);
 		}
 
 		bool changedeta = true;
 
-		if(itms_to_minutes (ampm2fullhrs (p_eta)) != eta)
+		if(dayMinute(p_eta) != eta)
 			changedeta = true;
 
 
@@ -35693,7 +36793,7 @@ for(int i = 0; i < counter; i++){
 
 		//  if(DEBUG == 1) gse << "2. I am here " << schd_tab[local_s_tab[0]][0] << endl;
 
-		strcpy(schd_tab[local_s_tab[i]][4], to_string(itms_to_minutes (ampm2fullhrs ( p_promised_time))).c_str());
+		strcpy(schd_tab[local_s_tab[i]][4], to_string(dayMinute(p_promised_time)).c_str());
 		strcpy( schd_tab[local_s_tab[i]][22] ,est_traveltime1.c_str());
 		strcpy( schd_tab[local_s_tab[i]][23],arrivetime1.c_str());
 		strcpy( schd_tab[local_s_tab[i]][24] ,departtime1.c_str());
@@ -35706,8 +36806,8 @@ for(int i = 0; i < counter; i++){
 			if(DEBUG == 1) gse << "Copying " << p_timetonextstop << "  to "  << local_s_tab[i-1] << endl;
 		}
 
-		strcpy(  schd_tab[local_s_tab[i]][29] ,to_string(itms_to_minutes (ampm2fullhrs (p_eta))).c_str());
-		strcpy(  schd_tab[local_s_tab[i]][30] ,to_string(itms_to_minutes (ampm2fullhrs (p_etd))).c_str());
+		strcpy(  schd_tab[local_s_tab[i]][29] ,to_string(dayMinute(p_eta)).c_str());
+		strcpy(  schd_tab[local_s_tab[i]][30] ,to_string(dayMinute(p_etd)).c_str());
 		//strcpy(  schd_tab[local_s_tab[i]][DIRTYBIT] ,("Y")) ;
 		//temproute[i][6] = to_string(disttrav);
 		strcpy( schd_tab[local_s_tab[i]][31] ,  to_string(p_amb_occ).c_str());
@@ -35719,17 +36819,17 @@ for(int i = 0; i < counter; i++){
 
 		if(p_stop_type  == "P"){
 			string tripidforwait = schd_tab[local_s_tab[i]][3];
-			int DW = getDWByStop (tripidforwait, p_stop_type ,itms_to_minutes (ampm2fullhrs (p_eta)) , itms_to_minutes (ampm2fullhrs (p_etd))  ,(int)to_number(starttime1), p_perf_time);
-			int PW = getPWByStop (tripidforwait,  p_stop_type  ,itms_to_minutes (ampm2fullhrs (p_eta))    , (int)to_number(starttime1));
+			int DW = getDWByStop (tripidforwait, p_stop_type ,dayMinute(p_eta) , dayMinute(p_etd)  ,(int)to_number(starttime1), p_perf_time);
+			int PW = getPWByStop (tripidforwait,  p_stop_type  ,dayMinute(p_eta)    , (int)to_number(starttime1));
 			strcpy(schd_tab[local_s_tab[i]][DWWAIT], to_string(DW).c_str());
 			strcpy(schd_tab[local_s_tab[i]][PWWAIT], to_string(PW).c_str());
 		}
 		else{
 
 
-			int eta = itms_to_minutes (ampm2fullhrs (p_eta));
-			int etd = (int)to_number(schd_tab[local_s_tab[i-1]][30]);
-			int TT = (int)to_number(schd_tab[local_s_tab[i-1]][CALCULATEDTIME]);
+			int eta = dayMinute(p_eta);
+			int etd = (int)tripNumber(local_s_tab[i-1], 30);
+			int TT = (int)tripNumber(local_s_tab[i-1], CALCULATEDTIME);
 			string tripidforwait = schd_tab[local_s_tab[i]][3];
 			int DW = eta - etd + TT;
 			int PW = getPWByStop (tripidforwait,  schd_tab[local_s_tab[i]][7],eta, (int)to_number(endtime1));
@@ -35794,7 +36894,7 @@ for(int i = 0; i < counter; i++){
 		last_amb_occ=(int)to_number(prev_amb_occ1);
 		last_wc_occ=(int)to_number(prev_wc_occ1);
 		p_prev_perf_time = prev_p_perf_time;
-		p_prev_stop_num = (int)to_number(schd_tab[local_s_tab[i]][2]);
+		p_prev_stop_num = (int)tripNumber(local_s_tab[i], 2);
 		p_prev_promised_time = p_promised_time;
 
 
@@ -35851,7 +36951,7 @@ for(int i = 0; i < counter; i++){
          latlon4= latlon4+ ","+ schd_tab[local_s_tab[i+1]][37];
 
 
-         actualTT = (itms_to_minutes (ampm2fullhrs (doeta)) - itms_to_minutes (ampm2fullhrs (puetd))); //flipped eta/etd
+         actualTT = (dayMinute(doeta) - dayMinute(puetd)); //flipped eta/etd
             if(DEBUG == 1) gse << "Actual travel time " << actualTT << endl;
     }
 		 */
@@ -35866,9 +36966,9 @@ for(int i = 0; i < counter; i++){
 
 		if(strcmp(schd_tab[local_s_tab[i]][7],"D")==0 && (tripid2.substr(0,1) == "T" ||  tripid2.substr(0,1) == "R") && p_trip_type2 != "BRK" && p_trip_type2 != "LUNCH" && p_trip_type2 != "ADMIN"){
 
-			int pickupid = (int)to_number(schd_tab[local_s_tab[i]][PICKUPIDX]);
-			int doeta1 = (int)to_number(schd_tab[local_s_tab[i]][30]) - (int)to_number(schd_tab[local_s_tab[i]][25]);
-			int puetd1 = (int)to_number(schd_tab[pickupid][30]);
+			int pickupid = (int)tripNumber(local_s_tab[i], PICKUPIDX);
+			int doeta1 = (int)tripNumber(local_s_tab[i], 30) - (int)tripNumber(local_s_tab[i], 25);
+			int puetd1 = (int)tripNumber(pickupid, 30);
 			int stopafter;
 
 			for(int t = 0; t < counter; t++){
@@ -35895,9 +36995,9 @@ for(int i = 0; i < counter; i++){
 			}
 
 
-			if((int)to_number(schd_tab[stopafter][30]) - (int)to_number(schd_tab[stopafter][25])  >= (int)to_number(schd_tab[pickupid][4]) + aLatepickup + (int)to_number(schd_tab[pickupid][25]) + (int)to_number(schd_tab[pickupid][CALCULATEDTIME])){
-				puetd1 = (int)to_number(schd_tab[pickupid][4]) + aLatepickup + (int)to_number(schd_tab[pickupid][25]);
-				if(DEBUG == 1) gse << "Changing puetd to " << puetd1 << " " << (int)to_number(schd_tab[stopafter][30]) << "  " <<  (int)to_number(schd_tab[stopafter][25]) <<  endl;
+			if((int)tripNumber(stopafter, 30) - (int)tripNumber(stopafter, 25)  >= (int)tripNumber(pickupid, 4) + aLatepickup + (int)tripNumber(pickupid, 25) + (int)tripNumber(pickupid, CALCULATEDTIME)){
+				puetd1 = (int)tripNumber(pickupid, 4) + aLatepickup + (int)tripNumber(pickupid, 25);
+				if(DEBUG == 1) gse << "Changing puetd to " << puetd1 << " " << (int)tripNumber(stopafter, 30) << "  " <<  (int)tripNumber(stopafter, 25) <<  endl;
 			}
 
 
@@ -35910,8 +37010,8 @@ for(int i = 0; i < counter; i++){
 
 
 
-		p_eta = itms_minutes_to_ampm((int)to_number(schd_tab[local_s_tab[i]][29]));
-		p_etd = itms_minutes_to_ampm((int)to_number(schd_tab[local_s_tab[i]][30]));
+		p_eta = itms_minutes_to_ampm((int)tripNumber(local_s_tab[i], 29));
+		p_etd = itms_minutes_to_ampm((int)tripNumber(local_s_tab[i], 30));
 
 
 		if(DEBUG == 1) gse << p_stop_num << " \t " << p_promised_time << " \t " << p_eta << " \t " << p_etd << " \t "  << setprecision(2) << prev_distance <<  "  \t" << p_timetonextstop << " \t " << p_stop_type << "\t wc occ" << p_wc_occ << " \t amb occ" << p_amb_occ << "\t" << p_cs_occ << "\t" << p_bs_occ << "\t" << p_esc << " " << arrivetime1 << " " << departtime1 << " " << p_trip_type << " " << schd_tab[local_s_tab[i]][20] << " " << " " <<schd_tab[local_s_tab[i]][42]<< " " << schd_tab[local_s_tab[i]][41] << " " << local_s_tab[i] <<" start time: " << starttime1<< " end time: " << endtime1 << " trip id " <<schd_tab[local_s_tab[i]][3] << " " << schd_tab[local_s_tab[i]][10] << " " << schd_tab[local_s_tab[i]][37]  <<  endl;
@@ -35928,18 +37028,18 @@ for(int i = 0; i < counter; i++){
 		}
 
 		if(p_stop_num == (int)to_number(MAXSTOPNUM[0])){
-			endtime1 = to_string((int)itms_to_minutes(ampm2fullhrs(p_promised_time))); // to make sure segments do not go beyond the end'
-			//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)itms_to_minutes(ampm2fullhrs(p_promised_time)) << endl;
+			endtime1 = to_string((int)dayMinute(p_promised_time)); // to make sure segments do not go beyond the end'
+			//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)dayMinute(p_promised_time) << endl;
 		}
 
 		bool preassigntripchange = true;
 		if(strcmp(schd_tab[local_s_tab[i]][LATEDEVIATION],"")!=0 || strcmp(schd_tab[local_s_tab[i]][TRVLTIMEDEVIATION],"")!=0){
 			preassigntripchange = false;
 			if ((p_stop_type == "P") && starttime1 != "0" && starttime1 != "" &&   starttime1 != "0000" ) {
-				if( itms_to_minutes(ampm2fullhrs(p_eta))  > (int)to_number(starttime1) + aLatepickup)//p_DIALRIDELATEPICKFACTOR )
+				if( dayMinute(p_eta)  > (int)to_number(starttime1) + aLatepickup)//p_DIALRIDELATEPICKFACTOR )
 				{
-					int dev =  itms_to_minutes(ampm2fullhrs(p_eta)) - ((int)to_number(starttime1) + aLatepickup);
-					if(dev > (int)to_number(schd_tab[local_s_tab[i]][LATEDEVIATION])){
+					int dev =  dayMinute(p_eta) - ((int)to_number(starttime1) + aLatepickup);
+					if(dev > (int)tripNumber(local_s_tab[i], LATEDEVIATION)){
 						preassigntripchange = true;
 					}
 
@@ -35949,11 +37049,11 @@ for(int i = 0; i < counter; i++){
 
 			if ((p_stop_type == "D") && (endtime1) != "0" && (endtime1) != "" && (endtime1) != "0000")
 			{
-				if((((itms_to_minutes(ampm2fullhrs(p_eta))) >  (int)to_number(endtime1)) && prom_time != 0))
+				if((((dayMinute(p_eta)) >  (int)to_number(endtime1)) && prom_time != 0))
 				{
 
-					int dev =  itms_to_minutes(ampm2fullhrs(p_eta)) - ((int)to_number(endtime1));
-					if(dev > (int)to_number(schd_tab[local_s_tab[i]][LATEDEVIATION])){
+					int dev =  dayMinute(p_eta) - ((int)to_number(endtime1));
+					if(dev > (int)tripNumber(local_s_tab[i], LATEDEVIATION)){
 						preassigntripchange = true;
 					}
 
@@ -35962,8 +37062,8 @@ for(int i = 0; i < counter; i++){
 			}
 
 			if((actualTT > aAllowedTT + floor((RELAXCONSTRAINTS[0] - 1)*50) && actualTT > 0)){
-				if((actualTT - aAllowedTT) > (int)to_number(schd_tab[local_s_tab[i]][TRVLTIMEDEVIATION])){
-					if(DEBUG == 1) gse << "The dev is " << (int)to_number(schd_tab[local_s_tab[i]][TRVLTIMEDEVIATION]) << endl;
+				if((actualTT - aAllowedTT) > (int)tripNumber(local_s_tab[i], TRVLTIMEDEVIATION)){
+					if(DEBUG == 1) gse << "The dev is " << (int)tripNumber(local_s_tab[i], TRVLTIMEDEVIATION) << endl;
 					preassigntripchange = true;
 				}
 			}
@@ -36073,7 +37173,7 @@ for(int i = 0; i < counter; i++){
 				/***3. Pickup Window violation *****/
 				if ( preassigntripchange && (p_stop_type == "P") && starttime1 != "0" && starttime1 != "" &&   starttime1 != "0000" && (p_stop_num >= aStp )) {
 
-					if( itms_to_minutes(ampm2fullhrs(p_eta))  > (int)to_number(starttime1) + aLatepickup + floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
+					if( dayMinute(p_eta)  > (int)to_number(starttime1) + aLatepickup + floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 					{
 						//   if(DEBUG == 1) gse << "Starttime " << itms_minutes_to_ampm(to_number(starttime1)) << endl;
 						// oDropETA = " Dropoff ETA:  ;" ;
@@ -36120,8 +37220,8 @@ for(int i = 0; i < counter; i++){
 
 
 				if(p_stop_num == (int)to_number(MAXSTOPNUM[0])){
-					endtime1 = to_string((int)itms_to_minutes(ampm2fullhrs(p_promised_time))); // to make sure segments do not go beyond the end'
-					//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)itms_to_minutes(ampm2fullhrs(p_promised_time)) << endl;
+					endtime1 = to_string((int)dayMinute(p_promised_time)); // to make sure segments do not go beyond the end'
+					//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)dayMinute(p_promised_time) << endl;
 				}
 				/*** 4. Check if someone is late for Appointment ***/
 				/** Added condition if the appt. time is not null and return_trip = Y **/
@@ -36130,12 +37230,12 @@ for(int i = 0; i < counter; i++){
 
 
 
-					if((((itms_to_minutes(ampm2fullhrs(p_eta))) > /*12 +*/ (int)to_number(endtime1)+ floor((RELAXCONSTRAINTS[0] - 1)*50)) && prom_time != 0))
+					if((((dayMinute(p_eta)) > /*12 +*/ (int)to_number(endtime1)+ floor((RELAXCONSTRAINTS[0] - 1)*50)) && prom_time != 0))
 					{
 						if(DEBUG == 1) gse << "Endtime " << endtime1 << endl;
 						if(!finished){
 							string tripid = schd_tab[local_s_tab[i]][3];
-							oResult = "Impact: " +  tripid + " will be late: " + to_string((int)itms_to_minutes(ampm2fullhrs(p_eta)) - (int)to_number(endtime1) ) +
+							oResult = "Impact: " +  tripid + " will be late: " + to_string((int)dayMinute(p_eta) - (int)to_number(endtime1) ) +
 									" minutes for the " + itms_minutes_to_ampm((int)to_number(endtime1)) + " Appointment";
 							// strcpy( schd_tab[local_s_tab[i]][0] ,"");
 							if(DEBUG == 1) gse <<   oResult <<"\n\n";
@@ -36542,8 +37642,8 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 		// temp = schd_tab[local_s_tab[i]][12];
 		amb_occ1 =  schd_tab[local_s_tab[i]][31];
 		wc_occ1 =  schd_tab[local_s_tab[i]][32];
-		p_cs_occ = to_number(schd_tab[local_s_tab[i]][CS_OCC]);
-		p_bs_occ =to_number(schd_tab[local_s_tab[i]][BS_OCC]);
+		p_cs_occ = tripNumber(local_s_tab[i], CS_OCC);
+		p_bs_occ =tripNumber(local_s_tab[i], BS_OCC);
 		amb_cap1 =  schd_tab[local_s_tab[SEGSTART]][33];
 		//temp = temp+",";
 		wc_cap1 =  schd_tab[local_s_tab[SEGSTART]][34]; /// fix this hack in get next token
@@ -36562,8 +37662,8 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 		p_name = schd_tab[local_s_tab[i]][14];
 		p_return_trip = schd_tab[local_s_tab[i]][18];
 		p_stop_type = schd_tab[local_s_tab[i]][7];
-		p_esc = (int)to_number(schd_tab[local_s_tab[i]][13]);
-		p_stop_num = (int)to_number(schd_tab[local_s_tab[i]][2]);
+		p_esc = (int)tripNumber(local_s_tab[i], 13);
+		p_stop_num = (int)tripNumber(local_s_tab[i], 2);
 		p_td_segmentid = "STEST";
 		//    if(DEBUG == 1) gse << "The segment is  " << p_td_segmentid << " " <<  schd_tab[local_s_tab[SEGSTART]][0] << endl;
 		//  if(DEBUG == 1) gse << "STop num " << p_stop_num<< endl;
@@ -36647,14 +37747,14 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 				a_longtriptime1, a_mediumtriptime1, a_extra_loadtime1, ZONE_DESCR1,IGNORE_DEPOTS_CUTOFF1, pReturn_trip,  pDisability,p_trip_type1);
 
 
-		double estdisttrip = to_number(schd_tab[local_s_tab[i]][21]);
+		double estdisttrip = tripNumber(local_s_tab[i], 21);
 
 		int aAllowedTT;
 
 
 
 		int allowedDW;
-		double esttime = to_number(schd_tab[local_s_tab[i]][22]);
+		double esttime = tripNumber(local_s_tab[i], 22);
 
 		if(estdisttrip < a_mediumshortdistance1){
 			aAllowedTT = a_shorttriptime1 + extratraveltime;
@@ -36684,7 +37784,7 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 		tripid = tripid.substr(0,1);
 		string endtime2;
 		if(tripid == "S"){
-			endtime2 =to_string( (int)itms_to_minutes(ampm2fullhrs(p_promised_time)));
+			endtime2 =to_string( (int)dayMinute(p_promised_time));
 		}
 
 		if(p_stop_type == "P"){
@@ -36769,7 +37869,7 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 
 
 		if(!secondpassinsertedtrip){
-			p_etd =  itms_minutes_to_ampm(itms_to_minutes (ampm2fullhrs (p_etd)) - p_perf_time);
+			p_etd =  itms_minutes_to_ampm(dayMinute(p_etd) - p_perf_time);
 
 			if (p_stop_num != 1 && p_stop_num != (int)to_number(MAXSTOPNUM[0])) {
 				if (timetonextstop2 == 0 && strcmp(schd_tab[local_s_tab[i]][7],schd_tab[local_s_tab[i-1]][7])==0)
@@ -36818,7 +37918,7 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 				}
 
 			}
-			p_etd =  itms_minutes_to_ampm(itms_to_minutes (ampm2fullhrs (p_etd)) + p_perf_time);
+			p_etd =  itms_minutes_to_ampm(dayMinute(p_etd) + p_perf_time);
 		}
 
 		//   if(DEBUG == 1) gse << "ETa 2" << p_eta << " " << p_etd << endl;
@@ -36836,7 +37936,7 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 
 		// temp = temproute[i][4];
 
-		prev_eta1 = to_string(itms_to_minutes (ampm2fullhrs (p_eta)));
+		prev_eta1 = to_string(dayMinute(p_eta));
 		prev_eta = (int)to_number(prev_eta1);
 		prev_eta1 = itms_minutes_to_ampm(prev_eta);
 
@@ -36846,7 +37946,7 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 		prev_p_perf_time = (int)to_number(prev_perftime1);
 
 
-		prev_etd1 = to_string(itms_to_minutes (ampm2fullhrs (p_etd)));
+		prev_etd1 = to_string(dayMinute(p_etd));
 		prev_etd = (int)to_number(prev_etd1);
 		prev_etd1 = itms_minutes_to_ampm(prev_etd);
 		//temp = temproute[i][12];
@@ -36864,7 +37964,7 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 		last_amb_occ=(int)to_number(prev_amb_occ1);
 		last_wc_occ=(int)to_number(prev_wc_occ1);
 		p_prev_perf_time = prev_p_perf_time;
-		p_prev_stop_num = (int)to_number(schd_tab[local_s_tab[i]][2]);
+		p_prev_stop_num = (int)tripNumber(local_s_tab[i], 2);
 		p_prev_promised_time = p_promised_time;
 		/*if(temproute[i][20] == "0" && temproute[i-1][20] != "0"){
                                if(DEBUG == 1) gse << "Stop Num " << temproute[i-1][2] << endl;
@@ -36913,7 +38013,7 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
          latlon4= latlon4+ ","+ schd_tab[local_s_tab[i+1]][37];
 
 
-         actualTT = (itms_to_minutes (ampm2fullhrs (doeta)) - itms_to_minutes (ampm2fullhrs (puetd))); //flipped eta/etd
+         actualTT = (dayMinute(doeta) - dayMinute(puetd)); //flipped eta/etd
             if(DEBUG == 1) gse << "Actual travel time " << actualTT << endl;
     }
 		 */
@@ -36923,7 +38023,7 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 
 		bool changedeta = true;
 
-		if(itms_to_minutes (ampm2fullhrs (p_eta)) != eta)
+		if(dayMinute(p_eta) != eta)
 			changedeta = true;
 
 
@@ -36935,9 +38035,9 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 
 		if(strcmp(schd_tab[local_s_tab[i]][7],"D")==0 && (tripid2.substr(0,1) == "T" || tripid2.substr(0,1) == "R") && p_trip_type2 != "BRK" && p_trip_type2 != "LUNCH" && p_trip_type2 != "ADMIN"){
 
-			int pickupid = (int)to_number(schd_tab[local_s_tab[i]][PICKUPIDX]);
-			int doeta1 = (int)to_number(schd_tab[local_s_tab[i]][30])-(int)to_number(schd_tab[local_s_tab[i]][25]);
-			int puetd1 = (int)to_number(schd_tab[pickupid][30]);
+			int pickupid = (int)tripNumber(local_s_tab[i], PICKUPIDX);
+			int doeta1 = (int)tripNumber(local_s_tab[i], 30)-(int)tripNumber(local_s_tab[i], 25);
+			int puetd1 = (int)tripNumber(pickupid, 30);
 			int stopafter;
 
 			for(int t = 0; t < counter; t++){
@@ -36963,11 +38063,11 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 				aLatepickup = p_DIALRIDELATEPICKFACTOR1;
 			}
 
-			if((int)to_number(schd_tab[stopafter][30]) - (int)to_number(schd_tab[stopafter][25])  >= (int)to_number(schd_tab[pickupid][4]) + aLatepickup+ (int)to_number(schd_tab[pickupid][25]) + (int)to_number(schd_tab[pickupid][CALCULATEDTIME])){
+			if((int)tripNumber(stopafter, 30) - (int)tripNumber(stopafter, 25)  >= (int)tripNumber(pickupid, 4) + aLatepickup+ (int)tripNumber(pickupid, 25) + (int)tripNumber(pickupid, CALCULATEDTIME)){
 
-				puetd1 = (int)to_number(schd_tab[pickupid][4]) + aLatepickup+ (int)to_number(schd_tab[pickupid][25]);
+				puetd1 = (int)tripNumber(pickupid, 4) + aLatepickup+ (int)tripNumber(pickupid, 25);
 
-				if(DEBUG == 1) gse << "Changing puetd to " << puetd1 << " " << (int)to_number(schd_tab[stopafter][30]) << "  " <<  (int)to_number(schd_tab[stopafter][25]) <<  endl;
+				if(DEBUG == 1) gse << "Changing puetd to " << puetd1 << " " << (int)tripNumber(stopafter, 30) << "  " <<  (int)tripNumber(stopafter, 25) <<  endl;
 			}
 
 
@@ -37054,7 +38154,7 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 				/***3. Pickup Window violation *****/
 				if (true && (p_stop_type == "P") && starttime1 != "0" && starttime1 != "" &&   starttime1 != "0000" && (i >= insertionstart )) {
 
-					if( itms_to_minutes(ampm2fullhrs(p_eta))  > (int)to_number(starttime1) + aLatepickup+ floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
+					if( dayMinute(p_eta)  > (int)to_number(starttime1) + aLatepickup+ floor((RELAXCONSTRAINTS[0] - 1)*50))//p_DIALRIDELATEPICKFACTOR )
 					{
 						//   if(DEBUG == 1) gse << "Starttime " << itms_minutes_to_ampm(to_number(starttime1)) << endl;
 						// oDropETA = " Dropoff ETA:  ;" ;
@@ -37090,8 +38190,8 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 
 
 				if(p_stop_num == (int)to_number(MAXSTOPNUM[0])){
-					endtime1 = to_string((int)itms_to_minutes(ampm2fullhrs(p_promised_time))); // to make sure segments do not go beyond the end'
-					//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)itms_to_minutes(ampm2fullhrs(p_promised_time)) << endl;
+					endtime1 = to_string((int)dayMinute(p_promised_time)); // to make sure segments do not go beyond the end'
+					//  if(DEBUG == 1) gse << "promtime " << endtime1 << " " << p_promised_time << " " << (int)dayMinute(p_promised_time) << endl;
 				}
 				/*** 4. Check if someone is late for Appointment ***/
 				/** Added condition if the appt. time is not null and return_trip = Y **/
@@ -37100,12 +38200,12 @@ int checkforlatetripsrecalc(int counter, int * local_s_tab, int insertionstart){
 
 
 
-					if((((itms_to_minutes(ampm2fullhrs(p_eta))) > /*12 +*/ (int)to_number(endtime1)+ floor((RELAXCONSTRAINTS[0] - 1)*50)) && prom_time != 0))
+					if((((dayMinute(p_eta)) > /*12 +*/ (int)to_number(endtime1)+ floor((RELAXCONSTRAINTS[0] - 1)*50)) && prom_time != 0))
 					{
 						if(DEBUG == 1) gse << "Endtime " << endtime1 << endl;
 						if(!finished){
 							string tripid = schd_tab[local_s_tab[i]][3];
-							oResult = "Impact: " +  tripid + " will be late: " + to_string((int)itms_to_minutes(ampm2fullhrs(p_eta)) - (int)to_number(endtime1) ) +
+							oResult = "Impact: " +  tripid + " will be late: " + to_string((int)dayMinute(p_eta) - (int)to_number(endtime1) ) +
 									" minutes for the " + itms_minutes_to_ampm((int)to_number(endtime1)) + " Appointment";
 							// strcpy( schd_tab[local_s_tab[i]][0] ,"");
 							if(DEBUG == 1) gse <<   oResult <<"\n\n";
@@ -37212,21 +38312,24 @@ int getTravTime(int tripidx, int do_aftershmid){
 
 
 
-	double blat = to_number(schd_tab[tripidx][10]);
-	double gridlat = to_number(schd_tab[do_aftershmid][10]);
-	double blon = to_number(schd_tab[tripidx][37]);
-	double gridlon = to_number(schd_tab[do_aftershmid][37]);
+	double blat = tripNumber(tripidx, 10);
+	double gridlat = tripNumber(do_aftershmid, 10);
+	double blon = tripNumber(tripidx, 37);
+	double gridlon = tripNumber(do_aftershmid, 37);
 	double dist = ((blat - gridlat)*(blat - gridlat) + (blon - gridlon)*(blon - gridlon)) ;
 	dist = sqrt(dist)*3959.0 * 3.1415/180;
 	//double dist = (acos(1.0*sin(blat)*sin(gridlat)+cos(blat)*cos(gridlat)*cos(blon-gridlon)))*3959.87;
 	//getTimeZone(env ,conn);
-	string time_zone = timeZones(schd_tab[tripidx][29],itms_minutes_to_ampm((int)to_number(schd_tab[tripidx][4])));
+	DayMinute zoneminute = dayMinuteOf((int)tripNumber(tripidx, 4));
+
+	//the stop matrix is routed without a departure minute, so its times always take the factor
+	float matrixdistance, matrixtime;
+	if(lookupStopMatrix(tripidx, do_aftershmid, matrixdistance, matrixtime))
+		return travelTimeAt((int)matrixtime, zoneminute);
 
 
 
 
-	string running = "RUNNINGCALC";
-	strcpy(shared_process_tab[WRITINGFB][0], running.c_str());
 
 	int waitingforosrm = 0;
 	int q;
@@ -37240,29 +38343,16 @@ int getTravTime(int tripidx, int do_aftershmid){
 
 	string osrm = lat1 + "," + lon1 + "," + lat2 + "," + lon2;
 
-	for (int d = 0; d < MAXREQUESTS; d++)
-	{
-
-		if (requestIsEmpty(d))
-		{
-			//usleep(10);
-			if (requestIsEmpty(d))
-			{
-				q = d;
-				break;
-			}
-		}
-		if (d + 1 == MAXREQUESTS)
-			d = -1;
-	}
+	q = acquireRequest();
 	//  if(DEBUG == 1) gse << "q is " << q << endl;
 
 	string function = "CalcDist";
 
 	time_t t = time(NULL);
-	struct tm tm = *localtime(&t);
+	struct tm tm;
+	localtime_r(&t, &tm);
 	char timebuffer[100];
-	sprintf(timebuffer, "%s", asctime(&tm));
+	asctime_r(&tm, timebuffer);
 	string localtimestr = timebuffer;
 	localtimestr.erase(std::remove(localtimestr.begin(), localtimestr.end(), '\n'), localtimestr.end());
 
@@ -37272,6 +38362,7 @@ int getTravTime(int tripidx, int do_aftershmid){
 	updateRequest(q, to_string(0), "ID");
 	updateRequest(q, osrm, "LATLONG");
 	updateRequest(q, to_string(tripidx), "TRIPIDX");
+	requestDepartureAt(q, zoneminute);
 
 	waitingforosrm++;
 
@@ -37280,18 +38371,19 @@ int getTravTime(int tripidx, int do_aftershmid){
 
 
 
-	strcpy(shared_process_tab[WRITINGFB][0], "READY");
+	submitRequest(q);
 	int datafromosrm = 0;
 	int timebetween = 0;
+	bool departuremetric = false;
+	waitForRequest(q);
 	while (true)
 	{
 
 		if (fetchRequest(q, "DISTANCE") != "" &&  fetchRequest(q, "TIME") != "" &&/*fetchRequest(q, "ID") == to_string(g) &&*/ fetchRequest(q, "NUM") == "getTravTime"&& fetchRequest(q, "FUNC") == "CalcDist")
 		{
 			timebetween = (int)to_number(fetchRequest(q, "TIME"));
+			departuremetric = requestHas(q, REQUESTFIELD_DEPARTUREMETRIC);
 			clearRequest(q);
-			while(!requestIsEmpty(q)){
-			}
 			//f++;
 			//g++;
 			datafromosrm++;
@@ -37302,7 +38394,7 @@ int getTravTime(int tripidx, int do_aftershmid){
 	}
 
 
-	int trav_time = F_GET_TRAVEL_TIME (timebetween , time_zone, "*");
+	int trav_time = departuremetric ? timebetween : travelTimeAt(timebetween, zoneminute);
 
 	//  if(DEBUG == 1) gse << "The time zone is : " << time_zone << " " << trav_time << " " << dist  << endl;
 
@@ -5,7 +5,9 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
+#include "customizer/departure_range.hpp"
 #include "storage/io_config.hpp"
 #include "updater/updater_config.hpp"
 
@@ -38,6 +40,15 @@ struct CustomizationConfig final : storage::IOConfig
     unsigned requested_num_threads;
 
     updater::UpdaterConfig updater_config;
+
+    // Metrics customized in addition to the base one, each from the base speeds with the
+    // segment speed files of its departure range applied on top
+    struct DepartureBucket
+    {
+        DepartureRange range;
+        std::vector<std::string> segment_speed_lookup_paths;
+    };
+    std::vector<DepartureBucket> departure_buckets;
 };
 } // namespace customizer
 } // namespace osrm
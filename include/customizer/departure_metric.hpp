@@ -0,0 +1,41 @@
+#ifndef OSRM_CUSTOMIZER_DEPARTURE_METRIC_HPP
+#define OSRM_CUSTOMIZER_DEPARTURE_METRIC_HPP
+
+#include "customizer/departure_range.hpp"
+
+#include "extractor/segment_data_container.hpp"
+
+#include "storage/shared_memory_ownership.hpp"
+
+#include "util/typedefs.hpp"
+#include "util/vector_view.hpp"
+
+namespace osrm
+{
+namespace customizer
+{
+namespace detail
+{
+// Everything a departure metric replaces besides the cell metrics: the weights of the
+// edge-based nodes and of the segments in the shared geometry. Distances, turn penalties and
+// data sources stay those of the base metric.
+template <storage::Ownership Ownership> struct DepartureMetricImpl
+{
+    template <typename T> using Vector = util::ViewOrVector<T, Ownership>;
+    using SegmentData = extractor::detail::SegmentDataContainerImpl<Ownership>;
+
+    Vector<EdgeWeight> node_weights;
+    Vector<EdgeDuration> node_durations;
+    typename SegmentData::SegmentWeightVector forward_weights;
+    typename SegmentData::SegmentWeightVector reverse_weights;
+    typename SegmentData::SegmentDurationVector forward_durations;
+    typename SegmentData::SegmentDurationVector reverse_durations;
+};
+} // namespace detail
+
+using DepartureMetric = detail::DepartureMetricImpl<storage::Ownership::Container>;
+using DepartureMetricView = detail::DepartureMetricImpl<storage::Ownership::View>;
+} // namespace customizer
+} // namespace osrm
+
+#endif
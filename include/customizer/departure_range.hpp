@@ -0,0 +1,61 @@
+#ifndef OSRM_CUSTOMIZER_DEPARTURE_RANGE_HPP
+#define OSRM_CUSTOMIZER_DEPARTURE_RANGE_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace osrm
+{
+namespace customizer
+{
+
+// Minutes of the day [begin, end) for which a metric was customized
+struct DepartureRange
+{
+    static constexpr std::uint32_t MINUTES_PER_DAY = 24 * 60;
+
+    std::uint32_t begin;
+    std::uint32_t end;
+
+    bool IsValid() const { return begin < end && end <= MINUTES_PER_DAY; }
+
+    bool Contains(const std::uint32_t minute) const { return begin <= minute && minute < end; }
+
+    bool Overlaps(const DepartureRange &other) const
+    {
+        return begin < other.end && other.begin < end;
+    }
+};
+
+// Departure metrics are stored next to the metric of the profile's weight as
+// "<weight name>/departure/<begin>-<end>", so every consumer of "/mld/metrics/<name>" can use
+// them like any other metric.
+inline std::string departureMetricName(const std::string &weight_name,
+                                       const DepartureRange &range)
+{
+    return weight_name + "/departure/" + std::to_string(range.begin) + "-" +
+           std::to_string(range.end);
+}
+
+inline bool isDepartureMetric(const std::string &metric_name)
+{
+    return metric_name.find("/departure/") != std::string::npos;
+}
+
+// Parses the range from the last component of a departure metric name or data path
+inline bool parseDepartureRange(const std::string &name, DepartureRange &range)
+{
+    const auto component = name.substr(name.find_last_of('/') + 1);
+    const auto dash = component.find('-');
+    if (dash == std::string::npos || dash == 0 || dash + 1 == component.size() ||
+        component.find_first_not_of("0123456789-") != std::string::npos)
+        return false;
+
+    range.begin = std::stoul(component.substr(0, dash));
+    range.end = std::stoul(component.substr(dash + 1));
+    return range.IsValid();
+}
+} // namespace customizer
+} // namespace osrm
+
+#endif
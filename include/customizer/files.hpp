@@ -7,6 +7,8 @@
 
 #include "util/integer_range.hpp"
 
+#include <boost/assert.hpp>
+
 #include <unordered_map>
 
 namespace osrm
@@ -45,15 +47,38 @@ inline void readCellMetrics(const boost::filesystem::path &path,
     }
 }
 
-// writes .osrm.cell_metrics file
-template <typename CellMetricT>
+// reads the departure metrics from the .osrm.cell_metrics file
+template <typename DepartureMetricT>
+inline void
+readDepartureMetrics(const boost::filesystem::path &path,
+                     std::unordered_map<std::string, DepartureMetricT> &departure_metrics)
+{
+    static_assert(std::is_same<DepartureMetricView, DepartureMetricT>::value ||
+                      std::is_same<DepartureMetric, DepartureMetricT>::value,
+                  "");
+
+    const auto fingerprint = storage::tar::FileReader::VerifyFingerprint;
+    storage::tar::FileReader reader{path, fingerprint};
+
+    for (auto &pair : departure_metrics)
+    {
+        serialization::read(reader, "/mld/metrics/" + pair.first, pair.second);
+    }
+}
+
+// writes .osrm.cell_metrics file, departure metrics are keyed by the name of their cell metrics
+template <typename CellMetricT, typename DepartureMetricT>
 inline void
 writeCellMetrics(const boost::filesystem::path &path,
-                 const std::unordered_map<std::string, std::vector<CellMetricT>> &metrics)
+                 const std::unordered_map<std::string, std::vector<CellMetricT>> &metrics,
+                 const std::unordered_map<std::string, DepartureMetricT> &departure_metrics)
 {
     static_assert(std::is_same<CellMetricView, CellMetricT>::value ||
                       std::is_same<CellMetric, CellMetricT>::value,
                   "");
+    static_assert(std::is_same<DepartureMetricView, DepartureMetricT>::value ||
+                      std::is_same<DepartureMetric, DepartureMetricT>::value,
+                  "");
 
     const auto fingerprint = storage::tar::FileWriter::GenerateFingerprint;
     storage::tar::FileWriter writer{path, fingerprint};
@@ -72,6 +97,21 @@ writeCellMetrics(const boost::filesystem::path &path,
             serialization::write(writer, prefix + "/" + std::to_string(id++), exclude_metric);
         }
     }
+
+    for (const auto &pair : departure_metrics)
+    {
+        BOOST_ASSERT(metrics.count(pair.first) == 1);
+        serialization::write(writer, "/mld/metrics/" + pair.first, pair.second);
+    }
+}
+
+// writes .osrm.cell_metrics file
+template <typename CellMetricT>
+inline void
+writeCellMetrics(const boost::filesystem::path &path,
+                 const std::unordered_map<std::string, std::vector<CellMetricT>> &metrics)
+{
+    writeCellMetrics(path, metrics, std::unordered_map<std::string, DepartureMetric>{});
 }
 
 // reads .osrm.mldgr file
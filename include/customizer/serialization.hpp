@@ -1,6 +1,7 @@
 #ifndef OSRM_CUSTOMIZER_SERIALIZATION_HPP
 #define OSRM_CUSTOMIZER_SERIALIZATION_HPP
 
+#include "customizer/departure_metric.hpp"
 #include "customizer/edge_based_graph.hpp"
 
 #include "partitioner/cell_storage.hpp"
@@ -9,6 +10,8 @@
 #include "storage/shared_memory_ownership.hpp"
 #include "storage/tar.hpp"
 
+#include "util/serialization.hpp"
+
 namespace osrm
 {
 namespace customizer
@@ -36,6 +39,40 @@ inline void write(storage::tar::FileWriter &writer,
     storage::serialization::write(writer, name + "/distances", metric.distances);
 }
 
+template <storage::Ownership Ownership>
+inline void read(storage::tar::FileReader &reader,
+                 const std::string &name,
+                 detail::DepartureMetricImpl<Ownership> &metric)
+{
+    storage::serialization::read(reader, name + "/node_weights", metric.node_weights);
+    storage::serialization::read(reader, name + "/node_durations", metric.node_durations);
+    util::serialization::read(
+        reader, name + "/segment_data/forward_weights", metric.forward_weights);
+    util::serialization::read(
+        reader, name + "/segment_data/reverse_weights", metric.reverse_weights);
+    util::serialization::read(
+        reader, name + "/segment_data/forward_durations", metric.forward_durations);
+    util::serialization::read(
+        reader, name + "/segment_data/reverse_durations", metric.reverse_durations);
+}
+
+template <storage::Ownership Ownership>
+inline void write(storage::tar::FileWriter &writer,
+                  const std::string &name,
+                  const detail::DepartureMetricImpl<Ownership> &metric)
+{
+    storage::serialization::write(writer, name + "/node_weights", metric.node_weights);
+    storage::serialization::write(writer, name + "/node_durations", metric.node_durations);
+    util::serialization::write(
+        writer, name + "/segment_data/forward_weights", metric.forward_weights);
+    util::serialization::write(
+        writer, name + "/segment_data/reverse_weights", metric.reverse_weights);
+    util::serialization::write(
+        writer, name + "/segment_data/forward_durations", metric.forward_durations);
+    util::serialization::write(
+        writer, name + "/segment_data/reverse_durations", metric.reverse_durations);
+}
+
 template <typename EdgeDataT, storage::Ownership Ownership>
 inline void read(storage::tar::FileReader &reader,
                  const std::string &name,
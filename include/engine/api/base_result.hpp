@@ -6,6 +6,7 @@
 
 #include <string>
 
+#include "engine/api/typed_result.hpp"
 #include "util/json_container.hpp"
 
 namespace osrm
@@ -14,8 +15,12 @@ namespace engine
 {
 namespace api
 {
-using ResultT =
-    mapbox::util::variant<util::json::Object, std::string, flatbuffers::FlatBufferBuilder>;
+using ResultT = mapbox::util::variant<util::json::Object,
+                                      std::string,
+                                      flatbuffers::FlatBufferBuilder,
+                                      RouteResult,
+                                      TableResult,
+                                      NearestResult>;
 } // namespace api
 } // namespace engine
 } // namespace osrm
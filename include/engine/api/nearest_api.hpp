@@ -38,6 +38,11 @@ class NearestAPI final : public BaseAPI
             auto &fb_result = response.get<flatbuffers::FlatBufferBuilder>();
             MakeResponse(phantom_nodes, fb_result);
         }
+        else if (response.is<NearestResult>())
+        {
+            auto &typed_result = response.get<NearestResult>();
+            MakeResponse(phantom_nodes, typed_result);
+        }
         else
         {
             auto &json_result = response.get<util::json::Object>();
@@ -118,6 +123,56 @@ class NearestAPI final : public BaseAPI
         response.values["code"] = "Ok";
     }
 
+    // Snapped locations and segment nodes only, no names or hints
+    void MakeResponse(const std::vector<std::vector<PhantomNodeWithDistance>> &phantom_nodes,
+                      NearestResult &response) const
+    {
+        response.edges.clear();
+        response.waypoints.clear();
+        response.waypoints.reserve(phantom_nodes.front().size());
+        for (const auto &phantom_with_distance : phantom_nodes.front())
+        {
+            const auto &phantom_node = phantom_with_distance.phantom_node;
+            const auto node_values = MakeNodes(phantom_node);
+            response.waypoints.push_back(
+                {phantom_node.location,
+                 util::coordinate_calculation::fccApproximateDistance(phantom_node.location,
+                                                                      phantom_node.input_location),
+                 node_values.first,
+                 node_values.second});
+        }
+
+        response.code = "Ok";
+    }
+
+    // Segments as OSM node pairs for NearestParameters::edges_in_radius, JSON or typed only
+    void MakeResponse(const std::vector<std::pair<std::uint64_t, std::uint64_t>> &edges,
+                      osrm::engine::api::ResultT &response) const
+    {
+        if (response.is<NearestResult>())
+        {
+            auto &typed_result = response.get<NearestResult>();
+            typed_result.waypoints.clear();
+            typed_result.edges = edges;
+            typed_result.code = "Ok";
+        }
+        else
+        {
+            auto &json_result = response.get<util::json::Object>();
+            util::json::Array json_edges;
+            json_edges.values.reserve(edges.size());
+            for (const auto &edge : edges)
+            {
+                util::json::Array nodes;
+                nodes.values.push_back(edge.first);
+                nodes.values.push_back(edge.second);
+                json_edges.values.push_back(std::move(nodes));
+            }
+            json_result.values["edges"] = std::move(json_edges);
+            json_result.values["code"] = "Ok";
+        }
+    }
+
     const NearestParameters &parameters;
 
   protected:
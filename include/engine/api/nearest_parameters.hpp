@@ -42,6 +42,8 @@ namespace api
  *
  * Holds member attributes:
  *  - number of results: number of nearest segments that should be returned
+ *  - edges in radius: return the OSM node pairs of every segment within radiuses[0] instead
+ *  - spacing: with edges in radius, keep at most one segment per spacing x spacing meters
  *
  * \see OSRM, Coordinate, Hint, Bearing, RouteParame, RouteParameters, TableParameters,
  *      NearestParameters, TripParameters, MatchParameters and TileParameters
@@ -49,8 +51,13 @@ namespace api
 struct NearestParameters : public BaseParameters
 {
     unsigned number_of_results = 1;
+    bool edges_in_radius = false;
+    double spacing = 0;
 
-    bool IsValid() const { return BaseParameters::IsValid() && number_of_results >= 1; }
+    bool IsValid() const
+    {
+        return BaseParameters::IsValid() && number_of_results >= 1 && spacing >= 0;
+    }
 };
 } // namespace api
 } // namespace engine
@@ -58,6 +58,11 @@ class RouteAPI : public BaseAPI
             auto &fb_result = response.get<flatbuffers::FlatBufferBuilder>();
             MakeResponse(raw_routes, all_start_end_points, fb_result);
         }
+        else if (response.is<RouteResult>())
+        {
+            auto &typed_result = response.get<RouteResult>();
+            MakeResponse(raw_routes, typed_result);
+        }
         else
         {
             auto &json_result = response.get<util::json::Object>();
@@ -123,6 +128,81 @@ class RouteAPI : public BaseAPI
         }
     }
 
+    // Fills plain structs without building geometries, steps or waypoints
+    void MakeResponse(const InternalManyRoutesResult &raw_routes, RouteResult &response) const
+    {
+        // To maintain support for uses of the old default constructors, we check
+        // if annotations property was set manually after default construction
+        auto requested_annotations = parameters.annotations_type;
+        if ((parameters.annotations == true) &&
+            (parameters.annotations_type == RouteParameters::AnnotationsType::None))
+        {
+            requested_annotations = RouteParameters::AnnotationsType::All;
+        }
+
+        response.routes.clear();
+        for (const auto &raw_route : raw_routes.routes)
+        {
+            if (!raw_route.is_valid())
+                continue;
+
+            auto legs_info = MakeLegs(raw_route.segment_end_coordinates,
+                                      raw_route.unpacked_path_segments,
+                                      raw_route.source_traversed_in_reverse,
+                                      raw_route.target_traversed_in_reverse);
+            const auto &legs = legs_info.first;
+            const auto &leg_geometries = legs_info.second;
+            const auto route = guidance::assembleRoute(legs);
+
+            RouteResult::Route typed_route;
+            typed_route.distance = route.distance;
+            typed_route.duration = route.duration;
+            typed_route.weight = route.weight;
+            typed_route.legs.reserve(legs.size());
+
+            for (const auto idx : util::irange<std::size_t>(0UL, legs.size()))
+            {
+                const auto &leg_geometry = leg_geometries[idx];
+                RouteResult::Leg typed_leg;
+                typed_leg.distance = legs[idx].distance;
+                typed_leg.duration = legs[idx].duration;
+                typed_leg.weight = legs[idx].weight;
+
+                // AnnotationsType uses bit flags, & operator checks if a property is set
+                if (requested_annotations & RouteParameters::AnnotationsType::Nodes)
+                {
+                    typed_leg.nodes.reserve(leg_geometry.osm_node_ids.size());
+                    for (const auto node_id : leg_geometry.osm_node_ids)
+                        typed_leg.nodes.push_back(static_cast<std::uint64_t>(node_id));
+                }
+                if (requested_annotations & RouteParameters::AnnotationsType::Distance)
+                {
+                    typed_leg.distances.reserve(leg_geometry.annotations.size());
+                    for (const auto &anno : leg_geometry.annotations)
+                        typed_leg.distances.push_back(anno.distance);
+                }
+                if (requested_annotations & RouteParameters::AnnotationsType::Duration)
+                {
+                    typed_leg.durations.reserve(leg_geometry.annotations.size());
+                    for (const auto &anno : leg_geometry.annotations)
+                        typed_leg.durations.push_back(anno.duration);
+                }
+                if (requested_annotations & RouteParameters::AnnotationsType::Weight)
+                {
+                    typed_leg.weights.reserve(leg_geometry.annotations.size());
+                    for (const auto &anno : leg_geometry.annotations)
+                        typed_leg.weights.push_back(anno.weight);
+                }
+
+                typed_route.legs.push_back(std::move(typed_leg));
+            }
+
+            response.routes.push_back(std::move(typed_route));
+        }
+        response.departure_metric = facade.IsDepartureMetric();
+        response.code = "Ok";
+    }
+
   protected:
     template <typename GetWptsFn>
     std::unique_ptr<fbresult::FBResultBuilder>
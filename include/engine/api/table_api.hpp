@@ -20,7 +20,9 @@
 
 #include <boost/range/algorithm/transform.hpp>
 
+#include <cmath>
 #include <iterator>
+#include <limits>
 
 namespace osrm
 {
@@ -57,6 +59,11 @@ class TableAPI final : public BaseAPI
             auto &fb_result = response.get<flatbuffers::FlatBufferBuilder>();
             MakeResponse(tables, phantoms, fallback_speed_cells, fb_result);
         }
+        else if (response.is<TableResult>())
+        {
+            auto &typed_result = response.get<TableResult>();
+            MakeResponse(tables, phantoms, fallback_speed_cells, typed_result);
+        }
         else
         {
             auto &json_result = response.get<util::json::Object>();
@@ -228,6 +235,55 @@ class TableAPI final : public BaseAPI
         response.values["code"] = "Ok";
     }
 
+    // Copies the matrices into contiguous row-major arrays without any waypoints
+    virtual void
+    MakeResponse(const std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>> &tables,
+                 const std::vector<PhantomNode> &phantoms,
+                 const std::vector<TableCellRef> &fallback_speed_cells,
+                 TableResult &response) const
+    {
+        response.rows =
+            parameters.sources.empty() ? phantoms.size() : parameters.sources.size();
+        response.columns =
+            parameters.destinations.empty() ? phantoms.size() : parameters.destinations.size();
+
+        response.durations.clear();
+        if (parameters.annotations & TableParameters::AnnotationsType::Duration)
+        {
+            response.durations.reserve(tables.first.size());
+            for (const auto duration : tables.first)
+            {
+                // division by 10 because the duration is in deciseconds (10s)
+                response.durations.push_back(duration == MAXIMAL_EDGE_DURATION
+                                                 ? std::numeric_limits<double>::quiet_NaN()
+                                                 : duration / 10.);
+            }
+        }
+
+        response.distances.clear();
+        if (parameters.annotations & TableParameters::AnnotationsType::Distance)
+        {
+            response.distances.reserve(tables.second.size());
+            for (const auto distance : tables.second)
+            {
+                response.distances.push_back(distance == INVALID_EDGE_DISTANCE
+                                                 ? std::numeric_limits<double>::quiet_NaN()
+                                                 : std::round(distance * 10) / 10.);
+            }
+        }
+
+        response.fallback_speed_cells.clear();
+        if (parameters.fallback_speed != INVALID_FALLBACK_SPEED && parameters.fallback_speed > 0)
+        {
+            response.fallback_speed_cells.reserve(fallback_speed_cells.size());
+            for (const auto &cell : fallback_speed_cells)
+                response.fallback_speed_cells.emplace_back(cell.row, cell.column);
+        }
+
+        response.departure_metric = facade.IsDepartureMetric();
+        response.code = "Ok";
+    }
+
   protected:
     virtual flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<fbresult::Waypoint>>>
     MakeWaypoints(flatbuffers::FlatBufferBuilder &builder,
@@ -0,0 +1,101 @@
+#ifndef ENGINE_API_TYPED_RESULT_HPP
+#define ENGINE_API_TYPED_RESULT_HPP
+
+#include "util/coordinate.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+
+/**
+ * Plain C++ results for embedding callers that do not want a json::Object tree.
+ *
+ * They are filled straight from the internal route/table/nearest results and carry the same
+ * values as the JSON responses (meters, seconds, weight units). On error only code and
+ * message are set, exactly like the "code"/"message" keys of a JSON error.
+ */
+struct RouteResult
+{
+    struct Leg
+    {
+        double distance;
+        double duration;
+        double weight;
+
+        // Per-segment annotations, only filled for the requested AnnotationsType bits
+        std::vector<std::uint64_t> nodes;
+        std::vector<double> distances;
+        std::vector<double> durations;
+        std::vector<double> weights;
+    };
+
+    struct Route
+    {
+        double distance;
+        double duration;
+        double weight;
+        std::vector<Leg> legs;
+    };
+
+    std::string code;
+    std::string message;
+    std::vector<Route> routes;
+
+    // Whether departure_time picked a departure range metric; false for the base metric
+    bool departure_metric = false;
+};
+
+struct TableResult
+{
+    std::string code;
+    std::string message;
+
+    std::size_t rows = 0;
+    std::size_t columns = 0;
+
+    // Row-major rows x columns matrices, only filled for the requested AnnotationsType bits.
+    // Unreachable cells hold NaN where the JSON response has null.
+    std::vector<double> durations;
+    std::vector<double> distances;
+
+    // (row, column) of cells estimated with the fallback speed
+    std::vector<std::pair<std::size_t, std::size_t>> fallback_speed_cells;
+
+    // Whether departure_time picked a departure range metric; false for the base metric
+    bool departure_metric = false;
+};
+
+struct NearestResult
+{
+    struct Waypoint
+    {
+        util::Coordinate location;
+        double distance;
+        // OSM ids of the two nodes of the snapped segment, 0 if unknown
+        std::uint64_t from_node;
+        std::uint64_t to_node;
+    };
+
+    std::string code;
+    std::string message;
+    std::vector<Waypoint> waypoints;
+
+    // OSM node pairs (from, to) of the segments in range, closest first.
+    // Only filled for NearestParameters::edges_in_radius, which leaves waypoints empty.
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> edges;
+};
+
+} // namespace api
+} // namespace engine
+} // namespace osrm
+
+#endif
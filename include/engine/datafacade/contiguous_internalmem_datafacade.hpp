@@ -134,6 +134,7 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
 
     extractor::ClassData exclude_mask;
     extractor::ProfileProperties *m_profile_properties;
+    bool m_departure_metric;
     extractor::Datasources *m_datasources;
 
     std::uint32_t m_check_sum;
@@ -175,10 +176,10 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
                                     const std::size_t exclude_index)
     {
         // TODO: For multi-metric support we need to have separate exclude classes per metric
-        (void)metric_name;
 
         m_profile_properties =
             index.GetBlockPtr<extractor::ProfileProperties>("/common/properties");
+        m_departure_metric = customizer::isDepartureMetric(metric_name);
 
         exclude_mask = m_profile_properties->excludable_classes[exclude_index];
 
@@ -206,7 +207,17 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         m_turn_weight_penalties = make_turn_weight_view(index, "/common/turn_penalty");
         m_turn_duration_penalties = make_turn_duration_view(index, "/common/turn_penalty");
 
-        segment_data = make_segment_data_view(index, "/common/segment_data");
+        if (m_departure_metric)
+        {
+            // only MLD customizes metrics per departure range
+            const auto departure_metric = make_departure_metric_view(
+                index, "/mld/metrics/" + metric_name, "/common/segment_data");
+            segment_data = make_segment_data_view(index, "/common/segment_data", departure_metric);
+        }
+        else
+        {
+            segment_data = make_segment_data_view(index, "/common/segment_data");
+        }
 
         m_datasources = index.GetBlockPtr<extractor::Datasources>("/common/data_sources_names");
 
@@ -312,6 +323,13 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         return m_geospatial_query->Search(bbox);
     }
 
+    std::vector<RTreeLeaf> GetEdgesInRange(const util::Coordinate input_coordinate,
+                                           const double max_distance) const override final
+    {
+        BOOST_ASSERT(m_geospatial_query.get());
+        return m_geospatial_query->NearestEdgesInRange(input_coordinate, max_distance);
+    }
+
     std::vector<PhantomNodeWithDistance>
     NearestPhantomNodesInRange(const util::Coordinate input_coordinate,
                                const float max_distance,
@@ -537,6 +555,8 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         return m_profile_properties->GetWeightMultiplier();
     }
 
+    bool IsDepartureMetric() const override final { return m_departure_metric; }
+
     util::guidance::BearingClass GetBearingClass(const NodeID node) const override final
     {
         return intersection_bearings_view.GetBearingClass(node);
@@ -659,7 +679,17 @@ template <> class ContiguousInternalMemoryAlgorithmDataFacade<MLD> : public Algo
         mld_cell_metric =
             make_filtered_cell_metric_view(index, "/mld/metrics/" + metric_name, exclude_index);
         mld_cell_storage = make_cell_storage_view(index, "/mld/cellstorage");
-        query_graph = make_multi_level_graph_view(index, "/mld/multilevelgraph");
+        if (customizer::isDepartureMetric(metric_name))
+        {
+            const auto departure_metric = make_departure_metric_view(
+                index, "/mld/metrics/" + metric_name, "/common/segment_data");
+            query_graph =
+                make_multi_level_graph_view(index, "/mld/multilevelgraph", departure_metric);
+        }
+        else
+        {
+            query_graph = make_multi_level_graph_view(index, "/mld/multilevelgraph");
+        }
     }
 
     // allocator that keeps the allocation data
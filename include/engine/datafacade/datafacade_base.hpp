@@ -123,6 +123,9 @@ class BaseDataFacade
     virtual std::vector<RTreeLeaf> GetEdgesInBox(const util::Coordinate south_west,
                                                  const util::Coordinate north_east) const = 0;
 
+    virtual std::vector<RTreeLeaf> GetEdgesInRange(const util::Coordinate input_coordinate,
+                                                   const double max_distance) const = 0;
+
     virtual std::vector<PhantomNodeWithDistance>
     NearestPhantomNodesInRange(const util::Coordinate input_coordinate,
                                const float max_distance,
@@ -209,6 +212,9 @@ class BaseDataFacade
 
     virtual double GetWeightMultiplier() const = 0;
 
+    // Whether weights and durations come from a metric customized for a departure range
+    virtual bool IsDepartureMetric() const = 0;
+
     virtual osrm::guidance::TurnBearing PreTurnBearing(const EdgeID eid) const = 0;
     virtual osrm::guidance::TurnBearing PostTurnBearing(const EdgeID eid) const = 0;
 
@@ -1,6 +1,8 @@
 #ifndef OSRM_ENGINE_DATAFACADE_FACTORY_HPP
 #define OSRM_ENGINE_DATAFACADE_FACTORY_HPP
 
+#include "customizer/departure_range.hpp"
+
 #include "extractor/class_data.hpp"
 #include "extractor/profile_properties.hpp"
 
@@ -74,6 +76,28 @@ template <template <typename A> class FacadeT, typename AlgorithmT> class DataFa
             facades[index] = std::make_shared<const Facade>(allocator, metric_name, index);
         }
 
+        std::vector<std::string> departure_prefixes;
+        auto departure_path = std::string("/") + routing_algorithms::identifier<AlgorithmT>() +
+                              std::string("/metrics/") + metric_name + "/departure/";
+        index.List(departure_path, std::back_inserter(departure_prefixes));
+        for (const auto &departure_prefix : departure_prefixes)
+        {
+            DepartureFacades departure;
+            if (!customizer::parseDepartureRange(departure_prefix, departure.range))
+            {
+                throw util::exception("Invalid departure metric " + departure_prefix);
+            }
+
+            const auto departure_metric_name =
+                customizer::departureMetricName(metric_name, departure.range);
+            for (const auto exclude_index : util::irange<std::size_t>(0, facades.size()))
+            {
+                departure.facades.push_back(std::make_shared<const Facade>(
+                    allocator, departure_metric_name, exclude_index));
+            }
+            departures.push_back(std::move(departure));
+        }
+
         for (const auto index : util::irange<std::size_t>(0, properties->class_names.size()))
         {
             const std::string name = properties->GetClassName(index);
@@ -116,11 +140,30 @@ template <template <typename A> class FacadeT, typename AlgorithmT> class DataFa
         return facades[0];
     }
 
+    // Facades of the departure range the requested departure time falls into, the base facades
+    // without a departure time or for times no range was customized for
+    const std::vector<std::shared_ptr<const Facade>> &
+    GetDepartureFacades(const api::BaseParameters &params) const
+    {
+        if (params.departure_time)
+        {
+            for (const auto &departure : departures)
+            {
+                if (departure.range.Contains(*params.departure_time))
+                    return departure.facades;
+            }
+        }
+
+        return facades;
+    }
+
     // Selection logic for finding the corresponding datafacade for the given parameters
     std::shared_ptr<const Facade> Get(const api::BaseParameters &params, std::true_type) const
     {
+        const auto &candidates = GetDepartureFacades(params);
+
         if (params.exclude.empty())
-            return facades[0];
+            return candidates[0];
 
         extractor::ClassData mask = 0;
         for (const auto &name : params.exclude)
@@ -142,13 +185,20 @@ template <template <typename A> class FacadeT, typename AlgorithmT> class DataFa
         {
             auto exclude_index =
                 std::distance(properties->excludable_classes.begin(), exclude_iter);
-            return facades[exclude_index];
+            return candidates[exclude_index];
         }
 
         return {};
     }
 
+    struct DepartureFacades
+    {
+        customizer::DepartureRange range;
+        std::vector<std::shared_ptr<const Facade>> facades;
+    };
+
     std::vector<std::shared_ptr<const Facade>> facades;
+    std::vector<DepartureFacades> departures;
     std::unordered_map<std::string, extractor::ClassData> name_to_class;
     const extractor::ProfileProperties *properties = nullptr;
 };
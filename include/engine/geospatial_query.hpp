@@ -48,6 +48,25 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
         return rtree.SearchInBox(bbox);
     }
 
+    // Returns all usable segments within max_distance, closest first, without building
+    // PhantomNodes. Does not filter by small/big component!
+    std::vector<EdgeData> NearestEdgesInRange(const util::Coordinate input_coordinate,
+                                              const double max_distance) const
+    {
+        auto results = rtree.SearchInRange(input_coordinate, max_distance);
+        results.erase(std::remove_if(results.begin(),
+                                     results.end(),
+                                     [this](const EdgeData &edge) {
+                                         const CandidateSegment segment{util::Coordinate{}, edge};
+                                         const auto use_direction = boolPairAnd(
+                                             HasValidEdge(segment, true),
+                                             CheckSegmentExclude(segment));
+                                         return !use_direction.first && !use_direction.second;
+                                     }),
+                      results.end());
+        return results;
+    }
+
     // Returns nearest PhantomNodes in the given bearing range within max_distance.
     // Does not filter by small/big component!
     std::vector<PhantomNodeWithDistance>
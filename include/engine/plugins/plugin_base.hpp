@@ -89,6 +89,16 @@ class BasePlugin
         {
             str_result = str(boost::format("code=%1% message=%2%") % code % message);
         };
+        void operator()(api::RouteResult &route_result) { Render(route_result); };
+        void operator()(api::TableResult &table_result) { Render(table_result); };
+        void operator()(api::NearestResult &nearest_result) { Render(nearest_result); };
+
+      private:
+        template <typename TypedResultT> void Render(TypedResultT &typed_result)
+        {
+            typed_result.code = code;
+            typed_result.message = message;
+        }
     };
 
     Status Error(const std::string &code,
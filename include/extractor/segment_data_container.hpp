@@ -202,6 +202,12 @@ template <storage::Ownership Ownership> class SegmentDataContainerImpl
     auto GetNumberOfGeometries() const { return index.size() - 1; }
     auto GetNumberOfSegments() const { return fwd_weights.size(); }
 
+    // Per-segment weights and durations as a whole, for metrics that share this geometry
+    const SegmentWeightVector &GetForwardWeightVector() const { return fwd_weights; }
+    const SegmentWeightVector &GetReverseWeightVector() const { return rev_weights; }
+    const SegmentDurationVector &GetForwardDurationVector() const { return fwd_durations; }
+    const SegmentDurationVector &GetReverseDurationVector() const { return rev_durations; }
+
     friend void
     serialization::read<Ownership>(storage::tar::FileReader &reader,
                                    const std::string &name,
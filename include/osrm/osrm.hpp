@@ -41,8 +41,11 @@ namespace json = util::json;
 using engine::EngineConfig;
 using engine::api::MatchParameters;
 using engine::api::NearestParameters;
+using engine::api::NearestResult;
 using engine::api::RouteParameters;
+using engine::api::RouteResult;
 using engine::api::TableParameters;
+using engine::api::TableResult;
 using engine::api::TileParameters;
 using engine::api::TripParameters;
 
@@ -59,6 +62,8 @@ using engine::api::TripParameters;
  *  - Tile: vector tiles with internal graph representation
  *
  *  All services take service-specific parameters, fill a JSON object, and return a status code.
+ *  Route, Table and Nearest can also fill plain structs (RouteResult, TableResult and
+ *  NearestResult) which skips building and walking a JSON tree.
  */
 class OSRM final
 {
@@ -86,6 +91,7 @@ class OSRM final
      */
     Status Route(const RouteParameters &parameters, json::Object &result) const;
     Status Route(const RouteParameters &parameters, engine::api::ResultT &result) const;
+    Status Route(const RouteParameters &parameters, RouteResult &result) const;
 
     /**
      * Distance tables for coordinates.
@@ -96,6 +102,7 @@ class OSRM final
      */
     Status Table(const TableParameters &parameters, json::Object &result) const;
     Status Table(const TableParameters &parameters, engine::api::ResultT &result) const;
+    Status Table(const TableParameters &parameters, TableResult &result) const;
 
     /**
      * Nearest street segment for coordinate.
@@ -106,6 +113,7 @@ class OSRM final
      */
     Status Nearest(const NearestParameters &parameters, json::Object &result) const;
     Status Nearest(const NearestParameters &parameters, engine::api::ResultT &result) const;
+    Status Nearest(const NearestParameters &parameters, NearestResult &result) const;
 
     /**
      * Trip: shortest round trip between coordinates.
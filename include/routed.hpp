@@ -1,6 +1,12 @@
 #pragma once
 
 #include "osrm/engine_config.hpp"
+#include "osrm/osrm.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 
 namespace osrm
@@ -20,17 +26,19 @@ inline unsigned generateServerProgramOptions( const int argc,
                                               osrm::EngineConfig &config,
                                               int &requested_thread_num );
 
-std::string routedDIST( double lat1, double lon1, double lat2, double lon2, const char * argv );
+std::string routedDIST( double lat1, double lon1, double lat2, double lon2, const osrm::OSRM &osrm );
+
+std::string table( double lat1, double lon1, double lat2, double lon2, const osrm::OSRM &osrm );
 
-std::string table( double lat1, double lon1, double lat2, double lon2, const char * argv );
+std::vector<std::string> tableDIST( const std::vector<std::array<double, 4>> &pairs, const osrm::OSRM &osrm, int max_table_size );
 
-std::string routed( double lat1, double lon1, double lat2, double lon2, const char * argv );
+std::string routed( double lat1, double lon1, double lat2, double lon2, const osrm::OSRM &osrm, std::vector<std::uint64_t> &nodes );
 
-std::string routedStringDistances( std::string longlat, const char * argv );
+std::string routedStringDistances( std::string longlat, const osrm::OSRM &osrm );
 
-std::string routedString( std::string longlat, const char * argv );
+std::string routedString( std::string longlat, const osrm::OSRM &osrm, std::vector<std::vector<std::uint64_t>> &legnodes );
 
-std::string near( double lat, double lon, const char * argv, double radius );
+std::vector<std::uint64_t> near( double lat, double lon, const osrm::OSRM &osrm, double radius );
 
 std::string addZeroStr( std::string date );
 
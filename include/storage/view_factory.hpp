@@ -6,6 +6,7 @@
 #include "contractor/contracted_metric.hpp"
 #include "contractor/query_graph.hpp"
 
+#include "customizer/departure_metric.hpp"
 #include "customizer/edge_based_graph.hpp"
 
 #include "extractor/class_data.hpp"
@@ -170,6 +171,72 @@ inline auto make_segment_data_view(const SharedDataIndex &index, const std::stri
                                       std::move(rev_datasources_list)};
 }
 
+// The segment weights and durations of a departure metric are indexed like the geometry in
+// segment_data_name, which they share with the base metric
+inline auto make_departure_metric_view(const SharedDataIndex &index,
+                                       const std::string &name,
+                                       const std::string &segment_data_name)
+{
+    using DepartureMetricView = customizer::DepartureMetricView;
+
+    auto num_entries = index.GetBlockEntries(segment_data_name + "/nodes");
+
+    auto node_weights = make_vector_view<EdgeWeight>(index, name + "/node_weights");
+    auto node_durations = make_vector_view<EdgeDuration>(index, name + "/node_durations");
+
+    DepartureMetricView::SegmentData::SegmentWeightVector fwd_weight_list(
+        make_vector_view<DepartureMetricView::SegmentData::SegmentWeightVector::block_type>(
+            index, name + "/segment_data/forward_weights/packed"),
+        num_entries);
+
+    DepartureMetricView::SegmentData::SegmentWeightVector rev_weight_list(
+        make_vector_view<DepartureMetricView::SegmentData::SegmentWeightVector::block_type>(
+            index, name + "/segment_data/reverse_weights/packed"),
+        num_entries);
+
+    DepartureMetricView::SegmentData::SegmentDurationVector fwd_duration_list(
+        make_vector_view<DepartureMetricView::SegmentData::SegmentDurationVector::block_type>(
+            index, name + "/segment_data/forward_durations/packed"),
+        num_entries);
+
+    DepartureMetricView::SegmentData::SegmentDurationVector rev_duration_list(
+        make_vector_view<DepartureMetricView::SegmentData::SegmentDurationVector::block_type>(
+            index, name + "/segment_data/reverse_durations/packed"),
+        num_entries);
+
+    return DepartureMetricView{std::move(node_weights),
+                               std::move(node_durations),
+                               std::move(fwd_weight_list),
+                               std::move(rev_weight_list),
+                               std::move(fwd_duration_list),
+                               std::move(rev_duration_list)};
+}
+
+// Segment data with the weights and durations of a departure metric instead of its own
+inline auto make_segment_data_view(const SharedDataIndex &index,
+                                   const std::string &name,
+                                   const customizer::DepartureMetricView &metric)
+{
+    auto geometry_begin_indices = make_vector_view<unsigned>(index, name + "/index");
+
+    auto node_list = make_vector_view<NodeID>(index, name + "/nodes");
+
+    auto fwd_datasources_list =
+        make_vector_view<DatasourceID>(index, name + "/forward_data_sources");
+
+    auto rev_datasources_list =
+        make_vector_view<DatasourceID>(index, name + "/reverse_data_sources");
+
+    return extractor::SegmentDataView{std::move(geometry_begin_indices),
+                                      std::move(node_list),
+                                      metric.forward_weights,
+                                      metric.reverse_weights,
+                                      metric.forward_durations,
+                                      metric.reverse_durations,
+                                      std::move(fwd_datasources_list),
+                                      std::move(rev_datasources_list)};
+}
+
 inline auto make_coordinates_view(const SharedDataIndex &index, const std::string &name)
 {
     return make_vector_view<util::Coordinate>(index, name);
@@ -356,6 +423,31 @@ inline auto make_multi_level_graph_view(const SharedDataIndex &index, const std:
                                                     std::move(is_backward_edge));
 }
 
+// Multi-level graph with the node weights and durations of a departure metric instead of its own
+inline auto make_multi_level_graph_view(const SharedDataIndex &index,
+                                        const std::string &name,
+                                        const customizer::DepartureMetricView &metric)
+{
+    auto node_list = make_vector_view<customizer::MultiLevelEdgeBasedGraphView::NodeArrayEntry>(
+        index, name + "/node_array");
+    auto edge_list = make_vector_view<customizer::MultiLevelEdgeBasedGraphView::EdgeArrayEntry>(
+        index, name + "/edge_array");
+    auto node_to_offset = make_vector_view<customizer::MultiLevelEdgeBasedGraphView::EdgeOffset>(
+        index, name + "/node_to_edge_offset");
+    auto node_distances = make_vector_view<EdgeDistance>(index, name + "/node_distances");
+    auto is_forward_edge = make_vector_view<bool>(index, name + "/is_forward_edge");
+    auto is_backward_edge = make_vector_view<bool>(index, name + "/is_backward_edge");
+
+    return customizer::MultiLevelEdgeBasedGraphView(std::move(node_list),
+                                                    std::move(edge_list),
+                                                    std::move(node_to_offset),
+                                                    metric.node_weights,
+                                                    metric.node_durations,
+                                                    std::move(node_distances),
+                                                    std::move(is_forward_edge),
+                                                    std::move(is_backward_edge));
+}
+
 inline auto make_maneuver_overrides_views(const SharedDataIndex &index, const std::string &name)
 {
     auto maneuver_overrides =
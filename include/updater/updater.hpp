@@ -4,6 +4,7 @@
 #include "updater/updater_config.hpp"
 
 #include "extractor/edge_based_edge.hpp"
+#include "extractor/segment_data_container.hpp"
 
 #include <chrono>
 #include <vector>
@@ -34,7 +35,22 @@ class Updater
         std::vector<EdgeDistance> &node_distances, // TODO: remove when optional
         std::uint32_t &connectivity_checksum) const;
 
+    // Leaves the input files untouched and hands out the updated segment data instead, for
+    // metrics that are customized next to the one written by the calls above
+    EdgeID LoadAndUpdateEdgeExpandedGraph(
+        std::vector<extractor::EdgeBasedEdge> &edge_based_edge_list,
+        std::vector<EdgeWeight> &node_weights,
+        std::vector<EdgeDuration> &node_durations, // TODO: remove when optional
+        extractor::SegmentDataContainer &segment_data,
+        std::uint32_t &connectivity_checksum) const;
+
   private:
+    EdgeID UpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &edge_based_edge_list,
+                                   std::vector<EdgeWeight> &node_weights,
+                                   std::vector<EdgeDuration> &node_durations,
+                                   extractor::SegmentDataContainer *updated_segment_data,
+                                   std::uint32_t &connectivity_checksum) const;
+
     UpdaterConfig config;
 };
 } // namespace updater
@@ -0,0 +1,590 @@
+#ifndef OSRM_UTIL_ASYNC_LOG_HPP
+#define OSRM_UTIL_ASYNC_LOG_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+
+/**
+ * Line logger that keeps formatting and all file I/O off the logging threads.
+ *
+ * Every thread appends its lines to a ring of its own (single producer, no locks): the raw
+ * CLOCK_REALTIME stamp and the values of the line. Numbers, characters and strings go in as they
+ * are, with the flags, precision, width and fill of the stream they were written to; only values
+ * of other types are formatted by the logging thread. A background thread drains all rings every
+ * poll interval, orders the lines by stamp, formats their values, prefixes each with its
+ * "%D %T.nanoseconds " UTC stamp and writes them to the file. Flush() waits until everything
+ * logged before it is in the file; Close() and the destructor flush as well.
+ *
+ * A thread whose ring is full waits for the writer, so lines are never dropped. Lines logged while
+ * no file is open are discarded, as with a closed std::ofstream.
+ */
+class AsyncLog
+{
+    struct Header
+    {
+        std::int64_t seconds;
+        std::int64_t nanoseconds;
+        std::uint32_t length;
+    };
+
+    // Collects text; keeps its capacity from line to line
+    class LineBuffer : public std::streambuf
+    {
+      public:
+        std::string text;
+
+      protected:
+        int_type overflow(int_type c) override
+        {
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+                text.push_back(traits_type::to_char_type(c));
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(const char *s, std::streamsize n) override
+        {
+            text.append(s, static_cast<std::size_t>(n));
+            return n;
+        }
+    };
+
+    // Turns the payload of a value back into text on the writer's stream
+    using Format = void (*)(std::ostream &out, const char *payload, std::size_t size);
+
+    // A value of a line in the ring, followed by size bytes of payload
+    struct Item
+    {
+        Format format;
+        std::ios_base::fmtflags flags;
+        std::streamsize precision;
+        std::streamsize width;
+        char fill;
+        std::uint32_t size;
+    };
+
+    template <typename T>
+    static void FormatValue(std::ostream &out, const char *payload, std::size_t)
+    {
+        T value;
+        std::memcpy(&value, payload, sizeof(T));
+        out << value;
+    }
+
+    static void FormatText(std::ostream &out, const char *payload, std::size_t size)
+    {
+        if (out.width() > 0)
+            out << std::string(payload, size);
+        else
+            out.write(payload, static_cast<std::streamsize>(size));
+    }
+
+  public:
+    // The values of one line while the calling thread builds it
+    class LineValues
+    {
+      public:
+        template <typename T> void Value(const T &value)
+        {
+            Add(&FormatValue<T>, &value, sizeof(T));
+        }
+
+        void Text(const char *text, std::size_t size) { Add(&FormatText, text, size); }
+
+        // Values of other types and manipulators go through the stream of the line, which keeps
+        // the formatting state of the values added afterwards
+        std::ostream &Stream() { return out; }
+
+        // Adds the text the stream produced as an already formatted value
+        void TakeText()
+        {
+            if (buffer.text.empty())
+                return;
+            Text(buffer.text.data(), buffer.text.size());
+            buffer.text.clear();
+        }
+
+      private:
+        friend class AsyncLog;
+
+        void Add(Format format, const void *payload, std::size_t size)
+        {
+            const Item item{format,
+                            out.flags(),
+                            out.precision(),
+                            out.width(),
+                            out.fill(),
+                            static_cast<std::uint32_t>(size)};
+            // as after out << value, the width only applies to one value
+            out.width(0);
+            const std::size_t at = items.size();
+            items.resize(at + sizeof(Item) + size);
+            std::memcpy(&items[at], &item, sizeof(Item));
+            std::memcpy(&items[at + sizeof(Item)], payload, size);
+        }
+
+        std::string items;
+        LineBuffer buffer;
+        std::ostream out{&buffer};
+    };
+
+  private:
+    struct Ring
+    {
+        explicit Ring(std::size_t capacity) : bytes(capacity) {}
+
+        std::vector<char> bytes;
+        std::atomic<std::uint64_t> head{0}; // written by the owning thread
+        std::atomic<std::uint64_t> tail{0}; // consumed by the writer
+        std::atomic<bool> orphaned{false};  // the owning thread has exited
+
+        // owning thread only; one line per nesting level of lines being built
+        std::vector<std::unique_ptr<LineValues>> lines;
+        std::size_t depth = 0;
+    };
+
+    // Rings of the calling thread, one per log; marks them orphaned when the thread exits
+    struct ThreadRings
+    {
+        std::vector<std::pair<std::uint64_t, std::shared_ptr<Ring>>> rings;
+
+        ~ThreadRings()
+        {
+            for (auto &ring : rings)
+                ring.second->orphaned = true;
+        }
+    };
+
+  public:
+    explicit AsyncLog(std::size_t ring_bytes = 1 << 18,
+                      std::chrono::milliseconds poll_interval = std::chrono::milliseconds(20))
+        : id(NextId()), capacity(RoundUp(std::max<std::size_t>(ring_bytes, 4 * sizeof(Header)))),
+          poll_interval(poll_interval)
+    {
+    }
+
+    AsyncLog(const AsyncLog &) = delete;
+    AsyncLog &operator=(const AsyncLog &) = delete;
+
+    ~AsyncLog()
+    {
+        if (!worker.joinable())
+            return;
+        Flush();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    bool Open(const std::string &path,
+              std::ios_base::openmode mode = std::ios_base::out | std::ios_base::app)
+    {
+        Flush();
+        {
+            std::lock_guard<std::mutex> lock(file_mutex);
+            if (file.is_open())
+                file.close();
+            file.open(path.c_str(), mode);
+            if (!file.is_open())
+                return false;
+        }
+        {
+            // the writer starts with the first file, so processes that never log run no thread
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!worker.joinable())
+                worker = std::thread(&AsyncLog::Run, this);
+        }
+        open = true;
+        return true;
+    }
+
+    bool IsOpen() const { return open.load(std::memory_order_relaxed); }
+
+    void Close()
+    {
+        open = false;
+        Flush();
+        std::lock_guard<std::mutex> lock(file_mutex);
+        file.close();
+    }
+
+    void Flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        std::vector<std::pair<std::shared_ptr<Ring>, std::uint64_t>> targets;
+        for (const auto &ring : rings)
+            targets.emplace_back(ring, ring->head.load(std::memory_order_acquire));
+        drain_requested = true;
+        wake.notify_one();
+        drained.wait(lock, [&targets] {
+            for (const auto &target : targets)
+                if (target.first->tail.load(std::memory_order_acquire) < target.second)
+                    return false;
+            return true;
+        });
+    }
+
+    // Lines written to the file and times a thread found its ring full
+    std::size_t Written() const { return written.load(); }
+    std::size_t Waits() const { return waits.load(); }
+
+    // A line is built in the calling thread's values for this log and appended on Commit()
+    LineValues *Begin()
+    {
+        Ring &ring = ThreadRing();
+        if (ring.depth == ring.lines.size())
+            ring.lines.emplace_back(new LineValues);
+        auto &values = *ring.lines[ring.depth++];
+        values.items.clear();
+        values.buffer.text.clear();
+        return &values;
+    }
+
+    void Commit(const timespec &stamp)
+    {
+        Ring &ring = ThreadRing();
+        std::string &items = ring.lines[--ring.depth]->items;
+        Append(ring, stamp, items.data(), Fit(items));
+    }
+
+  private:
+    static std::uint64_t NextId()
+    {
+        static std::atomic<std::uint64_t> next{0};
+        return next++;
+    }
+
+    static std::size_t RoundUp(std::size_t bytes)
+    {
+        std::size_t rounded = 1;
+        while (rounded < bytes)
+            rounded <<= 1;
+        return rounded;
+    }
+
+    // Bytes of items that fit into the ring: the values that fit whole and as much of the text
+    // of the first one that does not as fits
+    std::size_t Fit(std::string &items) const
+    {
+        const std::size_t limit = capacity - sizeof(Header);
+        if (items.size() <= limit)
+            return items.size();
+        std::size_t length = 0;
+        while (length < items.size())
+        {
+            Item item;
+            std::memcpy(&item, &items[length], sizeof(Item));
+            if (length + sizeof(Item) + item.size <= limit)
+            {
+                length += sizeof(Item) + item.size;
+                continue;
+            }
+            if (item.format == &FormatText && length + sizeof(Item) < limit)
+            {
+                item.size = static_cast<std::uint32_t>(limit - length - sizeof(Item));
+                std::memcpy(&items[length], &item, sizeof(Item));
+                length = limit;
+            }
+            break;
+        }
+        return length;
+    }
+
+    Ring &ThreadRing()
+    {
+        static thread_local ThreadRings thread_rings;
+        for (const auto &ring : thread_rings.rings)
+            if (ring.first == id)
+                return *ring.second;
+
+        auto ring = std::make_shared<Ring>(capacity);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            rings.push_back(ring);
+        }
+        thread_rings.rings.emplace_back(id, ring);
+        return *ring;
+    }
+
+    void Append(Ring &ring, const timespec &stamp, const char *items, std::size_t length)
+    {
+        const std::size_t size = sizeof(Header) + length;
+        const std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+        while (capacity - (head - ring.tail.load(std::memory_order_acquire)) < size)
+        {
+            ++waits;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                drain_requested = true;
+            }
+            wake.notify_one();
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+
+        const Header header{stamp.tv_sec, stamp.tv_nsec, static_cast<std::uint32_t>(length)};
+        Copy(ring, head, reinterpret_cast<const char *>(&header), sizeof(Header));
+        Copy(ring, head + sizeof(Header), items, length);
+        ring.head.store(head + size, std::memory_order_release);
+    }
+
+    void Copy(Ring &ring, std::uint64_t position, const char *from, std::size_t length) const
+    {
+        const std::size_t offset = position & (capacity - 1);
+        const std::size_t first = std::min(length, capacity - offset);
+        std::memcpy(ring.bytes.data() + offset, from, first);
+        std::memcpy(ring.bytes.data(), from + first, length - first);
+    }
+
+    void Read(const Ring &ring, std::uint64_t position, char *to, std::size_t length) const
+    {
+        const std::size_t offset = position & (capacity - 1);
+        const std::size_t first = std::min(length, capacity - offset);
+        std::memcpy(to, ring.bytes.data() + offset, first);
+        std::memcpy(to + first, ring.bytes.data(), length - first);
+    }
+
+    // A drained line; its items are at offset in the item buffer of the drain
+    struct Line
+    {
+        std::int64_t seconds;
+        std::int64_t nanoseconds;
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    void Run()
+    {
+        std::vector<std::pair<std::shared_ptr<Ring>, std::uint64_t>> taken;
+        std::vector<Line> lines;
+        std::string items;
+        LineBuffer formatted;
+        std::ostream out(&formatted);
+        std::int64_t stamped_second = -1;
+        char second_text[64] = "";
+
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            wake.wait_for(lock, poll_interval, [this] { return stopping || drain_requested; });
+            const bool stop = stopping;
+            drain_requested = false;
+            taken.clear();
+            for (const auto &ring : rings)
+                taken.emplace_back(ring, ring->head.load(std::memory_order_acquire));
+            lock.unlock();
+
+            lines.clear();
+            items.clear();
+            for (const auto &ring : taken)
+            {
+                std::uint64_t position = ring.first->tail.load(std::memory_order_relaxed);
+                while (position < ring.second)
+                {
+                    Header header;
+                    Read(*ring.first, position, reinterpret_cast<char *>(&header), sizeof(Header));
+                    lines.push_back(
+                        {header.seconds, header.nanoseconds, items.size(), header.length});
+                    items.resize(items.size() + header.length);
+                    Read(*ring.first,
+                         position + sizeof(Header),
+                         &items[lines.back().offset],
+                         header.length);
+                    position += sizeof(Header) + header.length;
+                }
+            }
+            std::stable_sort(lines.begin(), lines.end(), [](const Line &lhs, const Line &rhs) {
+                return lhs.seconds < rhs.seconds ||
+                       (lhs.seconds == rhs.seconds && lhs.nanoseconds < rhs.nanoseconds);
+            });
+
+            formatted.text.clear();
+            for (const auto &line : lines)
+            {
+                if (line.seconds != stamped_second)
+                {
+                    const std::time_t seconds = static_cast<std::time_t>(line.seconds);
+                    std::tm utc;
+                    gmtime_r(&seconds, &utc);
+                    std::strftime(second_text, sizeof(second_text), "%D %T", &utc);
+                    stamped_second = line.seconds;
+                }
+                char stamp[96];
+                const int length = std::snprintf(stamp,
+                                                 sizeof(stamp),
+                                                 "%s.%09ld ",
+                                                 second_text,
+                                                 static_cast<long>(line.nanoseconds));
+                formatted.text.append(stamp, static_cast<std::size_t>(length));
+                for (std::size_t at = line.offset; at < line.offset + line.length;)
+                {
+                    Item item;
+                    std::memcpy(&item, &items[at], sizeof(Item));
+                    out.flags(item.flags);
+                    out.precision(item.precision);
+                    out.width(item.width);
+                    out.fill(item.fill);
+                    item.format(out, &items[at + sizeof(Item)], item.size);
+                    at += sizeof(Item) + item.size;
+                }
+            }
+            if (!formatted.text.empty())
+            {
+                std::lock_guard<std::mutex> file_lock(file_mutex);
+                if (file.is_open())
+                {
+                    file.write(formatted.text.data(),
+                               static_cast<std::streamsize>(formatted.text.size()));
+                    file.flush();
+                }
+            }
+            written += lines.size();
+
+            // space is handed back only once the lines are in the file, which Flush() relies on
+            for (const auto &ring : taken)
+                ring.first->tail.store(ring.second, std::memory_order_release);
+
+            lock.lock();
+            rings.erase(std::remove_if(rings.begin(),
+                                       rings.end(),
+                                       [](const std::shared_ptr<Ring> &ring) {
+                                           return ring->orphaned &&
+                                                  ring->tail.load() == ring->head.load();
+                                       }),
+                        rings.end());
+            drained.notify_all();
+            if (stop)
+                return;
+        }
+    }
+
+    const std::uint64_t id;
+    const std::size_t capacity;
+    const std::chrono::milliseconds poll_interval;
+
+    std::atomic<bool> open{false};
+    std::mutex file_mutex;
+    std::ofstream file;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable drained;
+    std::vector<std::shared_ptr<Ring>> rings;
+    bool drain_requested = false;
+    bool stopping = false;
+    std::atomic<std::size_t> written{0};
+    std::atomic<std::size_t> waits{0};
+
+    std::thread worker;
+};
+
+/**
+ * One line for an AsyncLog, used like an ostream: log_line << "eta " << eta << std::endl;
+ * The stamp is taken when the line starts and the line is handed over when it goes out of scope.
+ * Numbers, characters and strings are copied and formatted by the writer; other values are
+ * formatted here.
+ */
+class AsyncLogLine
+{
+  public:
+    explicit AsyncLogLine(AsyncLog &log)
+        : log(log), values(log.IsOpen() ? log.Begin() : nullptr)
+    {
+        if (values)
+            clock_gettime(CLOCK_REALTIME, &stamp);
+    }
+
+    AsyncLogLine(const AsyncLogLine &) = delete;
+    AsyncLogLine &operator=(const AsyncLogLine &) = delete;
+
+    ~AsyncLogLine()
+    {
+        if (values)
+            log.Commit(stamp);
+    }
+
+    template <typename T> AsyncLogLine &operator<<(const T &value)
+    {
+        if (values)
+            Add(value, Copied<T>{});
+        return *this;
+    }
+
+    AsyncLogLine &operator<<(const std::string &value)
+    {
+        if (values)
+            values->Text(value.data(), value.size());
+        return *this;
+    }
+
+    AsyncLogLine &operator<<(const char *value)
+    {
+        if (values)
+            values->Text(value, std::strlen(value));
+        return *this;
+    }
+
+    AsyncLogLine &operator<<(char *value) { return *this << static_cast<const char *>(value); }
+
+    AsyncLogLine &operator<<(std::ostream &(*manipulator)(std::ostream &))
+    {
+        if (values)
+        {
+            manipulator(values->Stream());
+            values->TakeText();
+        }
+        return *this;
+    }
+
+    AsyncLogLine &operator<<(std::ios_base &(*manipulator)(std::ios_base &))
+    {
+        if (values)
+            manipulator(values->Stream());
+        return *this;
+    }
+
+  private:
+    template <typename T>
+    using Copied =
+        std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value>;
+
+    template <typename T> void Add(const T &value, std::true_type) { values->Value(value); }
+
+    // setprecision() and the like only change the stream; anything else is formatted here
+    template <typename T> void Add(const T &value, std::false_type)
+    {
+        values->Stream() << value;
+        values->TakeText();
+    }
+
+    AsyncLog &log;
+    AsyncLog::LineValues *values;
+    timespec stamp;
+};
+} // namespace util
+} // namespace osrm
+
+#endif // OSRM_UTIL_ASYNC_LOG_HPP
@@ -0,0 +1,133 @@
+#ifndef OSRM_UTIL_BOUNDED_MPMC_QUEUE_HPP
+#define OSRM_UTIL_BOUNDED_MPMC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace osrm
+{
+namespace util
+{
+
+/**
+ * Bounded lock-free multi-producer/multi-consumer FIFO queue (Vyukov's sequenced ring).
+ *
+ * Every cell carries a sequence number that tells producers and consumers whether the
+ * cell is free for the current lap, so both ends only need one CAS on their position
+ * counter. The queue holds no pointers and no heap memory, which makes it safe to place
+ * inside a boost::interprocess segment and share between processes.
+ */
+template <typename T, std::size_t Capacity> class BoundedMPMCQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable values can be shared between processes");
+
+  public:
+    BoundedMPMCQueue() : enqueue_position(0), dequeue_position(0)
+    {
+        for (std::size_t index = 0; index < Capacity; ++index)
+            cells[index].sequence.store(index, std::memory_order_relaxed);
+    }
+
+    BoundedMPMCQueue(const BoundedMPMCQueue &) = delete;
+    BoundedMPMCQueue &operator=(const BoundedMPMCQueue &) = delete;
+
+    // Returns false if the queue is full
+    bool TryPush(const T &value)
+    {
+        Cell *cell;
+        std::size_t position = enqueue_position.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &cells[position & (Capacity - 1)];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference =
+                static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (difference == 0)
+            {
+                if (enqueue_position.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Returns false if the queue is empty
+    bool TryPop(T &value)
+    {
+        Cell *cell;
+        std::size_t position = dequeue_position.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &cells[position & (Capacity - 1)];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence) -
+                                    static_cast<std::ptrdiff_t>(position + 1);
+            if (difference == 0)
+            {
+                if (dequeue_position.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+        value = cell->value;
+        cell->sequence.store(position + Capacity, std::memory_order_release);
+        return true;
+    }
+
+    // Only a snapshot: concurrent pushes and pops may change it right away
+    std::size_t ApproximateSize() const
+    {
+        const std::size_t enqueued = enqueue_position.load(std::memory_order_relaxed);
+        const std::size_t dequeued = dequeue_position.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+  private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    // keep the two hot counters and the cells on separate cache lines
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+    using Padding = char[CACHE_LINE_SIZE];
+
+    Padding padding0;
+    std::array<Cell, Capacity> cells;
+    Padding padding1;
+    std::atomic<std::size_t> enqueue_position;
+    Padding padding2;
+    std::atomic<std::size_t> dequeue_position;
+    Padding padding3;
+};
+}
+}
+
+#endif // OSRM_UTIL_BOUNDED_MPMC_QUEUE_HPP
@@ -0,0 +1,138 @@
+#ifndef OSRM_UTIL_PERMUTATION_SORT_HPP
+#define OSRM_UTIL_PERMUTATION_SORT_HPP
+
+#include "util/permutation.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+
+/**
+ * Sorting of parallel arrays through an ordering of their positions.
+ *
+ * The order is described by keys over the arrays, ascending or descending and chained with
+ * thenBy(). A range of positions is sorted (or only its best k selected) under that key and the
+ * resulting ordering is applied to every parallel array in one pass each. Ties keep their
+ * original order, so the results match the stable exchange sorts these replace.
+ */
+template <typename T> class ArrayKey
+{
+  public:
+    ArrayKey(const T *values, bool descending) : values(values), descending(descending) {}
+
+    // Negative if position lhs goes first, positive if rhs does, 0 on a tie
+    int compare(std::size_t lhs, std::size_t rhs) const
+    {
+        if (values[lhs] < values[rhs])
+            return descending ? 1 : -1;
+        if (values[rhs] < values[lhs])
+            return descending ? -1 : 1;
+        return 0;
+    }
+
+  private:
+    const T *values;
+    bool descending;
+};
+
+template <typename First, typename Second> class ChainedKey
+{
+  public:
+    ChainedKey(First first, Second second) : first(first), second(second) {}
+
+    int compare(std::size_t lhs, std::size_t rhs) const
+    {
+        const int order = first.compare(lhs, rhs);
+        return order != 0 ? order : second.compare(lhs, rhs);
+    }
+
+  private:
+    First first;
+    Second second;
+};
+
+template <typename T> ArrayKey<T> ascending(const T *values) { return ArrayKey<T>(values, false); }
+
+template <typename T> ArrayKey<T> descending(const T *values) { return ArrayKey<T>(values, true); }
+
+// Orders by first and breaks its ties with second
+template <typename First, typename Second>
+ChainedKey<First, Second> thenBy(First first, Second second)
+{
+    return ChainedKey<First, Second>(first, second);
+}
+
+// Positions [first, last) in key order, ties in position order
+template <typename Key>
+std::vector<std::size_t> sortedPositions(std::size_t first, std::size_t last, const Key &key)
+{
+    std::vector<std::size_t> positions(last - first);
+    std::iota(positions.begin(), positions.end(), first);
+    std::stable_sort(positions.begin(), positions.end(), [&key](std::size_t lhs, std::size_t rhs) {
+        return key.compare(lhs, rhs) < 0;
+    });
+    return positions;
+}
+
+// The first k positions sortedPositions() would return, without ordering the rest
+template <typename Key>
+std::vector<std::size_t>
+topPositions(std::size_t first, std::size_t last, std::size_t k, const Key &key)
+{
+    std::vector<std::size_t> positions(last - first);
+    std::iota(positions.begin(), positions.end(), first);
+    k = std::min(k, positions.size());
+    std::partial_sort(positions.begin(),
+                      positions.begin() + k,
+                      positions.end(),
+                      [&key](std::size_t lhs, std::size_t rhs) {
+                          const int order = key.compare(lhs, rhs);
+                          return order != 0 ? order < 0 : lhs < rhs;
+                      });
+    positions.resize(k);
+    return positions;
+}
+
+namespace permutation_sort_detail
+{
+inline void permuteAll(const std::vector<std::size_t> &, std::size_t) {}
+
+template <typename T, typename... Arrays>
+void permuteAll(const std::vector<std::size_t> &old_to_new,
+                std::size_t first,
+                T *values,
+                Arrays *... arrays)
+{
+    inplacePermutation(values + first, values + first + old_to_new.size(), old_to_new);
+    permuteAll(old_to_new, first, arrays...);
+}
+} // namespace permutation_sort_detail
+
+// Moves the values at positions[i] to first + i in every array
+template <typename... Arrays>
+void applyPositions(const std::vector<std::size_t> &positions, std::size_t first, Arrays *... arrays)
+{
+    std::vector<std::size_t> old_to_new(positions.size());
+    for (std::size_t index = 0; index < positions.size(); ++index)
+        old_to_new[positions[index] - first] = index;
+    permutation_sort_detail::permuteAll(old_to_new, first, arrays...);
+}
+
+// Stable sort of the range [first, last) of parallel arrays under key
+template <typename Key, typename... Arrays>
+void sortParallel(std::size_t first, std::size_t last, const Key &key, Arrays *... arrays)
+{
+    if (last <= first + 1)
+        return;
+    applyPositions(sortedPositions(first, last, key), first, arrays...);
+}
+} // namespace util
+} // namespace osrm
+
+#endif // OSRM_UTIL_PERMUTATION_SORT_HPP
@@ -0,0 +1,107 @@
+#ifndef OSRM_UTIL_ROUTE_SLACK_HPP
+#define OSRM_UTIL_ROUTE_SLACK_HPP
+
+#include <algorithm>
+#include <climits>
+
+namespace osrm
+{
+namespace util
+{
+
+/**
+ * Per-stop state of one vehicle route, cached so an insertion can be checked without walking
+ * the stops after it.
+ *
+ * Stop p holds its arrival and departure minute, the minutes to stop p + 1, the latest arrival
+ * the stop accepts and the occupancy after it in each of Loads dimensions. build() derives the
+ * forward slack from that: slack(p) is how many minutes the departure from stop p - 1 can slip
+ * before stop p or a later one arrives after its latest minute, counting the waits at early
+ * stops that absorb a delay. A stop that is already late takes no further delay.
+ */
+template <int MaxStops, int Loads> class RouteSlack
+{
+  public:
+    RouteSlack() : count(0) {}
+
+    int size() const { return count; }
+
+    void clear() { count = 0; }
+
+    // Appends stop size(); build() has to run again before the slack is read
+    void push(int arrival, int departure, int travel, int latest, const int (&load)[Loads])
+    {
+        Stop &stop = stops[count++];
+        stop.arrival = arrival;
+        stop.departure = departure;
+        stop.travel = travel;
+        stop.latest = latest;
+        std::copy(load, load + Loads, stop.load);
+    }
+
+    void build()
+    {
+        forward[count] = INT_MAX;
+        for (int p = count - 1; p >= 1; p--)
+            forward[p] = wait(p) + std::min(room(p), forward[p + 1]);
+    }
+
+    int arrival(int p) const { return stops[p].arrival; }
+    int departure(int p) const { return stops[p].departure; }
+    int load(int p, int dimension) const { return stops[p].load[dimension]; }
+    int slack(int p) const { return forward[p]; }
+
+    // Whether the stops after stop k stay on time when an insertion before stop k makes the
+    // vehicle arrive there at arrival. One comparison; stop k itself is the caller's to check.
+    bool delayFits(int k, int arrival) const
+    {
+        if (k + 1 >= count)
+            return true;
+        return arrival - stops[k].arrival <= forward[k + 1];
+    }
+
+    // The answer delayFits() gives, found by pushing the delay through every later stop
+    bool delayFitsByPropagation(int k, int arrival) const
+    {
+        int delay = arrival - stops[k].arrival;
+        for (int p = k + 1; p < count && delay > 0; p++)
+        {
+            delay = std::max(0, delay - wait(p));
+            if (delay > room(p))
+                return false;
+        }
+        return true;
+    }
+
+    // Whether added more in dimension fit on the leg into stop k, next to the occupancy after k - 1
+    bool loadFits(int k, int dimension, int added, int capacity) const
+    {
+        return stops[k - 1].load[dimension] + added <= capacity;
+    }
+
+  private:
+    struct Stop
+    {
+        int arrival;
+        int departure;
+        int travel; // minutes to the next stop
+        int latest;
+        int load[Loads];
+    };
+
+    // Minutes the vehicle idles before stop p, which a delay upstream uses up first
+    int wait(int p) const
+    {
+        return std::max(0, stops[p].arrival - stops[p - 1].departure - stops[p - 1].travel);
+    }
+
+    int room(int p) const { return std::max(0, stops[p].latest - stops[p].arrival); }
+
+    int count;
+    Stop stops[MaxStops];
+    int forward[MaxStops + 1];
+};
+} // namespace util
+} // namespace osrm
+
+#endif // OSRM_UTIL_ROUTE_SLACK_HPP
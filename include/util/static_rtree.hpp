@@ -30,6 +30,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <queue>
@@ -555,6 +556,46 @@ class StaticRTree
         return results;
     }
 
+    /* Returns all features within max_distance meters of the coordinate, closest first.
+       Walks the tree with the bounding box of the circle and only tests the leaves. */
+    std::vector<EdgeDataT> SearchInRange(const Coordinate input_coordinate,
+                                         const double max_distance) const
+    {
+        const double latitude = static_cast<double>(toFloating(input_coordinate.lat));
+        const double lat_delta = max_distance / coordinate_calculation::detail::EARTH_RADIUS *
+                                 coordinate_calculation::detail::RAD_TO_DEGREE;
+        const double lon_delta =
+            lat_delta /
+            std::max(std::cos(latitude * coordinate_calculation::detail::DEGREE_TO_RAD), 1e-6);
+        const Rectangle search_rectangle{
+            input_coordinate.lon - toFixed(FloatLongitude{lon_delta}),
+            input_coordinate.lon + toFixed(FloatLongitude{lon_delta}),
+            input_coordinate.lat - toFixed(FloatLatitude{lat_delta}),
+            input_coordinate.lat + toFixed(FloatLatitude{lat_delta})};
+
+        std::vector<std::pair<double, EdgeDataT>> candidates;
+        for (const auto &edge : SearchInBox(search_rectangle))
+        {
+            const auto distance = coordinate_calculation::perpendicularDistance(
+                m_coordinate_list[edge.u], m_coordinate_list[edge.v], input_coordinate);
+            if (distance <= max_distance)
+            {
+                candidates.emplace_back(distance, edge);
+            }
+        }
+        std::stable_sort(candidates.begin(),
+                         candidates.end(),
+                         [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+
+        std::vector<EdgeDataT> results;
+        results.reserve(candidates.size());
+        for (const auto &candidate : candidates)
+        {
+            results.push_back(candidate.second);
+        }
+        return results;
+    }
+
     // Override filter and terminator for the desired behaviour.
     std::vector<EdgeDataT> Nearest(const Coordinate input_coordinate,
                                    const std::size_t max_results) const
@@ -0,0 +1,187 @@
+#ifndef OSRM_UTIL_STOP_GRID_HPP
+#define OSRM_UTIL_STOP_GRID_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+
+// Straight-line miles between two lat/lon pairs on the flat metric the scheduler compares stops by
+inline double planarMiles(double lat, double lon, double lat2, double lon2)
+{
+    double dist = ((lat - lat2) * (lat - lat2) + (lon - lon2) * (lon - lon2));
+    return std::sqrt(dist) * 3959.0 * 3.1415 / 180;
+}
+
+const double PLANAR_MILES_PER_DEGREE = 3959.0 * 3.1415 / 180;
+
+/**
+ * Uniform grid over the coordinates of up to Capacity stop ids.
+ *
+ * Every id is linked into the list of the bucket its grid cell hashes onto, so radius and
+ * k-nearest queries only visit the cells around the query point. The grid is plain arrays of
+ * indices and can be placed in shared memory; callers serialise access to it.
+ */
+template <int Buckets, int Capacity> class StopGrid
+{
+    static_assert(Buckets > 0 && (Buckets & (Buckets - 1)) == 0, "Buckets must be a power of two");
+
+  public:
+    // cell_degrees is the side of a grid cell, max_ring how many cells nearest() walks out
+    StopGrid(double cell_degrees, int max_ring) : cell_degrees(cell_degrees), max_ring(max_ring)
+    {
+        std::fill(head, head + Buckets, -1);
+        for (int id = 0; id < Capacity; id++)
+            entry[id].bucket = -1;
+    }
+
+    bool contains(int id) const { return entry[id].bucket >= 0; }
+
+    // Whether id is in the grid at exactly lat/lon
+    bool containsAt(int id, double lat, double lon) const
+    {
+        return contains(id) && entry[id].coords[0] == lat && entry[id].coords[1] == lon;
+    }
+
+    // Adds id at lat/lon, or moves it there if it is in the grid already
+    void insert(int id, double lat, double lon)
+    {
+        if (containsAt(id, lat, lon))
+            return;
+        remove(id);
+
+        Entry &e = entry[id];
+        e.coords[0] = lat;
+        e.coords[1] = lon;
+        e.cell[0] = cell(lat);
+        e.cell[1] = cell(lon);
+        e.bucket = bucket(e.cell[0], e.cell[1]);
+        e.prev = -1;
+        e.next = head[e.bucket];
+        if (e.next >= 0)
+            entry[e.next].prev = id;
+        head[e.bucket] = id;
+    }
+
+    void remove(int id)
+    {
+        Entry &e = entry[id];
+        if (e.bucket < 0)
+            return;
+        if (e.prev >= 0)
+            entry[e.prev].next = e.next;
+        else
+            head[e.bucket] = e.next;
+        if (e.next >= 0)
+            entry[e.next].prev = e.prev;
+        e.bucket = -1;
+    }
+
+    // Ids within miles of lat/lon, ascending
+    void withinRadius(double lat, double lon, double miles, std::vector<int> &ids) const
+    {
+        ids.clear();
+        const double degrees = miles / PLANAR_MILES_PER_DEGREE + 1e-9;
+        const int low_lat = cell(lat - degrees), high_lat = cell(lat + degrees);
+        const int low_lon = cell(lon - degrees), high_lon = cell(lon + degrees);
+
+        // a radius spanning more cells than there are buckets is cheaper as one pass
+        if (static_cast<double>(high_lat - low_lat + 1) * (high_lon - low_lon + 1) > Buckets)
+        {
+            for (int id = 0; id < Capacity; id++)
+            {
+                const Entry &e = entry[id];
+                if (e.bucket >= 0 && planarMiles(lat, lon, e.coords[0], e.coords[1]) <= miles)
+                    ids.push_back(id);
+            }
+            return;
+        }
+        for (int cell_lat = low_lat; cell_lat <= high_lat; cell_lat++)
+        {
+            for (int cell_lon = low_lon; cell_lon <= high_lon; cell_lon++)
+            {
+                for (int id = head[bucket(cell_lat, cell_lon)]; id >= 0; id = entry[id].next)
+                {
+                    const Entry &e = entry[id];
+                    if (e.cell[0] == cell_lat && e.cell[1] == cell_lon &&
+                        planarMiles(lat, lon, e.coords[0], e.coords[1]) <= miles)
+                        ids.push_back(id);
+                }
+            }
+        }
+        std::sort(ids.begin(), ids.end());
+    }
+
+    // Up to k ids closest to lat/lon, closest first and ties by id. The search walks rings of
+    // cells outwards and stops once no cell left can hold anything closer, or after max_ring.
+    void nearest(double lat, double lon, int k, std::vector<int> &ids) const
+    {
+        ids.clear();
+        if (k <= 0)
+            return;
+        const int center_lat = cell(lat), center_lon = cell(lon);
+        std::vector<std::pair<double, int>> found;
+
+        for (int ring = 0; ring <= max_ring; ring++)
+        {
+            if (static_cast<int>(found.size()) >= k)
+            {
+                std::nth_element(found.begin(), found.begin() + (k - 1), found.end());
+                if (found[k - 1].first <= (ring - 1) * cell_degrees * PLANAR_MILES_PER_DEGREE)
+                    break;
+            }
+            for (int dlat = -ring; dlat <= ring; dlat++)
+            {
+                // inner cells of the ring were visited already, only its border is new
+                const int step = (dlat == -ring || dlat == ring) ? 1 : 2 * ring;
+                for (int dlon = -ring; dlon <= ring; dlon += step)
+                {
+                    const int cell_lat = center_lat + dlat, cell_lon = center_lon + dlon;
+                    for (int id = head[bucket(cell_lat, cell_lon)]; id >= 0; id = entry[id].next)
+                    {
+                        const Entry &e = entry[id];
+                        if (e.cell[0] == cell_lat && e.cell[1] == cell_lon)
+                            found.emplace_back(planarMiles(lat, lon, e.coords[0], e.coords[1]),
+                                               id);
+                    }
+                }
+            }
+        }
+        std::sort(found.begin(), found.end());
+        for (int f = 0; f < static_cast<int>(found.size()) && f < k; f++)
+            ids.push_back(found[f].second);
+    }
+
+  private:
+    struct Entry
+    {
+        double coords[2];
+        int cell[2];
+        int bucket; // -1 while the id is not in the grid
+        int next;
+        int prev;
+    };
+
+    int cell(double degrees) const { return static_cast<int>(std::floor(degrees / cell_degrees)); }
+
+    static int bucket(int cell_lat, int cell_lon)
+    {
+        return static_cast<int>((static_cast<unsigned>(cell_lat) * 73856093u ^
+                                 static_cast<unsigned>(cell_lon) * 19349663u) &
+                                (Buckets - 1));
+    }
+
+    double cell_degrees;
+    int max_ring;
+    int head[Buckets];
+    Entry entry[Capacity];
+};
+} // namespace util
+} // namespace osrm
+
+#endif // OSRM_UTIL_STOP_GRID_HPP
@@ -0,0 +1,251 @@
+#ifndef OSRM_UTIL_WRITE_BEHIND_QUEUE_HPP
+#define OSRM_UTIL_WRITE_BEHIND_QUEUE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+
+/**
+ * Coalescing write-behind buffer in front of a slow row sink such as a database connection.
+ *
+ * Push() keeps the newest row for its key and returns at once. A background thread takes all
+ * pending rows whenever it is idle and hands them to the sink in batches of at most batch_size,
+ * in the order their keys were first pushed. A row pushed again before it was taken replaces the
+ * pending one, so a key that changes many times while the sink is busy is written once. Flush()
+ * waits until everything pushed before it reached the sink; the destructor flushes as well.
+ *
+ * The sink only ever runs on the background thread. A batch it throws on is counted, its message
+ * kept for the owner to report, and its rows go back to the front of the queue to be tried again
+ * after retry_delay, unless a newer row for the same key was pushed meanwhile. A row that failed
+ * attempts times is handed to the abandon callback instead, also on the background thread, so the
+ * owner can write it some other way.
+ */
+template <typename Key, typename Row, typename Hash = std::hash<Key>> class WriteBehindQueue
+{
+  public:
+    using Sink = std::function<void(const std::vector<Row> &)>;
+    using Abandon = std::function<void(const std::vector<Row> &)>;
+
+    WriteBehindQueue(Sink sink,
+                     std::size_t batch_size,
+                     std::size_t attempts = 1,
+                     std::chrono::milliseconds retry_delay = std::chrono::milliseconds(0),
+                     Abandon abandon = nullptr)
+        : sink(std::move(sink)), batch_size(batch_size == 0 ? 1 : batch_size),
+          attempts(attempts == 0 ? 1 : attempts), retry_delay(retry_delay),
+          abandon(std::move(abandon)), worker(&WriteBehindQueue::Run, this)
+    {
+    }
+
+    WriteBehindQueue(const WriteBehindQueue &) = delete;
+    WriteBehindQueue &operator=(const WriteBehindQueue &) = delete;
+
+    ~WriteBehindQueue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    void Push(const Key &key, Row row)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto found = pending_index.find(key);
+            if (found != pending_index.end())
+            {
+                pending[found->second].row = std::move(row);
+                pending[found->second].attempts = 0;
+                ++coalesced;
+            }
+            else
+            {
+                pending_index.emplace(key, pending.size());
+                pending.push_back(Entry{key, std::move(row), 0});
+            }
+        }
+        wake.notify_one();
+    }
+
+    void Flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        drained.wait(lock, [this] { return pending.empty() && !writing; });
+    }
+
+    // Rows handed to the sink, rows replaced before they were written, batches that failed and
+    // rows given to the abandon callback
+    std::size_t Written() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return written;
+    }
+
+    std::size_t Coalesced() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return coalesced;
+    }
+
+    std::size_t Failed() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return failed;
+    }
+
+    std::size_t Abandoned() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return abandoned;
+    }
+
+    std::string LastError() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return last_error;
+    }
+
+  private:
+    struct Entry
+    {
+        Key key;
+        Row row;
+        std::size_t attempts; // failed writes so far
+    };
+
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            wake.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty())
+                return;
+
+            std::vector<Entry> entries;
+            entries.swap(pending);
+            pending_index.clear();
+            writing = true;
+            lock.unlock();
+
+            std::size_t done = 0;
+            std::size_t batches_failed = 0;
+            std::string error;
+            std::vector<Entry> failed_entries;
+            std::vector<Row> batch;
+            for (std::size_t first = 0; first < entries.size(); first += batch_size)
+            {
+                const std::size_t last = std::min(entries.size(), first + batch_size);
+                batch.clear();
+                for (std::size_t index = first; index < last; ++index)
+                    batch.push_back(std::move(entries[index].row));
+                try
+                {
+                    sink(batch);
+                    done += batch.size();
+                }
+                catch (const std::exception &exception)
+                {
+                    ++batches_failed;
+                    error = exception.what();
+                    for (std::size_t index = first; index < last; ++index)
+                    {
+                        entries[index].row = std::move(batch[index - first]);
+                        ++entries[index].attempts;
+                        failed_entries.push_back(std::move(entries[index]));
+                    }
+                }
+            }
+
+            lock.lock();
+            std::vector<Row> given_up;
+            Requeue(failed_entries, given_up);
+            if (!given_up.empty() && abandon)
+            {
+                lock.unlock();
+                abandon(given_up);
+                lock.lock();
+            }
+            written += done;
+            failed += batches_failed;
+            abandoned += given_up.size();
+            if (batches_failed > 0)
+                last_error = error;
+            writing = false;
+            drained.notify_all();
+
+            if (!pending.empty() && batches_failed > 0 && retry_delay.count() > 0)
+                wake.wait_for(lock, retry_delay, [this] { return stopping; });
+        }
+    }
+
+    // Puts failed rows back in front of the pending ones, or into given_up once they are out of
+    // attempts. Rows whose key was pushed again since are dropped, the newer row replaces them.
+    void Requeue(std::vector<Entry> &failed_entries, std::vector<Row> &given_up)
+    {
+        std::vector<Entry> retry;
+        for (auto &entry : failed_entries)
+        {
+            if (pending_index.find(entry.key) != pending_index.end())
+                continue;
+            if (entry.attempts < attempts)
+                retry.push_back(std::move(entry));
+            else
+                given_up.push_back(std::move(entry.row));
+        }
+        if (retry.empty())
+            return;
+
+        retry.insert(retry.end(),
+                     std::make_move_iterator(pending.begin()),
+                     std::make_move_iterator(pending.end()));
+        pending.swap(retry);
+        pending_index.clear();
+        for (std::size_t index = 0; index < pending.size(); ++index)
+            pending_index.emplace(pending[index].key, index);
+    }
+
+    Sink sink;
+    const std::size_t batch_size;
+    const std::size_t attempts;
+    const std::chrono::milliseconds retry_delay;
+    Abandon abandon;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable drained;
+    std::vector<Entry> pending;
+    std::unordered_map<Key, std::size_t, Hash> pending_index;
+    bool writing = false;
+    bool stopping = false;
+    std::size_t written = 0;
+    std::size_t coalesced = 0;
+    std::size_t failed = 0;
+    std::size_t abandoned = 0;
+    std::string last_error;
+
+    // last, so the members above exist before the thread starts
+    std::thread worker;
+};
+} // namespace util
+} // namespace osrm
+
+#endif // OSRM_UTIL_WRITE_BEHIND_QUEUE_HPP
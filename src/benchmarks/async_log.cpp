@@ -0,0 +1,93 @@
+#include "util/async_log.hpp"
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace osrm;
+
+// How the scheduler stamped its log lines before: a formatted string for every line
+std::string stampNow()
+{
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    std::tm utc;
+    char seconds[64];
+    std::strftime(seconds, sizeof(seconds), "%D %T", gmtime_r(&ts.tv_sec, &utc));
+    char stamp[96];
+    std::snprintf(stamp, sizeof(stamp), "%s.%09ld ", seconds, ts.tv_nsec);
+    return stamp;
+}
+
+// Runs body(thread) on the given number of threads and returns the wall time in ms
+template <typename Body> double timeThreads(int threads, Body body)
+{
+    TIMER_START(run);
+    std::vector<std::thread> pool;
+    for (int thread = 0; thread < threads; ++thread)
+        pool.emplace_back(body, thread);
+    for (auto &thread : pool)
+        thread.join();
+    TIMER_STOP(run);
+    return TIMER_MSEC(run);
+}
+
+int main(int argc, char **argv)
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    // lines per thread, about what one slot of the osrm-routed loop writes with DEBUGSTATE on
+    const int lines = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const auto path =
+        (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+
+    for (const int threads : {1, 4})
+    {
+        double direct;
+        {
+            std::ofstream file(path);
+            std::mutex mutex;
+            direct = timeThreads(threads, [&](int thread) {
+                for (int line = 0; line < lines; ++line)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    file << stampNow() << "osrm_routed:'Case 1':updateRequest( " << thread << ", "
+                         << line << ", 'TIME' );" << std::endl;
+                }
+            });
+        }
+
+        double queued;
+        double written;
+        std::size_t waits;
+        {
+            util::AsyncLog log;
+            log.Open(path, std::ios_base::out | std::ios_base::trunc);
+            queued = timeThreads(threads, [&](int thread) {
+                for (int line = 0; line < lines; ++line)
+                    util::AsyncLogLine(log) << "osrm_routed:'Case 1':updateRequest( " << thread
+                                            << ", " << line << ", 'TIME' );" << std::endl;
+            });
+            TIMER_START(flush);
+            log.Flush();
+            TIMER_STOP(flush);
+            written = queued + TIMER_MSEC(flush);
+            waits = log.Waits();
+        }
+
+        util::Log() << threads << " thread(s), " << lines << " lines each: ofstream " << direct
+                    << " ms, async " << queued << " ms on the callers (" << written
+                    << " ms until written, " << waits << " waits for a full ring)";
+    }
+
+    boost::filesystem::remove(path);
+}
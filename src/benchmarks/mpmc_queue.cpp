@@ -0,0 +1,112 @@
+#include "util/bounded_mpmc_queue.hpp"
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace osrm;
+
+// Mirrors the osrm request table: slot indices circulate between a free list and a
+// pending FIFO that both live in one shared memory segment.
+constexpr std::size_t QUEUE_CAPACITY = 8192;
+constexpr int NUM_SLOTS = 5000;
+using SlotQueue = util::BoundedMPMCQueue<int, QUEUE_CAPACITY>;
+
+struct SharedQueues
+{
+    SharedQueues()
+    {
+        for (int slot = 0; slot < NUM_SLOTS; ++slot)
+            free_slots.TryPush(slot);
+    }
+
+    SlotQueue free_slots;
+    SlotQueue pending;
+};
+
+struct Measurement
+{
+    double total_ms;
+    double ops_per_ms;
+};
+
+// Each producer claims a free slot and submits it, each consumer takes submitted slots
+// in FIFO order and releases them again.
+Measurement measure(SharedQueues &queues, int num_producers, int num_consumers, int num_requests)
+{
+    std::atomic<int> consumed{0};
+    const int requests_per_producer = num_requests / num_producers;
+    const int total_requests = requests_per_producer * num_producers;
+
+    TIMER_START(run);
+    std::vector<std::thread> threads;
+    for (int producer = 0; producer < num_producers; ++producer)
+    {
+        threads.emplace_back([&] {
+            int slot;
+            for (int request = 0; request < requests_per_producer; ++request)
+            {
+                while (!queues.free_slots.TryPop(slot))
+                    std::this_thread::yield();
+                while (!queues.pending.TryPush(slot))
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for (int consumer = 0; consumer < num_consumers; ++consumer)
+    {
+        threads.emplace_back([&] {
+            int slot;
+            while (consumed.load(std::memory_order_relaxed) < total_requests)
+            {
+                if (!queues.pending.TryPop(slot))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                consumed.fetch_add(1, std::memory_order_relaxed);
+                while (!queues.free_slots.TryPush(slot))
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    TIMER_STOP(run);
+
+    return Measurement{TIMER_MSEC(run), total_requests / TIMER_MSEC(run)};
+}
+
+int main(int argc, char **argv)
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    const int num_requests = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    const std::string segment_name = "osrm-mpmc-queue-bench";
+
+    namespace bip = boost::interprocess;
+    bip::shared_memory_object::remove(segment_name.c_str());
+    bip::managed_shared_memory segment(
+        bip::create_only, segment_name.c_str(), sizeof(SharedQueues) + 65536);
+    auto *queues = segment.construct<SharedQueues>("SharedQueues")();
+
+    const std::vector<std::pair<int, int>> configurations = {
+        {1, 1}, {2, 1}, {4, 1}, {8, 1}, {4, 2}, {4, 4}, {8, 4}, {8, 8}};
+    for (const auto &configuration : configurations)
+    {
+        const auto result =
+            measure(*queues, configuration.first, configuration.second, num_requests);
+        util::Log() << configuration.first << " producers, " << configuration.second
+                    << " consumers: " << result.total_ms << " ms, " << result.ops_per_ms
+                    << " requests/ms";
+    }
+
+    segment.destroy<SharedQueues>("SharedQueues");
+    bip::shared_memory_object::remove(segment_name.c_str());
+}
@@ -0,0 +1,100 @@
+#include "util/log.hpp"
+#include "util/permutation_sort.hpp"
+#include "util/timing_util.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace osrm;
+
+#ifdef _WIN32
+#pragma optimize("", off)
+template <class T> void dont_optimize_away(T &&datum) { T local = datum; }
+#pragma optimize("", on)
+#else
+template <class T> void dont_optimize_away(T &&datum) { asm volatile("" : "+r"(datum)); }
+#endif
+
+// The exchange sort calculator.h used for its candidate lists (bubbleSort_twoarray)
+void bubbleSortTwoArrays(double dist[], int tripidxes[], int count)
+{
+    for (int i = 0; i < count - 1; i++)
+        for (int j = 0; j < count - i - 1; j++)
+            if (dist[j] > dist[j + 1])
+            {
+                std::swap(dist[j], dist[j + 1]);
+                std::swap(tripidxes[j], tripidxes[j + 1]);
+            }
+}
+
+struct Candidates
+{
+    std::vector<double> deviation;
+    std::vector<int> tripidxes;
+};
+
+Candidates makeCandidates(int count, std::mt19937 &generator)
+{
+    // deviations are whole minutes in FindBest, so there are plenty of ties
+    std::uniform_int_distribution<int> minutes(0, 120);
+    Candidates candidates;
+    for (int index = 0; index < count; ++index)
+    {
+        candidates.deviation.push_back(minutes(generator));
+        candidates.tripidxes.push_back(2 * index + 1);
+    }
+    return candidates;
+}
+
+int main(int argc, char **argv)
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    const int num_rounds = argc > 1 ? std::atoi(argv[1]) : 20;
+    std::mt19937 generator(1337);
+
+    for (const int count : {16, 128, 1024, 5000})
+    {
+        std::vector<Candidates> inputs;
+        for (int round = 0; round < num_rounds; ++round)
+            inputs.push_back(makeCandidates(count, generator));
+
+        auto bubble_inputs = inputs;
+        TIMER_START(bubble);
+        for (auto &candidates : bubble_inputs)
+            bubbleSortTwoArrays(
+                candidates.deviation.data(), candidates.tripidxes.data(), count);
+        TIMER_STOP(bubble);
+
+        auto sort_inputs = inputs;
+        TIMER_START(sort);
+        for (auto &candidates : sort_inputs)
+            util::sortParallel(0,
+                               count,
+                               util::ascending(candidates.deviation.data()),
+                               candidates.deviation.data(),
+                               candidates.tripidxes.data());
+        TIMER_STOP(sort);
+
+        int best = 0;
+        TIMER_START(top);
+        for (auto &candidates : inputs)
+            best += candidates.tripidxes[util::topPositions(
+                0, count, 1, util::ascending(candidates.deviation.data()))[0]];
+        TIMER_STOP(top);
+        dont_optimize_away(best);
+
+        bool same = true;
+        for (int round = 0; round < num_rounds; ++round)
+            same = same && bubble_inputs[round].tripidxes == sort_inputs[round].tripidxes;
+
+        util::Log() << count << " candidates: bubble sort " << TIMER_MSEC(bubble) / num_rounds
+                    << " ms, permutation sort " << TIMER_MSEC(sort) / num_rounds
+                    << " ms, top-1 selection " << TIMER_MSEC(top) / num_rounds << " ms"
+                    << (same ? "" : " (orders differ!)");
+    }
+}
@@ -0,0 +1,104 @@
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+#include "util/write_behind_queue.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace osrm;
+
+// One stop update as the scheduler writes it back after recalculating a route
+struct StopRow
+{
+    int tripidx;
+    int eta;
+    int etd;
+};
+
+// Stand-in for the database: every round trip appends its rows and syncs them to disk, the way
+// a commit waits for the redo log
+class FileSink
+{
+  public:
+    explicit FileSink(const std::string &path) : file(std::fopen(path.c_str(), "w")) {}
+    ~FileSink() { std::fclose(file); }
+
+    void Write(const std::vector<StopRow> &rows)
+    {
+        for (const auto &row : rows)
+            std::fprintf(file,
+                         "UPDATE itms_trips set pu_eta = %d, pu_etd = %d where tripid = '%d';\n",
+                         row.eta,
+                         row.etd,
+                         row.tripidx);
+        std::fflush(file);
+        fsync(fileno(file));
+    }
+
+  private:
+    std::FILE *file;
+};
+
+int main(int argc, char **argv)
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    // routes of a day, stops per route and how often each route is recalculated in a run
+    const int routes = argc > 1 ? std::atoi(argv[1]) : 40;
+    const int stops = 30;
+    const int passes = 5;
+    const auto path =
+        (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+
+    std::size_t round_trips = 0;
+    {
+        FileSink sink(path);
+        TIMER_START(direct);
+        for (int pass = 0; pass < passes; ++pass)
+            for (int route = 0; route < routes; ++route)
+                for (int stop = 0; stop < stops; ++stop)
+                {
+                    sink.Write({StopRow{route * stops + stop, pass, pass + 1}});
+                    ++round_trips;
+                }
+        TIMER_STOP(direct);
+        util::Log() << "one statement per stop: " << TIMER_MSEC(direct) << " ms on the scheduler, "
+                    << round_trips << " round trips";
+    }
+
+    for (const std::size_t batch_size : {stops, 500})
+    {
+        FileSink sink(path);
+        round_trips = 0;
+        util::WriteBehindQueue<int, StopRow> queue(
+            [&](const std::vector<StopRow> &rows) {
+                sink.Write(rows);
+                ++round_trips;
+            },
+            batch_size);
+
+        TIMER_START(queued);
+        for (int pass = 0; pass < passes; ++pass)
+            for (int route = 0; route < routes; ++route)
+                for (int stop = 0; stop < stops; ++stop)
+                    queue.Push(route * stops + stop, StopRow{route * stops + stop, pass, pass + 1});
+        TIMER_STOP(queued);
+        TIMER_START(flushed);
+        queue.Flush();
+        TIMER_STOP(flushed);
+
+        util::Log() << "write-behind, " << batch_size << " rows per batch: "
+                    << TIMER_MSEC(queued) << " ms on the scheduler, "
+                    << TIMER_MSEC(queued) + TIMER_MSEC(flushed) << " ms until written, "
+                    << queue.Written() << " rows in " << round_trips << " round trips, "
+                    << queue.Coalesced() << " updates coalesced";
+    }
+
+    boost::filesystem::remove(path);
+}
@@ -2,6 +2,7 @@
 
 #include "customizer/cell_customizer.hpp"
 #include "customizer/customizer.hpp"
+#include "customizer/departure_metric.hpp"
 #include "customizer/edge_based_graph.hpp"
 #include "customizer/files.hpp"
 
@@ -76,6 +77,21 @@ void printUnreachableStatistics(const Partition &partition,
     }
 }
 
+auto BuildEdgeExpandedGraph(const partitioner::MultiLevelPartition &mlp,
+                            const EdgeID num_nodes,
+                            const std::vector<extractor::EdgeBasedEdge> &edge_based_edge_list)
+{
+    auto directed = partitioner::splitBidirectionalEdges(edge_based_edge_list);
+
+    auto tidied = partitioner::prepareEdgesForUsageInGraph<
+        typename partitioner::MultiLevelEdgeBasedGraph::InputEdge>(std::move(directed));
+
+    auto edge_based_graph =
+        partitioner::MultiLevelEdgeBasedGraph(mlp, num_nodes, std::move(tidied));
+
+    return edge_based_graph;
+}
+
 auto LoadAndUpdateEdgeExpandedGraph(const CustomizationConfig &config,
                                     const partitioner::MultiLevelPartition &mlp,
                                     std::vector<EdgeWeight> &node_weights,
@@ -91,15 +107,42 @@ auto LoadAndUpdateEdgeExpandedGraph(const CustomizationConfig &config,
 
     extractor::files::readEdgeBasedNodeDistances(config.GetPath(".osrm.enw"), node_distances);
 
-    auto directed = partitioner::splitBidirectionalEdges(edge_based_edge_list);
-
-    auto tidied = partitioner::prepareEdgesForUsageInGraph<
-        typename partitioner::MultiLevelEdgeBasedGraph::InputEdge>(std::move(directed));
+    return BuildEdgeExpandedGraph(mlp, num_nodes, edge_based_edge_list);
+}
 
-    auto edge_based_graph =
-        partitioner::MultiLevelEdgeBasedGraph(mlp, num_nodes, std::move(tidied));
+// The base update only writes the segment geometry and the turn penalties back, the edge-based
+// graph and the node weights are read from the original files again. So the departure graph is
+// updated with all the base files plus the speed files of its range, which come last and win.
+auto LoadAndUpdateDepartureGraph(const CustomizationConfig &config,
+                                 const CustomizationConfig::DepartureBucket &bucket,
+                                 const partitioner::MultiLevelPartition &mlp,
+                                 DepartureMetric &departure_metric,
+                                 std::uint32_t &connectivity_checksum)
+{
+    auto updater_config = config.updater_config;
+    updater_config.segment_speed_lookup_paths.insert(
+        updater_config.segment_speed_lookup_paths.end(),
+        bucket.segment_speed_lookup_paths.begin(),
+        bucket.segment_speed_lookup_paths.end());
+    updater::Updater updater(updater_config);
 
-    return edge_based_graph;
+    std::vector<extractor::EdgeBasedEdge> edge_based_edge_list;
+    extractor::SegmentDataContainer segment_data;
+    EdgeID num_nodes = updater.LoadAndUpdateEdgeExpandedGraph(edge_based_edge_list,
+                                                              departure_metric.node_weights,
+                                                              departure_metric.node_durations,
+                                                              segment_data,
+                                                              connectivity_checksum);
+    std::for_each(departure_metric.node_weights.begin(),
+                  departure_metric.node_weights.end(),
+                  [](auto &w) { w &= 0x7fffffff; });
+
+    departure_metric.forward_weights = segment_data.GetForwardWeightVector();
+    departure_metric.reverse_weights = segment_data.GetReverseWeightVector();
+    departure_metric.forward_durations = segment_data.GetForwardDurationVector();
+    departure_metric.reverse_durations = segment_data.GetReverseDurationVector();
+
+    return BuildEdgeExpandedGraph(mlp, num_nodes, edge_based_edge_list);
 }
 
 std::vector<CellMetric> customizeFilteredMetrics(const partitioner::MultiLevelEdgeBasedGraph &graph,
@@ -170,11 +213,33 @@ int Customizer::Run(const CustomizationConfig &config)
         printUnreachableStatistics(mlp, storage, metric);
     }
 
-    TIMER_START(writing_mld_data);
     std::unordered_map<std::string, std::vector<CellMetric>> metric_exclude_classes = {
         {properties.GetWeightName(), std::move(metrics)},
     };
-    files::writeCellMetrics(config.GetPath(".osrm.cell_metrics"), metric_exclude_classes);
+    std::unordered_map<std::string, DepartureMetric> departure_metrics;
+    for (const auto &bucket : config.departure_buckets)
+    {
+        TIMER_START(departure_customize);
+        const auto name = departureMetricName(properties.GetWeightName(), bucket.range);
+        DepartureMetric departure_metric;
+        std::uint32_t departure_connectivity_checksum = 0;
+        auto departure_graph = LoadAndUpdateDepartureGraph(
+            config, bucket, mlp, departure_metric, departure_connectivity_checksum);
+        BOOST_ASSERT(departure_connectivity_checksum == connectivity_checksum);
+        BOOST_ASSERT(departure_graph.GetNumberOfNodes() == graph.GetNumberOfNodes());
+
+        metric_exclude_classes[name] =
+            customizeFilteredMetrics(departure_graph, storage, CellCustomizer{mlp}, filter);
+        departure_metrics[name] = std::move(departure_metric);
+        TIMER_STOP(departure_customize);
+        util::Log() << "Customizing departures " << bucket.range.begin << "-"
+                    << bucket.range.end << " took " << TIMER_SEC(departure_customize)
+                    << " seconds";
+    }
+
+    TIMER_START(writing_mld_data);
+    files::writeCellMetrics(
+        config.GetPath(".osrm.cell_metrics"), metric_exclude_classes, departure_metrics);
     TIMER_STOP(writing_mld_data);
     util::Log() << "MLD customization writing took " << TIMER_SEC(writing_mld_data) << " seconds";
 
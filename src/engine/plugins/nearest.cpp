@@ -2,10 +2,17 @@
 #include "engine/api/nearest_api.hpp"
 #include "engine/api/nearest_parameters.hpp"
 #include "engine/phantom_node.hpp"
+#include "util/coordinate_calculation.hpp"
 #include "util/integer_range.hpp"
+#include "util/std_hash.hpp"
 
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <boost/assert.hpp>
 #include <boost/numeric/conversion/cast.hpp>
@@ -17,6 +24,60 @@ namespace engine
 namespace plugins
 {
 
+namespace
+{
+// OSM node pairs of all segments within radius, closest first. Parallel segments between the
+// same nodes are reported once. With a spacing only the closest segment whose midpoint falls
+// into each spacing x spacing meters cell around the input coordinate is kept.
+std::vector<std::pair<std::uint64_t, std::uint64_t>>
+getEdgesInRadius(const datafacade::BaseDataFacade &facade,
+                 const util::Coordinate input_coordinate,
+                 const double radius,
+                 const double spacing)
+{
+    const auto segments = facade.GetEdgesInRange(input_coordinate, radius);
+
+    // meters per fixed coordinate unit, equirectangular around the input coordinate
+    const double lat_scale = util::coordinate_calculation::detail::EARTH_RADIUS *
+                             util::coordinate_calculation::detail::DEGREE_TO_RAD /
+                             COORDINATE_PRECISION;
+    const double lon_scale =
+        lat_scale * std::cos(static_cast<double>(util::toFloating(input_coordinate.lat)) *
+                             util::coordinate_calculation::detail::DEGREE_TO_RAD);
+
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> edges;
+    std::unordered_set<std::pair<std::uint64_t, std::uint64_t>> seen_edges;
+    std::unordered_set<std::pair<std::int64_t, std::int64_t>> used_cells;
+    edges.reserve(segments.size());
+    for (const auto &segment : segments)
+    {
+        const std::pair<std::uint64_t, std::uint64_t> edge{
+            static_cast<std::uint64_t>(facade.GetOSMNodeIDOfNode(segment.u)),
+            static_cast<std::uint64_t>(facade.GetOSMNodeIDOfNode(segment.v))};
+        if (!seen_edges.insert(edge).second)
+            continue;
+
+        if (spacing > 0)
+        {
+            const auto midpoint = util::coordinate_calculation::centroid(
+                facade.GetCoordinateOfNode(segment.u), facade.GetCoordinateOfNode(segment.v));
+            const std::pair<std::int64_t, std::int64_t> cell{
+                static_cast<std::int64_t>(std::floor(
+                    static_cast<std::int32_t>(midpoint.lon - input_coordinate.lon) * lon_scale /
+                    spacing)),
+                static_cast<std::int64_t>(std::floor(
+                    static_cast<std::int32_t>(midpoint.lat - input_coordinate.lat) * lat_scale /
+                    spacing))};
+            if (!used_cells.insert(cell).second)
+                continue;
+        }
+
+        edges.push_back(edge);
+    }
+    return edges;
+}
+} // namespace
+
 NearestPlugin::NearestPlugin(const int max_results_) : max_results{max_results_} {}
 
 Status NearestPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
@@ -47,6 +108,26 @@ Status NearestPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms
         return Error("InvalidOptions", "Only one input coordinate is supported", result);
     }
 
+    if (params.edges_in_radius)
+    {
+        if (params.radiuses.size() != 1 || !params.radiuses.front())
+        {
+            return Error("InvalidOptions", "Edges in radius require a radius", result);
+        }
+        if (result.is<flatbuffers::FlatBufferBuilder>())
+        {
+            return Error(
+                "NotImplemented", "Edges in radius are only available as JSON or typed", result);
+        }
+
+        const auto edges = getEdgesInRadius(
+            facade, params.coordinates.front(), *params.radiuses.front(), params.spacing);
+
+        api::NearestAPI nearest_api(facade, params);
+        nearest_api.MakeResponse(edges, result);
+        return Status::Ok;
+    }
+
     auto phantom_nodes = GetPhantomNodes(facade, params, params.number_of_results);
 
     if (phantom_nodes.front().size() == 0)
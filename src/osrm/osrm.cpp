@@ -69,6 +69,14 @@ Status OSRM::Route(const RouteParameters &params, engine::api::ResultT &result)
     return engine_->Route(params, result);
 }
 
+Status OSRM::Route(const RouteParameters &params, RouteResult &typed_result) const
+{
+    osrm::engine::api::ResultT result = RouteResult();
+    auto status = engine_->Route(params, result);
+    typed_result = std::move(result.get<RouteResult>());
+    return status;
+}
+
 Status OSRM::Table(const engine::api::TableParameters &params, json::Object &json_result) const
 {
     osrm::engine::api::ResultT result = json::Object();
@@ -82,6 +90,14 @@ Status OSRM::Table(const TableParameters &params, engine::api::ResultT &result)
     return engine_->Table(params, result);
 }
 
+Status OSRM::Table(const TableParameters &params, TableResult &typed_result) const
+{
+    osrm::engine::api::ResultT result = TableResult();
+    auto status = engine_->Table(params, result);
+    typed_result = std::move(result.get<TableResult>());
+    return status;
+}
+
 Status OSRM::Nearest(const engine::api::NearestParameters &params, json::Object &json_result) const
 {
     osrm::engine::api::ResultT result = json::Object();
@@ -95,6 +111,14 @@ Status OSRM::Nearest(const NearestParameters &params, engine::api::ResultT &resu
     return engine_->Nearest(params, result);
 }
 
+Status OSRM::Nearest(const NearestParameters &params, NearestResult &typed_result) const
+{
+    osrm::engine::api::ResultT result = NearestResult();
+    auto status = engine_->Nearest(params, result);
+    typed_result = std::move(result.get<NearestResult>());
+    return status;
+}
+
 Status OSRM::Trip(const engine::api::TripParameters &params, json::Object &json_result) const
 {
     osrm::engine::api::ResultT result = json::Object();
@@ -565,7 +565,24 @@ void Storage::PopulateUpdatableData(const SharedDataIndex &index)
         std::unordered_map<std::string, std::vector<customizer::CellMetricView>> metrics = {
             {metric_name, std::move(exclude_metrics)},
         };
+
+        // metrics customized per departure range, see customizer::departureMetricName
+        std::unordered_map<std::string, customizer::DepartureMetricView> departure_metrics;
+        std::vector<std::string> departure_prefixes;
+        index.List("/mld/metrics/" + metric_name + "/departure/",
+                   std::back_inserter(departure_prefixes));
+        for (const auto &prefix : departure_prefixes)
+        {
+            const auto departure_metric_name = prefix.substr(std::string("/mld/metrics/").size());
+            metrics.emplace(departure_metric_name, make_cell_metric_view(index, prefix));
+            departure_metrics.emplace(
+                departure_metric_name,
+                make_departure_metric_view(index, prefix, "/common/segment_data"));
+        }
+
         customizer::files::readCellMetrics(config.GetPath(".osrm.cell_metrics"), metrics);
+        customizer::files::readDepartureMetrics(config.GetPath(".osrm.cell_metrics"),
+                                                departure_metrics);
     }
 
     if (boost::filesystem::exists(config.GetPath(".osrm.mldgr")))
@@ -8,8 +8,13 @@
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
+#include <iterator>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace osrm;
 
@@ -20,11 +25,78 @@ enum class return_code : unsigned
     exit
 };
 
+// "07:00-09:30=peak.csv" into the departure range and the speed file for it
+bool parseDepartureSpeedFile(const std::string &value,
+                             customizer::DepartureRange &range,
+                             std::string &path)
+{
+    unsigned begin_hours, begin_minutes, end_hours, end_minutes;
+    int consumed = 0;
+    if (std::sscanf(value.c_str(),
+                    "%2u:%2u-%2u:%2u=%n",
+                    &begin_hours,
+                    &begin_minutes,
+                    &end_hours,
+                    &end_minutes,
+                    &consumed) != 4 ||
+        consumed == 0 || static_cast<std::size_t>(consumed) == value.size() ||
+        begin_minutes > 59 || end_minutes > 59)
+    {
+        return false;
+    }
+
+    range = {begin_hours * 60 + begin_minutes, end_hours * 60 + end_minutes};
+    path = value.substr(consumed);
+    return range.IsValid();
+}
+
+// Groups the speed files by departure range, a range may be given several times
+bool parseDepartureBuckets(const std::vector<std::string> &departure_speed_files,
+                           customizer::CustomizationConfig &customization_config)
+{
+    auto &buckets = customization_config.departure_buckets;
+    for (const auto &value : departure_speed_files)
+    {
+        customizer::DepartureRange range;
+        std::string path;
+        if (!parseDepartureSpeedFile(value, range, path))
+        {
+            util::Log(logERROR) << "Invalid departure speed file " << value
+                                << ", expected HH:MM-HH:MM=file within one day";
+            return false;
+        }
+
+        auto bucket = std::find_if(buckets.begin(), buckets.end(), [&](const auto &bucket) {
+            return bucket.range.begin == range.begin && bucket.range.end == range.end;
+        });
+        if (bucket == buckets.end())
+        {
+            const auto overlapping =
+                std::find_if(buckets.begin(), buckets.end(), [&](const auto &bucket) {
+                    return bucket.range.Overlaps(range);
+                });
+            if (overlapping != buckets.end())
+            {
+                util::Log(logERROR) << "Departure speed file " << value
+                                    << " overlaps another departure range";
+                return false;
+            }
+            buckets.push_back({range, {}});
+            bucket = std::prev(buckets.end());
+        }
+        bucket->segment_speed_lookup_paths.push_back(path);
+    }
+
+    return true;
+}
+
 return_code parseArguments(int argc,
                            char *argv[],
                            std::string &verbosity,
                            customizer::CustomizationConfig &customization_config)
 {
+    std::vector<std::string> departure_speed_files;
+
     // declare a group of options that will be allowed only on command line
     boost::program_options::options_description generic_options("Options");
     generic_options.add_options()("version,v", "Show version")("help,h", "Show this help message")(
@@ -45,6 +117,11 @@ return_code parseArguments(int argc,
                 &customization_config.updater_config.segment_speed_lookup_paths)
                 ->composing(),
             "Lookup files containing nodeA, nodeB, speed data to adjust edge weights")(
+            "departure-speed-file",
+            boost::program_options::value<std::vector<std::string>>(&departure_speed_files)
+                ->composing(),
+            "Lookup file for a range of departure times given as HH:MM-HH:MM=file, applied on "
+            "top of the segment speed files to customize an additional metric for that range")(
             "turn-penalty-file",
             boost::program_options::value<std::vector<std::string>>(
                 &customization_config.updater_config.turn_penalty_lookup_paths)
@@ -122,6 +199,11 @@ return_code parseArguments(int argc,
 
     boost::program_options::notify(option_variables);
 
+    if (!parseDepartureBuckets(departure_speed_files, customization_config))
+    {
+        return return_code::fail;
+    }
+
     if (!option_variables.count("input"))
     {
         std::cout << visible_options;
@@ -1,8 +1,11 @@
 #include "routed.hpp"
 #include "server/server.hpp"
+#include "storage/shared_datatype.hpp"
+#include "storage/shared_monitor.hpp"
 #include "util/exception_utils.hpp"
 #include "util/log.hpp"
 #include "util/meminfo.hpp"
+#include "util/timing_util.hpp"
 #include "util/version.hpp"
 
 //#include "fixture.hpp"
@@ -30,15 +33,20 @@
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
+#include <cmath>
 #include <cstdlib>
 
 #include <signal.h>
 
+#include <algorithm>
 #include <chrono>
+#include <deque>
 #include <exception>
 #include <future>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <string>
 #include <thread>
@@ -138,6 +146,12 @@ inline unsigned generateServerProgramOptions( const int argc,
         ( "shared-memory,s",
           value<bool>( &config.use_shared_memory )->implicit_value( true )->default_value( false ),
           "Load data from shared memory" )    //
+        ( "dataset-name",
+          value<std::string>( &config.dataset_name ),
+          "Name of the shared memory dataset to connect to" )    //
+        ( "mmap,m",
+          value<bool>( &config.use_mmap )->implicit_value( true )->default_value( false ),
+          "Map datafiles directly, do not use any additional memory." )    //
         ( "algorithm,a",
           value<EngineConfig::Algorithm>( &config.algorithm )
           ->default_value( EngineConfig::Algorithm::CH, "CH" ),
@@ -222,7 +236,12 @@ inline unsigned generateServerProgramOptions( const int argc,
     }
     else if ( config.use_shared_memory && option_variables.count( "base" ) )
     {
-        util::Log( logWARNING ) << "Shared memory settings conflict with path settings.";
+        // the shm service always gets a base path in argv[ 1 ]; with --shared-memory every client
+        // process attaches to the one osrm-datastore dataset instead of loading its own copy
+        util::Log( logWARNING ) << "Shared memory settings conflict with path settings, "
+                                << base_path.string() << " is not loaded.";
+        base_path.clear();
+        return INIT_OK_START_ENGINE;
     }
 
     // Adjust number of threads to hardware concurrency
@@ -325,42 +344,9 @@ return 0;
 
 }*/
 
-string routedDIST( double lat1, double lon1, double lat2, double lon2, const char * argv )
+string routedDIST( double lat1, double lon1, double lat2, double lon2, const OSRM &osrm )
 {
 
-    util::LogPolicy::GetInstance().Unmute();
-
-
-
-
-
-
-    EngineConfig config;
-    boost::filesystem::path base_path;
-    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
-
-    config.storage_config =
-    {
-        argv
-    };
-
-    // We support two routing speed up techniques:
-    // - Contraction Hierarchies (CH): requires extract+contract pre-processing
-    // - Multi-Level Dijkstra (MLD): requires extract+partition+customize pre-processing
-    //
-    config.algorithm = EngineConfig::Algorithm::CH;
-    // config.algorithm = EngineConfig::Algorithm::MLD;
-
-    // Routing machine with several services (such as Route, Table, Nearest, Trip, Match)
-    const OSRM osrm
-    {
-        config
-    };
-
-    /* if (config.use_shared_memory)
-     {
-         util::Log() << "Loading from shared memory";
-     }*/
 
 
     string osrmnodes;
@@ -375,10 +361,9 @@ string routedDIST( double lat1, double lon1, double lat2, double lon2, const cha
 
         RouteParameters params;
 
-        json::Object result;
+        RouteResult result;
 
 
-        params.annotations_type = RouteParameters::AnnotationsType::Nodes;
         params.coordinates.push_back(
                                      {
                                          util::FloatLongitude
@@ -402,8 +387,6 @@ string routedDIST( double lat1, double lon1, double lat2, double lon2, const cha
                                      }
                                      );
 
-        params.overview = RouteParameters::OverviewType::Simplified;
-        params.steps = true;
         params.continue_straight = false;
         // cout << "In routed: " << lon1 <<"," << lat1 << " 2: "<< lon2 <<"," << lat2 << endl;
         osrm.Route( params, result );
@@ -417,11 +400,9 @@ string routedDIST( double lat1, double lon1, double lat2, double lon2, const cha
 
         try
         {
-            const auto &routes = result.values[ "routes" ].get<json::Array>().values;
-            auto &routes2 = result.values[ "routes" ].get<json::Array>();
-            auto &route = routes2.values.at( 0 ).get<json::Object>();
-            distance = route.values[ "distance" ].get<json::Number>().value;
-            time1 = route.values[ "duration" ].get<json::Number>().value;
+            const auto &route = result.routes.at( 0 );
+            distance = route.distance;
+            time1 = route.duration;
             distance = distance * ( 1 / 1609.34 );
 
             // cout << "finished nodes: " << lon1 <<"," << lat1 << " 2: "<< lon2 <<"," << lat2 << endl;
@@ -461,42 +442,9 @@ string routedDIST( double lat1, double lon1, double lat2, double lon2, const cha
 }
 
 
-string table( double lat1, double lon1, double lat2, double lon2, const char * argv )
+string table( double lat1, double lon1, double lat2, double lon2, const OSRM &osrm )
 {
 
-    util::LogPolicy::GetInstance().Unmute();
-
-
-
-
-
-
-    EngineConfig config;
-    boost::filesystem::path base_path;
-    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
-
-    config.storage_config =
-    {
-        argv
-    };
-
-    // We support two routing speed up techniques:
-    // - Contraction Hierarchies (CH): requires extract+contract pre-processing
-    // - Multi-Level Dijkstra (MLD): requires extract+partition+customize pre-processing
-    //
-    config.algorithm = EngineConfig::Algorithm::CH;
-    // config.algorithm = EngineConfig::Algorithm::MLD;
-
-    // Routing machine with several services (such as Route, Table, Nearest, Trip, Match)
-    const OSRM osrm
-    {
-        config
-    };
-
-    /* if (config.use_shared_memory)
-     {
-         util::Log() << "Loading from shared memory";
-     }*/
     string time1 = "0";
     {
 
@@ -505,7 +453,7 @@ string table( double lat1, double lon1, double lat2, double lon2, const char * a
         TableParameters params;
 
 
-        json::Object result;
+        TableResult result;
 
 
         //params.annotations_type = RouteParameters::AnnotationsType::Nodes;
@@ -549,10 +497,10 @@ string table( double lat1, double lon1, double lat2, double lon2, const char * a
         try
         {
 
-            const auto code = result.values.at( "code" ).get<json::String>().value;
-            const auto &durations_array = result.values.at( "durations" ).get<json::Array>().values;
-            const auto durations_matrix = durations_array[ 0 ].get<json::Array>().values;
-            time1 = to_string( ( int )ceil( ( ceil( durations_matrix[ 0 ].get<json::Number>().value ) / 60 ) )    /*in minutes*/ );
+            const double duration = result.durations.at( 0 );
+            if( std::isnan( duration ) )
+                throw std::runtime_error( "unreachable" );
+            time1 = to_string( ( int )ceil( ( ceil( duration ) / 60 ) )    /*in minutes*/ );
 
 
             // cout << "finished nodes: " << lon1 <<"," << lat1 << " 2: "<< lon2 <<"," << lat2 << endl;
@@ -579,47 +527,243 @@ string table( double lat1, double lon1, double lat2, double lon2, const char * a
 }
 
 
-
-string routed( double lat1, double lon1, double lat2, double lon2, const char * argv )
+// Many-to-many version of routedDIST(): every lat1,lon1,lat2,lon2 pair is answered from one
+// Table query over the distinct origins and destinations, split into chunks of at most
+// max_table_size sources/destinations. Results use the same "miles^minutes" format.
+// departures holds the departure minute of every pair, -1 for none; a chunk only takes pairs of
+// one minute, so callers sort the pairs by it. departuremetric tells which answers the engine took
+// from the departure metric of their minute; CH datasets, datasets without departure ranges and
+// minutes outside every range are answered from the base metric.
+vector<string> tableDIST( const vector<std::array<double, 4>> &pairs, const vector<int> &departures, const OSRM &osrm, int max_table_size, vector<bool> &estimated, vector<bool> &departuremetric )
 {
+    vector<string> results( pairs.size() );
+    estimated.assign( pairs.size(), false );
+    departuremetric.assign( pairs.size(), false );
 
-    util::LogPolicy::GetInstance().Unmute();
+    size_t first = 0;
+    while( first < pairs.size() )
+    {
+        TableParameters params;
+        params.annotations = TableParameters::AnnotationsType::Duration | TableParameters::AnnotationsType::Distance;
+        const int departure = departures[ first ];
+        if( departure >= 0 )
+            params.departure_time = departure;
+
+        map<pair<double, double>, size_t> coordinateindex;
+        map<size_t, size_t> sourcerow;
+        map<size_t, size_t> destinationcolumn;
+        vector<pair<size_t, size_t>> cells;
+
+        size_t last = first;
+        for( ;
+             last < pairs.size();
+             last++ )
+        {
+            const pair<double, double> origin( pairs[ last ][ 0 ], pairs[ last ][ 1 ] );
+            const pair<double, double> destination( pairs[ last ][ 2 ], pairs[ last ][ 3 ] );
+            const bool neworigin = coordinateindex.find( origin ) == coordinateindex.end() || sourcerow.find( coordinateindex[ origin ] ) == sourcerow.end();
+            const bool newdestination = coordinateindex.find( destination ) == coordinateindex.end() || destinationcolumn.find( coordinateindex[ destination ] ) == destinationcolumn.end();
+            if( max_table_size > 0 && last > first &&
+                ( params.sources.size() + neworigin > ( size_t )max_table_size || params.destinations.size() + newdestination > ( size_t )max_table_size ) )
+                break;
+            if( departures[ last ] != departure )
+                break;
+
+            for( const auto &coordinate : { origin, destination } )
+            {
+                if( coordinateindex.find( coordinate ) == coordinateindex.end() )
+                {
+                    coordinateindex[ coordinate ] = params.coordinates.size();
+                    params.coordinates.push_back( { util::FloatLongitude{ coordinate.second }, util::FloatLatitude{ coordinate.first } } );
+                }
+            }
+            const size_t originindex = coordinateindex[ origin ];
+            const size_t destinationindex = coordinateindex[ destination ];
+            if( sourcerow.find( originindex ) == sourcerow.end() )
+            {
+                sourcerow[ originindex ] = params.sources.size();
+                params.sources.push_back( originindex );
+            }
+            if( destinationcolumn.find( destinationindex ) == destinationcolumn.end() )
+            {
+                destinationcolumn[ destinationindex ] = params.destinations.size();
+                params.destinations.push_back( destinationindex );
+            }
+            cells.push_back( make_pair( sourcerow[ originindex ], destinationcolumn[ destinationindex ] ) );
+        }
 
+        TableResult result;
+        const auto status = osrm.Table( params, result );
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "tableDIST: " << last - first << " pairs as " << params.sources.size() << "x" << params.destinations.size() << " table" << endl;
 
+        for( size_t k = first;
+             k < last;
+             k++ )
+        {
+            const double lat1 = pairs[ k ][ 0 ], lon1 = pairs[ k ][ 1 ], lat2 = pairs[ k ][ 2 ], lon2 = pairs[ k ][ 3 ];
+            double distance;
+            double time1;
+            try
+            {
+                if( status != Status::Ok )
+                    throw std::runtime_error( "table query failed" );
+                const auto &cell = cells[ k - first ];
+                distance = result.distances.at( cell.first * result.columns + cell.second );
+                time1 = result.durations.at( cell.first * result.columns + cell.second );
+                if( std::isnan( distance ) || std::isnan( time1 ) )
+                    throw std::runtime_error( "unreachable" );
+                distance = distance * ( 1 / 1609.34 );
+                departuremetric[ k ] = result.departure_metric;
+            }
+            catch( ... )
+            {
+                // unreachable pair (NaN cell) or failed query: straight-line miles, as routedDIST()
+                double dist = ( ( lat1 - lat2 ) *( lat1 - lat2 ) + ( lon1 - lon2 ) *( lon1 - lon2 ) ) ;
+                dist = sqrt( dist ) * 3959.0 * 3.1415 / 180;
 
-    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "in routed " << endl;
+                distance = dist;
+                time1 = 0.0;
+                estimated[ k ] = true;
+            }
+            results[ k ] = to_string( ( roundf( distance * 100 ) / 100 ) ) + "^" + to_string( ceil( time1 / 60 ) );
+        }
+
+        first = last;
+    }
 
+    return results;
+
+}
 
-    EngineConfig config;
-    //boost::filesystem::path base_path;
-    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
 
-    config.storage_config =
+// Fills the stop matrix a scheduler prepared in buildStopMatrix(): the unique stops are split into
+// tiles of at most max_table_size sources by max_table_size destinations, and the tiles are spread
+// over one Table query per hardware thread. Cells use the units and rounding of tableDIST().
+void fillStopMatrix( const OSRM &osrm, int max_table_size )
+{
+    attachStopMatrix( true );
+    StopMatrix &matrix = *stop_matrix;
+    if( ( matrix.version.load() & 1 ) == 0 )
     {
-        argv
-    };
-    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Starting 21" << endl;
-    // We support two routing speed up techniques:
-    // - Contraction Hierarchies (CH): requires extract+contract pre-processing
-    // - Multi-Level Dijkstra (MLD): requires extract+partition+customize pre-processing
-    //
-    config.algorithm = EngineConfig::Algorithm::CH;
-    // config.algorithm = EngineConfig::Algorithm::MLD;
-    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Starting 22" << endl;
-    // Routing machine with several services (such as Route, Table, Nearest, Trip, Match)
-    const OSRM osrm
+        gse << "Stop matrix: no build in progress, request ignored" << endl;
+        return;
+    }
+    const int nstops = matrix.nstops;
+    // the cells are only good for the dataset the queries start on
+    const unsigned long long dataset = travelCacheDataset();
+    const int tilesize = max_table_size > 0 ? std::min( max_table_size, STOPMATRIXTILE ) : STOPMATRIXTILE;
+    const int tilesperside = ( nstops + tilesize - 1 ) / tilesize;
+    std::atomic<int> nexttile( 0 );
+
+    auto filltiles = [ & ]
     {
-        config
+        int tile;
+        while( ( tile = nexttile.fetch_add( 1 ) ) < tilesperside * tilesperside )
+        {
+            const int firstsource = ( tile / tilesperside ) * tilesize;
+            const int firstdestination = ( tile % tilesperside ) * tilesize;
+            const int nsources = std::min( tilesize, nstops - firstsource );
+            const int ndestinations = std::min( tilesize, nstops - firstdestination );
+
+            TableParameters params;
+            params.annotations = TableParameters::AnnotationsType::Duration | TableParameters::AnnotationsType::Distance;
+            for( int s = 0;
+                 s < nsources;
+                 s++ )
+            {
+                params.sources.push_back( params.coordinates.size() );
+                params.coordinates.push_back( { util::FloatLongitude{ matrix.coords[ firstsource + s ][ 1 ] }, util::FloatLatitude{ matrix.coords[ firstsource + s ][ 0 ] } } );
+            }
+            for( int d = 0;
+                 d < ndestinations;
+                 d++ )
+            {
+                params.destinations.push_back( params.coordinates.size() );
+                params.coordinates.push_back( { util::FloatLongitude{ matrix.coords[ firstdestination + d ][ 1 ] }, util::FloatLatitude{ matrix.coords[ firstdestination + d ][ 0 ] } } );
+            }
+
+            TableResult result;
+            const auto status = osrm.Table( params, result );
+
+            for( int s = 0;
+                 s < nsources;
+                 s++ )
+            {
+                for( int d = 0;
+                     d < ndestinations;
+                     d++ )
+                {
+                    const double lat1 = matrix.coords[ firstsource + s ][ 0 ], lon1 = matrix.coords[ firstsource + s ][ 1 ];
+                    const double lat2 = matrix.coords[ firstdestination + d ][ 0 ], lon2 = matrix.coords[ firstdestination + d ][ 1 ];
+                    StopMatrixCell &cell = matrix.cell[ firstsource + s ][ firstdestination + d ];
+                    // same stop, or stops close enough to count as one: zero, as in Case 3
+                    if( firstsource + s == firstdestination + d || isSameLocation_onlyLatLong( lat1, lon1, lat2, lon2 ) )
+                    {
+                        cell.distance = 0;
+                        cell.time = 0;
+                        continue;
+                    }
+                    double distance;
+                    double time1;
+                    try
+                    {
+                        if( status != Status::Ok )
+                            throw std::runtime_error( "table query failed" );
+                        distance = result.distances.at( s * result.columns + d );
+                        time1 = result.durations.at( s * result.columns + d );
+                        if( std::isnan( distance ) || std::isnan( time1 ) )
+                            throw std::runtime_error( "unreachable" );
+                        distance = distance * ( 1 / 1609.34 );
+                    }
+                    catch( ... )
+                    {
+                        // unreachable pair or failed query: straight-line miles, as tableDIST(), and a
+                        // negative time so lookups ask for the pair again instead of serving the estimate
+                        double dist = ( ( lat1 - lat2 ) *( lat1 - lat2 ) + ( lon1 - lon2 ) *( lon1 - lon2 ) ) ;
+                        dist = sqrt( dist ) * 3959.0 * 3.1415 / 180;
+
+                        cell.distance = roundf( dist * 100 ) / 100;
+                        cell.time = STOPMATRIXESTIMATE;
+                        continue;
+                    }
+                    cell.distance = roundf( distance * 100 ) / 100;
+                    cell.time = ceil( time1 / 60 );
+                }
+            }
+        }
     };
-    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Starting 3" << endl;
-    /* if (config.use_shared_memory)
-     {
-         util::Log() << "Loading from shared memory";
-     }*/
 
+    TIMER_START( stop_matrix_timer );
+    std::vector<std::thread> threads;
+    const int nthreads = std::max( 1u, std::thread::hardware_concurrency() );
+    for( int t = 1;
+         t < nthreads;
+         t++ )
+    {
+        threads.emplace_back( filltiles );
+    }
+    filltiles();
+    for( auto &thread : threads )
+    {
+        thread.join();
+    }
+    TIMER_STOP( stop_matrix_timer );
+
+    // publish against the dataset this engine serves; invalidateTravelCache() or a new dataset retires it
+    matrix.generation = request_table->travel_cache.generation.load();
+    matrix.dataset = dataset;
+    matrix.version.fetch_add( 1, std::memory_order_release );
+    gse << "Stop matrix: " << nstops << " stops in " << tilesperside * tilesperside << " tiles, " << TIMER_MSEC( stop_matrix_timer ) << " ms" << endl;
+}
+
+
+// Route between two points: the OSM nodes along it go to nodes, the result is "miles^minutes".
+string routed( double lat1, double lon1, double lat2, double lon2, const OSRM &osrm, vector<std::uint64_t> &nodes )
+{
+
+    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "in routed " << endl;
 
     string osrmnodes;
-    string nodestr;
     double distance;    ////// to match values in database
     double time1;
 
@@ -634,7 +778,7 @@ string routed( double lat1, double lon1, double lat2, double lon2, const char *
         RouteParameters params;
 
 
-        json::Object result;
+        RouteResult result;
 
 
         params.annotations_type = RouteParameters::AnnotationsType::Nodes;
@@ -661,8 +805,6 @@ string routed( double lat1, double lon1, double lat2, double lon2, const char *
                                      }
                                      );
 
-        params.overview = RouteParameters::OverviewType::Simplified;
-        params.steps = true;
         params.continue_straight = false;
         // cout << "In routed: " << lon1 <<"," << lat1 << " 2: "<< lon2 <<"," << lat2 << endl;
         if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Starting 2.1" << endl;
@@ -679,50 +821,26 @@ string routed( double lat1, double lon1, double lat2, double lon2, const char *
 
         try
         {
-            const auto &routes = result.values[ "routes" ].get<json::Array>().values;
-            // cout << "got route  1  : " << lon1 <<"," << lat1 << " 2: "<< lon2 <<"," << lat2 << endl;
-            auto &routes2 = result.values[ "routes" ].get<json::Array>();
-            // cout << "got route 2 : " << lon1 <<"," << lat1 << " 2: "<< lon2 <<"," << lat2 << endl;
-            auto &route = routes2.values.at( 0 ).get<json::Object>();
+            const auto &route = result.routes.at( 0 );
             //if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "got route 1 : " << lon1 <<"," << lat1 << " 2: "<< lon2 <<"," << lat2 << endl;
-            distance = route.values[ "distance" ].get<json::Number>().value;
-            time1 = route.values[ "duration" ].get<json::Number>().value;
+            distance = route.distance;
+            time1 = route.duration;
             //if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "got distance: " <<  distance <<  endl;
-            const auto &legs = routes[ 0 ].get<json::Object>().values.at( "legs" ).get<json::Array>().values;
-            const auto &annotation = legs[ 0 ].get<json::Object>().values.at( "annotation" ).get<json::Object>();
-            const auto &nodes = annotation.values.at( "nodes" ).get<json::Array>().values;
-            int length = nodes.size();
+            const auto &annotationnodes = route.legs.at( 0 ).nodes;
+            int length = annotationnodes.size();
 
 
             //if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "node length : " << lon1 <<"," << lat1 << " 2: "<< lon2 <<"," << lat2 << " " << length << endl;
+            nodes.reserve( length );
             for ( int i = 0;
                   i < length;
                   i++ )
             {
-
-
-
-                unsigned long long node = nodes[ i ].get<json::Number>().value;
+                const std::uint64_t node = annotationnodes[ i ];
                 if( node != 0 )
                 {
-                    if ( i + 1 == length )
-                    {
-                        nodestr = to_string( node );
-                        osrmnodes += nodestr;
-                        //cout << nodestr << endl;
-                        // }
-                    }
-                    else
-                    {
-                        nodestr = to_string( node );
-                        osrmnodes += nodestr;
-                        osrmnodes += ",";
-                        //cout << nodestr << endl;
-                        // }
-                    }
-
+                    nodes.push_back( node );
                 }
-
             }
 
 
@@ -754,9 +872,8 @@ string routed( double lat1, double lon1, double lat2, double lon2, const char *
         //cout << "The distance is " << distance << endl;
         string strdist = to_string( ( roundf( distance * 100 ) / 100 ) );
 
-        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Node length " << osrmnodes.length() << endl;
-        osrmnodes.push_back( '^' );
-        osrmnodes = osrmnodes + strdist;
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Node length " << nodes.size() << endl;
+        osrmnodes = strdist;
         osrmnodes.push_back( '^' );
         osrmnodes = osrmnodes + to_string( ceil( time1 / 60 ) );
         // cout << distance << endl;
@@ -771,42 +888,9 @@ string routed( double lat1, double lon1, double lat2, double lon2, const char *
 }
 
 
-string routedStringDistances( string longlat, const char * argv )
+string routedStringDistances( string longlat, const OSRM &osrm )
 {
 
-    util::LogPolicy::GetInstance().Unmute();
-
-
-
-
-
-
-    EngineConfig config;
-    boost::filesystem::path base_path;
-    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
-
-    config.storage_config =
-    {
-        argv
-    };
-
-    // We support two routing speed up techniques:
-    // - Contraction Hierarchies (CH): requires extract+contract pre-processing
-    // - Multi-Level Dijkstra (MLD): requires extract+partition+customize pre-processing
-    //
-    config.algorithm = EngineConfig::Algorithm::CH;
-    // config.algorithm = EngineConfig::Algorithm::MLD;
-
-    // Routing machine with several services (such as Route, Table, Nearest, Trip, Match)
-    const OSRM osrm
-    {
-        config
-    };
-
-    /* if (config.use_shared_memory)
-     {
-         util::Log() << "Loading from shared memory";
-     }*/
 
 
     string osrmnodes;
@@ -820,8 +904,7 @@ string routedStringDistances( string longlat, const char * argv )
 
         RouteParameters params;
 
-        json::Object result;
-        params.annotations_type = RouteParameters::AnnotationsType::Nodes;
+        RouteResult result;
         string temp = longlat;
 
         while( temp != "" )
@@ -846,8 +929,6 @@ string routedStringDistances( string longlat, const char * argv )
 
         }
 
-        params.overview = RouteParameters::OverviewType::Simplified;
-        params.steps = true;
         params.continue_straight = false;
 
         osrm.Route( params, result );
@@ -856,26 +937,15 @@ string routedStringDistances( string longlat, const char * argv )
 
 
 
-        const auto &routes = result.values.at( "routes" ).get<json::Array>().values;
-
-
-
-        for ( const auto &route : routes )
+        for ( const auto &route : result.routes )
         {
-            const auto &route_object = route.get<json::Object>();
-            //const auto distance = route_object.values.at("distance").get<json::Number>().value;
-            //const auto duration = route_object.values.at("duration").get<json::Number>().value;
-            //const auto geometry = route_object.values.at("geometry").get<json::String>().value;
-            const auto &legs = route_object.values.at( "legs" ).get<json::Array>().values;
-
-            for ( const auto &leg : legs )
+            for ( const auto &leg : route.legs )
             {
 
                 osrmnodes = "";
                 try
                 {
-                    const auto &leg_object = leg.get<json::Object>();
-                    double distance = leg_object.values.at( "distance" ).get<json::Number>().value;
+                    double distance = leg.distance;
                     distance = distance * ( 1 / 1609.34 );
                     osrmnodes = to_string( ( roundf( distance * 100 ) / 100 ) );
                 }
@@ -950,46 +1020,14 @@ string routedStringDistances( string longlat, const char * argv )
 
 
 
-string routedString( string longlat, const char * argv )
+// One route through every lon,lat of longlat: the OSM nodes of each leg go to legnodes and the
+// result holds the leg distances in miles, joined by "?".
+string routedString( string longlat, const OSRM &osrm, vector<vector<std::uint64_t>> &legnodes )
 {
 
-    util::LogPolicy::GetInstance().Unmute();
-
-
-
-
-
-
-    EngineConfig config;
-    boost::filesystem::path base_path;
-    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
-
-    config.storage_config =
-    {
-        argv
-    };
-
-    // We support two routing speed up techniques:
-    // - Contraction Hierarchies (CH): requires extract+contract pre-processing
-    // - Multi-Level Dijkstra (MLD): requires extract+partition+customize pre-processing
-    //
-    config.algorithm = EngineConfig::Algorithm::CH;
-    // config.algorithm = EngineConfig::Algorithm::MLD;
-
-    // Routing machine with several services (such as Route, Table, Nearest, Trip, Match)
-    const OSRM osrm
-    {
-        config
-    };
-
-    /* if (config.use_shared_memory)
-     {
-         util::Log() << "Loading from shared memory";
-     }*/
 
 
     string osrmnodes;
-    string nodestr;
     ////// to match values in database
     string finalroute = "";
 
@@ -999,7 +1037,7 @@ string routedString( string longlat, const char * argv )
 
         RouteParameters params;
 
-        json::Object result;
+        RouteResult result;
         params.annotations_type = RouteParameters::AnnotationsType::Nodes;
         string temp = longlat;
 
@@ -1036,56 +1074,19 @@ string routedString( string longlat, const char * argv )
 
 
 
-        const auto &routes = result.values.at( "routes" ).get<json::Array>().values;
-
-
-
-        for ( const auto &route : routes )
+        for ( const auto &route : result.routes )
         {
-            const auto &route_object = route.get<json::Object>();
-            //const auto distance = route_object.values.at("distance").get<json::Number>().value;
-            //const auto duration = route_object.values.at("duration").get<json::Number>().value;
-            //const auto geometry = route_object.values.at("geometry").get<json::String>().value;
-            const auto &legs = route_object.values.at( "legs" ).get<json::Array>().values;
-
-            for ( const auto &leg : legs )
+            for ( const auto &leg : route.legs )
             {
                 osrmnodes = "";
+                legnodes.emplace_back();
                 try
                 {
-                    const auto &leg_object = leg.get<json::Object>();
-                    const auto &annotation = leg_object.values.at( "annotation" ).get<json::Object>();
-                    const auto &nodes = annotation.values.at( "nodes" ).get<json::Array>().values;
-                    double distance = leg_object.values.at( "distance" ).get<json::Number>().value;
-                    int length = nodes.size();
-
-
-
-
-
-                    for ( int i = 0;
-                          i < length;
-                          i++ )
-                    {
-
-                        unsigned long long node = nodes[ i ].get<json::Number>().value;
-
-                        if ( i + 1 == length )
-                        {
-                            nodestr = to_string( node );
-                            distance = distance * ( 1 / 1609.34 );
-                            osrmnodes = osrmnodes + nodestr + "^" + to_string( ( roundf( distance * 100 ) / 100 ) );
-
-                        }
-                        else
-                        {
-                            nodestr = to_string( node );
-                            osrmnodes = osrmnodes + nodestr;
-                            osrmnodes.push_back( ',' );
-                        }
-
+                    double distance = leg.distance;
 
-                    }
+                    legnodes.back() = leg.nodes;
+                    distance = distance * ( 1 / 1609.34 );
+                    osrmnodes = to_string( ( roundf( distance * 100 ) / 100 ) );
 
                 }
 
@@ -1112,7 +1113,8 @@ string routedString( string longlat, const char * argv )
 
 
 
-                    osrmnodes = "^" + to_string( ( roundf( dist * 100 ) / 100 ) );
+                    legnodes.back().clear();
+                    osrmnodes = to_string( ( roundf( dist * 100 ) / 100 ) );
 
 
                     if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "ERROR DISTANCE so using " << dist << endl;
@@ -1150,44 +1152,20 @@ string routedString( string longlat, const char * argv )
 }
 
 
-string near( double lat, double lon, const char * argv, double radius )
-{
-
-    string osrmnodes;
-
-    util::LogPolicy::GetInstance().Unmute();
-
-
-    EngineConfig config;
-    boost::filesystem::path base_path;
-    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
-
-    config.storage_config =
-    {
-        argv
-    };
+// Node pairs of the road segments within radius meters of lat,lon. Above NEARSPACINGRADIUS the
+// engine keeps one segment per cell of a grid that widens with the radius, closest first.
+const double NEARSPACINGRADIUS = 4500;
+const double NEARSPACING = 30;
 
-    // We support two routing speed up techniques:
-    // - Contraction Hierarchies (CH): requires extract+contract pre-processing
-    // - Multi-Level Dijkstra (MLD): requires extract+partition+customize pre-processing
-    //
-    config.algorithm = EngineConfig::Algorithm::CH;
-    // config.algorithm = EngineConfig::Algorithm::MLD;
+vector<std::uint64_t> near( double lat, double lon, const OSRM &osrm, double radius )
+{
 
-    // Routing machine with several services (such as Route, Table, Nearest, Trip, Match)
-    const OSRM osrm
-    {
-        config
-    };
+    vector<std::uint64_t> osrmnodes;
 
-    /*if (config.use_shared_memory)
-    {
-        util::Log() << "Loading from shared memory";
-    }*/
 
     //if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Nearest" <<endl;
     NearestParameters params;
-    params.number_of_results = 27000;
+    params.edges_in_radius = true;
     params.radiuses.push_back( radius );
     params.coordinates.push_back( osrm::util::Coordinate( osrm::util::FloatLongitude
                                                           {
@@ -1197,75 +1175,28 @@ string near( double lat, double lon, const char * argv, double radius )
                                                               lat
                                                           }
                                                           ) );
+    if( radius >= NEARSPACINGRADIUS )
+    {
+        // about one segment in radius/3000 survives, as the old every-mod-th-pair pruning
+        params.spacing = NEARSPACING * sqrt( radius / 3000 );
+    }
 
-    int distance = 0;
-    json::Object result ;
-
-    //  if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Starting nearest function" << endl;
-    //starttimer(0);
+    NearestResult result ;
 
     const auto status2 = osrm.Nearest( params, result );
-    int mod = ( int )( floor( radius / 1500 ) );
-    if ( mod % 2 != 0 )
-    {
-        //every even modular since they are paired nodes
-        mod++;
-    }
-    //         if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "ending nearest function " << endl;
-    //  starttimer(0);
+    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "near: " << result.edges.size() << " edges within " << radius << " m, spacing " << params.spacing << endl;
 
-    //cout << lon << " " << lat << endl;
-    // if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Starting loop function" << endl;
-    // starttimer(0);
     if ( status2 == Status::Ok )
     {
-        int numberofnodes = 0;
-        int total = 0;
-        const auto &waypoints = result.values.at( "waypoints" ).get<json::Array>().values;
-        for ( const auto &waypoint : waypoints )
+        osrmnodes.reserve( result.edges.size() * 2 );
+        for ( const auto &edge : result.edges )
         {
-
-            if( numberofnodes % mod == 0 )
+            if( edge.first != 0 && edge.second != 0 )
             {
-
-                //cout << lon << " " << lat << endl;
-                const auto &waypoint_object = waypoint.get<json::Object>();
-                const auto &nodes = waypoint_object.values.at( "nodes" ).get<json::Array>().values;
-                //const auto &location = waypoint_object.values.at("location").get<json::Array>().values;
-                const auto node1 = ( unsigned long long )nodes[ 0 ].get<util::json::Number>().value;
-                const auto node2 = ( unsigned long long )nodes[ 1 ].get<util::json::Number>().value;
-                //const auto longitude = location[0].get<json::Number>().value;
-                //const auto latitude = location[1].get<json::Number>().value;
-                const auto distance1 = waypoint_object.values.at( "distance" ).get<json::Number>().value;
-
-                //if(DEBUGROUTED == 1 || DEBUG == 1 ) gse <<  "Distance " << distance1  << endl;
-                //if(distance1 - distance > radius*0.03 && distance1 > radius/3 || distance1 <= radius/3 || distance == 0 && distance1 > radius/3 ){
-
-
-                if( node1 != 0 && node2 != 0 )
-                {
-                    // take every 2rd edge pair to prune results with minimal loss of results
-                    //distance  = distance1;
-                    // if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Starting copy" << endl;
-                    // starttimer(0);
-                    osrmnodes += to_string( node1 );
-                    osrmnodes += ',';
-                    osrmnodes += to_string( node2 );
-                    osrmnodes += ',';
-                    //if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "ending copy" << endl;
-                    //starttimer(0);
-                    total = total + 2;
-                }
+                osrmnodes.push_back( edge.first );
+                osrmnodes.push_back( edge.second );
             }
-            numberofnodes = numberofnodes + 2;
-
-            //}
         }
-        osrmnodes.pop_back();
-        //if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "ending loop function" << endl;
-        // starttimer(0);
-        //if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "osrmnodes number " << total << endl ;
-
     }
     return osrmnodes;
 }
@@ -1306,873 +1237,1174 @@ using namespace std;
 namespace bip = boost::interprocess;
 
 
-int main( int argc, const char *argv[] ) try
+// Per-case latency of the shared-memory loop, kept apart from the one-off engine load time.
+struct RequestLatency
 {
-    /*
-    string shared_memory = argv[2];
+    string name;
+    unsigned long long count = 0;
+    double total_ms = 0;
+    double max_ms = 0;
+};
 
+const static unsigned long long LATENCYREPORTINTERVAL = 1000;
 
+std::mutex latencyMutex;
 
+void reportLatency( RequestLatency &latency, double elapsed_ms )
+{
+    std::lock_guard<std::mutex> lock( latencyMutex );
+    latency.count++;
+    latency.total_ms += elapsed_ms;
+    latency.max_ms = std::max( latency.max_ms, elapsed_ms );
 
-    initosrmshm(shared_memory);
-    */
+    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << latency.name << " request took " << elapsed_ms << " ms" << endl;
 
-    string client = argv[ 2 ];
-    string date = argv[ 3 ];
-    string datedow;
-    string datestr;
-    string upperStr;
-    bool updatedb = true;
-    string date2 = argv[ 3 ];
-    if ( date2.length()>3 )
+    if( latency.count % LATENCYREPORTINTERVAL == 0 )
     {
-        string datetemp = date;
-        string datemonth;
-        string dateday = getNextToken( & ( datetemp ), "-" );
-        datetemp = getNextToken( & ( datetemp ), "-" );
-        if ( datetemp == "JAN" )
-          datemonth = "01";
-        if ( datetemp == "FEB" )
-          datemonth = "02";
-        if ( datetemp == "MAR" )
-          datemonth = "03";
-        if ( datetemp == "APR" )
-          datemonth = "04";
-        if ( datetemp == "MAY" )
-          datemonth = "05";
-        if ( datetemp == "JUN" )
-          datemonth = "06";
-        if ( datetemp == "JUL" )
-          datemonth = "07";
-        if ( datetemp == "AUG" )
-          datemonth = "08";
-        if ( datetemp == "SEP" )
-          datemonth = "09";
-        if ( datetemp == "OCT" )
-          datemonth = "10";
-        if ( datetemp == "NOV" )
-          datemonth = "11";
-        if ( datetemp == "DEC" )
-          datemonth = "12";
-        datetemp = date;
-        getNextToken( & ( datetemp ), "-" );
-        getNextToken( & ( datetemp ), "-" );
-        string dateyear = getNextToken( & ( datetemp ), "-" );
-
-        if( dateyear.length()>2 )
-        {
-            dateyear.erase( 0, 2 );
-        }
-        datestr = dateday + datemonth + dateyear;
-
-    }
-    else
-    {
-        if ( date2 == "SUN" )
-          date = "7";
-        if ( date2 == "MON" )
-          date = "1";
-        if ( date2 == "TUE" )
-          date = "2";
-        if ( date2 == "WED" )
-          date = "3";
-        if ( date2 == "THU" )
-          date = "4";
-        if ( date2 == "FRI" )
-          date = "5";
-        if ( date2 == "SAT" )
-          date = "6";
-        datestr = date;
+        gse << latency.name << " latency after " << latency.count << " requests: avg " << latency.total_ms / latency.count << " ms, max " << latency.max_ms << " ms" << endl;
+        const TravelCache &cache = request_table->travel_cache;
+        gse << "Travel cache: " << cache.hits.load() << " hits, " << cache.misses.load() << " misses (generation " << cache.generation.load() << ")" << endl;
     }
+}
 
 
+RequestLatency accessLatency{ "Case 1 (Access)" };
+RequestLatency findBestLatency{ "Case 2 (FindBest)" };
+RequestLatency distLatency{ "Case 3 (Dist)" };
+RequestLatency fullStringLatency{ "Case 4 (GETOSRMFULLSTRINGACCESS)" };
+RequestLatency fullStringDistancesLatency{ "Case 5 (GETOSRMFULLSTRINGDISTANCES)" };
 
+std::mutex batchMutex;
 
+// --max-table-size of the engine, tableDIST() chunks its queries to stay within it
+int tableSizeLimit = -1;
 
-    initshm( client, datestr );
-    f_cout( LOGDIR + "osrm" + "^" + client + "^" + datestr + ".txt" );
-    s_cout( LOGDIR + "gse_states_log" + "^" + client + "^" + datestr + ".txt" );
-    gse << "The value of DEBUGROUTED is " << DEBUGROUTED << endl; //***JDC hack
-
-    string osrmnodes;
-    // create segment and corresponding allocator
-
-    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Max value of keyt " << std::numeric_limits<key_t> ::max() << endl;
-
-    int shmid = shmget ( key_shared_process, sizeof( char[ MAXPROCESSESCOL ][ MAXLGSTRSIZE ][ NUMBEROFPROCESSES ] ), IPC_CREAT | 0666 );
-    shared_process_tab = ( char ( * )[ MAXPROCESSESCOL ][ MAXLGSTRSIZE ] )shmat( shmid, 0, 0 );
-
-    shmid = shmget ( keyrnum, sizeof( char[ MAXREQUESTS ][ MAXLGSTRSIZE ] ), IPC_CREAT | 0666 );
-    request_number = ( char( * )[ MAXLGSTRSIZE ] )shmat( shmid, 0, 0 );
+bool isDistanceRequest( int i )
+{
+    const int function = requestFunction( i );
+    return !requestHas( i, REQUESTFIELD_DISTANCE ) && requestHas( i, REQUESTFIELD_LATLONG ) &&
+           ( function == FUNC_SLACKDIST || function == FUNC_CALCDIST || function == FUNC_FINDBESTDIST || function == FUNC_FINDBESTDISTSINGLE || function == FUNC_NEEDDIST );
+}
 
-    shmid = shmget ( keyrid, sizeof( char[ MAXREQUESTS ][ MAXLGSTRSIZE ] ), IPC_CREAT | 0666 );
-    request_id = ( char ( * )[ MAXLGSTRSIZE ] )shmat( shmid, 0, 0 );
 
-    shmid = shmget ( keyfunc, sizeof( char[ MAXREQUESTS ][ MAXLGSTRSIZE ] ), IPC_CREAT | 0666 );
-    request_function = ( char( * )[ MAXLGSTRSIZE ] )shmat( shmid, 0, 0 );
+// Serves one submitted slot; returns false if it was not ours to serve or had to wait.
+// Case 4/5 legs sharing an ID are gathered under batchMutex so that two workers never
+// split one batch; every other slot is claimed on its own.
+bool serveRequest( int i, const OSRM &osrm )
+{
+    bool foundhit = false;
+    const int function = requestFunction( i );
+    const bool batch = function == FUNC_GETOSRMFULLSTRINGACCESS || function == FUNC_GETOSRMFULLSTRINGDISTANCES;
+    std::unique_lock<std::mutex> batchlock( batchMutex, std::defer_lock );
+    if( batch )
+    {
+        batchlock.lock();
+        // already answered as part of another worker's batch, or cleared and reused since
+        if( requestState( i ) != REQUESTSUBMITTED )
+            return false;
+    }
+    else if( !claimRequest( i ) )
+    {
+        return false;
+    }
 
-    shmid = shmget ( keytime, sizeof( char[ MAXREQUESTS ][ MAXLGSTRSIZE ] ), IPC_CREAT | 0666 );
-    request_timestamp = ( char( * )[ MAXLGSTRSIZE ] )shmat( shmid, 0, 0 );
+    //***Case 1 - Begin***//
+    if( requestHas( i, REQUESTFIELD_ID ) && ( requestFunction( i ) == FUNC_ACCESS || requestFunction( i ) == FUNC_ACCESSBOTH ) && !requestHas( i, REQUESTFIELD_EDGES ) )
+    {
+        TIMER_START( case1_timer );
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 1':fetchRequest( i, 'ID' ) != ''" << endl;
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 1':fetchRequest( i, 'FUNC' ) == " << fetchRequest( i, "FUNC" ) << endl;
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 1':fetchRequest( i, 'EDGES' ) == " << fetchRequest( i, "EDGES" ) << endl;
+        foundhit = true;
+        string foo_str ( fetchRequest( i, "LATLONG" ) );
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "processing " << fetchRequest( i, "ID" ) << " " << foo_str << endl;
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Case 1 - ID: " << fetchRequest( i, "ID" ) << "; FUNC: " << fetchRequest( i, "FUNC" ) << endl;
+        // string foo_str (fetchRequest(i, "LATLONG"));
+        int len = foo_str.length();
+        int j = 1;
+        int distanc1 = 0;
+        int distanc2 = 0;
+        int previous = 0;
+        string substring;
+        int index = 0;
+        string latlon[ 4 ] =
+        {
+            "empty", "empty", "empty", "empty"
+        };
+        int d_comma = 0;
+        int sub_len = 0;
+        iterator_range<string::iterator> prev;
+        string empty[ 4 ];
+
+        while( foo_str != "" )
+        {
+            latlon[ index ] = getNextToken( ( &foo_str ), "," );
+            index++;
+        }
 
-    shmid = shmget ( keyrlatlong, sizeof( char[ MAXREQUESTS ][ MAXLGSTRSIZE ] ), IPC_CREAT | 0666 );
-    request_latlon = ( char ( * )[ MAXLGSTRSIZE ] )shmat( shmid, 0, 0 );
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Done with lat long " << endl;
+        /*
+                    while (distanc1<len)
+                    {
+                        iterator_range<string::iterator> r = find_nth(foo_str, ",", j);
+
+                        if (j == 1){
+                            distanc1 = distance(foo_str.begin(), r.begin());
+                            distanc2 = distance(foo_str.begin(), r.begin());
+                            substring = foo_str.substr(previous, distanc2);
+                            sub_len = substring.length();
+                            iterator_range<string::iterator> n = find_nth(substring, ",", 0);
+                            d_comma = distance(substring.begin(), n.begin());
+                            latlon[index] = substring.substr(0,d_comma);
+                            index++;
+                            latlon[index] = substring.substr(d_comma+1,sub_len);
+                            index++;
+                        }
 
-    shmid = shmget ( keyrdist, sizeof( char[ MAXREQUESTS ][ MAXLGSTRSIZE ] ), IPC_CREAT | 0666 );
-    request_distance =( char ( * )[ MAXLGSTRSIZE ] )shmat( shmid, 0, 0 );
+                        else{
+                            distanc1 = distance(foo_str.begin(), r.begin());
+                            distanc2 = distance(prev.begin(), r.begin());
+                            substring = foo_str.substr(previous+1, distanc2-1);
+                            sub_len = substring.length();
+                             iterator_range<string::iterator> n = find_nth(substring, ",", 0);
+                            d_comma = distance(substring.begin(), n.begin());
+                            latlon[index] = substring.substr(0,d_comma);
+                            index++;
+                            latlon[index] = substring.substr(d_comma+1,sub_len);
+                            index++;
 
-    shmid = shmget ( keyredge, sizeof( char[ MAXREQUESTS ][ MAXVYLGSTRSIZE ] ), IPC_CREAT | 0666 );
-    request_edges = ( char ( * )[ MAXVYLGSTRSIZE ] )shmat( shmid, 0, 0 );
+                        }
+                        previous = distanc1;
+                        prev = r;
+                        j = j+2;
+                    }
+        */
 
-    shmid = shmget ( keyrtripidx, sizeof( char[ MAXREQUESTS ][ MAXVYLGSTRSIZE ] ), IPC_CREAT | 0666 );
-    request_tripidx = ( char ( * )[ MAXVYLGSTRSIZE ] )shmat( shmid, 0, 0 );
 
-    shmid = shmget ( key_number_of_edges, sizeof( char[ MAXREQUESTS ][ MAXLGSTRSIZE ] ), IPC_CREAT | 0666 );
-    request_numberofedges = ( char( * )[ MAXLGSTRSIZE ] )shmat( shmid, 0, 0 );
+        const char * messages;
 
-    shmid = shmget ( keyrtime, sizeof( char[ MAXREQUESTS ][ MAXLGSTRSIZE ] ), IPC_CREAT | 0666 );
-    request_time = ( char ( * )[ MAXLGSTRSIZE ] )shmat( shmid, 0, 0 );
+        if ( latlon[ 2 ] != "empty" )
+        {
 
+            string temp;
+            string timebetweenstops;
+            double lat1, lon1, lat2, lon2;
+            stringstream geek0( latlon[ 0 ] );
+            geek0 >> lat1;
+            stringstream geek1( latlon[ 1 ] );
+            geek1 >> lon1;
+            stringstream geek2( latlon[ 2 ] );
+            geek2 >> lat2;
+            stringstream geek3( latlon[ 3 ] );
+            geek3 >> lon2;
+
+
+            temp = "";
+            /*if(fetchRequest(i, "FUNC") == "AccessBOTH"){
+                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Doing both" << endl;
+                temp = routed(lat1,lon1,lat2,lon2,argv[1]);
+                timebetweenstops = table(lat1,lon1,lat2,lon2,argv[1]);
+            }
+            else{
+                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "only doing time " << endl;
+                timebetweenstops = table(lat1,lon1,lat2,lon2,argv[1]);
+            }*/
 
+            vector<std::uint64_t> nodes;
+            temp = routed( lat1, lon1, lat2, lon2, osrm, nodes );
 
-    strcpy( ( shared_process_tab[ OSRMSTATUS ][ 0 ] ) , ( "READY" ) );
-    if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:shared_process_tab[ OSRMSTATUS ][ 0 ]=READY" << endl;
 
-    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "OSRM Server starting ... v2" << endl;
-    bool foundhit = false;
+            string substring = getNextToken( &temp, "^" );
+            timebetweenstops = getNextToken( &temp, "^" );
 
-    //int cnt = 1;
-    //***main while loop - Begin***//
-    while ( true )
-    {
+            if( isSameLocation_onlyLatLong( lat1, lon1, lat2, lon2 ) )
+            {
+                substring = "0.00000";
+                timebetweenstops = "0";
+            }
 
-        std::clock_t startt;
-        double durationt;
-        startt = std::clock();
+            updateRequest( i, substring, "DISTANCE" );
+            storeRequestNodes( i, nodes.data(), nodes.size() );
+            updateRequest( i, timebetweenstops, "TIME" );
+            if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 1':updateRequest( " << i << ", " << substring << ", 'DISTANCE' );" << endl;
+            if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 1':storeRequestNodes( " << i << ", " << nodes.size() << " nodes );" << endl;
+            if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 1':updateRequest( " << i << ", " << timebetweenstops << ", 'TIME' );" << endl;
 
+            temp = "";
 
+            for ( int j = 0;
+                  j < 4;
+                  ++j )
+            {
+                latlon[ j ] = "empty";
+            }
 
+            if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Finished with this id" << endl;
 
 
 
-        //***main for loop - Begin***//
-        for( int i = 0;
-             i < MAXREQUESTS;
-             i++ )
-        {
 
 
-            // if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "i is " << i << endl;
-            //***Case 1 - Begin***//
-            if( fetchRequest( i, "ID" ) != "" && ( fetchRequest( i, "FUNC" ) == "Access" || fetchRequest( i, "FUNC" ) == "AccessBOTH" ) && fetchRequest( i, "EDGES" ) == "" )
-            {
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 1':fetchRequest( i, 'ID' ) != ''" << endl;
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 1':fetchRequest( i, 'FUNC' ) == " << fetchRequest( i, "FUNC" ) << endl;
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 1':fetchRequest( i, 'EDGES' ) == " << fetchRequest( i, "EDGES" ) << endl;
-                foundhit = true;
-                string foo_str ( fetchRequest( i, "LATLONG" ) );
-                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "processing " << fetchRequest( i, "ID" ) << " " << foo_str << endl;
-                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Case 1 - ID: " << fetchRequest( i, "ID" ) << "; FUNC: " << fetchRequest( i, "FUNC" ) << endl;
-                // string foo_str (fetchRequest(i, "LATLONG"));
-                int len = foo_str.length();
-                int j = 1;
-                int distanc1 = 0;
-                int distanc2 = 0;
-                int previous = 0;
-                string substring;
-                int index = 0;
-                string latlon[ 4 ] =
-                {
-                    "empty", "empty", "empty", "empty"
-                };
-                int d_comma = 0;
-                int sub_len = 0;
-                iterator_range<string::iterator> prev;
-                string empty[ 4 ];
-
-                while( foo_str != "" )
-                {
-                    latlon[ index ] = getNextToken( ( &foo_str ), "," );
-                    index++;
-                }
 
-                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Done with lat long " << endl;
-                /*
-                            while (distanc1<len)
-                            {
-                                iterator_range<string::iterator> r = find_nth(foo_str, ",", j);
-
-                                if (j == 1){
-                                    distanc1 = distance(foo_str.begin(), r.begin());
-                                    distanc2 = distance(foo_str.begin(), r.begin());
-                                    substring = foo_str.substr(previous, distanc2);
-                                    sub_len = substring.length();
-                                    iterator_range<string::iterator> n = find_nth(substring, ",", 0);
-                                    d_comma = distance(substring.begin(), n.begin());
-                                    latlon[index] = substring.substr(0,d_comma);
-                                    index++;
-                                    latlon[index] = substring.substr(d_comma+1,sub_len);
-                                    index++;
-                                }
-
-                                else{
-                                    distanc1 = distance(foo_str.begin(), r.begin());
-                                    distanc2 = distance(prev.begin(), r.begin());
-                                    substring = foo_str.substr(previous+1, distanc2-1);
-                                    sub_len = substring.length();
-                                     iterator_range<string::iterator> n = find_nth(substring, ",", 0);
-                                    d_comma = distance(substring.begin(), n.begin());
-                                    latlon[index] = substring.substr(0,d_comma);
-                                    index++;
-                                    latlon[index] = substring.substr(d_comma+1,sub_len);
-                                    index++;
-
-                                }
-                                previous = distanc1;
-                                prev = r;
-                                j = j+2;
-                            }
-                */
-
-
-                const char * messages;
-
-                if ( latlon[ 2 ] != "empty" )
-                {
+        }
 
-                    string temp;
-                    string timebetweenstops;
-                    double lat1, lon1, lat2, lon2;
-                    stringstream geek0( latlon[ 0 ] );
-                    geek0 >> lat1;
-                    stringstream geek1( latlon[ 1 ] );
-                    geek1 >> lon1;
-                    stringstream geek2( latlon[ 2 ] );
-                    geek2 >> lat2;
-                    stringstream geek3( latlon[ 3 ] );
-                    geek3 >> lon2;
-
-
-                    temp = "";
-                    /*if(fetchRequest(i, "FUNC") == "AccessBOTH"){
-                        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Doing both" << endl;
-                        temp = routed(lat1,lon1,lat2,lon2,argv[1]);
-                        timebetweenstops = table(lat1,lon1,lat2,lon2,argv[1]);
-                    }
-                    else{
-                        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "only doing time " << endl;
-                        timebetweenstops = table(lat1,lon1,lat2,lon2,argv[1]);
-                    }*/
+        completeRequest( i );
 
-                    temp = routed( lat1, lon1, lat2, lon2, argv[ 1 ] );
+        TIMER_STOP( case1_timer );
+        reportLatency( accessLatency, TIMER_MSEC( case1_timer ) );
+    }
+    //***Case 1 - End***//
 
 
-                    string substringnodes = getNextToken( &temp, "^" );
-                    string substring = getNextToken( &temp, "^" );
-                    timebetweenstops = getNextToken( &temp, "^" );
+    //***Case 2 - Begin***//
+    if( !requestHas( i, REQUESTFIELD_EDGES ) && requestHas( i, REQUESTFIELD_LATLONG ) && ( requestFunction( i ) == FUNC_FINDBEST || requestFunction( i ) == FUNC_FINDBESTSINGLE ) )
+    {
+        TIMER_START( case2_timer );
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'EDGES' ) == ''" << endl;
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'LATLONG' ) != ''" << endl;
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'FUNC' ) == " << fetchRequest( i, "FUNC" ) << endl;
+        //if there is a request and no response
+        foundhit = true;
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Lat longs for  " << fetchRequest( i, "LATLONG" ) << endl;
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Case 2 - LATLONG: " << fetchRequest( i, "LATLONG" ) << "; FUNC: " << fetchRequest( i, "FUNC" ) << endl;
+        time_t curtime;
+        curtime = starttimer( 0 );
+
+        string foo_str = fetchRequest( i, "LATLONG" );
+        int len = foo_str.length();
+        int j = 1;
+        int distanc1 = 0;
+        int distanc2 = 0;
+        int previous = 0;
+        string substring;
+        int index = 0;
+        string latlon[ 4 ] =
+        {
+            "empty", "empty", "empty", "empty"
+        };
+        int d_comma = 0;
+        int sub_len = 0;
+        iterator_range<string::iterator> prev;
+        string empty[ 4 ];
+
+        while( foo_str != "" )
+        {
+            latlon[ index ] = getNextToken( ( &foo_str ), "," );
+            index++;
+        }
 
+        /*
 
-                    if( substringnodes.length() > MAXVYLGSTRSIZE )
-                        substringnodes = "ERROR";
+        while (distanc1<len)
+        {
+            iterator_range<string::iterator> r = find_nth(foo_str, ",", j);
+
+            if (j == 1){
+                distanc1 = distance(foo_str.begin(), r.begin());
+                distanc2 = distance(foo_str.begin(), r.begin());
+                substring = foo_str.substr(previous, distanc2);
+                sub_len = substring.length();
+                iterator_range<string::iterator> n = find_nth(substring, ",", 0);
+                d_comma = distance(substring.begin(), n.begin());
+                latlon[index] = substring.substr(0,d_comma);
+                index++;
+                latlon[index] = substring.substr(d_comma+1,sub_len);
+                index++;
+            }
 
-                    if( isSameLocation_onlyLatLong( lat1, lon1, lat2, lon2 ) )
-                    {
-                        substring = "0.00000";
-                        timebetweenstops = "0";
-                    }
+            else{
+                distanc1 = distance(foo_str.begin(), r.begin());
+                distanc2 = distance(prev.begin(), r.begin());
+                substring = foo_str.substr(previous+1, distanc2-1);
+                sub_len = substring.length();
+                 iterator_range<string::iterator> n = find_nth(substring, ",", 0);
+                d_comma = distance(substring.begin(), n.begin());
+                latlon[index] = substring.substr(0,d_comma);
+                index++;
+                latlon[index] = substring.substr(d_comma+1,sub_len);
+                index++;
 
-                    updateRequest( i, substring, "DISTANCE" );
-                    updateRequest( i, substringnodes, "EDGES" );
-                    updateRequest( i, timebetweenstops, "TIME" );
-                    if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 1':updateRequest( " << i << ", " << substring << ", 'DISTANCE' );" << endl;
-                    if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 1':updateRequest( " << i << ", " << substringnodes << ", 'EDGES' );" << endl;
-                    if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 1':updateRequest( " << i << ", " << timebetweenstops << ", 'TIME' );" << endl;
+            }
+            previous = distanc1;
+            prev = r;
+            j = j+2;
+        }
 
-                    temp = "";
+        */
 
-                    for ( int j = 0;
-                          j < 4;
-                          ++j )
-                    {
-                        latlon[ j ] = "empty";
-                    }
 
-                    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Finished with this id" << endl;
 
+        if ( latlon[ 2 ] != "empty" )
+        {
 
+            string temp;
+            string timebetweenstops;
+            double lat1, lon1, lat2, lon2;
+            stringstream geek0( latlon[ 0 ] );
+            geek0 >> lat1;
+            stringstream geek1( latlon[ 1 ] );
+            geek1 >> lon1;
+            stringstream geek2( latlon[ 2 ] );
+            geek2 >> lat2;
+            stringstream geek3( latlon[ 3 ] );
+            geek3 >> lon2;
 
+            /*std::clock_t start;
+            double duration;
+            start = std::clock();*/
 
 
+            //cout << "Trying for: " << std::get<0>(foo) << " "  << lon1 <<"," << lat1 << " 2: "<< lon2 <<"," << lat2 << endl;
+            vector<std::uint64_t> nodes;
+            temp = routed( lat1, lon1, lat2, lon2, osrm, nodes );
+            //cout << "Finished for " << std::get<0>(foo) << endl;
+            timebetweenstops = table( lat1, lon1, lat2, lon2, osrm );
 
-                }
 
-            }
-            //***Case 1 - End***//
 
 
-            //***Case 2 - Begin***//
-            if( fetchRequest( i, "EDGES" ) == "" && fetchRequest( i, "LATLONG" ) != "" && ( fetchRequest( i, "FUNC" ) == "FindBest" || fetchRequest( i, "FUNC" ) == "FindBestSINGLE" ) )
-            {
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'EDGES' ) == ''" << endl;
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'LATLONG' ) != ''" << endl;
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'FUNC' ) == " << fetchRequest( i, "FUNC" ) << endl;
-                //if there is a request and no response
-                foundhit = true;
-                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Lat longs for  " << request_latlon[ i ] << endl;
-                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Case 2 - LATLONG: " << fetchRequest( i, "LATLONG" ) << "; FUNC: " << fetchRequest( i, "FUNC" ) << endl;
-                time_t curtime;
-                curtime = starttimer( 0 );
-
-                string foo_str = request_latlon[ i ];
-                int len = foo_str.length();
-                int j = 1;
-                int distanc1 = 0;
-                int distanc2 = 0;
-                int previous = 0;
-                string substring;
-                int index = 0;
-                string latlon[ 4 ] =
-                {
-                    "empty", "empty", "empty", "empty"
-                };
-                int d_comma = 0;
-                int sub_len = 0;
-                iterator_range<string::iterator> prev;
-                string empty[ 4 ];
-
-                while( foo_str != "" )
-                {
-                    latlon[ index ] = getNextToken( ( &foo_str ), "," );
-                    index++;
-                }
+            //temp = routed(lat1,lon1,lat2,lon2,argv[1]);
+            //int indextable = std::get<0>(foo);
 
-                /*
+            //////find foo2<0> update distance with returned distance
 
-                while (distanc1<len)
-                {
-                    iterator_range<string::iterator> r = find_nth(foo_str, ",", j);
-
-                    if (j == 1){
-                        distanc1 = distance(foo_str.begin(), r.begin());
-                        distanc2 = distance(foo_str.begin(), r.begin());
-                        substring = foo_str.substr(previous, distanc2);
-                        sub_len = substring.length();
-                        iterator_range<string::iterator> n = find_nth(substring, ",", 0);
-                        d_comma = distance(substring.begin(), n.begin());
-                        latlon[index] = substring.substr(0,d_comma);
-                        index++;
-                        latlon[index] = substring.substr(d_comma+1,sub_len);
-                        index++;
-                    }
 
-                    else{
-                        distanc1 = distance(foo_str.begin(), r.begin());
-                        distanc2 = distance(prev.begin(), r.begin());
-                        substring = foo_str.substr(previous+1, distanc2-1);
-                        sub_len = substring.length();
-                         iterator_range<string::iterator> n = find_nth(substring, ",", 0);
-                        d_comma = distance(substring.begin(), n.begin());
-                        latlon[index] = substring.substr(0,d_comma);
-                        index++;
-                        latlon[index] = substring.substr(d_comma+1,sub_len);
-                        index++;
+            //cout << "nodes " << nodes.size() << endl;
 
-                    }
-                    previous = distanc1;
-                    prev = r;
-                    j = j+2;
-                }
+            //cout << "The distance is " <<substring << endl;
 
-                */
+            //duration = 1000.0 *( std::clock() - start ) / (double) CLOCKS_PER_SEC;
+            //st
+            //duration = 1000.0 *( std::clock() - start ) / (double) CLOCKS_PER_SEC;
+            //std::cout<<"time routed: "<< duration <<'\n';
 
+            //cout <<cnt<<endl;
+            //cnt ++;
 
+            //updateRequest(i, substring, "DISTANCE");--- don't need the distance to search the tree
+            storeRequestNodes( i, nodes.data(), nodes.size() );
+            if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 2':storeRequestNodes( " << i << ", " << nodes.size() << " nodes );" << endl;
 
-                if ( latlon[ 2 ] != "empty" )
-                {
+            if( isSameLocation_onlyLatLong( lat1, lon1, lat2, lon2 ) )
+            {
+                timebetweenstops = "0";
+            }
+            updateRequest( i, timebetweenstops, "TIME" );
+            if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 2':updateRequest( " << i << ", " << timebetweenstops << ", 'TIME' );" << endl;
 
-                    string temp;
-                    string timebetweenstops;
-                    double lat1, lon1, lat2, lon2;
-                    stringstream geek0( latlon[ 0 ] );
-                    geek0 >> lat1;
-                    stringstream geek1( latlon[ 1 ] );
-                    geek1 >> lon1;
-                    stringstream geek2( latlon[ 2 ] );
-                    geek2 >> lat2;
-                    stringstream geek3( latlon[ 3 ] );
-                    geek3 >> lon2;
 
-                    /*std::clock_t start;
-                    double duration;
-                    start = std::clock();*/
+            //std::pair<int,shm::shared_string> foo2 (std::get<0>(foo),str2);
 
+            for ( int j = 0;
+                  j < 4;
+                  ++j )
+            {
+                latlon[ j ] = "empty";
+            }
 
-                    //cout << "Trying for: " << std::get<0>(foo) << " "  << lon1 <<"," << lat1 << " 2: "<< lon2 <<"," << lat2 << endl;
-                    temp = routed( lat1, lon1, lat2, lon2, argv[ 1 ] );
-                    //cout << "Finished for " << std::get<0>(foo) << endl;
-                    timebetweenstops = table( lat1, lon1, lat2, lon2, argv[ 1 ] );
 
+            //queueNodesR->push(foo2);
+            // std::cout << "Processed R: " << foo2.first << "\n";
 
 
+        }
 
-                    //temp = routed(lat1,lon1,lat2,lon2,argv[1]);
-                    //int indextable = std::get<0>(foo);
 
-                    //////find foo2<0> update distance with returned distance
 
+        else
+        {
 
-                    iterator_range<string::iterator> k = find_nth( temp, "^", 0 );
-                    double distance2 = distance( k.begin() + 1, temp.end() );
-                    string substring = temp.substr( temp.length() -distance2, temp.length() );
-                    string substringnodes = temp.substr( 0, ( temp.length() -distance2 -1 ) );
-                    //cout << "nodes " << substringnodes << endl;
+            double lat, lon;
+            stringstream geek1( latlon[ 0 ] );
+            geek1 >> lat;
+            stringstream geek2( latlon[ 1 ] );
+            geek2 >> lon;
+            //   if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Starting nearest " << endl;
+            // curtime = starttimer(0);
+            //cout << "nearest";
+            if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "radius " << to_number( fetchRequest( i, "NUMBEROFEDGES" ) ) << endl;
+            const vector<std::uint64_t> nodes = near( lat, lon, osrm, to_number( fetchRequest( i, "NUMBEROFEDGES" ) ) );
+            //if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "end nearest " << endl;
+            //   curtime = starttimer(0);
+
+            if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Copying into request table for: " << fetchRequest( i, "ID" ) << endl;
+            if( nodes.empty() )
+            {
+                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "bad lat longs, no returned edges" << endl;
+                storeRequestNodes( i, NULL, -1 );
+            }
+            else
+            {
+                storeRequestNodes( i, nodes.data(), nodes.size() );
+            }
+            if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 2':storeRequestNodes( " << i << ", " << nodes.size() << " nodes );" << endl;
 
-                    //cout << "The distance is " <<substring << endl;
+            //cout << " The edges are " << str2 << endl;
+            for ( int j = 0;
+                  j < 4;
+                  ++j )
+            {
+                latlon[ j ] = "empty";
+            }
 
-                    //duration = 1000.0 *( std::clock() - start ) / (double) CLOCKS_PER_SEC;
-                    //st
-                    //duration = 1000.0 *( std::clock() - start ) / (double) CLOCKS_PER_SEC;
-                    //std::cout<<"time routed: "<< duration <<'\n';
+            // std::cout << "Processed N: " << foo2.first << "\n";
 
-                    //cout <<cnt<<endl;
-                    //cnt ++;
+        }
 
-                    if( substringnodes.length() > MAXVYLGSTRSIZE )
-                    {
-                        substringnodes = "ERROR";
-                    }
 
-                    //updateRequest(i, substring, "DISTANCE");--- don't need the distance to search the tree
-                    updateRequest( i, substringnodes, "EDGES" );
-                    if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 2':updateRequest( " << i << ", " << substringnodes << ", 'EDGES' );" << endl;
-                    
-                    if( isSameLocation_onlyLatLong( lat1, lon1, lat2, lon2 ) )
-                    {
-                        timebetweenstops = "0";
-                    }
-                    updateRequest( i, timebetweenstops, "TIME" );
-                    if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 2':updateRequest( " << i << ", " << timebetweenstops << ", 'TIME' );" << endl;
 
+        //cout << "OSRM: Pushing into queueNodesN size now " << queueNodes->read_available() <<endl;
+        endtimer( curtime, 0 );
 
-                    //std::pair<int,shm::shared_string> foo2 (std::get<0>(foo),str2);
+        completeRequest( i );
 
-                    for ( int j = 0;
-                          j < 4;
-                          ++j )
-                    {
-                        latlon[ j ] = "empty";
-                    }
+        TIMER_STOP( case2_timer );
+        reportLatency( findBestLatency, TIMER_MSEC( case2_timer ) );
+    }
+    //***Case 2 - End***//
 
 
-                    //queueNodesR->push(foo2);
-                    // std::cout << "Processed R: " << foo2.first << "\n";
+    //***Case 3 - Begin***//
+    if( isDistanceRequest( i ) )
+    {
+        TIMER_START( case3_timer );
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 3':fetchRequest( i, 'DISTANCE' ) == ''" << endl;
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 3':fetchRequest( i, 'LATLONG' ) != ''" << endl;
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 3':fetchRequest( i, 'FUNC' ) == " << fetchRequest( i, "FUNC" ) << endl;
+        foundhit = true;
+
+        // Take every other outstanding pair along so optimizeRoutes() and the slack passes,
+        // which submit hundreds of pairs over the same stops, cost one Table query per pass.
+        vector<int> batch( 1, i );
+        for( int j = 0;
+             j < MAXREQUESTS;
+             j++ )
+        {
+            if( j != i && requestState( j ) == REQUESTSUBMITTED && isDistanceRequest( j ) && claimRequest( j ) )
+                batch.push_back( j );
+        }
 
+        // pairs with a DEPARTURE minute are routed at that minute, one Table query per minute
+        std::stable_sort( batch.begin(), batch.end(), []( int a, int b ) { return requestDeparture( a ) < requestDeparture( b ); } );
 
-                }
+        vector<int> batchslots;
+        vector<std::array<double, 4>> pairs;
+        vector<int> departures;
+        for( int slot : batch )
+        {
+            if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Case 3 - LATLONG: " << fetchRequest( slot, "LATLONG" ) << "; FUNC: " << fetchRequest( slot, "FUNC" ) << "; DEPARTURE: " << fetchRequest( slot, "DEPARTURE" ) << endl;
+            std::array<double, 4> latlon;
+            if( requestCoordinates( slot, latlon.data() ) == 4 )
+            {
+                batchslots.push_back( slot );
+                pairs.push_back( latlon );
+                departures.push_back( requestDeparture( slot ) );
+            }
+        }
 
+        // answers are cached for the dataset the query starts on, see storeTravelCache()
+        const unsigned long long dataset = travelCacheDataset();
+        vector<bool> estimated;
+        vector<bool> departuremetric;
+        const vector<string> answers = tableDIST( pairs, departures, osrm, tableSizeLimit, estimated, departuremetric );
 
+        for( size_t k = 0;
+             k < batchslots.size();
+             k++ )
+        {
+            const int slot = batchslots[ k ];
+            string temp = answers[ k ];
+            string substring = getNextToken( &temp, "^" );
+            string time1 = getNextToken( &temp, "^" );
 
-                else
-                {
+            if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Distance " << substring << " Time " << time1 << " for " << fetchRequest( slot, "LATLONG" ) << endl;
 
-                    string temp;
-                    double lat, lon;
-                    stringstream geek1( latlon[ 0 ] );
-                    geek1 >> lat;
-                    stringstream geek2( latlon[ 1 ] );
-                    geek2 >> lon;
-                    //   if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Starting nearest " << endl;
-                    // curtime = starttimer(0);
-                    //cout << "nearest";
-                    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "radius " << to_number( request_numberofedges[ i ] ) << endl;
-                    temp = near( lat, lon, argv[ 1 ], to_number( request_numberofedges[ i ] ) );
-                    //if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "end nearest " << endl;
-                    //   curtime = starttimer(0);
-                    if( temp.length() > MAXVYLGSTRSIZE )
-                    {
+            if( isSameLocation_onlyLatLong( pairs[ k ][ 0 ], pairs[ k ][ 1 ], pairs[ k ][ 2 ], pairs[ k ][ 3 ] ) )
+            {
+                substring = "0.00000";
+                time1 = "0";
+            }
+            else if( estimated[ k ] )
+            {
+                // answered, but kept out of the travel cache so the next request routes it again
+                markRequestEstimate( slot );
+            }
+            else if( departuremetric[ k ] )
+            {
+                // the time is for the DEPARTURE minute, the scheduler applies no velocity factor to it
+                markRequestDepartureMetric( slot );
+            }
 
-                        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Over max length size : " << temp.length() << " out of " << MAXVYLGSTRSIZE << endl;
-                        temp = "ERROR";
-                    }
+            updateRequest( slot, substring, "DISTANCE" );
+            updateRequest( slot, time1, "TIME" );
+            if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 3':updateRequest( " << slot << ", " << substring << ", 'DISTANCE' );" << endl;
+            if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 3':updateRequest( " << slot << ", " << time1 << ", 'TIME' );" << endl;
+        }
 
-                    if( temp == "" )
-                    {
-                        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "bad lat longs, no returned edges" << endl;
-                        temp = "ERROR";
-                    }
+        for( int slot : batch )
+        {
+            completeRequest( slot, dataset );
+        }
 
-                    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Copying into request table for: " << request_id[ i ] << endl;
-                    updateRequest( i, temp, "EDGES" );
-                    if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 2':updateRequest( " << i << ", " << temp << ", 'EDGES' );" << endl;
-                    
-                    //cout << " The edges are " << str2 << endl;
-                    for ( int j = 0;
-                          j < 4;
-                          ++j )
-                    {
-                        latlon[ j ] = "empty";
-                    }
+        TIMER_STOP( case3_timer );
+        reportLatency( distLatency, TIMER_MSEC( case3_timer ) );
+    }
+    //***Case 3 - End***//
 
-                    // std::cout << "Processed N: " << foo2.first << "\n";
 
-                }
+    //***Case 4 - Begin***//
+    if( strcmp( shared_process_tab[ WRITINGFB ][ 0 ], "READY" ) == 0 && !requestHas( i, REQUESTFIELD_DISTANCE ) && !requestHas( i, REQUESTFIELD_EDGES ) && requestHas( i, REQUESTFIELD_LATLONG ) && requestFunction( i ) == FUNC_GETOSRMFULLSTRINGACCESS )
+    {
+        TIMER_START( case4_timer );
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':shared_process_tab[ WRITINGFB ][ 0 ] == READY" << endl;
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'DISTANCE' ) == ''" << endl;
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'EDGES' ) == ''" << endl;
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'LATLONG' ) != ''" << endl;
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'FUNC' ) == GETOSRMFULLSTRINGACCESS" << endl;
+        foundhit = true;
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Getting full route" << endl;
+        for( int j = 0;
+             j < MAXREQUESTS;
+             j++ )
+        {
+            if( requestState( j ) == REQUESTSUBMITTED && !requestHas( j, REQUESTFIELD_DISTANCE ) && requestHas( j, REQUESTFIELD_LATLONG ) && requestFunction( j ) == FUNC_GETOSRMFULLSTRINGACCESS && j < i && fetchRequest( j, "ID" ) == fetchRequest( i, "ID" ) )
+            {
+                //usleep(10);
+                i = j;
+                j = -1;
 
 
+            }
+        }
 
-                //cout << "OSRM: Pushing into queueNodesN size now " << queueNodes->read_available() <<endl;
-                endtimer( curtime, 0 );
+        // slots come off the free list in any order, so the legs are put together in the order
+        // they were submitted
+        vector<std::pair<unsigned long long, int>> legs;
+        for( int j = 0;
+             j < MAXREQUESTS;
+             j++ )
+        {
 
+            if( requestState( j ) == REQUESTSUBMITTED && !requestHas( j, REQUESTFIELD_DISTANCE ) && requestHas( j, REQUESTFIELD_LATLONG ) && requestFunction( j ) == FUNC_GETOSRMFULLSTRINGACCESS && fetchRequest( j, "ID" ) == fetchRequest( i, "ID" ) )
+            {
+                claimRequest( j );
+                legs.emplace_back( requestSequence( j ), j );
             }
-            //***Case 2 - End***//
+        }
+        std::sort( legs.begin(), legs.end() );
 
+        string foo_index;
+        string foo_str;
+        for( const auto &leg : legs )
+        {
+            if( foo_str == "" )
+            {
 
-            //***Case 3 - Begin***//
-            if( fetchRequest( i, "DISTANCE" ) == "" && fetchRequest( i, "LATLONG" ) != "" && ( fetchRequest( i, "FUNC" ) == "SlackDist" || fetchRequest( i, "FUNC" ) == "CalcDist" || fetchRequest( i, "FUNC" ) == "FindBestDist" || fetchRequest( i, "FUNC" ) == "FindBestDistSINGLE" || fetchRequest( i, "FUNC" ) == "NEEDDist" ) )
+                foo_str = fetchRequest( leg.second, "LATLONG" );
+                foo_index = to_string( leg.second );
+            }
+            else
             {
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 3':fetchRequest( i, 'DISTANCE' ) == ''" << endl;
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 3':fetchRequest( i, 'LATLONG' ) != ''" << endl;
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 3':fetchRequest( i, 'FUNC' ) == " << fetchRequest( i, "FUNC" ) << endl;
-                foundhit = true;
-                string foo_str = request_latlon[ i ];
-                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Lat/Long " << foo_str << endl;
-                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Case 3 - LATLONG: " << fetchRequest( i, "LATLONG" ) << "; FUNC: " << fetchRequest( i, "FUNC" ) << endl;
-                int len = foo_str.length();
-                int j = 1;
-                int distanc1 = 0;
-                int distanc2 = 0;
-                int previous = 0;
-                string substring;
-                int index = 0;
-                string latlon[ 4 ] =
-                {
-                    "empty", "empty", "empty", "empty"
-                };
-                int d_comma = 0;
-                int sub_len = 0;
-                iterator_range<string::iterator> prev;
-                string empty[ 4 ];
-
-                while( foo_str != "" )
-                {
-                    latlon[ index ] = getNextToken( ( &foo_str ), "," );
-                    index++;
+                foo_str = foo_str + "," + fetchRequest( leg.second, "LATLONG" );
+                foo_index = foo_index + "?" + to_string( leg.second );
+            }
+        }
 
-                }
+        batchlock.unlock();
 
-                /*
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Lat/Long " << foo_str << endl;
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << foo_index << endl;
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Case 4 - LATLONG: " << fetchRequest( i, "LATLONG" ) << "; FUNC: " << fetchRequest( i, "FUNC" ) << endl;
 
-                while (distanc1<len)
-                {
-                    iterator_range<string::iterator> r = find_nth(foo_str, ",", j);
-
-                    if (j == 1){
-                        distanc1 = distance(foo_str.begin(), r.begin());
-                        distanc2 = distance(foo_str.begin(), r.begin());
-                        substring = foo_str.substr(previous, distanc2);
-                        sub_len = substring.length();
-                        iterator_range<string::iterator> n = find_nth(substring, ",", 0);
-                        d_comma = distance(substring.begin(), n.begin());
-                        latlon[index] = substring.substr(0,d_comma);
-                        index++;
-                        latlon[index] = substring.substr(d_comma+1,sub_len);
-                        index++;
-                    }
 
-                    else{
-                        distanc1 = distance(foo_str.begin(), r.begin());
-                        distanc2 = distance(prev.begin(), r.begin());
-                        substring = foo_str.substr(previous+1, distanc2-1);
-                        sub_len = substring.length();
-                         iterator_range<string::iterator> n = find_nth(substring, ",", 0);
-                        d_comma = distance(substring.begin(), n.begin());
-                        latlon[index] = substring.substr(0,d_comma);
-                        index++;
-                        latlon[index] = substring.substr(d_comma+1,sub_len);
-                        index++;
 
-                    }
-                    previous = distanc1;
-                    prev = r;
-                    j = j+2;
-                }
-                */
+        // cout << "Trying for: " << std::get<0>(foo) << " "  << lon1 <<"," << lat1 << " 2: "<< lon2 <<"," << lat2 << endl;
+        vector<vector<std::uint64_t>> legnodes;
+        string temp = routedString( foo_str, osrm, legnodes );
+        // cout << "Finished for " << std::get<0>(foo) << endl;
 
 
-                const char * messages;
+        for( const auto &nodes : legnodes )
+        {
+            if( temp == "" )
+                break;
 
-                //cout << latlon[2] << endl;
+            if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "temp " << i << " " << temp << endl;
+            int index = ( int )to_number( getNextToken( &foo_index, "?" ) );
+            string distance = getNextToken( &temp, "?" );
 
-                if ( latlon[ 2 ] != "empty" )
-                {
+            if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "index " << index << " " << distance << " " << nodes.size() << " nodes" << endl;
 
-                    string temp;
-                    double lat1, lon1, lat2, lon2;
-                    stringstream geek0( latlon[ 0 ] );
-                    geek0 >> lat1;
-                    stringstream geek1( latlon[ 1 ] );
-                    geek1 >> lon1;
-                    stringstream geek2( latlon[ 2 ] );
-                    geek2 >> lat2;
-                    stringstream geek3( latlon[ 3 ] );
-                    geek3 >> lon2;
+            //if(isSameLocation_onlyLatLong(lat1,lon1,lat2,lon2)){
+            //  distance = "0.0000";
+            // }
+            updateRequest( index, distance.c_str(), "DISTANCE" );
+            storeRequestNodes( index, nodes.data(), nodes.size() );
+            completeRequest( index );
+            if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 4':updateRequest( " << index << ", " << distance.c_str() << ", 'DISTANCE' );" << endl;
+            if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 4':storeRequestNodes( " << index << ", " << nodes.size() << " nodes );" << endl;
 
-                    /*std::clock_t start;
-                    double duration;
-                    start = std::clock();*/
+        }
 
+        TIMER_STOP( case4_timer );
+        reportLatency( fullStringLatency, TIMER_MSEC( case4_timer ) );
+    }
+    //***Case 4 - End***//
 
+    //***Case 5 - Begin***//
+    if( strcmp( shared_process_tab[ WRITINGFB ][ 0 ], "READY" ) == 0 && !requestHas( i, REQUESTFIELD_DISTANCE ) && requestHas( i, REQUESTFIELD_LATLONG ) && requestFunction( i ) == FUNC_GETOSRMFULLSTRINGDISTANCES )
+    {
+        TIMER_START( case5_timer );
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':shared_process_tab[ WRITINGFB ][ 0 ] == READY" << endl;
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'DISTANCE' ) == ''" << endl;
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'LATLONG' ) != ''" << endl;
+        if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'FUNC' ) == GETOSRMFULLSTRINGDISTANCES" << endl;
+        for( int j = 0;
+             j < MAXREQUESTS;
+             j++ )
+        {
+            if( requestState( j ) == REQUESTSUBMITTED && !requestHas( j, REQUESTFIELD_DISTANCE ) && requestHas( j, REQUESTFIELD_LATLONG ) && requestFunction( j ) == FUNC_GETOSRMFULLSTRINGDISTANCES && j < i && fetchRequest( j, "ID" ) == fetchRequest( i, "ID" ) )
+            {
+                //usleep(10);
+                i = j;
+                j = -1;
 
-                    // cout << "Trying for: " << std::get<0>(foo) << " "  << lon1 <<"," << lat1 << " 2: "<< lon2 <<"," << lat2 << endl;
-                    /*if(fetchRequest(i, "FUNC") != "CalcDist"){
-                        temp = routedDIST(lat1,lon1,lat2,lon2,argv[1]);
-                    }
-                    else{
-                        temp = "0";
-                    }*/
-                    temp = "0";
-                    string time1 = "0";
-                    string dist = "0";
-                    // cout << "Finished for " << std::get<0>(foo) << endl;
 
-                    //if(fetchRequest(i, "FUNC") == "NEEDDist"){
-                    temp = routedDIST( lat1, lon1, lat2, lon2, argv[ 1 ] );
-                    dist = getNextToken( &temp, "^" );
-                    time1 = getNextToken( &temp, "^" );
-                    //}
-                    //else{
-                    //time1 = table(lat1,lon1,lat2,lon2,argv[1]);
-                    //}
+            }
+        }
 
+        // slots come off the free list in any order, so the legs are put together in the order
+        // they were submitted
+        vector<std::pair<unsigned long long, int>> legs;
+        for( int j = 0;
+             j < MAXREQUESTS;
+             j++ )
+        {
 
+            if( requestState( j ) == REQUESTSUBMITTED && !requestHas( j, REQUESTFIELD_DISTANCE ) && requestHas( j, REQUESTFIELD_LATLONG ) && requestFunction( j ) == FUNC_GETOSRMFULLSTRINGDISTANCES && fetchRequest( j, "ID" ) == fetchRequest( i, "ID" ) )
+            {
+                claimRequest( j );
+                legs.emplace_back( requestSequence( j ), j );
+            }
+        }
+        std::sort( legs.begin(), legs.end() );
 
-                    int indextable = ( int )to_number( fetchRequest( i, "TRIPIDX" ) );
+        string foo_index;
+        string foo_str;
+        for( const auto &leg : legs )
+        {
+            if( foo_str == "" )
+            {
 
-                    //////find foo2<0> update distance with returned distance
+                foo_str = fetchRequest( leg.second, "LATLONG" );
+                foo_index = to_string( leg.second );
+            }
+            else
+            {
+                foo_str = foo_str + "," + fetchRequest( leg.second, "LATLONG" );
+                foo_index = foo_index + "?" + to_string( leg.second );
+            }
+        }
 
+        batchlock.unlock();
 
-                    //iterator_range<string::iterator> k = find_nth(temp, "^", 0);
-                    //double distance2 = distance(k.begin()+1, temp.end());
-                    //string substring = temp.substr(temp.length()-distance2, temp.length());
-                    string substring = dist;
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Lat/Long " << foo_str << endl;
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "foo_index " << foo_index << endl;
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Case 5 - LATLONG: " << fetchRequest( i, "LATLONG" ) << "; FUNC: " << fetchRequest( i, "FUNC" ) << endl;
 
 
 
-                    //cout << "nodes " << substringnodes << endl;
+        string temp = routedStringDistances( foo_str, osrm );
+        // cout << "Finished for " << std::get<0>(foo) << endl;
 
-                    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Distance " << substring << " for " << foo_str << endl;
-                    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Time " << time1 << " for " << foo_str << endl;
 
-                    //duration = 1000.0 *( std::clock() - start ) / (double) CLOCKS_PER_SEC;
-                    //std::cout<<"time routed: "<< duration <<'\n';
-                    messages = substring.c_str();
+        while( temp != "" && foo_index != "" )
+        {
+            int index = ( int )to_number( getNextToken( &foo_index, "?" ) );
+            string distance = getNextToken( &temp, "?" );
+            // if(isSameLocation_onlyLatLong(lat1,lon1,lat2,lon2)){
+            //distance = "0.00000";
 
-                    if( isSameLocation_onlyLatLong( lat1, lon1, lat2, lon2 ) )
-                    {
-                        substring = "0.00000";
-                        time1 = "0";
-                    }
+            // }
+            updateRequest( index, distance.c_str(), "DISTANCE" );
+            completeRequest( index );
+            if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 5':updateRequest( " << index << ", " << distance.c_str() << ", 'DISTANCE' );" << endl;
 
-                    updateRequest( i, substring, "DISTANCE" );
-                    updateRequest( i, time1, "TIME" );
-                    if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 3':updateRequest( " << i << ", " << substring << ", 'DISTANCE' );" << endl;
-                    if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 3':updateRequest( " << i << ", " << time1 << ", 'TIME' );" << endl;
 
-                    for ( int i = 0;
-                          i < 4;
-                          ++i )
-                    {
-                        latlon[ i ] = "empty";
-                    }
+        }
 
-                }
+        TIMER_STOP( case5_timer );
+        reportLatency( fullStringDistancesLatency, TIMER_MSEC( case5_timer ) );
+    }
+    //***Case 5 - End***//
 
 
+    //***Case 6 - Begin***//
+    if( requestFunction( i ) == FUNC_BUILDSTOPMATRIX )
+    {
+        foundhit = true;
+        if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Case 6 - building the stop matrix" << endl;
+        fillStopMatrix( osrm, tableSizeLimit );
+        completeRequest( i );
+        releaseStopMatrixRequest( i );
+    }
+    //***Case 6 - End***//
 
-            }
-            //***Case 3 - End***//
+    if( !foundhit )
+        requeueRequest( i );
 
+    return foundhit;
+}
 
-            //***Case 4 - Begin***//
-            if( strcmp( shared_process_tab[ WRITINGFB ][ 0 ], "READY" ) == 0 && fetchRequest( i, "DISTANCE" ) == "" && fetchRequest( i, "EDGES" ) == "" && fetchRequest( i, "LATLONG" ) != "" && fetchRequest( i, "FUNC" ) == "GETOSRMFULLSTRINGACCESS" )
-            {
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':shared_process_tab[ WRITINGFB ][ 0 ] == READY" << endl;
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'DISTANCE' ) == ''" << endl;
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'EDGES' ) == ''" << endl;
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'LATLONG' ) != ''" << endl;
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'FUNC' ) == GETOSRMFULLSTRINGACCESS" << endl;
-                foundhit = true;
-                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Getting full route" << endl;
-                for( int j = 0;
-                     j < MAXREQUESTS;
-                     j++ )
-                {
-                    if( fetchRequest( j, "DISTANCE" ) == "" && fetchRequest( j, "LATLONG" ) != "" && fetchRequest( j, "FUNC" ) == "GETOSRMFULLSTRINGACCESS" && j < i && fetchRequest( j, "ID" ) == fetchRequest( i, "ID" ) )
-                    {
-                        //usleep(10);
-                        i = j;
-                        j = -1;
 
+// One worker: drain the pending FIFO, then sleep on the submissions futex until more work arrives.
+void serveRequests( const OSRM &osrm )
+{
+    while ( true )
+    {
+        int submissionsseen = requestSubmissions();
+        bool foundhit = false;
+
+        // submitted slots come off the pending FIFO oldest first; one pass looks at each once
+        int pendingrequests = requestsPending();
+        for( int n = 0;
+             n < pendingrequests;
+             n++ )
+        {
+            int i;
+            if( !nextRequest( i ) )
+                break;
 
-                    }
-                }
+            if( serveRequest( i, osrm ) )
+                foundhit = true;
+        }
 
-                string foo_index;
-                string foo_str;
+        // a client's submitRequest() wakes us immediately, and the REQUESTSERVERWAITUS
+        // timeout rescans slots left over from a busy pass. Slots of callers that fill a slot
+        // and poll for the answer without submitting it are picked up on the same timeout.
+        if( !foundhit && adoptUnsubmittedRequests() > 0 )
+            continue;
+        if( !foundhit )
+            waitForRequestSubmission( submissionsseen );
+    }
+}
 
-                for( int j = i;
-                     j < MAXREQUESTS;
-                     j++ )
-                {
 
-                    if( fetchRequest( j, "DISTANCE" ) == "" && fetchRequest( j, "LATLONG" ) != "" && fetchRequest( j, "FUNC" ) == "GETOSRMFULLSTRINGACCESS" && fetchRequest( j, "ID" ) == fetchRequest( i, "ID" ) )
-                    {
+// With --shared-memory the engine's DataWatchdog switches to whatever osrm-datastore loads next.
+// Answers cached from the old data have to go with it, so this polls the timestamps of the
+// dataset's regions and publishes them to the travel cache. Entries and the stop matrix are
+// tagged with the timestamps current when their query started, so everything routed on an
+// older dataset, including queries still running when it changed, stops matching.
+void watchDataset( const std::string &dataset_name )
+{
+    storage::SharedMonitor<storage::SharedRegionRegister> barrier;
+    std::uint64_t static_timestamp = 0;
+    std::uint64_t updatable_timestamp = 0;
+    while ( true )
+    {
+        bool changed = false;
+        {
+            boost::interprocess::scoped_lock<storage::SharedMonitor<storage::SharedRegionRegister>::mutex_type> lock( barrier.get_mutex() );
+            const auto &shared_register = barrier.data();
+            const auto static_region_id = shared_register.Find( dataset_name + "/static" );
+            const auto updatable_region_id = shared_register.Find( dataset_name + "/updatable" );
+            if ( static_region_id != storage::SharedRegionRegister::INVALID_REGION_ID &&
+                 updatable_region_id != storage::SharedRegionRegister::INVALID_REGION_ID )
+            {
+                const auto static_now = shared_register.GetRegion( static_region_id ).timestamp;
+                const auto updatable_now = shared_register.GetRegion( updatable_region_id ).timestamp;
+                changed = static_now != static_timestamp || updatable_now != updatable_timestamp;
+                static_timestamp = static_now;
+                updatable_timestamp = updatable_now;
+            }
+        }
 
-                        if( foo_str == "" )
-                        {
+        if ( changed )
+        {
+            publishTravelCacheDataset( static_timestamp, updatable_timestamp );
+            gse << "Shared dataset \"" << dataset_name << "\" changed to timestamps " << static_timestamp << " and " << updatable_timestamp << ", travel cache invalidated" << endl;
+            util::Log() << "Dataset \"" << dataset_name << "\" changed, travel cache invalidated";
+        }
 
-                            foo_str = request_latlon[ j ];
-                            foo_index = to_string( j );
-                        }
-                        else
-                        {
-                            foo_str = foo_str + "," + request_latlon[ j ];
-                            foo_index = foo_index + "?" + to_string( j );
-                        }
+        std::this_thread::sleep_for( std::chrono::seconds( 1 ) );
+    }
+}
 
-                    }
-                }
 
-                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Lat/Long " << foo_str << endl;
-                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << foo_index << endl;
-                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Case 4 - LATLONG: " << fetchRequest( i, "LATLONG" ) << "; FUNC: " << fetchRequest( i, "FUNC" ) << endl;
+// A vehicle position as the tracker first saw it in avl_tops
+struct TrackedFix
+{
+    double lat;
+    double lon;
+    unsigned timestamp;
+};
+
+// Snaps the latest fix with the Match HMM over the vehicle's recent fixes, so a position off the
+// road or on the wrong carriageway lands where the trace says the vehicle drives. Keeps the raw
+// position when there is no trace yet or the match fails.
+void matchVehicle( const OSRM &osrm, const std::deque<TrackedFix> &trace, double &lat, double &lon )
+{
+    lat = trace.back().lat;
+    lon = trace.back().lon;
+    if( trace.size() < 2 )
+        return;
 
+    MatchParameters params;
+    for( const auto &fix : trace )
+    {
+        params.coordinates.push_back( { util::FloatLongitude{ fix.lon }, util::FloatLatitude{ fix.lat } } );
+        params.timestamps.push_back( fix.timestamp );
+    }
+    params.gaps = MatchParameters::GapsType::Ignore;
+    params.overview = RouteParameters::OverviewType::False;
+
+    json::Object result;
+    if( osrm.Match( params, result ) != Status::Ok )
+        return;
+    const auto &tracepoints = result.values.at( "tracepoints" ).get<json::Array>().values;
+    // fixes the HMM dropped as outliers come back as null
+    if( tracepoints.empty() || !tracepoints.back().is<json::Object>() )
+        return;
+    const auto &location = tracepoints.back().get<json::Object>().values.at( "location" ).get<json::Array>().values;
+    lon = location[ 0 ].get<json::Number>().value;
+    lat = location[ 1 ].get<json::Number>().value;
+}
 
 
-                // cout << "Trying for: " << std::get<0>(foo) << " "  << lon1 <<"," << lat1 << " 2: "<< lon2 <<"," << lat2 << endl;
-                string temp = routedString( foo_str, argv[ 1 ] );
-                // cout << "Finished for " << std::get<0>(foo) << endl;
+// Keeps the vehicle tracks the schedulers registered current. Each pass looks up the tracked
+// segments in avl_tops; a segment with a new fix, or with stops registered since its last answer,
+// is matched and routed once from the matched position through its remaining stops. The leg
+// durations become the ETAs getRealTimeTravleTime() then reads without a request. A segment
+// that is no longer in avl_tops has finished its run and its track is released.
+void trackVehicles( const OSRM &osrm )
+{
+    std::map<string, std::deque<TrackedFix>> traces;
+    std::map<string, string> lastfix;
+    while ( true )
+    {
+        std::this_thread::sleep_for( std::chrono::seconds( AVLTRACKINTERVAL ) );
+        if( !attachAvlTops() )
+            continue;
+        attachVehicleTracks();
+
+        for( int t = 0;
+             t < MAXSEGMENTS;
+             t++ )
+        {
+            VehicleTrackData data;
+            if( !readVehicleTrack( t, data ) )
+                continue;
+            const string segment = data.segment;
+            if( data.requested == 0 )
+            {
+                traces.erase( segment );
+                lastfix.erase( segment );
+                continue;
+            }
+            const int row = findAvlTopsRow( segment );
+            if( row < 0 )
+            {
+                releaseVehicleTrack( segment );
+                traces.erase( segment );
+                lastfix.erase( segment );
+                continue;
+            }
+            const string record_time = avl_tops[ row ][ 3 ];
+            const string lat = avl_tops[ row ][ 1 ];
+            const string lon = avl_tops[ row ][ 2 ];
+            if( record_time == "" || lat == "" || lon == "" )
+                continue;
+
+            std::deque<TrackedFix> &trace = traces[ segment ];
+            if( lastfix[ segment ] != record_time )
+            {
+                lastfix[ segment ] = record_time;
+                // the HMM needs the time the fix was taken, not when this pass saw it
+                const unsigned timestamp = ( unsigned )dayMinute( record_time ) * 60;
+                // a fix from before the last one, e.g. past midnight, starts a new trace
+                if( !trace.empty() && timestamp < trace.back().timestamp )
+                    trace.clear();
+                trace.push_back( { to_number( lat ), to_number( lon ), timestamp } );
+                if( trace.size() > ( size_t )AVLTRACKWINDOW )
+                    trace.pop_front();
+            }
+            else if( data.answered == data.requested && record_time == data.record_time )
+            {
+                continue;
+            }
 
+            TIMER_START( track_timer );
+            double matchedlat, matchedlon;
+            matchVehicle( osrm, trace, matchedlat, matchedlon );
+
+            RouteParameters params;
+            params.continue_straight = false;
+            params.overview = RouteParameters::OverviewType::False;
+            params.coordinates.push_back( { util::FloatLongitude{ matchedlon }, util::FloatLatitude{ matchedlat } } );
+            for( int s = 0;
+                 s < data.nstops;
+                 s++ )
+            {
+                params.coordinates.push_back( { util::FloatLongitude{ data.coords[ s ][ 1 ] }, util::FloatLatitude{ data.coords[ s ][ 0 ] } } );
+            }
 
-                while( temp != "" )
+            // stops the route cannot reach keep -1 and go back to a request of their own
+            vector<float> etas( data.nstops, -1 );
+            RouteResult result;
+            if( data.nstops > 0 && osrm.Route( params, result ) == Status::Ok && !result.routes.empty() )
+            {
+                const auto &legs = result.routes[ 0 ].legs;
+                double elapsed = 0;
+                for( int s = 0;
+                     s < data.nstops && s < ( int )legs.size();
+                     s++ )
                 {
+                    elapsed += legs[ s ].duration;
+                    etas[ s ] = elapsed;
+                }
+            }
+            const bool published = publishVehicleTrack( t, data.requested, record_time, matchedlat, matchedlon, etas );
+            TIMER_STOP( track_timer );
+            if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Vehicle track " << segment << ": fix " << record_time << " matched to " << matchedlat << "," << matchedlon << ", " << data.nstops << " stops routed in " << TIMER_MSEC( track_timer ) << " ms" << ( published ? "" : ", stops changed meanwhile" ) << endl;
+        }
+    }
+}
 
-                    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "temp " << i << " " << temp << endl;
-                    int index = ( int )to_number( getNextToken( &foo_index, "?" ) );
-                    string edges = getNextToken( &temp, "^" );
-                    string distance = getNextToken( &temp, "?" );
-
-                    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "index " << index << " " << distance << " " << edges << endl;
 
-                    if( edges.length() > MAXVYLGSTRSIZE )
-                      edges = "ERROR";
+int main( int argc, const char *argv[] ) try
+{
+    /*
+    string shared_memory = argv[2];
 
-                    //if(isSameLocation_onlyLatLong(lat1,lon1,lat2,lon2)){
-                    //  distance = "0.0000";
-                    // }
-                    updateRequest( index, distance.c_str(), "DISTANCE" );
-                    updateRequest( index, edges.c_str(), "EDGES" );
-                    if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 4':updateRequest( " << index << ", " << distance.c_str() << ", 'DISTANCE' );" << endl;
-                    if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 4':updateRequest( " << index << ", " << edges.c_str() << ", 'TIME' );" << endl;
 
-                }
 
-            }
-            //***Case 4 - End***//
 
-            //***Case 5 - Begin***//
-            if( strcmp( shared_process_tab[ WRITINGFB ][ 0 ], "READY" ) == 0 && fetchRequest( i, "DISTANCE" ) == "" && fetchRequest( i, "LATLONG" ) != "" && fetchRequest( i, "FUNC" ) == "GETOSRMFULLSTRINGDISTANCES" )
-            {
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':shared_process_tab[ WRITINGFB ][ 0 ] == READY" << endl;
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'DISTANCE' ) == ''" << endl;
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'LATLONG' ) != ''" << endl;
-                if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed - confirm:'Case 2':fetchRequest( i, 'FUNC' ) == GETOSRMFULLSTRINGDISTANCES" << endl;
-                for( int j = 0;
-                     j < MAXREQUESTS;
-                     j++ )
-                {
-                    if( fetchRequest( j, "DISTANCE" ) == "" && fetchRequest( j, "LATLONG" ) != "" && fetchRequest( j, "FUNC" ) == "GETOSRMFULLSTRINGDISTANCES" && j < i && fetchRequest( j, "ID" ) == fetchRequest( i, "ID" ) )
-                    {
-                        //usleep(10);
-                        i = j;
-                        j = -1;
+    initosrmshm(shared_memory);
+    */
 
+    string client = argv[ 2 ];
+    string date = argv[ 3 ];
+    string datedow;
+    string datestr;
+    string upperStr;
+    bool updatedb = true;
+    string date2 = argv[ 3 ];
+    if ( date2.length()>3 )
+    {
+        string datetemp = date;
+        string datemonth;
+        string dateday = getNextToken( & ( datetemp ), "-" );
+        datetemp = getNextToken( & ( datetemp ), "-" );
+        if ( datetemp == "JAN" )
+          datemonth = "01";
+        if ( datetemp == "FEB" )
+          datemonth = "02";
+        if ( datetemp == "MAR" )
+          datemonth = "03";
+        if ( datetemp == "APR" )
+          datemonth = "04";
+        if ( datetemp == "MAY" )
+          datemonth = "05";
+        if ( datetemp == "JUN" )
+          datemonth = "06";
+        if ( datetemp == "JUL" )
+          datemonth = "07";
+        if ( datetemp == "AUG" )
+          datemonth = "08";
+        if ( datetemp == "SEP" )
+          datemonth = "09";
+        if ( datetemp == "OCT" )
+          datemonth = "10";
+        if ( datetemp == "NOV" )
+          datemonth = "11";
+        if ( datetemp == "DEC" )
+          datemonth = "12";
+        datetemp = date;
+        getNextToken( & ( datetemp ), "-" );
+        getNextToken( & ( datetemp ), "-" );
+        string dateyear = getNextToken( & ( datetemp ), "-" );
 
-                    }
-                }
+        if( dateyear.length()>2 )
+        {
+            dateyear.erase( 0, 2 );
+        }
+        datestr = dateday + datemonth + dateyear;
 
-                string foo_index;
-                string foo_str;
+    }
+    else
+    {
+        if ( date2 == "SUN" )
+          date = "7";
+        if ( date2 == "MON" )
+          date = "1";
+        if ( date2 == "TUE" )
+          date = "2";
+        if ( date2 == "WED" )
+          date = "3";
+        if ( date2 == "THU" )
+          date = "4";
+        if ( date2 == "FRI" )
+          date = "5";
+        if ( date2 == "SAT" )
+          date = "6";
+        datestr = date;
+    }
 
-                for( int j = 0;
-                     j < MAXREQUESTS;
-                     j++ )
-                {
 
-                    if( fetchRequest( j, "DISTANCE" ) == "" && fetchRequest( j, "LATLONG" ) != "" && fetchRequest( j, "FUNC" ) == "GETOSRMFULLSTRINGDISTANCES" && fetchRequest( j, "ID" ) == fetchRequest( i, "ID" ) )
-                    {
 
-                        if( foo_str == "" )
-                        {
 
-                            foo_str = request_latlon[ j ];
-                            foo_index = to_string( j );
-                        }
-                        else
-                        {
-                            foo_str = foo_str + "," + request_latlon[ j ];
-                            foo_index = foo_index + "?" + to_string( j );
-                        }
 
-                    }
-                }
+    initshm( client, datestr );
+    f_cout( LOGDIR + "osrm" + "^" + client + "^" + datestr + ".txt" );
+    s_cout( LOGDIR + "gse_states_log" + "^" + client + "^" + datestr + ".txt" );
+    gse << "The value of DEBUGROUTED is " << DEBUGROUTED << endl; //***JDC hack
 
-                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Lat/Long " << foo_str << endl;
-                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "foo_index " << foo_index << endl;
-                if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Case 5 - LATLONG: " << fetchRequest( i, "LATLONG" ) << "; FUNC: " << fetchRequest( i, "FUNC" ) << endl;
+    // argv[ 2 ] and argv[ 3 ] are the client and date; everything else goes through the regular
+    // osrm-routed options so --algorithm, --mmap, --shared-memory and --dataset-name apply to the shm
+    // service too; with --shared-memory every client shares one osrm-datastore copy of the map.
+    std::vector<const char *> engine_argv;
+    engine_argv.push_back( argv[ 0 ] );
+    engine_argv.push_back( argv[ 1 ] );
+    for ( int a = 4;
+          a < argc;
+          a++ )
+    {
+        engine_argv.push_back( argv[ a ] );
+    }
 
+    EngineConfig config;
+    boost::filesystem::path base_path;
+    std::string ip_address;
+    int ip_port;
+    bool trial = false;
+    int requested_thread_num;
+    const unsigned init_result = generateServerProgramOptions( engine_argv.size(), engine_argv.data(), base_path, ip_address, ip_port, trial, config, requested_thread_num );
+    if ( init_result == INIT_OK_DO_NOT_START_ENGINE )
+    {
+        return EXIT_SUCCESS;
+    }
+    if ( init_result == INIT_FAILED )
+    {
+        return EXIT_FAILURE;
+    }
+    if ( !base_path.empty() )
+    {
+        config.storage_config = storage::StorageConfig( base_path );
+    }
+    if ( !config.IsValid() )
+    {
+        gse << "Required files are missing for " << base_path.string() << ", cannot start the engine" << endl;
+        util::Log( logERROR ) << "Required files are missing, cannot continue. Have all the pre-processing steps been run?";
+        return EXIT_FAILURE;
+    }
 
+    util::LogPolicy::GetInstance().Unmute();
+    util::LogPolicy::GetInstance().SetLevel( config.verbosity );
 
-                string temp = routedStringDistances( foo_str, argv[ 1 ] );
-                // cout << "Finished for " << std::get<0>(foo) << endl;
+    tableSizeLimit = config.max_locations_distance_table;
 
+    // One engine for the lifetime of the process; every Case below queries it.
+    TIMER_START( engine_load );
+    const OSRM osrm
+    {
+        config
+    };
+    TIMER_STOP( engine_load );
+    gse << "OSRM engine loaded in " << TIMER_MSEC( engine_load ) << " ms (shared memory: " << config.use_shared_memory << ", mmap: " << config.use_mmap << ")" << endl;
+    if ( config.use_shared_memory )
+    {
+        gse << "Serving the shared dataset \"" << config.dataset_name << "\" for client " << client << endl;
+    }
+    util::Log() << "Engine loaded in " << TIMER_MSEC( engine_load ) << " ms";
 
-                while( temp != "" && foo_index != "" )
-                {
-                    int index = ( int )to_number( getNextToken( &foo_index, "?" ) );
-                    string distance = getNextToken( &temp, "?" );
-                    // if(isSameLocation_onlyLatLong(lat1,lon1,lat2,lon2)){
-                    //distance = "0.00000";
+    if ( trial )
+    {
+        return EXIT_SUCCESS;
+    }
 
-                    // }
-                    updateRequest( index, distance.c_str(), "DISTANCE" );
-                    if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:'main while loop':'main for loop':'Case 5':updateRequest( " << index << ", " << distance.c_str() << ", 'DISTANCE' );" << endl;
-                    
+    string osrmnodes;
+    // create segment and corresponding allocator
 
-                }
+    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "Max value of keyt " << std::numeric_limits<key_t> ::max() << endl;
 
-            }
-            //***Case 5 - End***//
+    int shmid = shmget ( key_shared_process, sizeof( char[ MAXPROCESSESCOL ][ MAXLGSTRSIZE ][ NUMBEROFPROCESSES ] ), IPC_CREAT | 0666 );
+    shared_process_tab = ( char ( * )[ MAXPROCESSESCOL ][ MAXLGSTRSIZE ] )shmat( shmid, 0, 0 );
 
+    // request slots and their EDGES/TRIPIDX arena live in one segment keyed by keyrnum
+    attachRequestTable();
+    // cached stop-pair answers came from whatever dataset was loaded before this engine
+    invalidateTravelCache();
 
+    strcpy( ( shared_process_tab[ OSRMSTATUS ][ 0 ] ) , ( "READY" ) );
+    if( DEBUGSTATE == 1 ) logstatechange << "osrm_routed:shared_process_tab[ OSRMSTATUS ][ 0 ]=READY" << endl;
 
-        }
-        //***main for loop - End***//
+    if(DEBUGROUTED == 1 || DEBUG == 1 ) gse << "OSRM Server starting ... v2" << endl;
 
+    // The calling thread is worker 0; the engine is safe for concurrent queries, and so are the
+    // debug logs, which every thread appends to through its own ring.
+    int workers = std::max( 1, requested_thread_num );
+    gse << "Serving requests with " << workers << " worker thread(s)" << endl;
 
+    // DEBUG* flags follow configLogs.txt while the server runs
+    reloadDebugFlags( client );
+    std::thread( [ client ]
+    {
+        while ( true )
+        {
+            std::this_thread::sleep_for( std::chrono::seconds( 5 ) );
+            reloadDebugFlags( client );
+        }
+    } ).detach();
 
+    // every client process on the shared dataset drops its cached answers when osrm-datastore swaps it
+    if ( config.use_shared_memory )
+    {
+        const std::string dataset_name = config.dataset_name;
+        std::thread( [ dataset_name ]
+        {
+            try
+            {
+                watchDataset( dataset_name );
+            }
+            catch ( const std::exception &e )
+            {
+                util::Log( logERROR ) << "Dataset watch failed: " << e.what();
+            }
+        } ).detach();
+    }
 
-        if( !foundhit ) //JDC Is this intended to reduce cpu time when there's nothing to do? Would normally be cycling through the While loop.
-        	            //JDC But 0.1 seconds seems a bit long. Am reducing to 0.01.
-        	//usleep( 100000 );    //microseconds
-        	usleep( 10000 );
-        else
+    // vehicle tracks registered by getRealTimeTravleTime() follow avl_tops in the background
+    std::thread( [ &osrm ]
+    {
+        try
         {
-            foundhit = false;
-            usleep( 100 );
+            trackVehicles( osrm );
         }
+        catch ( const std::exception &e )
+        {
+            util::Log( logERROR ) << "Vehicle tracking failed: " << e.what();
+        }
+    } ).detach();
 
-
+    std::vector<std::thread> pool;
+    for( int w = 1;
+         w < workers;
+         w++ )
+    {
+        pool.emplace_back( [ &osrm ]
+        {
+            try
+            {
+                serveRequests( osrm );
+            }
+            catch ( const std::exception &e )
+            {
+                util::Log( logERROR ) << "Worker failed: " << e.what();
+                std::exit( EXIT_FAILURE );
+            }
+        } );
     }
-    //***main while loop - End***//
+    serveRequests( osrm );
 }
 
 catch ( const osrm::RuntimeError &e )
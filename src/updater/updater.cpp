@@ -545,6 +545,30 @@ Updater::LoadAndUpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &e
                                         std::vector<EdgeWeight> &node_weights,
                                         std::vector<EdgeDuration> &node_durations,
                                         std::uint32_t &connectivity_checksum) const
+{
+    return UpdateEdgeExpandedGraph(
+        edge_based_edge_list, node_weights, node_durations, nullptr, connectivity_checksum);
+}
+
+EdgeID
+Updater::LoadAndUpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &edge_based_edge_list,
+                                        std::vector<EdgeWeight> &node_weights,
+                                        std::vector<EdgeDuration> &node_durations,
+                                        extractor::SegmentDataContainer &segment_data,
+                                        std::uint32_t &connectivity_checksum) const
+{
+    return UpdateEdgeExpandedGraph(
+        edge_based_edge_list, node_weights, node_durations, &segment_data, connectivity_checksum);
+}
+
+// Without updated_segment_data the updates are written back to the input files, otherwise they
+// are left untouched and the updated segment data is handed out instead
+EdgeID
+Updater::UpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &edge_based_edge_list,
+                                 std::vector<EdgeWeight> &node_weights,
+                                 std::vector<EdgeDuration> &node_durations,
+                                 extractor::SegmentDataContainer *updated_segment_data,
+                                 std::uint32_t &connectivity_checksum) const
 {
     TIMER_START(load_edges);
 
@@ -568,6 +592,12 @@ Updater::LoadAndUpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &e
 
     if (!update_edge_weights && !update_turn_penalties && !update_conditional_turns)
     {
+        if (updated_segment_data)
+        {
+            extractor::files::readSegmentData(config.GetPath(".osrm.geometry"),
+                                              *updated_segment_data);
+            return number_of_edge_based_nodes;
+        }
         saveDatasourcesNames(config);
         return number_of_edge_based_nodes;
     }
@@ -623,7 +653,8 @@ Updater::LoadAndUpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &e
                                              coordinates,
                                              osm_node_ids);
         // Now save out the updated compressed geometries
-        extractor::files::writeSegmentData(config.GetPath(".osrm.geometry"), segment_data);
+        if (!updated_segment_data)
+            extractor::files::writeSegmentData(config.GetPath(".osrm.geometry"), segment_data);
         TIMER_STOP(segment);
         util::Log() << "Updating segment data took " << TIMER_MSEC(segment) << "ms.";
     }
@@ -804,7 +835,7 @@ Updater::LoadAndUpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &e
                           });
     }
 
-    if (update_turn_penalties || update_conditional_turns)
+    if ((update_turn_penalties || update_conditional_turns) && !updated_segment_data)
     {
         tbb::parallel_invoke(
             [&] {
@@ -825,7 +856,10 @@ Updater::LoadAndUpdateEdgeExpandedGraph(std::vector<extractor::EdgeBasedEdge> &e
     }
 #endif
 
-    saveDatasourcesNames(config);
+    if (updated_segment_data)
+        *updated_segment_data = std::move(segment_data);
+    else
+        saveDatasourcesNames(config);
 
     TIMER_STOP(load_edges);
     util::Log() << "Done reading edges in " << TIMER_MSEC(load_edges) << "ms.";
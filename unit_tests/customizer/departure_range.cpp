@@ -0,0 +1,43 @@
+#include "customizer/departure_range.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace osrm;
+using namespace osrm::customizer;
+
+BOOST_AUTO_TEST_SUITE(departure_range)
+
+BOOST_AUTO_TEST_CASE(metric_names_round_trip)
+{
+    const DepartureRange morning{420, 570};
+    const auto name = departureMetricName("routability", morning);
+    BOOST_CHECK_EQUAL(name, "routability/departure/420-570");
+    BOOST_CHECK(isDepartureMetric(name));
+    BOOST_CHECK(!isDepartureMetric("routability"));
+
+    DepartureRange parsed{0, 0};
+    BOOST_REQUIRE(parseDepartureRange("/mld/metrics/" + name, parsed));
+    BOOST_CHECK_EQUAL(parsed.begin, 420);
+    BOOST_CHECK_EQUAL(parsed.end, 570);
+
+    BOOST_CHECK(!parseDepartureRange("/mld/metrics/routability/departure/570-420", parsed));
+    BOOST_CHECK(!parseDepartureRange("/mld/metrics/routability/departure/0-1441", parsed));
+    BOOST_CHECK(!parseDepartureRange("/mld/metrics/routability/departure/420", parsed));
+    BOOST_CHECK(!parseDepartureRange("/mld/metrics/routability/departure/-570", parsed));
+}
+
+BOOST_AUTO_TEST_CASE(ranges_are_half_open)
+{
+    const DepartureRange morning{420, 570};
+    BOOST_CHECK(!morning.Contains(419));
+    BOOST_CHECK(morning.Contains(420));
+    BOOST_CHECK(morning.Contains(569));
+    BOOST_CHECK(!morning.Contains(570));
+
+    BOOST_CHECK(!morning.Overlaps(DepartureRange{570, 600}));
+    BOOST_CHECK(!morning.Overlaps(DepartureRange{300, 420}));
+    BOOST_CHECK(morning.Overlaps(DepartureRange{569, 600}));
+    BOOST_CHECK(morning.Overlaps(DepartureRange{0, 1440}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
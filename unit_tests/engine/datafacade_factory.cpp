@@ -0,0 +1,94 @@
+#include "engine/datafacade_factory.hpp"
+
+#include "engine/api/route_parameters.hpp"
+#include "storage/shared_data_index.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(datafacade_factory)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+// Only remembers which metric the factory built it for
+template <typename AlgorithmT> class MetricFacade
+{
+  public:
+    template <typename AllocatorT>
+    MetricFacade(std::shared_ptr<AllocatorT>, const std::string &metric_name, std::size_t exclude)
+        : metric_name(metric_name), exclude(exclude)
+    {
+    }
+
+    std::string metric_name;
+    std::size_t exclude;
+};
+
+// The blocks osrm-datastore lays out for a dataset customized with two departure ranges
+class TwoRangeAllocator
+{
+  public:
+    TwoRangeAllocator()
+    {
+        std::unique_ptr<storage::BaseDataLayout> layout =
+            std::make_unique<storage::ContiguousDataLayout>();
+        layout->SetBlock("/common/properties",
+                         storage::make_block<extractor::ProfileProperties>(1));
+        for (const std::string metric : {"duration",
+                                         "duration/departure/420-570",
+                                         "duration/departure/960-1140"})
+        {
+            layout->SetBlock("/mld/metrics/" + metric + "/exclude/0/weights",
+                             storage::make_block<EdgeWeight>(1));
+            layout->SetBlock("/mld/metrics/" + metric + "/exclude/0/durations",
+                             storage::make_block<EdgeDuration>(1));
+        }
+
+        memory.resize(layout->GetSizeOfLayout());
+        new (layout->GetBlockPtr(memory.data(), "/common/properties"))
+            extractor::ProfileProperties();
+
+        std::vector<storage::SharedDataIndex::AllocatedRegion> regions;
+        regions.push_back({memory.data(), std::move(layout)});
+        index = storage::SharedDataIndex{std::move(regions)};
+    }
+
+    const storage::SharedDataIndex &GetIndex() { return index; }
+
+  private:
+    std::vector<char> memory;
+    storage::SharedDataIndex index;
+};
+
+using Factory = DataFacadeFactory<MetricFacade, routing_algorithms::mld::Algorithm>;
+
+std::string metricFor(const Factory &factory, boost::optional<unsigned> departure_time)
+{
+    api::RouteParameters params;
+    params.departure_time = departure_time;
+    return factory.Get(params)->metric_name;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(departure_time_selects_range_metric)
+{
+    const Factory factory(std::make_shared<TwoRangeAllocator>());
+
+    BOOST_CHECK_EQUAL(metricFor(factory, boost::none), "duration");
+    BOOST_CHECK_EQUAL(metricFor(factory, 0u), "duration");
+    BOOST_CHECK_EQUAL(metricFor(factory, 419u), "duration");
+    BOOST_CHECK_EQUAL(metricFor(factory, 420u), "duration/departure/420-570");
+    BOOST_CHECK_EQUAL(metricFor(factory, 569u), "duration/departure/420-570");
+    BOOST_CHECK_EQUAL(metricFor(factory, 570u), "duration");
+    BOOST_CHECK_EQUAL(metricFor(factory, 1000u), "duration/departure/960-1140");
+    BOOST_CHECK_EQUAL(metricFor(factory, 1140u), "duration");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
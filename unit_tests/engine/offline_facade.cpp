@@ -224,6 +224,12 @@ class ContiguousInternalMemoryDataFacade<routing_algorithms::offline::Algorithm>
         return {};
     }
 
+    std::vector<RTreeLeaf> GetEdgesInRange(const util::Coordinate /*input_coordinate*/,
+                                           const double /*max_distance*/) const override
+    {
+        return {};
+    }
+
     std::vector<PhantomNodeWithDistance>
     NearestPhantomNodesInRange(const util::Coordinate /*input_coordinate*/,
                                const float /*max_distance*/,
@@ -350,6 +356,7 @@ class ContiguousInternalMemoryDataFacade<routing_algorithms::offline::Algorithm>
     const char *GetWeightName() const override { return ""; }
     unsigned GetWeightPrecision() const override { return 0; }
     double GetWeightMultiplier() const override { return 1; }
+    bool IsDepartureMetric() const override { return false; }
     ComponentID GetComponentID(NodeID) const override { return ComponentID{}; }
     bool ExcludeNode(const NodeID) const override { return false; }
 
@@ -249,4 +249,53 @@ BOOST_AUTO_TEST_CASE(test_nearest_fb_error)
     BOOST_CHECK_EQUAL(fb->code()->code()->str(), "InvalidOptions");
 }
 
+BOOST_AUTO_TEST_CASE(test_nearest_typed_result)
+{
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    using namespace osrm;
+
+    NearestParameters params;
+    params.number_of_results = 3;
+    params.coordinates.push_back(get_dummy_location());
+
+    json::Object json_result;
+    BOOST_REQUIRE(osrm.Nearest(params, json_result) == Status::Ok);
+
+    NearestResult typed_result;
+    const auto rc = osrm.Nearest(params, typed_result);
+    BOOST_REQUIRE(rc == Status::Ok);
+    BOOST_CHECK_EQUAL(typed_result.code, "Ok");
+
+    const auto &json_waypoints = json_result.values.at("waypoints").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(typed_result.waypoints.size(), json_waypoints.size());
+    for (std::size_t idx = 0; idx < json_waypoints.size(); ++idx)
+    {
+        const auto &waypoint = typed_result.waypoints[idx];
+        const auto &json_waypoint = json_waypoints[idx].get<json::Object>();
+        BOOST_CHECK_EQUAL(waypoint.distance,
+                          json_waypoint.values.at("distance").get<json::Number>().value);
+
+        const auto &nodes = json_waypoint.values.at("nodes").get<json::Array>().values;
+        BOOST_CHECK_EQUAL(waypoint.from_node, nodes[0].get<json::Number>().value);
+        BOOST_CHECK_EQUAL(waypoint.to_node, nodes[1].get<json::Number>().value);
+        BOOST_CHECK(waypoint.location.IsValid());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_nearest_typed_result_error)
+{
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    using namespace osrm;
+
+    NearestParameters params;
+
+    NearestResult typed_result;
+    const auto rc = osrm.Nearest(params, typed_result);
+    BOOST_REQUIRE(rc == Status::Error);
+    BOOST_CHECK_EQUAL(typed_result.code, "InvalidOptions");
+    BOOST_CHECK(typed_result.waypoints.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
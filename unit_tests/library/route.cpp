@@ -732,4 +732,57 @@ BOOST_AUTO_TEST_CASE(test_route_serialize_fb_skip_waypoints)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_route_typed_result)
+{
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    using namespace osrm;
+
+    RouteParameters params;
+    params.annotations_type = RouteParameters::AnnotationsType::Nodes |
+                              RouteParameters::AnnotationsType::Distance;
+    for (const auto &location : get_locations_in_big_component())
+        params.coordinates.push_back(location);
+
+    json::Object json_result;
+    BOOST_REQUIRE(osrm.Route(params, json_result) == Status::Ok);
+
+    RouteResult typed_result;
+    const auto rc = osrm.Route(params, typed_result);
+    BOOST_REQUIRE(rc == Status::Ok);
+    BOOST_CHECK_EQUAL(typed_result.code, "Ok");
+
+    // same numbers as the JSON response, leg by leg
+    const auto &json_routes = json_result.values.at("routes").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(typed_result.routes.size(), json_routes.size());
+    const auto &json_route = json_routes.front().get<json::Object>();
+    const auto &route = typed_result.routes.front();
+    BOOST_CHECK_EQUAL(route.distance,
+                      json_route.values.at("distance").get<json::Number>().value);
+    BOOST_CHECK_EQUAL(route.duration,
+                      json_route.values.at("duration").get<json::Number>().value);
+    BOOST_CHECK_EQUAL(route.weight, json_route.values.at("weight").get<json::Number>().value);
+
+    const auto &json_legs = json_route.values.at("legs").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(route.legs.size(), json_legs.size());
+    for (std::size_t idx = 0; idx < route.legs.size(); ++idx)
+    {
+        const auto &leg = route.legs[idx];
+        const auto &annotation = json_legs[idx]
+                                     .get<json::Object>()
+                                     .values.at("annotation")
+                                     .get<json::Object>();
+        const auto &json_nodes = annotation.values.at("nodes").get<json::Array>().values;
+        BOOST_REQUIRE_EQUAL(leg.nodes.size(), json_nodes.size());
+        for (std::size_t node = 0; node < leg.nodes.size(); ++node)
+            BOOST_CHECK_EQUAL(leg.nodes[node], json_nodes[node].get<json::Number>().value);
+
+        BOOST_CHECK_EQUAL(leg.distances.size(),
+                          annotation.values.at("distance").get<json::Array>().values.size());
+        // not requested
+        BOOST_CHECK(leg.durations.empty());
+        BOOST_CHECK(leg.weights.empty());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -387,4 +387,54 @@ BOOST_AUTO_TEST_CASE(test_table_serialiaze_fb_no_waypoints)
     BOOST_CHECK(fb->waypoints() == nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(test_table_typed_result)
+{
+    using namespace osrm;
+
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    TableParameters params;
+    for (const auto &location : get_locations_in_big_component())
+        params.coordinates.push_back(location);
+    params.sources.push_back(0);
+    params.sources.push_back(1);
+    params.annotations = TableParameters::AnnotationsType::All;
+
+    json::Object json_result;
+    BOOST_REQUIRE(osrm.Table(params, json_result) == Status::Ok);
+
+    TableResult typed_result;
+    const auto rc = osrm.Table(params, typed_result);
+    BOOST_REQUIRE(rc == Status::Ok);
+    BOOST_CHECK_EQUAL(typed_result.code, "Ok");
+    BOOST_CHECK_EQUAL(typed_result.rows, 2);
+    BOOST_CHECK_EQUAL(typed_result.columns, 3);
+    BOOST_REQUIRE_EQUAL(typed_result.durations.size(), 2 * 3);
+    BOOST_REQUIRE_EQUAL(typed_result.distances.size(), 2 * 3);
+
+    // row-major layout with the same values as the nested JSON arrays
+    const auto &json_durations = json_result.values.at("durations").get<json::Array>().values;
+    const auto &json_distances = json_result.values.at("distances").get<json::Array>().values;
+    for (std::size_t row = 0; row < typed_result.rows; ++row)
+    {
+        const auto &duration_row = json_durations[row].get<json::Array>().values;
+        const auto &distance_row = json_distances[row].get<json::Array>().values;
+        for (std::size_t column = 0; column < typed_result.columns; ++column)
+        {
+            const auto cell = row * typed_result.columns + column;
+            BOOST_CHECK_EQUAL(typed_result.durations[cell],
+                              duration_row[column].get<json::Number>().value);
+            BOOST_CHECK_EQUAL(typed_result.distances[cell],
+                              distance_row[column].get<json::Number>().value);
+        }
+    }
+    BOOST_CHECK(typed_result.fallback_speed_cells.empty());
+
+    // the test dataset has no departure ranges, a departure time keeps the base metric
+    BOOST_CHECK(!typed_result.departure_metric);
+    params.departure_time = 480;
+    BOOST_REQUIRE(osrm.Table(params, typed_result) == Status::Ok);
+    BOOST_CHECK(!typed_result.departure_metric);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
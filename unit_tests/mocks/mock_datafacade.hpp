@@ -108,6 +108,12 @@ class MockBaseDataFacade : public engine::datafacade::BaseDataFacade
         return {};
     }
 
+    std::vector<RTreeLeaf> GetEdgesInRange(const util::Coordinate /*input_coordinate*/,
+                                           const double /*max_distance*/) const override
+    {
+        return {};
+    }
+
     std::vector<engine::PhantomNodeWithDistance>
     NearestPhantomNodesInRange(const util::Coordinate /*input_coordinate*/,
                                const float /*max_distance*/,
@@ -231,6 +237,7 @@ class MockBaseDataFacade : public engine::datafacade::BaseDataFacade
     const char *GetWeightName() const override final { return "duration"; }
     unsigned GetWeightPrecision() const override final { return 1; }
     double GetWeightMultiplier() const override final { return 10.; }
+    bool IsDepartureMetric() const override final { return false; }
     bool IsLeftHandDriving(const NodeID /*id*/) const override { return false; }
     bool IsSegregated(const NodeID /*id*/) const override { return false; }
 
@@ -518,6 +518,18 @@ BOOST_AUTO_TEST_CASE(valid_route_urls)
     CHECK_EQUAL_RANGE(reference_21.coordinates, result_21->coordinates);
     CHECK_EQUAL_RANGE(reference_21.hints, result_21->hints);
     CHECK_EQUAL_RANGE(reference_21.exclude, result_21->exclude);
+
+    // departure time
+    RouteParameters reference_22{};
+    reference_22.departure_time = 465;
+    reference_22.coordinates = coords_1;
+    auto result_22 = parseParameters<RouteParameters>("1,2;3,4?departure_time=465");
+    BOOST_CHECK(result_22);
+    BOOST_CHECK_EQUAL(reference_22.departure_time, result_22->departure_time);
+    CHECK_EQUAL_RANGE(reference_22.coordinates, result_22->coordinates);
+    auto result_23 = parseParameters<RouteParameters>("1,2;3,4?departure_time=1440");
+    BOOST_CHECK(result_23);
+    BOOST_CHECK(!result_23->IsValid());
 }
 
 BOOST_AUTO_TEST_CASE(valid_table_urls)
@@ -632,6 +644,12 @@ BOOST_AUTO_TEST_CASE(valid_table_urls)
     CHECK_EQUAL_RANGE(reference_1.radiuses, result_11->radiuses);
     CHECK_EQUAL_RANGE(reference_1.approaches, result_11->approaches);
     CHECK_EQUAL_RANGE(reference_1.coordinates, result_11->coordinates);
+
+    auto result_12 =
+        parseParameters<TableParameters>("1,2;3,4?annotations=duration&departure_time=1020");
+    BOOST_CHECK(result_12);
+    BOOST_CHECK_EQUAL(result_12->departure_time, boost::optional<unsigned>(1020));
+    CHECK_EQUAL_RANGE(reference_1.coordinates, result_12->coordinates);
 }
 
 BOOST_AUTO_TEST_CASE(valid_match_urls)
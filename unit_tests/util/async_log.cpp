@@ -0,0 +1,152 @@
+#include "util/async_log.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(async_log_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+struct TemporaryFile
+{
+    TemporaryFile()
+        : path((boost::filesystem::temp_directory_path() / boost::filesystem::unique_path())
+                   .string())
+    {
+    }
+    ~TemporaryFile() { boost::filesystem::remove(path); }
+
+    std::vector<std::string> lines() const
+    {
+        std::ifstream file(path);
+        std::vector<std::string> all;
+        std::string line;
+        while (std::getline(file, line))
+            all.push_back(line);
+        return all;
+    }
+
+    std::string path;
+};
+
+// "%D %T.nanoseconds " is 28 characters
+std::string text(const std::string &line) { return line.size() < 28 ? "" : line.substr(28); }
+
+BOOST_AUTO_TEST_CASE(lines_carry_a_stamp_and_keep_their_order)
+{
+    TemporaryFile file;
+    AsyncLog log;
+    BOOST_REQUIRE(log.Open(file.path));
+
+    for (int stop = 0; stop < 100; ++stop)
+        AsyncLogLine(log) << "stop " << stop << std::endl;
+    AsyncLogLine(log) << std::fixed << std::setprecision(2) << 1.5 << std::endl;
+    log.Flush();
+
+    const auto lines = file.lines();
+    BOOST_REQUIRE_EQUAL(lines.size(), 101);
+    for (int stop = 0; stop < 100; ++stop)
+        BOOST_CHECK_EQUAL(text(lines[stop]), "stop " + std::to_string(stop));
+    BOOST_CHECK_EQUAL(text(lines[100]), "1.50");
+    BOOST_CHECK_EQUAL(lines[0][2], '/');
+    BOOST_CHECK_EQUAL(lines[0][17], '.');
+    BOOST_CHECK_EQUAL(log.Written(), 101);
+}
+
+BOOST_AUTO_TEST_CASE(small_rings_wait_instead_of_dropping)
+{
+    TemporaryFile file;
+    AsyncLog log(256);
+    BOOST_REQUIRE(log.Open(file.path));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&log, t] {
+            for (int line = 0; line < 500; ++line)
+                AsyncLogLine(log) << "thread " << t << " line " << line << std::endl;
+        });
+    for (auto &thread : threads)
+        thread.join();
+    log.Flush();
+
+    BOOST_CHECK_EQUAL(file.lines().size(), 2000);
+    BOOST_CHECK(log.Waits() > 0);
+}
+
+BOOST_AUTO_TEST_CASE(nested_lines_and_closed_log)
+{
+    TemporaryFile file;
+    AsyncLog log;
+
+    AsyncLogLine(log) << "before open" << std::endl;
+    BOOST_REQUIRE(log.Open(file.path));
+
+    const auto inner = [&log] {
+        AsyncLogLine(log) << "inner" << std::endl;
+        return 7;
+    };
+    AsyncLogLine(log) << "outer " << inner() << std::endl;
+    log.Close();
+    AsyncLogLine(log) << "after close" << std::endl;
+
+    const auto lines = file.lines();
+    BOOST_REQUIRE_EQUAL(lines.size(), 2);
+    BOOST_CHECK(text(lines[0]) == "inner" || text(lines[1]) == "inner");
+    BOOST_CHECK(text(lines[0]) == "outer 7" || text(lines[1]) == "outer 7");
+}
+
+BOOST_AUTO_TEST_CASE(writer_formats_like_an_ostream)
+{
+    TemporaryFile file;
+    AsyncLog log;
+    BOOST_REQUIRE(log.Open(file.path));
+
+    std::string name = "trip";
+    const char id[] = "A1";
+    std::ostringstream expected;
+    const auto both = [&](auto &out) {
+        out << name << ' ' << id << std::setw(6) << std::setfill('.') << -42 << std::left
+            << std::setw(5) << name << std::right << std::hex << 255u << std::dec << std::fixed
+            << std::setprecision(3) << 2.0 / 3 << std::boolalpha << true << 'x' << 7.5f;
+    };
+    both(expected);
+    {
+        AsyncLogLine line(log);
+        both(line);
+        // values are copied as they go in
+        name = "changed";
+        line << std::endl;
+    }
+    log.Flush();
+
+    const auto lines = file.lines();
+    BOOST_REQUIRE_EQUAL(lines.size(), 1);
+    BOOST_CHECK_EQUAL(text(lines[0]), expected.str());
+}
+
+BOOST_AUTO_TEST_CASE(long_lines_keep_what_fits)
+{
+    TemporaryFile file;
+    AsyncLog log(256);
+    BOOST_REQUIRE(log.Open(file.path));
+
+    // the string is cut where the ring ends, the values after it are dropped
+    AsyncLogLine(log) << 12345 << std::string(1000, 'x') << 67890 << std::endl;
+    log.Flush();
+
+    const auto lines = file.lines();
+    BOOST_REQUIRE_EQUAL(lines.size(), 1);
+    BOOST_CHECK_EQUAL(text(lines[0]).substr(0, 6), "12345x");
+    BOOST_CHECK(text(lines[0]).size() > 100 && text(lines[0]).size() < 256);
+    BOOST_CHECK_EQUAL(text(lines[0]).find('6'), std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
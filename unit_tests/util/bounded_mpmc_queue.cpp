@@ -0,0 +1,99 @@
+#include "util/bounded_mpmc_queue.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(bounded_mpmc_queue_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(fifo_order_test)
+{
+    auto queue = std::make_unique<BoundedMPMCQueue<int, 8>>();
+
+    for (int value = 0; value < 8; ++value)
+        BOOST_CHECK(queue->TryPush(value));
+    BOOST_CHECK(!queue->TryPush(8));
+    BOOST_CHECK_EQUAL(queue->ApproximateSize(), 8);
+
+    int value;
+    for (int expected = 0; expected < 8; ++expected)
+    {
+        BOOST_CHECK(queue->TryPop(value));
+        BOOST_CHECK_EQUAL(value, expected);
+    }
+    BOOST_CHECK(!queue->TryPop(value));
+    BOOST_CHECK_EQUAL(queue->ApproximateSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(wrap_around_test)
+{
+    auto queue = std::make_unique<BoundedMPMCQueue<int, 4>>();
+
+    int value;
+    for (int lap = 0; lap < 100; ++lap)
+    {
+        BOOST_CHECK(queue->TryPush(lap));
+        BOOST_CHECK(queue->TryPush(lap + 1000));
+        BOOST_CHECK(queue->TryPop(value));
+        BOOST_CHECK_EQUAL(value, lap);
+        BOOST_CHECK(queue->TryPop(value));
+        BOOST_CHECK_EQUAL(value, lap + 1000);
+    }
+}
+
+// every pushed value comes out exactly once with several producers and consumers
+BOOST_AUTO_TEST_CASE(concurrent_push_pop_test)
+{
+    constexpr int num_producers = 4;
+    constexpr int num_consumers = 4;
+    constexpr int values_per_producer = 20000;
+
+    auto queue = std::make_unique<BoundedMPMCQueue<int, 1024>>();
+    std::vector<std::atomic<int>> seen(num_producers * values_per_producer);
+    for (auto &count : seen)
+        count = 0;
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (int producer = 0; producer < num_producers; ++producer)
+    {
+        threads.emplace_back([&, producer] {
+            for (int index = 0; index < values_per_producer; ++index)
+            {
+                while (!queue->TryPush(producer * values_per_producer + index))
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for (int consumer = 0; consumer < num_consumers; ++consumer)
+    {
+        threads.emplace_back([&] {
+            int value;
+            while (consumed.load() < num_producers * values_per_producer)
+            {
+                if (queue->TryPop(value))
+                {
+                    seen[value]++;
+                    consumed++;
+                }
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    BOOST_CHECK(std::all_of(seen.begin(), seen.end(), [](const std::atomic<int> &count) {
+        return count.load() == 1;
+    }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,62 @@
+#include "../common/range_tools.hpp"
+
+#include "util/permutation_sort.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(permutation_sort_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(stable_parallel_sort)
+{
+    std::vector<double> deviation{3.5, 1.0, 2.0, 1.0, 0.5};
+    std::vector<int> trips{10, 11, 12, 13, 14};
+    std::vector<std::string> json{"a", "b", "c", "d", "e"};
+
+    sortParallel(0, 5, ascending(deviation.data()), deviation.data(), trips.data(), json.data());
+
+    const std::vector<double> sorted_deviation{0.5, 1.0, 1.0, 2.0, 3.5};
+    const std::vector<int> sorted_trips{14, 11, 13, 12, 10};
+    const std::vector<std::string> sorted_json{"e", "b", "d", "c", "a"};
+    CHECK_EQUAL_COLLECTIONS(deviation, sorted_deviation);
+    CHECK_EQUAL_COLLECTIONS(trips, sorted_trips);
+    CHECK_EQUAL_COLLECTIONS(json, sorted_json);
+}
+
+BOOST_AUTO_TEST_CASE(chained_keys_and_subrange)
+{
+    // positions 0 and 5 lie outside of the sorted range
+    std::vector<int> transfer{9, 1, 0, 1, 0, 9};
+    std::vector<double> time{9, 30, 20, 10, 40, 9};
+
+    sortParallel(1,
+                 5,
+                 thenBy(ascending(transfer.data()), descending(time.data())),
+                 transfer.data(),
+                 time.data());
+
+    const std::vector<int> sorted_transfer{9, 0, 0, 1, 1, 9};
+    const std::vector<double> sorted_time{9, 40, 20, 30, 10, 9};
+    CHECK_EQUAL_COLLECTIONS(transfer, sorted_transfer);
+    CHECK_EQUAL_COLLECTIONS(time, sorted_time);
+}
+
+BOOST_AUTO_TEST_CASE(top_positions)
+{
+    const std::vector<double> deviation{4, 2, 7, 2, 1, 9};
+
+    const auto best = topPositions(0, deviation.size(), 3, ascending(deviation.data()));
+    const std::vector<std::size_t> expected{4, 1, 3};
+    CHECK_EQUAL_COLLECTIONS(best, expected);
+
+    BOOST_CHECK_EQUAL(topPositions(0, deviation.size(), 10, ascending(deviation.data())).size(),
+                      deviation.size());
+    BOOST_CHECK(topPositions(2, 2, 1, ascending(deviation.data())).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
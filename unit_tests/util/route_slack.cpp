@@ -0,0 +1,92 @@
+#include "util/route_slack.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <random>
+
+BOOST_AUTO_TEST_SUITE(route_slack_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+namespace
+{
+using Route = RouteSlack<32, 2>;
+
+void push(Route &route, int arrival, int service, int travel, int latest, int amb, int wc)
+{
+    const int load[2] = {amb, wc};
+    route.push(arrival, arrival + service, travel, latest, load);
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(waits_absorb_delay)
+{
+    std::unique_ptr<Route> route(new Route());
+    push(*route, 480, 5, 10, 500, 1, 0); // stop 0, departs 485
+    push(*route, 495, 5, 10, 505, 2, 0); // no wait, 10 minutes of room
+    push(*route, 520, 5, 10, 525, 1, 0); // waits 10 minutes, 5 of room
+    push(*route, 535, 5, 10, 530, 0, 0); // late already
+    route->build();
+
+    BOOST_CHECK_EQUAL(route->slack(3), 0);
+    BOOST_CHECK_EQUAL(route->slack(2), 10);
+    BOOST_CHECK_EQUAL(route->slack(1), 10);
+
+    // arriving at stop 1 ten minutes late uses up the wait before stop 2
+    BOOST_CHECK(route->delayFits(1, 505));
+    BOOST_CHECK(!route->delayFits(1, 506));
+    // nothing may push into the late stop
+    BOOST_CHECK(route->delayFits(2, 520));
+    BOOST_CHECK(!route->delayFits(2, 521));
+    // early arrivals and the last stop always fit
+    BOOST_CHECK(route->delayFits(2, 400));
+    BOOST_CHECK(route->delayFits(3, 900));
+}
+
+BOOST_AUTO_TEST_CASE(loads_are_read_after_the_previous_stop)
+{
+    std::unique_ptr<Route> route(new Route());
+    push(*route, 480, 5, 10, 500, 3, 1);
+    push(*route, 495, 5, 10, 505, 4, 0);
+    route->build();
+
+    BOOST_CHECK_EQUAL(route->load(0, 0), 3);
+    BOOST_CHECK_EQUAL(route->load(0, 1), 1);
+    BOOST_CHECK(route->loadFits(1, 0, 1, 4));
+    BOOST_CHECK(!route->loadFits(1, 0, 2, 4));
+    BOOST_CHECK(route->loadFits(1, 1, 1, 2));
+}
+
+BOOST_AUTO_TEST_CASE(slack_matches_full_propagation)
+{
+    std::mt19937 generator(17);
+    std::uniform_int_distribution<int> stops(1, 32), minutes(0, 30), chance(0, 3);
+    std::unique_ptr<Route> route(new Route());
+
+    for (int round = 0; round < 500; round++)
+    {
+        route->clear();
+        int departure = 360;
+        const int count = stops(generator);
+        for (int p = 0; p < count; p++)
+        {
+            const int travel = minutes(generator);
+            const int arrival = departure + minutes(generator) * (chance(generator) == 0);
+            const int service = minutes(generator) / 5;
+            // some stops are late already, the rest have up to 30 minutes of room
+            const int latest = arrival + minutes(generator) - 5 * (chance(generator) == 0);
+            push(*route, arrival, service, travel, latest, 0, 0);
+            departure = arrival + service + travel;
+        }
+        route->build();
+
+        for (int k = 0; k < count; k++)
+            for (int arrival = route->arrival(k) - 5; arrival <= route->arrival(k) + 90; arrival++)
+                BOOST_REQUIRE_EQUAL(route->delayFits(k, arrival),
+                                    route->delayFitsByPropagation(k, arrival));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -503,4 +503,49 @@ BOOST_AUTO_TEST_CASE(bbox_search_tests)
     }
 }
 
+BOOST_AUTO_TEST_CASE(range_search_tests)
+{
+    using Coord = std::pair<FloatLongitude, FloatLatitude>;
+    using Edge = std::tuple<unsigned, unsigned, bool>;
+
+    // roughly 157m between consecutive nodes
+    GraphFixture fixture(
+        {
+            Coord(FloatLongitude{0.000}, FloatLatitude{0.000}),
+            Coord(FloatLongitude{0.001}, FloatLatitude{0.001}),
+            Coord(FloatLongitude{0.002}, FloatLatitude{0.002}),
+            Coord(FloatLongitude{0.003}, FloatLatitude{0.003}),
+            Coord(FloatLongitude{0.004}, FloatLatitude{0.004}),
+        },
+        {Edge(0, 1, true), Edge(1, 2, true), Edge(2, 3, true), Edge(3, 4, true)});
+
+    TemporaryFile tmp;
+    auto rtree = make_rtree<MiniStaticRTree>(tmp.path, fixture);
+    TestDataFacade mockfacade;
+    engine::GeospatialQuery<MiniStaticRTree, TestDataFacade> query(
+        rtree, fixture.coords, mockfacade);
+
+    {
+        Coordinate input(FloatLongitude{0.0}, FloatLatitude{0.0});
+        auto results = query.NearestEdgesInRange(input, 200);
+        BOOST_REQUIRE_EQUAL(results.size(), 2);
+        BOOST_CHECK_EQUAL(results[0].u, 0);
+        BOOST_CHECK_EQUAL(results[1].u, 1);
+    }
+
+    {
+        // closest first, within range of the perpendicular distance
+        Coordinate input(FloatLongitude{0.0025}, FloatLatitude{0.0025});
+        auto results = query.NearestEdgesInRange(input, 50);
+        BOOST_REQUIRE_EQUAL(results.size(), 1);
+        BOOST_CHECK_EQUAL(results[0].u, 2);
+        BOOST_CHECK_EQUAL(rtree.SearchInRange(input, 1000).size(), 4);
+    }
+
+    {
+        Coordinate input(FloatLongitude{1.0}, FloatLatitude{1.0});
+        BOOST_CHECK(query.NearestEdgesInRange(input, 1000).empty());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
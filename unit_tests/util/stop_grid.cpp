@@ -0,0 +1,115 @@
+#include "../common/range_tools.hpp"
+
+#include "util/stop_grid.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(stop_grid_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+namespace
+{
+// Few buckets so that distant cells share lists and the cell check is exercised
+using Grid = StopGrid<8, 16>;
+
+// Stops around a depot at 40.005/-75.005, in the middle of a 0.01 degree cell
+std::unique_ptr<Grid> makeFixture()
+{
+    std::unique_ptr<Grid> grid(new Grid(0.01, 100));
+    grid->insert(1, 40.005, -75.005);  // the depot
+    grid->insert(2, 40.0055, -75.005); // 0.03 miles north, same cell
+    grid->insert(3, 40.0045, -75.004); // 0.08 miles south east, same cell
+    grid->insert(4, 40.015, -75.015);  // diagonal neighbour cell, 0.98 miles
+    grid->insert(5, 40.055, -75.005);  // 5 cells north, 3.45 miles
+    grid->insert(6, 40.505, -75.005);  // 50 cells north, 34.5 miles
+    return grid;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(nearest_orders_by_distance)
+{
+    const auto grid = makeFixture();
+    std::vector<int> ids;
+
+    grid->nearest(40.005, -75.005, 3, ids);
+    CHECK_EQUAL_RANGE(ids, 1, 2, 3);
+
+    grid->nearest(40.005, -75.005, 10, ids);
+    CHECK_EQUAL_RANGE(ids, 1, 2, 3, 4, 5, 6);
+
+    // from the far stop the order reverses
+    grid->nearest(40.505, -75.005, 2, ids);
+    CHECK_EQUAL_RANGE(ids, 6, 5);
+
+    grid->nearest(40.005, -75.005, 0, ids);
+    BOOST_CHECK(ids.empty());
+}
+
+BOOST_AUTO_TEST_CASE(nearest_breaks_ties_by_id)
+{
+    auto grid = makeFixture();
+    grid->insert(9, 40.0055, -75.005);
+    grid->insert(0, 40.0055, -75.005);
+    std::vector<int> ids;
+
+    grid->nearest(40.005, -75.005, 4, ids);
+    CHECK_EQUAL_RANGE(ids, 1, 0, 2, 9);
+}
+
+BOOST_AUTO_TEST_CASE(nearest_gives_up_after_max_ring)
+{
+    Grid grid(0.01, 2);
+    grid.insert(1, 40.005, -75.005);
+    grid.insert(2, 40.505, -75.005);
+    std::vector<int> ids;
+
+    grid.nearest(40.005, -75.005, 2, ids);
+    CHECK_EQUAL_RANGE(ids, 1);
+}
+
+BOOST_AUTO_TEST_CASE(radius_returns_ascending_ids)
+{
+    const auto grid = makeFixture();
+    std::vector<int> ids;
+
+    grid->withinRadius(40.005, -75.005, 0.1, ids);
+    CHECK_EQUAL_RANGE(ids, 1, 2, 3);
+
+    grid->withinRadius(40.015, -75.015, 1.0, ids);
+    CHECK_EQUAL_RANGE(ids, 1, 2, 4);
+
+    // more cells than buckets: answered by one pass over the ids
+    grid->withinRadius(40.005, -75.005, 40, ids);
+    CHECK_EQUAL_RANGE(ids, 1, 2, 3, 4, 5, 6);
+}
+
+BOOST_AUTO_TEST_CASE(insert_moves_and_remove_unlinks)
+{
+    auto grid = makeFixture();
+    std::vector<int> ids;
+
+    BOOST_CHECK(grid->containsAt(2, 40.0055, -75.005));
+    grid->insert(2, 40.505, -75.005);
+    BOOST_CHECK(!grid->containsAt(2, 40.0055, -75.005));
+    BOOST_CHECK(grid->containsAt(2, 40.505, -75.005));
+
+    grid->withinRadius(40.005, -75.005, 0.1, ids);
+    CHECK_EQUAL_RANGE(ids, 1, 3);
+    grid->nearest(40.505, -75.005, 2, ids);
+    CHECK_EQUAL_RANGE(ids, 2, 6);
+
+    grid->remove(3);
+    grid->remove(3);
+    BOOST_CHECK(!grid->contains(3));
+    grid->withinRadius(40.005, -75.005, 0.1, ids);
+    CHECK_EQUAL_RANGE(ids, 1);
+    grid->nearest(40.005, -75.005, 3, ids);
+    CHECK_EQUAL_RANGE(ids, 1, 4, 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
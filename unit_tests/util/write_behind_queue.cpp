@@ -0,0 +1,203 @@
+#include "util/write_behind_queue.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(write_behind_queue_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+using StopRow = std::pair<int, std::string>;
+
+// Collects every batch, optionally holding the writer until released
+struct RecordingSink
+{
+    std::mutex mutex;
+    std::vector<std::vector<StopRow>> batches;
+    std::mutex gate;
+    std::atomic<bool> entered{false};
+
+    void operator()(const std::vector<StopRow> &rows)
+    {
+        entered = true;
+        std::lock_guard<std::mutex> hold(gate);
+        std::lock_guard<std::mutex> lock(mutex);
+        batches.push_back(rows);
+    }
+
+    std::vector<StopRow> rows()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<StopRow> all;
+        for (const auto &batch : batches)
+            all.insert(all.end(), batch.begin(), batch.end());
+        return all;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(flush_writes_everything_in_push_order)
+{
+    RecordingSink sink;
+    WriteBehindQueue<int, StopRow> queue([&sink](const std::vector<StopRow> &rows) { sink(rows); },
+                                         3);
+
+    for (int stop = 0; stop < 10; ++stop)
+        queue.Push(stop, StopRow(stop, "eta" + std::to_string(stop)));
+    queue.Flush();
+
+    const auto rows = sink.rows();
+    BOOST_REQUIRE_EQUAL(rows.size(), 10);
+    for (int stop = 0; stop < 10; ++stop)
+        BOOST_CHECK_EQUAL(rows[stop].first, stop);
+    for (const auto &batch : sink.batches)
+        BOOST_CHECK(batch.size() <= 3);
+    BOOST_CHECK_EQUAL(queue.Written(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(repeated_updates_coalesce_while_the_sink_is_busy)
+{
+    RecordingSink sink;
+    WriteBehindQueue<int, StopRow> queue([&sink](const std::vector<StopRow> &rows) { sink(rows); },
+                                         100);
+
+    {
+        // the writer blocks on the first batch, so everything below stays pending
+        std::lock_guard<std::mutex> hold(sink.gate);
+        queue.Push(1, StopRow(1, "first"));
+        while (!sink.entered)
+            std::this_thread::yield();
+
+        queue.Push(2, StopRow(2, "a"));
+        queue.Push(3, StopRow(3, "b"));
+        queue.Push(2, StopRow(2, "c"));
+        queue.Push(2, StopRow(2, "d"));
+    }
+    queue.Flush();
+
+    const auto rows = sink.rows();
+    BOOST_CHECK_EQUAL(queue.Coalesced(), 2);
+    BOOST_REQUIRE(rows.size() >= 3);
+
+    // the last two rows are the newest value of each key, in first push order
+    BOOST_CHECK_EQUAL(rows[rows.size() - 2].first, 2);
+    BOOST_CHECK_EQUAL(rows[rows.size() - 2].second, "d");
+    BOOST_CHECK_EQUAL(rows.back().first, 3);
+    BOOST_CHECK_EQUAL(rows.back().second, "b");
+}
+
+BOOST_AUTO_TEST_CASE(failed_batches_are_counted)
+{
+    WriteBehindQueue<int, StopRow> queue(
+        [](const std::vector<StopRow> &rows) {
+            if (rows.front().first < 0)
+                throw std::runtime_error("ORA-00942");
+        },
+        1);
+
+    queue.Push(-1, StopRow(-1, ""));
+    queue.Push(4, StopRow(4, ""));
+    queue.Flush();
+
+    BOOST_CHECK_EQUAL(queue.Failed(), 1);
+    BOOST_CHECK_EQUAL(queue.Written(), 1);
+    BOOST_CHECK_EQUAL(queue.LastError(), "ORA-00942");
+}
+
+BOOST_AUTO_TEST_CASE(failed_batches_are_retried)
+{
+    std::atomic<int> calls{0};
+    RecordingSink sink;
+    WriteBehindQueue<int, StopRow> queue(
+        [&](const std::vector<StopRow> &rows) {
+            // the database is down for the first two round trips
+            if (calls++ < 2)
+                throw std::runtime_error("ORA-03113");
+            sink(rows);
+        },
+        10,
+        3,
+        std::chrono::milliseconds(1));
+
+    queue.Push(1, StopRow(1, "a"));
+    queue.Push(2, StopRow(2, "b"));
+    queue.Flush();
+
+    const auto rows = sink.rows();
+    BOOST_REQUIRE_EQUAL(rows.size(), 2);
+    BOOST_CHECK_EQUAL(rows[0].second, "a");
+    BOOST_CHECK_EQUAL(rows[1].second, "b");
+    BOOST_CHECK_EQUAL(queue.Failed(), 2);
+    BOOST_CHECK_EQUAL(queue.Written(), 2);
+    BOOST_CHECK_EQUAL(queue.Abandoned(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(rows_out_of_attempts_are_abandoned)
+{
+    std::vector<StopRow> abandoned;
+    WriteBehindQueue<int, StopRow> queue(
+        [](const std::vector<StopRow> &rows) {
+            if (rows.front().first < 0)
+                throw std::runtime_error("ORA-00942");
+        },
+        1,
+        2,
+        std::chrono::milliseconds(1),
+        [&abandoned](const std::vector<StopRow> &rows) {
+            abandoned.insert(abandoned.end(), rows.begin(), rows.end());
+        });
+
+    queue.Push(-1, StopRow(-1, "bad"));
+    queue.Push(4, StopRow(4, "good"));
+    queue.Flush();
+
+    BOOST_CHECK_EQUAL(queue.Failed(), 2);
+    BOOST_CHECK_EQUAL(queue.Written(), 1);
+    BOOST_CHECK_EQUAL(queue.Abandoned(), 1);
+    BOOST_REQUIRE_EQUAL(abandoned.size(), 1);
+    BOOST_CHECK_EQUAL(abandoned[0].second, "bad");
+}
+
+BOOST_AUTO_TEST_CASE(a_newer_row_replaces_a_failed_one)
+{
+    RecordingSink sink;
+    std::atomic<bool> fail{true};
+    std::atomic<bool> failing{false};
+    std::mutex gate;
+    WriteBehindQueue<int, StopRow> queue(
+        [&](const std::vector<StopRow> &rows) {
+            if (fail.exchange(false))
+            {
+                failing = true;
+                std::lock_guard<std::mutex> hold(gate);
+                throw std::runtime_error("ORA-03113");
+            }
+            sink(rows);
+        },
+        10,
+        3);
+
+    {
+        // the newer row for key 1 arrives while the first write of key 1 is failing
+        std::lock_guard<std::mutex> hold(gate);
+        queue.Push(1, StopRow(1, "old"));
+        while (!failing)
+            std::this_thread::yield();
+        queue.Push(1, StopRow(1, "new"));
+    }
+    queue.Flush();
+
+    const auto rows = sink.rows();
+    BOOST_REQUIRE_EQUAL(rows.size(), 1);
+    BOOST_CHECK_EQUAL(rows[0].second, "new");
+}
+
+BOOST_AUTO_TEST_SUITE_END()